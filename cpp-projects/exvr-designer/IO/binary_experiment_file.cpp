@@ -0,0 +1,645 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "binary_experiment_file.hpp"
+
+// std
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <type_traits>
+
+// Qt
+#include <QDataStream>
+#include <QLocale>
+#include <QXmlStreamReader>
+#include <QtEndian>
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace  {
+
+enum class ValueTag : quint8{
+    String = 0, Int, Double, IntArray, DoubleArray
+};
+
+constexpr qint64 headerSize = 24;
+
+std::optional<qint32> canonical_int(const QString &text){
+    bool ok = false;
+    const int value = text.toInt(&ok);
+    if(ok && QString::number(value) == text){
+        return value;
+    }
+    return std::nullopt;
+}
+
+std::optional<double> canonical_double(const QString &text){
+    bool ok = false;
+    const double value = text.toDouble(&ok);
+    if(ok && std::isfinite(value) && QString::number(value, 'g', QLocale::FloatingPointShortest) == text){
+        return value;
+    }
+    return std::nullopt;
+}
+
+// little endian, same layout as the QDataStream reads
+template<typename T>
+void append(QByteArray &data, T value){
+    if constexpr(std::is_floating_point_v<T>){
+        append(data, std::bit_cast<quint64>(static_cast<double>(value)));
+    }else{
+        const T le = qToLittleEndian(value);
+        data.append(reinterpret_cast<const char*>(&le), sizeof(T));
+    }
+}
+
+template<typename T>
+void append_block(QByteArray &data, const std::vector<T> &values){
+    if constexpr(std::endian::native == std::endian::little){
+        data.append(reinterpret_cast<const char*>(values.data()), static_cast<qsizetype>(values.size()*sizeof(T)));
+    }else{
+        for(const auto &value : values){
+            append(data, value);
+        }
+    }
+}
+
+template<typename T>
+bool read_block(QDataStream &s, std::vector<T> &values){
+    if constexpr(std::endian::native == std::endian::little){
+        const int bytes = static_cast<int>(values.size()*sizeof(T));
+        return s.readRawData(reinterpret_cast<char*>(values.data()), bytes) == bytes;
+    }else{
+        for(auto &value : values){
+            s >> value;
+        }
+        return s.status() == QDataStream::Ok;
+    }
+}
+
+std::optional<QString> read_value(QDataStream &s, const std::vector<QString> &strings){
+
+    quint8 tag = 0;
+    s >> tag;
+    switch(static_cast<ValueTag>(tag)){
+    case ValueTag::String:{
+        quint32 id = 0;
+        s >> id;
+        if(id < strings.size()){
+            return strings[id];
+        }
+    }break;
+    case ValueTag::Int:{
+        qint32 value = 0;
+        s >> value;
+        return QString::number(value);
+    }
+    case ValueTag::Double:{
+        double value = 0.;
+        s >> value;
+        return QString::number(value, 'g', QLocale::FloatingPointShortest);
+    }
+    case ValueTag::IntArray:
+    case ValueTag::DoubleArray:{
+        quint32 sepId = 0, count = 0;
+        s >> sepId >> count;
+        const size_t elementSize = static_cast<ValueTag>(tag) == ValueTag::IntArray ? sizeof(qint32) : sizeof(double);
+        if(sepId >= strings.size() || count*elementSize > static_cast<size_t>(s.device()->bytesAvailable())){
+            return std::nullopt;
+        }
+
+        QStringList tokens;
+        tokens.reserve(count);
+        if(static_cast<ValueTag>(tag) == ValueTag::IntArray){
+            std::vector<qint32> values(count);
+            if(!read_block(s, values)){
+                return std::nullopt;
+            }
+            for(const auto value : values){
+                tokens << QString::number(value);
+            }
+        }else{
+            std::vector<double> values(count);
+            if(!read_block(s, values)){
+                return std::nullopt;
+            }
+            for(const auto value : values){
+                tokens << QString::number(value, 'g', QLocale::FloatingPointShortest);
+            }
+        }
+        return tokens.join(strings[sepId]);
+    }
+    }
+    return std::nullopt;
+}
+
+bool read_node(QDataStream &s, const std::vector<QString> &strings, XmlNode &node){
+
+    quint8 kind = 0;
+    s >> kind;
+    if(kind > static_cast<quint8>(XmlNode::Kind::Section)){
+        return false;
+    }
+    node.kind = static_cast<XmlNode::Kind>(kind);
+
+    if(node.kind == XmlNode::Kind::Section){
+        s >> node.sectionId;
+        return s.status() == QDataStream::Ok;
+    }
+
+    quint32 nameId = 0;
+    s >> nameId;
+    if(nameId >= strings.size()){
+        return false;
+    }
+    node.name = strings[nameId];
+    if(node.kind != XmlNode::Kind::Element){
+        return s.status() == QDataStream::Ok;
+    }
+
+    quint32 nbAttributes = 0;
+    s >> nbAttributes;
+    if(nbAttributes > s.device()->bytesAvailable()){
+        return false;
+    }
+    node.attributes.reserve(nbAttributes);
+    for(quint32 ii = 0; ii < nbAttributes; ++ii){
+        quint32 attributeId = 0;
+        s >> attributeId;
+        auto value = read_value(s, strings);
+        if(attributeId >= strings.size() || !value.has_value()){
+            return false;
+        }
+        node.attributes.emplace_back(strings[attributeId], std::move(value.value()));
+    }
+
+    quint32 nbChildren = 0;
+    s >> nbChildren;
+    if(nbChildren > s.device()->bytesAvailable()){
+        return false;
+    }
+    node.children.resize(nbChildren);
+    for(auto &child : node.children){
+        if(!read_node(s, strings, child)){
+            return false;
+        }
+    }
+    return s.status() == QDataStream::Ok;
+}
+
+}
+
+bool BinaryExperimentFile::is_binary(const QByteArray &data){
+    if(data.size() < 4){
+        return false;
+    }
+    QDataStream s(data);
+    s.setByteOrder(QDataStream::LittleEndian);
+    quint32 m = 0;
+    s >> m;
+    return m == magic;
+}
+
+QByteArray BinaryExperimentFile::from_xml(const QByteArray &xml){
+
+    BinaryExperimentWriter writer;
+    QXmlStreamReader r(xml);
+    while(!r.atEnd()){
+        switch(r.readNext()){
+        case QXmlStreamReader::StartElement:
+            writer.write_start_element(r.name().toString());
+            for(const auto &attribute : r.attributes()){
+                writer.write_attribute(attribute.qualifiedName().toString(), attribute.value().toString());
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            writer.write_end_element();
+            break;
+        case QXmlStreamReader::Characters:
+            if(!r.isWhitespace()){
+                writer.write_characters(r.text().toString());
+            }
+            break;
+        case QXmlStreamReader::Comment:
+            writer.write_comment(r.text().toString());
+            break;
+        default:
+            break;
+        }
+    }
+
+    if(r.hasError()){
+        return {};
+    }
+    return writer.finish();
+}
+
+std::optional<QByteArray> BinaryExperimentFile::to_xml(const QByteArray &binary){
+
+    BinaryExperimentFile file;
+    if(!file.open(binary)){
+        return std::nullopt;
+    }
+
+    QByteArray xml;
+    QXmlStreamWriter w(&xml);
+    w.setAutoFormatting(true);
+    if(!file.write_xml(w)){
+        return std::nullopt;
+    }
+    return xml;
+}
+
+bool BinaryExperimentFile::open(QByteArray data){
+
+    m_data = std::move(data);
+    m_strings.clear();
+    m_sections.clear();
+    m_decoded.clear();
+
+    if(m_data.size() < headerSize){
+        return false;
+    }
+
+    QDataStream s(m_data);
+    s.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 m = 0, v = 0;
+    quint64 stringsOffset = 0, sectionsOffset = 0;
+    s >> m >> v >> stringsOffset >> sectionsOffset;
+    if(m != magic || v != version || stringsOffset >= static_cast<quint64>(m_data.size()) || sectionsOffset >= static_cast<quint64>(m_data.size())){
+        return false;
+    }
+
+    s.device()->seek(static_cast<qint64>(stringsOffset));
+    quint32 nbStrings = 0;
+    s >> nbStrings;
+    if(nbStrings > s.device()->bytesAvailable()){
+        return false;
+    }
+    m_strings.reserve(nbStrings);
+    for(quint32 ii = 0; ii < nbStrings; ++ii){
+        QByteArray str;
+        s >> str;
+        m_strings.push_back(QString::fromUtf8(str));
+    }
+
+    s.device()->seek(static_cast<qint64>(sectionsOffset));
+    quint32 nbSections = 0;
+    s >> nbSections;
+    if(nbSections == 0 || nbSections > s.device()->bytesAvailable()){
+        return false;
+    }
+    m_sections.resize(nbSections);
+    for(auto &section : m_sections){
+        quint32 nameId = 0;
+        qint32 key = -1;
+        s >> nameId >> key >> section.offset >> section.size;
+        if(nameId >= m_strings.size() || section.offset + section.size > stringsOffset){
+            return false;
+        }
+        section.name = m_strings[nameId];
+        section.key  = key;
+    }
+    m_decoded.resize(nbSections);
+
+    return s.status() == QDataStream::Ok;
+}
+
+std::optional<size_t> BinaryExperimentFile::find_section(const QString &name, int key) const{
+    for(size_t ii = 0; ii < m_sections.size(); ++ii){
+        if(m_sections[ii].name == name && (key == -1 || m_sections[ii].key == key)){
+            return ii;
+        }
+    }
+    return std::nullopt;
+}
+
+const XmlNode *BinaryExperimentFile::section(size_t id){
+
+    if(id >= m_sections.size()){
+        return nullptr;
+    }
+
+    if(!m_decoded[id]){
+        QDataStream s(m_data);
+        s.setByteOrder(QDataStream::LittleEndian);
+        s.device()->seek(static_cast<qint64>(m_sections[id].offset));
+
+        auto node = std::make_unique<XmlNode>();
+        if(!read_node(s, m_strings, *node)){
+            return nullptr;
+        }
+        m_decoded[id] = std::move(node);
+    }
+    return m_decoded[id].get();
+}
+
+void BinaryExperimentFile::release_section(size_t id){
+    if(id < m_decoded.size()){
+        m_decoded[id] = nullptr;
+    }
+}
+
+size_t BinaryExperimentFile::decoded_sections_count() const noexcept{
+    return static_cast<size_t>(std::count_if(m_decoded.begin(), m_decoded.end(), [](const auto &node){
+        return node != nullptr;
+    }));
+}
+
+bool BinaryExperimentFile::write_xml(QXmlStreamWriter &w){
+
+    const auto root = section(0);
+    if(root == nullptr){
+        return false;
+    }
+
+    w.writeStartDocument();
+    for(const auto &child : root->children){
+        if(!write_node(w, child, 0)){
+            return false;
+        }
+    }
+    w.writeEndDocument();
+    return true;
+}
+
+bool BinaryExperimentFile::write_node(QXmlStreamWriter &w, const XmlNode &node, size_t sectionId){
+
+    switch(node.kind){
+    case XmlNode::Kind::Element:
+        w.writeStartElement(node.name);
+        for(const auto &attribute : node.attributes){
+            w.writeAttribute(attribute.first, attribute.second);
+        }
+        for(const auto &child : node.children){
+            if(!write_node(w, child, sectionId)){
+                return false;
+            }
+        }
+        w.writeEndElement();
+        return true;
+    case XmlNode::Kind::Text:
+        w.writeCharacters(node.name);
+        return true;
+    case XmlNode::Kind::Comment:
+        w.writeComment(node.name);
+        return true;
+    case XmlNode::Kind::Section:
+        // sub-sections are always stored after their parent, protects from cycles
+        if(node.sectionId <= sectionId){
+            return false;
+        }
+        if(auto sectionNode = section(node.sectionId); sectionNode != nullptr){
+            return write_node(w, *sectionNode, node.sectionId);
+        }
+        return false;
+    }
+    return false;
+}
+
+BinaryExperimentWriter::BinaryExperimentWriter(){
+
+    // document root is the section 0
+    m_sections.push_back(BinarySection{});
+    m_sectionsData.emplace_back();
+    m_elements.push_back(Element{});
+}
+
+void BinaryExperimentWriter::write_start_element(const QString &name){
+
+    auto &parent = add_child();
+    const auto parentSectionId = parent.sectionId;
+
+    Element element;
+    element.name = name;
+    element.sectionId = parentSectionId;
+    if(BinaryExperimentFile::sectionsElements.contains(name)){
+        element.sectionId   = static_cast<quint32>(m_sections.size());
+        element.sectionRoot = true;
+        m_sections.push_back(BinarySection{name});
+        m_sectionsData.emplace_back();
+
+        auto &data = m_sectionsData[parentSectionId];
+        append(data, static_cast<quint8>(XmlNode::Kind::Section));
+        append(data, element.sectionId);
+    }
+    m_elements.push_back(std::move(element));
+}
+
+void BinaryExperimentWriter::write_attribute(const QString &name, const QString &value){
+
+    auto &element = m_elements.back();
+    if(m_elements.size() == 1 || element.childrenCountPos >= 0){
+        // no element or attribute after a child
+        m_valid = false;
+        return;
+    }
+
+    if(element.sectionRoot && name == QStringLiteral("key")){
+        m_sections[element.sectionId].key = canonical_int(value).value_or(-1);
+    }
+    element.attributes.emplace_back(name, value);
+}
+
+void BinaryExperimentWriter::write_characters(const QString &text){
+    auto &data = m_sectionsData[add_child().sectionId];
+    append(data, static_cast<quint8>(XmlNode::Kind::Text));
+    append(data, string_id(text));
+}
+
+void BinaryExperimentWriter::write_comment(const QString &text){
+    auto &data = m_sectionsData[add_child().sectionId];
+    append(data, static_cast<quint8>(XmlNode::Kind::Comment));
+    append(data, string_id(text));
+}
+
+void BinaryExperimentWriter::write_end_element(){
+
+    if(m_elements.size() == 1){
+        m_valid = false;
+        return;
+    }
+    end_element(m_elements.back());
+    m_elements.pop_back();
+}
+
+QByteArray BinaryExperimentWriter::finish(){
+
+    if(!m_valid || m_elements.size() != 1){
+        return {};
+    }
+    end_element(m_elements.back());
+    m_valid = false; // encoded once
+
+    std::vector<quint32> sectionsNamesIds;
+    sectionsNamesIds.reserve(m_sections.size());
+    for(const auto &section : m_sections){
+        sectionsNamesIds.push_back(string_id(section.name));
+    }
+
+    QByteArray file;
+    append(file, BinaryExperimentFile::magic);
+    append(file, BinaryExperimentFile::version);
+    append(file, quint64{0});
+    append(file, quint64{0});
+
+    for(size_t ii = 0; ii < m_sections.size(); ++ii){
+        m_sections[ii].offset = static_cast<quint64>(file.size());
+        m_sections[ii].size   = static_cast<quint64>(m_sectionsData[ii].size());
+        file.append(m_sectionsData[ii]);
+        m_sectionsData[ii] = {};
+    }
+
+    const auto stringsOffset = static_cast<quint64>(file.size());
+    append(file, static_cast<quint32>(m_strings.size()));
+    for(const auto &str : m_strings){
+        const auto utf8 = str.toUtf8();
+        append(file, static_cast<quint32>(utf8.size()));
+        file.append(utf8);
+    }
+
+    const auto sectionsOffset = static_cast<quint64>(file.size());
+    append(file, static_cast<quint32>(m_sections.size()));
+    for(size_t ii = 0; ii < m_sections.size(); ++ii){
+        append(file, sectionsNamesIds[ii]);
+        append(file, static_cast<qint32>(m_sections[ii].key));
+        append(file, m_sections[ii].offset);
+        append(file, m_sections[ii].size);
+    }
+
+    qToLittleEndian(stringsOffset,  file.data() + 8);
+    qToLittleEndian(sectionsOffset, file.data() + 16);
+    return file;
+}
+
+quint32 BinaryExperimentWriter::string_id(const QString &str){
+    if(auto id = m_stringsIds.find(str); id != m_stringsIds.end()){
+        return id->second;
+    }
+    const auto id = static_cast<quint32>(m_strings.size());
+    m_stringsIds[str] = id;
+    m_strings.push_back(str);
+    return id;
+}
+
+void BinaryExperimentWriter::write_value(QByteArray &data, const QString &value, const QString &separator){
+
+    if(auto v = canonical_int(value); v.has_value()){
+        append(data, static_cast<quint8>(ValueTag::Int));
+        append(data, v.value());
+        return;
+    }
+    if(auto v = canonical_double(value); v.has_value()){
+        append(data, static_cast<quint8>(ValueTag::Double));
+        append(data, v.value());
+        return;
+    }
+
+    // arguments arrays as raw typed blocks
+    if(!separator.isEmpty() && value.contains(separator)){
+
+        const auto tokens = value.split(separator);
+        std::vector<qint32> ints;
+        ints.reserve(tokens.size());
+        for(const auto &token : tokens){
+            if(auto v = canonical_int(token); v.has_value()){
+                ints.push_back(v.value());
+            }else{
+                break;
+            }
+        }
+        if(ints.size() == static_cast<size_t>(tokens.size())){
+            append(data, static_cast<quint8>(ValueTag::IntArray));
+            append(data, string_id(separator));
+            append(data, static_cast<quint32>(ints.size()));
+            append_block(data, ints);
+            return;
+        }
+
+        std::vector<double> doubles;
+        doubles.reserve(tokens.size());
+        for(const auto &token : tokens){
+            if(auto v = canonical_double(token); v.has_value()){
+                doubles.push_back(v.value());
+            }else if(auto i = canonical_int(token); i.has_value()){
+                doubles.push_back(i.value()); // written back as an integer
+            }else{
+                break;
+            }
+        }
+        if(doubles.size() == static_cast<size_t>(tokens.size())){
+            append(data, static_cast<quint8>(ValueTag::DoubleArray));
+            append(data, string_id(separator));
+            append(data, static_cast<quint32>(doubles.size()));
+            append_block(data, doubles);
+            return;
+        }
+    }
+
+    append(data, static_cast<quint8>(ValueTag::String));
+    append(data, string_id(value));
+}
+
+void BinaryExperimentWriter::write_header(Element &element){
+
+    auto &data = m_sectionsData[element.sectionId];
+
+    QString separator;
+    for(const auto &attribute : element.attributes){
+        if(attribute.first == QStringLiteral("sep")){
+            separator = attribute.second;
+        }
+    }
+
+    append(data, static_cast<quint8>(XmlNode::Kind::Element));
+    append(data, string_id(element.name));
+    append(data, static_cast<quint32>(element.attributes.size()));
+    for(const auto &attribute : element.attributes){
+        append(data, string_id(attribute.first));
+        write_value(data, attribute.second, attribute.first == QStringLiteral("value") ? separator : QString());
+    }
+    element.attributes.clear();
+
+    // patched when the element ends
+    element.childrenCountPos = data.size();
+    append(data, quint32{0});
+}
+
+BinaryExperimentWriter::Element &BinaryExperimentWriter::add_child(){
+    auto &parent = m_elements.back();
+    if(parent.childrenCountPos < 0){
+        write_header(parent);
+    }
+    ++parent.childrenCount;
+    return parent;
+}
+
+void BinaryExperimentWriter::end_element(Element &element){
+    if(element.childrenCountPos < 0){
+        write_header(element);
+    }
+    qToLittleEndian(element.childrenCount, m_sectionsData[element.sectionId].data() + element.childrenCountPos);
+}
@@ -0,0 +1,143 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <optional>
+#include <memory>
+
+// Qt
+#include <QByteArray>
+#include <QStringList>
+#include <QXmlStreamWriter>
+
+// base
+#include "utility/unordered_map.hpp"
+
+namespace tool::ex {
+
+struct XmlNode{
+
+    enum class Kind : quint8{
+        Element = 0, Text, Comment,
+        Section         /**< reference to a lazily decoded section */
+    };
+
+    Kind kind = Kind::Element;
+    QString name;                                       /**< element name or text/comment content */
+    std::vector<std::pair<QString,QString>> attributes;
+    std::vector<XmlNode> children;
+    quint32 sectionId = 0;
+};
+
+struct BinarySection{
+    QString name;
+    int key = -1;               /**< "key" attribute of the section element */
+    quint64 offset = 0;
+    quint64 size = 0;
+};
+
+// Compact binary version of the experiment xml: interned strings, typed numeric values and
+// raw blocks for the arguments arrays. Components, routines, isis, loops, resources and settings
+// are stored in separate sections, section() decodes them only when accessed. The designer builds
+// its whole experiment model when loading a file, ExperimentStreamReader decodes them one by one.
+class BinaryExperimentFile{
+public:
+
+    static constexpr quint32 magic   = 0x42525845; // "EXRB"
+    static constexpr quint32 version = 1;
+    static inline const QStringList sectionsElements = {
+        QStringLiteral("Settings"), QStringLiteral("Resources"), QStringLiteral("Component"),
+        QStringLiteral("Routine"), QStringLiteral("Isi"), QStringLiteral("Loop"), QStringLiteral("ExperimentFlow")
+    };
+
+    static bool is_binary(const QByteArray &data);
+    static QByteArray from_xml(const QByteArray &xml);
+    static std::optional<QByteArray> to_xml(const QByteArray &binary);
+
+    // only reads the header, strings and sections tables
+    bool open(QByteArray data);
+
+    size_t sections_count() const noexcept{return m_sections.size();}
+    const BinarySection &section_info(size_t id) const{return m_sections[id];}
+    std::optional<size_t> find_section(const QString &name, int key = -1) const;
+
+    // decoded on first access, section 0 is the document root
+    const XmlNode *section(size_t id);
+    void release_section(size_t id);
+    size_t decoded_sections_count() const noexcept;
+
+    bool write_xml(QXmlStreamWriter &w);
+
+private:
+
+    bool write_node(QXmlStreamWriter &w, const XmlNode &node, size_t sectionId);
+
+    QByteArray m_data;
+    std::vector<QString> m_strings;
+    std::vector<BinarySection> m_sections;
+    std::vector<std::unique_ptr<XmlNode>> m_decoded;
+};
+
+// Streaming encoder, no document is built: each section is encoded in its own buffer as the
+// elements come and the children counts are patched when their element ends.
+class BinaryExperimentWriter{
+public:
+
+    BinaryExperimentWriter();
+
+    void write_start_element(const QString &name);
+    void write_attribute(const QString &name, const QString &value);
+    void write_characters(const QString &text);
+    void write_comment(const QString &text);
+    void write_end_element();
+
+    // whole file, empty if the elements are unbalanced or an attribute follows a child
+    QByteArray finish();
+
+private:
+
+    struct Element{
+        QString name;
+        quint32 sectionId = 0;
+        bool sectionRoot = false;
+        std::vector<std::pair<QString,QString>> attributes; /**< until the header is written */
+        qsizetype childrenCountPos = -1;                    /**< -1 while the header isn't written */
+        quint32 childrenCount = 0;
+    };
+
+    quint32 string_id(const QString &str);
+    void write_value(QByteArray &data, const QString &value, const QString &separator);
+    void write_header(Element &element);
+    Element &add_child();
+    void end_element(Element &element);
+
+    umap<QString, quint32> m_stringsIds;
+    std::vector<QString> m_strings;
+    std::vector<BinarySection> m_sections;
+    std::vector<QByteArray> m_sectionsData;
+    std::vector<Element> m_elements;
+    bool m_valid = true;
+};
+}
@@ -0,0 +1,267 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+
+#include "experiment_stream.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+void ExperimentStreamReader::set_xml(QIODevice *device){
+    m_binary = nullptr;
+    m_xml    = std::make_unique<QXmlStreamReader>(device);
+    m_token  = QXmlStreamReader::NoToken;
+}
+
+bool ExperimentStreamReader::set_binary(QByteArray data){
+
+    m_xml    = nullptr;
+    m_binary = std::make_unique<BinaryExperimentFile>();
+    m_token  = QXmlStreamReader::NoToken;
+    m_frames.clear();
+    m_node = nullptr;
+    m_sectionToRelease = std::nullopt;
+    m_elementsCount = 0;
+    m_binaryError   = !m_binary->open(std::move(data));
+    return !m_binaryError;
+}
+
+QXmlStreamReader::TokenType ExperimentStreamReader::read_next(){
+
+    if(m_xml){
+        m_token = m_xml->readNext();
+        if(m_token == QXmlStreamReader::StartElement){
+            m_xmlAttributes = m_xml->attributes();
+        }
+        return m_token;
+    }
+    if(m_binary){
+        return m_token = read_next_binary();
+    }
+    return m_token = QXmlStreamReader::Invalid;
+}
+
+QXmlStreamReader::TokenType ExperimentStreamReader::read_next_binary(){
+
+    if(m_sectionToRelease.has_value()){
+        m_binary->release_section(m_sectionToRelease.value());
+        m_sectionToRelease = std::nullopt;
+    }
+
+    auto error = [&](){
+        m_binaryError = true;
+        m_node = nullptr;
+        m_frames.clear();
+        return QXmlStreamReader::Invalid;
+    };
+
+    if(m_binaryError || m_token == QXmlStreamReader::EndDocument){
+        return QXmlStreamReader::Invalid;
+    }
+
+    if(m_token == QXmlStreamReader::NoToken){
+        if(auto root = m_binary->section(0); root != nullptr){
+            m_frames.push_back(Frame{root, 0, 0, true});
+            return QXmlStreamReader::StartDocument;
+        }
+        return error();
+    }
+
+    auto &frame = m_frames.back();
+    if(frame.nextChild < frame.node->children.size()){
+
+        const XmlNode *child = &frame.node->children[frame.nextChild++];
+        size_t sectionId     = frame.sectionId;
+        bool sectionRoot     = false;
+        if(child->kind == XmlNode::Kind::Section){
+            // sub-sections are always stored after their parent, protects from cycles
+            if(child->sectionId <= sectionId){
+                return error();
+            }
+            sectionId   = child->sectionId;
+            sectionRoot = true;
+            if(child = m_binary->section(sectionId); child == nullptr || child->kind != XmlNode::Kind::Element){
+                return error();
+            }
+        }
+
+        m_node = child;
+        switch(child->kind){
+        case XmlNode::Kind::Element:
+            ++m_elementsCount;
+            m_frames.push_back(Frame{child, sectionId, 0, sectionRoot});
+            return QXmlStreamReader::StartElement;
+        case XmlNode::Kind::Text:
+            return QXmlStreamReader::Characters;
+        case XmlNode::Kind::Comment:
+            ++m_elementsCount;
+            return QXmlStreamReader::Comment;
+        default:
+            return error();
+        }
+    }
+
+    const auto ended = m_frames.back();
+    m_frames.pop_back();
+    if(m_frames.empty()){
+        m_node = nullptr;
+        return QXmlStreamReader::EndDocument;
+    }
+
+    // the node stays valid until the next token
+    m_node = ended.node;
+    if(ended.sectionRoot){
+        m_sectionToRelease = ended.sectionId;
+    }
+    return QXmlStreamReader::EndElement;
+}
+
+bool ExperimentStreamReader::at_end() const{
+    if(m_xml){
+        return m_xml->atEnd();
+    }
+    if(m_binary){
+        return m_binaryError || m_token == QXmlStreamReader::EndDocument;
+    }
+    return true;
+}
+
+bool ExperimentStreamReader::has_error() const{
+    if(m_xml){
+        return m_xml->hasError();
+    }
+    return m_binaryError;
+}
+
+QStringView ExperimentStreamReader::name() const{
+    if(m_xml){
+        return m_xml->name();
+    }
+    if(m_node != nullptr && (is_start_element() || is_end_element())){
+        return m_node->name;
+    }
+    return {};
+}
+
+bool ExperimentStreamReader::has_attribute(const QString &name) const{
+
+    if(m_xml){
+        return m_xmlAttributes.hasAttribute(name);
+    }
+    if(m_node != nullptr && is_start_element()){
+        for(const auto &attribute : m_node->attributes){
+            if(attribute.first == name){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+QStringView ExperimentStreamReader::attribute(const QString &name) const{
+
+    if(m_xml){
+        return m_xmlAttributes.value(name);
+    }
+    if(m_node != nullptr && is_start_element()){
+        for(const auto &attribute : m_node->attributes){
+            if(attribute.first == name){
+                return attribute.second;
+            }
+        }
+    }
+    return {};
+}
+
+qint64 ExperimentStreamReader::line_number() const{
+    if(m_xml){
+        return m_xml->lineNumber();
+    }
+    return m_elementsCount + 1; // xml declaration
+}
+
+ExperimentStreamWriter::ExperimentStreamWriter(QIODevice *device, bool binary) : m_device(device){
+    if(binary){
+        m_binary = std::make_unique<BinaryExperimentWriter>();
+    }else{
+        m_xml = std::make_unique<QXmlStreamWriter>(device);
+        m_xml->setAutoFormatting(true);
+    }
+}
+
+void ExperimentStreamWriter::write_start_document(){
+    if(m_xml){
+        m_xml->writeStartDocument();
+    }
+}
+
+void ExperimentStreamWriter::write_end_document(){
+    if(m_xml){
+        m_xml->writeEndDocument();
+    }
+}
+
+void ExperimentStreamWriter::write_start_element(const QString &name){
+    if(m_binary){
+        m_binary->write_start_element(name);
+    }else{
+        m_xml->writeStartElement(name);
+    }
+}
+
+void ExperimentStreamWriter::write_attribute(const QString &name, const QString &value){
+    if(m_binary){
+        m_binary->write_attribute(name, value);
+    }else{
+        m_xml->writeAttribute(name, value);
+    }
+}
+
+void ExperimentStreamWriter::write_comment(const QString &text){
+    if(m_binary){
+        m_binary->write_comment(text);
+    }else{
+        m_xml->writeComment(text);
+    }
+}
+
+void ExperimentStreamWriter::write_end_element(){
+    if(m_binary){
+        m_binary->write_end_element();
+    }else{
+        m_xml->writeEndElement();
+    }
+}
+
+bool ExperimentStreamWriter::finish(){
+
+    if(m_xml){
+        return !m_xml->hasError();
+    }
+
+    const auto data = m_binary->finish();
+    if(data.isEmpty()){
+        return false;
+    }
+    return m_device->write(data) == data.size();
+}
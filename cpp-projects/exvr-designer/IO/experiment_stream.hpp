@@ -0,0 +1,113 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+
+#pragma once
+
+// std
+#include <memory>
+#include <optional>
+#include <vector>
+
+// Qt
+#include <QIODevice>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+// local
+#include "binary_experiment_file.hpp"
+
+namespace tool::ex {
+
+// Experiment file reader, xml or binary (.exvrb) with the subset of the QXmlStreamReader interface
+// used by the XmlIoManager. Binary sections are decoded when reached and released once read, every section
+// is reached when loading an experiment, only one of them is kept decoded at a time.
+class ExperimentStreamReader{
+public:
+
+    void set_xml(QIODevice *device);
+    bool set_binary(QByteArray data);
+
+    QXmlStreamReader::TokenType read_next();
+    bool at_end() const;
+    bool has_error() const;
+
+    bool is_start_element() const noexcept{return m_token == QXmlStreamReader::StartElement;}
+    bool is_end_element() const noexcept{return m_token == QXmlStreamReader::EndElement;}
+    QStringView name() const;
+
+    // current start element attributes
+    bool has_attribute(const QString &name) const;
+    QStringView attribute(const QString &name) const;
+
+    // binary: elements ordinal, the line of the element in the equivalent xml file
+    qint64 line_number() const;
+
+private:
+
+    QXmlStreamReader::TokenType read_next_binary();
+
+    QXmlStreamReader::TokenType m_token = QXmlStreamReader::NoToken;
+
+    // xml
+    std::unique_ptr<QXmlStreamReader> m_xml = nullptr;
+    QXmlStreamAttributes m_xmlAttributes;
+
+    // binary
+    struct Frame{
+        const XmlNode *node = nullptr;
+        size_t sectionId = 0;
+        size_t nextChild = 0;
+        bool sectionRoot = false;
+    };
+    std::unique_ptr<BinaryExperimentFile> m_binary = nullptr;
+    std::vector<Frame> m_frames;
+    const XmlNode *m_node = nullptr;
+    std::optional<size_t> m_sectionToRelease;
+    qint64 m_elementsCount = 0;
+    bool m_binaryError = false;
+};
+
+// Experiment file writer, xml or binary (.exvrb) encoded while writing
+class ExperimentStreamWriter{
+public:
+
+    ExperimentStreamWriter(QIODevice *device, bool binary);
+
+    void write_start_document();
+    void write_end_document();
+    void write_start_element(const QString &name);
+    void write_attribute(const QString &name, const QString &value);
+    void write_comment(const QString &text);
+    void write_end_element();
+
+    // binary file is written to the device at this point
+    bool finish();
+
+private:
+
+    QIODevice *m_device = nullptr;
+    std::unique_ptr<QXmlStreamWriter> m_xml = nullptr;
+    std::unique_ptr<BinaryExperimentWriter> m_binary = nullptr;
+};
+}
@@ -31,6 +31,7 @@
 #include <QDesktopServices>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QSaveFile>
 
 // base
 #include "utility/benchmark.hpp"
@@ -38,6 +39,7 @@
 
 // local
 #include "utility/path_utility.hpp"
+#include "utility/profiling_trace.hpp"
 #include "data/flow_elements/node_flow.hpp"
 
 
@@ -47,17 +49,27 @@ using namespace tool::ex;
 bool XmlIoManager::save_experiment_file(QString expFilePath){
 
     QtLogger::message(QSL("[XML] Save experiment to file: ") % expFilePath);
-    QFile expFile(expFilePath);
+    TraceGuard t("[XML::save_experiment_file]"sv);
+    QSaveFile expFile(expFilePath);
     if ( !expFile.open(QIODevice::WriteOnly) ){
         return false;
     }
     expFileToSave = expFilePath;
 
-    w = std::make_unique<QXmlStreamWriter>(&expFile);
-    w->setAutoFormatting(true);
-    w->writeStartDocument();
+    // binary files are encoded while writing
+    w = std::make_unique<ExperimentStreamWriter>(&expFile, QFileInfo(expFilePath).suffix() == QSL("exvrb"));
+    w->write_start_document();
     write_experiment();
-    w->writeEndDocument();
+    w->write_end_document();
+    const bool written = w->finish();
+    w = nullptr;
+
+    // previous file is kept if anything failed
+    if(!written || !expFile.commit()){
+        expFile.cancelWriting();
+        QtLogger::error(QSL("[XML] Cannot write experiment file: ") % expFilePath);
+        return false;
+    }
 
     return true;
 }
@@ -66,6 +78,7 @@ bool XmlIoManager::load_experiment_file(QString expFilePath){
 
     QtLogger::message(QSL("[XML] Load experiment from file: ") % expFilePath);
     BenchGuard b("[XML::load_experiment_file");
+    TraceGuard t("[XML::load_experiment_file]"sv);
 
     // set current file to load
     expFileToLoad = expFilePath;
@@ -81,16 +94,31 @@ bool XmlIoManager::load_experiment_file(QString expFilePath){
     }
 
     QFile file(expFileToLoad);
-    if(!file.open(QFile::ReadOnly | QFile::Text)){
+    bool binary = false;
+    if(file.open(QFile::ReadOnly)){
+        binary = BinaryExperimentFile::is_binary(file.peek(4));
+        if(!binary){
+            file.close();
+        }
+    }
+    if(!binary && !file.open(QFile::ReadOnly | QFile::Text)){
         QtLogger::error(QSL("[XML] Can't open experiment file with path: ") % expFileToLoad);
         return false;
     }
 
-    // unpile xml
-    r = std::make_unique<QXmlStreamReader>();
-    r->setDevice(&file);
+    // unpile xml, binary sections are read directly
+    r = std::make_unique<ExperimentStreamReader>();
+    if(binary){
+        if(!r->set_binary(file.readAll())){
+            QtLogger::error(QSL("[XML] Invalid binary experiment file: ") % expFileToLoad);
+            return false;
+        }
+    }else{
+        r->set_xml(&file);
+    }
+    m_loadedTimelines.clear();
     bool expValid = false;
-    while(!r->atEnd()){
+    while(!r->at_end()){
         if(check_start_node(QSL("Experiment"))){
             QtLogger::status(QSL("Read XML experiment file: ") % expFilePath, 2000);
             QtLogger::message(QSL("[XML] Read XML experiment file: ") % expFilePath);
@@ -98,7 +126,7 @@ bool XmlIoManager::load_experiment_file(QString expFilePath){
             QtLogger::status(QSL("XML experiment file loaded."), 2000);
             QtLogger::message(QSL("[XML] XML experiment file loaded."));
         }
-        r->readNext();
+        r->read_next();
     }
 
     // check nodes validity
@@ -106,6 +134,10 @@ bool XmlIoManager::load_experiment_file(QString expFilePath){
         QtLogger::error(QSL("[XML] Cannot read experiment xml. "));
         return false;
     }
+    if(binary && r->has_error()){
+        QtLogger::error(QSL("[XML] Corrupted binary experiment file: ") % expFileToLoad);
+        return false;
+    }
 
     // xml has been fully loaded, update path
     m_experiment->states.currentExpfilePath = expFileToLoad;
@@ -162,10 +194,10 @@ bool XmlIoManager::read_exp(){
                           QSL(" with version: ") % m_experiment->states.loadedExpDesignerVersion);
     }
 
-    r->readNext();
+    r->read_next();
 
     bool currentNodeValid   = false;
-    while(!r->atEnd()){       
+    while(!r->at_end()){       
         if(check_start_node(QSL("Settings"))){
             QtLogger::message(QSL("[XML] Read settings..."));
             if(!read_settings()){
@@ -198,7 +230,7 @@ bool XmlIoManager::read_exp(){
             currentNodeValid = true;
             break;
         }
-        r->readNext();
+        r->read_next();
     }
 
     return currentNodeValid;
@@ -209,7 +241,7 @@ std::unique_ptr<FlowElement> XmlIoManager::read_element(){
     const auto id = read_attribute<int>(QSL("key"), true);
     const auto &typeStr = read_attribute<QString>(QSL("type"), true);
     if(!id.has_value() || !typeStr.has_value()){
-        QtLogger::error(QSL("[XML] Invalid element at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid element at line: ") % QString::number(r->line_number()));
         return nullptr;
     }
     const FlowElement::Type type = FlowElement::get_type(typeStr.value().toStdString());
@@ -263,7 +295,7 @@ std::unique_ptr<FlowElement> XmlIoManager::read_element(){
     default: break;}
     }
 
-    QtLogger::error(QSL("[XML] Cannot find flow sequence element at line: ") % QString::number(r->lineNumber()) % QSL(" with id ") % QString::number(id.value()));
+    QtLogger::error(QSL("[XML] Cannot find flow sequence element at line: ") % QString::number(r->line_number()) % QSL(" with id ") % QString::number(id.value()));
 
     return nullptr;
 }
@@ -290,7 +322,7 @@ void XmlIoManager::check_read_elements(){
 
 bool XmlIoManager::check_start_node(QString nodeName){
 
-    if(r->isStartElement()){
+    if(r->is_start_element()){
         if(r->name() == nodeName){
             return true;
         }
@@ -299,7 +331,7 @@ bool XmlIoManager::check_start_node(QString nodeName){
 }
 
 bool XmlIoManager::check_end_node(QString nodeName){
-    if(r->isEndElement()){
+    if(r->is_end_element()){
         if(r->name() == nodeName){
             return true;
         }
@@ -313,22 +345,22 @@ QString XmlIoManager::invalid_bracket_error_message(int id, IdKey::Type type){
 
 void XmlIoManager::write_generator(const Generator &generator){
 
-    w->writeAttribute(QSL("g_order"), QString::number(generator.order));
+    w->write_attribute(QSL("g_order"), QString::number(generator.order));
 
     if(generator.info.has_value()){
-        w->writeAttribute(QSL("g_info"), generator.info.value());
+        w->write_attribute(QSL("g_info"), generator.info.value());
     }
     if(generator.decimals.has_value()){
-        w->writeAttribute(QSL("g_dec"), generator.decimals.value());
+        w->write_attribute(QSL("g_dec"), generator.decimals.value());
     }
     if(generator.min.has_value()){
-        w->writeAttribute(QSL("g_min"), generator.min.value());
+        w->write_attribute(QSL("g_min"), generator.min.value());
     }
     if(generator.max.has_value()){
-        w->writeAttribute(QSL("g_max"), generator.max.value());
+        w->write_attribute(QSL("g_max"), generator.max.value());
     }
     if(generator.step.has_value()){
-        w->writeAttribute(QSL("g_step"), generator.step.value());
+        w->write_attribute(QSL("g_step"), generator.step.value());
     }
 }
 
@@ -348,16 +380,16 @@ Generator XmlIoManager::read_generator(){
 
 void XmlIoManager::write_argument(const Arg &arg){
 
-    w->writeStartElement(QSL("Arg"));
-    w->writeAttribute(QSL("name"),  arg.name);
-    w->writeAttribute(QSL("ui"),    from_view(get_name(arg.associated_ui_type())));
-    w->writeAttribute(QSL("value"), arg.value());
-    w->writeAttribute(QSL("type"),  from_view(get_unity_type_string(arg.unity_type())));
+    w->write_start_element(QSL("Arg"));
+    w->write_attribute(QSL("name"),  arg.name);
+    w->write_attribute(QSL("ui"),    from_view(get_name(arg.associated_ui_type())));
+    w->write_attribute(QSL("value"), arg.value());
+    w->write_attribute(QSL("type"),  from_view(get_unity_type_string(arg.unity_type())));
     int dim = arg.dimensions_nb();
-    w->writeAttribute(QSL("dim"),   QString::number(dim));
+    w->write_attribute(QSL("dim"),   QString::number(dim));
 
     if(dim > 0){
-        w->writeAttribute(QSL("sep"), arg.separator());
+        w->write_attribute(QSL("sep"), arg.separator());
         QString sizesStr;
         for(int ii = 0; ii < arg.dimensions_nb(); ++ii){
             if(ii != 0){
@@ -365,23 +397,23 @@ void XmlIoManager::write_argument(const Arg &arg){
             }
             sizesStr += QString::number(arg.size_dimension(ii));
         }
-        w->writeAttribute(QSL("sizes"), sizesStr);
+        w->write_attribute(QSL("sizes"), sizesStr);
     }
 
     if(arg.generator.has_value()){
-        w->writeAttribute(QSL("gen"), "");
+        w->write_attribute(QSL("gen"), "");
         write_generator(arg.generator.value());
     }
 
-    w->writeEndElement();
+    w->write_end_element();
 }
 
 void XmlIoManager::write_set(const Set *set){
-    w->writeStartElement(QSL("Set"));
-    w->writeAttribute(QSL("key"),   QString::number(set->key()));
-    w->writeAttribute(QSL("name"),  set->name);
-    w->writeAttribute(QSL("occu"),  QString::number(set->occurencies));
-    w->writeEndElement();
+    w->write_start_element(QSL("Set"));
+    w->write_attribute(QSL("key"),   QString::number(set->key()));
+    w->write_attribute(QSL("name"),  set->name);
+    w->write_attribute(QSL("occu"),  QString::number(set->occurencies));
+    w->write_end_element();
 }
 
 std::tuple<std::optional<Arg>, QString> XmlIoManager::read_argument(){
@@ -400,12 +432,12 @@ std::tuple<std::optional<Arg>, QString> XmlIoManager::read_argument(){
        !type.has_value()    ||
        !value.has_value()   ||
        !ui.has_value()){
-        return {std::nullopt,QSL("Invalid arg at line: ") % QString::number(r->lineNumber())};
+        return {std::nullopt,QSL("Invalid arg at line: ") % QString::number(r->line_number())};
     }
 
     const auto uiGType= tool::ex::get_ui_type(ui.value().toStdString());
     if(!uiGType.has_value()){
-        return {std::nullopt,QSL("Invalid ui type at line: ") % QString::number(r->lineNumber())};
+        return {std::nullopt,QSL("Invalid ui type at line: ") % QString::number(r->line_number())};
     }
 
     QString separator;
@@ -421,7 +453,7 @@ std::tuple<std::optional<Arg>, QString> XmlIoManager::read_argument(){
 
     std::optional<UnityType> uType = get_unity_type(type->toStdString());
     if(!uType.has_value()){
-        return {std::nullopt,QSL("Invalid unity type type at line: ") % QString::number(r->lineNumber())};
+        return {std::nullopt,QSL("Invalid unity type type at line: ") % QString::number(r->line_number())};
     }
 
     Arg arg = Arg::generate_from_loaded_xml_values(uiGType.value(), name.value(), value.value(), separator, sizes, uType.value());
@@ -436,14 +468,14 @@ std::unique_ptr<Config> XmlIoManager::read_config(){
     const auto key      = read_attribute<int>(QSL("key"), true);
     const auto name     = read_attribute<QString>(QSL("name"), true);
     if(!key.has_value() || !name.has_value() ){
-        QtLogger::error(QSL("[XML] Invalid config at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid config at line: ") % QString::number(r->line_number()));
         return nullptr;
     }
 
     auto config = std::make_unique<Config>(name.value(), ConfigKey{key.value()});
-    r->readNext();
+    r->read_next();
 
-    while(!r->atEnd()){
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Arg"))){
             if(auto arg = read_argument(); std::get<0>(arg).has_value()){
@@ -451,7 +483,7 @@ std::unique_ptr<Config> XmlIoManager::read_config(){
             }else{
                 QtLogger::error(QSL("[XML] -> from config ") % name.value() % QSL(": ") % std::get<1>(arg));
             }
-            r->readNext();
+            r->read_next();
         }
 
         if(check_end_node(QSL("Config")) || check_end_node(QSL("InitConfig"))){
@@ -459,30 +491,30 @@ std::unique_ptr<Config> XmlIoManager::read_config(){
             return config;
         }
 
-        r->readNext();
+        r->read_next();
     }
     return nullptr;
 }
 
 void XmlIoManager::write_config(const Config *config, bool initConfig){
 
-    w->writeStartElement(initConfig ? QSL("InitConfig") : QSL("Config"));
-    w->writeAttribute(QSL("key"),  QString::number(config->key()));
-    w->writeAttribute(QSL("name"), config->name);
+    w->write_start_element(initConfig ? QSL("InitConfig") : QSL("Config"));
+    w->write_attribute(QSL("key"),  QString::number(config->key()));
+    w->write_attribute(QSL("name"), config->name);
 
     for(const auto &arg : config->args){
         write_argument(arg.second);
     }    
 
-    w->writeEndElement(); // /InitConfig or /Config
+    w->write_end_element(); // /InitConfig or /Config
 }
 
 std::vector<std::unique_ptr<Config>> XmlIoManager::read_configs(){
 
-    r->readNext();
+    r->read_next();
 
     std::vector<std::unique_ptr<Config>> readConfigs;
-    while(!r->atEnd()){
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Config"))){
             readConfigs.push_back(read_config());
@@ -492,7 +524,7 @@ std::vector<std::unique_ptr<Config>> XmlIoManager::read_configs(){
             return readConfigs;
         }
 
-        r->readNext();
+        r->read_next();
     }
     QtLogger::error(QSL("[XML] Invalid xml configs list, no end bracket."));    
     return {};
@@ -505,7 +537,7 @@ std::unique_ptr<Component> XmlIoManager::read_component(){
     auto unityName  = read_attribute<QString>(QSL("type"), true);
 
     if(!key.has_value() || !name.has_value() || !unityName.has_value()){
-        QtLogger::error(QSL("[XML] Invalid component at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid component at line: ") % QString::number(r->line_number()));
         return nullptr;
     }
 
@@ -530,7 +562,7 @@ std::unique_ptr<Component> XmlIoManager::read_component(){
         // try again with modifications
         type = Component::get_type_from_unity_name(unityNameStr.toStdString());
         if(!type.has_value()){
-            QtLogger::error(QSL("[XML] Invalid component type at line: ") % QString::number(r->lineNumber()) % QSL(" with name ") % name.value());
+            QtLogger::error(QSL("[XML] Invalid component type at line: ") % QString::number(r->line_number()) % QSL(" with name ") % name.value());
             return nullptr;
         }
     }
@@ -539,8 +571,8 @@ std::unique_ptr<Component> XmlIoManager::read_component(){
     std::unique_ptr<Config> initConfig = nullptr;
     std::vector<std::unique_ptr<Config>> configs;
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
 
         if(check_start_node(QSL("InitConfig"))){
             initConfig = read_config();
@@ -560,7 +592,7 @@ std::unique_ptr<Component> XmlIoManager::read_component(){
         }
 
 
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(invalid_bracket_error_message(key.value(), IdKey::Type::Component));
@@ -576,13 +608,13 @@ std::unique_ptr<Resource> XmlIoManager::read_resource(){
     const auto path     = read_attribute<QString>(QSL("path"), true);
 
     if(!key.has_value() || !typeStr.has_value() || !alias.has_value()  || !path.has_value()){
-        QtLogger::error(QSL("[XML] Invalid resource at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid resource at line: ") % QString::number(r->line_number()));
         return nullptr;
     }
 
     const auto type = Resource::get_type(typeStr.value().toStdString());
     if(!type.has_value()){
-        QtLogger::error(QSL("[XML] Invalid resource type at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid resource type at line: ") % QString::number(r->line_number()));
         return nullptr;
     }
 
@@ -634,33 +666,33 @@ std::unique_ptr<Resource> XmlIoManager::read_resource(){
 
 void XmlIoManager::write_component(const Component *component) {
 
-    w->writeStartElement(QSL("Component"));
-    w->writeAttribute(QSL("key"),               QString::number(component->key()));
-    w->writeAttribute(QSL("name"),              component->name());
-    w->writeAttribute(QSL("category"),          from_view(Component::get_unity_name(component->category)));
-    w->writeAttribute(QSL("type"),              from_view(Component::get_unity_name(component->type)));
-    w->writeAttribute(QSL("global"),            Component::is_global(component->type) ? QSL("1") : QSL("0"));
-    w->writeAttribute(QSL("always_updating"),   Component::is_alsways_updating(component->type) ? QSL("1") : QSL("0"));
-    w->writeAttribute(QSL("exceptions"),        Component::get_exceptions(component->type) ? QSL("1") : QSL("0"));
-    w->writeAttribute(QSL("frame_logging"),     Component::has_frame_logging(component->type) ? QSL("1") : QSL("0"));
-    w->writeAttribute(QSL("trigger_logging"),   Component::has_trigger_logging(component->type) ? QSL("1") : QSL("0"));
-    w->writeAttribute(QSL("restricted"),        QString::number(static_cast<int>(Component::get_restricted(component->type))));
-    w->writeAttribute(QSL("priority"),          QString::number(static_cast<int>(Component::get_priority(component->type))));
+    w->write_start_element(QSL("Component"));
+    w->write_attribute(QSL("key"),               QString::number(component->key()));
+    w->write_attribute(QSL("name"),              component->name());
+    w->write_attribute(QSL("category"),          from_view(Component::get_unity_name(component->category)));
+    w->write_attribute(QSL("type"),              from_view(Component::get_unity_name(component->type)));
+    w->write_attribute(QSL("global"),            Component::is_global(component->type) ? QSL("1") : QSL("0"));
+    w->write_attribute(QSL("always_updating"),   Component::is_alsways_updating(component->type) ? QSL("1") : QSL("0"));
+    w->write_attribute(QSL("exceptions"),        Component::get_exceptions(component->type) ? QSL("1") : QSL("0"));
+    w->write_attribute(QSL("frame_logging"),     Component::has_frame_logging(component->type) ? QSL("1") : QSL("0"));
+    w->write_attribute(QSL("trigger_logging"),   Component::has_trigger_logging(component->type) ? QSL("1") : QSL("0"));
+    w->write_attribute(QSL("restricted"),        QString::number(static_cast<int>(Component::get_restricted(component->type))));
+    w->write_attribute(QSL("priority"),          QString::number(static_cast<int>(Component::get_priority(component->type))));
 
     write_config(component->initConfig.get(), true);
-    w->writeStartElement(QSL("Configs"));
+    w->write_start_element(QSL("Configs"));
     for(const auto &config : component->configs){
         write_config(config.get());
     }
-    w->writeEndElement(); // /Configs
-    w->writeEndElement(); // /Component
+    w->write_end_element(); // /Configs
+    w->write_end_element(); // /Component
 }
 
 void XmlIoManager::write_interval(const Interval &interval){
-    w->writeStartElement(QSL("Interval"));
-    w->writeAttribute(QSL("t1"),     QString::number(interval.start.v));
-    w->writeAttribute(QSL("t2"),     QString::number(interval.end.v));
-    w->writeEndElement(); // /Interval
+    w->write_start_element(QSL("Interval"));
+    w->write_attribute(QSL("t1"),     QString::number(interval.start.v));
+    w->write_attribute(QSL("t2"),     QString::number(interval.end.v));
+    w->write_end_element(); // /Interval
 }
 
 std::optional<Interval> XmlIoManager::read_interval(){
@@ -668,16 +700,17 @@ std::optional<Interval> XmlIoManager::read_interval(){
     const auto start = read_attribute<double>(QSL("t1"), true);
     const auto end   = read_attribute<double>(QSL("t2"), true);
     if(!start.has_value() || !end.has_value()){
-        QtLogger::error(QSL("[XML] Invalid interval at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid interval at line: ") % QString::number(r->line_number()));
         return {};
     }
     return Interval{SecondsTS{start.value()}, SecondsTS{end.value()}};
 }
 
-void XmlIoManager::write_timeline(const Timeline *timeline){
+void XmlIoManager::write_timeline(const Timeline *timeline, int key){
 
-    w->writeStartElement(QSL("Timeline"));
-    w->writeAttribute(QSL("type"), (timeline->type == Timeline::Update ? QSL("Update") : QSL("Visibiliy")));
+    w->write_start_element(QSL("Timeline"));
+    w->write_attribute(QSL("key"),  QString::number(key));
+    w->write_attribute(QSL("type"), (timeline->type == Timeline::Update ? QSL("Update") : QSL("Visibiliy")));
 
     double min = std::numeric_limits<double>::max();
     double max = 0.;
@@ -690,57 +723,62 @@ void XmlIoManager::write_timeline(const Timeline *timeline){
         }
     }
     if(timeline->intervals.size() > 0){
-        w->writeComment(QSL("Starts at ") % QString::number(min) % QSL("(s) and ends at ") % QString::number(max) % QSL("s(), duration: ") % QString::number(max-min) % QSL("(s) "));
+        w->write_comment(QSL("Starts at ") % QString::number(min) % QSL("(s) and ends at ") % QString::number(max) % QSL("s(), duration: ") % QString::number(max-min) % QSL("(s) "));
     }
 
     for(const auto &interval : timeline->intervals){
         write_interval(interval);
     }
-    w->writeEndElement(); // /Timeline
+    w->write_end_element(); // /Timeline
 }
 
-std::unique_ptr<Timeline> XmlIoManager::read_timeline(){
+std::optional<CowData<Timeline>> XmlIoManager::read_timeline(){
 
     const auto typeStr = read_attribute<QString>(QSL("type"), true);
 
     if(!typeStr.has_value()){
-        QtLogger::error(QSL("[XML] Invalid timeline at line: ") % QString::number(r->lineNumber()));
-        return nullptr;
+        QtLogger::error(QSL("[XML] Invalid timeline at line: ") % QString::number(r->line_number()));
+        return std::nullopt;
     }
 
     const auto type = typeStr.value() == QSL("Update") ? Timeline::Update : Timeline::Visibility;
-    auto timeline = std::make_unique<Timeline>(type);
+    Timeline timeline(type);
 
     // read attributes
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
         if(check_start_node(QSL("Interval"))){
             if(auto interval = read_interval(); interval.has_value()){
-                timeline->intervals.emplace_back(std::move(interval.value()));
+                timeline.intervals.emplace_back(std::move(interval.value()));
             }
         }else if(check_end_node(QSL("Timeline"))){
-            return timeline;
+            // identical timelines share their data
+            const QString id = typeStr.value() % timeline.to_string();
+            if(auto shared = m_loadedTimelines.find(id); shared != m_loadedTimelines.end()){
+                return shared->second;
+            }
+            return m_loadedTimelines.emplace(id, CowData<Timeline>(std::move(timeline))).first->second;
         }
 
-        r->readNext();
+        r->read_next();
     }
 
-    return nullptr;
+    return std::nullopt;
 }
 
 void XmlIoManager::write_action(const Action *action) {
 
-    w->writeStartElement(QSL("Action"));
-    w->writeAttribute(QSL("key"),           QString::number(action->key()));
-    w->writeAttribute(QSL("key_component"), QString::number(action->component->key()));
-    w->writeAttribute(QSL("key_config"),    QString::number(action->config->key()));
-    w->writeAttribute(QSL("node_used"),     action->nodeUsed ? QSL("1") : QSL("0"));
-    w->writeAttribute(QSL("node_position"), QString::number(action->nodePosition.x()) % QSL(" ") % QString::number(action->nodePosition.y()));
+    w->write_start_element(QSL("Action"));
+    w->write_attribute(QSL("key"),           QString::number(action->key()));
+    w->write_attribute(QSL("key_component"), QString::number(action->component->key()));
+    w->write_attribute(QSL("key_config"),    QString::number(action->config->key()));
+    w->write_attribute(QSL("node_used"),     action->nodeUsed ? QSL("1") : QSL("0"));
+    w->write_attribute(QSL("node_position"), QString::number(action->nodePosition.x()) % QSL(" ") % QString::number(action->nodePosition.y()));
+    w->write_attribute(QSL("key_timeline_update"),     QString::number(m_writtenTimelinesKeys.at(action->timelineUpdate.id())));
+    w->write_attribute(QSL("key_timeline_visibility"), QString::number(m_writtenTimelinesKeys.at(action->timelineVisibility.id())));
 
-    w->writeComment(QSL("Component ") % action->component->name() % QSL(" with config ") % action->config->name % QSL(" "));
-    write_timeline(action->timelineUpdate.get());
-    write_timeline(action->timelineVisibility.get());
-    w->writeEndElement(); // /Action
+    w->write_comment(QSL("Component ") % action->component->name() % QSL(" with config ") % action->config->name % QSL(" "));
+    w->write_end_element(); // /Action
 }
 
 void XmlIoManager::write_connection(const Condition *condition, const Connection *connection){
@@ -783,37 +821,37 @@ void XmlIoManager::write_connection(const Condition *condition, const Connection
         }
     }
 
-    w->writeComment(QSL("Connection between ") %
+    w->write_comment(QSL("Connection between ") %
         QSL("Key") % QString::number(connection->startKey) % QSL(":") % startType % QSL(":") % startName % QSL(":Port") +
                      QString::number(connection->startIndex) + " and " +
         QSL("Key") % QString::number(connection->endKey)   % QSL(":") % endType % QSL(":") % endName % QSL(":Port") +
                      QString::number(connection->endIndex) % QSL(" "));
 
-    w->writeStartElement(QSL("Connection"));
-    w->writeAttribute(QSL("key"),      QString::number(connection->key()));
-    w->writeAttribute(QSL("out_type"), connection->startType == Connection::Type::Component ? QSL("component") : QSL("connector"));
-    w->writeAttribute(QSL("out_key"),  QString::number(connection->startKey));
-    w->writeAttribute(QSL("signal_id"),QString::number(connection->startIndex));
-    w->writeAttribute(QSL("out_data_type"),  connection->startDataType);
-    w->writeAttribute(QSL("signal"),   connection->signal);
+    w->write_start_element(QSL("Connection"));
+    w->write_attribute(QSL("key"),      QString::number(connection->key()));
+    w->write_attribute(QSL("out_type"), connection->startType == Connection::Type::Component ? QSL("component") : QSL("connector"));
+    w->write_attribute(QSL("out_key"),  QString::number(connection->startKey));
+    w->write_attribute(QSL("signal_id"),QString::number(connection->startIndex));
+    w->write_attribute(QSL("out_data_type"),  connection->startDataType);
+    w->write_attribute(QSL("signal"),   connection->signal);
 
-    w->writeAttribute(QSL("in_type"),  connection->endType == Connection::Type::Component ? QSL("component") : QSL("connector"));
-    w->writeAttribute(QSL("in_key"),   QString::number(connection->endKey));
-    w->writeAttribute(QSL("slot_id"),  QString::number(connection->endIndex));
-    w->writeAttribute(QSL("in_data_type"),   connection->endDataType);
-    w->writeAttribute(QSL("slot"),     connection->slot);
+    w->write_attribute(QSL("in_type"),  connection->endType == Connection::Type::Component ? QSL("component") : QSL("connector"));
+    w->write_attribute(QSL("in_key"),   QString::number(connection->endKey));
+    w->write_attribute(QSL("slot_id"),  QString::number(connection->endIndex));
+    w->write_attribute(QSL("in_data_type"),   connection->endDataType);
+    w->write_attribute(QSL("slot"),     connection->slot);
 
-    w->writeEndElement(); // /Connection
+    w->write_end_element(); // /Connection
 }
 
 void XmlIoManager::write_connector(const Connector *connector){
 
-    w->writeStartElement(QSL("Connector"));
-    w->writeAttribute(QSL("key"), QString::number(connector->key()));
-    w->writeAttribute(QSL("name"), connector->name);
-    w->writeAttribute(QSL("node_position"), QString::number(connector->pos.x()) % QSL(" ") % QString::number(connector->pos.y()));   
-    write_argument(connector->arg);
-    w->writeEndElement(); // /Connector
+    w->write_start_element(QSL("Connector"));
+    w->write_attribute(QSL("key"), QString::number(connector->key()));
+    w->write_attribute(QSL("name"), connector->name);
+    w->write_attribute(QSL("node_position"), QString::number(connector->pos.x()) % QSL(" ") % QString::number(connector->pos.y()));   
+    w->write_attribute(QSL("key_arg"), QString::number(m_writtenConnectorsArgsKeys.at(connector->arg.id())));
+    w->write_end_element(); // /Connector
 }
 
 
@@ -824,17 +862,17 @@ std::tuple<std::unique_ptr<Action>, QString> XmlIoManager::read_action(){
     const auto configKey    = read_attribute<int>(QSL("key_config"), true);
 
     if(!key.has_value() || !keyComponent.has_value() || !configKey.has_value()){
-        return {nullptr, QSL("Invalid action at line: ") % QString::number(r->lineNumber())};
+        return {nullptr, QSL("Invalid action at line: ") % QString::number(r->line_number())};
     }
 
     Component *actionComponent = m_experiment->get_component(ComponentKey{keyComponent.value()});
     if(actionComponent == nullptr){
-        return {nullptr, QSL("Invalid action at line: ") % QString::number(r->lineNumber()) % QSL(", cannot found component with key ") % QString::number(keyComponent.value())};
+        return {nullptr, QSL("Invalid action at line: ") % QString::number(r->line_number()) % QSL(", cannot found component with key ") % QString::number(keyComponent.value())};
     }
 
     Config *actionConfig = actionComponent->get_config(ConfigKey{configKey.value()});
     if(actionConfig == nullptr){
-        return {nullptr, QSL("Invalid action at line: ") % QString::number(r->lineNumber()) % QSL(", cannot found config with key ") % QString::number(configKey.value())};
+        return {nullptr, QSL("Invalid action at line: ") % QString::number(r->line_number()) % QSL(", cannot found config with key ") % QString::number(configKey.value())};
     }
 
     std::unique_ptr<Action> action = std::make_unique<Action>(actionComponent, actionConfig, ActionKey{key.value()});
@@ -844,16 +882,27 @@ std::tuple<std::unique_ptr<Action>, QString> XmlIoManager::read_action(){
         action->nodePosition = QPointF(split[0].toDouble(), split[1].toDouble());
     }
 
-    r->readNext();
-    while(!r->atEnd()){
+    // timelines defined once in the routine
+    for(auto [name, timeline] : {std::make_pair(QSL("key_timeline_update"), &action->timelineUpdate), std::make_pair(QSL("key_timeline_visibility"), &action->timelineVisibility)}){
+        if(const auto timelineKey = read_attribute<int>(name, false); timelineKey.has_value()){
+            if(auto shared = m_routineTimelines.find(timelineKey.value()); shared != m_routineTimelines.end()){
+                *timeline = shared->second;
+            }else{
+                return {nullptr, QSL("Invalid action at line: ") % QString::number(r->line_number()) % QSL(", cannot found timeline with key ") % QString::number(timelineKey.value())};
+            }
+        }
+    }
+
+    r->read_next();
+    while(!r->at_end()){
 
-        if(check_start_node("Timeline")){
+        if(check_start_node("Timeline")){ // legacy, timelines inside the action
 
-            if(auto timeline = read_timeline(); timeline != nullptr){
-                if(timeline->type == Timeline::Type::Update){
-                    action->timelineUpdate     = std::move(timeline);
+            if(auto timeline = read_timeline(); timeline.has_value()){
+                if(timeline.value()->type == Timeline::Type::Update){
+                    action->timelineUpdate     = std::move(timeline.value());
                 }else{
-                    action->timelineVisibility = std::move(timeline);
+                    action->timelineVisibility = std::move(timeline.value());
                 }
             }
 
@@ -861,7 +910,7 @@ std::tuple<std::unique_ptr<Action>, QString> XmlIoManager::read_action(){
             return {std::move(action), ""};
         }
 
-        r->readNext();
+        r->read_next();
     }
 
     return {nullptr, invalid_bracket_error_message(key.value(), IdKey::Type::Action)};
@@ -970,7 +1019,7 @@ std::tuple<std::unique_ptr<Connector>, QString> XmlIoManager::read_connector(){
     if(!key.has_value()          ||
        !name.has_value()         ||
        !nodePosStr.has_value()){
-        return {nullptr,QSL("invalid connector at line: ") % QString::number(r->lineNumber())};
+        return {nullptr,QSL("invalid connector at line: ") % QString::number(r->line_number())};
     }
 
     // for converting legacy
@@ -997,17 +1046,29 @@ std::tuple<std::unique_ptr<Connector>, QString> XmlIoManager::read_connector(){
 
     auto typeFromStr = Connector::get_type_from_name(name.value().toStdString());
     if(!typeFromStr.has_value()){
-        return {nullptr,QSL("invalid connector type at line: ") % QString::number(r->lineNumber()) % QSL(" (") % name.value() % QSL(")")};
+        return {nullptr,QSL("invalid connector type at line: ") % QString::number(r->line_number()) % QSL(" (") % name.value() % QSL(")")};
     }
 
     auto split               = nodePosStr.value().split(" ");
     const auto nodePosition  = QPointF(split[0].toDouble(), split[1].toDouble());
 
-    while(!r->atEnd()){
+    // argument defined once in the routine
+    if(const auto argKey = read_attribute<int>(QSL("key_arg"), false); argKey.has_value()){
+        if(auto shared = m_routineConnectorsArgs.find(argKey.value()); shared != m_routineConnectorsArgs.end()){
+            return {
+                std::make_unique<Connector>(ConnectorKey{key.value()}, typeFromStr.value(), name.value(), nodePosition, shared->second),
+                ""
+            };
+        }
+        return {nullptr, QSL("invalid connector at line: ") % QString::number(r->line_number()) % QSL(", cannot found argument with key ") % QString::number(argKey.value())};
+    }
+
+    // legacy, argument inside the connector
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Arg"))){
             if(auto arg = read_argument(); std::get<0>(arg).has_value()){
-                r->readNext();                               
+                r->read_next();                               
 
                 return {
                     std::make_unique<Connector>(ConnectorKey{key.value()}, typeFromStr.value(), name.value(), nodePosition, std::move(std::get<0>(arg).value())),
@@ -1016,31 +1077,31 @@ std::tuple<std::unique_ptr<Connector>, QString> XmlIoManager::read_connector(){
             }
             break;
         }
-        r->readNext();
+        r->read_next();
     }
 
-    return {nullptr, QSL("invalid connector at line: ") % QString::number(r->lineNumber()) % QSL(", no argument found.")};
+    return {nullptr, QSL("invalid connector at line: ") % QString::number(r->line_number()) % QSL(", no argument found.")};
 }
 
 void XmlIoManager::write_condition(const Condition *condition){
 
-    w->writeStartElement(QSL("Condition"));
-    w->writeAttribute(QSL("key"), QString::number(condition->key()));
-    w->writeAttribute(QSL("name"), condition->name);
+    w->write_start_element(QSL("Condition"));
+    w->write_attribute(QSL("key"), QString::number(condition->key()));
+    w->write_attribute(QSL("name"), condition->name);
 
     if(!m_debugNoDuration){
-        w->writeAttribute(QSL("duration"),  QString::number(condition->duration.v));
+        w->write_attribute(QSL("duration"),  QString::number(condition->duration.v));
     }else{
-        w->writeAttribute(QSL("duration"),  "0.2");
+        w->write_attribute(QSL("duration"),  "0.2");
     }
-    w->writeAttribute(QSL("ui_scale"),  QString::number(condition->scale));
-    w->writeAttribute(QSL("ui_size"),   QString::number(condition->uiFactorSize));
+    w->write_attribute(QSL("ui_scale"),  QString::number(condition->scale));
+    w->write_attribute(QSL("ui_size"),   QString::number(condition->uiFactorSize));
 
     QStringList setsKeys;
     for(const auto &setKey : condition->setsKeys){
         setsKeys << QString::number(setKey.v);
     }
-    w->writeAttribute(QSL("sets_keys"), setsKeys.join("-"));
+    w->write_attribute(QSL("sets_keys"), setsKeys.join("-"));
 
     // find the longest timeline for every action
     double min = std::numeric_limits<double>::max();
@@ -1086,7 +1147,7 @@ void XmlIoManager::write_condition(const Condition *condition){
         write_connection(condition, connection.get());
     }
 
-    w->writeEndElement(); // /Condition
+    w->write_end_element(); // /Condition
 }
 
 
@@ -1103,7 +1164,7 @@ std::unique_ptr<Condition> XmlIoManager::read_condition(Routine *routine){
        !duration.has_value()    ||
        !uiScale.has_value()     ||
        !uiSize.has_value()){
-        QtLogger::error(QSL("[XML] -> from routine ") % routine->name() % QSL(": invalid condition at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] -> from routine ") % routine->name() % QSL(": invalid condition at line: ") % QString::number(r->line_number()));
         return {};
     }
 
@@ -1116,8 +1177,8 @@ std::unique_ptr<Condition> XmlIoManager::read_condition(Routine *routine){
         }
     }
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Action"))){
 
@@ -1147,7 +1208,7 @@ std::unique_ptr<Condition> XmlIoManager::read_condition(Routine *routine){
 //            std::reverse(condition->actions.begin(), condition->actions.end());
             return condition;
         }
-        r->readNext();
+        r->read_next();
     }
 
     return nullptr;
@@ -1159,28 +1220,30 @@ void XmlIoManager::write_element(const FlowElement *element){
         return;
     }
 
-    w->writeStartElement(QSL("Element"));
-    w->writeAttribute(QSL("key"),  QString::number(element->key()));
-    w->writeAttribute(QSL("type"), from_view(FlowElement::get_type_name(element->type())));
-    w->writeEndElement(); // /Element
+    w->write_start_element(QSL("Element"));
+    w->write_attribute(QSL("key"),  QString::number(element->key()));
+    w->write_attribute(QSL("type"), from_view(FlowElement::get_type_name(element->type())));
+    w->write_end_element(); // /Element
 }
 
 void XmlIoManager::write_loop(const Loop *loop) {
 
-    w->writeStartElement(QSL("Loop"));
-    w->writeAttribute(QSL("key"), QString::number(loop->key()));
-    w->writeAttribute(QSL("name"), loop->name());
-    w->writeAttribute(QSL("type"), from_view(Loop::get_name(loop->mode)));
-    w->writeAttribute(QSL("nbReps"), QString::number(loop->nbReps));
-    w->writeAttribute(QSL("N"), QString::number(loop->N));
-    w->writeAttribute(QSL("noFollowingValues"), loop->noFollowingValues ? "1" : "0");
-    w->writeAttribute(QSL("informations"), loop->informations);
+    w->write_start_element(QSL("Loop"));
+    w->write_attribute(QSL("key"), QString::number(loop->key()));
+    w->write_attribute(QSL("name"), loop->name());
+    w->write_attribute(QSL("type"), from_view(Loop::get_name(loop->mode)));
+    w->write_attribute(QSL("nbReps"), QString::number(loop->nbReps));
+    w->write_attribute(QSL("N"), QString::number(loop->N));
+    w->write_attribute(QSL("noFollowingValues"), loop->noFollowingValues ? "1" : "0");
+    w->write_attribute(QSL("maxRepeats"), QString::number(loop->maxRepeats));
+    w->write_attribute(QSL("minDistance"), QString::number(loop->minDistance));
+    w->write_attribute(QSL("informations"), loop->informations);
 
     for(const auto &set : loop->sets){
         write_set(set.get());
     }
 
-    w->writeEndElement(); // /Loop
+    w->write_end_element(); // /Loop
 }
 
 std::tuple<std::unique_ptr<LoopNode>, std::unique_ptr<Loop>, std::unique_ptr<LoopNode>> XmlIoManager::read_loop(){
@@ -1191,7 +1254,7 @@ std::tuple<std::unique_ptr<LoopNode>, std::unique_ptr<Loop>, std::unique_ptr<Loo
     if(!key.has_value()         ||
        !type.has_value()        ||
        !name.has_value()){
-        QtLogger::error(QSL("[XML] Invalid Loop at line: ") + QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid Loop at line: ") + QString::number(r->line_number()));
         return std::make_tuple(nullptr,nullptr,nullptr);
     }
 
@@ -1203,12 +1266,14 @@ std::tuple<std::unique_ptr<LoopNode>, std::unique_ptr<Loop>, std::unique_ptr<Loo
     if(auto mode = Loop::get_mode(type.value().toStdString()); mode.has_value()){
         loop->mode = mode.value();
     }else{
-        QtLogger::error(QSL("[XML] Invalid Loop type at line: ") + QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid Loop type at line: ") + QString::number(r->line_number()));
         return std::make_tuple(nullptr,nullptr,nullptr);
     }
 
     assign_attribute(loop->nbReps,            QSL("nbReps"),            true);
     assign_attribute(loop->N,                 QSL("N"),                 false);
+    assign_attribute(loop->maxRepeats,        QSL("maxRepeats"),        false);
+    assign_attribute(loop->minDistance,       QSL("minDistance"),       false);
 
     if(auto noFollowingValues = read_attribute<bool>(QSL("noFollowingValues"), false); noFollowingValues.has_value()){
         loop->noFollowingValues = noFollowingValues.value();
@@ -1230,22 +1295,22 @@ std::tuple<std::unique_ptr<LoopNode>, std::unique_ptr<Loop>, std::unique_ptr<Loo
 
 
     // new set system
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Set"))){
 
             if(auto set = read_set(); set != nullptr){
                 loop->sets.push_back(std::move(set));
             }
-            r->readNext();
+            r->read_next();
         }
 
         if(check_end_node(QSL("Loop"))){
             return std::make_tuple(std::move(startLoop), std::move(loop), std::move(endLoop));
         }
 
-        r->readNext();
+        r->read_next();
     }
     return {nullptr,nullptr,nullptr};
 }
@@ -1259,7 +1324,7 @@ std::unique_ptr<Set> XmlIoManager::read_set(){
     if(!key.has_value()     ||
        !name.has_value()    ||
        !occu.has_value()){
-        QtLogger::error(QSL("[XML] Invalid set at line: ") + QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid set at line: ") + QString::number(r->line_number()));
         return nullptr;
     }
 
@@ -1268,133 +1333,161 @@ std::unique_ptr<Set> XmlIoManager::read_set(){
 
 void XmlIoManager::write_routine(const Routine *routine){
 
-    w->writeStartElement(QSL("Routine"));
-    w->writeAttribute(QSL("key"), QString::number(routine->key()));
-    w->writeAttribute(QSL("name"), routine->name());
-    w->writeAttribute(QSL("randomizer"), routine->isARandomizer ? "1" : "0");
-    w->writeAttribute(QSL("informations"), routine->informations);
+    w->write_start_element(QSL("Routine"));
+    w->write_attribute(QSL("key"), QString::number(routine->key()));
+    w->write_attribute(QSL("name"), routine->name());
+    w->write_attribute(QSL("randomizer"), routine->isARandomizer ? "1" : "0");
+    w->write_attribute(QSL("informations"), routine->informations);
+
+    // timelines and connectors arguments shared between actions and connectors are written once
+    m_writtenTimelinesKeys.clear();
+    m_writtenConnectorsArgsKeys.clear();
+    for(const auto &cond : routine->conditions){
+        for(const auto &action : cond->actions){
+            for(const auto timeline : {&action->timelineUpdate, &action->timelineVisibility}){
+                const int timelineKey = static_cast<int>(m_writtenTimelinesKeys.size());
+                if(m_writtenTimelinesKeys.emplace(timeline->id(), timelineKey).second){
+                    write_timeline(&timeline->get(), timelineKey);
+                }
+            }
+        }
+    }
+    for(const auto &cond : routine->conditions){
+        for(const auto &connector : cond->connectors){
+            const int argKey = static_cast<int>(m_writtenConnectorsArgsKeys.size());
+            if(m_writtenConnectorsArgsKeys.emplace(connector->arg.id(), argKey).second){
+                w->write_start_element(QSL("ConnectorArg"));
+                w->write_attribute(QSL("key"), QString::number(argKey));
+                write_argument(connector->arg.get());
+                w->write_end_element(); // /ConnectorArg
+            }
+        }
+    }
 
     for(const auto &cond : routine->conditions){
         write_condition(cond.get());
     }
 
-    w->writeEndElement(); // /Routine
+    w->write_end_element(); // /Routine
 }
 
 void XmlIoManager::write_settings(){
 
     auto settings = m_experiment->settings();
 
-    w->writeStartElement(QSL("Settings"));{
+    w->write_start_element(QSL("Settings"));{
 
-        w->writeAttribute(QSL("debug"), settings->debug ? "1" : "0");
-        w->writeAttribute(QSL("csharp_debug_info"), settings->csharpAddDebugInfo? "1" : "0");
-        w->writeAttribute(QSL("catch_components_exceptions"), settings->catchComponentsExceptions ? "1" : "0");
-        w->writeAttribute(QSL("positional_tracking"), settings->positionalTracking ? "1" : "0");
-        w->writeAttribute(QSL("catch_external_keyboard_events"), settings->catchExternalKeyboardKeysEvents ? "1" : "0");
+        w->write_attribute(QSL("debug"), settings->debug ? "1" : "0");
+        w->write_attribute(QSL("csharp_debug_info"), settings->csharpAddDebugInfo? "1" : "0");
+        w->write_attribute(QSL("catch_components_exceptions"), settings->catchComponentsExceptions ? "1" : "0");
+        w->write_attribute(QSL("positional_tracking"), settings->positionalTracking ? "1" : "0");
+        w->write_attribute(QSL("catch_external_keyboard_events"), settings->catchExternalKeyboardKeysEvents ? "1" : "0");
 
-        w->writeStartElement(QSL("Display"));{
-            w->writeAttribute(QSL("mode"), QString::number(static_cast<int>(settings->displayMode)));
-            w->writeAttribute(QSL("stereo_fov"), QString::number(static_cast<int>(settings->stereoCameraFOV)));
-            w->writeAttribute(QSL("fullscreen"), settings->fullscreen ? "1" : "0");
-            w->writeAttribute(QSL("monitor_id"), QString::number(static_cast<int>(settings->monitorId)));
-            w->writeAttribute(QSL("resolution_id"), QString::number(static_cast<int>(settings->resolutionId)));
-            w->writeAttribute(QSL("custom_width"), QString::number(static_cast<int>(settings->customWidth)));
-            w->writeAttribute(QSL("custom_height"), QString::number(static_cast<int>(settings->customHeight)));
-        }w->writeEndElement(); // /Display
+        w->write_start_element(QSL("Display"));{
+            w->write_attribute(QSL("mode"), QString::number(static_cast<int>(settings->displayMode)));
+            w->write_attribute(QSL("stereo_fov"), QString::number(static_cast<int>(settings->stereoCameraFOV)));
+            w->write_attribute(QSL("fullscreen"), settings->fullscreen ? "1" : "0");
+            w->write_attribute(QSL("monitor_id"), QString::number(static_cast<int>(settings->monitorId)));
+            w->write_attribute(QSL("resolution_id"), QString::number(static_cast<int>(settings->resolutionId)));
+            w->write_attribute(QSL("custom_width"), QString::number(static_cast<int>(settings->customWidth)));
+            w->write_attribute(QSL("custom_height"), QString::number(static_cast<int>(settings->customHeight)));
+        }w->write_end_element(); // /Display
 
-        w->writeStartElement(QSL("Camera"));{
-            w->writeAttribute(QSL("neutral_x"), settings->neutralX ? "1" : "0");
-            w->writeAttribute(QSL("neutral_y"), settings->neutralY ? "1" : "0");
-            w->writeAttribute(QSL("neutral_z"), settings->neutralZ ? "1" : "0");
-        }w->writeEndElement(); // /Camera
+        w->write_start_element(QSL("Camera"));{
+            w->write_attribute(QSL("neutral_x"), settings->neutralX ? "1" : "0");
+            w->write_attribute(QSL("neutral_y"), settings->neutralY ? "1" : "0");
+            w->write_attribute(QSL("neutral_z"), settings->neutralZ ? "1" : "0");
+        }w->write_end_element(); // /Camera
 
-    }w->writeEndElement(); // /Settings
+    }w->write_end_element(); // /Settings
 }
 
 void XmlIoManager::write_resources(){
 
     auto resM = &m_experiment->resM;
 
-    w->writeStartElement(QSL("Resources")); 
-    w->writeAttribute(QSL("reload"), QString::number(resM->reload_code()));
+    w->write_start_element(QSL("Resources")); 
+    w->write_attribute(QSL("reload"), QString::number(resM->reload_code()));
+
+    // same destinations than the resources exporter, names collisions included
+    const auto exportPaths = resM->exportMode ? ResourcesExporter::generate_export_paths(*resM) : umap<int, QString>{};
 
     for(const auto resT : Resource::get_types()){
 
         const QString typeN = std::string(Resource::get_name(resT)).c_str();
         for(const auto &resource : resM->get_resources(resT)){
-            w->writeStartElement(QSL("Resource"));
-            w->writeAttribute(QSL("key"),       QString::number(resource->key()));
-            w->writeAttribute(QSL("type"),      typeN);
-            w->writeAttribute(QSL("alias"),     resource->alias);
+            w->write_start_element(QSL("Resource"));
+            w->write_attribute(QSL("key"),       QString::number(resource->key()));
+            w->write_attribute(QSL("type"),      typeN);
+            w->write_attribute(QSL("alias"),     resource->alias);
 
             if(!resM->exportMode){
                 if(QFileInfo(resource->path).exists()){ // write relative path if possible
                     auto dir = QFileInfo(expFileToSave).absoluteDir();
-                    w->writeAttribute(QSL("path"),      dir.relativeFilePath(resource->path));
+                    w->write_attribute(QSL("path"),      dir.relativeFilePath(resource->path));
                 }else{
-                    w->writeAttribute(QSL("path"),      resource->path);
+                    w->write_attribute(QSL("path"),      resource->path);
                 }
             }else{
-                w->writeAttribute(QSL("path"),  "./resources/" + typeN + "/" + resource->path.split("/").last());
+                w->write_attribute(QSL("path"),  QSL("./") % exportPaths.at(resource->key()));
             }
 
-            w->writeEndElement(); // /resource
+            w->write_end_element(); // /resource
         }
     }
-    w->writeEndElement(); // /resources
+    w->write_end_element(); // /resources
 }
 
 void XmlIoManager::write_components(){
 
-    w->writeStartElement(QSL("Components"));{
+    w->write_start_element(QSL("Components"));{
         for(auto component : m_experiment->compM.get_components()){
             write_component(component);
         }
-    }w->writeEndElement(); // /Components
+    }w->write_end_element(); // /Components
 }
 
 void XmlIoManager::write_flow_elements(){
 
-    w->writeStartElement(QSL("FlowElements"));{
-        w->writeStartElement(QSL("Routines"));{
+    w->write_start_element(QSL("FlowElements"));{
+        w->write_start_element(QSL("Routines"));{
              for(const auto &routine : m_experiment->get_elements_from_type<Routine>()){
                 write_routine(routine);
             }
-        }w->writeEndElement(); // /Routines
+        }w->write_end_element(); // /Routines
 
-        w->writeStartElement(QSL("ISIs"));{
+        w->write_start_element(QSL("ISIs"));{
             for(const auto &isi : m_experiment->get_elements_from_type<Isi>()){
                 write_isi(isi);
             }
-        }w->writeEndElement(); // /ISIs
+        }w->write_end_element(); // /ISIs
 
-        w->writeStartElement(QSL("Loops"));{
+        w->write_start_element(QSL("Loops"));{
             for(const auto &loop : m_experiment->loops){
                 write_loop(loop.get());
             }
-        }w->writeEndElement(); // /Loops
+        }w->write_end_element(); // /Loops
 
-    }w->writeEndElement(); // /FlowElements
+    }w->write_end_element(); // /FlowElements
 }
 
 void XmlIoManager::write_flow_sequence(){
 
-    w->writeStartElement(QSL("FlowSequence"));{
+    w->write_start_element(QSL("FlowSequence"));{
         for(const auto &elem : m_experiment->elements){
             write_element(elem.get());
         }
-    }w->writeEndElement(); // /FlowSequence
+    }w->write_end_element(); // /FlowSequence
 }
 
 void XmlIoManager::write_experiment(){
 
-    w->writeStartElement(QSL("Experiment"));{
+    w->write_start_element(QSL("Experiment"));{
 
-        w->writeAttribute(QSL("name"), m_experiment->states.currentName);
-        w->writeAttribute(QSL("version"), m_experiment->states.numVersion);
-        w->writeAttribute(QSL("mode"), m_experiment->states.currentMode);
-        w->writeAttribute(QSL("designer-used"), Paths::exe);        
+        w->write_attribute(QSL("name"), m_experiment->states.currentName);
+        w->write_attribute(QSL("version"), m_experiment->states.numVersion);
+        w->write_attribute(QSL("mode"), m_experiment->states.currentMode);
+        w->write_attribute(QSL("designer-used"), Paths::exe);        
 
         write_settings();
         write_resources();
@@ -1403,7 +1496,7 @@ void XmlIoManager::write_experiment(){
         write_flow_elements();
         write_flow_sequence();
 
-    }w->writeEndElement(); // /Experiment
+    }w->write_end_element(); // /Experiment
 }
 
 bool XmlIoManager::save_instance_file(const Instance &instance, QString instanceFilePath){
@@ -1426,7 +1519,7 @@ bool XmlIoManager::save_instance_file(const Instance &instance, QString instance
             routine->name(),QString::number(routineInfo.first.v), QString::number(routineInfo.second), QString::number(nbConditions)));
         for(const auto &condInfo : instance.routinesConditionsIterations.at(routineInfo.first)){
             stream.writeComment(QString("   condition [%1] is called [%2] times").arg(
-                condInfo.first, QString::number(condInfo.second)));
+                instance.conditions[condInfo.first], QString::number(condInfo.second)));
         }
     }
 
@@ -1438,7 +1531,7 @@ bool XmlIoManager::save_instance_file(const Instance &instance, QString instance
         stream.writeAttribute(QSL("key"),  QString::number(instElem.elem->key()));
         stream.writeAttribute(QSL("type"), type);
         stream.writeAttribute(QSL("name"), instElem.elem->name());
-        stream.writeAttribute(QSL("cond"), instElem.condition);
+        stream.writeAttribute(QSL("cond"), instance.condition(instElem));
         stream.writeAttribute(QSL("elem_iter"), QString::number(instElem.elementIteration));
         stream.writeAttribute(QSL("cond_iter"), QString::number(instElem.conditionIteration));
         stream.writeEndElement(); // /Element
@@ -1450,6 +1543,8 @@ bool XmlIoManager::save_instance_file(const Instance &instance, QString instance
 
 std::unique_ptr<Instance> XmlIoManager::load_instance_file(QString instanceFilePath){
 
+    TraceGuard t("[XML::load_instance_file]"sv);
+
     QFile file(instanceFilePath);
     if(!file.open(QFile::ReadOnly | QFile::Text)){
         QtLogger::error(QSL("[XML] Cannot read instance file ")  % instanceFilePath % QSL("."));
@@ -1457,17 +1552,17 @@ std::unique_ptr<Instance> XmlIoManager::load_instance_file(QString instanceFileP
     }    
 
     // unpile xml
-    r = std::make_unique<QXmlStreamReader>();
-    r->setDevice(&file);
+    r = std::make_unique<ExperimentStreamReader>();
+    r->set_xml(&file);
 
     std::unique_ptr<Instance> instance = std::make_unique<Instance>();
     instance->filePath = instanceFilePath;
     instance->fileName =  instanceFilePath.split("/").last();
 
     // unpile xml
-    while(!r->atEnd()){
+    while(!r->at_end()){
         if(check_start_node(QSL("ExperimentFlow"))){
-            while(r->readNext()){
+            while(r->read_next()){
                 if(check_start_node(QSL("Element"))){
 
 
@@ -1481,7 +1576,7 @@ std::unique_ptr<Instance> XmlIoManager::load_instance_file(QString instanceFileP
                        !name.has_value() ||
                        !type.has_value() ||
                        !cond.has_value() ){
-                        QtLogger::error(QSL("[XML] Invalid instance element at line: ") % QString::number(r->lineNumber()));
+                        QtLogger::error(QSL("[XML] Invalid instance element at line: ") % QString::number(r->line_number()));
                         return nullptr;
                     }
 
@@ -1489,7 +1584,7 @@ std::unique_ptr<Instance> XmlIoManager::load_instance_file(QString instanceFileP
 
                         auto routine = m_experiment->get_routine(ElementKey{key.value()});
                         if(!routine){
-                            QtLogger::error(QSL("[XML] Invalid routine at line: ") % QString::number(r->lineNumber()));
+                            QtLogger::error(QSL("[XML] Invalid routine at line: ") % QString::number(r->line_number()));
                             return nullptr;
                         }
 
@@ -1507,16 +1602,16 @@ std::unique_ptr<Instance> XmlIoManager::load_instance_file(QString instanceFileP
                         }
 
                         if(elemIter.has_value() && condIter.has_value()){
-                            instance->flow.emplace_back(InstanceElement{elemIter.value(), condIter.value(), routine, cond.value()});
+                            instance->add_element(routine, cond.value(), elemIter.value(), condIter.value());
                         }else{
-                            instance->flow.emplace_back(InstanceElement{0, 0, routine, cond.value()});
+                            instance->add_element(routine, cond.value());
                         }
 
                     }else {
 
                         auto isi = m_experiment->get_isi(ElementKey{key.value()});
                         if(!isi){
-                            QtLogger::error(QSL("[XML] Invalid ISI at line: ") % QString::number(r->lineNumber()));
+                            QtLogger::error(QSL("[XML] Invalid ISI at line: ") % QString::number(r->line_number()));
                             return nullptr;
                         }
 
@@ -1534,18 +1629,19 @@ std::unique_ptr<Instance> XmlIoManager::load_instance_file(QString instanceFileP
                         }
 
                         if(elemIter.has_value() && condIter.has_value()){
-                            instance->flow.emplace_back(InstanceElement{elemIter.value(), condIter.value(), isi, cond.value()});
+                            instance->add_element(isi, cond.value(), elemIter.value(), condIter.value());
                         }else{
-                            instance->flow.emplace_back(InstanceElement{0, 0, isi, cond.value()});
+                            instance->add_element(isi, cond.value());
                         }
                     }
 
                 }else if(check_end_node(QSL("ExperimentFlow"))){
+                    instance->update_index();
                     return instance;
                 }
             }
         }
-        r->readNext();
+        r->read_next();
     }
 
     return nullptr;
@@ -1557,7 +1653,7 @@ std::unique_ptr<Routine> XmlIoManager::read_routine(){
     const auto name     = read_attribute<QString>(QSL("name"), true);
 
     if(!key.has_value() || !name.has_value() ){
-        QtLogger::error(QSL("[XML] Invalid routine at line: ") % QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid routine at line: ") % QString::number(r->line_number()));
         return nullptr;
     }
 
@@ -1572,16 +1668,42 @@ std::unique_ptr<Routine> XmlIoManager::read_routine(){
     if(!m_experiment->lastRoutineSelected){
         m_experiment->lastRoutineSelected = routine.get();
     }
-    r->readNext();
-    while(!r->atEnd()){
-        if(check_start_node(QSL("Condition"))){
+
+    m_routineTimelines.clear();
+    m_routineConnectorsArgs.clear();
+
+    r->read_next();
+    while(!r->at_end()){
+        if(check_start_node(QSL("Timeline"))){
+
+            const auto timelineKey = read_attribute<int>(QSL("key"), true);
+            if(auto timeline = read_timeline(); timeline.has_value() && timelineKey.has_value()){
+                m_routineTimelines.emplace(timelineKey.value(), std::move(timeline.value()));
+            }
+
+        }else if(check_start_node(QSL("ConnectorArg"))){
+
+            const auto argKey = read_attribute<int>(QSL("key"), true);
+            r->read_next();
+            while(!r->at_end() && !check_end_node(QSL("ConnectorArg"))){
+                if(check_start_node(QSL("Arg")) && argKey.has_value()){
+                    if(auto arg = read_argument(); std::get<0>(arg).has_value()){
+                        m_routineConnectorsArgs.emplace(argKey.value(), std::move(std::get<0>(arg).value()));
+                    }else{
+                        QtLogger::error(QSL("[XML] -> from routine ") % routine->name() % QSL(": ") % std::get<1>(arg));
+                    }
+                }
+                r->read_next();
+            }
+
+        }else if(check_start_node(QSL("Condition"))){
             if(auto condition = read_condition(routine.get()); condition != nullptr){
                 routine->conditions.emplace_back(std::move(condition));
             }
         }else if(check_end_node(QSL("Routine"))){
             return routine;
         }
-        r->readNext();
+        r->read_next();
     }
 
 
@@ -1595,7 +1717,7 @@ bool XmlIoManager::read_settings(){
     QtLogger::status(QSL("Read settings."), 2000);
 
     auto settings = m_experiment->settings();
-    while(!r->atEnd()){
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Settings"))){
             assign_attribute(settings->debug, QSL("debug"), true);
@@ -1627,7 +1749,7 @@ bool XmlIoManager::read_settings(){
             return true;
         }
 
-        r->readNext();
+        r->read_next();
     }
 
     return false;
@@ -1637,9 +1759,9 @@ bool XmlIoManager::read_components(){
 
     QtLogger::status("Read components.", 2000);
     BenchGuard bench("[XML::read_components]");
-    r->readNext();
+    r->read_next();
 
-    while(!r->atEnd()){
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Component"))){
             if(auto component = read_component(); component != nullptr){
@@ -1650,7 +1772,7 @@ bool XmlIoManager::read_components(){
         if(check_end_node(QSL("Components"))){
             return true;
         }
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(QSL("[XML] Invalid xml Components, no end bracket. "));
@@ -1661,13 +1783,13 @@ bool XmlIoManager::read_components(){
 
 
 void XmlIoManager::write_isi(const Isi *isi){
-    w->writeStartElement(QSL("Isi"));
-    w->writeAttribute(QSL("key"), QString::number(isi->key()));
-    w->writeAttribute(QSL("name"), isi->name());
-    w->writeAttribute(QSL("set"), isi->str_intervals());
-    w->writeAttribute(QSL("randomized"), (isi->randomized ? "1" : "0"));
-    w->writeAttribute(QSL("informations"), isi->informations);
-    w->writeEndElement(); // /Isi
+    w->write_start_element(QSL("Isi"));
+    w->write_attribute(QSL("key"), QString::number(isi->key()));
+    w->write_attribute(QSL("name"), isi->name());
+    w->write_attribute(QSL("set"), isi->str_intervals());
+    w->write_attribute(QSL("randomized"), (isi->randomized ? "1" : "0"));
+    w->write_attribute(QSL("informations"), isi->informations);
+    w->write_end_element(); // /Isi
 }
 
 IsiUP XmlIoManager::read_isi(){
@@ -1675,7 +1797,7 @@ IsiUP XmlIoManager::read_isi(){
     const auto key      = read_attribute<int>(QSL("key"), true);
     const auto name     = read_attribute<QString>(QSL("name"), true);
     if(!key.has_value() || !name.has_value() ){
-        QtLogger::error(QSL("[XML] Invalid Isi at line: ") + QString::number(r->lineNumber()));
+        QtLogger::error(QSL("[XML] Invalid Isi at line: ") + QString::number(r->line_number()));
         return nullptr;
     }
 
@@ -1699,8 +1821,8 @@ bool XmlIoManager::read_ISIs(){
 
     BenchGuard bench("[XML::read_ISIs]");
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Isi"))){
 
@@ -1711,7 +1833,7 @@ bool XmlIoManager::read_ISIs(){
         }else if(check_end_node(QSL("ISIs"))){
             return true;
         }
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(QSL("[XML] Invalid xml ISIs, no end bracket. "));
@@ -1723,8 +1845,8 @@ bool XmlIoManager::read_loops(){
 
     BenchGuard bench("[XML::read_loops]");
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
         if(check_start_node(QSL("Loop"))){
 
             if(auto [s,l,e] = read_loop(); s != nullptr){
@@ -1735,7 +1857,7 @@ bool XmlIoManager::read_loops(){
         }else if(check_end_node(QSL("Loops"))){
             return true;
         }
-        r->readNext();
+        r->read_next();
     }
     QtLogger::error(QSL("[XML] Invalid xml Loops, no end bracket. "));
 
@@ -1746,8 +1868,8 @@ bool XmlIoManager::read_routines(){
 
     BenchGuard bench("[XML::read_routines]");
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
         if(check_start_node(QSL("Routine"))){
 
             if(auto routine = read_routine(); routine != nullptr){
@@ -1758,7 +1880,7 @@ bool XmlIoManager::read_routines(){
 
             return true;
         }
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(QSL("[XML] Invalid xml Routines, no end bracket. "));
@@ -1771,8 +1893,8 @@ bool XmlIoManager::read_resources(){
     QtLogger::status("Read resources.", 2000);
     BenchGuard bench("[XML::read_resources]");
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
         if(check_start_node(QSL("Resource"))){
             if(auto resource = read_resource();resource != nullptr){                
                 m_experiment->resM.add_resource(std::move(resource));
@@ -1781,7 +1903,7 @@ bool XmlIoManager::read_resources(){
             return true;
         }
 
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(QSL("[XML] Invalid xml resources, no end bracket. "));
@@ -1794,8 +1916,8 @@ bool XmlIoManager::read_flow_elements(){
     QtLogger::status("Read flow elements.", 2000);
     BenchGuard bench("[XML::read_flow_elements]");
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
 
         if(check_start_node(QSL("Routines"))){
             if(!read_routines()){
@@ -1813,7 +1935,7 @@ bool XmlIoManager::read_flow_elements(){
             check_read_elements();
             return true;
         }
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(QSL("[XML] Invalid xml FlowElements, no end bracket. "));
@@ -1827,8 +1949,8 @@ bool XmlIoManager::read_flow_sequence(){
     QtLogger::status("Read flow sequence.", 2000);
     BenchGuard bench("[XML::read_flow_sequence]");
 
-    r->readNext();
-    while(!r->atEnd()){
+    r->read_next();
+    while(!r->at_end()){
         if(check_start_node(QSL("Element"))){
             if(auto element = read_element(); element != nullptr){
                 m_experiment->elements.emplace_back(std::make_unique<NodeFlow>());
@@ -1839,7 +1961,7 @@ bool XmlIoManager::read_flow_sequence(){
             m_experiment->elements.emplace_back(std::make_unique<NodeFlow>());
             return true;
         }
-        r->readNext();
+        r->read_next();
     }
 
     QtLogger::error(QSL("[XML] Invalid xml FlowSequence, no end bracket. "));
@@ -1908,8 +2030,34 @@ void XmlIoManager::export_experiment_to(){
         auto resM = &m_experiment->resM;
         resM->exportMode = true;
         save_experiment_file(expFilePath);
-        resM->exportMode = false;        
-        resM->export_to(path);
+        resM->exportMode = false;
+
+        if(!m_resourcesExporter.start(*resM, path)){
+            return;
+        }
+
+        m_exportProgressD = std::make_unique<QProgressDialog>(QSL("Export resources..."), QSL("Cancel"), 0, 1000);
+        m_exportProgressD->setWindowTitle(QSL("Export experiment"));
+        m_exportProgressD->setMinimumDuration(500);
+        m_exportProgressD->setAutoClose(false);
+        m_exportProgressD->setAutoReset(false);
+        connect(m_exportProgressD.get(), &QProgressDialog::canceled, this, [&]{
+            m_resourcesExporter.cancel();
+        });
+        connect(&m_resourcesExporter, &ResourcesExporter::progress_signal, m_exportProgressD.get(), [&](ResourcesExportProgress p){
+            m_exportProgressD->setLabelText(
+                QSL("Files: ") % QString::number(p.filesDone) % QSL("/") % QString::number(p.filesTotal) %
+                QSL(" (up to date: ") % QString::number(p.filesSkipped) % QSL(", failed: ") % QString::number(p.filesFailed) % QSL(")\n") %
+                QString::number(p.bytesDone / (1024.*1024.), 'f', 1) % QSL(" / ") % QString::number(p.bytesTotal / (1024.*1024.), 'f', 1) % QSL(" MB - ") %
+                QString::number(p.bytesPerSecond / (1024.*1024.), 'f', 1) % QSL(" MB/s")
+            );
+            m_exportProgressD->setValue(p.bytesTotal > 0 ? static_cast<int>(1000 * p.bytesDone / p.bytesTotal) : 1000);
+        });
+        connect(&m_resourcesExporter, &ResourcesExporter::finished_signal, m_exportProgressD.get(), [&]{
+            m_exportProgressD->close();
+            // called from one of the dialog connections, deleted once the event loop is back
+            m_exportProgressD.release()->deleteLater();
+        });
     }
 }
 
@@ -1923,7 +2071,7 @@ bool XmlIoManager::save_experiment_as(){
         parentDirPath = Paths::exeDir;
     }
 
-    QString path = QFileDialog::getSaveFileName(nullptr, "Experiment file", parentDirPath, "XML (*.xml)");
+    QString path = QFileDialog::getSaveFileName(nullptr, "Experiment file", parentDirPath, "XML (*.xml);;Binary (*.exvrb)");
     if(path.length() > 0){
         QtLogger::message(QSL("[XML] Save experiment as: ") % path);
         m_experiment->states.currentExpfilePath = path;
@@ -26,15 +26,17 @@
 
 // Qt
 #include <QString>
-#include <QXmlStreamReader>
+#include <QProgressDialog>
 #include <QDebug>
 
 // qt-utility
 #include "qt_logger.hpp"
 
 // local
+#include "IO/experiment_stream.hpp"
 #include "experiment/experiment.hpp"
 #include "experiment/instance.hpp"
+#include "resources/resources_exporter.hpp"
 
 namespace tool::ex{
 
@@ -65,7 +67,7 @@ namespace tool::ex{
 
         bool has_attribute(const QStringList &names) const{
             for(const auto &name : names){                                
-                if(r->attributes().hasAttribute(name)){
+                if(r->has_attribute(name)){
                     return true;
                 }
             }
@@ -79,7 +81,7 @@ namespace tool::ex{
                 }
             }
             if(raiseError){
-                QtLogger::error(QSL("[XML] No attribute found with names: ") % names.join(",") % QSL(", at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] No attribute found with names: ") % names.join(",") % QSL(", at line ") % QString::number(r->line_number()));
             }
 
             return {};
@@ -87,19 +89,19 @@ namespace tool::ex{
 
         template<> std::optional<bool> read_attribute(const QString &name, bool raiseError){
 
-            if(r->attributes().hasAttribute(name)){
+            if(r->has_attribute(name)){
                 bool ok;
-                auto value = r->attributes().value(name).toInt(&ok);
+                auto value = r->attribute(name).toInt(&ok);
                 if(ok){
                     return value == 1;
                 }
 
-                QtLogger::error(QSL("[XML] Invalid boolean attribute with name: ") %  name % QSL(" cannot convert from ") % r->attributes().value(name) % QSL(", at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Invalid boolean attribute with name: ") %  name % QSL(" cannot convert from ") % r->attribute(name) % QSL(", at line ") % QString::number(r->line_number()));
                 return {};
             }
 
             if(raiseError){
-                QtLogger::error(QSL("[XML] Boolean attribute ") %  name % QSL(" doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Boolean attribute ") %  name % QSL(" doesn't exist, at line ") % QString::number(r->line_number()));
             }
 
             return {};
@@ -111,7 +113,7 @@ namespace tool::ex{
             }
 
             if(raiseError){
-                QtLogger::error(QSL("[XML] Size_t attribute ") %  name % QSL(" doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Size_t attribute ") %  name % QSL(" doesn't exist, at line ") % QString::number(r->line_number()));
             }
 
             return {};
@@ -119,19 +121,19 @@ namespace tool::ex{
 
         template<> std::optional<int> read_attribute(const QString &name, bool raiseError){
 
-            if(r->attributes().hasAttribute(name)){
+            if(r->has_attribute(name)){
                 bool ok;
-                auto value = r->attributes().value(name).toInt(&ok);
+                auto value = r->attribute(name).toInt(&ok);
                 if(ok){
                     return value;
                 }
 
-                QtLogger::error(QSL("[XML] Invalid integer attribute [") % name % QSL("] cannot convert from ") % r->attributes().value(name) % QSL(", at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Invalid integer attribute [") % name % QSL("] cannot convert from ") % r->attribute(name) % QSL(", at line ") % QString::number(r->line_number()));
                 return {};
             }
 
             if(raiseError){
-                QtLogger::error(QSL("[XML] Integer attribute [") % name % QSL("] doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Integer attribute [") % name % QSL("] doesn't exist, at line ") % QString::number(r->line_number()));
             }
 
             return {};
@@ -140,31 +142,31 @@ namespace tool::ex{
 
         template<> std::optional<double> read_attribute(const QString &name, bool raiseError){
 
-            if(r->attributes().hasAttribute(name)){
+            if(r->has_attribute(name)){
                 bool ok;
-                auto value = r->attributes().value(name).toDouble(&ok);
+                auto value = r->attribute(name).toDouble(&ok);
                 if(ok){
                     return value;
                 }
 
-                QtLogger::error(QSL("[XML] Invalid double attribute with name [") % name % QSL("] cannot convert from ") % r->attributes().value(name) % QSL(", at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Invalid double attribute with name [") % name % QSL("] cannot convert from ") % r->attribute(name) % QSL(", at line ") % QString::number(r->line_number()));
                 return {};
             }
 
             if(raiseError){
-                QtLogger::error(QSL("[XML] Double attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Double attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->line_number()));
             }
 
             return {};
         }
 
         template<> std::optional<QString> read_attribute(const QString &name, bool raiseError){
-            if(r->attributes().hasAttribute(name)){
-                return r->attributes().value(name).toString().replace("\\n","\n");
+            if(r->has_attribute(name)){
+                return r->attribute(name).toString().replace("\\n","\n");
             }
 
             if(raiseError){
-                QtLogger::error(QSL("[XML] String attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] String attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->line_number()));
             }
 
             return {};
@@ -177,7 +179,7 @@ namespace tool::ex{
                 return;
             }
             if(raiseError){               
-                QtLogger::error(QSL("[XML] Can't assign attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Can't assign attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->line_number()));
             }
         }
 
@@ -188,7 +190,7 @@ namespace tool::ex{
                 return;
             }
             if(raiseError){
-                QtLogger::error(QSL("[XML] Can't assign attribute, it doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Can't assign attribute, it doesn't exist, at line ") % QString::number(r->line_number()));
             }
         }
 
@@ -198,7 +200,7 @@ namespace tool::ex{
                 return v.value() == target;
             }
             if(raiseError){
-                QtLogger::error(QSL("[XML] Can't campare with attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->lineNumber()));
+                QtLogger::error(QSL("[XML] Can't campare with attribute [") % name % QSL("], it doesn't exist, at line ") % QString::number(r->line_number()));
             }
 
             return false;
@@ -214,7 +216,7 @@ namespace tool::ex{
         void write_generator(const Generator &generator);
         void write_config(const Config *config, bool initConfig = false);
         void write_interval(const Interval &interval);
-        void write_timeline(const Timeline *timeline);
+        void write_timeline(const Timeline *timeline, int key);
         void write_component(const Component *component);
         void write_components();
         void write_action(const Action *action);
@@ -236,7 +238,7 @@ namespace tool::ex{
         std::unique_ptr<Config>            read_config();
         std::tuple<std::optional<Arg>, QString>  read_argument();
         std::optional<Interval> read_interval();
-        std::unique_ptr<Timeline>          read_timeline();
+        std::optional<CowData<Timeline>>   read_timeline();
         std::tuple<std::unique_ptr<Action>, QString> read_action();
         std::tuple<std::unique_ptr<Connection>, QString> read_connection(Condition *condition);
         std::tuple<std::unique_ptr<Connector>, QString> read_connector();
@@ -267,8 +269,17 @@ namespace tool::ex{
 
         bool m_debugNoDuration = false;
         Experiment *m_experiment = nullptr;
-        std::unique_ptr<QXmlStreamReader> r = nullptr;
-        std::unique_ptr<QXmlStreamWriter> w = nullptr;
+
+        umap<QString, CowData<Timeline>> m_loadedTimelines; /**< identical timelines read share their data */
+        umap<int, CowData<Timeline>> m_routineTimelines;    /**< timelines definitions of the routine being read */
+        umap<int, CowData<Arg>> m_routineConnectorsArgs;    /**< connectors arguments definitions of the routine being read */
+        umap<const void*, int> m_writtenTimelinesKeys;      /**< shared timelines of the routine being written */
+        umap<const void*, int> m_writtenConnectorsArgsKeys; /**< shared connectors arguments of the routine being written */
+
+        ResourcesExporter m_resourcesExporter;
+        std::unique_ptr<QProgressDialog> m_exportProgressD = nullptr;
+        std::unique_ptr<ExperimentStreamReader> r = nullptr;
+        std::unique_ptr<ExperimentStreamWriter> w = nullptr;
 
         std::vector<std::unique_ptr<Routine>>  readXmlRoutines;
         std::vector<IsiUP>      readXmlISIs;
@@ -32,6 +32,7 @@
 
 // local
 #include "utility/script_utility.hpp"
+#include "utility/profiling_trace.hpp"
 
 // ui
 #include "ui_about_dialog.h"
@@ -270,30 +271,20 @@ void ExVrController::go_to_current_specific_instance_element(){
             return;
         }
 
-        int idOrder = 0;
-        for(const auto &instanceElement : m_currentInstance->flow){
-            if(instanceElement.elem->key() == routine->key() && instanceElement.condition == selectedCondition){
-                QtLogger::message(QSL("[CONTROLLER] Got to element ") % QString::number(idOrder));
-                emit go_to_specific_instance_element_signal(idOrder);
-                return;
-            }
-            if(instanceElement.elem->is_routine()){
-                if(dynamic_cast<Routine*>(instanceElement.elem)->isARandomizer){
-                    continue;
+        if(auto positions = m_currentInstance->positions(routine->e_key(), selectedCondition); positions != nullptr){
+            for(auto position : *positions){
+                if(const auto orderId = m_currentInstance->flow[position].orderId; orderId >= 0){
+                    QtLogger::message(QSL("[CONTROLLER] Got to element ") % QString::number(orderId));
+                    emit go_to_specific_instance_element_signal(orderId);
+                    return;
                 }
             }
-            ++idOrder;
         }
     }else{
         auto isi = dynamic_cast<Isi*>(element);
 
-        int idOrder = 0;
-        for(const auto &instanceElement : m_currentInstance->flow){
-            if(instanceElement.elem->key() == isi->key()){
-                emit go_to_specific_instance_element_signal(idOrder);
-                return;
-            }
-            ++idOrder;
+        if(auto positions = m_currentInstance->positions(isi->e_key()); positions != nullptr){
+            emit go_to_specific_instance_element_signal(m_currentInstance->flow[positions->front()].orderId);
         }
     }
 }
@@ -307,7 +298,9 @@ void ExVrController::generate_instances(QString directoryPath, unsigned int seed
         if(!manual){
             for(int ii = 0; ii < nbInstances; ++ii){
 
+                Trace::begin("[Generate instance]"sv);
                 auto instance = Instance::generate_from_full_experiment(&exp()->randomizer, *exp(), ii);
+                Trace::end();
                 if(!instance){
                     return;
                 }
@@ -317,6 +310,7 @@ void ExVrController::generate_instances(QString directoryPath, unsigned int seed
                     baseName %
                     QString::number(ii+startId) % QSL(".xml");
 
+                TraceGuard t("[Save instance file]"sv);
                 if(!xml()->save_instance_file(*instance, instanceFileName)){
                     return;
                 }
@@ -326,7 +320,9 @@ void ExVrController::generate_instances(QString directoryPath, unsigned int seed
 
             for(int ii = 0; ii < manualNames.size(); ++ii){
 
+                Trace::begin("[Generate instance]"sv);
                 auto instance = Instance::generate_from_full_experiment(&exp()->randomizer, *exp(), ii);
+                Trace::end();
                 if(!instance){
                     return;
                 }
@@ -334,6 +330,7 @@ void ExVrController::generate_instances(QString directoryPath, unsigned int seed
                 const QString instanceFileName =
                     directoryPath % QSL("/") %
                     manualNames[ii] % QSL(".xml");
+                TraceGuard t("[Save instance file]"sv);
                 if(!xml()->save_instance_file(*instance, instanceFileName)){
                     return;
                 }
@@ -367,7 +364,7 @@ void ExVrController::show_got_to_specific_instance_element_dialog(){
     twInstanceElements->setSelectionBehavior(QAbstractItemView::SelectRows);
 
     int orderId = 0;
-    umap<int, umap<QString,int>> countIterations;
+    umap<int, umap<std::uint32_t,int>> countIterations;
 
     twInstanceElements->setHorizontalHeaderLabels({"Element type", "Element name", "Condition/interval", "Condition iteration"});
     for(const auto &element : m_currentInstance->flow){
@@ -383,20 +380,10 @@ void ExVrController::show_got_to_specific_instance_element_dialog(){
         }
 
         twInstanceElements->setItem(orderId, 1, new QTableWidgetItem(element.elem->name()));
-        twInstanceElements->setItem(orderId, 2, new QTableWidgetItem(element.condition));
+        twInstanceElements->setItem(orderId, 2, new QTableWidgetItem(m_currentInstance->condition(element)));
 
         if(element.elem->type() == FlowElement::Type::Routine){
-
-            if(countIterations.count(element.elem->key()) == 0){
-                countIterations[element.elem->key()] = {};
-            }
-
-            if(countIterations[element.elem->key()].count(element.condition) == 0){
-                countIterations[element.elem->key()][element.condition] = 0;
-            }
-
-            twInstanceElements->setItem(orderId, 3, new QTableWidgetItem(QString::number(countIterations[element.elem->key()][element.condition])));
-            countIterations[element.elem->key()][element.condition]++;
+            twInstanceElements->setItem(orderId, 3, new QTableWidgetItem(QString::number(countIterations[element.elem->key()][element.conditionId]++)));
         }else{
             twInstanceElements->setItem(orderId, 3, new QTableWidgetItem("-"));
         }
@@ -594,18 +581,10 @@ void ExVrController::show_component_informations_dialog(ComponentKey componentKe
                         auto condition = std::get<0>(conditionAction);
                         auto action    = std::get<1>(conditionAction);
 
-                        double lengthUpdate = 0.;
-                        size_t nbUpdateIntervals = 0;
-                        if(action->timelineUpdate){
-                            nbUpdateIntervals = action->timelineUpdate->nb_intervals();
-                            lengthUpdate      = action->timelineUpdate->sum_intervals();
-                        }
-                        double lengthVisibility = 0.;
-                        size_t nbVisibilityIntervals = 0;
-                        if(action->timelineVisibility){
-                            nbVisibilityIntervals += action->timelineVisibility->nb_intervals();
-                            lengthVisibility = action->timelineVisibility->sum_intervals() ;
-                        }
+                        const size_t nbUpdateIntervals     = action->timelineUpdate->nb_intervals();
+                        const double lengthUpdate          = action->timelineUpdate->sum_intervals();
+                        const size_t nbVisibilityIntervals = action->timelineVisibility->nb_intervals();
+                        const double lengthVisibility      = action->timelineVisibility->sum_intervals();
 
                         QString timelineTxt;
                         auto tOpt = Component::get_timeline_opt(action->component->type);
@@ -737,7 +716,7 @@ void ExVrController::show_import_dialog(){
         parentDirPath = Paths::expDir;
     }
 
-    QString path = QFileDialog::getOpenFileName(nullptr, "Experiment file to import", parentDirPath, "XML (*.xml)");
+    QString path = QFileDialog::getOpenFileName(nullptr, "Experiment file to import", parentDirPath, "Experiment (*.xml *.exvrb)");
     if(path.length() == 0){
         return;
     }
@@ -753,68 +732,79 @@ void ExVrController::show_import_dialog(){
 void ExVrController::update_gui_from_experiment(){
 
     auto flag = exp()->update_flag();
+    ChangeJournal journal;
+    exp()->take_journal(journal);
     exp()->reset_update_flag();
 
-    Bench::start("[Update full UI]"sv, false);
-    if(flag & UpdateSettings){
-        Bench::start("[Update dialogs]"sv, false);
-        m_settingsD.update_from_settings(exp()->settings());
-        Bench::stop();
-    }
+    {
+        ProfileGuard fullUi("[Update full UI]"sv, false);
+        if(flag & UpdateSettings){
+            ProfileGuard p("[Update dialogs]"sv, false);
+            m_settingsD.update_from_settings(exp()->settings());
+        }
 
-    if(flag & UpdateResources){ // update experiment components
-        Bench::start("[Update resources]"sv, false);
-        m_resourcesD.update_from_resources_manager(&ExperimentManager::get()->current()->resM);
-        Bench::stop();
-    }
+        if(flag & UpdateResources){ // update experiment components
+            ProfileGuard p("[Update resources]"sv, false);
+            const auto resM = &ExperimentManager::get()->current()->resM;
+            m_resourcesIndexer.update(*resM, exp()->states.currentExpfilePath);
+            m_resourcesD.update_from_resources_manager(resM, &m_resourcesIndexer);
+        }
 
-    Bench::start("[Update designer window]"sv);
-    if(flag != 0){
-        ui()->update_from_experiment(exp(), flag);
-    }
-    Bench::stop();
+        {
+            ProfileGuard p("[Update designer window]"sv);
+            if(flag != 0){
+                ui()->update_from_experiment(exp(), flag, journal);
+            }
+            if(flag & ResetUI){
+                m_benchmarkD->end_experiment_opening(ui()->components_manager());
+            }
+        }
 
-    // infos
-    // # components
-    Bench::start("[Update components infos]"sv, false);
-    for(const auto &componentI : exp()->componentsInfo){
-        for(const auto &configI : componentI.second){
-            for(const auto &idI : configI.second){
-                ui()->components_manager()->update_component_dialog_with_info(
-                    ComponentKey{componentI.first},
-                    ConfigKey{configI.first},
-                    idI.first,
-                    idI.second
-                );
+        // infos
+        // # components
+        {
+            ProfileGuard p("[Update components infos]"sv, false);
+            for(const auto &componentI : exp()->componentsInfo){
+                for(const auto &configI : componentI.second){
+                    for(const auto &idI : configI.second){
+                        ui()->components_manager()->update_component_dialog_with_info(
+                            ComponentKey{componentI.first},
+                            ConfigKey{configI.first},
+                            idI.first,
+                            idI.second
+                        );
+                    }
+                }
             }
         }
-    }
-    Bench::stop();
-    // # connectors
-    Bench::start("[Update connectors infos]"sv, false);
-    for(const auto &elementI : exp()->connectorsInfo){
-        for(const auto &conditionI : elementI.second){
-            for(const auto &connectorI : conditionI.second){
-                for(const auto &idI : connectorI.second){
-                    ui()->routines_manager()->update_connector_dialog_with_info(
-                        ElementKey{elementI.first},
-                        ConditionKey{conditionI.first},
-                        ConnectorKey{connectorI.first},
-                        idI.first,
-                        idI.second
-                    );
+        // # connectors
+        {
+            ProfileGuard p("[Update connectors infos]"sv, false);
+            for(const auto &elementI : exp()->connectorsInfo){
+                for(const auto &conditionI : elementI.second){
+                    for(const auto &connectorI : conditionI.second){
+                        for(const auto &idI : connectorI.second){
+                            ui()->routines_manager()->update_connector_dialog_with_info(
+                                ElementKey{elementI.first},
+                                ConditionKey{conditionI.first},
+                                ConnectorKey{connectorI.first},
+                                idI.first,
+                                idI.second
+                            );
+                        }
+                    }
                 }
             }
         }
-    }
-    Bench::stop();
 
-    exp()->componentsInfo.clear();
-    exp()->connectorsInfo.clear();
-
-    Bench::stop();
+        exp()->componentsInfo.clear();
+        exp()->connectorsInfo.clear();
+    }
 
+    m_benchmarkD->update_ipc_counters(m_expLauncher->receive_counters());
+    m_benchmarkD->update_components_dialogs(ui()->components_manager());
     m_benchmarkD->update();
+    Trace::next_frame();
 
     Bench::display(BenchUnit::milliseconds, 0, true);
     Bench::reset();
@@ -1127,6 +1117,7 @@ void ExVrController::generate_global_signals_connections(){
     connect(s, &GSignals::modify_loop_nb_reps_signal,                 exp(), &EXP::modify_loop_nb_reps);
     connect(s, &GSignals::modify_loop_n_signal,                       exp(), &EXP::modify_loop_N);
     connect(s, &GSignals::modify_loop_no_following_value_signal,      exp(), &EXP::modify_loop_no_following_value);
+    connect(s, &GSignals::modify_loop_constraints_signal,             exp(), &EXP::modify_loop_constraints);
     connect(s, &GSignals::modify_loop_type_signal,                    exp(), &EXP::modify_loop_type);
     connect(s, &GSignals::modify_loop_set_name_signal,                exp(), &EXP::modify_loop_set_name);
     connect(s, &GSignals::modify_loop_set_occurrencies_nb_signal,     exp(), &EXP::modify_loop_set_occurrencies_nb);
@@ -1262,13 +1253,14 @@ void ExVrController::generate_main_window_connections(){
             parentDirPath = Paths::expDir;
         }
 
-        QString path = QFileDialog::getOpenFileName(nullptr, "Experiment file", parentDirPath, "XML (*.xml)");
+        QString path = QFileDialog::getOpenFileName(nullptr, "Experiment file", parentDirPath, "Experiment (*.xml *.exvrb)");
         if(path.length() > 0){
             if(!exp()->states.neverLoaded){
                 exp_launcher()->stop_experiment();
                 exp_launcher()->clean_experiment();
             }
             exp()->clean_experiment();
+            m_benchmarkD->start_experiment_opening();
             xml()->load_experiment_file(path);
             exp()->add_to_update_flag(UpdateAll | ResetUI);
         }
@@ -1281,6 +1273,7 @@ void ExVrController::generate_main_window_connections(){
                 exp_launcher()->clean_experiment();
             }
             exp()->clean_experiment();
+            m_benchmarkD->start_experiment_opening();
             xml()->load_experiment_file(path);
             exp()->add_to_update_flag(UpdateAll | ResetUI);
         }
@@ -1336,6 +1329,10 @@ void ExVrController::generate_resources_manager_connections(){
     connect(res(), &ResourcesManagerDialog::clean_resources_signal,             exp(),  &EXP::clean_resources);
     connect(res(), &ResourcesManagerDialog::remove_resource_signal,             exp(),  &EXP::remove_resource);
     connect(res(), &ResourcesManagerDialog::update_reload_resource_code_signal, exp(),  &EXP::update_reload_resource_code);
+    // -> dialog
+    connect(&m_resourcesIndexer, &ResourcesIndexer::index_updated_signal, res(), [&]{
+        res()->update_resources_status(&ExperimentManager::get()->current()->resM, &m_resourcesIndexer);
+    });
 }
 
 void ExVrController::generate_logger_connections(){
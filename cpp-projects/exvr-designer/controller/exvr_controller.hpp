@@ -42,6 +42,7 @@
 #include "IO/xml_io_manager.hpp"
 // # resources
 #include "resources/resources_manager.hpp"
+#include "resources/resources_indexer.hpp"
 // # gui
 // ## widgets
 #include "gui/widgets/designer_window.hpp"
@@ -149,6 +150,7 @@ private :
 
     // data    
     std::unique_ptr<Instance> m_currentInstance = nullptr;
+    ResourcesIndexer m_resourcesIndexer;
 
     // I/O
     std::unique_ptr<XmlIoManager> m_xmlManager = nullptr;
@@ -39,13 +39,11 @@ std::unique_ptr<Action> Action::generate_component_action(Component *component,
 
     auto action = std::make_unique<Action>(component,
         configKey.has_value() ? component->get_config(configKey.value()) : component->get_config(RowId{0}), ActionKey{-1});
-    action->timelineUpdate     = std::make_unique<Timeline>(Timeline::Type::Update);
     if(fillUpdateTimeline){
-        action->timelineUpdate->add_interval({SecondsTS{0}, duration});
+        action->timelineUpdate.edit().add_interval({SecondsTS{0}, duration});
     }
-    action->timelineVisibility = std::make_unique<Timeline>(Timeline::Type::Visibility);
     if(fillVisibilityTimeline){
-        action->timelineVisibility->add_interval({SecondsTS{0}, duration});
+        action->timelineVisibility.edit().add_interval({SecondsTS{0}, duration});
     }
     return action;
 }
@@ -58,8 +56,8 @@ void Action::select_config(RowId configTabId){
 
 std::unique_ptr<Action> Action::copy_with_new_element_id(const Action &actionToCopy){
     auto action                = std::make_unique<Action>(actionToCopy.component, actionToCopy.config, ActionKey{-1});
-    action->timelineUpdate     = Timeline::copy_with_new_element_id(*actionToCopy.timelineUpdate);
-    action->timelineVisibility = Timeline::copy_with_new_element_id(*actionToCopy.timelineVisibility);
+    action->timelineUpdate     = actionToCopy.timelineUpdate;
+    action->timelineVisibility = actionToCopy.timelineVisibility;
     action->nodePosition       = actionToCopy.nodePosition;
     action->nodeUsed           = actionToCopy.nodeUsed;
     return action;
@@ -71,22 +69,26 @@ void Action::check_integrity(){
 
 void Action::update_intervals_with_max_length(tool::SecondsTS maxLength){
 
-    timelineUpdate->intervals.erase(std::remove_if(timelineUpdate->intervals.begin(), timelineUpdate->intervals.end(),[=](Interval& i) {
-        return (i.start.v > maxLength.v);
-    }), timelineUpdate->intervals.end());
+    auto update = [=](CowData<Timeline> &timeline){
 
-    timelineVisibility->intervals.erase(std::remove_if(timelineVisibility->intervals.begin(), timelineVisibility->intervals.end(),[=](Interval& i) {
-        return (i.start.v > maxLength.v);
-    }), timelineVisibility->intervals.end());
-
-    for(auto &interval : timelineUpdate->intervals){
-        if(interval.inside(maxLength)){
-            interval.end = maxLength;
+        // don't detach a shared timeline if nothing changes
+        if(std::none_of(timeline->intervals.begin(), timeline->intervals.end(), [=](const Interval& i) {
+            return i.end.v > maxLength.v;
+        })){
+            return;
         }
-    }
-    for(auto &interval : timelineVisibility->intervals){
-        if(interval.inside(maxLength)){
-            interval.end = maxLength;
+
+        auto &intervals = timeline.edit().intervals;
+        intervals.erase(std::remove_if(intervals.begin(), intervals.end(),[=](Interval& i) {
+            return (i.start.v > maxLength.v);
+        }), intervals.end());
+
+        for(auto &interval : intervals){
+            if(interval.inside(maxLength)){
+                interval.end = maxLength;
+            }
         }
-    }
+    };
+    update(timelineUpdate);
+    update(timelineVisibility);
 }
@@ -57,8 +57,9 @@ struct Action{
     Config    *config               = nullptr;
     Component *component            = nullptr;
 
-    std::unique_ptr<Timeline> timelineUpdate       = nullptr;
-    std::unique_ptr<Timeline> timelineVisibility   = nullptr;
+    // shared with the actions copied from this one until modified
+    CowData<Timeline> timelineUpdate     = Timeline::empty(Timeline::Update);
+    CowData<Timeline> timelineVisibility = Timeline::empty(Timeline::Visibility);
 
     // ui
     // # graph
@@ -48,6 +48,7 @@ void Condition::apply_condition(const Condition *conditionToCopy, bool copyActio
         selected     = conditionToCopy->selected;
 
         actions.clear();
+        actions.reserve(conditionToCopy->actions.size());
         for(auto &actionToCopy : conditionToCopy->actions){
             auto action = Action::copy_with_new_element_id(*actionToCopy);
             if(!copyConnections){
@@ -62,32 +63,42 @@ void Condition::apply_condition(const Condition *conditionToCopy, bool copyActio
 
         // copy all connectors nodes
         connectors.clear();        
+        connectors.reserve(conditionToCopy->connectors.size());
         umap<int,int> keysMapping;
+        keysMapping.reserve(conditionToCopy->connectors.size());
         for(auto &connectorToCopy : conditionToCopy->connectors){
             connectors.emplace_back(Connector::copy_with_new_element_id(*connectorToCopy));
             keysMapping[connectorToCopy->key()] = connectors[connectors.size()-1]->key();
         }
 
+        // actions per component key, avoids a search per copied action and connection
+        umap<int, Action*> componentsActions;
+        componentsActions.reserve(actions.size());
+        for(auto &action : actions){
+            componentsActions[action->component->key()] = action.get();
+        }
+
         // apply action component node used state
         for(auto &actionToCopy : conditionToCopy->actions){
-            if(auto action = get_action_from_component_key(ComponentKey{actionToCopy->component->key()}, false); action != nullptr){
-                action->nodeUsed     = actionToCopy->nodeUsed;
-                action->nodePosition = actionToCopy->nodePosition;
+            if(auto action = componentsActions.find(actionToCopy->component->key()); action != componentsActions.end()){
+                action->second->nodeUsed     = actionToCopy->nodeUsed;
+                action->second->nodePosition = actionToCopy->nodePosition;
             }
         }
 
         connections.clear();
+        connections.reserve(conditionToCopy->connections.size());
         for(auto &connection : conditionToCopy->connections){
 
             if(connection->startType == Connection::Type::Component){
-                if(auto component = get_component_from_key(ComponentKey{connection->startKey}, false); component == nullptr){
+                if(componentsActions.count(connection->startKey) == 0){
                     QtLogger::message(QSL("From condition ") % conditionToCopy->name % QSL(", starting connection node component with key ") %
                                     QString::number(connection->startKey) % QSL(" not available in condition ") % name % QSL(", cannot copy it. "));
                     continue;
                 }
             }
             if(connection->endType == Connection::Type::Component){
-                if(auto component = get_component_from_key(ComponentKey{connection->endKey}, false); component == nullptr){
+                if(componentsActions.count(connection->endKey) == 0){
                     QtLogger::message(QSL("From condition ") % conditionToCopy->name % QSL(", ending connection node component with key ")
                                     % QString::number(connection->endKey) % QSL(" not available in condition ") % name % QSL(", cannot copy it. "));
                     continue;
@@ -29,6 +29,7 @@
 
 // local
 #include "connection_node.hpp"
+#include "cow_data.hpp"
 
 namespace tool::ex {
 
@@ -421,7 +422,7 @@ struct Connector{
 
     Connector() = delete;
     Connector(ConnectorKey id, Type t, QString n, QPointF p) : name(n), pos(p), type(t), m_key(IdKey::Type::Connector, id.v){}
-    Connector(ConnectorKey id, Type t, QString n, QPointF p, Arg a) : name(n), pos(p), arg(a), type(t), m_key(IdKey::Type::Connector, id.v){}
+    Connector(ConnectorKey id, Type t, QString n, QPointF p, CowData<Arg> a) : name(n), pos(p), arg(std::move(a)), type(t), m_key(IdKey::Type::Connector, id.v){}
     Connector(const Connector &) = delete;
     Connector& operator=(const Connector&) = delete;
 
@@ -435,7 +436,7 @@ struct Connector{
 
     QString name;
     QPointF pos;
-    Arg arg;
+    CowData<Arg> arg; // shared with the connectors copied from this one until modified
     bool inputValidity = true;
     Type type;
     QSize size; // TO REMOVE
@@ -0,0 +1,73 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <memory>
+
+namespace tool::ex {
+
+// Value shared between copies until one of them is modified (copy-on-write).
+// Not thread-safe, meant for the designer data model accessed from the ui thread.
+template<class T>
+class CowData{
+public:
+
+    CowData() : m_data(empty()){}
+    CowData(T value) : m_data(std::make_shared<T>(std::move(value))){}
+
+    const T &get() const noexcept{return *m_data;}
+    const T &operator*() const noexcept{return *m_data;}
+    const T *operator->() const noexcept{return m_data.get();}
+
+    // detach from the other copies before giving write access
+    T &edit(){
+        if(m_data.use_count() > 1){
+            m_data = std::make_shared<T>(*m_data);
+        }
+        return *m_data;
+    }
+
+    void reset(){m_data = empty();}
+
+    bool shares_with(const CowData &other) const noexcept{return m_data == other.m_data;}
+    const void *id() const noexcept{return m_data.get();}
+    long use_count() const noexcept{return m_data.use_count();}
+
+    // read only container interface
+    auto begin() const{return m_data->cbegin();}
+    auto end() const{return m_data->cend();}
+    auto size() const{return m_data->size();}
+    const auto &operator[](size_t id) const{return (*m_data)[id];}
+
+private:
+
+    static const std::shared_ptr<T> &empty(){
+        static const std::shared_ptr<T> e = std::make_shared<T>();
+        return e;
+    }
+
+    std::shared_ptr<T> m_data;
+};
+}
@@ -27,6 +27,9 @@
 // local
 #include "qt_logger.hpp"
 
+// exvr-export
+#include "ex_resources/csv_columns_file.hpp"
+
 using namespace tool::ex;
 
 
@@ -46,6 +49,8 @@ std::unique_ptr<Loop> Loop::copy_with_new_element_id(const Loop &loopToCopy, con
     loop->nbReps            = loopToCopy.nbReps;
     loop->mode              = loopToCopy.mode;
     loop->noFollowingValues = loopToCopy.noFollowingValues;
+    loop->maxRepeats        = loopToCopy.maxRepeats;
+    loop->minDistance       = loopToCopy.minDistance;
 
     loop->sets.reserve(loopToCopy.sets.size());
     for(const auto &setToCopy : loopToCopy.sets){
@@ -72,6 +77,11 @@ void Loop::set_loop_type(Loop::Mode mode) noexcept{
     this->mode = mode;
 }
 
+void Loop::set_constraints(int maxRepeats, int minDistance) noexcept{
+    this->maxRepeats  = maxRepeats;
+    this->minDistance = minDistance;
+}
+
 bool Loop::is_default() const{
 
     if(sets.size() == 1){
@@ -244,31 +254,34 @@ void Loop::sort_sets_num(){
 
 bool Loop::load_file(QString path){
 
-    QFile file(path);
-    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+    // one set per line: "name [occurrences]"
+    CsvColumnsFile file;
+    CsvParseSettings settings;
+    settings.separator  = ' ';
+    settings.header     = false;
+    settings.inferTypes = false;
+    settings.quotes     = false;
+    if(!file.open(path.toStdString(), settings)){
         return false;
     }
 
-    QTextStream in(&file);
     std::vector<std::unique_ptr<Set>> filSets;
     std::set<QString> validNames;
 
-    while (!in.atEnd()){
-        auto line = in.readLine();
-        auto split = line.split(" ");
-        QString name;
-        if(split.length() > 0){
-            name = split[0];
-        }
+    for(size_t idRow = 0; idRow < file.rows_count(); ++idRow){
+
+        const auto nameText = file.text(0, idRow);
+        const auto name = QString::fromUtf8(nameText.data(), static_cast<int>(nameText.size()));
         if(name.length() == 0 || validNames.contains(name)){
             continue;
         }
         validNames.insert(name);
 
         int nbOcc = 1;
-        if(split.length() > 1){
+        if(file.columns_count() > 1){
             bool ok;
-            nbOcc = split[1].toInt(&ok);
+            const auto nbOccText = file.text(1, idRow);
+            nbOcc = QString::fromUtf8(nbOccText.data(), static_cast<int>(nbOccText.size())).toInt(&ok);
             if(!ok){
                 nbOcc = 1;
             }
@@ -63,6 +63,9 @@ struct Loop : public FlowElement {
         ShuffleOneForAllInstances,
         RandomEveryNInstances,
         ShuffleEveryNInstances,
+        ConstrainedShuffle,
+        BalancedTransitions,
+        WilliamsInstances,
         SizeEnum
     };
 
@@ -80,6 +83,9 @@ struct Loop : public FlowElement {
         {Mode::ShuffleOneForAllInstances,   "only_once_shuffle"sv},
         {Mode::RandomEveryNInstances,       "every_n_instances_random"sv},
         {Mode::ShuffleEveryNInstances,      "every_n_instances_shuffle"sv},
+        {Mode::ConstrainedShuffle,          "constrained_shuffle"sv},
+        {Mode::BalancedTransitions,         "balanced_transitions"sv},
+        {Mode::WilliamsInstances,           "williams_instances"sv},
     }};
 
     [[maybe_unused]] static Name get_name(Mode m) {
@@ -101,6 +107,7 @@ struct Loop : public FlowElement {
     void set_nb_reps(size_t nbReps) noexcept;
     void set_N(int N) noexcept;
     void set_loop_type(Mode mode) noexcept;
+    void set_constraints(int maxRepeats, int minDistance) noexcept;
 
     bool is_default() const;
     void set_sets(QStringList sets);
@@ -126,6 +133,8 @@ struct Loop : public FlowElement {
     Mode mode = Mode::Fixed;
     int N = 1;
     bool noFollowingValues = false; /**< for random and shuffle only */
+    int maxRepeats = 0;             /**< constrained shuffle, max identical sets in a row, 0: no limit */
+    int minDistance = 0;            /**< constrained shuffle, min positions between identical sets, 0: no limit */
 
     // sets
     std::vector<std::unique_ptr<Set>> sets;
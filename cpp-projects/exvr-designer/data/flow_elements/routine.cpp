@@ -123,9 +123,10 @@ void Routine::set_connector_input_connection_validity(ConditionKey conditionKey,
 
 void Routine::fill_actions_from_condition(ConditionKey conditionKey){
     if(auto condition = get_condition(conditionKey); condition != nullptr){
+        TimelinesFiller filler;
         for(auto &action : condition->actions){
-            action->timelineUpdate->fill(condition->duration);
-            action->timelineVisibility->fill(condition->duration);
+            filler.fill(action->timelineUpdate, condition->duration);
+            filler.fill(action->timelineVisibility, condition->duration);
         }
     }
 }
@@ -133,8 +134,8 @@ void Routine::fill_actions_from_condition(ConditionKey conditionKey){
 void Routine::clean_actions_from_condition(ConditionKey conditionKey){
     if(auto condition = get_condition(conditionKey); condition != nullptr){
         for(auto &action : condition->actions){
-            action->timelineUpdate->clean();
-            action->timelineVisibility->clean();
+            TimelinesFiller::clean(action->timelineUpdate);
+            TimelinesFiller::clean(action->timelineVisibility);
         }
     }
 }
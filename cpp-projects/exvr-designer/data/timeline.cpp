@@ -162,3 +162,34 @@ void Timeline::merge(){
 
     std::sort(intervals.begin(), intervals.end(), compare_intervals);
 }
+
+bool Timeline::is_filled(SecondsTS length) const{
+    return intervals.size() == 1 && almost_equal(intervals[0].start.v, 0.) && almost_equal(intervals[0].end.v, length.v);
+}
+
+const CowData<Timeline> &Timeline::empty(Type type){
+    static const CowData<Timeline> update(Timeline(Update));
+    static const CowData<Timeline> visibility(Timeline(Visibility));
+    return type == Update ? update : visibility;
+}
+
+void TimelinesFiller::fill(CowData<Timeline> &timeline, SecondsTS duration){
+
+    for(const auto &filled : m_filled){
+        if(filled->type == timeline->type && filled->is_filled(duration)){
+            timeline = filled;
+            return;
+        }
+    }
+
+    if(!timeline->is_filled(duration)){
+        Timeline filled(timeline->type);
+        filled.fill(duration);
+        timeline = std::move(filled);
+    }
+    m_filled.push_back(timeline);
+}
+
+void TimelinesFiller::clean(CowData<Timeline> &timeline){
+    timeline = Timeline::empty(timeline->type);
+}
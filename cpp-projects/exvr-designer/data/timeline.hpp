@@ -33,6 +33,7 @@
 
 // local
 #include "interval.hpp"
+#include "cow_data.hpp"
 
 namespace tool::ex {
 
@@ -43,17 +44,15 @@ struct Timeline{
 
     Timeline(Type t) : type(t){}
 
-    static std::unique_ptr<Timeline> copy_with_new_element_id(const Timeline &timelineToCopy){
-        std::unique_ptr<Timeline> timeline = std::make_unique<Timeline>(timelineToCopy.type);
-        timeline->intervals = timelineToCopy.intervals;
-        return timeline;
-    }
+    // shared empty timeline, actions point to it until their timeline is filled
+    static const CowData<Timeline> &empty(Type type);
 
     bool add_interval(Interval interval);
     bool remove_interval(Interval intervalToRemove);
     void cut(SecondsTS max);
     size_t nb_intervals() const;
     double sum_intervals() const;
+    bool is_filled(SecondsTS length) const;
 
     void fill(SecondsTS lenght);
     void clean();
@@ -75,5 +74,14 @@ private:
 
 };
 
+// fill/clean shared timelines, timelines with the same type and duration point to the same data
+struct TimelinesFiller{
+
+    void fill(CowData<Timeline> &timeline, SecondsTS duration);
+    static void clean(CowData<Timeline> &timeline);
+
+private:
+    std::vector<CowData<Timeline>> m_filled;
+};
 
 }
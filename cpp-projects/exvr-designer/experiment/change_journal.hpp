@@ -0,0 +1,150 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// base
+#include "utility/unordered_map.hpp"
+
+namespace tool::ex{
+
+// ############################################################################### CONSTANTS
+
+constexpr static int UpdateFlow        = 0b1;
+constexpr static int UpdateSelection   = 0b10;
+constexpr static int UpdateComponents  = 0b100;
+constexpr static int UpdateRoutines    = 0b1000;
+constexpr static int UpdateUI          = 0b10000;
+constexpr static int UpdateResources   = 0b100000;
+constexpr static int UpdateSettings    = 0b1000000;
+[[maybe_unused]] constexpr static int ResetUI           = 0b10000000;
+constexpr static int UpdateAll         = UpdateComponents | UpdateFlow | UpdateSelection | UpdateUI | UpdateRoutines | UpdateResources | UpdateSettings;
+
+// changes masks
+constexpr static int ChangeAdded       = 0b1;
+constexpr static int ChangeRemoved     = 0b10;
+constexpr static int ChangeMoved       = 0b100;
+constexpr static int ChangeRenamed     = 0b1000;
+constexpr static int ChangeModified    = 0b10000;
+constexpr static int ChangeStructure   = ChangeAdded | ChangeRemoved | ChangeMoved;
+
+struct ChangeJournal{
+
+    // components
+    inline void component_changed(int componentKey, int change){
+        components[componentKey] |= change;
+    }
+    inline void config_changed(int componentKey, int configKey, int change){
+        components[componentKey] |= ChangeModified;
+        configs[componentKey][configKey] |= change;
+    }
+
+    // routines
+    inline void condition_changed(int routineKey, int conditionKey, int change){
+        conditions[routineKey][conditionKey] |= change;
+    }
+    // condition entry is only added, a modified condition implies a full update of its widget
+    inline void action_changed(int routineKey, int conditionKey, int actionKey, int change){
+        conditions[routineKey][conditionKey] |= 0;
+        actions[routineKey][conditionKey][actionKey] |= change;
+    }
+    inline void connections_changed(int routineKey, int conditionKey){
+        conditions[routineKey][conditionKey] |= 0;
+        connections[routineKey][conditionKey] = true;
+    }
+
+    // the widgets can be patched only if every change of the category has been journaled
+    // and if no element of the category has been added, removed or moved
+    inline bool components_patchable() const noexcept{
+        if(untracked & UpdateComponents){
+            return false;
+        }
+        for(const auto &component : components){
+            if(component.second & ChangeStructure){
+                return false;
+            }
+        }
+        return true;
+    }
+    inline bool routines_patchable() const noexcept{
+        if(untracked & UpdateRoutines){
+            return false;
+        }
+        for(const auto &routine : conditions){
+            for(const auto &condition : routine.second){
+                if(condition.second & ChangeStructure){
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    inline int component_changes(int componentKey) const{
+        if(auto it = components.find(componentKey); it != components.end()){
+            return it->second;
+        }
+        return 0;
+    }
+
+    inline const umap<int,int> *conditions_changes(int routineKey) const{
+        if(auto it = conditions.find(routineKey); it != conditions.end()){
+            return &it->second;
+        }
+        return nullptr;
+    }
+
+    inline const umap<int,int> *actions_changes(int routineKey, int conditionKey) const{
+        if(auto itR = actions.find(routineKey); itR != actions.end()){
+            if(auto itC = itR->second.find(conditionKey); itC != itR->second.end()){
+                return &itC->second;
+            }
+        }
+        return nullptr;
+    }
+
+    inline bool connections_changes(int routineKey, int conditionKey) const{
+        if(auto itR = connections.find(routineKey); itR != connections.end()){
+            return itR->second.contains(conditionKey);
+        }
+        return false;
+    }
+
+    inline void clear(){
+        untracked = 0;
+        components.clear();
+        configs.clear();
+        conditions.clear();
+        actions.clear();
+        connections.clear();
+    }
+
+    int untracked = 0; /**< update flags added without details, the corresponding widgets must be fully updated */
+
+    umap<int, int> components;                          /**< component key -> changes */
+    umap<int, umap<int, int>> configs;                  /**< component key -> config key -> changes */
+    umap<int, umap<int, int>> conditions;               /**< routine key -> condition key -> changes */
+    umap<int, umap<int, umap<int, int>>> actions;       /**< routine key -> condition key -> action key -> changes */
+    umap<int, umap<int, bool>> connections;             /**< routine key -> condition key -> connections changed */
+};
+}
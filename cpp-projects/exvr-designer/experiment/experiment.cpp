@@ -842,7 +842,7 @@ void Experiment::update_condition_timeline(ElementKey routineKey, ConditionKey c
         condition->update_max_length(SecondsTS{duration});
         condition->scale = scale;
         condition->uiFactorSize = uiFactorSize;
-        add_to_update_flag(UpdateRoutines);
+        add_condition_change(routineKey, conditionKey, ChangeModified);
     }
 }
 
@@ -991,7 +991,7 @@ void Experiment::delete_actions_from_condition(ElementKey routineKey, ConditionK
     if(auto routine = get_routine(routineKey); routine != nullptr){
         routine->delete_actions_from_condition(conditionKey);
     }
-    add_to_update_flag(UpdateRoutines);
+    add_condition_change(routineKey, conditionKey, ChangeModified);
 }
 
 void Experiment::fill_actions_from_condition(ElementKey routineKey, ConditionKey conditionKey){
@@ -999,7 +999,7 @@ void Experiment::fill_actions_from_condition(ElementKey routineKey, ConditionKey
     if(auto routine = get_routine(routineKey); routine != nullptr){
         routine->fill_actions_from_condition(conditionKey);
     }
-    add_to_update_flag(UpdateRoutines);
+    add_condition_change(routineKey, conditionKey, ChangeModified);
 }
 
 void Experiment::clean_actions_from_condition(ElementKey routineKey, ConditionKey conditionKey){
@@ -1007,7 +1007,7 @@ void Experiment::clean_actions_from_condition(ElementKey routineKey, ConditionKe
     if(auto routine = get_routine(routineKey); routine != nullptr){
         routine->clean_actions_from_condition(conditionKey);
     }
-    add_to_update_flag(UpdateRoutines);
+    add_condition_change(routineKey, conditionKey, ChangeModified);
 }
 
 void Experiment::create_connection(ElementKey routineKey, ConditionKey conditionKey, Connection *connection){
@@ -1026,7 +1026,7 @@ void Experiment::delete_connections(ElementKey routineKey, ConditionKey conditio
         for(auto &action : condition->actions){
             action->nodeUsed = false;
         }
-        add_to_update_flag(UpdateRoutines);
+        add_condition_change(routineKey, conditionKey, ChangeModified);
     }
 }
 
@@ -1034,7 +1034,7 @@ void Experiment::create_connector_node(ElementKey routineKey, ConditionKey condi
 
     if(auto routine = get_routine(routineKey); routine != nullptr){
         routine->create_connector_node(conditionKey, connector);
-        add_to_update_flag(UpdateRoutines);
+        add_connections_change(routineKey, conditionKey);
     }
 }
 
@@ -1056,7 +1056,7 @@ void Experiment::duplicate_connector_node(ElementKey routineKey, ConditionKey co
 
     if(auto routine = get_routine(routineKey); routine != nullptr){
         routine->duplicate_connector_node(conditionKey, connectorKey);
-        add_to_update_flag(UpdateRoutines);
+        add_connections_change(routineKey, conditionKey);
     }
 }
 
@@ -1107,7 +1107,7 @@ void Experiment::delete_selected_nodes(ElementKey routineKey, ConditionKey condi
             condition->remove_component_node(componentKey);
         }
 
-        add_to_update_flag(UpdateRoutines);
+        add_connections_change(routineKey, conditionKey);
     }
 }
 
@@ -1127,7 +1127,7 @@ void Experiment::create_component_node(ElementKey routineKey, ConditionKey condi
             if(action->component->key() == componentKey.v){
                 action->nodeUsed     = true;
                 action->nodePosition = pos;
-                add_to_update_flag(UpdateRoutines);
+                add_connections_change(routineKey, conditionKey);
                 return;
             }
         }
@@ -1155,7 +1155,7 @@ void Experiment::unselect_nodes_and_connections(ElementKey routineKey, Condition
         }
 
         if(doUpdate){
-            add_to_update_flag(UpdateRoutines);
+            add_connections_change(routineKey, conditionKey);
         }
     }
 }
@@ -1181,7 +1181,7 @@ void Experiment::delete_nodes_and_connections(ElementKey routineKey, ConditionKe
         }
 
         if(doUpdate){
-            add_to_update_flag(UpdateRoutines);
+            add_connections_change(routineKey, conditionKey);
         }
     }
 }
@@ -1212,7 +1212,7 @@ void Experiment::select_nodes_and_connections(ElementKey routineKey, ConditionKe
         }
 
         if(doUpdate){
-            add_to_update_flag(UpdateRoutines);
+            add_connections_change(routineKey, conditionKey);
         }
     }
 }
@@ -1233,7 +1233,7 @@ auto Experiment::paste_nodes_clip_board(QPointF mousePosition, ElementKey routin
     NodesClipBoard::connectors.clear();
     NodesClipBoard::connections.clear();
     NodesClipBoard::enabled = false;
-    add_to_update_flag(UpdateRoutines);
+    add_connections_change(routineKey, conditionKey);
 }
 
 void Experiment::display_exp_infos(){
@@ -1272,7 +1272,7 @@ void Experiment::add_action(ElementKey routineKey, ConditionKey conditionKey, Co
                 condition->actions.push_back(Action::generate_component_action(
                     component, condition->duration, configKey, fillUpdateTimeline, fillVisibilityTimeline));
 
-                add_to_update_flag(UpdateRoutines);
+                add_action_change(routineKey, conditionKey, ActionKey{condition->actions.back()->key()}, ChangeAdded);
             }else{
                 QtLogger::message(QSL("[EXP] Component already added to timeline."));
             }
@@ -1291,6 +1291,8 @@ void Experiment::add_action_to_all_conditions(ElementKey routineKey, ComponentKe
         return;
     }
 
+    TimelinesFiller filler;
+
     if(auto routine = get_routine(routineKey); routine != nullptr){
 
         if(routine->isARandomizer){
@@ -1301,8 +1303,14 @@ void Experiment::add_action_to_all_conditions(ElementKey routineKey, ComponentKe
 
             if(auto action = condition->get_action_from_component_key(componentKey, false); action == nullptr){
 
-                condition->actions.push_back(Action::generate_component_action(
-                    component, condition->duration, configKey, fillUpdateTimeline, fillVisibilityTimeline));
+                auto &added = condition->actions.emplace_back(Action::generate_component_action(
+                    component, condition->duration, configKey, false, false));
+                if(fillUpdateTimeline){
+                    filler.fill(added->timelineUpdate, condition->duration);
+                }
+                if(fillVisibilityTimeline){
+                    filler.fill(added->timelineVisibility, condition->duration);
+                }
             }
         }
     }
@@ -1319,6 +1327,8 @@ void Experiment::add_action_to_all_routines_conditions(ComponentKey componentKey
         return;
     }
 
+    TimelinesFiller filler;
+
     for(auto &routine : get_elements_from_type<Routine>()){
 
         if(routine->isARandomizer){
@@ -1329,8 +1339,14 @@ void Experiment::add_action_to_all_routines_conditions(ComponentKey componentKey
 
             if(auto action = condition->get_action_from_component_key(componentKey, false); action == nullptr){
 
-                condition->actions.push_back(Action::generate_component_action(
-                    component, condition->duration, configKey, fillUpdateTimeline, fillVisibilityTimeline));
+                auto &added = condition->actions.emplace_back(Action::generate_component_action(
+                    component, condition->duration, configKey, false, false));
+                if(fillUpdateTimeline){
+                    filler.fill(added->timelineUpdate, condition->duration);
+                }
+                if(fillVisibilityTimeline){
+                    filler.fill(added->timelineVisibility, condition->duration);
+                }
             }
         }
     }
@@ -1376,6 +1392,8 @@ void Experiment::modify_action(ElementKey routineKey, ConditionKey conditionKey,
         return;
     }
 
+    TimelinesFiller filler;
+
     if(auto routine = get_routine(routineKey); routine != nullptr){
 
         if(routine->isARandomizer){
@@ -1394,20 +1412,20 @@ void Experiment::modify_action(ElementKey routineKey, ConditionKey conditionKey,
 
                 if(changeUpdateTimeline){
                     if(fillUpdateTimeline){
-                        action->timelineUpdate->fill(condition->duration);
+                        filler.fill(action->timelineUpdate, condition->duration);
                     }else{
-                        action->timelineUpdate->clean();
+                        TimelinesFiller::clean(action->timelineUpdate);
                     }
                 }
 
                 if(changeVisibilityTimeline){
                     if(fillVisibilityTimeline){
-                        action->timelineVisibility->fill(condition->duration);
+                        filler.fill(action->timelineVisibility, condition->duration);
                     }else{
-                        action->timelineVisibility->clean();
+                        TimelinesFiller::clean(action->timelineVisibility);
                     }
                 }
-                add_to_update_flag(UpdateRoutines);
+                add_action_change(routineKey, conditionKey, ActionKey{action->key()}, ChangeModified);
             }
         }
     }
@@ -1424,6 +1442,8 @@ void Experiment::modify_action_to_all_conditions(ElementKey routineKey, Componen
         return;
     }
 
+    TimelinesFiller filler;
+
     if(auto routine = get_routine(routineKey); routine != nullptr){
 
         if(routine->isARandomizer){
@@ -1442,17 +1462,17 @@ void Experiment::modify_action_to_all_conditions(ElementKey routineKey, Componen
 
                 if(changeUpdateTimeline){
                     if(fillUpdateTimeline){
-                        action->timelineUpdate->fill(condition->duration);
+                        filler.fill(action->timelineUpdate, condition->duration);
                     }else{
-                        action->timelineUpdate->clean();
+                        TimelinesFiller::clean(action->timelineUpdate);
                     }
                 }
 
                 if(changeVisibilityTimeline){
                     if(fillVisibilityTimeline){
-                        action->timelineVisibility->fill(condition->duration);
+                        filler.fill(action->timelineVisibility, condition->duration);
                     }else{
-                        action->timelineVisibility->clean();
+                        TimelinesFiller::clean(action->timelineVisibility);
                     }
                 }
             }
@@ -1471,6 +1491,8 @@ void Experiment::modify_action_to_all_routines_conditions(ComponentKey component
         return;
     }
 
+    TimelinesFiller filler;
+
     for(auto &routine : get_elements_from_type<Routine>()){
 
         if(routine->isARandomizer){
@@ -1489,17 +1511,17 @@ void Experiment::modify_action_to_all_routines_conditions(ComponentKey component
 
                 if(changeUpdateTimeline){
                     if(fillUpdateTimeline){
-                        action->timelineUpdate->fill(condition->duration);
+                        filler.fill(action->timelineUpdate, condition->duration);
                     }else{
-                        action->timelineUpdate->clean();
+                        TimelinesFiller::clean(action->timelineUpdate);
                     }
                 }
 
                 if(changeVisibilityTimeline){
                     if(fillVisibilityTimeline){
-                        action->timelineVisibility->fill(condition->duration);
+                        filler.fill(action->timelineVisibility, condition->duration);
                     }else{
-                        action->timelineVisibility->clean();
+                        TimelinesFiller::clean(action->timelineVisibility);
                     }
                 }
             }
@@ -1547,13 +1569,14 @@ void Experiment::fill_action(ElementKey routineKey, ConditionKey conditionKey, A
 
     if(auto condition = get_condition(routineKey, conditionKey); condition != nullptr){
         if(auto action = condition->get_action_from_key(actionKey); action != nullptr){
+            TimelinesFiller filler;
             if(update){
-                action->timelineUpdate->fill(condition->duration);
+                filler.fill(action->timelineUpdate, condition->duration);
             }
             if(visibility){
-                action->timelineVisibility->fill(condition->duration);
+                filler.fill(action->timelineVisibility, condition->duration);
             }
-            add_to_update_flag(UpdateRoutines);
+            add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
         }
     }
 }
@@ -1563,12 +1586,12 @@ void Experiment::clean_action(ElementKey routineKey, ConditionKey conditionKey,
     if(auto condition = get_condition(routineKey, conditionKey); condition != nullptr){
         if(auto action = condition->get_action_from_key(actionKey); action != nullptr){
             if(update){
-                action->timelineUpdate->clean();
+                TimelinesFiller::clean(action->timelineUpdate);
             }
             if(visibility){
-                action->timelineVisibility->clean();
+                TimelinesFiller::clean(action->timelineVisibility);
             }
-            add_to_update_flag(UpdateRoutines);
+            add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
         }
     }
 }
@@ -1579,7 +1602,7 @@ void Experiment::remove_action_from_condition(ElementKey routineKey, ConditionKe
         condition->remove_action(actionKey);
 
         if(update){
-            add_to_update_flag(UpdateRoutines);
+            add_action_change(routineKey, conditionKey, actionKey, ChangeRemoved);
         }
     }
 }
@@ -1588,7 +1611,7 @@ void Experiment::move_action_up(ElementKey routineKey, ConditionKey conditionKey
 
     if(auto condition = get_condition(routineKey, conditionKey); condition != nullptr){
         condition->move_action_up(actionKey);
-        add_to_update_flag(UpdateRoutines);
+        add_action_change(routineKey, conditionKey, actionKey, ChangeMoved);
     }
 }
 
@@ -1596,7 +1619,7 @@ void Experiment::move_action_down(ElementKey routineKey, ConditionKey conditionK
 
     if(auto condition = get_condition(routineKey, conditionKey); condition != nullptr){
         condition->move_action_down(actionKey);
-        add_to_update_flag(UpdateRoutines);
+        add_action_change(routineKey, conditionKey, actionKey, ChangeMoved);
     }
 }
 
@@ -1604,7 +1627,7 @@ void Experiment::select_action_config(ElementKey routineKey, ConditionKey condit
 
     if(auto action = get_action(routineKey, conditionKey, actionKey); action != nullptr){
         action->select_config(configTabId);
-        add_to_update_flag(UpdateRoutines);
+        add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
     }
 }
 
@@ -1668,6 +1691,12 @@ void Experiment::modify_loop_no_following_value(ElementKey loopKey, bool state){
     }
 }
 
+void Experiment::modify_loop_constraints(ElementKey loopKey, int maxRepeats, int minDistance){
+    if(auto loop = get_loop(loopKey); loop != nullptr){
+        loop->set_constraints(maxRepeats, minDistance);
+    }
+}
+
 void Experiment::remove_set(ElementKey loopKey, RowId id){
     if(auto loop = get_loop(loopKey); loop != nullptr){
         loop->remove_set(id);
@@ -1727,12 +1756,12 @@ void Experiment::add_timeline_interval(ElementKey routineKey, ConditionKey condi
     if(auto action = get_action(routineKey, conditionKey, actionKey); action != nullptr){
 
         if(updateTimeline){
-            if(action->timelineUpdate->add_interval(std::move(interval))){
-                add_to_update_flag(UpdateRoutines);
+            if(action->timelineUpdate.edit().add_interval(std::move(interval))){
+                add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
             }
         }else{
-            if(action->timelineVisibility->add_interval(std::move(interval))){
-                add_to_update_flag(UpdateRoutines);
+            if(action->timelineVisibility.edit().add_interval(std::move(interval))){
+                add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
             }
         }        
     }
@@ -1742,12 +1771,12 @@ void Experiment::remove_timeline_interval(ElementKey routineKey, ConditionKey co
 
     if(auto action = get_action(routineKey, conditionKey, actionKey); action != nullptr){
         if(updateTimeline){
-            if(action->timelineUpdate->remove_interval(std::move(interval))){
-                add_to_update_flag(UpdateRoutines);
+            if(action->timelineUpdate.edit().remove_interval(std::move(interval))){
+                add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
             }
         }else{
-            if(action->timelineVisibility->remove_interval(std::move(interval))){
-                add_to_update_flag(UpdateRoutines);
+            if(action->timelineVisibility.edit().remove_interval(std::move(interval))){
+                add_action_change(routineKey, conditionKey, actionKey, ChangeModified);
             }
         }        
     }
@@ -2023,7 +2052,7 @@ void Experiment::update_conditions(){
 
 void Experiment::update_component_position(ComponentKey componentKey, RowId id){    
     compM.update_component_position(componentKey, id);
-    add_to_update_flag(UpdateComponents);
+    add_component_change(componentKey, ChangeMoved);
 }
 
 void Experiment::remove_component(ComponentKey componentKey){
@@ -2063,7 +2092,8 @@ void Experiment::copy_component(Component *component, std::vector<ConfigKey> con
 void Experiment::update_component_name(ComponentKey componentKey, QString name){
 
     if(compM.update_component_name(componentKey, name)){
-        add_to_update_flag(UpdateComponents | UpdateRoutines);
+        add_component_change(componentKey, ChangeRenamed);
+        add_to_update_flag(UpdateRoutines);
     }
 }
 
@@ -2160,7 +2190,8 @@ void Experiment::delete_unused_components(){
 void Experiment::select_config_in_component(ComponentKey componentKey, RowId id){
     if(auto component = get_component(componentKey); component != nullptr){
         if(component->select_config(id)){
-            add_to_update_flag(UpdateComponents | UpdateRoutines);
+            add_component_change(componentKey, ChangeModified);
+            add_to_update_flag(UpdateRoutines);
         }
     }
 }
@@ -2169,7 +2200,8 @@ void Experiment::insert_config_in_component(ComponentKey componentKey, RowId id,
 
     if(auto component = get_component(componentKey); component != nullptr){
         if(component->insert_config(id, configName)){
-            add_to_update_flag(UpdateComponents | UpdateRoutines);
+            add_component_change(componentKey, ChangeModified);
+            add_to_update_flag(UpdateRoutines);
         }
     }
 }
@@ -2178,7 +2210,8 @@ void Experiment::copy_config_from_component(ComponentKey componentKey, RowId id,
 
     if(auto component = get_component(componentKey); component != nullptr){
         if(component->copy_config(id, configName)){
-            add_to_update_flag(UpdateComponents | UpdateRoutines);
+            add_component_change(componentKey, ChangeModified);
+            add_to_update_flag(UpdateRoutines);
         }
     }
 }
@@ -2213,14 +2246,16 @@ void Experiment::remove_config_from_component(ComponentKey componentKey, RowId i
         }
 
         component->remove_config(id);
-        add_to_update_flag(UpdateComponents | UpdateRoutines);
+        add_config_change(componentKey, configKey, ChangeRemoved);
+        add_to_update_flag(UpdateRoutines);
     }
 }
 
 void Experiment::move_config_in_component(ComponentKey componentKey, RowId from, RowId to){
     if(auto component = get_component(componentKey); component != nullptr){        
         if(component->move_config(from, to)){
-            add_to_update_flag(UpdateComponents | UpdateRoutines);
+            add_component_change(componentKey, ChangeModified);
+            add_to_update_flag(UpdateRoutines);
         }
     }
 }
@@ -2229,7 +2264,8 @@ void Experiment::rename_config_in_component(ComponentKey componentKey, RowId id,
 
     if(auto component = get_component(componentKey); component != nullptr){
         if(component->rename_config(id, configName)){
-            add_to_update_flag(UpdateComponents | UpdateRoutines);
+            add_component_change(componentKey, ChangeModified);
+            add_to_update_flag(UpdateRoutines);
         }
     }
 }
@@ -2432,13 +2468,15 @@ void Experiment::clean_experiment(){
     states.reset();
 }
 
-void Experiment::update_exp_launcher_state(ExpLauncherState state, QStringView infos){
+void Experiment::update_exp_launcher_state(ExpLauncherState state, QString infos){
     Q_UNUSED(infos)
     states.explauncherState = state;
     add_to_update_flag(UpdateUI);
 }
 
-void Experiment::update_exp_state(ExpState state, QStringView infos){
+void Experiment::update_exp_state(ExpState state, QString stateInfos){
+
+    QStringView infos = stateInfos;
 
     states.expState = state;
     if(states.expState == ExpState::Loaded){
@@ -2576,12 +2614,12 @@ void Experiment::toggle_follow_condition_mode(){
     add_to_update_flag(UpdateUI);
 }
 
-void Experiment::update_connector_dialog_with_info(ElementKey elementKey, ConditionKey conditionKey, ConnectorKey connectorKey, QStringView id, QStringView value){
-    connectorsInfo[elementKey.v][conditionKey.v][connectorKey.v][id] = value;
+void Experiment::update_connector_dialog_with_info(ElementKey elementKey, ConditionKey conditionKey, ConnectorKey connectorKey, QString id, QString value){
+    connectorsInfo[elementKey.v][conditionKey.v][connectorKey.v][std::move(id)] = std::move(value);
 }
 
-void Experiment::update_component_dialog_with_info(ComponentKey componentKey, ConfigKey configKey, QStringView id, QStringView value){
-    componentsInfo[componentKey.v][configKey.v][id] = value;
+void Experiment::update_component_dialog_with_info(ComponentKey componentKey, ConfigKey configKey, QString id, QString value){
+    componentsInfo[componentKey.v][configKey.v][std::move(id)] = std::move(value);
 }
 
 void Experiment::set_instance_name(QString instanceName){
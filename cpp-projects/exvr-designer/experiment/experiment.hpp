@@ -43,6 +43,7 @@
 #include "resources/resources_manager.hpp"
 // # experiment
 #include "randomizer.hpp"
+#include "change_journal.hpp"
 
 namespace tex = tool::ex;
 
@@ -51,19 +52,6 @@ concept FlowElementDerived = std::is_base_of<tex::FlowElement, T>::value;
 
 namespace tool::ex{
 
-// ############################################################################### CONSTANTS
-
-constexpr static int UpdateFlow        = 0b1;
-constexpr static int UpdateSelection   = 0b10;
-constexpr static int UpdateComponents  = 0b100;
-constexpr static int UpdateRoutines    = 0b1000;
-constexpr static int UpdateUI          = 0b10000;
-constexpr static int UpdateResources   = 0b100000;
-constexpr static int UpdateSettings    = 0b1000000;
-[[maybe_unused]] constexpr static int ResetUI           = 0b10000000;
-constexpr static int UpdateAll         = UpdateComponents | UpdateFlow | UpdateSelection | UpdateUI | UpdateRoutines | UpdateResources | UpdateSettings;
-
-
 class Experiment;
 using ExperimentUP = std::unique_ptr<Experiment>;
 
@@ -144,10 +132,37 @@ public:
     void check_integrity();
 
     // update flags
-    inline void set_update_all_flag() noexcept{updateFlag = UpdateAll;}
-    inline void add_to_update_flag(int flag) noexcept{updateFlag |= flag;}
-    inline void reset_update_flag() noexcept{updateFlag = 0;}
+    inline void set_update_all_flag() noexcept{updateFlag = UpdateAll; m_journal.untracked = UpdateAll;}
+    inline void add_to_update_flag(int flag) noexcept{updateFlag |= flag; m_journal.untracked |= flag;}
+    inline void reset_update_flag() noexcept{updateFlag = 0; m_journal.clear();}
     inline int update_flag() const noexcept {return updateFlag;}
+    // # journaled changes, allow the widgets to only update the modified rows
+    inline void add_component_change(ComponentKey componentKey, int change){
+        updateFlag |= UpdateComponents;
+        m_journal.component_changed(componentKey.v, change);
+    }
+    inline void add_config_change(ComponentKey componentKey, ConfigKey configKey, int change){
+        updateFlag |= UpdateComponents;
+        m_journal.config_changed(componentKey.v, configKey.v, change);
+    }
+    inline void add_condition_change(ElementKey routineKey, ConditionKey conditionKey, int change){
+        updateFlag |= UpdateRoutines;
+        m_journal.condition_changed(routineKey.v, conditionKey.v, change);
+    }
+    inline void add_action_change(ElementKey routineKey, ConditionKey conditionKey, ActionKey actionKey, int change){
+        updateFlag |= UpdateRoutines;
+        m_journal.action_changed(routineKey.v, conditionKey.v, actionKey.v, change);
+    }
+    inline void add_connections_change(ElementKey routineKey, ConditionKey conditionKey){
+        updateFlag |= UpdateRoutines;
+        m_journal.connections_changed(routineKey.v, conditionKey.v);
+    }
+    inline const ChangeJournal &journal() const noexcept{return m_journal;}
+    // moves the journaled changes to the consumer, the previous content of the argument is dropped
+    inline void take_journal(ChangeJournal &journal) noexcept{
+        std::swap(journal, m_journal);
+        m_journal.clear();
+    }
 
 public slots:
 
@@ -181,11 +196,11 @@ public slots:
     void toggle_design_mode();
     void toggle_follow_condition_mode();
     // # infos
-    void update_connector_dialog_with_info(tex::ElementKey elementKey, tex::ConditionKey conditionKey, tex::ConnectorKey connectorKey, QStringView id, QStringView value);
-    void update_component_dialog_with_info(tex::ComponentKey componentKey, tex::ConfigKey configKey, QStringView id, QStringView value);
+    void update_connector_dialog_with_info(tex::ElementKey elementKey, tex::ConditionKey conditionKey, tex::ConnectorKey connectorKey, QString id, QString value);
+    void update_component_dialog_with_info(tex::ComponentKey componentKey, tex::ConfigKey configKey, QString id, QString value);
     // # states
-    void update_exp_launcher_state(tex::ExpLauncherState state, QStringView infos);
-    void update_exp_state(tex::ExpState state, QStringView infos);
+    void update_exp_launcher_state(tex::ExpLauncherState state, QString infos);
+    void update_exp_state(tex::ExpState state, QString infos);
 
     // components
     void add_new_component(tex::Component::Type type, tex::RowId id);
@@ -241,6 +256,7 @@ public slots:
     void modify_loop_nb_reps(tex::ElementKey loopKey, int nbReps);
     void modify_loop_N(tex::ElementKey loopKey, int N);
     void modify_loop_no_following_value(tex::ElementKey loopKey, bool state);
+    void modify_loop_constraints(tex::ElementKey loopKey, int maxRepeats, int minDistance);
     void remove_set(tex::ElementKey loopKey, tex::RowId id);
     void sort_loop_sets_lexico(tex::ElementKey loopKey);
     void sort_loop_sets_num(tex::ElementKey loopKey);
@@ -349,8 +365,8 @@ public :
     ResourcesManager resM;
 
     // infos
-    using UiKey   = QStringView;
-    using UiValue = QStringView;
+    using UiKey   = QString;
+    using UiValue = QString;
     template<class T1,class T2>
     using umap = umap<T1,T2>;
     umap<int, umap<int, umap<int, umap<UiKey, UiValue>>>> connectorsInfo;
@@ -360,6 +376,7 @@ private :
 
     // update
     int updateFlag = 0;
+    ChangeJournal m_journal;
 
     GUI m_gui;
     Settings m_settings;
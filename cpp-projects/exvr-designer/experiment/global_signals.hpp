@@ -58,12 +58,13 @@ signals:
     auto fix_colors_signal() -> void;
 
     // state
-    auto exp_launcher_state_updated_signal(tool::ex::ExpLauncherState state, QStringView infos) -> void;
-    auto exp_state_updated_signal(tool::ex::ExpState state, QStringView infos) -> void;
+    auto exp_launcher_state_updated_signal(tool::ex::ExpLauncherState state, QString infos) -> void;
+    auto exp_state_updated_signal(tool::ex::ExpState state, QString infos) -> void;
 
     // info
-    auto component_info_update_signal(tool::ex::ComponentKey componentKey, tool::ex::ConfigKey configKey, QStringView id, QStringView value) -> void;
-    auto connector_info_update_signal(tool::ex::ElementKey elementKey, tool::ex::ConditionKey conditionKey, tool::ex::ConnectorKey connectorKey, QStringView uiName, QStringView value) -> void;
+    // emitted from the exp-launcher thread, the strings own their data
+    auto component_info_update_signal(tool::ex::ComponentKey componentKey, tool::ex::ConfigKey configKey, QString id, QString value) -> void;
+    auto connector_info_update_signal(tool::ex::ElementKey elementKey, tool::ex::ConditionKey conditionKey, tool::ex::ConnectorKey connectorKey, QString uiName, QString value) -> void;
 
     // instances
     auto generate_instances_signal(QString directoryPath, unsigned int seed, bool manual, int nbInstances, int startId, QString baseName, QStringList manualNames) -> void;
@@ -125,6 +126,7 @@ signals:
     auto modify_loop_nb_reps_signal(tool::ex::ElementKey loopKey, int nbReps) -> void;
     auto modify_loop_n_signal(tool::ex::ElementKey loopKey, int nbReps) -> void;
     auto modify_loop_no_following_value_signal(tool::ex::ElementKey loopKey, bool state) -> void;
+    auto modify_loop_constraints_signal(tool::ex::ElementKey loopKey, int maxRepeats, int minDistance) -> void;
     auto modify_loop_type_signal(tool::ex::ElementKey loopKey, tool::ex::Loop::Mode mode) -> void;
     auto modify_loop_set_name_signal(tool::ex::ElementKey loopKey, QString set, tool::ex::RowId idSet) -> void;
     auto modify_loop_set_occurrencies_nb_signal(tool::ex::ElementKey loopKey, int occurenciesNb, tool::ex::RowId idSet) -> void;
@@ -187,6 +187,55 @@ Instance::Instance(const Randomizer *randomizer, const std::vector<FlowElement*>
                     setsNames.push_back(set);
                 }
 
+            break;}case Loop::Mode::ConstrainedShuffle:{
+
+                // sets counts of the full blocks, the remaining trials are drawn from a shuffled block
+                auto instanceGen = randomizer->instance_generator(idInstance, loop->key());
+                const size_t blockSize = setsOccurenciesStr.size();
+                std::vector<size_t> counts(loop->sets.size(), 0);
+                std::vector<size_t> blockIds;
+                blockIds.reserve(blockSize);
+                for(size_t ii = 0; ii < loop->sets.size(); ++ii){
+                    counts[ii] = loop->sets[ii]->occurencies * (totalNbReps / blockSize);
+                    blockIds.insert(blockIds.end(), loop->sets[ii]->occurencies, ii);
+                }
+                std::shuffle(blockIds.begin(), blockIds.end(), instanceGen);
+                for(size_t ii = 0; ii < totalNbReps % blockSize; ++ii){
+                    ++counts[blockIds[ii]];
+                }
+
+                SequenceConstraints constraints;
+                constraints.maxRepeats  = to_size_t(loop->maxRepeats);
+                constraints.minDistance = to_size_t(loop->minDistance);
+                if(loop->noFollowingValues){
+                    constraints.maxRepeats = 1;
+                }
+
+                size_t nbViolations = 0;
+                setsNames.reserve(totalNbReps);
+                for(auto id : Randomizer::generate_constrained_ids(counts, constraints, instanceGen, &nbViolations)){
+                    setsNames.push_back(loop->sets[to_size_t(id)]->name);
+                }
+                if(nbViolations > 0){
+                    QtLogger::warning(QSL("[Instance] Loop ") % loop->name() % QSL(" constraints cannot be satisfied for ") %
+                        QString::number(nbViolations) % QSL(" trial(s) of instance ") % QString::number(idInstance));
+                }
+
+            break;}case Loop::Mode::BalancedTransitions:{
+
+                auto instanceGen = randomizer->instance_generator(idInstance, loop->key());
+                setsNames.reserve(totalNbReps);
+                for(auto id : Randomizer::generate_balanced_transitions_ids(loop->sets.size(), totalNbReps, loop->noFollowingValues, instanceGen)){
+                    setsNames.push_back(loop->sets[to_size_t(id)]->name);
+                }
+
+            break;}case Loop::Mode::WilliamsInstances:{
+
+                setsNames.reserve(totalNbReps);
+                for(auto id : Randomizer::generate_williams_ids(loop->sets.size(), totalNbReps, idInstance)){
+                    setsNames.push_back(loop->sets[to_size_t(id)]->name);
+                }
+
             break;}
             default:
             break;
@@ -231,42 +280,32 @@ Instance::Instance(const Randomizer *randomizer, const std::vector<FlowElement*>
 
 
 
+    QString conditionName;
     for(size_t ii = 0; ii < elements.size(); ++ii){
 
         if(elements[ii]->type() == FlowElement::Type::Routine){
 
             auto routine = dynamic_cast<Routine*>(elements[ii]);
 
-
-            // generate new instance element with routine
-            InstanceElement instanceElem;
-            instanceElem.elem = routine;
-
             // retrieve condition
-            QStringList conditions;
-            conditions.reserve(static_cast<int>(routine->insideLoops.size()));
-            for(const auto &loop : routine->insideLoops){
-                conditions << loopsSetsNames[loop->key()][loopsCurentSetId[loop->key()]].toString();
-            }
-            if(conditions.size() > 0){
-                instanceElem.condition = conditions.join('-');
+            if(routine->insideLoops.size() > 0){
+                conditionName.clear();
+                for(const auto &loop : routine->insideLoops){
+                    if(&loop != &routine->insideLoops.front()){
+                        conditionName += '-';
+                    }
+                    conditionName += loopsSetsNames[loop->key()][loopsCurentSetId[loop->key()]];
+                }
+                add_element(routine, conditionName);
             }else{
-                instanceElem.condition = QSL("default");
+                add_element(routine, QSL("default"));
             }
-            flow.emplace_back(std::move(instanceElem));
 
         }else if(elements[ii]->type() == FlowElement::Type::Isi){
 
             auto isi = dynamic_cast<Isi*>(elements[ii]);
-
-            // generate new instance element with ISI
-            InstanceElement instanceElem;
-            instanceElem.elem = isi;
-
-            instanceElem.condition = QString::number(isisIntervals[isi->key()][isisCurentIntervalId[isi->key()]]);
+            add_element(isi, QString::number(isisIntervals[isi->key()][isisCurentIntervalId[isi->key()]]));
             isisCurentIntervalId[isi->key()]++;
-            flow.emplace_back(std::move(instanceElem));
-
 
         }else if(elements[ii]->type() == FlowElement::Type::LoopStart){
 
@@ -313,46 +352,78 @@ Instance::Instance(const Randomizer *randomizer, const std::vector<FlowElement*>
     // count iterations
     for(auto &element : flow){
 
-        const auto key = element.elem->e_key();
-        const QString cond = element.condition;
+        const auto key  = element.elem->e_key();
+        const auto cond = element.conditionId;
 
         if(element.elem->type() == FlowElement::Type::Routine){
+            element.elementIteration   = routinesIterations[key]++;
+            element.conditionIteration = routinesConditionsIterations[key][cond]++;
+        }else if(element.elem->type() == FlowElement::Type::Isi){
+            element.elementIteration   = isisIterations[key]++;
+            element.conditionIteration = isisConditionsIterations[key][cond]++;
+        }
+    }
 
-            if(routinesIterations.count(key) == 0){
-                routinesIterations[key] = 0;
-            }
-            if(routinesConditionsIterations.count(key) == 0){
-                routinesConditionsIterations[key] = {};
-            }
-            if(routinesConditionsIterations[key].count(cond) == 0){
-                routinesConditionsIterations[key][cond] = 0;
-            }
+    update_index();
+}
 
-            element.elementIteration   = routinesIterations[key];
-            element.conditionIteration = routinesConditionsIterations[key][cond];
+auto Instance::intern_condition(const QString &condition) -> std::uint32_t{
+    if(auto it = m_conditionsIds.find(condition); it != m_conditionsIds.end()){
+        return it->second;
+    }
+    const auto id = static_cast<std::uint32_t>(conditions.size());
+    conditions.push_back(condition);
+    m_conditionsIds[condition] = id;
+    return id;
+}
 
-            routinesIterations[key]++;
-            routinesConditionsIterations[key][cond]++;            
+auto Instance::add_element(FlowElement *elem, const QString &condition, int elementIteration, int conditionIteration) -> void{
+    InstanceElement element;
+    element.elementIteration   = elementIteration;
+    element.conditionIteration = conditionIteration;
+    element.elem               = elem;
+    element.conditionId        = intern_condition(condition);
+    flow.push_back(element);
+}
 
-        }else if(element.elem->type() == FlowElement::Type::Isi){
+auto Instance::update_index() -> void{
 
-            if(isisIterations.count(key) == 0){
-                isisIterations[key] = 0;
-            }
-            if(isisConditionsIterations.count(key) == 0){
-                isisConditionsIterations[key] = {};
-            }
-            if(isisConditionsIterations[key].count(cond) == 0){
-                isisConditionsIterations[key][cond] = 0;
-            }
+    m_conditionsPositions.clear();
+    m_elementsPositions.clear();
 
-            element.elementIteration   = isisIterations[key];
-            element.conditionIteration = isisConditionsIterations[key][cond];
+    std::int32_t orderId = 0;
+    for(size_t ii = 0; ii < flow.size(); ++ii){
 
-            isisIterations[key]++;
-            isisConditionsIterations[key][cond]++;
+        auto &element = flow[ii];
+        if(element.elem->is_routine() && dynamic_cast<Routine*>(element.elem)->isARandomizer){
+            element.orderId = -1;
+        }else{
+            element.orderId = orderId++;
         }
+
+        const auto position = static_cast<std::uint32_t>(ii);
+        m_conditionsPositions[index_key(element.elem->key(), element.conditionId)].push_back(position);
+        m_elementsPositions[element.elem->key()].push_back(position);
+    }
+}
+
+auto Instance::positions(ElementKey elementKey, const QString &condition) const -> const std::vector<std::uint32_t>*{
+
+    auto conditionId = m_conditionsIds.find(condition);
+    if(conditionId == m_conditionsIds.end()){
+        return nullptr;
+    }
+    if(auto it = m_conditionsPositions.find(index_key(elementKey.v, conditionId->second)); it != m_conditionsPositions.end()){
+        return &it->second;
+    }
+    return nullptr;
+}
+
+auto Instance::positions(ElementKey elementKey) const -> const std::vector<std::uint32_t>*{
+    if(auto it = m_elementsPositions.find(elementKey.v); it != m_elementsPositions.end()){
+        return &it->second;
     }
+    return nullptr;
 }
 
 std::unique_ptr<Instance> Instance::generate_from_one_routine(Routine *routine){
@@ -371,7 +442,8 @@ std::unique_ptr<Instance> Instance::generate_from_one_routine(Routine *routine){
         conditionName = routine->conditions[0]->name;
     }
 
-    instance->flow.emplace_back(InstanceElement{0, 0, routine, conditionName});
+    instance->add_element(routine, conditionName);
+    instance->update_index();
     return instance;
 }
 
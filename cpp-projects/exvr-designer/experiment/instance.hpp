@@ -24,6 +24,9 @@
 
 #pragma once
 
+// std
+#include <cstdint>
+
 // qt-utility
 //#include "qt_str.hpp"
 
@@ -44,8 +47,9 @@ struct LoopInfo{
 struct InstanceElement{
     int elementIteration = 0;
     int conditionIteration = 0;
-    FlowElement *elem;
-    QString condition;
+    FlowElement *elem = nullptr;
+    std::uint32_t conditionId = 0;  /**< index in Instance::conditions */
+    std::int32_t orderId = -1;      /**< id sent to the exp launcher, -1 for randomizer routines */
 };
 
 struct Instance {
@@ -63,16 +67,36 @@ struct Instance {
     static inline umap<int, std::vector<QStringView>> everyNShuffleLoopSets = {};
     static inline umap<int, std::vector<QStringView>> everyNRandomLoopSets = {};
 
+    // flow
+    auto add_element(FlowElement *elem, const QString &condition, int elementIteration = 0, int conditionIteration = 0) -> void;
+    auto intern_condition(const QString &condition) -> std::uint32_t;
+    inline auto condition(const InstanceElement &element) const -> const QString& {return conditions[element.conditionId];}
+    // # reverse index, call update_index once the flow is complete
+    auto update_index() -> void;
+    auto positions(ElementKey elementKey, const QString &condition) const -> const std::vector<std::uint32_t>*;
+    auto positions(ElementKey elementKey) const -> const std::vector<std::uint32_t>*;
+
     QString filePath = "";
     QString fileName = "debug-instance";
     size_t idInstance = 0;
     std::vector<InstanceElement> flow;
+    std::vector<QString> conditions;                /**< interned conditions names and ISI intervals */
 
     // count iterations
     umap<ElementKey, int> routinesIterations;
-    umap<ElementKey, umap<QString, int>> routinesConditionsIterations;
+    umap<ElementKey, umap<std::uint32_t, int>> routinesConditionsIterations;
     umap<ElementKey, int> isisIterations;
-    umap<ElementKey, umap<QString, int>> isisConditionsIterations;
+    umap<ElementKey, umap<std::uint32_t, int>> isisConditionsIterations;
+
+private:
+
+    static constexpr auto index_key(int elementKey, std::uint32_t conditionId) noexcept -> std::uint64_t{
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(elementKey)) << 32) | conditionId;
+    }
+
+    umap<QString, std::uint32_t> m_conditionsIds;
+    umap<std::uint64_t, std::vector<std::uint32_t>> m_conditionsPositions;  /**< (element, condition) -> flow positions */
+    umap<int, std::vector<std::uint32_t>> m_elementsPositions;             /**< element -> flow positions */
 };
 
 }
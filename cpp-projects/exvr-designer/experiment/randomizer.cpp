@@ -25,14 +25,25 @@
 
 #include "randomizer.hpp"
 
+// std
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
 using namespace tool::ex;
 
-Randomizer::Randomizer(unsigned int seed){
+Randomizer::Randomizer(unsigned int seed) : m_seed(seed){
     gen = std::make_unique<std::mt19937>(seed);
 }
 
-Randomizer::Randomizer(std::random_device &rd) {
-    gen = std::make_unique<std::mt19937>(rd());
+Randomizer::Randomizer(std::random_device &rd) : m_seed(rd()){
+    gen = std::make_unique<std::mt19937>(m_seed);
+}
+
+std::mt19937 Randomizer::instance_generator(size_t idInstance, int key) const{
+    std::seed_seq seq{m_seed, static_cast<unsigned int>(idInstance), static_cast<unsigned int>(key)};
+    return std::mt19937(seq);
 }
 
 size_t Randomizer::randomize_start(size_t containerSize) const{
@@ -147,3 +158,212 @@ std::vector<int> Randomizer::generate_random_ids(size_t nbValues, size_t reps, b
     }
     return randomIds;
 }
+
+std::vector<int> Randomizer::generate_constrained_ids(const std::vector<size_t> &counts, SequenceConstraints constraints, std::mt19937 &gen, size_t *nbViolations){
+
+    constexpr size_t never = std::numeric_limits<size_t>::max();
+    const size_t nbValues = counts.size();
+    const size_t total    = std::accumulate(counts.begin(), counts.end(), size_t{0});
+
+    std::vector<int> ids;
+    ids.reserve(total);
+
+    std::vector<size_t> remaining = counts;
+    std::vector<size_t> lastPosition(nbValues, never);
+    std::vector<size_t> eligibles;
+    eligibles.reserve(nbValues);
+
+    // necessary conditions for the remaining values to fit in the remaining positions:
+    // min distance d: (rMax-1)*d + nbMax <= positions, max repeats k: rMax <= k*(positions-rMax+1)
+    auto fits_after = [&](size_t id, size_t positionsLeft){
+        size_t rMax = 0, nbMax = 0;
+        for(size_t ii = 0; ii < nbValues; ++ii){
+            const size_t r = remaining[ii] - (ii == id ? 1 : 0);
+            if(r > rMax){
+                rMax  = r;
+                nbMax = 1;
+            }else if(r == rMax){
+                ++nbMax;
+            }
+        }
+        if(rMax == 0){
+            return true;
+        }
+        if(constraints.minDistance > 1 && ((rMax-1)*constraints.minDistance + nbMax) > positionsLeft){
+            return false;
+        }
+        if(constraints.maxRepeats > 0 && rMax > constraints.maxRepeats*(positionsLeft - rMax + 1)){
+            return false;
+        }
+        return true;
+    };
+
+    size_t violations = 0;
+    size_t previous   = never;
+    size_t run        = 0;
+
+    for(size_t pos = 0; pos < total; ++pos){
+
+        eligibles.clear();
+        size_t weightsSum = 0;
+        for(size_t ii = 0; ii < nbValues; ++ii){
+            if(remaining[ii] == 0){
+                continue;
+            }
+            if(constraints.maxRepeats > 0 && ii == previous && run >= constraints.maxRepeats){
+                continue;
+            }
+            if(constraints.minDistance > 1 && lastPosition[ii] != never && (pos - lastPosition[ii]) < constraints.minDistance){
+                continue;
+            }
+            eligibles.push_back(ii);
+            weightsSum += remaining[ii];
+        }
+
+        size_t id = never;
+        if(!eligibles.empty()){
+
+            // random pick weighted by the remaining counts (uniform over the remaining trials)
+            size_t w = std::uniform_int_distribution<size_t>(0, weightsSum-1)(gen);
+            for(auto ii : eligibles){
+                if(w < remaining[ii]){
+                    id = ii;
+                    break;
+                }
+                w -= remaining[ii];
+            }
+
+            // the pick would make the end unsatisfiable: most remaining value first, then least recently used
+            if(!fits_after(id, total - pos - 1)){
+                for(auto ii : eligibles){
+                    if(remaining[ii] > remaining[id] || (remaining[ii] == remaining[id] && (lastPosition[ii] + 1) < (lastPosition[id] + 1))){
+                        id = ii;
+                    }
+                }
+            }
+
+        }else{
+
+            // dead end: least recently used value
+            ++violations;
+            size_t oldest = never;
+            for(size_t ii = 0; ii < nbValues; ++ii){
+                if(remaining[ii] == 0){
+                    continue;
+                }
+                const size_t last = lastPosition[ii] == never ? 0 : lastPosition[ii] + 1;
+                if(last < oldest){
+                    id     = ii;
+                    oldest = last;
+                }
+            }
+        }
+
+        run = (id == previous) ? run + 1 : 1;
+        previous = id;
+        lastPosition[id] = pos;
+        --remaining[id];
+        ids.push_back(static_cast<int>(id));
+    }
+
+    if(nbViolations != nullptr){
+        *nbViolations = violations;
+    }
+    return ids;
+}
+
+std::vector<int> Randomizer::generate_balanced_transitions_ids(size_t nbValues, size_t reps, bool noFollowingValue, std::mt19937 &gen){
+
+    std::vector<int> ids;
+    if(nbValues == 0 || reps == 0){
+        return ids;
+    }
+    ids.reserve(reps);
+
+    if(nbValues == 1){
+        ids.resize(reps, 0);
+        return ids;
+    }
+
+    // adjacency of the complete transitions graph
+    const size_t degree = noFollowingValue ? nbValues - 1 : nbValues;
+    std::vector<int> adjacency(nbValues * degree);
+    std::vector<size_t> cursors(nbValues);
+    std::vector<int> stack;
+    std::vector<int> circuit;
+    stack.reserve(adjacency.size() + 1);
+    circuit.reserve(adjacency.size() + 1);
+
+    const int start = std::uniform_int_distribution<int>(0, static_cast<int>(nbValues)-1)(gen);
+    ids.push_back(start);
+
+    while(ids.size() < reps){
+
+        for(size_t ii = 0; ii < nbValues; ++ii){
+            auto begin = adjacency.begin() + static_cast<std::ptrdiff_t>(ii * degree);
+            auto it = begin;
+            for(size_t jj = 0; jj < nbValues; ++jj){
+                if(!noFollowingValue || jj != ii){
+                    *it++ = static_cast<int>(jj);
+                }
+            }
+            std::shuffle(begin, begin + static_cast<std::ptrdiff_t>(degree), gen);
+            cursors[ii] = 0;
+        }
+
+        // Hierholzer, the circuit is closed on the start value
+        stack.clear();
+        circuit.clear();
+        stack.push_back(start);
+        while(!stack.empty()){
+            const size_t v = static_cast<size_t>(stack.back());
+            if(cursors[v] < degree){
+                stack.push_back(adjacency[v * degree + cursors[v]++]);
+            }else{
+                circuit.push_back(stack.back());
+                stack.pop_back();
+            }
+        }
+        std::reverse(circuit.begin(), circuit.end());
+
+        for(size_t ii = 1; ii < circuit.size() && ids.size() < reps; ++ii){
+            ids.push_back(circuit[ii]);
+        }
+    }
+
+    return ids;
+}
+
+std::vector<int> Randomizer::generate_williams_ids(size_t nbValues, size_t reps, size_t idInstance){
+
+    std::vector<int> ids;
+    if(nbValues == 0 || reps == 0){
+        return ids;
+    }
+    ids.reserve(reps);
+
+    // first row: 0, 1, n-1, 2, n-2, ...
+    std::vector<int> row(nbValues);
+    for(size_t ii = 0; ii < nbValues; ++ii){
+        row[ii] = static_cast<int>(ii == 0 ? 0 : (ii % 2 == 1 ? (ii + 1) / 2 : nbValues - ii / 2));
+    }
+
+    const size_t nbRows = nbValues % 2 == 0 ? nbValues : 2 * nbValues;
+    const size_t idRow  = idInstance % nbRows;
+    for(auto &v : row){
+        v = static_cast<int>((static_cast<size_t>(v) + idRow) % nbValues);
+    }
+    if(idRow >= nbValues){
+        std::reverse(row.begin(), row.end());
+    }
+
+    while(ids.size() < reps){
+        for(auto v : row){
+            if(ids.size() == reps){
+                break;
+            }
+            ids.push_back(v);
+        }
+    }
+    return ids;
+}
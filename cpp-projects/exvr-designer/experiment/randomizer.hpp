@@ -31,9 +31,15 @@
 
 namespace tool::ex {
 
+struct SequenceConstraints{
+    size_t maxRepeats  = 0; /**< maximum consecutive identical values, 0: no limit */
+    size_t minDistance = 0; /**< minimum positions between two identical values, 0: no limit */
+};
+
 class Randomizer{
 
     std::unique_ptr<std::mt19937> gen = nullptr;
+    unsigned int m_seed = 0;
 
 public :
 
@@ -44,6 +50,19 @@ public :
     std::vector<int> generate_random_ids(size_t nbValues, size_t reps, bool noFollowingValue)const;
     size_t randomize_start(size_t containerSize) const;
 
+    // generator only depending on the randomizer seed, the instance id and the element key
+    std::mt19937 instance_generator(size_t idInstance, int key) const;
+
+    // counts[id] values of each id, random placement weighted by the remaining counts, O(reps * nbValues)
+    // picks that would make the end of the sequence unsatisfiable are replaced by the most remaining id
+    // when no id is allowed at a position the least recently used one is placed and counted as a violation
+    static std::vector<int> generate_constrained_ids(const std::vector<size_t> &counts, SequenceConstraints constraints, std::mt19937 &gen, size_t *nbViolations = nullptr);
+    // first-order counterbalancing: chained random eulerian circuits of the complete transitions graph,
+    // every ordered pair (with self pairs if noFollowingValue is false) appears once per circuit, O(reps)
+    static std::vector<int> generate_balanced_transitions_ids(size_t nbValues, size_t reps, bool noFollowingValue, std::mt19937 &gen);
+    // row idInstance of a Williams balanced latin square (2*nbValues rows for odd sizes), repeated until reps
+    static std::vector<int> generate_williams_ids(size_t nbValues, size_t reps, size_t idInstance);
+
     template<typename T>
     std::vector<T> shuffle(const std::vector<T> &values, size_t reps, bool noFollowingValue) const{
 
@@ -0,0 +1,608 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "simulator.hpp"
+
+// std
+#include <chrono>
+#include <cmath>
+
+using namespace tool;
+using namespace tool::ex;
+
+using CT = Connector::Type;
+
+static std::int64_t elapsed_us(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::optional<double> to_real(const SimValue &value){
+    if(auto v = std::get_if<double>(&value)){
+        return *v;
+    }
+    if(auto v = std::get_if<int>(&value)){
+        return *v;
+    }
+    if(auto v = std::get_if<bool>(&value)){
+        return *v ? 1. : 0.;
+    }
+    return std::nullopt;
+}
+
+static std::optional<bool> to_bool(const SimValue &value){
+    if(auto v = std::get_if<bool>(&value)){
+        return *v;
+    }
+    if(auto v = to_real(value); v.has_value()){
+        return v.value() != 0.;
+    }
+    return std::nullopt;
+}
+
+static QString sim_value_to_string(const SimValue &value){
+    if(std::holds_alternative<std::monostate>(value)){
+        return QSL("void");
+    }
+    if(auto v = std::get_if<bool>(&value)){
+        return *v ? QSL("true") : QSL("false");
+    }
+    if(auto v = std::get_if<int>(&value)){
+        return QString::number(*v);
+    }
+    if(auto v = std::get_if<double>(&value)){
+        return QString::number(*v);
+    }
+    return std::get<QString>(value);
+}
+
+static bool is_unset(const SimValue &value){
+    return std::holds_alternative<std::monostate>(value);
+}
+
+Simulator::Simulator(SimulatorSettings settings) : m_settings(settings), m_gen(settings.seed){
+}
+
+Simulator::SimGraph Simulator::compile(const Condition *condition){
+
+    SimGraph g;
+    g.nodes.reserve(condition->connectors.size());
+
+    umap<int, size_t> nodesId;
+    for(const auto &connector : condition->connectors){
+
+        nodesId[connector->key()] = g.nodes.size();
+
+        SimNode node;
+        node.type = connector->type;
+        node.key  = connector->key();
+        node.arg  = connector->arg->value();
+        node.outputs.resize(Connector::get_io(node.type).outNb);
+
+        const size_t id = g.nodes.size();
+        switch(node.type){
+        case CT::Start_routine:
+            g.startNodes.push_back(id);
+            break;
+        case CT::Pre_update_routine:
+            g.preUpdateNodes.push_back(id);
+            break;
+        case CT::Update_routine:
+            g.updateNodes.push_back(id);
+            break;
+        case CT::Post_update_routine:
+            g.postUpdateNodes.push_back(id);
+            break;
+        case CT::Stop_routine:
+            g.stopNodes.push_back(id);
+            break;
+        case CT::Boolean:
+            node.state = node.arg == QSL("1") || node.arg.toLower() == QSL("true");
+            g.generatorsNodes.push_back(id);
+            break;
+        case CT::Integer:
+            node.state = node.arg.toInt();
+            g.generatorsNodes.push_back(id);
+            break;
+        case CT::Real:
+            node.state = node.arg.toDouble();
+            g.generatorsNodes.push_back(id);
+            break;
+        case CT::String:
+            node.state = node.arg;
+            g.generatorsNodes.push_back(id);
+            break;
+        case CT::Decimal_counter:
+            node.state = 0.;
+            break;
+        case CT::Conditional_gate:
+            node.state = node.arg == QSL("1") || node.arg.toLower() == QSL("true");
+            break;
+        case CT::Time: case CT::Random_real: case CT::Delay: case CT::Binary_operation: case CT::Decimal_operation:
+        case CT::Pass_values: case CT::Pass_value_trigger: case CT::Conditional_trigger: case CT::Logger:
+        case CT::Next: case CT::Previous: case CT::Stop: case CT::Pause:
+        case CT::Next_with_name: case CT::Next_with_cond: case CT::Previous_with_name: case CT::Previous_with_cond:
+            break;
+        default:
+            node.simulated = false;
+            break;
+        }
+
+        g.nodes.push_back(std::move(node));
+    }
+
+    // components are not simulated, connections from or to them are ignored
+    for(const auto &connection : condition->connections){
+        if(connection->startType != Connection::Type::Connector || connection->endType != Connection::Type::Connector){
+            continue;
+        }
+        if(!nodesId.contains(connection->startKey) || !nodesId.contains(connection->endKey)){
+            continue;
+        }
+
+        auto &outputs = g.nodes[nodesId[connection->startKey]].outputs;
+        const auto startIndex = to_size_t(connection->startIndex);
+        if(startIndex < outputs.size()){
+            outputs[startIndex].push_back({nodesId[connection->endKey], to_size_t(connection->endIndex)});
+        }
+    }
+
+    return g;
+}
+
+Simulator::SimGraph &Simulator::graph(const Condition *condition){
+    if(auto it = m_graphs.find(condition); it != m_graphs.end()){
+        return it->second;
+    }
+    return m_graphs[condition] = compile(condition);
+}
+
+void Simulator::emit_value(SimGraph &g, size_t node, size_t port, const SimValue &value){
+    for(const auto &link : g.nodes[node].outputs[port]){
+        m_events.push_back({link.node, link.port, value});
+    }
+}
+
+void Simulator::receive(SimGraph &g, const SimEvent &event){
+
+    auto &node = g.nodes[event.node];
+    if(!node.simulated){
+        m_report->unsimulatedConnectors[node.type]++;
+        return;
+    }
+    if(event.port < node.inputs.size()){
+        node.inputs[event.port] = event.value;
+    }
+
+    auto request_flow = [&](SimEndReason reason){
+        if(!m_flowRequest.has_value()){
+            m_flowRequest    = reason;
+            m_flowRequestArg = node.arg;
+        }
+    };
+
+    switch(node.type){
+    case CT::Boolean: case CT::Integer: case CT::Real: case CT::String:
+        if(event.port == 0){
+            node.state = event.value;
+        }
+        emit_value(g, event.node, 0, node.state);
+        break;
+    case CT::Time:
+        emit_value(g, event.node, 0, m_elementTime * 1000.);
+        break;
+    case CT::Random_real:
+        if(event.port == 2){
+            const double min = to_real(node.inputs[0]).value_or(0.);
+            const double max = to_real(node.inputs[1]).value_or(1.);
+            emit_value(g, event.node, 0, std::uniform_real_distribution<double>(std::min(min,max), std::max(min,max))(m_gen));
+        }
+        break;
+    case CT::Decimal_counter:{
+        double count = std::get<double>(node.state);
+        if(event.port == 0){
+            count += to_real(event.value).value_or(0.);
+        }else if(event.port == 1){
+            count -= to_real(event.value).value_or(0.);
+        }else{
+            count = 0.;
+        }
+        node.state = count;
+        emit_value(g, event.node, 0, count);
+        break;
+    }case CT::Delay:
+        m_delayed.push_back({m_elementTime + node.arg.toDouble()*0.001, {event.node, 0, event.value}});
+        break;
+    case CT::Binary_operation:{
+        auto a = to_bool(node.inputs[0]);
+        auto b = to_bool(node.inputs[1]);
+        if(node.arg == QSL("NOT")){
+            if(a.has_value()){
+                emit_value(g, event.node, 0, !a.value());
+            }
+        }else if(a.has_value() && b.has_value()){
+            if(node.arg == QSL("OR")){
+                emit_value(g, event.node, 0, a.value() || b.value());
+            }else if(node.arg == QSL("XOR")){
+                emit_value(g, event.node, 0, a.value() != b.value());
+            }else{
+                emit_value(g, event.node, 0, a.value() && b.value());
+            }
+        }
+        break;
+    }case CT::Decimal_operation:{
+        auto a = to_real(node.inputs[0]);
+        auto b = to_real(node.inputs[1]);
+        if(!a.has_value() || !b.has_value()){
+            break;
+        }
+        const auto op = node.arg.trimmed();
+        const double l = a.value(), r = b.value();
+        if(op == QSL("Substract")){
+            emit_value(g, event.node, 0, l - r);
+        }else if(op == QSL("Multiply")){
+            emit_value(g, event.node, 0, l * r);
+        }else if(op == QSL("Divide")){
+            if(r != 0.){
+                emit_value(g, event.node, 0, l / r);
+            }
+        }else if(op == QSL("Modulo")){
+            if(r != 0.){
+                emit_value(g, event.node, 0, std::fmod(l, r));
+            }
+        }else if(op == QSL("Inferior?")){
+            emit_value(g, event.node, 0, l < r);
+        }else if(op == QSL("Inferior or equal?")){
+            emit_value(g, event.node, 0, l <= r);
+        }else if(op == QSL("Superior?")){
+            emit_value(g, event.node, 0, l > r);
+        }else if(op == QSL("Superior or equal?")){
+            emit_value(g, event.node, 0, l >= r);
+        }else if(op == QSL("Equal?")){
+            emit_value(g, event.node, 0, l == r);
+        }else if(op == QSL("Not equal?")){
+            emit_value(g, event.node, 0, l != r);
+        }else{
+            emit_value(g, event.node, 0, l + r);
+        }
+        break;
+    }case CT::Pass_values:
+        emit_value(g, event.node, 0, event.value);
+        break;
+    case CT::Pass_value_trigger:
+        if(event.port == 1 && !is_unset(node.inputs[0])){
+            emit_value(g, event.node, 0, node.inputs[0]);
+        }
+        break;
+    case CT::Conditional_trigger:
+        if(to_bool(event.value).value_or(false)){
+            emit_value(g, event.node, 0, std::monostate{});
+        }
+        break;
+    case CT::Conditional_gate:
+        if(event.port == 1){
+            node.state = to_bool(event.value).value_or(false);
+        }else if(std::get<bool>(node.state)){
+            emit_value(g, event.node, 0, event.value);
+        }
+        break;
+    case CT::Logger:
+        m_report->logs.push_back(QString::number(m_time, 'f', 3) % QSL(" ") % sim_value_to_string(event.value));
+        break;
+    case CT::Next:
+        request_flow(SimEndReason::Next);
+        break;
+    case CT::Previous:
+        request_flow(SimEndReason::Previous);
+        break;
+    case CT::Next_with_name:
+        request_flow(SimEndReason::NextWithName);
+        break;
+    case CT::Next_with_cond:
+        request_flow(SimEndReason::NextWithCond);
+        break;
+    case CT::Previous_with_name:
+        request_flow(SimEndReason::PreviousWithName);
+        break;
+    case CT::Previous_with_cond:
+        request_flow(SimEndReason::PreviousWithCond);
+        break;
+    case CT::Stop:
+        request_flow(SimEndReason::Stop);
+        break;
+    case CT::Pause:
+        m_report->warnings.push_back(QSL("Pause ignored at ") % QString::number(m_time, 'f', 3) % QSL("s"));
+        break;
+    default:
+        break;
+    }
+}
+
+void Simulator::process_events(SimGraph &g){
+
+    while(!m_events.empty()){
+        if(m_frameEvents >= m_settings.maxEventsPerFrame){
+            m_report->warnings.push_back(QSL("Connectors events limit reached at ") % QString::number(m_time, 'f', 3) % QSL("s, possible cycle."));
+            m_events.clear();
+            return;
+        }
+        auto event = std::move(m_events.front());
+        m_events.pop_front();
+        receive(g, event);
+        ++m_frameEvents;
+    }
+}
+
+void Simulator::update_activations(const Condition *condition, size_t flowId, std::vector<std::pair<bool,bool>> &states, bool end){
+
+    for(size_t ii = 0; ii < condition->actions.size(); ++ii){
+
+        const auto action = condition->actions[ii].get();
+        const SecondsTS t{m_elementTime};
+
+        auto inside = [&](const Timeline *timeline){
+            if(end || timeline == nullptr){
+                return false;
+            }
+            for(const auto &interval : timeline->intervals){
+                if(interval.inside(t)){
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        const bool update  = inside(&action->timelineUpdate.get());
+        const bool visible = inside(&action->timelineVisibility.get());
+
+        if(update != states[ii].first){
+            states[ii].first = update;
+            m_report->activations.push_back({m_time, flowId, action->component->key(), action->key(), Timeline::Update, update});
+        }
+        if(visible != states[ii].second){
+            states[ii].second = visible;
+            m_report->activations.push_back({m_time, flowId, action->component->key(), action->key(), Timeline::Visibility, visible});
+        }
+    }
+}
+
+void Simulator::simulate_routine(const InstanceElement &element, const Condition *condition, SimElementReport &elementR){
+
+    auto &g = graph(condition);
+
+    // reset connectors inputs between routines
+    for(auto &node : g.nodes){
+        node.inputs.fill(SimValue{});
+        if(node.type == CT::Decimal_counter){
+            node.state = 0.;
+        }
+    }
+    m_events.clear();
+    m_delayed.clear();
+
+    std::vector<std::pair<bool,bool>> states(condition->actions.size(), {false,false});
+
+    const double duration = condition->duration.v;
+    const double dt       = m_settings.frameDuration;
+    const double startTime = m_time;
+
+    // start routine
+    m_frameEvents = 0;
+    for(auto id : g.startNodes){
+        emit_value(g, id, 0, element.elem->name());
+        emit_value(g, id, 1, elementR.condition);
+        emit_value(g, id, 2, element.elementIteration);
+        emit_value(g, id, 3, element.conditionIteration);
+        emit_value(g, id, 4, m_time * 1000.);
+    }
+    for(auto id : g.generatorsNodes){
+        emit_value(g, id, 0, g.nodes[id].state);
+    }
+    process_events(g);
+    elementR.events += m_frameEvents;
+
+    while(m_elementTime < duration && !m_flowRequest.has_value()){
+
+        m_frameEvents = 0;
+
+        if(m_settings.recordActivations){
+            update_activations(condition, elementR.flowId, states, false);
+        }
+
+        // delayed values
+        for(size_t ii = 0; ii < m_delayed.size();){
+            if(m_delayed[ii].time <= m_elementTime){
+                m_events.push_back(std::move(m_delayed[ii].event));
+                m_delayed[ii] = std::move(m_delayed.back());
+                m_delayed.pop_back();
+            }else{
+                ++ii;
+            }
+        }
+
+        for(auto id : g.preUpdateNodes){
+            emit_value(g, id, 0, m_elementTime * 1000.);
+        }
+        for(auto id : g.updateNodes){
+            emit_value(g, id, 0, m_elementTime * 1000.);
+            emit_value(g, id, 1, m_time * 1000.);
+        }
+        for(auto id : g.postUpdateNodes){
+            emit_value(g, id, 0, m_elementTime * 1000.);
+        }
+        process_events(g);
+
+        elementR.events += m_frameEvents;
+        ++elementR.frames;
+
+        m_elementTime += dt;
+        m_time        += dt;
+    }
+
+    // stop routine
+    m_frameEvents = 0;
+    for(auto id : g.stopNodes){
+        emit_value(g, id, 0, element.elem->name());
+        emit_value(g, id, 1, elementR.condition);
+    }
+    auto request = m_flowRequest;
+    process_events(g);
+    m_flowRequest = request;
+    elementR.events += m_frameEvents;
+
+    if(m_settings.recordActivations){
+        update_activations(condition, elementR.flowId, states, true);
+    }
+
+    elementR.duration = m_time - startTime;
+}
+
+SimReport Simulator::run(const Instance &instance){
+
+    SimReport report;
+    m_report = &report;
+    m_time   = 0.;
+    m_gen.seed(m_settings.seed + static_cast<unsigned int>(instance.idInstance));
+
+    const auto startRun = std::chrono::steady_clock::now();
+    const size_t maxVisited = m_settings.maxVisitedElements != 0 ? m_settings.maxVisitedElements : 4 * instance.flow.size();
+    report.elements.reserve(instance.flow.size());
+
+    auto find_element = [&](size_t from, bool forward, auto predicate) -> std::optional<size_t>{
+        if(forward){
+            for(size_t ii = from + 1; ii < instance.flow.size(); ++ii){
+                if(predicate(instance.flow[ii])){
+                    return ii;
+                }
+            }
+        }else{
+            for(size_t ii = from; ii-- > 0;){
+                if(predicate(instance.flow[ii])){
+                    return ii;
+                }
+            }
+        }
+        return std::nullopt;
+    };
+
+    size_t flowId = 0;
+    while(flowId < instance.flow.size()){
+
+        if(report.elements.size() >= maxVisited){
+            report.warnings.push_back(QSL("Maximum number of visited elements reached, possible previous/next cycle."));
+            break;
+        }
+
+        const auto &element = instance.flow[flowId];
+        const auto startElement = std::chrono::steady_clock::now();
+
+        SimElementReport elementR;
+        elementR.flowId             = flowId;
+        elementR.type               = element.elem->type();
+        elementR.key                = element.elem->key();
+        elementR.name               = element.elem->name();
+        elementR.condition          = instance.condition(element);
+        elementR.elementIteration   = element.elementIteration;
+        elementR.conditionIteration = element.conditionIteration;
+        elementR.startTime          = m_time;
+
+        m_elementTime = 0.;
+        m_flowRequest = std::nullopt;
+
+        if(element.elem->type() == FlowElement::Type::Routine){
+
+            auto routine = dynamic_cast<Routine*>(element.elem);
+            const Condition *condition = nullptr;
+            for(const auto &c : routine->conditions){
+                if(c->name == elementR.condition){
+                    condition = c.get();
+                    break;
+                }
+            }
+
+            if(condition != nullptr){
+                simulate_routine(element, condition, elementR);
+            }else{
+                report.warnings.push_back(QSL("Condition ") % elementR.condition % QSL(" not found in routine ") % routine->name());
+            }
+
+        }else if(element.elem->type() == FlowElement::Type::Isi){
+            const double duration = elementR.condition.toDouble();
+            elementR.frames   = static_cast<size_t>(std::ceil(duration / m_settings.frameDuration));
+            elementR.duration = duration;
+            m_time += duration;
+        }
+
+        const SimEndReason endReason = m_flowRequest.value_or(SimEndReason::Duration);
+        elementR.endReason  = endReason;
+        elementR.wallTimeUs = elapsed_us(startElement);
+        report.frames += elementR.frames;
+        report.events += elementR.events;
+        report.elements.push_back(std::move(elementR));
+
+        // next element
+        std::optional<size_t> nextId = flowId + 1;
+        switch(endReason){
+        case SimEndReason::Duration: case SimEndReason::Next:
+            break;
+        case SimEndReason::Previous:
+            nextId = flowId > 0 ? flowId - 1 : 0;
+            break;
+        case SimEndReason::NextWithName:
+            nextId = find_element(flowId, true, [&](const InstanceElement &e){return e.elem->name() == m_flowRequestArg;});
+            break;
+        case SimEndReason::NextWithCond:
+            nextId = find_element(flowId, true, [&](const InstanceElement &e){return instance.condition(e) == m_flowRequestArg;});
+            break;
+        case SimEndReason::PreviousWithName:
+            nextId = find_element(flowId, false, [&](const InstanceElement &e){return e.elem->name() == m_flowRequestArg;});
+            break;
+        case SimEndReason::PreviousWithCond:
+            nextId = find_element(flowId, false, [&](const InstanceElement &e){return instance.condition(e) == m_flowRequestArg;});
+            break;
+        case SimEndReason::Stop:
+            report.stopped = true;
+            nextId = std::nullopt;
+            break;
+        }
+
+        if(!nextId.has_value()){
+            if(!report.stopped){
+                const bool next = endReason == SimEndReason::NextWithName || endReason == SimEndReason::NextWithCond;
+                const bool byName = endReason == SimEndReason::NextWithName || endReason == SimEndReason::PreviousWithName;
+                report.warnings.push_back(
+                    (next ? QSL("Next ") : QSL("Previous ")) % (byName ? QSL("element ") : QSL("condition ")) %
+                    QSL("[") % m_flowRequestArg % QSL("] requested at ") % QString::number(m_time, 'f', 3) %
+                    QSL("s not found in the instance flow, simulation stopped.")
+                );
+            }
+            break;
+        }
+        flowId = nextId.value();
+    }
+
+    report.totalDuration = m_time;
+    report.wallTimeUs    = elapsed_us(startRun);
+    m_report = nullptr;
+
+    return report;
+}
@@ -0,0 +1,164 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <deque>
+#include <map>
+#include <random>
+#include <variant>
+
+// local
+#include "instance.hpp"
+
+namespace tool::ex {
+
+using SimValue = std::variant<std::monostate, bool, int, double, QString>; /**< monostate is a void (trigger) value */
+
+struct SimulatorSettings{
+    double frameDuration = 1./90.;          /**< virtual clock step in seconds */
+    size_t maxEventsPerFrame = 10000;       /**< connectors events limit, protects from graph cycles */
+    size_t maxVisitedElements = 0;          /**< 0: 4 times the instance flow size, protects from previous/next cycles */
+    unsigned int seed = 0;                  /**< added to the instance id for random connectors */
+    bool recordActivations = true;
+};
+
+enum class SimEndReason : int{
+    Duration = 0, Next, Previous, NextWithName, NextWithCond, PreviousWithName, PreviousWithCond, Stop
+};
+
+struct SimElementReport{
+    size_t flowId = 0;                      /**< position in the instance flow */
+    FlowElement::Type type;
+    int key = -1;
+    QString name;
+    QString condition;
+    int elementIteration = 0;
+    int conditionIteration = 0;
+    double startTime = 0.;                  /**< virtual time (s) */
+    double duration = 0.;                   /**< virtual time (s) */
+    size_t frames = 0;
+    size_t events = 0;                      /**< connectors events processed */
+    std::int64_t wallTimeUs = 0;
+    SimEndReason endReason = SimEndReason::Duration;
+};
+
+struct SimActivation{
+    double time = 0.;
+    size_t flowId = 0;
+    int componentKey = -1;
+    int actionKey = -1;
+    Timeline::Type timeline;
+    bool enabled = false;
+};
+
+struct SimReport{
+    std::vector<SimElementReport> elements; /**< activation order */
+    std::vector<SimActivation> activations;
+    std::vector<QString> logs;              /**< values received by logger connectors */
+    std::vector<QString> warnings;
+    std::map<Connector::Type, size_t> unsimulatedConnectors;
+    size_t frames = 0;
+    size_t events = 0;
+    double totalDuration = 0.;
+    std::int64_t wallTimeUs = 0;
+    bool stopped = false;
+};
+
+// headless stepping of an instance flow on a virtual clock, connectors graphs are evaluated
+// with the subset of Connector::Type semantics that doesn't need the runtime (inputs devices, components, resources)
+// times sent by the flow connectors are in milliseconds, as in the runtime
+// compiled graphs are cached by condition, the experiment must outlive the simulator
+class Simulator{
+
+public:
+
+    Simulator(SimulatorSettings settings = {});
+
+    SimReport run(const Instance &instance);
+
+private:
+
+    struct SimLink{
+        size_t node;
+        size_t port;
+    };
+
+    struct SimNode{
+        Connector::Type type;
+        int key = -1;
+        QString arg;
+        std::array<SimValue, Connector::maxInputConnection> inputs;
+        std::vector<std::vector<SimLink>> outputs;
+        SimValue state;
+        bool simulated = true;
+    };
+
+    struct SimGraph{
+        std::vector<SimNode> nodes;
+        std::vector<size_t> startNodes;
+        std::vector<size_t> preUpdateNodes;
+        std::vector<size_t> updateNodes;
+        std::vector<size_t> postUpdateNodes;
+        std::vector<size_t> stopNodes;
+        std::vector<size_t> generatorsNodes;
+    };
+
+    struct SimEvent{
+        size_t node;
+        size_t port;
+        SimValue value;
+    };
+
+    struct SimDelayed{
+        double time;
+        SimEvent event;
+    };
+
+    SimGraph &graph(const Condition *condition);
+    SimGraph compile(const Condition *condition);
+
+    void emit_value(SimGraph &g, size_t node, size_t port, const SimValue &value);
+    void receive(SimGraph &g, const SimEvent &event);
+    void process_events(SimGraph &g);
+
+    void simulate_routine(const InstanceElement &element, const Condition *condition, SimElementReport &elementR);
+    void update_activations(const Condition *condition, size_t flowId, std::vector<std::pair<bool,bool>> &states, bool end);
+
+    SimulatorSettings m_settings;
+    std::mt19937 m_gen;
+
+    umap<const Condition*, SimGraph> m_graphs;
+    std::deque<SimEvent> m_events;
+    std::vector<SimDelayed> m_delayed;
+
+    // current run
+    SimReport *m_report = nullptr;
+    double m_time = 0.;
+    double m_elementTime = 0.;
+    size_t m_frameEvents = 0;
+    std::optional<SimEndReason> m_flowRequest;
+    QString m_flowRequestArg;
+};
+}
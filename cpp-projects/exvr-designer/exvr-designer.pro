@@ -72,6 +72,7 @@ INCLUDEPATH += \
     $$QT_UTILITY_INCLUDES \
     # local
     $$EXVR_DESIGNER_MOC \
+    $$EXVR_EXPORT_INCLUDES \
     # third-party
     $$QWT_INCLUDES \
     $$NODES_INCLUDES \
@@ -110,8 +111,11 @@ HEADERS += \
     gui/widgets/components/config_parameters/video_resource_pw.hpp \
     utility/script_utility.hpp \
     utility/path_utility.hpp \
+    utility/profiling_trace.hpp \
     # IO
     IO/xml_io_manager.hpp \
+    IO/binary_experiment_file.hpp \
+    IO/experiment_stream.hpp \
     # launcher
     launcher/exp_launcher.hpp \
     launcher/exp_launcher_communication.hpp \
@@ -140,10 +144,14 @@ HEADERS += \
     # resources
     resources/resource.hpp \
     resources/resources_manager.hpp \
+    resources/resources_exporter.hpp \
+    resources/resources_indexer.hpp \
     # experiment
+    experiment/change_journal.hpp \
     experiment/experiment.hpp \
     experiment/randomizer.hpp \
     experiment/instance.hpp \
+    experiment/simulator.hpp \
     experiment/global_signals.hpp \
     # gui
     ## settings
@@ -151,6 +159,7 @@ HEADERS += \
     ## objects
     gui/objects/flow_element_object.hpp \
     gui/objects/flow_sequence_object.hpp \
+    gui/objects/flow_spatial_index.hpp \
     gui/objects/isi_flow_element_object.hpp \
     gui/objects/loop_flow_element_object.hpp \
     gui/objects/movable_flow_element_object.hpp \
@@ -262,6 +271,7 @@ HEADERS += \
     ### connections
     gui/widgets/connections/ex_flow_view_widget.hpp \
     gui/widgets/connections/connections_widget.hpp \
+    gui/widgets/connections/connections_graph_plan.hpp \
     gui/widgets/connections/data_models/base_node_data_model.hpp \
     gui/widgets/connections/data_models/connectors/from_time_any_ndm.hpp \
     gui/widgets/connections/data_models/connectors/vector2_ndm.hpp \
@@ -309,12 +319,16 @@ HEADERS += \
     gui/widgets/connections/data_models/connectors/basic_ndm.hpp \
     gui/widgets/connections/data_models/connectors/time_ndm.hpp \
     gui/widgets/connections/data_models/connectors/flow_routine_ndm.hpp \
+    # exvr-export
+    ../exvr-export/ex_resources/csv_columns_file.hpp \
 
 SOURCES += \
     # main
     designer_main.cpp \
     # IO
     IO/xml_io_manager.cpp \
+    IO/binary_experiment_file.cpp \
+    IO/experiment_stream.cpp \
     # data
     data/connector.cpp \
     data/timeline.cpp \
@@ -330,6 +344,7 @@ SOURCES += \
     data/flow_elements/isi.cpp \
     # experiment
     experiment/instance.cpp \
+    experiment/simulator.cpp \
     experiment/global_signals.cpp \
     experiment/experiment.cpp \
     experiment/randomizer.cpp \
@@ -354,14 +369,18 @@ SOURCES += \
     # utility
     utility/path_utility.cpp \
     utility/script_utility.cpp \
+    utility/profiling_trace.cpp \
     # resources
     resources/resources_manager.cpp \
+    resources/resources_exporter.cpp \
+    resources/resources_indexer.cpp \
     # gui
     ## settings
     gui/settings/display.cpp \
     ## objects
     gui/objects/flow_element_object.cpp \
     gui/objects/flow_sequence_object.cpp \
+    gui/objects/flow_spatial_index.cpp \
     gui/objects/isi_flow_element_object.cpp \
     gui/objects/loop_flow_element_object.cpp \
     gui/objects/movable_flow_element_object.cpp \
@@ -450,6 +469,7 @@ SOURCES += \
     ### connections
     gui/widgets/connections/data_models/connectors/resources_ndm.cpp \
     gui/widgets/connections/connections_widget.cpp \
+    gui/widgets/connections/connections_graph_plan.cpp \
     gui/widgets/connections/ex_flow_view_widget.cpp \
     gui/widgets/connections/data_models/all_node_data_models.cpp \
     gui/widgets/connections/data_models/base_embedded_widget.cpp \
@@ -494,6 +514,8 @@ SOURCES += \
     gui/widgets/connections/data_models/connectors/basic_ndm.cpp \
     gui/widgets/connections/data_models/connectors/time_ndm.cpp \
     gui/widgets/connections/data_models/connectors/flow_routine_ndm.cpp \
+    # exvr-export
+    ../exvr-export/ex_resources/csv_columns_file.cpp \
 
 FORMS += \
     # elements
@@ -24,18 +24,56 @@
 
 #include "benchmark_dialog.hpp"
 
+// std
+#include <fstream>
+
 // Qt
 #include <QDoubleSpinBox>
+#include <QFileDialog>
+#include <QHeaderView>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
 
 // base
 #include "utility/benchmark.hpp"
 
 // qt-utility
 #include "qt_ui.hpp"
+#include "qt_logger.hpp"
+
+// local
+#include "utility/profiling_trace.hpp"
+#include "launcher/exp_launcher.hpp"
+#include "utility/path_utility.hpp"
+#include "gui/widgets/components/components_manager_widget.hpp"
 
 using namespace tool;
 using namespace tool::ex;
 
+namespace {
+
+// resident memory of the designer process
+std::int64_t process_memory_kb(){
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))){
+        return static_cast<std::int64_t>(counters.WorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    std::int64_t totalPages = 0, residentPages = 0;
+    std::ifstream statm("/proc/self/statm");
+    if(statm >> totalPages >> residentPages){
+        return residentPages * static_cast<std::int64_t>(sysconf(_SC_PAGESIZE)) / 1024;
+    }
+    return 0;
+#endif
+}
+}
 
 BenchmarkDialog::BenchmarkDialog(){
 
@@ -55,20 +93,198 @@ BenchmarkDialog::BenchmarkDialog(){
     auto unit = new QComboBox();
     auto minT = new QDoubleSpinBox();
     pbClear = new QPushButton("Clear");
-    layout()->addWidget(ui::F::gen(ui::L::HB(), {cbSort, ui::W::txt("Unit:"), unit, ui::W::txt("Min T:"), minT, pbClear}, LStretch{true}, LMargins{true}, QFrame::NoFrame));
-    layout()->addWidget(view);
+    pbRecord = new QPushButton("Record session");
+    pbRecord->setCheckable(true);
+    pbExport = new QPushButton("Export trace");
+    layout()->addWidget(ui::F::gen(ui::L::HB(), {cbSort, ui::W::txt("Unit:"), unit, ui::W::txt("Min T:"), minT, pbClear, pbRecord, pbExport}, LStretch{true}, LMargins{true}, QFrame::NoFrame));
+
+    laIpc = new QLabel("IPC receive: -");
+    layout()->addWidget(laIpc);
+    ipcTimer.start();
+
+    laDialogs = new QLabel("Components dialogs: -");
+    cbLazyDialogs = new QCheckBox("Lazy dialogs (applied at next experiment loading)");
+    cbLazyDialogs->setChecked(ComponentsManagerW::lazyDialogs);
+    layout()->addWidget(ui::F::gen(ui::L::HB(), {laDialogs, cbLazyDialogs}, LStretch{true}, LMargins{true}, QFrame::NoFrame));
+    dialogsTimer.start();
+    connect(cbLazyDialogs, &QCheckBox::toggled, this, [](bool checked){
+        ComponentsManagerW::lazyDialogs = checked;
+    });
+    laOpening = new QLabel("Experiment opening: load an experiment with lazy dialogs enabled then disabled to compare");
+    layout()->addWidget(laOpening);
+
+    // histograms
+    histogramsW = new QTableWidget();
+    histogramsW->setColumnCount(7);
+    histogramsW->setHorizontalHeaderLabels({"Scope", "Count", "Min (us)", "Mean (us)", "P50 (us)", "P95 (us)", "Max (us)"});
+    histogramsW->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    histogramsW->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    histogramsW->setSortingEnabled(true);
+
+    tabs = new QTabWidget();
+    tabs->addTab(view, "Last frame");
+    tabs->addTab(histogramsW, "Trace histograms");
+    layout()->addWidget(tabs);
 
     connect(pbClear, &QPushButton::clicked, this, [=]{
         qDebug() << "clear";
         Bench::clear();
+        Trace::clear();
         model->elements.clear();
         model->elementsRow.clear();
+        histogramsW->setRowCount(0);
+    });
+    connect(pbRecord, &QPushButton::toggled, this, [=](bool checked){
+        if(checked){
+            Trace::start_recording();
+            pbRecord->setText("Stop recording");
+        }else{
+            Trace::stop_recording();
+            pbRecord->setText("Record session");
+            export_trace();
+        }
     });
+    connect(pbExport, &QPushButton::clicked, this, &BenchmarkDialog::export_trace);
 }
 
 void BenchmarkDialog::update(){
-    model->update(cbSort->isChecked());
-    view->viewport()->update();
+
+    if(!isVisible()){
+        return;
+    }
+
+    if(tabs->currentIndex() == 0){
+        model->update(cbSort->isChecked());
+        view->viewport()->update();
+    }else{
+        update_histograms();
+    }
+
+    if(Trace::is_recording()){
+        if(const auto dropped = Trace::dropped_events_count(); dropped > 0){
+            pbRecord->setText(QString("Stop recording (%1 events, %2 dropped)").arg(Trace::recorded_events_count()).arg(dropped));
+        }else{
+            pbRecord->setText(QString("Stop recording (%1 events)").arg(Trace::recorded_events_count()));
+        }
+    }
+}
+
+void BenchmarkDialog::update_ipc_counters(const ExpLauncherReceiveCounters &counters){
+
+    const auto elapsedMs = ipcTimer.elapsed();
+    if(elapsedMs < 1000){
+        return;
+    }
+    ipcTimer.restart();
+
+    const std::uint64_t bytes       = counters.bytes;
+    const std::uint64_t messages    = counters.messages;
+    const std::uint64_t parseTimeUs = counters.parseTimeUs;
+
+    const double seconds = 0.001 * static_cast<double>(elapsedMs);
+    const auto nbMessages = messages - previousMessages;
+    laIpc->setText(QString("IPC receive: %1 messages/s, %2 KB/s, parse mean %3 us, parse max %4 us").arg(
+        QString::number(static_cast<double>(nbMessages) / seconds, 'f', 1),
+        QString::number(static_cast<double>(bytes - previousBytes) / (1024.0 * seconds), 'f', 1),
+        QString::number(nbMessages > 0 ? (parseTimeUs - previousParseTimeUs) / nbMessages : 0),
+        QString::number(counters.maxParseTimeUs.load())
+    ));
+
+    previousBytes       = bytes;
+    previousMessages    = messages;
+    previousParseTimeUs = parseTimeUs;
+}
+
+void BenchmarkDialog::update_components_dialogs(const ComponentsManagerW *componentsW){
+
+    if(!isVisible() || dialogsTimer.elapsed() < 1000){
+        return;
+    }
+    dialogsTimer.restart();
+
+    laDialogs->setText(QString("Components dialogs: %1 alive, %2 widgets").arg(
+        QString::number(componentsW->dialogs_count()),
+        QString::number(componentsW->dialogs_widgets_count())
+    ));
+}
+
+void BenchmarkDialog::start_experiment_opening(){
+    openingLazy = ComponentsManagerW::lazyDialogs;
+    openingMemoryKB = process_memory_kb();
+    openingTimer.start();
+}
+
+void BenchmarkDialog::end_experiment_opening(const ComponentsManagerW *componentsW){
+
+    if(!openingTimer.isValid()){
+        return;
+    }
+
+    auto &opening = openingLazy ? lazyOpening : eagerOpening;
+    opening.valid       = true;
+    opening.timeMs      = openingTimer.nsecsElapsed()*0.000001;
+    opening.memoryKB    = process_memory_kb() - openingMemoryKB;
+    opening.dialogs     = componentsW->dialogs_count();
+    openingTimer.invalidate();
+
+    auto to_text = [](const ExperimentOpening &o){
+        if(!o.valid){
+            return QString("-");
+        }
+        return QString("%1 ms, %2 MB, %3 dialogs").arg(
+            QString::number(o.timeMs, 'f', 1),
+            QString::number(o.memoryKB/1024.0, 'f', 1),
+            QString::number(o.dialogs)
+        );
+    };
+    laOpening->setText(QString("Experiment opening (load + UI reset), lazy dialogs: %1 | eager dialogs: %2").arg(
+        to_text(lazyOpening), to_text(eagerOpening)
+    ));
+}
+
+void BenchmarkDialog::update_histograms(){
+
+    auto histograms = Trace::histograms();
+
+    histogramsW->setSortingEnabled(false);
+    histogramsW->setRowCount(static_cast<int>(histograms.size()));
+    for(size_t ii = 0; ii < histograms.size(); ++ii){
+
+        const auto &h = histograms[ii].second;
+        const std::array<QString, 7> values = {
+            from_view(histograms[ii].first),
+            QString::number(h.count),
+            QString::number(h.minUs),
+            QString::number(h.mean()),
+            QString::number(h.percentile(0.5)),
+            QString::number(h.percentile(0.95)),
+            QString::number(h.maxUs)
+        };
+
+        const int row = static_cast<int>(ii);
+        for(int jj = 0; jj < static_cast<int>(values.size()); ++jj){
+            if(auto item = histogramsW->item(row, jj); item != nullptr){
+                item->setText(values[jj]);
+            }else{
+                histogramsW->setItem(row, jj, new QTableWidgetItem(values[jj]));
+            }
+        }
+    }
+    histogramsW->setSortingEnabled(true);
+}
+
+void BenchmarkDialog::export_trace(){
+
+    QString path = QFileDialog::getSaveFileName(nullptr, "Export chrome trace file", Paths::logsDir % QSL("/designer_trace.json"), "JSON (*.json)");
+    if(path.length() == 0){
+        return;
+    }
+
+    if(!Trace::export_chrome_trace(path)){
+        QtLogger::error(QSL("[BENCHMARK] Cannot export trace to file ") % path);
+    }else{
+        QtLogger::message(QSL("[BENCHMARK] Trace exported to file ") % path);
+    }
 }
 
 void BenchmarkDialog::show_dialog(){
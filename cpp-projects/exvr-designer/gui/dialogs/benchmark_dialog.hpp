@@ -31,9 +31,14 @@
 #include <QDialog>
 #include <QTableWidget>
 #include <QAbstractTableModel>
+#include <QTabWidget>
+#include <QElapsedTimer>
+#include <QLabel>
 
 namespace tool::ex {
 
+class ComponentsManagerW;
+struct ExpLauncherReceiveCounters;
 
 class Table : public QAbstractTableModel{
 
@@ -59,14 +64,51 @@ public :
 public slots:
 
     void update();
+    void update_ipc_counters(const ExpLauncherReceiveCounters &counters);
+    void update_components_dialogs(const ComponentsManagerW *componentsW);
+    void start_experiment_opening();
+    void end_experiment_opening(const ComponentsManagerW *componentsW);
     void show_dialog();
 
 private:
 
+    void update_histograms();
+    void export_trace();
+
+    QTabWidget *tabs = nullptr;
     QTableView *view = nullptr;
     Table *model = nullptr;
+    QTableWidget *histogramsW = nullptr;
 
     QCheckBox *cbSort = nullptr;
     QPushButton *pbClear = nullptr;
+    QPushButton *pbRecord = nullptr;
+    QPushButton *pbExport = nullptr;
+
+    // ipc
+    QLabel *laIpc = nullptr;
+    QElapsedTimer ipcTimer;
+    std::uint64_t previousBytes = 0;
+    std::uint64_t previousMessages = 0;
+    std::uint64_t previousParseTimeUs = 0;
+
+    // components dialogs
+    QLabel *laDialogs = nullptr;
+    QCheckBox *cbLazyDialogs = nullptr;
+    QElapsedTimer dialogsTimer;
+
+    // experiment opening
+    struct ExperimentOpening{
+        bool valid = false;
+        double timeMs = 0.;
+        std::int64_t memoryKB = 0;      /**< resident memory delta */
+        size_t dialogs = 0;
+    };
+    QLabel *laOpening = nullptr;
+    QElapsedTimer openingTimer;
+    std::int64_t openingMemoryKB = 0;
+    bool openingLazy = true;
+    ExperimentOpening lazyOpening;
+    ExperimentOpening eagerOpening;
 };
 }
@@ -201,7 +201,7 @@ ResourcesManagerDialog::ResourcesManagerDialog(){
     }
 }
 
-void ResourcesManagerDialog::update_from_resources_manager(const ResourcesManager *resM){
+void ResourcesManagerDialog::update_from_resources_manager(const ResourcesManager *resM, const ResourcesIndexer *indexer){
 
     auto code = resM->reload_code();
     ui::w_blocking(m_ui.cbReloadAudio)->setChecked(code & reloadAudioCode);
@@ -238,9 +238,7 @@ void ResourcesManagerDialog::update_from_resources_manager(const ResourcesManage
         ui.lwFiles->blockSignals(true);
         auto resources = resM->get_resources(type);
         for(auto resource : resources){
-            auto info = QFileInfo(resource->path);
             ui.lwFiles->addItem(resource->display_name());
-            ui.lwFiles->item(ui.lwFiles->count()-1)->setForeground(info.exists() ? Qt::darkGreen : Qt::red);
         }
 
         if(to_int(idSelected) < ui.lwFiles->count()){
@@ -269,6 +267,43 @@ void ResourcesManagerDialog::update_from_resources_manager(const ResourcesManage
             }
         }
     }
+
+    update_resources_status(resM, indexer);
+}
+
+void ResourcesManagerDialog::update_resources_status(const ResourcesManager *resM, const ResourcesIndexer *indexer){
+
+    // status comes from the background indexer, files are never accessed here
+    for(const auto type : Resource::get_types()){
+
+        auto &ui = std::get<0>(m_typesW[type]);
+        auto resources = resM->get_resources(type);
+        if(to_int(resources.size()) != ui.lwFiles->count()){
+            continue;
+        }
+
+        for(size_t ii = 0; ii < resources.size(); ++ii){
+
+            auto item = ui.lwFiles->item(to_int(ii));
+            const auto metadata = indexer->metadata(resources[ii]->path);
+            const auto status = metadata != nullptr ? metadata->status : ResourceMetadata::Status::Unknown;
+            switch(status){
+            case ResourceMetadata::Status::Valid:
+                item->setForeground(Qt::darkGreen);
+                break;
+            case ResourceMetadata::Status::Missing:
+                item->setForeground(Qt::red);
+                break;
+            case ResourceMetadata::Status::Invalid:
+                item->setForeground(QColor(255,140,0));
+                break;
+            default:
+                item->setForeground(Qt::gray);
+                break;
+            }
+            item->setToolTip(metadata != nullptr ? metadata->description() : ResourceMetadata().description());
+        }
+    }
 }
 
 void ResourcesManagerDialog::update_resources_to_reload(){
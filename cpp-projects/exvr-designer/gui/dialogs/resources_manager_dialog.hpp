@@ -38,6 +38,7 @@
 
 // local
 #include "resources/resources_manager.hpp"
+#include "resources/resources_indexer.hpp"
 #include "ui_resources_manager_dialog.h"
 #include "ui_resource_type.h"
 
@@ -55,7 +56,8 @@ Q_OBJECT
 public:
 
     ResourcesManagerDialog();
-    void update_from_resources_manager(const ResourcesManager *resM);
+    void update_from_resources_manager(const ResourcesManager *resM, const ResourcesIndexer *indexer);
+    void update_resources_status(const ResourcesManager *resM, const ResourcesIndexer *indexer);
 
 public slots:
 
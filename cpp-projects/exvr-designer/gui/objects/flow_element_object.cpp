@@ -31,11 +31,21 @@ using namespace tool::ex;
 
 
 
+qreal ElementO::text_width(const QFontMetrics &fontMetrics, const QString &text){
+
+    if(m_textGeneration != textMetricsGeneration || m_cachedText != text){
+        m_textGeneration  = textMetricsGeneration;
+        m_cachedText      = text;
+        m_cachedTextWidth = fontMetrics.boundingRect(text).width();
+    }
+    return m_cachedTextWidth;
+}
+
 void ElementO::adapt_size_from_name(QFontMetrics fontMetrics){
 
-    QRect rect = fontMetrics.boundingRect(name);
-    qreal minAreaWidth = 1.2*rect.width();
-    qreal maxAreaWidth = 1.7*rect.width();
+    const qreal textWidth = text_width(fontMetrics, name);
+    qreal minAreaWidth = 1.2*textWidth;
+    qreal maxAreaWidth = 1.7*textWidth;
     qreal areaWidth = minAreaWidth + areaStretch*(maxAreaWidth - minAreaWidth);
     uiElemRect = QRectF(QPointF(0.,0.), QSizeF(0.9*areaWidth, 0.8*areaHeight));
     uiAreaRect = QRectF(QPointF(0.,0.), QSizeF(areaWidth, areaHeight));
@@ -53,6 +63,10 @@ void ElementO::draw(QPainter &painter, qreal zoomLevel){
     Q_UNUSED(zoomLevel)    
 }
 
+QRectF ElementO::bounding_rect() const{
+    return uiAreaRect.united(uiElemRect);
+}
+
 FlowElementO::FlowElementO(FlowElement *element) :
     ElementO(element->name()),
     key(ElementKey{element->key()}),
@@ -60,10 +60,12 @@ public:
     }
     static void define_area_height(qreal height){areaHeight = height;}
     static void define_stretch(qreal stretch){areaStretch = stretch;};
+    static void invalidate_text_metrics(){++textMetricsGeneration;}
 
     virtual void adapt_size_from_name(QFontMetrics fontMetrics);
     virtual void compute_position(QPointF topLeft, int loopMaxDeepLevel);
     virtual void draw(QPainter &painter, qreal zoomLevel);
+    virtual QRectF bounding_rect() const;
 
     static inline qreal areaHeight = 0.;
     static inline qreal areaStretch = 0.75;
@@ -73,6 +75,19 @@ public:
     QRectF uiElemRect = QRectF(0., 0., 0., 0.); /**< rectangle of the element in the display view */
 
     QString name;
+
+protected:
+
+    qreal text_width(const QFontMetrics &fontMetrics, const QString &text);
+
+private:
+
+    static inline size_t textMetricsGeneration = 1; /**< incremented each time the font used by the flow changes */
+
+    // text metrics cache
+    size_t m_textGeneration = 0;
+    QString m_cachedText;
+    qreal m_cachedTextWidth = 0.;
 };
 
 
@@ -30,6 +30,7 @@
 using namespace tool::ex;
 
 void FlowSequenceO::reset(){
+    m_index.reset(1., 0);
     nodesElements.clear();
     routinesElements.clear();
     ISIsElements.clear();
@@ -176,6 +177,9 @@ void FlowSequenceO::update_from_experiment(Experiment *exp){
 
     loopsElements = std::move(newLoopsElements);
 
+    // ids changed, the index is rebuilt by compute_layout
+    m_index.reset(1., 0);
+
     // active move elements
     for(auto &element : elements){
         if(element->type == FlowElement::Type::Node){
@@ -213,9 +217,9 @@ void FlowSequenceO::update_from_experiment(Experiment *exp){
 }
 
 RowId FlowSequenceO::mouse_on_element_id(const QPoint &mousePos){
-    for(size_t ii = 0; ii < elements.size(); ++ii){
-        if(elements[ii]->uiElemRect.contains(mousePos)){
-            return RowId{static_cast<int>(ii)};
+    for(const auto id : m_index.items_at(mousePos)){
+        if(id < elements.size() && elements[id]->uiElemRect.contains(mousePos)){
+            return RowId{static_cast<int>(id)};
         }
     }
     return RowId{-1};
@@ -223,9 +227,9 @@ RowId FlowSequenceO::mouse_on_element_id(const QPoint &mousePos){
 
 FlowElementO *FlowSequenceO::mouse_on_element(const QPoint &mousePos){
 
-    for(auto& elem : elements){
-        if(elem->uiElemRect.contains(mousePos)){
-            return elem.get();
+    for(const auto id : m_index.items_at(mousePos)){
+        if(id < elements.size() && elements[id]->uiElemRect.contains(mousePos)){
+            return elements[id].get();
         }
     }
     return nullptr;
@@ -233,9 +237,11 @@ FlowElementO *FlowSequenceO::mouse_on_element(const QPoint &mousePos){
 
 LoopFlowElementO *FlowSequenceO::mouse_on_loop(const QPoint &mousePos){
 
-    for(auto& elem : loopsElements){
-        if(elem->uiElemRect.contains(mousePos)){
-            return elem.get();
+    for(const auto id : m_index.items_at(mousePos)){
+        if(id >= elements.size() && (id - elements.size()) < loopsElements.size()){
+            if(auto loop = loopsElements[id - elements.size()].get(); loop->uiElemRect.contains(mousePos)){
+                return loop;
+            }
         }
     }
     return nullptr;
@@ -310,14 +316,69 @@ void FlowSequenceO::check_click_on_elements(QPoint clickPos) noexcept{
     emit GSignals::get()->unselect_element_signal(true);
 }
 
-void FlowSequenceO::draw(QPainter &painter, qreal zoomLevel){
+QSizeF FlowSequenceO::compute_layout(const QFontMetrics &fontMetrics, qreal zoomLevel, int maximumDeepLevel){
 
+    // compute elements sizes
+    FlowElementO::define_area_height(fontMetrics.boundingRect("O").height()*2.5);
+    // # elements
     for(auto& element : elements){
-        element->draw(painter, zoomLevel);
+        element->adapt_size_from_name(fontMetrics);
+    }
+    // # loops
+    for(auto& loop : loopsElements){
+        loop->adapt_size_from_name(fontMetrics);
+    }
+
+    // area sizes
+    qreal allElementsWidth = 0.;
+    for(const auto& element : elements){
+        allElementsWidth += element->uiAreaRect.width();
     }
 
+    // compute starting and ending point
+    startMainLine = QPointF(20*zoomLevel, (maximumDeepLevel+1)*FlowElementO::areaHeight + FlowElementO::areaHeight*0.5);
+    endMainLine   = QPointF(allElementsWidth+2*startMainLine.x(), (maximumDeepLevel+1)*FlowElementO::areaHeight + FlowElementO::areaHeight*0.5);
+
+    // compute elements positions
+    qreal xoffset = startMainLine.x();
+    for(auto& element : elements){
+        QPointF topLeft(xoffset, (1+maximumDeepLevel)*FlowElementO::areaHeight);
+        element->compute_position(topLeft, 1+maximumDeepLevel);
+        xoffset += element->uiAreaRect.width();
+    }
     for(auto& loop : loopsElements){
-        loop->draw(painter, zoomLevel);
+        loop->compute_loop_position(zoomLevel);
+    }
+
+    // fill spatial index
+    m_index.reset(4.*FlowElementO::areaHeight, elements.size() + loopsElements.size());
+    for(size_t ii = 0; ii < elements.size(); ++ii){
+        m_index.insert(ii, elements[ii]->bounding_rect());
+    }
+    for(size_t ii = 0; ii < loopsElements.size(); ++ii){
+        m_index.insert(elements.size() + ii, loopsElements[ii]->bounding_rect());
+    }
+
+    return QSizeF(endMainLine.x(), endMainLine.y() + (maximumDeepLevel+1)*FlowElementO::areaHeight + 2*FlowElementO::areaHeight);
+}
+
+void FlowSequenceO::draw(QPainter &painter, qreal zoomLevel, const QRectF &exposedRect){
+
+    // take pens width into account
+    const qreal margin = 2.*zoomLevel;
+    const QRectF area = exposedRect.adjusted(-margin, -margin, margin, margin);
+
+    // ids are sorted, elements are drawn before loops
+    for(const auto id : m_index.items_in(area)){
+        if(id < elements.size()){
+            if(elements[id]->bounding_rect().intersects(area)){
+                elements[id]->draw(painter, zoomLevel);
+            }
+        }else if(id - elements.size() < loopsElements.size()){
+            if(auto loop = loopsElements[id - elements.size()].get(); loop->bounding_rect().intersects(area)){
+                loop->draw(painter, zoomLevel);
+            }
+        }
     }
 }
 
@@ -33,6 +33,7 @@
 #include "routine_flow_element_object.hpp"
 #include "isi_flow_element_object.hpp"
 #include "node_flow_element_object.hpp"
+#include "flow_spatial_index.hpp"
 // # experiment
 #include "experiment/experiment.hpp"
 
@@ -50,7 +51,8 @@ public:
     LoopFlowElementO *mouse_on_loop(const QPoint &mousePos);
 
     void check_click_on_elements(QPoint clickPos) noexcept;    
-    void draw(QPainter &painter, qreal zoomLevel);
+    QSizeF compute_layout(const QFontMetrics &fontMetrics, qreal zoomLevel, int maximumDeepLevel);
+    void draw(QPainter &painter, qreal zoomLevel, const QRectF &exposedRect);
 
     FlowElementO* current_selection() const;
 
@@ -58,6 +60,7 @@ private:
 
     size_t flow_position(FlowElementO *elem) const;
 
+    FlowSpatialIndex m_index; /**< elements ids followed by loops ids, updated by compute_layout */
 
 public:
 
@@ -68,6 +71,10 @@ public:
     std::vector<LoopNodeFlowElementO*>              loopsEnd;
     std::vector<std::unique_ptr<LoopFlowElementO>>  loopsElements; // not in elements
     std::vector<std::unique_ptr<FlowElementO>>      elements; // all elements
+
+    // layout
+    QPointF startMainLine;
+    QPointF endMainLine;
 };
 }
 
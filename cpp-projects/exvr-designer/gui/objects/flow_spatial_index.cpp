@@ -0,0 +1,97 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "flow_spatial_index.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+
+using namespace tool::ex;
+
+void FlowSpatialIndex::reset(qreal cellWidth, size_t nbItems){
+
+    m_cellWidth = cellWidth > 0. ? cellWidth : 1.;
+    for(auto &cell : m_cells){
+        cell.clear();
+    }
+    m_itemsStamp.assign(nbItems, 0);
+    m_currentStamp = 0;
+}
+
+size_t FlowSpatialIndex::cell_id(qreal x) const noexcept{
+    if(x <= 0.){
+        return 0;
+    }
+    return static_cast<size_t>(std::floor(x/m_cellWidth));
+}
+
+void FlowSpatialIndex::insert(size_t id, const QRectF &rect){
+
+    if(id >= m_itemsStamp.size()){
+        m_itemsStamp.resize(id+1, 0);
+    }
+
+    const size_t first = cell_id(rect.left());
+    const size_t last  = cell_id(rect.right());
+    if(last >= m_cells.size()){
+        m_cells.resize(last+1);
+    }
+
+    for(size_t ii = first; ii <= last; ++ii){
+        m_cells[ii].push_back(id);
+    }
+}
+
+const std::vector<size_t> &FlowSpatialIndex::items_at(const QPointF &pos) const{
+
+    const size_t id = cell_id(pos.x());
+    if(id >= m_cells.size()){
+        return m_empty;
+    }
+    return m_cells[id];
+}
+
+const std::vector<size_t> &FlowSpatialIndex::items_in(const QRectF &rect){
+
+    m_queryResult.clear();
+    if(m_cells.empty()){
+        return m_queryResult;
+    }
+
+    ++m_currentStamp;
+    const size_t first = cell_id(rect.left());
+    const size_t last  = std::min(cell_id(rect.right()), m_cells.size()-1);
+    for(size_t ii = first; ii <= last; ++ii){
+        for(const auto id : m_cells[ii]){
+            if(m_itemsStamp[id] != m_currentStamp){
+                m_itemsStamp[id] = m_currentStamp;
+                m_queryResult.push_back(id);
+            }
+        }
+    }
+
+    // keep insertion order for drawing
+    std::sort(m_queryResult.begin(), m_queryResult.end());
+    return m_queryResult;
+}
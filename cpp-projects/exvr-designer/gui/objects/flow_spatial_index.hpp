@@ -0,0 +1,58 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <vector>
+
+// Qt
+#include <QRectF>
+
+namespace tool::ex {
+
+class FlowSpatialIndex{
+
+public:
+
+    void reset(qreal cellWidth, size_t nbItems);
+    void insert(size_t id, const QRectF &rect);
+
+    const std::vector<size_t> &items_at(const QPointF &pos) const;
+    const std::vector<size_t> &items_in(const QRectF &rect);
+
+    inline size_t nb_cells() const noexcept{return m_cells.size();}
+
+private:
+
+    size_t cell_id(qreal x) const noexcept;
+
+    qreal m_cellWidth = 1.;
+    std::vector<std::vector<size_t>> m_cells;   /**< columns of the flow, each one containing the ids of the overlapping items */
+    std::vector<size_t> m_itemsStamp;           /**< last query each item has been returned by, avoid duplicates without sorting twice */
+    std::vector<size_t> m_queryResult;
+    size_t m_currentStamp = 0;
+
+    static inline const std::vector<size_t> m_empty = {};
+};
+}
@@ -28,6 +28,9 @@
 #include <QFile>
 #include <QTextStream>
 
+// qt-utility
+#include "qt_str.hpp"
+
 
 using namespace tool::ex;
 
@@ -35,9 +38,31 @@ LoopFlowElementO::LoopFlowElementO(Loop *loop) : FlowElementO(loop){
     squareSizeArrow = 5.;
 }
 
+void LoopFlowElementO::compute_loop_position(qreal zoomLevel){
+
+    const size_t level = m_insideLoopsID.size()+1;
+    const QSizeF sizeArrow(squareSizeArrow*zoomLevel, squareSizeArrow*zoomLevel);
+
+    lineRight    = endLoopNode->uiElemRect.center() - QPointF(0., endLoopNode->uiElemRect.height()*0.5);
+    lineTopRight = QPointF(endLoopNode->uiElemRect.center().x(),  (level)*FlowElementO::areaHeight);
+    lineTopLeft  = QPointF(startLoopNode->uiElemRect.center().x(), (level)*FlowElementO::areaHeight);
+    lineLeft     = startLoopNode->uiElemRect.center() - QPointF(0., sizeArrow.height() + startLoopNode->uiElemRect.height()*0.5);
+
+    const QPointF topMiddle= (lineTopLeft + lineTopRight)*0.5;
+    uiElemRect = QRectF(QPointF(topMiddle.x() - uiElemRect.width()*0.5, topMiddle.y() - uiElemRect.height()*0.5),
+                        uiElemRect.size());
+
+    const qreal margin = sizeArrow.width();
+    uiLoopRect = QRectF(lineTopLeft, QPointF(lineTopRight.x(), std::max(lineLeft.y(), lineRight.y()) + sizeArrow.height())).
+        united(uiElemRect).adjusted(-margin, -margin, margin, margin);
+}
+
+QRectF LoopFlowElementO::bounding_rect() const{
+    return uiLoopRect;
+}
+
 void LoopFlowElementO::draw(QPainter &painter, qreal zoomLevel){
 
-    size_t level = m_insideLoopsID.size()+1;
     QSizeF sizeArrow(squareSizeArrow*zoomLevel, squareSizeArrow*zoomLevel);
 
     QPen linePen;
@@ -48,34 +73,22 @@ void LoopFlowElementO::draw(QPainter &painter, qreal zoomLevel){
     boxPen.setWidthF(zoomLevel*1.1);
     boxPen.setColor(display::Colors::line_box(is_selected(), type));
 
-    QPointF right    = endLoopNode->uiElemRect.center() - QPointF(0., endLoopNode->uiElemRect.height()*0.5);
-    QPointF topRight = QPointF(endLoopNode->uiElemRect.center().x(),  (level)*FlowElementO::areaHeight);
-
-    QPointF topLeft  = QPointF(startLoopNode->uiElemRect.center().x(), (level)*FlowElementO::areaHeight);
-    QPointF left     = startLoopNode->uiElemRect.center() - QPointF(0., sizeArrow.height() + startLoopNode->uiElemRect.height()*0.5);
-
-    QPointF topMiddle= (topLeft + topRight)*0.5;
-
-    QPolygonF loopLine({right, topRight, topLeft, left});
+    QPolygonF loopLine({lineRight, lineTopRight, lineTopLeft, lineLeft});
 
     linePen.setStyle(Qt::DashLine);
     painter.setPen(linePen);
     painter.drawPolyline(loopLine);
 
     QPolygonF arrow;
-    arrow << left - QPointF(sizeArrow.width()*0.5,0.);
-    arrow << left + QPointF(0., sizeArrow.height());
-    arrow << left + QPointF(sizeArrow.width()*0.5,0.);
-    arrow << left - QPointF(sizeArrow.width()*0.5,0.);
+    arrow << lineLeft - QPointF(sizeArrow.width()*0.5,0.);
+    arrow << lineLeft + QPointF(0., sizeArrow.height());
+    arrow << lineLeft + QPointF(sizeArrow.width()*0.5,0.);
+    arrow << lineLeft - QPointF(sizeArrow.width()*0.5,0.);
 
     linePen.setStyle(Qt::SolidLine);
     painter.setPen(linePen);
     painter.drawPolyline(arrow);
 
-    QPainterPath path;
-    path.addPolygon(arrow);
-    uiElemRect = QRectF(QPointF(topMiddle.x() - uiElemRect.width()*0.5, topMiddle.y() - uiElemRect.height()*0.5),
-                        uiElemRect.size());
 
     // draw rectangle
     painter.setPen(boxPen);
@@ -95,11 +108,11 @@ LoopNodeFlowElementO::LoopNodeFlowElementO(LoopNode *loopNode) : MovableFlowElem
 
 void LoopNodeFlowElementO::adapt_size_from_name(QFontMetrics fontMetrics){
 
-    MovableFlowElementO::adapt_size_from_name(fontMetrics);
+    adapt_buttons_size(fontMetrics);
 
-    const QRect rect = fontMetrics.boundingRect("LOOP");
-    const qreal minAreaWidth = 0.4*rect.width();
-    const qreal maxAreaWidth = 0.8*rect.width();
+    const qreal textWidth = text_width(fontMetrics, QSL("LOOP"));
+    const qreal minAreaWidth = 0.4*textWidth;
+    const qreal maxAreaWidth = 0.8*textWidth;
     const qreal areaWidth = minAreaWidth + areaStretch*(maxAreaWidth - minAreaWidth);
 
     const qreal min = std::min(0.6*areaWidth, 0.8*areaHeight);
@@ -41,6 +41,10 @@ public:
 
     // element virtual
     void draw(QPainter &painter, qreal zoomLevel) override;
+    QRectF bounding_rect() const override;
+
+    // must be called once start and end nodes positions have been computed
+    void compute_loop_position(qreal zoomLevel);
 
     // associated nodes
     LoopNodeFlowElementO *startLoopNode = nullptr;
@@ -48,6 +52,13 @@ public:
 
     qreal squareSizeArrow = 5.;
 
+    // cached line points
+    QPointF lineRight;
+    QPointF lineTopRight;
+    QPointF lineTopLeft;
+    QPointF lineLeft;
+    QRectF uiLoopRect = QRectF(0., 0., 0., 0.); /**< rectangle containing the loop line and its box */
+
 };
 
 class LoopNodeFlowElementO : public MovableFlowElementO{
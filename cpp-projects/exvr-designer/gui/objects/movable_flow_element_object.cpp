@@ -33,8 +33,11 @@ MovableFlowElementO::MovableFlowElementO(FlowElement *element) : FlowElementO (e
 }
 
 void MovableFlowElementO::adapt_size_from_name(QFontMetrics fontMetrics){
-
     FlowElementO::adapt_size_from_name(fontMetrics);
+    adapt_buttons_size(fontMetrics);
+}
+
+void MovableFlowElementO::adapt_buttons_size(const QFontMetrics &fontMetrics){
     removeElement->adapt_size_from_name(fontMetrics);
     if(canMoveToLeft){
         moveLeftElement->adapt_size_from_name(fontMetrics);
@@ -63,6 +66,18 @@ void MovableFlowElementO::compute_position(QPointF topLeft, int loopMaxDeepLevel
     moveRightElement->uiElemRect = QRectF(uiElemRect.center()   + QPointF(0.2*rightSize.width(), 0.8*areaHeight + offset), rightSize);
 }
 
+QRectF MovableFlowElementO::bounding_rect() const{
+
+    auto rect = FlowElementO::bounding_rect().united(removeElement->uiElemRect);
+    if(canMoveToLeft){
+        rect = rect.united(moveLeftElement->uiElemRect);
+    }
+    if(canMoveToRight){
+        rect = rect.united(moveRightElement->uiElemRect);
+    }
+    return rect;
+}
+
 void MovableFlowElementO::draw(QPainter &painter, qreal zoomLevel){
 
     if(!is_selected()){
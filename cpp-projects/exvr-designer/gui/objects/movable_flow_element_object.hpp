@@ -38,8 +38,11 @@ struct MovableFlowElementO : public FlowElementO{
     void compute_position(QPointF topLeft, int loopMaxDeepLevel) override;
 
     void draw(QPainter &painter, qreal zoomLevel) override;
+    QRectF bounding_rect() const override;
     void update(FlowElement *element) override;
 
+    void adapt_buttons_size(const QFontMetrics &fontMetrics);
+
     bool canMoveToLeft  = true;
     bool canMoveToRight = true;
 
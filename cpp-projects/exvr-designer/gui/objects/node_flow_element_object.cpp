@@ -35,9 +35,9 @@ NodeFlowElementO::NodeFlowElementO(NodeFlow *node) : FlowElementO(node){
 
 void NodeFlowElementO::adapt_size_from_name(QFontMetrics fontMetrics){
 
-    QRect rect = fontMetrics.boundingRect(name);
-    qreal minAreaWidth = 0.4*rect.width();
-    qreal maxAreaWidth = 0.8*rect.width();
+    const qreal textWidth = text_width(fontMetrics, name);
+    qreal minAreaWidth = 0.4*textWidth;
+    qreal maxAreaWidth = 0.8*textWidth;
     qreal areaWidth = minAreaWidth + areaStretch*(maxAreaWidth - minAreaWidth);
 
     qreal min = std::min(0.6*areaWidth, 0.8*areaHeight);
@@ -76,6 +76,10 @@ void NodeFlowElementO::compute_position(QPointF topLeft, int loopMaxDeepLevel){
 //    addIsi->uiElemRect     = QRectF(QPointF(posXButtons, uiAreaRect.y() + areaHeight + 2*heightButtons + 3*heightOffset), QSizeF(widthButton, heightButtons));
 }
 
+QRectF NodeFlowElementO::bounding_rect() const{
+    return FlowElementO::bounding_rect().united(addRoutine->uiElemRect).united(addLoop->uiElemRect);
+}
+
 void NodeFlowElementO::draw_add_buttons(QPainter &painter, qreal zoomLevel){
 
     QPen pen;
@@ -42,6 +42,7 @@ public:
     void adapt_size_from_name(QFontMetrics fontMetrics) override;
     void draw(QPainter &painter, qreal zoomLevel) override;
     void compute_position(QPointF topLeft, int loopMaxDeepLevel) override;
+    QRectF bounding_rect() const override;
     void draw_add_buttons(QPainter &painter, qreal zoomLevel);
 
     std::unique_ptr<AddButtonO> addRoutine = nullptr;
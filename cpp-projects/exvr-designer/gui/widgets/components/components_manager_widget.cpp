@@ -24,6 +24,9 @@
 
 #include "components_manager_widget.hpp"
 
+// std
+#include <algorithm>
+
 // Qt
 #include <QMimeData>
 #include <QVector2D>
@@ -34,6 +37,7 @@
 
 // local
 #include "experiment/global_signals.hpp"
+#include "config_widget.hpp"
 
 using namespace tool::ex;
 
@@ -90,13 +94,63 @@ ComponentsManagerW::ComponentsManagerW(){
 
 ComponentConfigDialog *ComponentsManagerW::component_dialog(ComponentKey componentKey){
 
-    if(m_dialogsW.count(componentKey) != 0){
-        return m_dialogsW[componentKey].get();
+    if(auto dialog = m_dialogsW.find(componentKey); dialog != m_dialogsW.end()){
+        return dialog->second.get();
     }
 
     return nullptr;
 }
 
+size_t ComponentsManagerW::dialogs_widgets_count() const{
+    size_t count = 0;
+    for(const auto &dialog : m_dialogsW){
+        count += static_cast<size_t>(dialog.second->findChildren<QWidget*>().size());
+    }
+    return count;
+}
+
+void ComponentsManagerW::mark_dialog_as_closed(ComponentKey componentKey){
+    m_closedDialogs.erase(std::remove(m_closedDialogs.begin(), m_closedDialogs.end(), componentKey), m_closedDialogs.end());
+    m_closedDialogs.push_back(componentKey);
+}
+
+ComponentConfigDialog *ComponentsManagerW::create_component_dialog(ComponentKey componentKey){
+
+    if(auto dialog = component_dialog(componentKey); dialog != nullptr){
+        m_closedDialogs.erase(std::remove(m_closedDialogs.begin(), m_closedDialogs.end(), componentKey), m_closedDialogs.end());
+        return dialog;
+    }
+
+    if(m_compM == nullptr){
+        return nullptr;
+    }
+    auto component = m_compM->get_component(componentKey, false);
+    if(component == nullptr){
+        return nullptr;
+    }
+
+    // release the oldest closed dialogs, the arguments are kept by the model
+    while(m_closedDialogs.size() > closedDialogsCacheSize){
+        m_dialogsW.erase(m_closedDialogs.front());
+        m_closedDialogs.pop_front();
+    }
+
+    Bench::start("[CM: Generate component config dialog]"sv, false);
+        auto configDialog = std::make_unique<ComponentConfigDialog>(this, component);
+        connect(configDialog.get(), &ComponentConfigDialog::finished, this, [=](){
+            if(auto compoW = component_widget(componentKey); compoW != nullptr){
+                compoW->showWindow = false;
+                compoW->update_style();
+            }
+            mark_dialog_as_closed(componentKey);
+        });
+        auto dialog = configDialog.get();
+        m_dialogsW[componentKey] = std::move(configDialog);
+    Bench::stop();
+
+    return dialog;
+}
+
 ComponentW *ComponentsManagerW::component_widget(ComponentKey componentKey){
 
     for(int ii = 0; ii < m_componentsListW.count(); ++ii){
@@ -135,6 +189,7 @@ void ComponentsManagerW::update_from_components_manager(ComponentsManager *compM
         mask[componentW->key] = found;
         if(!found){
             m_dialogsW.erase(componentW->key);
+            m_closedDialogs.erase(std::remove(m_closedDialogs.begin(), m_closedDialogs.end(), componentW->key), m_closedDialogs.end());
             delete m_componentsListW.remove_at(ii);
         }
     }
@@ -142,6 +197,7 @@ void ComponentsManagerW::update_from_components_manager(ComponentsManager *compM
     Bench::stop();
     Bench::start("[CM: Generates new components]"sv, false);
 
+    m_compM = compM;
     m_configsList.clear();
 
     // add new widget/dialog
@@ -154,19 +210,17 @@ void ComponentsManagerW::update_from_components_manager(ComponentsManager *compM
 
         if(!mask[componentKey]){
 
-            Bench::start("[CM: Generate component config dialog]"sv, false);
-
-                // dialog
-                auto configDialog = std::make_unique<ComponentConfigDialog>(this, component);
-                connect(configDialog.get(), &ComponentConfigDialog::finished, this, [=](){
-                    if(auto compoW = component_widget(componentKey); compoW != nullptr){
-                        compoW->showWindow = false;
-                        compoW->update_style();
-                    }
-                });
-                m_dialogsW[componentKey] = std::move(configDialog);
+            // arguments missing from the model (new component, experiment saved with an older version)
+            // are added from the parameters widgets defaults, dialogs can then be created on first opening
+            Bench::start("[CM: Add missing args]"sv, false);
+                add_missing_args(component);
             Bench::stop();
 
+            if(!lazyDialogs){
+                create_component_dialog(componentKey);
+                mark_dialog_as_closed(componentKey);
+            }
+
             Bench::start("[CM: Generate Component widget]"sv, false);
                 m_componentsListW.add_widget(new ComponentW(component));
             Bench::stop();
@@ -201,7 +255,9 @@ void ComponentsManagerW::update_from_components_manager(ComponentsManager *compM
             componentW->update_from_component(component);
         Bench::stop();
         Bench::start("[CM: Update dialog]"sv, false);
-            m_dialogsW[ComponentKey{component->key()}]->update_from_component(component);
+            if(auto dialog = component_dialog(ComponentKey{component->key()}); dialog != nullptr){
+                dialog->update_from_component(component);
+            }
         Bench::stop();
     }
 
@@ -213,8 +269,59 @@ void ComponentsManagerW::update_from_components_manager(ComponentsManager *compM
     Bench::stop();
 }
 
+void ComponentsManagerW::add_missing_args(Component *component){
+
+    ComponentKey componentKey{component->key()};
+    for(const auto &arg : ConfigW::default_args(component->type, true)){
+        if(component->initConfig->args.count(arg.name) == 0){
+            emit GSignals::get()->new_arg_signal(componentKey, component->initConfig->c_key(), arg, true);
+        }
+    }
+
+    const auto &configArgs = ConfigW::default_args(component->type, false);
+    for(const auto &config : component->configs){
+        for(const auto &arg : configArgs){
+            if(config->args.count(arg.name) == 0){
+                emit GSignals::get()->new_arg_signal(componentKey, config->c_key(), arg, false);
+            }
+        }
+    }
+}
+
+void ComponentsManagerW::update_from_journal(ComponentsManager *compM, const ChangeJournal &journal){
+
+    Bench::start("[CM: Patch components]"sv, false);
+
+    // components list is unchanged, only patch journaled components
+    bool renamed = false;
+    for(const auto &change : journal.components){
+
+        ComponentKey componentKey{change.first};
+        auto component = compM->get_component(componentKey, false);
+        if(component == nullptr){
+            continue;
+        }
+
+        m_configsList[componentKey] = component->get_configs_name();
+        if(auto componentW = component_widget(componentKey); componentW != nullptr){
+            componentW->update_from_component(component);
+        }
+        if(auto dialog = component_dialog(componentKey); dialog != nullptr){
+            dialog->update_from_component(component);
+        }
+        renamed |= (change.second & ChangeRenamed) != 0;
+    }
+
+    if(renamed){
+        update_components_to_display();
+    }
+
+    Bench::stop();
+}
+
 void ComponentsManagerW::reset(){
     m_dialogsW.clear();
+    m_closedDialogs.clear();
     m_componentsListW.delete_all();
 }
 
@@ -329,7 +436,7 @@ void ComponentsManagerW::initialize_menues(){
 void ComponentsManagerW::toggle_component_parameters_dialog(ComponentKey componentKey){
 
     if(auto compoW = component_widget(componentKey); compoW != nullptr){
-        if(auto paramsD = component_dialog(componentKey); paramsD != nullptr){
+        if(auto paramsD = create_component_dialog(componentKey); paramsD != nullptr){
             if(paramsD){
                 if(!paramsD->isVisible()){
                     paramsD->show();
@@ -337,6 +444,7 @@ void ComponentsManagerW::toggle_component_parameters_dialog(ComponentKey compone
                 }else{
                     paramsD->hide();
                     component_widget(componentKey)->showWindow = false;
+                    mark_dialog_as_closed(componentKey);
                 }
             }
             compoW->update_style();
@@ -439,7 +547,7 @@ void ComponentsManagerW::show_howering_component_custom_menu(QPoint pos, Compone
 
     QAction *editA = new QAction("Edit parameters");
     connect(editA, &QAction::triggered, this, [=](){
-        auto paramsD = component_dialog(componentKey);
+        auto paramsD = create_component_dialog(componentKey);
         if(paramsD){
             paramsD->show();
             paramsD->raise();
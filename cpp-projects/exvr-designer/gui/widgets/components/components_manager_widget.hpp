@@ -25,6 +25,7 @@
 #pragma once
 
 // std
+#include <deque>
 #include <tuple>
 
 // Qt
@@ -40,6 +41,7 @@
 #include "data/components_manager.hpp"
 #include "component_widget.hpp"
 #include "component_config_dialog.hpp"
+#include "experiment/change_journal.hpp"
 
 namespace tool::ex {
 
@@ -58,15 +60,23 @@ public :
     ComponentsManagerW();
 
     ComponentConfigDialog *component_dialog(ComponentKey componentKey);
+    ComponentConfigDialog *create_component_dialog(ComponentKey componentKey);
     ComponentW *component_widget(ComponentKey componentKey);
     std::pair<int, ComponentW*> component_widget_with_position(ComponentKey componentKey);
 
     void reset();
     void update_from_components_manager(ComponentsManager *compM);
+    void update_from_journal(ComponentsManager *compM, const ChangeJournal &journal);
     void close_all_configs_dialogs();
 
     void add_new_component(Component::Type type, int id);
 
+    inline size_t dialogs_count() const noexcept{return m_dialogsW.size();}
+    size_t dialogs_widgets_count() const;
+
+    static inline bool lazyDialogs = true;              /**< create config dialogs on first opening */
+    static inline size_t closedDialogsCacheSize = 16;   /**< closed dialogs kept alive before being released */
+
 public slots:        
 
     void dragEnterEvent(QDragEnterEvent *event) override;
@@ -85,6 +95,8 @@ public slots:
 private:
 
     void initialize_menues();
+    void mark_dialog_as_closed(ComponentKey componentKey);
+    void add_missing_args(Component *component);
 
 private :
 
@@ -99,7 +111,9 @@ private :
 
     ui::ListWidget m_componentsListW = QColor(189,189,189);
 
+    ComponentsManager *m_compM = nullptr;
     std::unordered_map<ComponentKey, ComponentsConfigDialogUP> m_dialogsW;
+    std::deque<ComponentKey> m_closedDialogs;
     std::unordered_map<ComponentKey, QStringList> m_configsList;
 
     QComboBox m_cbComponentsToDisplay;
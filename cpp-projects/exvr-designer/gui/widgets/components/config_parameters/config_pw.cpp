@@ -182,6 +182,19 @@ void ConfigParametersW::init_from_args(std::map<QStringView,Arg> &args){
     }
 }
 
+std::vector<Arg> ConfigParametersW::default_args() const{
+
+    std::vector<Arg> args;
+    args.reserve(m_inputUiElements.size() + m_inputNonUiArguments.size());
+    for(const auto &inputUiElem : m_inputUiElements){
+        args.push_back(inputUiElem.second->convert_to_arg());
+    }
+    for(const auto &inputNonUiArg : m_inputNonUiArguments){
+        args.push_back(inputNonUiArg.second);
+    }
+    return args;
+}
+
 void ConfigParametersW::update_from_resources(){
     for(auto &ui : m_inputUiElements){
         ui.second->update_from_resources();
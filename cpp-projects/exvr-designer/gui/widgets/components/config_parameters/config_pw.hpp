@@ -68,6 +68,7 @@ public :
 
     // # update
     void init_from_args(std::map<QStringView,Arg> &args);
+    std::vector<Arg> default_args() const;
     void update_from_resources();
     void update_from_components();
     void reset_args();
@@ -29,6 +29,7 @@
 #include "gui/ex_widgets/ex_checkbox_w.hpp"
 #include "gui/ex_widgets/ex_line_edit_w.hpp"
 #include "gui/ex_widgets/ex_spin_box_w.hpp"
+#include "gui/ex_widgets/ex_double_spin_box_w.hpp"
 #include "gui/ex_widgets/ex_label_w.hpp"
 
 // local
@@ -43,6 +44,13 @@ struct K2ManagerInitConfigParametersW::Impl{
     ExComboBoxIndexW mode{"mode"};
     ExLineEditW camarasToUse{"cameras_to_use"};
     ExCheckBoxW debugBypassDevice{"debug_bypass"};
+
+    ExCheckBoxW fusionRemoveOverlaps{"fusion_remove_overlaps"};
+    ExDoubleSpinBoxW fusionVoxelSize{"fusion_voxel_size_mm"};
+
+    ExComboBoxIndexW decimationMode{"decimation_mode"};
+    ExLineEditW decimationBudgets{"decimation_budgets"};
+
     ExLabelW infos{"infos"};
 };
 
@@ -54,6 +62,11 @@ void K2ManagerInitConfigParametersW::insert_widgets(){
     add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Cameras mode:"), m_p->mode()}, LStretch{false}, LMargins{true}, QFrame::NoFrame));
     add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Grabbers id to use (ex:\"0;1;2\"):"), m_p->camarasToUse()}, LStretch{false}, LMargins{true}, QFrame::NoFrame));
     add_widget(m_p->debugBypassDevice());
+    add_widget(ui::F::gen(ui::L::HB(), {m_p->fusionRemoveOverlaps(), ui::W::txt("Voxel size (mm):"), m_p->fusionVoxelSize()}, LStretch{true}, LMargins{true}, QFrame::Box));
+    add_widget(ui::F::gen(ui::L::HB(), {
+        ui::W::txt("Clouds decimation:"), m_p->decimationMode(), ui::W::txt("Points per camera (ex:\"100000;50000\"):"), m_p->decimationBudgets()},
+        LStretch{true}, LMargins{true}, QFrame::Box)
+    );
     add_widget(ui::F::gen(ui::L::VB(), {ui::W::txt("Infos:"), m_p->infos()}, LStretch{false}, LMargins{true}, QFrame::Box));
 }
 
@@ -65,6 +78,10 @@ void K2ManagerInitConfigParametersW::init_and_register_widgets(){
     add_input_ui(m_p->mode.init_widget({"Cloud", "Mesh"}, 0));
     add_input_ui(m_p->camarasToUse.init_widget("0;1;2;3;4;5;6;7"));
     add_input_ui(m_p->debugBypassDevice.init_widget("Enable it for testing the experiment without the device", false));
+    add_input_ui(m_p->fusionRemoveOverlaps.init_widget("Fused cloud: remove the points overlapping a camera with a lower id", false));
+    add_input_ui(m_p->fusionVoxelSize.init_widget(MinV<qreal>{1.}, V<qreal>{10.}, MaxV<qreal>{100.}, StepV<qreal>{1.}, 1));
+    add_input_ui(m_p->decimationMode.init_widget({"None", "Stride", "Voxel grid"}, 0));
+    add_input_ui(m_p->decimationBudgets.init_widget("100000"));
 }
 
 void K2ManagerInitConfigParametersW::update_with_info(QStringView id, QStringView value){
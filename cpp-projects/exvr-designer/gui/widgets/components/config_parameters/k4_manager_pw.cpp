@@ -26,10 +26,12 @@
 
 // qt-utility
 #include "gui/ex_widgets/ex_radio_button_w.hpp"
+#include "gui/ex_widgets/ex_combo_box_index_w.hpp"
 #include "gui/ex_widgets/ex_checkbox_w.hpp"
 #include "gui/ex_widgets/ex_line_edit_w.hpp"
 #include "gui/ex_widgets/ex_label_w.hpp"
 #include "gui/ex_widgets/ex_spin_box_w.hpp"
+#include "gui/ex_widgets/ex_double_spin_box_w.hpp"
 
 // local
 #include "gui/ex_widgets/ex_resource_w.hpp"
@@ -61,6 +63,18 @@ struct K4ManagerInitConfigParametersW::Impl{
 
     ExLineEditW camarasToUse{"cameras_to_use"};
     ExCheckBoxW debugBypassDevice{"debug_bypass"};
+
+    ExCheckBoxW syncCameras{"sync_cameras"};
+    ExDoubleSpinBoxW syncTolerance{"sync_tolerance_ms"};
+    ExSpinBoxW syncBufferSize{"sync_buffer_size"};
+    ExCheckBoxW syncLatestFallback{"sync_latest_fallback"};
+
+    ExCheckBoxW fusionRemoveOverlaps{"fusion_remove_overlaps"};
+    ExDoubleSpinBoxW fusionVoxelSize{"fusion_voxel_size_mm"};
+
+    ExComboBoxIndexW decimationMode{"decimation_mode"};
+    ExLineEditW decimationBudgets{"decimation_budgets"};
+
     ExLabelW infos{"infos"};
 
     QString configInfos =
@@ -88,6 +102,18 @@ void K4ManagerInitConfigParametersW::insert_widgets(){
 
     add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Grabbers id to use (ex:\"0;1;2\"):"), m_p->camarasToUse()}, LStretch{false}, LMargins{true}, QFrame::NoFrame));
     add_widget(m_p->debugBypassDevice());
+
+    auto syncSettings = ui::F::gen(ui::L::HB(), {
+        ui::W::txt("Tolerance (ms):"), m_p->syncTolerance(), ui::W::txt("Frames buffered per camera:"), m_p->syncBufferSize()},
+        LStretch{true}, LMargins{false}, QFrame::NoFrame
+    );
+    add_widget(ui::F::gen(ui::L::VB(), {m_p->syncCameras(), syncSettings, m_p->syncLatestFallback()}, LStretch{false}, LMargins{true}, QFrame::Box));
+    add_widget(ui::F::gen(ui::L::HB(), {m_p->fusionRemoveOverlaps(), ui::W::txt("Voxel size (mm):"), m_p->fusionVoxelSize()}, LStretch{true}, LMargins{true}, QFrame::Box));
+    add_widget(ui::F::gen(ui::L::HB(), {
+        ui::W::txt("Clouds decimation:"), m_p->decimationMode(), ui::W::txt("Points per camera (ex:\"100000;50000\"):"), m_p->decimationBudgets()},
+        LStretch{true}, LMargins{true}, QFrame::Box)
+    );
+
     add_widget(ui::F::gen(ui::L::VB(), {ui::W::txt("Infos:"), m_p->infos()}, LStretch{false}, LMargins{true}, QFrame::Box));
 }
 
@@ -106,6 +132,17 @@ void K4ManagerInitConfigParametersW::init_and_register_widgets(){
 
     add_input_ui(m_p->camarasToUse.init_widget("0;1;2;3;4"));
     add_input_ui(m_p->debugBypassDevice.init_widget("Enable it for testing the experiment without the device", false));
+
+    add_input_ui(m_p->syncCameras.init_widget("Synchronize cameras (only complete sets of frames captured together are used)", false));
+    add_input_ui(m_p->syncTolerance.init_widget(MinV<qreal>{0.5}, V<qreal>{8.}, MaxV<qreal>{100.}, StepV<qreal>{0.5}, 1));
+    add_input_ui(m_p->syncBufferSize.init_widget(MinV<int>{1}, V<int>{4}, MaxV<int>{30}, StepV<int>{1}));
+    add_input_ui(m_p->syncLatestFallback.init_widget("Use the latest frames when a camera is late", false));
+
+    add_input_ui(m_p->fusionRemoveOverlaps.init_widget("Fused cloud: remove the points overlapping a camera with a lower id", false));
+    add_input_ui(m_p->fusionVoxelSize.init_widget(MinV<qreal>{1.}, V<qreal>{10.}, MaxV<qreal>{100.}, StepV<qreal>{1.}, 1));
+    add_input_ui(m_p->decimationMode.init_widget({"None", "Stride", "Voxel grid"}, 0));
+    add_input_ui(m_p->decimationBudgets.init_widget("100000"));
+    m_p->decimationBudgets.w->setToolTip("Applied to the clouds of each camera and to the fused cloud, the last budget is used for the next cameras.");
 }
 
 void K4ManagerInitConfigParametersW::update_with_info(QStringView id, QStringView value){
@@ -28,6 +28,8 @@
 #include "gui/ex_widgets/ex_checkbox_w.hpp"
 #include "gui/ex_widgets/ex_radio_button_w.hpp"
 #include "gui/ex_widgets/ex_line_edit_w.hpp"
+#include "gui/ex_widgets/ex_spin_box_w.hpp"
+#include "gui/ex_widgets/ex_combo_box_index_w.hpp"
 
 // local
 #include "gui/ex_widgets/ex_resource_w.hpp"
@@ -146,6 +148,10 @@ struct LoggerColumnsInitConfigParametersW::Impl{
 
     ExLineEditW separator{"separator"};
     ExCheckBoxW writeAtEnfOfEachFrame{"write_each_frame"};
+
+    ExSpinBoxW flushInterval{"flush_interval_ms"};
+    ExComboBoxIndexW syncPolicy{"sync_policy"};
+    ExCheckBoxW columnarFormat{"columnar_format"};
 };
 
 LoggerColumnsInitConfigParametersW::LoggerColumnsInitConfigParametersW():  ConfigParametersW(), m_p(std::make_unique<Impl>()){
@@ -172,6 +178,13 @@ void LoggerColumnsInitConfigParametersW::insert_widgets(){
         {l1,l2,l3,l4,l5,l6,l7,l8},
         LStretch{false}, LMargins{true}, QFrame::Box)
     );
+
+    add_widget(F::gen(L::VB(),{
+        F::gen(L::HB(), {W::txt("Write to disk every (ms):"), m_p->flushInterval()}, LStretch{true}, LMargins{false}),
+        F::gen(L::HB(), {W::txt("Sync file:"), m_p->syncPolicy()}, LStretch{true}, LMargins{false}),
+        m_p->columnarFormat()},
+        LStretch{false}, LMargins{true}, QFrame::Box)
+    );
 }
 
 void LoggerColumnsInitConfigParametersW::init_and_register_widgets(){
@@ -202,6 +215,10 @@ void LoggerColumnsInitConfigParametersW::init_and_register_widgets(){
 
     add_input_ui(m_p->writeAtEnfOfEachFrame.init_widget("Write columns at the end of each frame", true));
     add_input_ui(m_p->separator.init_widget(";"));
+
+    add_input_ui(m_p->flushInterval.init_widget(MinV<int>{1}, V<int>{100}, MaxV<int>{10000}, StepV<int>{10}));
+    add_input_ui(m_p->syncPolicy.init_widget({"Never", "After each write", "When experiment stops"}, 0));
+    add_input_ui(m_p->columnarFormat.init_widget("Typed columnar binary file (header line defines columns names)", false));
 }
 
 void LoggerColumnsInitConfigParametersW::create_connections(){
@@ -32,11 +32,17 @@
 #include "gui/ex_widgets/ex_checkbox_w.hpp"
 #include "gui/ex_widgets/ex_text_edit_w.hpp"
 #include "gui/ex_widgets/ex_double_spin_box_w.hpp"
+#include "gui/ex_widgets/ex_combo_box_index_w.hpp"
 
 using namespace tool::ex;
 
 struct SerialPortReaderInitParameterW::Impl{
     ExLineEditW leReaderPort{"port_to_read"};
+    ExSpinBoxW sbBaudRate{"baud_rate"};
+    ExComboBoxIndexW cbFramingMode{"framing_mode"};
+    ExLineEditW leDelimiter{"delimiter"};
+    ExSpinBoxW sbMessageLength{"message_length"};
+    ExLineEditW leStructFormat{"struct_format"};
 };
 
 SerialPortReaderInitParameterW::SerialPortReaderInitParameterW() :  ConfigParametersW(), m_p(std::make_unique<Impl>()){
@@ -44,10 +50,21 @@ SerialPortReaderInitParameterW::SerialPortReaderInitParameterW() :  ConfigParame
 
 void SerialPortReaderInitParameterW::insert_widgets(){
     add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Reader port:"), m_p->leReaderPort()}, LStretch{true}, LMargins{false}));
+    add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Baud rate:"), m_p->sbBaudRate()}, LStretch{true}, LMargins{false}));
+    add_widget(ui::W::horizontal_line());
+    add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Messages framing:"), m_p->cbFramingMode()}, LStretch{true}, LMargins{false}));
+    add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Delimiter (\\n, \\r, \\xHH...):"), m_p->leDelimiter()}, LStretch{true}, LMargins{false}));
+    add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Fixed length (bytes):"), m_p->sbMessageLength()}, LStretch{true}, LMargins{false}));
+    add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Binary struct format (e.g. <hhf):"), m_p->leStructFormat()}, LStretch{true}, LMargins{false}));
 }
 
 void SerialPortReaderInitParameterW::init_and_register_widgets(){
     add_input_ui(m_p->leReaderPort.init_widget("COM1"));
+    add_input_ui(m_p->sbBaudRate.init_widget(MinV<int>{0}, V<int>{9600}, MaxV<int>{100000000}, StepV<int>{100}));
+    add_input_ui(m_p->cbFramingMode.init_widget({"Delimiter", "Fixed length", "Binary struct"}, 0));
+    add_input_ui(m_p->leDelimiter.init_widget("\\n"));
+    add_input_ui(m_p->sbMessageLength.init_widget(MinV<int>{1}, V<int>{1}, MaxV<int>{65536}, StepV<int>{1}));
+    add_input_ui(m_p->leStructFormat.init_widget("<hhf"));
 }
 
 
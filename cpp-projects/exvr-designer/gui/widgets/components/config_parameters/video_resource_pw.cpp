@@ -26,6 +26,7 @@
 
 // qt-utility
 #include "gui/ex_widgets/ex_checkbox_w.hpp"
+#include "gui/ex_widgets/ex_spin_box_w.hpp"
 
 // local
 #include "gui/ex_widgets/ex_resource_w.hpp"
@@ -34,11 +35,23 @@
 using namespace tool::ex;
 
 struct VideoResourceInitConfigParametersW::Impl{
+    ExSpinBoxW framesRingSize{"frames_ring_size"};
+    ExCheckBoxW loop{"loop"};
 };
 
 VideoResourceInitConfigParametersW::VideoResourceInitConfigParametersW():  ConfigParametersW(), m_p(std::make_unique<Impl>()){
 }
 
+void VideoResourceInitConfigParametersW::insert_widgets(){
+    add_widget(ui::F::gen(ui::L::HB(), {ui::W::txt("Decoded frames buffer size:"), m_p->framesRingSize()}, LStretch{true}, LMargins{false}));
+    add_widget(ui::F::gen(ui::L::HB(), {m_p->loop()}, LStretch{true}, LMargins{false}));
+}
+
+void VideoResourceInitConfigParametersW::init_and_register_widgets(){
+    add_input_ui(m_p->framesRingSize.init_widget(MinV<int>{3}, V<int>{6}, MaxV<int>{60}, StepV<int>{1}));
+    add_input_ui(m_p->loop.init_widget("Loop video", false));
+}
+
 
 struct VideoResourceConfigParametersW::Impl{
     ExResourceW video{"video"};
@@ -36,8 +36,8 @@ public :
 
     VideoResourceInitConfigParametersW();
 
-    void insert_widgets() override{}
-    void init_and_register_widgets() override{}
+    void insert_widgets() override;
+    void init_and_register_widgets() override;
 
 private:
     struct Impl;
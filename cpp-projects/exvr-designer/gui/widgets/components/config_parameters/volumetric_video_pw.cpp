@@ -45,6 +45,8 @@ using namespace tool::ui;
 struct VolumetricVideoInitConfigParametersW::Impl{
     TransformSubPart transfo{"init_transform"};
     ExResourceW volumetricVideo{"volumetric_video"};
+    ExComboBoxIndexW decimationMode{"decimation_mode"};
+    ExLineEditW decimationBudgets{"decimation_budgets"};
     ExTextEditW infoText;
 };
 
@@ -54,6 +56,10 @@ VolumetricVideoInitConfigParametersW::VolumetricVideoInitConfigParametersW() :
 void VolumetricVideoInitConfigParametersW::insert_widgets(){
 
     add_widget(F::gen(L::VB(), {m_p->volumetricVideo()}, LStretch{false}, LMargins{true}, QFrame::NoFrame));
+    add_widget(F::gen(L::HB(), {
+        W::txt("Clouds decimation:"), m_p->decimationMode(), W::txt("Points per camera (ex:\"100000;50000\"):"), m_p->decimationBudgets()},
+        LStretch{true}, LMargins{true}, QFrame::Box)
+    );
 
     // infos
     add_widget(F::gen(L::VB(), {W::txt("Infos"), m_p->infoText()}, LStretch{true}, LMargins{true}, QFrame::Box));
@@ -65,6 +71,8 @@ void VolumetricVideoInitConfigParametersW::insert_widgets(){
 
 void VolumetricVideoInitConfigParametersW::init_and_register_widgets(){
     add_input_ui(m_p->volumetricVideo.init_widget(Resource::Type::VolumetricVideo, "Volumetric video:"));
+    add_input_ui(m_p->decimationMode.init_widget({"None", "Stride", "Voxel grid"}, 0));
+    add_input_ui(m_p->decimationBudgets.init_widget("100000"));
     map_sub_part(m_p->transfo.init_widget(QSL("Init transform</b> (applied when experiment starts)<b>")));
 }
 
@@ -145,6 +145,25 @@ void ConfigW::reset_args(){
     p->reset_args();
 }
 
+const std::vector<Arg> &ConfigW::default_args(Component::Type type, bool initConfig){
+
+    static std::map<std::pair<Component::Type, bool>, std::vector<Arg>> defaultArgs;
+    if(auto it = defaultArgs.find({type, initConfig}); it != defaultArgs.end()){
+        return it->second;
+    }
+
+    Bench::start("[ConfigW generate default args]"sv, false);
+        std::unique_ptr<ConfigParametersW> prototype(generate_parameters(type, initConfig));
+        prototype->type = type;
+        prototype->set_infos(ComponentKey{-1}, ConfigKey{-1}, initConfig);
+        prototype->insert_widgets();
+        prototype->init_and_register_widgets();
+        auto &args = defaultArgs[{type, initConfig}] = prototype->default_args();
+    Bench::stop();
+
+    return args;
+}
+
 ConfigParametersW *ConfigW::generate_parameters(Component::Type type, bool initConfig){
 
     using CT = Component::Type;
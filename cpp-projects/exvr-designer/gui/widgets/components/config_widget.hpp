@@ -50,6 +50,9 @@ public:
     void update_with_info(QStringView id, QStringView value);
     void reset_args();
 
+    // default arguments of the parameters widgets of a component type, generated once from a prototype widget
+    static const std::vector<Arg> &default_args(Component::Type type, bool initConfig);
+
     ConfigKey configKey;
     ComponentKey componentKey;
     QString name;
@@ -57,10 +60,10 @@ public:
 private:
 
     ConfigParametersW *p = nullptr;
-    ConfigParametersW *generate_parameters(Component::Type type, bool initConfig);
+    static ConfigParametersW *generate_parameters(Component::Type type, bool initConfig);
 
     template<typename T1, typename T2>
-    ConfigParametersW *gen_params_w(bool initConfig){
+    static ConfigParametersW *gen_params_w(bool initConfig){
         if(initConfig){
             return new T1();
         }else{
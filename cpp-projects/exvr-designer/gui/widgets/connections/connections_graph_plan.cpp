@@ -0,0 +1,295 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "connections_graph_plan.hpp"
+
+// std
+#include <algorithm>
+
+// qt-utility
+#include "qt_logger.hpp"
+
+using namespace tool::ex;
+using QtNodes::PortType;
+
+auto ConnectionsGraphPlan::node_id(Connection::Type type, int key) -> size_t{
+
+    const std::int64_t id = (static_cast<std::int64_t>(key) << 1) | (type == Connection::Type::Connector ? 1 : 0);
+    if(auto it = m_nodesId.find(id); it != m_nodesId.end()){
+        return it->second;
+    }
+
+    const size_t nodeId = m_nodesConnector.size();
+    m_nodesId[id] = nodeId;
+    m_nodesConnector.push_back(nullptr);
+    return nodeId;
+}
+
+void ConnectionsGraphPlan::compile(const Condition *condition){
+
+    m_nodesId.clear();
+    m_nodesConnector.clear();
+    m_connectorsOrder.clear();
+    m_connectionsOrder.clear();
+    m_maxDepth = 0;
+    m_cycle    = false;
+
+    // nodes
+    for(const auto &connector : condition->connectors){
+        const size_t node = node_id(Connection::Type::Connector, connector->key());
+        m_nodesConnector[node] = connector.get();
+    }
+    for(const auto &connection : condition->connections){
+        node_id(connection->startType, connection->startKey);
+        node_id(connection->endType,   connection->endKey);
+    }
+    const size_t nbNodes = m_nodesConnector.size();
+
+    // adjacency
+    m_outOffsets.assign(nbNodes + 1, 0);
+    m_inDegree.assign(nbNodes, 0);
+    for(const auto &connection : condition->connections){
+        ++m_outOffsets[node_id(connection->startType, connection->startKey) + 1];
+    }
+    for(size_t ii = 0; ii < nbNodes; ++ii){
+        m_outOffsets[ii+1] += m_outOffsets[ii];
+    }
+
+    m_outNodes.resize(condition->connections.size());
+    m_queue.assign(m_outOffsets.begin(), m_outOffsets.end() - 1); // used as fill cursors
+    for(const auto &connection : condition->connections){
+        const size_t start = node_id(connection->startType, connection->startKey);
+        const size_t end   = node_id(connection->endType,   connection->endKey);
+        m_outNodes[m_queue[start]++] = end;
+        ++m_inDegree[end];
+    }
+
+    // Kahn traversal, depth is the longest path from a source
+    m_depth.assign(nbNodes, 0);
+    m_queue.clear();
+    for(size_t ii = 0; ii < nbNodes; ++ii){
+        if(m_inDegree[ii] == 0){
+            m_queue.push_back(ii);
+        }
+    }
+
+    for(size_t ii = 0; ii < m_queue.size(); ++ii){
+        const size_t node = m_queue[ii];
+        for(size_t jj = m_outOffsets[node]; jj < m_outOffsets[node+1]; ++jj){
+            const size_t next = m_outNodes[jj];
+            m_depth[next] = std::max(m_depth[next], m_depth[node] + 1);
+            if(--m_inDegree[next] == 0){
+                m_queue.push_back(next);
+            }
+        }
+    }
+
+    for(size_t ii = 0; ii < nbNodes; ++ii){
+        m_maxDepth = std::max(m_maxDepth, m_depth[ii]);
+    }
+
+    // nodes inside a cycle are kept at the end, in the condition order
+    if(m_queue.size() < nbNodes){
+        m_cycle = true;
+        ++m_maxDepth;
+        for(size_t ii = 0; ii < nbNodes; ++ii){
+            if(m_inDegree[ii] != 0){
+                m_depth[ii] = m_maxDepth;
+                m_queue.push_back(ii);
+            }
+        }
+    }
+
+    // connectors
+    for(const auto node : m_queue){
+        if(m_nodesConnector[node] != nullptr){
+            m_connectorsOrder.push_back(m_nodesConnector[node]);
+        }
+    }
+
+    // connections, stable counting sort on the start node depth
+    m_depthOffsets.assign(m_maxDepth + 2, 0);
+    for(const auto &connection : condition->connections){
+        ++m_depthOffsets[m_depth[node_id(connection->startType, connection->startKey)] + 1];
+    }
+    for(size_t ii = 0; ii <= m_maxDepth; ++ii){
+        m_depthOffsets[ii+1] += m_depthOffsets[ii];
+    }
+    m_connectionsOrder.resize(condition->connections.size());
+    for(const auto &connection : condition->connections){
+        m_connectionsOrder[m_depthOffsets[m_depth[node_id(connection->startType, connection->startKey)]]++] = connection.get();
+    }
+}
+
+void ConnectionsGraphPlan::begin_binding(){
+
+    m_nodesDepth.clear();
+    for(auto &slot : m_slots){
+        slot.second.bound = false;
+    }
+}
+
+void ConnectionsGraphPlan::bind_node(const QtNodes::Node *node, Connection::Type type, int key){
+
+    const std::int64_t id = (static_cast<std::int64_t>(key) << 1) | (type == Connection::Type::Connector ? 1 : 0);
+    if(auto nodeId = m_nodesId.find(id); nodeId != m_nodesId.end()){
+        m_nodesDepth[node] = m_depth[nodeId->second];
+    }else{
+        m_nodesDepth[node] = 0;
+    }
+}
+
+void ConnectionsGraphPlan::bind_connection(const QtNodes::Connection &connection){
+
+    const auto outNode = connection.getNode(PortType::Out);
+    const auto inNode  = connection.getNode(PortType::In);
+    if(outNode == nullptr || inNode == nullptr){
+        return;
+    }
+
+    if(auto slot = m_slots.find(connection.id()); slot != m_slots.end()){
+        slot->second.bound = true;
+        return;
+    }
+
+    const auto outType = ConvertersTable::type(outNode->nodeDataModel()->port_data_type(PortType::Out, connection.getPortIndex(PortType::Out)).id);
+    const auto inType  = ConvertersTable::type(inNode->nodeDataModel()->port_data_type(PortType::In, connection.getPortIndex(PortType::In)).id);
+    if(!outType.has_value() || !inType.has_value()){
+        return; // propagated by QtNodes
+    }
+
+    ValueSlot slot;
+    slot.bound = true;
+    if(outType.value() != inType.value()){
+        if(slot.converter = ConvertersTable::generate(outType.value(), inType.value()); slot.converter == nullptr){
+            return; // propagated by QtNodes
+        }
+    }
+    m_slots[connection.id()] = std::move(slot);
+}
+
+void ConnectionsGraphPlan::end_binding(){
+
+    // release slots of removed connections
+    for(auto slot = m_slots.begin(); slot != m_slots.end();){
+        if(!slot->second.bound){
+            slot = m_slots.erase(slot);
+        }else{
+            ++slot;
+        }
+    }
+
+    m_pending.resize(m_maxDepth + 1);
+}
+
+auto ConnectionsGraphPlan::push_pending(const QtNodes::Node *node, QtNodes::PortIndex port) -> void{
+
+    size_t depth = 0;
+    if(auto nodeDepth = m_nodesDepth.find(node); nodeDepth != m_nodesDepth.end()){
+        depth = nodeDepth->second;
+    }
+    if(depth >= m_pending.size()){
+        m_pending.resize(depth + 1);
+    }
+
+    // a node output already waiting will be forwarded with its latest value
+    auto &bucket = m_pending[depth];
+    for(const auto &pending : bucket){
+        if(pending.first == node && pending.second == port){
+            return;
+        }
+    }
+    bucket.emplace_back(node, port);
+
+    ++m_pendingCount;
+    m_minPendingDepth = std::min(m_minPendingDepth, depth);
+}
+
+auto ConnectionsGraphPlan::deliver(const QtNodes::Connection &connection, const DataSP &data) -> void{
+
+    const auto inNode = connection.getNode(PortType::In);
+    if(inNode == nullptr){
+        return; // connection being drawn
+    }
+
+    auto slot = m_slots.find(connection.id());
+    if(slot == m_slots.end()){
+        connection.propagateData(data); // not bound yet, QtNodes converter
+        return;
+    }
+
+    ++m_deliveries;
+    if(slot->second.converter){
+        inNode->propagateData((*slot->second.converter)(data), connection.getPortIndex(PortType::In));
+    }else{
+        inNode->propagateData(data, connection.getPortIndex(PortType::In));
+    }
+}
+
+void ConnectionsGraphPlan::propagate(const QtNodes::Node *node, QtNodes::PortIndex port){
+
+    // outputs updated while propagating are forwarded by the running propagation
+    push_pending(node, port);
+    if(m_propagating){
+        return;
+    }
+
+    m_propagating = true;
+    m_deliveries  = 0;
+    const size_t maxDeliveries = MaxDeliveriesPerSlot * (m_slots.size() + 1);
+
+    while(m_pendingCount > 0){
+
+        auto &bucket = m_pending[m_minPendingDepth];
+        if(bucket.empty()){
+            ++m_minPendingDepth;
+            continue;
+        }
+
+        const auto [pendingNode, pendingPort] = bucket.back();
+        bucket.pop_back();
+        --m_pendingCount;
+
+        if(m_deliveries > maxDeliveries){
+            QtLogger::warning(QSL("ConnectionsGraphPlan: propagation stopped after ") % QString::number(m_deliveries) % QSL(" deliveries, cyclic relation."));
+            for(auto &pending : m_pending){
+                pending.clear();
+            }
+            m_pendingCount = 0;
+            break;
+        }
+
+        const auto &outConnections = pendingNode->nodeState().getEntries(PortType::Out);
+        if(static_cast<size_t>(pendingPort) >= outConnections.size()){
+            continue;
+        }
+
+        const auto data = pendingNode->nodeDataModel()->outData(pendingPort);
+        for(const auto &connection : outConnections[static_cast<size_t>(pendingPort)]){
+            deliver(*connection.second, data);
+        }
+    }
+
+    m_minPendingDepth = 0;
+    m_propagating     = false;
+}
@@ -0,0 +1,112 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <vector>
+
+// base
+#include "utility/unordered_map.hpp"
+
+// nodes
+#include "nodes/Node.hpp"
+#include "nodes/Connection.hpp"
+
+// local
+#include "data/condition.hpp"
+#include "data_models/data/nodes_data_converters.hpp"
+
+namespace tool::ex {
+
+// compiled nodes graph of a condition
+// - compile: topological order of the graph, connections are ordered by the depth of their start node
+//   buffers are kept between compilations, reloading a condition of the same size doesn't allocate
+// - bind: links the compiled graph to the scene, each connection gets a value slot holding its converter from the
+//   type-indexed ConvertersTable with a preallocated output, slots are kept while their connection exists
+// - propagate: outputs updated by the data models are forwarded by the plan in depth order instead of by QtNodes,
+//   a node receiving several inputs during a propagation forwards its latest outputs once
+class ConnectionsGraphPlan{
+
+public:
+
+    void compile(const Condition *condition);
+
+    void begin_binding();
+    void bind_node(const QtNodes::Node *node, Connection::Type type, int key);
+    void bind_connection(const QtNodes::Connection &connection);
+    void end_binding();
+
+    void propagate(const QtNodes::Node *node, QtNodes::PortIndex port);
+
+    constexpr auto connectors_order() const noexcept -> const std::vector<Connector*>& {return m_connectorsOrder;}
+    constexpr auto connections_order() const noexcept -> const std::vector<Connection*>& {return m_connectionsOrder;}
+
+    constexpr auto nodes_count() const noexcept -> size_t{return m_depth.size();}
+    constexpr auto max_depth() const noexcept -> size_t{return m_maxDepth;}
+    constexpr auto has_cycle() const noexcept -> bool{return m_cycle;}
+    inline auto slots_count() const noexcept -> size_t{return m_slots.size();}
+    constexpr auto last_deliveries_count() const noexcept -> size_t{return m_deliveries;}
+
+    static constexpr size_t MaxDeliveriesPerSlot = 64; /**< stops a propagation looping in a cycle */
+
+private:
+
+    struct ValueSlot{
+        std::unique_ptr<BaseConverter> converter = nullptr; /**< nullptr if both ports have the same type */
+        bool bound = false;
+    };
+
+    auto node_id(Connection::Type type, int key) -> size_t;
+    auto push_pending(const QtNodes::Node *node, QtNodes::PortIndex port) -> void;
+    auto deliver(const QtNodes::Connection &connection, const DataSP &data) -> void;
+
+    umap<std::int64_t, size_t> m_nodesId;
+    std::vector<Connector*> m_nodesConnector;   /**< nullptr for components nodes */
+
+    // adjacency (compressed rows)
+    std::vector<size_t> m_outOffsets;
+    std::vector<size_t> m_outNodes;
+    std::vector<size_t> m_inDegree;
+    std::vector<size_t> m_depth;
+    std::vector<size_t> m_queue;
+    std::vector<size_t> m_depthOffsets;
+
+    std::vector<Connector*> m_connectorsOrder;
+    std::vector<Connection*> m_connectionsOrder;
+
+    size_t m_maxDepth = 0;
+    bool m_cycle = false;
+
+    // binding
+    umap<const QtNodes::Node*, size_t> m_nodesDepth;
+    umap<QUuid, ValueSlot> m_slots;
+
+    // propagation, outputs waiting to be forwarded, one bucket per depth
+    std::vector<std::vector<std::pair<const QtNodes::Node*, QtNodes::PortIndex>>> m_pending;
+    size_t m_pendingCount = 0;
+    size_t m_minPendingDepth = 0;
+    size_t m_deliveries = 0;
+    bool m_propagating = false;
+};
+}
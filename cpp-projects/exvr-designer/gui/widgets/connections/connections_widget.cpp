@@ -24,6 +24,9 @@
 
 #include "connections_widget.hpp"
 
+// std
+#include <algorithm>
+
 // qt-utility
 #include "qt_logger.hpp"
 
@@ -412,6 +415,16 @@ void ConnectionsW::add_nodes_and_connections_to_scene(std::vector<Action *> comp
         QtNodes::Node &node = m_scene->createNode(std::move(std::get<1>(nodeDataModelType)));
         auto nodePtr  = &node;
 
+        // outputs are forwarded by the compiled plan instead of the node
+        if(QObject::disconnect(dataModelPtr, &NodeDataModel::dataUpdated, nodePtr, &QtNodes::Node::onDataUpdated)){
+            connect(dataModelPtr, &NodeDataModel::dataUpdated, this, [this, nodePtr](QtNodes::PortIndex index){
+                m_plan.propagate(nodePtr, index);
+            });
+        }else{
+            QtLogger::error(QSL("[ConnectionsW::add_nodes_and_connections_to_scene] Cannot detach node [") % dataModelPtr->caption() %
+                QSL("] from QtNodes propagation, its outputs bypass the compiled plan."));
+        }
+
         // geometry
         node.nodeGeometry().set_spacing(20);
 
@@ -543,7 +556,9 @@ auto ConnectionsW::update_from_condition(Condition *condition) -> void{
 
     // add
     Bench::start("ConnectionsW update_from_condition 2"sv, display);
+        m_plan.compile(condition);
         add_new_elements_from_condition(condition);
+        bind_plan();
     Bench::stop();
 
     // update
@@ -557,6 +572,21 @@ auto ConnectionsW::update_from_condition(Condition *condition) -> void{
     Bench::stop();
 }
 
+auto ConnectionsW::bind_plan() -> void{
+
+    m_plan.begin_binding();
+    for(const auto &componentNode : m_componentsNodes){
+        m_plan.bind_node(componentNode.second.first, Connection::Type::Component, componentNode.first);
+    }
+    for(const auto &connectorNode : m_connectorsNodes){
+        m_plan.bind_node(connectorNode.second.first, Connection::Type::Connector, connectorNode.first);
+    }
+    for(const auto &connection : m_connections){
+        m_plan.bind_connection(*connection.second.first);
+    }
+    m_plan.end_binding();
+}
+
 auto ConnectionsW::connector(ConnectorKey connectorKey) -> ConnectorNodeDataModel*{
     if(m_connectorsNodes.count(connectorKey.v) != 0){
         return m_connectorsNodes[connectorKey.v].second;
@@ -593,6 +623,8 @@ auto ConnectionsW::reset() -> void{
         m_scene->removeNode(*connectorNode.second.first);
     }
     m_connectorsNodes.clear();   
+
+    bind_plan();
 }
 
 void ConnectionsW::add_new_elements_from_condition(Condition *condition){
@@ -608,28 +640,25 @@ void ConnectionsW::add_new_elements_from_condition(Condition *condition){
         }
     }
 
-    // connector nodes
-    for(auto &connector : condition->connectors){
+    // connector nodes (sources first)
+    for(auto connector : m_plan.connectors_order()){
         if(m_connectorsNodes.count(connector->key()) == 0){ // if new node            
-            connectorsToAdd.emplace_back(connector.get());
+            connectorsToAdd.emplace_back(connector);
         }
     }
     add_nodes_and_connections_to_scene(commonentsNodesToAdd, connectorsToAdd, connectionsToAdd);
 
-    // connections
-    for(const auto &connection : condition->connections){
-
-        bool found = false;
-        for(const auto &connectionW : m_connections){
-
-            if(connectionW.second.second.v == connection->key()){
-                found = true;
-                break;
-            }
-        }
+    // connections (ordered by start node depth)
+    std::vector<int> existingConnections;
+    existingConnections.reserve(m_connections.size());
+    for(const auto &connectionW : m_connections){
+        existingConnections.push_back(connectionW.second.second.v);
+    }
+    std::sort(existingConnections.begin(), existingConnections.end());
 
-        if(!found){
-            add_connection(connection.get());
+    for(auto connection : m_plan.connections_order()){
+        if(!std::binary_search(existingConnections.begin(), existingConnections.end(), connection->key())){
+            add_connection(connection);
         }
     }
 }
@@ -666,28 +695,24 @@ void ConnectionsW::update_elements_from_condition(Condition *condition){
     update_components_context_menu();
 
     // connectors nodes
-    for(const auto &connector : condition->connectors){
-
-        for(auto &connectorNode : m_connectorsNodes){
+    for(auto connector : m_plan.connectors_order()){
 
-            if(connectorNode.first == connector->key()){
-
-                // update position
-                auto pos = m_scene->getNodePosition(*connectorNode.second.first);
-                if(!almost_equal(pos.x(),connector->pos.x()) || !almost_equal(pos.y(),connector->pos.y())){
-                    m_scene->setNodePosition(*connectorNode.second.first, connector->pos);
-                }
-
-                // update arg
-                connectorNode.second.second->update_from_connector(*connector);
-
-                // update selection
-                connectorNode.second.first->nodeGraphicsObject().setSelected(connector->selected);
+        auto connectorNode = m_connectorsNodes.find(connector->key());
+        if(connectorNode == m_connectorsNodes.end()){
+            continue;
+        }
 
-                break;
-            }
+        // update position
+        auto pos = m_scene->getNodePosition(*connectorNode->second.first);
+        if(!almost_equal(pos.x(),connector->pos.x()) || !almost_equal(pos.y(),connector->pos.y())){
+            m_scene->setNodePosition(*connectorNode->second.first, connector->pos);
         }
 
+        // update arg
+        connectorNode->second.second->update_from_connector(*connector);
+
+        // update selection
+        connectorNode->second.first->nodeGraphicsObject().setSelected(connector->selected);
     }
 }
 
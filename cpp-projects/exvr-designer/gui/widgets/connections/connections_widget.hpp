@@ -52,6 +52,7 @@ using QtNodes::TypeConverterId;
 #include "data/condition.hpp"
 // # widgets
 #include "ex_flow_view_widget.hpp"
+#include "connections_graph_plan.hpp"
 
 // # data models
 #include "data_models/connectors/component_node_data_model.hpp"
@@ -205,6 +206,7 @@ private:
     void update_components_context_menu();
 
     void add_connection(Connection *connection); // generate connection and insert it
+    auto bind_plan() -> void;
     void add_nodes_and_connections_to_scene(std::vector<Action*> componentsNodesToAdd, std::vector<Connector*> connectorsNodesToAdd, std::vector<Connection*> conectionsToAdd);
 
     // positions
@@ -223,6 +225,9 @@ private:
     // component id
     umap<int, std::tuple<Component::Type, QString>>  m_availableComponents;
 
+    // compiled graph of the condition, propagates the nodes outputs
+    ConnectionsGraphPlan m_plan;
+
     // scene & view
     std::unique_ptr<ExFlowScene> m_scene = nullptr;
     ExFlowView* m_view = nullptr;
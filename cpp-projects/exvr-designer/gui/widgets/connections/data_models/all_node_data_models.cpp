@@ -84,168 +84,173 @@ using QtNodes::NodeStyle;
 using QtNodes::FlowViewStyle;
 using QtNodes::ConnectionStyle;
 
+// converter used by QtNodes for the interactive connections and by the compiled graphs plans
+template<class In, class Out, class C>
+static auto register_converter(const std::shared_ptr<DataModelRegistry> &r) -> void{
+    r->registerTypeConverter(std::make_pair(In().type(), Out().type()), TypeConverter{C()});
+    ConvertersTable::add<C, Out>(In::data_type);
+}
 
 void DataNodeModels::initialize(){
 
     registry = std::make_shared<DataModelRegistry>();
 
-    using TC = TypeConverter;
     auto r = registry;
     // ### decimal
 
     // TEST
 //    r->registerTypeConverter(std::make_pair(BoolData().type(),IntData().type()),UniversalConverter(BoolData().type_data(), IntData().type_data()));
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), BoolData().type()),TC{DecimalToBoolConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), IntData().type()),TC{DecimalToIntegerConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), FloatData().type()),TC{DecimalToFloatConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), RealData().type()),TC{DecimalToRealConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), StringData().type()),TC{DecimalToStringConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(DecimalData().type(), RealListData().type()),TC{DecimalToRealListConverter()});
+    register_converter<DecimalData, BoolData, DecimalToBoolConverter>(r);
+    register_converter<DecimalData, IntData, DecimalToIntegerConverter>(r);
+    register_converter<DecimalData, FloatData, DecimalToFloatConverter>(r);
+    register_converter<DecimalData, RealData, DecimalToRealConverter>(r);
+    register_converter<DecimalData, StringData, DecimalToStringConverter>(r);
+    register_converter<DecimalData, AnyData, ToAnyConverter>(r);
+    register_converter<DecimalData, VoidData, ToVoidConverter>(r);
+    register_converter<DecimalData, RealListData, DecimalToRealListConverter>(r);
     // ### bool    
-    r->registerTypeConverter(std::make_pair(BoolData().type(),DecimalData().type()),TC{BoolToDecimalConverter()});
-    r->registerTypeConverter(std::make_pair(BoolData().type(),IntData().type()),TC{BoolToIntegerConverter()});
-    r->registerTypeConverter(std::make_pair(BoolData().type(),FloatData().type()),TC{BoolToFloatConverter()});
-    r->registerTypeConverter(std::make_pair(BoolData().type(),RealData().type()),TC{BoolToRealConverter()});
-    r->registerTypeConverter(std::make_pair(BoolData().type(),StringData().type()),TC{BoolToStringConverter()});
-    r->registerTypeConverter(std::make_pair(BoolData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(BoolData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<BoolData, DecimalData, BoolToDecimalConverter>(r);
+    register_converter<BoolData, IntData, BoolToIntegerConverter>(r);
+    register_converter<BoolData, FloatData, BoolToFloatConverter>(r);
+    register_converter<BoolData, RealData, BoolToRealConverter>(r);
+    register_converter<BoolData, StringData, BoolToStringConverter>(r);
+    register_converter<BoolData, AnyData, ToAnyConverter>(r);
+    register_converter<BoolData, VoidData, ToVoidConverter>(r);
     // ### int
-    r->registerTypeConverter(std::make_pair(IntData().type(),DecimalData().type()),TC{IntegerToDecimalConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),BoolData().type()),TC{IntegerToBoolConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),FloatData().type()),TC{IntegerToFloatConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),RealData().type()),TC{IntegerToRealConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),StringData().type()),TC{IntegerToStringConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(IntData().type(),RealListData().type()),TC{IntegerToRealListConverter()});
+    register_converter<IntData, DecimalData, IntegerToDecimalConverter>(r);
+    register_converter<IntData, BoolData, IntegerToBoolConverter>(r);
+    register_converter<IntData, FloatData, IntegerToFloatConverter>(r);
+    register_converter<IntData, RealData, IntegerToRealConverter>(r);
+    register_converter<IntData, StringData, IntegerToStringConverter>(r);
+    register_converter<IntData, AnyData, ToAnyConverter>(r);
+    register_converter<IntData, VoidData, ToVoidConverter>(r);
+    register_converter<IntData, RealListData, IntegerToRealListConverter>(r);
     // ### float
-    r->registerTypeConverter(std::make_pair(FloatData().type(),DecimalData().type()),TC{FloatToDecimalConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),BoolData().type()),TC{FloatToBoolConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),IntData().type()),TC{FloatToIntegerConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),RealData().type()),TC{FloatToRealConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),StringData().type()),TC{FloatToStringConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(FloatData().type(),RealListData().type()),TC{FloatToRealListConverter()});
+    register_converter<FloatData, DecimalData, FloatToDecimalConverter>(r);
+    register_converter<FloatData, BoolData, FloatToBoolConverter>(r);
+    register_converter<FloatData, IntData, FloatToIntegerConverter>(r);
+    register_converter<FloatData, RealData, FloatToRealConverter>(r);
+    register_converter<FloatData, StringData, FloatToStringConverter>(r);
+    register_converter<FloatData, AnyData, ToAnyConverter>(r);
+    register_converter<FloatData, VoidData, ToVoidConverter>(r);
+    register_converter<FloatData, RealListData, FloatToRealListConverter>(r);
     // ### real
-    r->registerTypeConverter(std::make_pair(RealData().type(),DecimalData().type()),TC{RealToDecimalConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),BoolData().type()),TC{RealToBoolConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),IntData().type()),TC{RealToIntegerConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),FloatData().type()),TC{RealToFloatConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),StringData().type()),TC{RealToStringConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(RealData().type(),RealListData().type()),TC{RealToRealListConverter()});
+    register_converter<RealData, DecimalData, RealToDecimalConverter>(r);
+    register_converter<RealData, BoolData, RealToBoolConverter>(r);
+    register_converter<RealData, IntData, RealToIntegerConverter>(r);
+    register_converter<RealData, FloatData, RealToFloatConverter>(r);
+    register_converter<RealData, StringData, RealToStringConverter>(r);
+    register_converter<RealData, AnyData, ToAnyConverter>(r);
+    register_converter<RealData, VoidData, ToVoidConverter>(r);
+    register_converter<RealData, RealListData, RealToRealListConverter>(r);
     // ### string
-    r->registerTypeConverter(std::make_pair(StringData().type(),DecimalData().type()),TC{StringToDecimalConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),BoolData().type()),TC{StringToBoolConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),IntData().type()),TC{StringToIntegerConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),FloatData().type()),TC{StringToFloatConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),RealData().type()),TC{StringToRealConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),StringListData().type()),TC{StringToStringListConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),ColorData().type()),TC{StringToColorConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(StringData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<StringData, DecimalData, StringToDecimalConverter>(r);
+    register_converter<StringData, BoolData, StringToBoolConverter>(r);
+    register_converter<StringData, IntData, StringToIntegerConverter>(r);
+    register_converter<StringData, FloatData, StringToFloatConverter>(r);
+    register_converter<StringData, RealData, StringToRealConverter>(r);
+    register_converter<StringData, StringListData, StringToStringListConverter>(r);
+    register_converter<StringData, ColorData, StringToColorConverter>(r);
+    register_converter<StringData, AnyData, ToAnyConverter>(r);
+    register_converter<StringData, VoidData, ToVoidConverter>(r);
     // ### string list
-    r->registerTypeConverter(std::make_pair(StringListData().type(),StringData().type()),TC{StringListToStringConverter()});
-    r->registerTypeConverter(std::make_pair(StringListData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(StringListData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<StringListData, StringData, StringListToStringConverter>(r);
+    register_converter<StringListData, AnyData, ToAnyConverter>(r);
+    register_converter<StringListData, VoidData, ToVoidConverter>(r);
     // ### double list
-    r->registerTypeConverter(std::make_pair(RealListData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(RealListData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<RealListData, AnyData, ToAnyConverter>(r);
+    register_converter<RealListData, VoidData, ToVoidConverter>(r);
     // ### any
-    r->registerTypeConverter(std::make_pair(AnyData().type(),BoolData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),IntData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),FloatData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),RealData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),StringData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),Vector2Data().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),Vector3Data().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),ColorData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),TransformData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),DecimalData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),VoidData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),StringListData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),RealListData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),DecimalListData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),LeapMotionFrameData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),LeapMotionHandsFrameData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),ImageData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),KinectBodyData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),IdAnyData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),StringAnyData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),TimeAnyData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),PlotData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),KeyboardButtonEventData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),MouseButtonEventData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),MouseAxisEventData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),JoypadButtonEventData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),JoypadAxisEventData().type()),TC{FromAnyConverter()});
-    r->registerTypeConverter(std::make_pair(AnyData().type(),GameObjectListData().type()),TC{FromAnyConverter()});
+    register_converter<AnyData, BoolData, FromAnyConverter>(r);
+    register_converter<AnyData, IntData, FromAnyConverter>(r);
+    register_converter<AnyData, FloatData, FromAnyConverter>(r);
+    register_converter<AnyData, RealData, FromAnyConverter>(r);
+    register_converter<AnyData, StringData, FromAnyConverter>(r);
+    register_converter<AnyData, Vector2Data, FromAnyConverter>(r);
+    register_converter<AnyData, Vector3Data, FromAnyConverter>(r);
+    register_converter<AnyData, ColorData, FromAnyConverter>(r);
+    register_converter<AnyData, TransformData, FromAnyConverter>(r);
+    register_converter<AnyData, DecimalData, FromAnyConverter>(r);
+    register_converter<AnyData, VoidData, FromAnyConverter>(r);
+    register_converter<AnyData, StringListData, FromAnyConverter>(r);
+    register_converter<AnyData, RealListData, FromAnyConverter>(r);
+    register_converter<AnyData, DecimalListData, FromAnyConverter>(r);
+    register_converter<AnyData, LeapMotionFrameData, FromAnyConverter>(r);
+    register_converter<AnyData, LeapMotionHandsFrameData, FromAnyConverter>(r);
+    register_converter<AnyData, ImageData, FromAnyConverter>(r);
+    register_converter<AnyData, KinectBodyData, FromAnyConverter>(r);
+    register_converter<AnyData, IdAnyData, FromAnyConverter>(r);
+    register_converter<AnyData, StringAnyData, FromAnyConverter>(r);
+    register_converter<AnyData, TimeAnyData, FromAnyConverter>(r);
+    register_converter<AnyData, PlotData, FromAnyConverter>(r);
+    register_converter<AnyData, KeyboardButtonEventData, FromAnyConverter>(r);
+    register_converter<AnyData, MouseButtonEventData, FromAnyConverter>(r);
+    register_converter<AnyData, MouseAxisEventData, FromAnyConverter>(r);
+    register_converter<AnyData, JoypadButtonEventData, FromAnyConverter>(r);
+    register_converter<AnyData, JoypadAxisEventData, FromAnyConverter>(r);
+    register_converter<AnyData, GameObjectListData, FromAnyConverter>(r);
     // ### void
-    r->registerTypeConverter(std::make_pair(VoidData().type(),AnyData().type()),TC{ToAnyConverter()});
+    register_converter<VoidData, AnyData, ToAnyConverter>(r);
     // ### leap motion frame
-    r->registerTypeConverter(std::make_pair(LeapMotionFrameData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(LeapMotionFrameData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<LeapMotionFrameData, AnyData, ToAnyConverter>(r);
+    register_converter<LeapMotionFrameData, VoidData, ToVoidConverter>(r);
     // ### keyboard button state
-    r->registerTypeConverter(std::make_pair(KeyboardButtonEventData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(KeyboardButtonEventData().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(KeyboardButtonEventData().type(),StringData().type()),TC{KeyboardButtonEventToStringConverter()});
+    register_converter<KeyboardButtonEventData, AnyData, ToAnyConverter>(r);
+    register_converter<KeyboardButtonEventData, VoidData, ToVoidConverter>(r);
+    register_converter<KeyboardButtonEventData, StringData, KeyboardButtonEventToStringConverter>(r);
     // ### mouse button state
-    r->registerTypeConverter(std::make_pair(MouseButtonEventData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(MouseButtonEventData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<MouseButtonEventData, AnyData, ToAnyConverter>(r);
+    register_converter<MouseButtonEventData, VoidData, ToVoidConverter>(r);
     // ### mouse axis state
-    r->registerTypeConverter(std::make_pair(MouseAxisEventData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(MouseAxisEventData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<MouseAxisEventData, AnyData, ToAnyConverter>(r);
+    register_converter<MouseAxisEventData, VoidData, ToVoidConverter>(r);
     // ### joypad button state
-    r->registerTypeConverter(std::make_pair(JoypadButtonEventData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(JoypadButtonEventData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<JoypadButtonEventData, AnyData, ToAnyConverter>(r);
+    register_converter<JoypadButtonEventData, VoidData, ToVoidConverter>(r);
     // ### joypad axis state
-    r->registerTypeConverter(std::make_pair(JoypadAxisEventData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(JoypadAxisEventData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<JoypadAxisEventData, AnyData, ToAnyConverter>(r);
+    register_converter<JoypadAxisEventData, VoidData, ToVoidConverter>(r);
     // ### leap motion hands frame
-    r->registerTypeConverter(std::make_pair(LeapMotionHandsFrameData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(LeapMotionHandsFrameData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<LeapMotionHandsFrameData, AnyData, ToAnyConverter>(r);
+    register_converter<LeapMotionHandsFrameData, VoidData, ToVoidConverter>(r);
     // ### kinect body
-    r->registerTypeConverter(std::make_pair(KinectBodyData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(KinectBodyData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<KinectBodyData, AnyData, ToAnyConverter>(r);
+    register_converter<KinectBodyData, VoidData, ToVoidConverter>(r);
     // ### image
-    r->registerTypeConverter(std::make_pair(ImageData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(ImageData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<ImageData, AnyData, ToAnyConverter>(r);
+    register_converter<ImageData, VoidData, ToVoidConverter>(r);
     // ### plot
-    r->registerTypeConverter(std::make_pair(PlotData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(PlotData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<PlotData, AnyData, ToAnyConverter>(r);
+    register_converter<PlotData, VoidData, ToVoidConverter>(r);
     // ### vector2
-    r->registerTypeConverter(std::make_pair(Vector2Data().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(Vector2Data().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(Vector2Data().type(),StringData().type()),TC{Vector2ToStringConverter()});
+    register_converter<Vector2Data, AnyData, ToAnyConverter>(r);
+    register_converter<Vector2Data, VoidData, ToVoidConverter>(r);
+    register_converter<Vector2Data, StringData, Vector2ToStringConverter>(r);
     // ### vector3
-    r->registerTypeConverter(std::make_pair(Vector3Data().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(Vector3Data().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(Vector3Data().type(),StringData().type()),TC{Vector3ToStringConverter()});
+    register_converter<Vector3Data, AnyData, ToAnyConverter>(r);
+    register_converter<Vector3Data, VoidData, ToVoidConverter>(r);
+    register_converter<Vector3Data, StringData, Vector3ToStringConverter>(r);
     // ### color
-    r->registerTypeConverter(std::make_pair(ColorData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(ColorData().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(ColorData().type(),StringData().type()),TC{ColorToStringConverter()});
-    r->registerTypeConverter(std::make_pair(ColorData().type(),Vector3Data().type()),TC{ColorToVector3Converter()});
+    register_converter<ColorData, AnyData, ToAnyConverter>(r);
+    register_converter<ColorData, VoidData, ToVoidConverter>(r);
+    register_converter<ColorData, StringData, ColorToStringConverter>(r);
+    register_converter<ColorData, Vector3Data, ColorToVector3Converter>(r);
     // ### transform
-    r->registerTypeConverter(std::make_pair(TransformData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(TransformData().type(),VoidData().type()),TC{ToVoidConverter()});
-    r->registerTypeConverter(std::make_pair(TransformData().type(),StringData().type()),TC{TransformToStringConverter()});
+    register_converter<TransformData, AnyData, ToAnyConverter>(r);
+    register_converter<TransformData, VoidData, ToVoidConverter>(r);
+    register_converter<TransformData, StringData, TransformToStringConverter>(r);
     // ### id any
-    r->registerTypeConverter(std::make_pair(IdAnyData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(IdAnyData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<IdAnyData, AnyData, ToAnyConverter>(r);
+    register_converter<IdAnyData, VoidData, ToVoidConverter>(r);
     // ### time any
-    r->registerTypeConverter(std::make_pair(TimeAnyData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(TimeAnyData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<TimeAnyData, AnyData, ToAnyConverter>(r);
+    register_converter<TimeAnyData, VoidData, ToVoidConverter>(r);
     // ### string any
-    r->registerTypeConverter(std::make_pair(StringAnyData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(StringAnyData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<StringAnyData, AnyData, ToAnyConverter>(r);
+    register_converter<StringAnyData, VoidData, ToVoidConverter>(r);
     // ### gameobject list
-    r->registerTypeConverter(std::make_pair(GameObjectListData().type(),AnyData().type()),TC{ToAnyConverter()});
-    r->registerTypeConverter(std::make_pair(GameObjectListData().type(),VoidData().type()),TC{ToVoidConverter()});
+    register_converter<GameObjectListData, AnyData, ToAnyConverter>(r);
+    register_converter<GameObjectListData, VoidData, ToVoidConverter>(r);
 
 //    // ### component out data
 //    r->registerTypeConverter(std::make_pair(ComponentOutData().type(),IntData().type()),TC{FromComponentConverter()});
@@ -637,7 +642,7 @@ std::unique_ptr<ConnectorNodeDataModel> DataNodeModels::generate_connector_data_
     connectorDataModel->initialize(style, ConnectorKey{connector->key()});
 
     // update
-    if(connector->arg.value().isEmpty()){
+    if(connector->arg->value().isEmpty()){
         connector->arg = connectorDataModel->convert_to_arg();
     }else{
         connectorDataModel->update_from_connector(*connector);
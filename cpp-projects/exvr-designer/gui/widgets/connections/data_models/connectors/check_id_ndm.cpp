@@ -43,7 +43,7 @@ void CheckIdEmbeddedW::initialize(){
 
 void CheckIdNodeDataModel::compute(){
 
-    auto idData = std::dynamic_pointer_cast<IntData>(interData[0]);
+    auto idData = node_data_cast<IntData>(interData[0]);
     QString text =QSL("== ") % idData->value_as_text();
     set_embedded_widget_text(text);
 
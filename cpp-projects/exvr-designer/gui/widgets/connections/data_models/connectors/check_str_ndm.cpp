@@ -43,7 +43,7 @@ void CheckStrEmbeddedW::initialize(){
 
 void CheckStrNodeDataModel::compute(){
 
-    auto strData = std::dynamic_pointer_cast<StringData>(interData[0]);
+    auto strData = node_data_cast<StringData>(interData[0]);
     QString text = QSL("== ") % strData->value();
     set_embedded_widget_text(text);
 
@@ -358,7 +358,7 @@ void ConnectorNodeDataModel::set_invalid_cast(){
 
 
 void ConnectorNodeDataModel::update_from_connector(const Connector &connector){
-    m_widget->update_from_arg(connector.arg);
+    m_widget->update_from_arg(connector.arg.get());
     emit embeddedWidgetSizeUpdated();
 }
 
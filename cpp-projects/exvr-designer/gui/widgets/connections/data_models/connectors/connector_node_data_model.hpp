@@ -110,7 +110,10 @@ public:
     virtual void setInData(std::shared_ptr<NodeData> nodeData, PortIndex index) override;
 
     static bool is_runtime(const std::shared_ptr<NodeData> &data){
-        return std::dynamic_pointer_cast<BaseNodeData>(data)->is_runtime();
+        if(auto baseNodeData = to_base_node_data(data.get()); baseNodeData != nullptr){
+            return baseNodeData->is_runtime();
+        }
+        return false;
     }
 
 public slots:
@@ -151,7 +154,7 @@ public:
 
     template<typename T2>
     static std::shared_ptr<T2> dcast(std::shared_ptr<NodeData> data){
-        return std::dynamic_pointer_cast<T2>(data);
+        return node_data_cast<T2>(data);
     }
 
     template<typename T1, typename T2>
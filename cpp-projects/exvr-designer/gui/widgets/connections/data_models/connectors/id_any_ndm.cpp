@@ -44,7 +44,7 @@ void IdAnyEmbeddedW::initialize(){
 
 void IdAnyNodeDataModel::compute(){
 
-    auto interV = std::dynamic_pointer_cast<IntData>(interData[0]);
+    auto interV = node_data_cast<IntData>(interData[0]);
     const int id = interV->value();
     const QString txt = interV->value_as_text();
     set_embedded_widget_text(txt);
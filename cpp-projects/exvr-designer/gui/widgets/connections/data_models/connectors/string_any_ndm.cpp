@@ -44,7 +44,7 @@ void StringAnyEmbeddedW::initialize(){
 
 void StringAnyNodeDataModel::compute(){
 
-    auto interV = std::dynamic_pointer_cast<StringData>(interData[0]);
+    auto interV = node_data_cast<StringData>(interData[0]);
     const QString str = interV->value();
     const QString txt = interV->value_as_text();
     set_embedded_widget_text(txt);
@@ -68,7 +68,7 @@ auto apply_str_convertion(const T &value) -> QString{
         if constexpr(std::is_same_v<T, QStringList>){
             return str::Convertor::to_str(value, " ");
         }
-        if constexpr(!std::is_same_v<T, QStringList>){
+        if constexpr(!std::is_same_v<T, QStringList> && requires{str::Convertor::to_str(value);}){
             return str::Convertor::to_str(value);
         }
     }
@@ -79,14 +79,21 @@ class BaseNodeData : public NodeData{
 
 public:
 
-    BaseNodeData(ConnectionNode::Type type, QString text = "") :  m_type(type), m_text(text) {
+    BaseNodeData(ConnectionNode::Type type) :  m_type(type) {
         if(type == ConnectionNode::Type::component_out_data_t){
             m_runtime = true;
         }        
         m_nodeDatatype = NodeDataType {get_id(m_type), get_name(m_type)};
     }
 
-    inline QString value_as_text() const{return m_text;}
+    // text is only generated when displayed or converted to a string
+    inline const QString &value_as_text() const{
+        if(!m_textGenerated){
+            m_text = generate_text();
+            m_textGenerated = true;
+        }
+        return m_text;
+    }
     const NodeDataType& type() const override {return m_nodeDatatype;}
     ConnectionNode::Type type_data() const{return m_type;}
     inline const QString &id()   const {return m_nodeDatatype.id;}
@@ -102,9 +109,20 @@ public:
 
 protected:
 
+    virtual QString generate_text() const{return "";}
+
+    void reset_state(){
+        m_runtime       = m_type == ConnectionNode::Type::component_out_data_t;
+        m_textGenerated = false;
+    }
+
     ConnectionNode::Type m_type;
-    QString m_text;
     bool m_runtime = false;
+
+private:
+
+    mutable QString m_text;
+    mutable bool m_textGenerated = false;
 };
 
 
@@ -113,10 +131,20 @@ class TypeNodeData : public BaseNodeData{
 
 public:
 
+    static constexpr ConnectionNode::Type data_type = T;
+
     TypeNodeData() : BaseNodeData(T){}
-    TypeNodeData(V value)  :  BaseNodeData(T,  apply_str_convertion(value)), m_value(value){}
+    TypeNodeData(V value)  :  BaseNodeData(T), m_value(std::move(value)){}
+
+    inline V value() const{return m_value;}
+
+    void set_value(V value){
+        m_value = std::move(value);
+        reset_state();
+    }
 
-    inline V value() const{return m_value;}    
+protected:
+    QString generate_text() const override{return apply_str_convertion(m_value);}
 
 private:
     V m_value;  
@@ -172,11 +200,16 @@ template<>
 class TypeNodeData<ConnectionNode::Type::id_any_t, IdAny> : public BaseNodeData{
 
 public:
-    TypeNodeData() : BaseNodeData(ConnectionNode::Type::id_any_t){}
-    TypeNodeData(IdAny value)  :  BaseNodeData(ConnectionNode::Type::id_any_t, apply_str_convertion(value.id)), m_value(value){}
+    static constexpr ConnectionNode::Type data_type = ConnectionNode::Type::id_any_t;
+
+    TypeNodeData() : BaseNodeData(data_type){}
+    TypeNodeData(IdAny value)  :  BaseNodeData(data_type), m_value(std::move(value)){}
 
     inline IdAny value() const{return m_value;}
 
+protected:
+    QString generate_text() const override{return apply_str_convertion(m_value.id);}
+
 private:
     IdAny m_value;
 };
@@ -185,11 +218,16 @@ template<>
 class TypeNodeData<ConnectionNode::Type::string_any_t, StringAny> : public BaseNodeData{
 
 public:
-    TypeNodeData() : BaseNodeData(ConnectionNode::Type::string_any_t){}
-    TypeNodeData(StringAny value)  :  BaseNodeData(ConnectionNode::Type::string_any_t, value.str), m_value(value){}
+    static constexpr ConnectionNode::Type data_type = ConnectionNode::Type::string_any_t;
+
+    TypeNodeData() : BaseNodeData(data_type){}
+    TypeNodeData(StringAny value)  :  BaseNodeData(data_type), m_value(std::move(value)){}
 
     inline StringAny value() const{return m_value;}
 
+protected:
+    QString generate_text() const override{return m_value.str;}
+
 private:
     StringAny m_value;
 };
@@ -239,8 +277,41 @@ using ComponentOutData          = TypeNodeData<CNT::component_out_data_t, Undefi
     return NodeDataType();
 }
 
+// every node data of the designer inherits from BaseNodeData, the cast is checked in debug builds
+// and its type tag replaces the RTTI lookup for the concrete types
+[[maybe_unused]] static auto to_base_node_data(const QtNodes::NodeData *nodeData) -> const BaseNodeData*{
+    if(nodeData == nullptr){
+        return nullptr;
+    }
+    Q_ASSERT(dynamic_cast<const BaseNodeData*>(nodeData) != nullptr);
+    return static_cast<const BaseNodeData*>(nodeData);
+}
+
+[[maybe_unused]] static auto to_base_node_data(QtNodes::NodeData *nodeData) -> BaseNodeData*{
+    return const_cast<BaseNodeData*>(to_base_node_data(static_cast<const QtNodes::NodeData*>(nodeData)));
+}
+
+template<class T>
+auto node_data_cast(const std::shared_ptr<QtNodes::NodeData> &nodeData) -> std::shared_ptr<T>{
+    auto baseNodeData = to_base_node_data(nodeData.get());
+    if(baseNodeData == nullptr){
+        return nullptr;
+    }
+    if constexpr(std::is_same_v<T, BaseNodeData>){
+        return std::static_pointer_cast<BaseNodeData>(nodeData);
+    }else{
+        if(baseNodeData->type_data() == T::data_type){
+            return std::static_pointer_cast<T>(nodeData);
+        }
+        return nullptr;
+    }
+}
+
 [[maybe_unused]] static auto convert_node_data_to_string(std::shared_ptr<QtNodes::NodeData> nodeData) -> QString{
-    return std::dynamic_pointer_cast<BaseNodeData>(nodeData)->value_as_text();
+    if(auto baseNodeData = to_base_node_data(nodeData.get()); baseNodeData != nullptr){
+        return baseNodeData->value_as_text();
+    }
+    return {};
 }
 
 
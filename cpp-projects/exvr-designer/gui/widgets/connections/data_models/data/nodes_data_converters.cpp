@@ -26,21 +26,61 @@
 
 // base
 #include "utility/math.hpp"
+#include "utility/unordered_map.hpp"
 
 using namespace tool::str;
 using namespace tool::ex;
 
-bool is_from_component(DataSP data){
-    if (auto inputData = std::dynamic_pointer_cast<ComponentOutData>(data); inputData){
-        return true;
+auto ConvertersTable::generate(ConnectionNode::Type in, ConnectionNode::Type out) -> std::unique_ptr<BaseConverter>{
+    if(auto generator = m_generators[static_cast<size_t>(in)][static_cast<size_t>(out)]; generator != nullptr){
+        return generator();
+    }
+    return nullptr;
+}
+
+auto ConvertersTable::type(const QString &id) -> std::optional<ConnectionNode::Type>{
+
+    static const auto types = []{
+        umap<QString, ConnectionNode::Type> types;
+        for(const auto &connectionNode : ConnectionNode::connectionsNodes.data){
+            types[from_view(std::get<1>(connectionNode))] = std::get<0>(connectionNode);
+        }
+        return types;
+    }();
+
+    if(auto type = types.find(id); type != types.end()){
+        return type->second;
+    }
+    return std::nullopt;
+}
+
+bool is_from_component(const DataSP &data){
+    if(auto baseNodeData = to_base_node_data(data.get()); baseNodeData != nullptr){
+        return baseNodeData->type_data() == ComponentOutData::data_type;
     }
     return false;
 }
 
-void propagate_runtime(DataSP input, DataSP output){
-    if(std::dynamic_pointer_cast<BaseNodeData>(input)->is_runtime()){
-        std::dynamic_pointer_cast<BaseNodeData>(output)->set_runtime();
+void propagate_runtime(const DataSP &input, const DataSP &output){
+    auto inputData  = to_base_node_data(input.get());
+    auto outputData = to_base_node_data(output.get());
+    if(inputData != nullptr && outputData != nullptr && inputData->is_runtime()){
+        outputData->set_runtime();
+    }
+}
+
+// the previous output is updated in place when it belongs to a compiled graph plan slot (receivers only keep weak
+// references to their inputs and the slot delivers the value to a single port) or when the converter is its only owner,
+// converters shared by the QtNodes registry connections get a new one otherwise
+template<class T, class V>
+DataSP reuse_output(DataSP &previous, bool slotOwned, V &&value){
+    if(previous != nullptr && (slotOwned || previous.use_count() == 1)){
+        if(auto previousData = to_base_node_data(previous.get()); previousData->type_data() == T::data_type){
+            static_cast<T*>(previousData)->set_value(std::forward<V>(value));
+            return previous;
+        }
     }
+    return std::make_shared<T>(std::forward<V>(value));
 }
 
 DataSP BoolToIntegerConverter::operator()(DataSP data){
@@ -51,8 +91,8 @@ DataSP BoolToIntegerConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<BoolData>(data); inputData){
-        m_value = std::make_shared<IntData>(inputData->value() ? 1 : 0);        
+    if (auto inputData = node_data_cast<BoolData>(data); inputData){
+        m_value = reuse_output<IntData>(m_value, m_slotOwned, inputData->value() ? 1 : 0);
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -68,8 +108,8 @@ DataSP BoolToFloatConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<BoolData>(data); inputData){
-        m_value = std::make_shared<FloatData>(inputData->value()? 1.f : 0.f);
+    if (auto inputData = node_data_cast<BoolData>(data); inputData){
+        m_value = reuse_output<FloatData>(m_value, m_slotOwned, inputData->value()? 1.f : 0.f);
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -85,8 +125,8 @@ DataSP BoolToRealConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<BoolData>(data); inputData){
-        m_value = std::make_shared<RealData>(inputData->value()? 1. : 0.);
+    if (auto inputData = node_data_cast<BoolData>(data); inputData){
+        m_value = reuse_output<RealData>(m_value, m_slotOwned, inputData->value()? 1. : 0.);
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -102,8 +142,8 @@ DataSP BoolToDecimalConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<BoolData>(data); inputData){
-        m_value = std::make_shared<DecimalData>(Decimal{inputData->value()});
+    if (auto inputData = node_data_cast<BoolData>(data); inputData){
+        m_value = reuse_output<DecimalData>(m_value, m_slotOwned, Decimal{inputData->value()});
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -120,8 +160,8 @@ DataSP IntegerToBoolConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<IntData>(data); inputData){
-        m_value = std::make_shared<BoolData>(inputData->value() != 0);
+    if (auto inputData = node_data_cast<IntData>(data); inputData){
+        m_value = reuse_output<BoolData>(m_value, m_slotOwned, inputData->value() != 0);
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -137,8 +177,8 @@ std::shared_ptr<NodeData> IntegerToFloatConverter::operator()(std::shared_ptr<No
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<IntData>(data); inputData){
-        m_value = std::make_shared<FloatData>(static_cast<float>(inputData->value()));
+    if (auto inputData = node_data_cast<IntData>(data); inputData){
+        m_value = reuse_output<FloatData>(m_value, m_slotOwned, static_cast<float>(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -154,8 +194,8 @@ DataSP IntegerToRealConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<IntData>(data); inputData){
-        m_value = std::make_shared<RealData>(static_cast<double>(inputData->value()));
+    if (auto inputData = node_data_cast<IntData>(data); inputData){
+        m_value = reuse_output<RealData>(m_value, m_slotOwned, static_cast<double>(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -172,8 +212,8 @@ DataSP FloatToBoolConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<FloatData>(data); inputData){
-        m_value = std::make_shared<BoolData>(!almost_equal<float>(inputData->value(), 0.f));
+    if (auto inputData = node_data_cast<FloatData>(data); inputData){
+        m_value = reuse_output<BoolData>(m_value, m_slotOwned, !almost_equal<float>(inputData->value(), 0.f));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -189,8 +229,8 @@ DataSP FloatToIntegerConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<FloatData>(data); inputData){
-        m_value = std::make_shared<IntData>(static_cast<int>(inputData->value()));
+    if (auto inputData = node_data_cast<FloatData>(data); inputData){
+        m_value = reuse_output<IntData>(m_value, m_slotOwned, static_cast<int>(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -206,8 +246,8 @@ DataSP FloatToRealConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<FloatData>(data)){
-        m_value = std::make_shared<RealData>(static_cast<double>(inputData->value()));
+    if (auto inputData =node_data_cast<FloatData>(data)){
+        m_value = reuse_output<RealData>(m_value, m_slotOwned, static_cast<double>(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -223,8 +263,8 @@ DataSP DecimalToBoolConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<DecimalData>(data)){
-        m_value = std::make_shared<BoolData>(inputData->value().to_int() != 0);
+    if (auto inputData =node_data_cast<DecimalData>(data)){
+        m_value = reuse_output<BoolData>(m_value, m_slotOwned, inputData->value().to_int() != 0);
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -240,8 +280,8 @@ DataSP DecimalToIntegerConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<DecimalData>(data)){
-        m_value = std::make_shared<IntData>(inputData->value().to_int());
+    if (auto inputData =node_data_cast<DecimalData>(data)){
+        m_value = reuse_output<IntData>(m_value, m_slotOwned, inputData->value().to_int());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -257,8 +297,8 @@ DataSP DecimalToFloatConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<DecimalData>(data)){
-        m_value = std::make_shared<FloatData>(inputData->value().to_float());
+    if (auto inputData =node_data_cast<DecimalData>(data)){
+        m_value = reuse_output<FloatData>(m_value, m_slotOwned, inputData->value().to_float());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -274,8 +314,8 @@ DataSP DecimalToRealConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<DecimalData>(data)){
-        m_value = std::make_shared<RealData>(inputData->value().to_double());
+    if (auto inputData =node_data_cast<DecimalData>(data)){
+        m_value = reuse_output<RealData>(m_value, m_slotOwned, inputData->value().to_double());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -291,8 +331,8 @@ DataSP IntegerToDecimalConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<IntData>(data)){
-        m_value = std::make_shared<DecimalData>(Decimal{inputData->value()});
+    if (auto inputData =node_data_cast<IntData>(data)){
+        m_value = reuse_output<DecimalData>(m_value, m_slotOwned, Decimal{inputData->value()});
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -308,8 +348,8 @@ DataSP FloatToDecimalConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<FloatData>(data)){
-        m_value = std::make_shared<DecimalData>(Decimal{inputData->value()});
+    if (auto inputData =node_data_cast<FloatData>(data)){
+        m_value = reuse_output<DecimalData>(m_value, m_slotOwned, Decimal{inputData->value()});
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -326,8 +366,8 @@ DataSP RealToBoolConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<RealData>(data)){
-        m_value = std::make_shared<BoolData>(!almost_equal<double>(inputData->value(), 0.));
+    if (auto inputData =node_data_cast<RealData>(data)){
+        m_value = reuse_output<BoolData>(m_value, m_slotOwned, !almost_equal<double>(inputData->value(), 0.));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -344,8 +384,8 @@ DataSP RealToIntegerConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<RealData>(data)){
-        m_value = std::make_shared<IntData>(static_cast<int>(inputData->value()));
+    if (auto inputData =node_data_cast<RealData>(data)){
+        m_value = reuse_output<IntData>(m_value, m_slotOwned, static_cast<int>(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -361,8 +401,8 @@ DataSP RealToFloatConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<RealData>(data)){
-        m_value = std::make_shared<FloatData>(static_cast<float>(inputData->value()));
+    if (auto inputData =node_data_cast<RealData>(data)){
+        m_value = reuse_output<FloatData>(m_value, m_slotOwned, static_cast<float>(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -378,8 +418,8 @@ DataSP RealToDecimalConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<RealData>(data)){
-        m_value = std::make_shared<DecimalData>(Decimal{inputData->value()});
+    if (auto inputData =node_data_cast<RealData>(data)){
+        m_value = reuse_output<DecimalData>(m_value, m_slotOwned, Decimal{inputData->value()});
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -414,7 +454,7 @@ DataSP FromAnyConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData = std::dynamic_pointer_cast<AnyData>(data)){
+    if (auto inputData = node_data_cast<AnyData>(data)){
         m_value = inputData->value();
         propagate_runtime(data, m_value);
     }else{
@@ -431,8 +471,8 @@ DataSP BoolToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<BoolData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<BoolData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -448,8 +488,8 @@ DataSP IntegerToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<IntData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<IntData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -465,8 +505,8 @@ DataSP FloatToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<FloatData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<FloatData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -482,8 +522,8 @@ DataSP RealToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<RealData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<RealData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -499,8 +539,8 @@ DataSP DecimalToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<DecimalData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<DecimalData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -517,8 +557,8 @@ DataSP Vector2ToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<Vector2Data>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<Vector2Data>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -534,8 +574,8 @@ DataSP Vector3ToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<Vector3Data>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<Vector3Data>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -550,8 +590,8 @@ DataSP ColorToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<ColorData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<ColorData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -566,8 +606,8 @@ DataSP ColorToVector3Converter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<ColorData>(data)){
-        m_value = std::make_shared<Vector3Data>(Convertor::to_vector3(inputData->value()));
+    if (auto inputData =node_data_cast<ColorData>(data)){
+        m_value = reuse_output<Vector3Data>(m_value, m_slotOwned, Convertor::to_vector3(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -583,8 +623,8 @@ DataSP TransformToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if (auto inputData =std::dynamic_pointer_cast<TransformData>(data)){
-        m_value = std::make_shared<StringData>(inputData->value_as_text());
+    if (auto inputData =node_data_cast<TransformData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, inputData->value_as_text());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -601,8 +641,8 @@ DataSP StringToBoolConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringData>(data)){
-        m_value = std::make_shared<BoolData>(Convertor::to_bool(inputData->value()));
+    if(auto inputData =node_data_cast<StringData>(data)){
+        m_value = reuse_output<BoolData>(m_value, m_slotOwned, Convertor::to_bool(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -618,8 +658,8 @@ DataSP StringToIntegerConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData = std::dynamic_pointer_cast<StringData>(data)){
-        m_value = std::make_shared<IntData>(Convertor::to_int(inputData->value()));
+    if(auto inputData = node_data_cast<StringData>(data)){
+        m_value = reuse_output<IntData>(m_value, m_slotOwned, Convertor::to_int(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -635,8 +675,8 @@ DataSP StringToFloatConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringData>(data)){
-        m_value = std::make_shared<FloatData>(Convertor::to_float(inputData->value()));
+    if(auto inputData =node_data_cast<StringData>(data)){
+        m_value = reuse_output<FloatData>(m_value, m_slotOwned, Convertor::to_float(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -652,8 +692,8 @@ DataSP StringToRealConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringData>(data)){
-        m_value = std::make_shared<RealData>(Convertor::to_double(inputData->value()));
+    if(auto inputData =node_data_cast<StringData>(data)){
+        m_value = reuse_output<RealData>(m_value, m_slotOwned, Convertor::to_double(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -669,10 +709,10 @@ DataSP StringToDecimalConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringData>(data)){
+    if(auto inputData =node_data_cast<StringData>(data)){
         bool ok;
         auto value = inputData->value().toDouble(&ok);
-        m_value = std::make_shared<DecimalData>(Decimal{ok ? value : 0.});
+        m_value = reuse_output<DecimalData>(m_value, m_slotOwned, Decimal{ok ? value : 0.});
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -688,8 +728,8 @@ DataSP StringToStringListConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringData>(data)){
-        m_value = std::make_shared<StringListData>(QStringList() << inputData->value());
+    if(auto inputData =node_data_cast<StringData>(data)){
+        m_value = reuse_output<StringListData>(m_value, m_slotOwned, QStringList() << inputData->value());
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -705,8 +745,8 @@ DataSP StringToColorConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringData>(data)){
-        m_value = std::make_shared<ColorData>(Convertor::to_color(inputData->value()));
+    if(auto inputData =node_data_cast<StringData>(data)){
+        m_value = reuse_output<ColorData>(m_value, m_slotOwned, Convertor::to_color(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -723,8 +763,8 @@ DataSP StringListToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<StringListData>(data)){
-        m_value = std::make_shared<StringData>(Convertor::to_str(inputData->value(), " "));
+    if(auto inputData =node_data_cast<StringListData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, Convertor::to_str(inputData->value(), " "));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -741,8 +781,8 @@ DataSP KeyboardButtonEventToStringConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<KeyboardButtonEventData>(data)){
-        m_value = std::make_shared<StringData>(Convertor::to_str(inputData->value().code));
+    if(auto inputData =node_data_cast<KeyboardButtonEventData>(data)){
+        m_value = reuse_output<StringData>(m_value, m_slotOwned, Convertor::to_str(inputData->value().code));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -759,8 +799,8 @@ DataSP RealToRealListConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<RealData>(data)){
-        m_value = std::make_shared<RealListData>(Convertor::to_double_list(inputData->value()));
+    if(auto inputData =node_data_cast<RealData>(data)){
+        m_value = reuse_output<RealListData>(m_value, m_slotOwned, Convertor::to_double_list(inputData->value()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -776,8 +816,8 @@ DataSP FloatToRealListConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<FloatData>(data)){
-        m_value = std::make_shared<RealListData>(Convertor::to_double_list(Convertor::to_double(inputData->value())));
+    if(auto inputData =node_data_cast<FloatData>(data)){
+        m_value = reuse_output<RealListData>(m_value, m_slotOwned, Convertor::to_double_list(Convertor::to_double(inputData->value())));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -793,8 +833,8 @@ DataSP IntegerToRealListConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<IntData>(data)){
-        m_value = std::make_shared<RealListData>(Convertor::to_double_list(Convertor::to_double(inputData->value())));
+    if(auto inputData =node_data_cast<IntData>(data)){
+        m_value = reuse_output<RealListData>(m_value, m_slotOwned, Convertor::to_double_list(Convertor::to_double(inputData->value())));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
@@ -810,8 +850,8 @@ DataSP DecimalToRealListConverter::operator()(DataSP data){
         return m_value = v;;
     }
 
-    if(auto inputData =std::dynamic_pointer_cast<DecimalData>(data)){
-        m_value = std::make_shared<RealListData>(Convertor::to_double_list(inputData->value().to_double()));
+    if(auto inputData =node_data_cast<DecimalData>(data)){
+        m_value = reuse_output<RealListData>(m_value, m_slotOwned, Convertor::to_double_list(inputData->value().to_double()));
         propagate_runtime(inputData, m_value);
     }else{
         m_value.reset();
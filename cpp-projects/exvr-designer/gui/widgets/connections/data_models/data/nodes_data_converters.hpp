@@ -24,6 +24,10 @@
 
 #pragma once
 
+// std
+#include <array>
+#include <optional>
+
 // nodes
 #include "nodes/NodeDataModel.hpp"
 #include "nodes/DataModelRegistry.hpp"
@@ -43,8 +47,11 @@ using DataSP = std::shared_ptr<QtNodes::NodeData>;
 struct BaseConverter{
     virtual ~BaseConverter(){}
     virtual DataSP operator()(DataSP data) = 0;
+    // output owned by a single plan slot, only delivered to its receiver port
+    void preallocate(DataSP value){m_value = std::move(value); m_slotOwned = true;}
 protected:
     DataSP m_value;
+    bool m_slotOwned = false;
 };
 
 // void
@@ -142,5 +149,30 @@ struct KeyboardButtonEventToStringConverter : public BaseConverter{DataSP operat
 // id any
 // ...
 
+// converters indexed by input/output ConnectionNode::Type, filled with the QtNodes registry
+// each compiled connection of a ConnectionsGraphPlan instantiates its own converter with a preallocated output value
+class ConvertersTable{
+
+public:
+
+    using Generator = std::unique_ptr<BaseConverter>(*)();
+
+    template<class C, class Out>
+    static auto add(ConnectionNode::Type in) -> void{
+        m_generators[static_cast<size_t>(in)][static_cast<size_t>(Out::data_type)] = []() -> std::unique_ptr<BaseConverter>{
+            auto converter = std::make_unique<C>();
+            converter->preallocate(std::make_shared<Out>());
+            return converter;
+        };
+    }
+
+    static auto generate(ConnectionNode::Type in, ConnectionNode::Type out) -> std::unique_ptr<BaseConverter>;
+    static auto type(const QString &id) -> std::optional<ConnectionNode::Type>;
+
+private:
+
+    static constexpr size_t TypesCount = static_cast<size_t>(ConnectionNode::Type::SizeEnum);
+    static inline std::array<std::array<Generator, TypesCount>, TypesCount> m_generators = {};
+};
 
 }
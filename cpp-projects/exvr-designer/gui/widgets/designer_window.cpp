@@ -47,6 +47,7 @@
 // local
 #include "designer_window.hpp"
 #include "utility/path_utility.hpp"
+#include "utility/profiling_trace.hpp"
 #include "connections/data_models/all_node_data_models.hpp"
 #include "connections/data_models/connectors/connector_node_data_model.hpp"
 #include "experiment/global_signals.hpp"
@@ -150,61 +151,71 @@ void DesignerWindow::close_program(){
     blockSignals(false);
 }
 
-void DesignerWindow::update_from_experiment(Experiment *experiment, int update){
+void DesignerWindow::update_from_experiment(Experiment *experiment, int update, const ChangeJournal &journal){
 
     bool display = false;
     if(update & ResetUI){
         QtLogger::log(QSL("Start [Reset ui]"));
-        Bench::start("[Reset ui]"sv, display);
-        QtLogger::log(QSL("Reset components widgets."));
-        m_componentsW->reset();
-        QtLogger::log(QSL("Reset rouitines widgets."));
-        m_routinesW->reset();
-        QtLogger::log(QSL("Reset flow diagram widget."));
-        m_flowDiagramW->reset();
-        QtLogger::log(QSL("Reset element viewer widget."));
-        m_elementViewerW->reset();
-        Bench::stop();
+        {
+            ProfileGuard p("[Reset ui]"sv, display);
+            QtLogger::log(QSL("Reset components widgets."));
+            m_componentsW->reset();
+            QtLogger::log(QSL("Reset rouitines widgets."));
+            m_routinesW->reset();
+            QtLogger::log(QSL("Reset flow diagram widget."));
+            m_flowDiagramW->reset();
+            QtLogger::log(QSL("Reset element viewer widget."));
+            m_elementViewerW->reset();
+        }
         QtLogger::log(QSL("End [Reset ui]"));
     }
 
     if(update & UpdateComponents){ // update experiment components
         QtLogger::log(QSL("Start [update experiment components]"));
-        Bench::start("[Update components]"sv, display);
-        m_componentsW->update_from_components_manager(&experiment->compM);
-        Bench::stop();
+        if(journal.components_patchable()){
+            ProfileGuard p("[Update components (patch)]"sv, display);
+            m_componentsW->update_from_journal(&experiment->compM, journal);
+        }else{
+            ProfileGuard p("[Update components (full)]"sv, display);
+            m_componentsW->update_from_components_manager(&experiment->compM);
+        }
         QtLogger::log(QSL("End [update experiment components]"));
     }
 
     if(update & UpdateFlow){ // update flow
         QtLogger::log(QSL("Start [update flow]"));
-        Bench::start("[Update flow]"sv, display);
-        m_flowDiagramW->update_from_experiment(experiment);
-        Bench::stop();
+        {
+            ProfileGuard p("[Update flow]"sv, display);
+            m_flowDiagramW->update_from_experiment(experiment);
+        }
         QtLogger::log(QSL("End [update flow]"));
     }
 
     if(update & UpdateSelection){ // update selected element
         QtLogger::log(QSL("Start [update selected element]"));
-        Bench::start("[Update selected element]"sv, display);
-        m_elementViewerW->update_from_current_element(experiment->selectedElement);
-        Bench::stop();
+        {
+            ProfileGuard p("[Update selected element]"sv, display);
+            m_elementViewerW->update_from_current_element(experiment->selectedElement);
+        }
         QtLogger::log(QSL("End [update selected element]"));
     }
 
     if(update & UpdateRoutines){ // update routines
         QtLogger::log(QSL("Start [update routines]"));
-        Bench::start("[Update routines]"sv, display);
-        m_routinesW->update_from_experiment(experiment);
-        Bench::stop();
+        if(journal.routines_patchable()){
+            ProfileGuard p("[Update routines (patch)]"sv, display);
+            m_routinesW->update_from_journal(experiment, journal);
+        }else{
+            ProfileGuard p("[Update routines (full)]"sv, display);
+            m_routinesW->update_from_experiment(experiment);
+        }
         QtLogger::log(QSL("End [update routines]"));
     }
 
     if(update & UpdateUI){
         // QtLogger::log(QSL("Start [update ui]"));
-        Bench::start("[Update main ui]"sv, false);
+        ProfileGuard p("[Update main ui]"sv, false);
         update_main_ui(experiment);
-        Bench::stop();
         // QtLogger::log(QSL("End [update ui]"));
     }
 
@@ -75,7 +75,7 @@ public:
 public slots:
 
     // update
-    void update_from_experiment(Experiment *experiment, int update);
+    void update_from_experiment(Experiment *experiment, int update, const ChangeJournal &journal);
 
     // logs    
     // # ui
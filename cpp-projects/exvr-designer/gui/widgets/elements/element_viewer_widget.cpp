@@ -260,6 +260,13 @@ void ElementViewerW::init_loop_ui(){
     connect(ui->cbNoFollowingValues, &QCheckBox::clicked, this, [&](bool checked){
         emit GSignals::get()->modify_loop_no_following_value_signal(m_currentElementId, checked);
     });
+    // constraints
+    connect(ui->sbMaxRepeats, QOverload<int>::of(&QSpinBox::valueChanged), this, [&](int value){
+        emit GSignals::get()->modify_loop_constraints_signal(m_currentElementId, value, m_loopUI->sbMinDistance->value());
+    });
+    connect(ui->sbMinDistance, QOverload<int>::of(&QSpinBox::valueChanged), this, [&](int value){
+        emit GSignals::get()->modify_loop_constraints_signal(m_currentElementId, m_loopUI->sbMaxRepeats->value(), value);
+    });
 
     // style
     connect(ui->cbLoopStyle,QOverload<int>::of( &QComboBox::currentIndexChanged),[=](int index){
@@ -477,6 +484,16 @@ void ElementViewerW::update_loop_ui(Loop *loop){
     ui->sbN->setValue(loop->N);
     ui->sbN->blockSignals(false);
 
+    const bool constrained = loop->mode == Loop::Mode::ConstrainedShuffle;
+    ui->sbMaxRepeats->setEnabled(constrained);
+    ui->sbMaxRepeats->blockSignals(true);
+    ui->sbMaxRepeats->setValue(loop->maxRepeats);
+    ui->sbMaxRepeats->blockSignals(false);
+    ui->sbMinDistance->setEnabled(constrained);
+    ui->sbMinDistance->blockSignals(true);
+    ui->sbMinDistance->setValue(loop->minDistance);
+    ui->sbMinDistance->blockSignals(false);
+
     // comboboxes
     ui->cbLoopStyle->blockSignals(true);
     ui->cbLoopStyle->setCurrentIndex(static_cast<int>(loop->mode));    
@@ -52,7 +52,7 @@ FlowDiagramW::FlowDiagramW(QSlider *zoomSlider, QPushButton *resizeButton){
     });
     connect(zoomSlider, &QSlider::valueChanged, this, [&](int value){
         m_zoomLevel = 0.1*value;
-        update();
+        invalidate_layout(true);
     });
 }
 
@@ -185,12 +185,42 @@ void FlowDiagramW::update_from_experiment(Experiment *exp){
 
     m_flowSequence.update_from_experiment(exp);
     m_maximumDeepLevel = exp->states.maximumDeepLevel;
+
+    // positions and spatial index are rebuilt now, mouse events can happen before the next paint
+    update_layout();
     update();
 }
 
 void FlowDiagramW::reset(){
     m_flowSequence.reset();
     m_maximumDeepLevel = 0;
+    m_layoutDirty = true;
+}
+
+void FlowDiagramW::invalidate_layout(bool textMetrics){
+    m_layoutDirty = true;
+    m_textMetricsDirty |= textMetrics;
+    update();
+}
+
+void FlowDiagramW::update_layout(){
+
+    // define font and metrics
+    if(m_textMetricsDirty){
+        m_font.setPointSizeF(FlowElementO::sizeTxt*m_zoomLevel);
+        FlowElementO::invalidate_text_metrics();
+        m_textMetricsDirty = false;
+    }
+
+    // compute elements sizes and positions
+    const QSizeF allElementsAreaSize = m_flowSequence.compute_layout(QFontMetrics(m_font), m_zoomLevel, m_maximumDeepLevel);
+    m_layoutDirty = false;
+
+    // define widget size
+    const QSize newMinimumSize(static_cast<int>(allElementsAreaSize.width()),static_cast<int>(allElementsAreaSize.height()));
+    if(newMinimumSize != minimumSize()){
+        setMinimumSize(newMinimumSize);
+    }
 }
 
 void FlowDiagramW::resizeEvent(QResizeEvent *event){
@@ -199,63 +229,27 @@ void FlowDiagramW::resizeEvent(QResizeEvent *event){
 
 void FlowDiagramW::paintEvent(QPaintEvent *event){
 
-    Q_UNUSED(event)
+    if(m_layoutDirty){
+        update_layout();
+    }
 
     // setup rendering
     QPainter painter(this);
+    const QRectF exposedRect = event->rect();
 
-    painter.fillRect(geometry(),Qt::lightGray);
+    painter.fillRect(event->rect(),Qt::lightGray);
     painter.setRenderHint(QPainter::Antialiasing);
-
-    // define font and metrics
-    QFont font;
-    font.setPointSizeF(FlowElementO::sizeTxt*m_zoomLevel);
-    QFontMetrics fm(font);
-    painter.setFont(font);
-
-    // compute elements sizes
-    FlowElementO::define_area_height(fm.boundingRect("O").height()*2.5);
-    // # elements
-    for(auto& element : m_flowSequence.elements){
-        element->adapt_size_from_name(fm);
-    }
-    // # loops
-    for(auto& loop : m_flowSequence.loopsElements){
-        loop->adapt_size_from_name(fm);
-    }
-
-    // area sizes
-    qreal allElementsWidth = 0.;
-    for(const auto& element : m_flowSequence.elements){
-        allElementsWidth += element->uiAreaRect.width();
-    }
-
-    // compute starting and ending point
-    const QPointF startMainLine(20*m_zoomLevel, (m_maximumDeepLevel+1)*FlowElementO::areaHeight + FlowElementO::areaHeight*0.5);
-    const QPointF endMainLine(allElementsWidth+2*startMainLine.x(), (m_maximumDeepLevel+1)*FlowElementO::areaHeight + FlowElementO::areaHeight*0.5);
-    const QSizeF allElementsAreaSize(endMainLine.x(), endMainLine.y() + (m_maximumDeepLevel+1)*FlowElementO::areaHeight + 2*FlowElementO::areaHeight);
-
-    // define widget size
-    setMinimumSize(static_cast<int>(allElementsAreaSize.width()),static_cast<int>(allElementsAreaSize.height()));
+    painter.setFont(m_font);
 
     // draw main line
     QPen linePen;
     linePen.setColor(Qt::black);
     linePen.setWidthF(m_zoomLevel*1.5);
     painter.setPen(linePen);
-    draw_arrow_line(painter, QLineF(startMainLine,endMainLine),m_zoomLevel);
-
-    // compute elements positions
-    qreal xoffset = startMainLine.x();   
-    for(auto& element : m_flowSequence.elements){
-        QPointF topLeft(xoffset, (1+m_maximumDeepLevel)*FlowElementO::areaHeight);
-        element->compute_position(topLeft, 1+m_maximumDeepLevel);
-        xoffset += element->uiAreaRect.width();
-    }
-
-    // draw sequence
-    m_flowSequence.draw(painter, m_zoomLevel);
+    draw_arrow_line(painter, QLineF(m_flowSequence.startMainLine, m_flowSequence.endMainLine),m_zoomLevel);
 
+    // draw visible part of the sequence
+    m_flowSequence.draw(painter, m_zoomLevel, exposedRect);
 }
 
 void FlowDiagramW::auto_resize(){ // TODO: to improve
@@ -271,22 +265,22 @@ void FlowDiagramW::auto_resize(){ // TODO: to improve
         m_zoomLevel = m_maxZoomLevel;
     }
     m_zoomLevel*=0.9;
-    update();
+    invalidate_layout(true);
 }
 
 void FlowDiagramW::zoom(int value){
     m_zoomLevel = 0.1*value;
-    update();
+    invalidate_layout(true);
 }
 
 void FlowDiagramW::update_stretch(qreal stretch){
     FlowElementO::define_stretch(stretch);
-    update();
+    invalidate_layout(false);
 }
 
 void FlowDiagramW::update_size_text(qreal sizeTxt){
     FlowElementO::sizeTxt = sizeTxt;
-    update();
+    invalidate_layout(true);
 }
 
 void FlowDiagramW::draw_arrow_line(QPainter &painter, const QLineF &line, qreal zoomLevel){
@@ -88,6 +88,12 @@ protected:
 private:
 
     void generate_signals();
+    void invalidate_layout(bool textMetrics);
+    void update_layout();
+
+    bool m_layoutDirty = true;
+    bool m_textMetricsDirty = true;
+    QFont m_font;
 
     qreal m_zoomLevel = 3.0;
     const qreal m_minZoomLevel = 0.5;
@@ -68,12 +68,12 @@ ActionW::ActionW(ElementKey routineKey, ConditionKey conditionKey, Action *actio
     // generate widgets
     auto opt = Component::get_timeline_opt(action->component->type);
     if(opt == Component::TimelineO::Update || opt == Component::TimelineO::Both){
-        m_timelineUpdateW = new TimelineW(routine_key(), condition_key(), action_key(), action->timelineUpdate.get(), opt == Component::TimelineO::Update, true);
+        m_timelineUpdateW = new TimelineW(routine_key(), condition_key(), action_key(), &action->timelineUpdate.get(), opt == Component::TimelineO::Update, true);
         m_ui.vlTimeline->addWidget(m_timelineUpdateW);
     }    
 
     if(opt == Component::TimelineO::Visibility || opt == Component::TimelineO::Both){
-        m_timelineVisibilityW = new TimelineW(routine_key(), condition_key(), action_key(), action->timelineVisibility.get(), true, false);
+        m_timelineVisibilityW = new TimelineW(routine_key(), condition_key(), action_key(), &action->timelineVisibility.get(), true, false);
         m_ui.vlTimeline->addWidget(m_timelineVisibilityW);
     }
 
@@ -204,10 +204,10 @@ void ActionW::update_from_action(int id, Action *action, qreal scale, qreal fact
     // update timelines
     auto opt = Component::get_timeline_opt(action->component->type);
     if(opt == Component::TimelineO::Update || opt == Component::TimelineO::Both){
-        m_timelineUpdateW->update_from_timeline(action->timelineUpdate.get(), scale, factorSize, max);
+        m_timelineUpdateW->update_from_timeline(&action->timelineUpdate.get(), scale, factorSize, max);
     }
     if(opt == Component::TimelineO::Visibility || opt == Component::TimelineO::Both){
-        m_timelineVisibilityW->update_from_timeline(action->timelineVisibility.get(), scale, factorSize, max);
+        m_timelineVisibilityW->update_from_timeline(&action->timelineVisibility.get(), scale, factorSize, max);
     }
 
 }
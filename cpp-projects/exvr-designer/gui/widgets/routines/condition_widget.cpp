@@ -207,55 +207,112 @@ void ConditionW::update_from_condition(GUI *gui, Condition *condition){
         }
         dsbDuration->setSingleStep(dsbScale->value());
 
-        // # remove inused actions
-        std::map<int,bool> mask;
-        for(int ii = m_actionsListW.count()-1; ii >= 0; --ii){
+        update_actions_list(condition);
 
-            bool found = false;
-            auto actionW = qobject_cast<ActionW*>(m_actionsListW.widget_at(ii));
-            for(const auto &action : condition->actions){
-                if(action->key() == actionW->action_key().v){
-                    found = true;
-                    break;
-                }
+    Bench::stop();
+    Bench::start("ConditionW update_from_condition 3"sv, display);
+
+        // update actions
+        update_actions(condition, nullptr);
+
+        update_ui_from_current_tab(m_ui.tabCondition->currentIndex());
+        Bench::stop();
+
+    m_isUpdating = false;
+}
+
+void ConditionW::update_from_journal(GUI *gui, Condition *condition, const ChangeJournal &journal){
+
+    if(auto conditionsChanges = journal.conditions_changes(m_routineKey.v); conditionsChanges != nullptr){
+        if(auto it = conditionsChanges->find(m_conditionKey.v); it != conditionsChanges->end()){
+            if(it->second & ChangeModified){
+                // duration, scale or whole actions list changed
+                update_from_condition(gui, condition);
+                return;
             }
-            mask[actionW->action_key().v] = found;
-            if(!found){
-                delete m_actionsListW.remove_at(ii);
+        }
+    }
+
+    m_isUpdating = true;
+
+    // connections
+    if(journal.connections_changes(m_routineKey.v, m_conditionKey.v)){
+        m_connectionsW->update_from_condition(condition);
+    }
+
+    // actions
+    if(auto actionsChanges = journal.actions_changes(m_routineKey.v, m_conditionKey.v); actionsChanges != nullptr){
+
+        bool structureChanged = false;
+        for(const auto &actionChange : *actionsChanges){
+            if(actionChange.second & ChangeStructure){
+                structureChanged = true;
+                break;
             }
         }
 
-        // # add new actions
+        if(structureChanged){
+            update_actions_list(condition);
+            update_actions(condition, nullptr);
+        }else{
+            update_actions(condition, actionsChanges);
+        }
+    }
+
+    m_isUpdating = false;
+}
+
+void ConditionW::update_actions_list(Condition *condition){
+
+    // # remove inused actions
+    std::map<int,bool> mask;
+    for(int ii = m_actionsListW.count()-1; ii >= 0; --ii){
+
+        bool found = false;
+        auto actionW = qobject_cast<ActionW*>(m_actionsListW.widget_at(ii));
         for(const auto &action : condition->actions){
-            if(!mask[action->key()]){
-                m_actionsListW.add_widget(new ActionW(routine_key(), condition_key(), action.get()));
+            if(action->key() == actionW->action_key().v){
+                found = true;
+                break;
             }
         }
+        mask[actionW->action_key().v] = found;
+        if(!found){
+            delete m_actionsListW.remove_at(ii);
+        }
+    }
+
+    // # add new actions
+    for(const auto &action : condition->actions){
+        if(!mask[action->key()]){
+            m_actionsListW.add_widget(new ActionW(routine_key(), condition_key(), action.get()));
+        }
+    }
 
-        // reorder
-        for(int ii = 0; ii < to_int(condition->actions.size()); ++ii){
-            for(int jj = 0; jj < to_int(m_actionsListW.count()); ++jj){
-                if(qobject_cast<ActionW*>(m_actionsListW.widget_at(jj))->action_key().v == condition->actions[to_size_t(ii)]->key()){
-                    if(ii != jj){
-                        m_actionsListW.move_from_to(jj,ii);
-                    }
-                    break;
+    // reorder
+    for(int ii = 0; ii < to_int(condition->actions.size()); ++ii){
+        for(int jj = 0; jj < to_int(m_actionsListW.count()); ++jj){
+            if(qobject_cast<ActionW*>(m_actionsListW.widget_at(jj))->action_key().v == condition->actions[to_size_t(ii)]->key()){
+                if(ii != jj){
+                    m_actionsListW.move_from_to(jj,ii);
                 }
+                break;
             }
         }
+    }
+}
 
-    Bench::stop();
-    Bench::start("ConditionW update_from_condition 3"sv, display);
+void ConditionW::update_actions(Condition *condition, const umap<int,int> *actionsToUpdate){
 
-        // update actions
-        for(int ii = 0; ii< m_actionsListW.count(); ++ii){
-            qobject_cast<ActionW*>(m_actionsListW.widget_at(ii))->update_from_action(ii, condition->actions[to_size_t(ii)].get(), condition->scale, condition->uiFactorSize, condition->duration);
+    for(int ii = 0; ii< m_actionsListW.count(); ++ii){
+        auto actionW = qobject_cast<ActionW*>(m_actionsListW.widget_at(ii));
+        if(actionsToUpdate != nullptr){
+            if(!actionsToUpdate->contains(actionW->action_key().v)){
+                continue;
+            }
         }
-
-        update_ui_from_current_tab(m_ui.tabCondition->currentIndex());
-        Bench::stop();
-
-    m_isUpdating = false;
+        actionW->update_from_action(ii, condition->actions[to_size_t(ii)].get(), condition->scale, condition->uiFactorSize, condition->duration);
+    }
 }
 
 void ConditionW::update_from_connector_info(ConnectorKey connectorKey, QStringView id, QStringView value){
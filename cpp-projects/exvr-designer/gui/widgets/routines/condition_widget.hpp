@@ -46,6 +46,8 @@
 // # data
 #include "data/condition.hpp"
 #include "data/gui.hpp"
+// # experiment
+#include "experiment/change_journal.hpp"
 
 namespace tool::ex {
 
@@ -78,6 +80,7 @@ public :
 
     ConditionW(ElementKey routineKey, Condition *condition);
     void update_from_condition(GUI *gui, Condition *condition);
+    void update_from_journal(GUI *gui, Condition *condition, const ChangeJournal &journal);
     void update_from_connector_info(ConnectorKey connectorKey, QStringView id, QStringView value);
 
     // connections
@@ -104,6 +107,9 @@ public slots:
 
 private:
 
+    void update_actions_list(Condition *condition);
+    void update_actions(Condition *condition, const umap<int,int> *actionsToUpdate);
+
     ElementKey m_routineKey;
     ConditionKey m_conditionKey;
 
@@ -178,6 +178,34 @@ void RoutineTabW::update_from_routine(GUI *gui, Routine *routine){
     Bench::stop();
 }
 
+void RoutineTabW::update_from_journal(GUI *gui, Routine *routine, const ChangeJournal &journal){
+
+    if(routine->isARandomizer){
+        return;
+    }
+
+    auto conditionsChanges = journal.conditions_changes(routine->key());
+    if(conditionsChanges == nullptr){
+        return;
+    }
+
+    // conditions list is unchanged, only patch modified conditions
+    for(int ii = 0; ii < count(); ++ii){
+        auto condition = routine->conditions[to_size_t(ii)].get();
+        if(!conditionsChanges->contains(condition->key())){
+            continue;
+        }
+
+        QString txt = condition->name % QSL(" (") %  QString::number(condition->actions.size()) % QSL("/") % QString::number(condition->connectors.size()) % QSL(")");
+        if(tabText(ii) != txt){
+            setTabText(ii, std::move(txt));
+        }
+        if(ii == currentIndex()){
+            qobject_cast<ConditionW*>(widget(ii))->update_from_journal(gui, condition, journal);
+        }
+    }
+}
+
 void RoutineTabW::update_from_connector_info(ConditionKey conditionKey, ConnectorKey connectorKey, QStringView id, QStringView value){
 
     for(int ii = 0; ii < count(); ++ii){
@@ -46,6 +46,7 @@ public:
     void close_all_windows();
 
     void update_from_routine(GUI *gui, Routine *routine);
+    void update_from_journal(GUI *gui, Routine *routine, const ChangeJournal &journal);
     void update_from_connector_info(ConditionKey conditionKey, ConnectorKey connectorKey, QStringView id, QStringView value);
 
     ConditionW *condition_widget(RowId tabId);
@@ -191,6 +191,26 @@ void RoutinesManagerTW::update_from_experiment(Experiment *exp){
     Bench::stop();
 }
 
+void RoutinesManagerTW::update_from_journal(Experiment *exp, const ChangeJournal &journal){
+
+    BlockSignalsGuard guard;
+
+    // routines list is unchanged, only the displayed routine is updated
+    int lastRoutineKey = exp->lastRoutineSelected != nullptr ? exp->lastRoutineSelected->key() : -1;
+    for(int idTab = 0; idTab < count(); ++idTab){
+        auto routineW = routine_widget(RowId{idTab});
+        if(journal.conditions_changes(routineW->routine_key().v) == nullptr){
+            continue;
+        }
+
+        if(auto routine = exp->get_element_from_type_and_id<Routine>(routineW->routine_key()); routine != nullptr){
+            if((routine->is_selected()) || (lastRoutineKey == routine->key())){
+                routineW->update_from_journal(exp->gui(), routine, journal);
+            }
+        }
+    }
+}
+
 RoutineTabW *RoutinesManagerTW::routine_widget(RowId tabId){
     return qobject_cast<RoutineTabW*>(widget(tabId.v));
 }
@@ -57,6 +57,7 @@ public :
 public slots:
 
     void update_from_experiment(Experiment *exp);
+    void update_from_journal(Experiment *exp, const ChangeJournal &journal);
     void reset();
     void update_connector_dialog_with_info(ElementKey elementKey, ConditionKey conditionKey, ConnectorKey connectorKey, QStringView id, QStringView value);
 };
@@ -30,7 +30,7 @@
 using namespace tool;
 using namespace tool::ex;
 
-TimelineW::TimelineW(ElementKey routineKey, ConditionKey conditionKey, ActionKey actionKey, Timeline *timeline, bool drawAxe, bool updateTimeline) :
+TimelineW::TimelineW(ElementKey routineKey, ConditionKey conditionKey, ActionKey actionKey, const Timeline *timeline, bool drawAxe, bool updateTimeline) :
       type(timeline->type), m_routineKey(routineKey), m_conditionKey(conditionKey), m_actionKey(actionKey), m_drawAxe(drawAxe), m_updateTimeline(updateTimeline){
 
     setMouseTracking(true);
@@ -57,7 +57,7 @@ Interval TimelineW::rect_to_interval(const QRectF &r) const{
     };
 }
 
-void TimelineW::update_from_timeline(Timeline *timeline, qreal scale, qreal factorSize, SecondsTS max){
+void TimelineW::update_from_timeline(const Timeline *timeline, qreal scale, qreal factorSize, SecondsTS max){
 
     m_scale      = scale;
     m_factorSize = factorSize;
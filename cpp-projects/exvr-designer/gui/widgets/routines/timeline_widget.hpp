@@ -43,12 +43,12 @@ namespace tool::ex{
 class TimelineW : public QWidget{
 public :
 
-    TimelineW(ElementKey routineKey, ConditionKey conditionKey, ActionKey actionKey, Timeline *timeline, bool drawAxe, bool updateTimeline);
+    TimelineW(ElementKey routineKey, ConditionKey conditionKey, ActionKey actionKey, const Timeline *timeline, bool drawAxe, bool updateTimeline);
 
     QRectF interval_to_rect(const Interval &i)const;
     Interval rect_to_interval(const QRectF &r) const;
 
-    void update_from_timeline(Timeline *timeline, qreal m_scale, qreal m_factorSize, SecondsTS max);
+    void update_from_timeline(const Timeline *timeline, qreal m_scale, qreal m_factorSize, SecondsTS max);
 
     constexpr ElementKey routine_key() const noexcept{return m_routineKey;}
     constexpr ConditionKey condition_key() const noexcept{return m_conditionKey;}
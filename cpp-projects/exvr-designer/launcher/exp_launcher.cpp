@@ -25,6 +25,8 @@
 #include "exp_launcher.hpp"
 
 // std
+#include <algorithm>
+#include <chrono>
 #include <optional>
 
 // qt-utility
@@ -32,6 +34,7 @@
 
 // local
 #include "experiment/global_signals.hpp"
+#include "utility/profiling_trace.hpp"
 
 using namespace tool::ex;
 
@@ -98,19 +101,63 @@ QString ExpLauncher::gen_command(QStringList messages){
     return StartCmd % messages.join(Sep) % EndCmd;
 }
 
-void ExpLauncher::message_from_exp_launcher(QString m){
+void ExpLauncher::message_from_exp_launcher(QByteArray m){
 
     if(m.length() == 0){
         return;
     }
 
-    if(messagesReceived.size() > 2000){
-        messagesReceived.erase(messagesReceived.begin(), messagesReceived.begin() + 1000);
+    // decode into the receive buffer, its capacity is kept between messages
+    m_receiveBuffer.resize(m.size()); // utf16 length <= utf8 bytes count
+    QChar *end = m_utf8Decoder.appendToBuffer(m_receiveBuffer.data(), m);
+    m_receiveBuffer.resize(static_cast<int>(end - m_receiveBuffer.data()));
+
+    receive_message(m_receiveBuffer, m.size());
+}
+
+void ExpLauncher::output_from_exp_launcher(QString message){
+
+    if(message.length() == 0){
+        return;
     }
 
-    messagesReceived.emplace_back(std::move(m));
-    QStringView message = messagesReceived[messagesReceived.size()-1];
+    // already decoded by the process
+    receive_message(message, message.size() * static_cast<qint64>(sizeof(QChar)));
+}
+
+auto ExpLauncher::fill_info_slot(QStringView key, QStringView value) -> const std::pair<QString,QString>&{
+
+    auto assign = [](QString &str, QStringView view){
+        str.resize(view.size()); // detaches only if the GUI thread still shares the previous value
+        std::copy(view.begin(), view.end(), str.data());
+    };
+
+    auto &slot = m_infoSlots[m_nextInfoSlot];
+    m_nextInfoSlot = (m_nextInfoSlot + 1) % InfoSlotsCount;
+    assign(slot.first,  key);
+    assign(slot.second, value);
+    return slot;
+}
+
+void ExpLauncher::receive_message(QStringView message, qint64 bytesCount){
+
+    TraceGuard t("[IPC receive]"sv);
+    const auto startParsing = std::chrono::steady_clock::now();
+
+    parse_message(message);
+
+    const auto parseTimeUs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startParsing).count()
+    );
+    m_receiveCounters.bytes          += static_cast<std::uint64_t>(bytesCount);
+    m_receiveCounters.messages       += 1;
+    m_receiveCounters.parseTimeUs    += parseTimeUs;
+    if(parseTimeUs > m_receiveCounters.maxParseTimeUs){
+        m_receiveCounters.maxParseTimeUs = parseTimeUs;
+    }
+}
 
+void ExpLauncher::parse_message(QStringView message){
 
     while(message.length() > 0){
         if(auto balise = extract_balise(message); balise.has_value()){
@@ -147,7 +194,8 @@ void ExpLauncher::message_from_exp_launcher(QString m){
                 QStringView infoKey   = info.left(idSep);
                 QStringView infoValue = info.mid(idSep+1);
 
-                emit GSignals::get()->component_info_update_signal(ComponentKey{componentKey}, ConfigKey{configKey}, infoKey, infoValue);
+                const auto &slot = fill_info_slot(infoKey, infoValue);
+                emit GSignals::get()->component_info_update_signal(ComponentKey{componentKey}, ConfigKey{configKey}, slot.first, slot.second);
                 continue;
             }
 
@@ -182,7 +230,8 @@ void ExpLauncher::message_from_exp_launcher(QString m){
                 QStringView infoKey   = info.left(idSep);
                 QStringView infoValue = info.mid(idSep+1);
 
-                emit GSignals::get()->connector_info_update_signal(ElementKey{elementKey}, ConditionKey{conditionKey}, ConnectorKey{connectorKey}, infoKey, infoValue);
+                const auto &slot = fill_info_slot(infoKey, infoValue);
+                emit GSignals::get()->connector_info_update_signal(ElementKey{elementKey}, ConditionKey{conditionKey}, ConnectorKey{connectorKey}, slot.first, slot.second);
                 continue;
             }
 
@@ -197,7 +246,7 @@ void ExpLauncher::message_from_exp_launcher(QString m){
                     int idSep = expState.indexOf('|');
                     auto state = static_cast<ExpState>(expState.left(idSep).toInt());
                     QStringView infos = expState.mid(idSep+1);
-                    emit GSignals::get()->exp_state_updated_signal(state, infos);
+                    emit GSignals::get()->exp_state_updated_signal(state, infos.toString());
                 }else{
                     QtLogger::error(QSL("Invalid experiment state info from exp-launcher: ") % expState, true, true);
                 }
@@ -243,7 +292,7 @@ void ExpLauncher::message_from_exp_launcher(QString m){
                             QtLogger::message("ExVR-exp started");
                         }
                     }
-                    emit GSignals::get()->exp_launcher_state_updated_signal(state, infos);
+                    emit GSignals::get()->exp_launcher_state_updated_signal(state, infos.toString());
 
                 }else{
                     QtLogger::error(QSL("Invalid experiment launcher state info from exp-launcher: ") % expLState, true, true);
@@ -276,7 +325,7 @@ void ExpLauncher::start_program(Settings settings){
 
     m_expLauncherProcess = std::make_unique<ExpLauncherProcess>();
     m_expLauncherProcess->start_program( Paths::expLauncherExe, settings, m_expLauncherCommunication->readingPort);
-    connect(m_expLauncherProcess.get(), &ExpLauncherProcess::standard_output_signal, this, &ExpLauncher::message_from_exp_launcher);
+    connect(m_expLauncherProcess.get(), &ExpLauncherProcess::standard_output_signal, this, &ExpLauncher::output_from_exp_launcher);
     connect(m_expLauncherProcess.get(), &ExpLauncherProcess::error_output_signal, this, &ExpLauncher::error_message_from_exp_launcher);
     connect(m_expLauncherProcess.get(), QOverload<int, ExpLauncherProcess::ExitStatus>::of(&ExpLauncherProcess::finished),
           [=](int exitCode, ExpLauncherProcess::ExitStatus exitStatus){ /* ... */
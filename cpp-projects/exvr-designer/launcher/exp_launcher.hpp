@@ -25,6 +25,8 @@
 #pragma once
 
 // std
+#include <array>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string_view>
@@ -32,6 +34,7 @@
 
 // Qt
 #include <QTimer>
+#include <QStringDecoder>
 
 // base
 #include "utility/tuple_array.hpp"
@@ -51,10 +54,21 @@ using namespace std::literals::string_view_literals;
 class ExpLauncher;
 using ExpLauncherUP = std::unique_ptr<ExpLauncher>;
 
+struct ExpLauncherReceiveCounters{
+    std::atomic<std::uint64_t> bytes = 0;
+    std::atomic<std::uint64_t> messages = 0;
+    std::atomic<std::uint64_t> parseTimeUs = 0;
+    std::atomic<std::uint64_t> maxParseTimeUs = 0;
+};
+
 class ExpLauncher : public QObject{
 
     Q_OBJECT
 
+public:
+
+    inline const ExpLauncherReceiveCounters &receive_counters() const noexcept{return m_receiveCounters;}
+
 public slots:
 
     void stop_communications();
@@ -85,7 +99,8 @@ public slots:
 
 private slots :
 
-    void message_from_exp_launcher(QString message);
+    void message_from_exp_launcher(QByteArray message);
+    void output_from_exp_launcher(QString message);
     void error_message_from_exp_launcher(QStringView error);
 
     auto close_exp_launcher_process() -> void;
@@ -96,6 +111,9 @@ signals:
 
 private :
 
+    void receive_message(QStringView message, qint64 bytesCount);
+    void parse_message(QStringView message);
+    auto fill_info_slot(QStringView key, QStringView value) -> const std::pair<QString,QString>&;
     std::optional<QStringView> extract_balise(QStringView &message);
     std::optional<QStringView> extract_balise_message(QStringView balise, QStringView start, QStringView end);
 
@@ -133,7 +151,14 @@ private :
     std::unique_ptr<ExpLauncherProcess> m_expLauncherProcess = nullptr;
     std::unique_ptr<ExpLauncherCommunication> m_expLauncherCommunication = nullptr;
 
-    // message from launcher
-    std::vector<QString> messagesReceived;
+    // messages from launcher, decoded into a reused buffer and parsed in place
+    QString m_receiveBuffer;
+    QStringDecoder m_utf8Decoder = QStringDecoder(QStringDecoder::Utf8);
+    // infos key/value are copied into a ring of slots keeping their capacity, the GUI thread receives implicitly shared
+    // copies of them, a slot only allocates again if its previous strings are still referenced when the ring wraps
+    static constexpr size_t InfoSlotsCount = 1024;
+    std::array<std::pair<QString,QString>, InfoSlotsCount> m_infoSlots;
+    size_t m_nextInfoSlot = 0;
+    ExpLauncherReceiveCounters m_receiveCounters;
 };
 }
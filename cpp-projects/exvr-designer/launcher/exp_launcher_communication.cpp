@@ -97,7 +97,7 @@ void ExpLauncherCommunication::read_pending_datagrams(){
 
         auto size = readSocket->readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
         if(size > 0){
-            emit message_received_signal(QString(datagram));
+            emit message_received_signal(datagram);
         }else{
             emit error_signal(QSL("[IPC] Error while reading udp packet.\n"));
         }
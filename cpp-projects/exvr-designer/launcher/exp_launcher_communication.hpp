@@ -59,7 +59,7 @@ public slots:
 
 signals:
 
-    void message_received_signal(QString message);
+    void message_received_signal(QByteArray message);
     void error_signal(QString error);
 };
 }
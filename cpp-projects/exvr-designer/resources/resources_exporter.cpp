@@ -0,0 +1,422 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "resources_exporter.hpp"
+
+// std
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+
+// Qt
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QDateTime>
+#include <QCryptographicHash>
+
+// qt-utility
+#include "qt_str.hpp"
+
+// local
+#include "utility/path_utility.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+bool ResourcesHashCache::load(const QString &filePath){
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text)){
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    while(!file.atEnd()){
+        const auto line = QString::fromUtf8(file.readLine()).trimmed();
+        const auto split = line.split('\t');
+        if(split.size() < 4){
+            continue;
+        }
+        bool okSize = false, okTime = false;
+        Entry entry;
+        entry.size  = split[0].toLongLong(&okSize);
+        entry.mtime = split[1].toLongLong(&okTime);
+        entry.hash  = QByteArray::fromHex(split[2].toLatin1());
+        if(okSize && okTime && !entry.hash.isEmpty()){
+            m_entries[split.mid(3).join('\t')] = std::move(entry);
+        }
+    }
+    return true;
+}
+
+bool ResourcesHashCache::save(const QString &filePath) const{
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)){
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    for(const auto &[path, entry] : m_entries){
+        // forget files which have been modified or removed since they were hashed
+        const QFileInfo info(path);
+        if(!info.exists() || info.size() != entry.size || info.lastModified().toMSecsSinceEpoch() != entry.mtime){
+            continue;
+        }
+        file.write(QString("%1\t%2\t%3\t%4\n").arg(entry.size).arg(entry.mtime).arg(QString::fromLatin1(entry.hash.toHex()), path).toUtf8());
+    }
+    return true;
+}
+
+std::optional<QByteArray> ResourcesHashCache::hash(const QFileInfo &info) const{
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if(auto entry = m_entries.find(info.absoluteFilePath()); entry != m_entries.end()){
+        if(entry->second.size == info.size() && entry->second.mtime == info.lastModified().toMSecsSinceEpoch()){
+            return entry->second.hash;
+        }
+    }
+    return std::nullopt;
+}
+
+void ResourcesHashCache::set_hash(const QFileInfo &info, QByteArray hash){
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_entries[info.absoluteFilePath()] = Entry{info.size(), info.lastModified().toMSecsSinceEpoch(), std::move(hash)};
+}
+
+QByteArray ResourcesHashCache::compute_hash(const QString &filePath, qint64 bufferSize){
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly)){
+        return {};
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QByteArray buffer(bufferSize, Qt::Uninitialized);
+    qint64 read = 0;
+    while((read = file.read(buffer.data(), bufferSize)) > 0){
+        hash.addData(QByteArrayView(buffer.constData(), read));
+    }
+    return read < 0 ? QByteArray{} : hash.result();
+}
+
+ResourcesExporter::ResourcesExporter(){
+    m_progressTimer.setInterval(200);
+    connect(&m_progressTimer, &QTimer::timeout, this, &ResourcesExporter::update_progress);
+}
+
+ResourcesExporter::~ResourcesExporter(){
+    cancel();
+    wait();
+}
+
+umap<int, QString> ResourcesExporter::generate_export_paths(const ResourcesManager &resM){
+
+    umap<int, QString> paths;
+    std::unordered_set<QString> used;
+    for(const auto type : Resource::get_types()){
+
+        const QString typeDir = QSL("resources/") % from_view(Resource::get_name(type)) % QSL("/");
+        for(const auto resource : resM.get_resources(type)){
+
+            const QFileInfo info(QDir::cleanPath(resource->path));
+            QString path = typeDir % info.fileName();
+
+            // case insensitive check, exported experiments are mostly used on Windows
+            for(int ii = 1; used.contains(path.toLower()); ++ii){
+                const auto suffix = info.suffix();
+                path = typeDir % info.completeBaseName() % QSL("_") % QString::number(ii) % (suffix.isEmpty() ? QString() : QString(QSL(".") % suffix));
+            }
+            used.insert(path.toLower());
+            paths[resource->key()] = std::move(path);
+        }
+    }
+    return paths;
+}
+
+std::vector<ResourceExportEntry> ResourcesExporter::generate_entries(const ResourcesManager &resM){
+
+    const auto paths = generate_export_paths(resM);
+
+    std::vector<ResourceExportEntry> entries;
+    for(const auto type : Resource::get_types()){
+        for(const auto resource : resM.get_resources(type)){
+
+            const auto &destination = paths.at(resource->key());
+            if(type == Resource::Type::Directory){
+                const QDir dir(resource->path);
+                QDirIterator it(resource->path, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+                while(it.hasNext()){
+                    const auto filePath = it.next();
+                    entries.push_back({filePath, destination % QSL("/") % dir.relativeFilePath(filePath), it.fileInfo().size()});
+                }
+            }else{
+                entries.push_back({resource->path, destination, QFileInfo(resource->path).size()});
+            }
+        }
+    }
+
+    // biggest files first, avoids ending with a single thread copying a large video
+    std::stable_sort(entries.begin(), entries.end(), [](const auto &e1, const auto &e2){
+        return e1.size > e2.size;
+    });
+    return entries;
+}
+
+bool ResourcesExporter::start(const ResourcesManager &resM, const QString &exportDirPath){
+
+    if(is_running()){
+        QtLogger::warning(QSL("[EXPORT] An export is already running."));
+        return false;
+    }
+    wait();
+
+    auto entries = generate_entries(resM);
+
+    m_cancel        = false;
+    m_bytesDone     = 0;
+    m_bytesCopied   = 0;
+    m_filesDone     = 0;
+    m_filesSkipped  = 0;
+    m_filesFailed   = 0;
+    m_filesTotal    = entries.size();
+    m_bytesTotal    = 0;
+    for(const auto &entry : entries){
+        m_bytesTotal += entry.size;
+    }
+    m_errors.clear();
+    m_start = std::chrono::steady_clock::now();
+
+    QDir(exportDirPath).mkpath(QSL("resources"));
+
+    QtLogger::message(QSL("[EXPORT] Export ") % QString::number(m_filesTotal) % QSL(" resources files (") %
+        QString::number(m_bytesTotal / (1024.*1024.), 'f', 1) % QSL(" MB) to ") % exportDirPath);
+
+    m_running = true;
+    m_thread = std::thread(&ResourcesExporter::run, this, exportDirPath, std::move(entries));
+    m_progressTimer.start();
+    return true;
+}
+
+void ResourcesExporter::cancel(){
+    m_cancel = true;
+}
+
+void ResourcesExporter::wait(){
+    if(m_thread.joinable()){
+        m_thread.join();
+    }
+}
+
+ResourcesExportProgress ResourcesExporter::progress() const{
+
+    ResourcesExportProgress p;
+    p.bytesDone     = m_bytesDone;
+    p.bytesCopied   = m_bytesCopied;
+    p.bytesTotal    = m_bytesTotal;
+    p.filesDone     = m_filesDone;
+    p.filesTotal    = m_filesTotal;
+    p.filesSkipped  = m_filesSkipped;
+    p.filesFailed   = m_filesFailed;
+    p.elapsed       = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    p.bytesPerSecond= p.elapsed > 0. ? p.bytesCopied / p.elapsed : 0.;
+    p.finished      = !m_running;
+    p.canceled      = m_cancel;
+    return p;
+}
+
+void ResourcesExporter::update_progress(){
+
+    if(is_running()){
+        emit progress_signal(progress());
+        return;
+    }
+
+    m_progressTimer.stop();
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(m_errorsLock);
+        for(const auto &error : m_errors){
+            QtLogger::error(error);
+        }
+        m_errors.clear();
+    }
+
+    const auto p = progress();
+    QtLogger::message(QSL("[EXPORT] ") % (p.canceled ? QSL("Canceled") : QSL("Done")) % QSL(" in ") % QString::number(p.elapsed, 'f', 1) %
+        QSL("s, copied: ") % QString::number(p.filesDone - p.filesSkipped - p.filesFailed) %
+        QSL(", up to date: ") % QString::number(p.filesSkipped) %
+        QSL(", failed: ") % QString::number(p.filesFailed) %
+        QSL(", throughput: ") % QString::number(p.bytesPerSecond / (1024.*1024.), 'f', 1) % QSL(" MB/s"));
+
+    emit progress_signal(p);
+    emit finished_signal(p);
+}
+
+QString ResourcesExporter::hash_cache_file_path(const QString &exportDirPath){
+    const auto dirHash = QCryptographicHash::hash(QDir(exportDirPath).absolutePath().toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+    return Paths::tempDir % QSL("/export_hashes_") % QString::fromLatin1(dirHash);
+}
+
+void ResourcesExporter::run(QString exportDirPath, std::vector<ResourceExportEntry> entries){
+
+    // older versions stored the cache inside the exported resources
+    QFile::remove(exportDirPath % QSL("/resources/.export_hashes"));
+
+    const QString cacheFilePath = hash_cache_file_path(exportDirPath);
+    m_cache.load(cacheFilePath);
+
+    std::atomic<size_t> next = 0;
+    auto worker = [&](){
+        for(size_t id = next++; id < entries.size() && !m_cancel; id = next++){
+            qint64 entryBytesDone = 0;
+            if(!export_entry(exportDirPath, entries[id], entryBytesDone)){
+                ++m_filesFailed;
+            }
+            // skipped and failed files count as done, progress reaches the total once every file has been processed
+            m_bytesDone += std::max<qint64>(0, entries[id].size - entryBytesDone);
+            ++m_filesDone;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t nbWorkers = std::clamp<size_t>(copyThreadsCount, 1, std::max<size_t>(entries.size(), 1));
+    for(size_t ii = 1; ii < nbWorkers; ++ii){
+        workers.emplace_back(worker);
+    }
+    worker();
+    for(auto &w : workers){
+        w.join();
+    }
+
+    m_cache.save(cacheFilePath);
+    m_running = false;
+}
+
+bool ResourcesExporter::export_entry(const QString &exportDirPath, const ResourceExportEntry &entry, qint64 &entryBytesDone){
+
+    auto error = [&](const QString &message){
+        std::lock_guard<std::mutex> lock(m_errorsLock);
+        m_errors.push_back(QSL("[EXPORT] ") % message);
+        return false;
+    };
+
+    const QFileInfo srcInfo(entry.source);
+    if(!srcInfo.exists()){
+        return error(QSL("Resource file ") % entry.source % QSL(" doesn't exist."));
+    }
+
+    const QString dstPath = exportDirPath % QSL("/") % entry.destination;
+    const QFileInfo dstInfo(dstPath);
+    auto srcHash = m_cache.hash(srcInfo);
+
+    // skip destination if already up to date
+    if(dstInfo.exists() && dstInfo.size() == srcInfo.size()){
+
+        if(!srcHash.has_value()){
+            srcHash = ResourcesHashCache::compute_hash(entry.source, copyBufferSize);
+            m_cache.set_hash(srcInfo, *srcHash);
+        }
+        auto dstHash = m_cache.hash(dstInfo);
+        if(!dstHash.has_value()){
+            dstHash = ResourcesHashCache::compute_hash(dstPath, copyBufferSize);
+            m_cache.set_hash(dstInfo, *dstHash);
+        }
+
+        if(!srcHash->isEmpty() && *srcHash == *dstHash){
+            ++m_filesSkipped;
+            return true;
+        }
+    }
+
+    if(!QDir().mkpath(dstInfo.absolutePath())){
+        return error(QSL("Cannot create directory ") % dstInfo.absolutePath());
+    }
+    if(dstInfo.exists() && !QFile::remove(dstPath)){
+        return error(QSL("Cannot overwrite file ") % dstPath);
+    }
+
+    if(srcHash.has_value() && !srcHash->isEmpty()){
+
+        // content already hashed, let the system do the copy (copy_file_range/CopyFile)
+        std::error_code ec;
+        std::filesystem::copy_file(
+            std::filesystem::path(entry.source.toStdU16String()),
+            std::filesystem::path(dstPath.toStdU16String()),
+            std::filesystem::copy_options::overwrite_existing,
+            ec
+        );
+        if(ec){
+            return error(QSL("Cannot copy ") % entry.source % QSL(" to ") % dstPath % QSL(": ") % QString::fromStdString(ec.message()));
+        }
+        m_bytesCopied += entry.size;
+
+    }else{
+
+        // hash while copying, source is read only once
+        QByteArray hash;
+        if(!copy_with_hash(entry.source, dstPath, hash, entryBytesDone)){
+            QFile::remove(dstPath);
+            if(m_cancel){
+                return false;
+            }
+            return error(QSL("Cannot copy ") % entry.source % QSL(" to ") % dstPath);
+        }
+        srcHash = std::move(hash);
+        m_cache.set_hash(srcInfo, *srcHash);
+    }
+
+    m_cache.set_hash(QFileInfo(dstPath), *srcHash);
+    return true;
+}
+
+bool ResourcesExporter::copy_with_hash(const QString &source, const QString &destination, QByteArray &hash, qint64 &bytesDone){
+
+    QFile src(source);
+    QFile dst(destination);
+    if(!src.open(QIODevice::ReadOnly) || !dst.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        return false;
+    }
+    dst.resize(src.size());
+
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    QByteArray buffer(copyBufferSize, Qt::Uninitialized);
+    qint64 read = 0;
+    while(!m_cancel && (read = src.read(buffer.data(), copyBufferSize)) > 0){
+        h.addData(QByteArrayView(buffer.constData(), read));
+        if(dst.write(buffer.constData(), read) != read){
+            return false;
+        }
+        bytesDone     += read;
+        m_bytesDone   += read;
+        m_bytesCopied += read;
+    }
+    if(read < 0 || m_cancel){
+        return false;
+    }
+
+    hash = h.result();
+    return true;
+}
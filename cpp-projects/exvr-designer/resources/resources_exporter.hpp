@@ -0,0 +1,146 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+// Qt
+#include <QObject>
+#include <QTimer>
+#include <QFileInfo>
+
+// base
+#include "utility/unordered_map.hpp"
+
+// local
+#include "resources_manager.hpp"
+
+namespace tool::ex {
+
+struct ResourceExportEntry{
+    QString source;
+    QString destination;            /**< relative to the export directory */
+    qint64 size = 0;
+};
+
+struct ResourcesExportProgress{
+    qint64 bytesDone = 0;           /**< copied, skipped or failed */
+    qint64 bytesCopied = 0;
+    qint64 bytesTotal = 0;
+    size_t filesDone = 0;
+    size_t filesTotal = 0;
+    size_t filesSkipped = 0;
+    size_t filesFailed = 0;
+    double bytesPerSecond = 0.;
+    double elapsed = 0.;            /**< seconds */
+    bool finished = false;
+    bool canceled = false;
+};
+
+class ResourcesHashCache{
+public:
+
+    bool load(const QString &filePath);
+    bool save(const QString &filePath) const;
+
+    std::optional<QByteArray> hash(const QFileInfo &info) const;
+    void set_hash(const QFileInfo &info, QByteArray hash);
+
+    static QByteArray compute_hash(const QString &filePath, qint64 bufferSize);
+
+private:
+
+    struct Entry{
+        qint64 size;
+        qint64 mtime;
+        QByteArray hash;
+    };
+
+    mutable std::mutex m_lock;
+    umap<QString, Entry> m_entries;
+};
+
+class ResourcesExporter : public QObject{
+    Q_OBJECT
+public:
+
+    ResourcesExporter();
+    ~ResourcesExporter();
+
+    // relative destination path of every resource inside the export directory, names collisions are suffixed
+    static umap<int, QString> generate_export_paths(const ResourcesManager &resM);
+    // files to copy, directories resources are expanded recursively
+    static std::vector<ResourceExportEntry> generate_entries(const ResourcesManager &resM);
+
+    bool start(const ResourcesManager &resM, const QString &exportDirPath);
+    void cancel();
+    void wait();
+
+    bool is_running() const{return m_running.load();}
+    ResourcesExportProgress progress() const;
+
+    static inline size_t copyThreadsCount = 4;                  /**< i/o bound, more threads mostly thrash the disks */
+    static inline qint64 copyBufferSize = 8 * 1024 * 1024;
+
+    // hashes cache of an export directory, kept in the designer temp directory so it is never shipped with the export
+    static QString hash_cache_file_path(const QString &exportDirPath);
+
+signals:
+
+    void progress_signal(tool::ex::ResourcesExportProgress progress);
+    void finished_signal(tool::ex::ResourcesExportProgress progress);
+
+private:
+
+    void run(QString exportDirPath, std::vector<ResourceExportEntry> entries);
+    bool export_entry(const QString &exportDirPath, const ResourceExportEntry &entry, qint64 &entryBytesDone);
+    bool copy_with_hash(const QString &source, const QString &destination, QByteArray &hash, qint64 &bytesDone);
+    void update_progress();
+
+    ResourcesHashCache m_cache;
+    std::thread m_thread;
+    QTimer m_progressTimer;
+
+    std::atomic_bool m_running = false;
+    std::atomic_bool m_cancel  = false;
+    std::atomic<qint64> m_bytesDone   = 0;
+    std::atomic<qint64> m_bytesCopied = 0;
+    std::atomic<size_t> m_filesDone    = 0;
+    std::atomic<size_t> m_filesSkipped = 0;
+    std::atomic<size_t> m_filesFailed  = 0;
+    qint64 m_bytesTotal = 0;
+    size_t m_filesTotal = 0;
+    std::chrono::steady_clock::time_point m_start;
+
+    std::mutex m_errorsLock;
+    std::vector<QString> m_errors;
+};
+}
+
+Q_DECLARE_METATYPE(tool::ex::ResourcesExportProgress)
@@ -0,0 +1,485 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "resources_indexer.hpp"
+
+// std
+#include <algorithm>
+
+// Qt
+#include <QThread>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QImageReader>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtEndian>
+
+// qt-utility
+#include "qt_str.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+// iso base media file (mp4, mov): duration from the movie header box, the media data itself is never read
+std::optional<double> ResourcesIndexer::read_mp4_duration(const QString &path){
+
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly)){
+        return std::nullopt;
+    }
+
+    auto find_box = [&](qint64 start, qint64 end, const char *type) -> std::optional<std::pair<qint64,qint64>>{
+        qint64 pos = start;
+        char header[16];
+        while(pos + 8 <= end){
+            if(!file.seek(pos) || file.read(header, 8) != 8){
+                return std::nullopt;
+            }
+            quint64 size = qFromBigEndian<quint32>(header);
+            qint64 headerSize = 8;
+            if(size == 1){
+                if(file.read(header + 8, 8) != 8){
+                    return std::nullopt;
+                }
+                size = qFromBigEndian<quint64>(header + 8);
+                headerSize = 16;
+            }else if(size == 0){
+                size = end - pos;
+            }
+            // truncated or corrupted box, a 64-bit size beyond the parent would overflow the position
+            if(size < static_cast<quint64>(headerSize) || size > static_cast<quint64>(end - pos)){
+                return std::nullopt;
+            }
+            if(std::equal(header + 4, header + 8, type)){
+                return std::make_pair(pos + headerSize, pos + static_cast<qint64>(size));
+            }
+            pos += static_cast<qint64>(size);
+        }
+        return std::nullopt;
+    };
+
+    auto moov = find_box(0, file.size(), "moov");
+    if(!moov.has_value()){
+        return std::nullopt;
+    }
+    auto mvhd = find_box(moov->first, moov->second, "mvhd");
+    if(!mvhd.has_value()){
+        return std::nullopt;
+    }
+
+    char data[32];
+    if(mvhd->second - mvhd->first < 20 || !file.seek(mvhd->first) || file.read(data, 20) != 20){
+        return std::nullopt;
+    }
+    if(data[0] == 1 && (mvhd->second - mvhd->first < 32 || file.read(data + 20, 12) != 12)){
+        return std::nullopt;
+    }
+
+    quint32 timeScale = 0;
+    quint64 duration  = 0;
+    if(data[0] == 1){
+        timeScale = qFromBigEndian<quint32>(data + 20);
+        duration  = qFromBigEndian<quint64>(data + 24);
+    }else{
+        timeScale = qFromBigEndian<quint32>(data + 12);
+        duration  = qFromBigEndian<quint32>(data + 16);
+    }
+    if(timeScale == 0){
+        return std::nullopt;
+    }
+    return static_cast<double>(duration) / timeScale;
+}
+
+// riff wave: channels and duration from the fmt and data chunks headers
+bool ResourcesIndexer::read_wav_info(const QString &path, ResourceMetadata &metadata){
+
+    QFile file(path);
+    if(!file.open(QIODevice::ReadOnly)){
+        return false;
+    }
+
+    char header[12];
+    if(file.read(header, 12) != 12 || !std::equal(header, header + 4, "RIFF") || !std::equal(header + 8, header + 12, "WAVE")){
+        return false;
+    }
+
+    quint32 byteRate = 0;
+    qint64 pos = 12;
+    char chunk[16];
+    while(pos + 8 <= file.size()){
+        if(!file.seek(pos) || file.read(chunk, 8) != 8){
+            return false;
+        }
+        const quint32 size = qFromLittleEndian<quint32>(chunk + 4);
+        if(std::equal(chunk, chunk + 4, "fmt ")){
+            if(size < 16 || file.read(chunk, 16) != 16){
+                return false;
+            }
+            metadata.channels = qFromLittleEndian<quint16>(chunk + 2);
+            byteRate          = qFromLittleEndian<quint32>(chunk + 8);
+        }else if(std::equal(chunk, chunk + 4, "data")){
+            if(byteRate == 0){
+                return false;
+            }
+            metadata.duration = static_cast<double>(size) / byteRate;
+            return true;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    return false;
+}
+
+QString ResourceMetadata::description() const{
+
+    switch(status){
+    case Status::Unknown:
+        return QSL("Scanning...");
+    case Status::Missing:
+        return QSL("File not found");
+    case Status::Invalid:
+        return QSL("Invalid: ") % error;
+    default:
+        break;
+    }
+
+    QStringList infos;
+    if(!format.isEmpty()){
+        infos << format;
+    }
+    infos << (QString::number(size / (1024.*1024.), 'f', 2) % QSL(" MB"));
+    if(filesCount > 0){
+        infos << (QString::number(filesCount) % QSL(" files"));
+    }
+    if(width > 0 && height > 0){
+        infos << (QString::number(width) % QSL("x") % QString::number(height));
+    }
+    if(duration >= 0.){
+        infos << (QString::number(duration, 'f', 2) % QSL("s"));
+    }
+    if(channels > 0){
+        infos << (QString::number(channels) % QSL(" channels"));
+    }
+    return infos.join(QSL(", "));
+}
+
+ResourcesIndexer::ResourcesIndexer(){
+
+    m_pool.setMaxThreadCount(std::clamp(QThread::idealThreadCount() / 2, 1, 4));
+
+    m_notifyTimer.setSingleShot(true);
+    m_notifyTimer.setInterval(100);
+    connect(&m_notifyTimer, &QTimer::timeout, this, &ResourcesIndexer::index_updated_signal);
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(1000);
+    connect(&m_saveTimer, &QTimer::timeout, this, [&]{
+        if(!m_experimentFilePath.isEmpty()){
+            save_index(index_file_path(m_experimentFilePath));
+        }
+    });
+
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged,      this, &ResourcesIndexer::path_changed);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ResourcesIndexer::path_changed);
+}
+
+ResourcesIndexer::~ResourcesIndexer(){
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QString ResourcesIndexer::index_file_path(const QString &experimentFilePath){
+    const QFileInfo info(experimentFilePath);
+    return info.absolutePath() % QSL("/") % info.completeBaseName() % QSL(".resources_index.json");
+}
+
+const ResourceMetadata *ResourcesIndexer::metadata(const QString &path) const{
+    if(auto entry = m_entries.find(QDir::cleanPath(path)); entry != m_entries.end()){
+        return &entry->second.metadata;
+    }
+    return nullptr;
+}
+
+void ResourcesIndexer::update(const ResourcesManager &resM, const QString &experimentFilePath){
+
+    if(experimentFilePath != m_experimentFilePath){
+        m_entries.clear();
+        m_experimentFilePath = experimentFilePath;
+        if(!m_experimentFilePath.isEmpty()){
+            load_index(index_file_path(m_experimentFilePath));
+        }
+    }
+
+    m_current.clear();
+    for(const auto type : Resource::get_types()){
+        for(const auto resource : resM.get_resources(type)){
+            m_current[QDir::cleanPath(resource->path)] = type;
+        }
+    }
+
+    // forget removed resources
+    for(auto it = m_entries.begin(); it != m_entries.end();){
+        if(!m_current.contains(it->first)){
+            it = m_entries.erase(it);
+        }else{
+            ++it;
+        }
+    }
+
+    QStringList unwatched;
+    for(const auto &path : m_watcher.files() + m_watcher.directories()){
+        if(!m_current.contains(path) && !m_missingParents.contains(path)){
+            unwatched << path;
+        }
+    }
+    if(!unwatched.isEmpty()){
+        m_watcher.removePaths(unwatched);
+    }
+
+    // scan new, modified or not yet verified ones
+    for(const auto &[path, type] : m_current){
+        auto entry = m_entries.find(path);
+        if(entry == m_entries.end() || !entry->second.verified || entry->second.type != type){
+            schedule(type, path);
+        }
+    }
+}
+
+void ResourcesIndexer::schedule(Resource::Type type, const QString &path){
+
+    const size_t generation = ++m_generation;
+    m_pending[path] = generation;
+
+    std::optional<ResourceMetadata> previous = std::nullopt;
+    if(auto entry = m_entries.find(path); entry != m_entries.end() && entry->second.type == type){
+        previous = entry->second.metadata;
+    }
+
+    m_pool.start([this, type, path, previous, generation]{
+        auto metadata = probe(type, path, previous);
+        QMetaObject::invokeMethod(this, [this, type, path, metadata = std::move(metadata), generation]{
+            set_result(type, path, std::move(metadata), generation);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ResourcesIndexer::set_result(Resource::Type type, QString path, ResourceMetadata metadata, size_t generation){
+
+    // resource removed or scan outdated by a more recent one
+    if(auto pending = m_pending.find(path); pending == m_pending.end() || pending->second != generation){
+        return;
+    }
+    m_pending.erase(path);
+    if(auto current = m_current.find(path); current == m_current.end() || current->second != type){
+        return;
+    }
+
+    // missing files are detected through their parent directory
+    const QString toWatch = metadata.status == ResourceMetadata::Status::Missing ? QFileInfo(path).absolutePath() : path;
+    if(metadata.status == ResourceMetadata::Status::Missing){
+        m_missingParents.insert(toWatch);
+    }
+    if(!m_watcher.files().contains(toWatch) && !m_watcher.directories().contains(toWatch) && QFileInfo::exists(toWatch)){
+        m_watcher.addPath(toWatch);
+    }
+
+    m_entries[path] = Entry{type, std::move(metadata), true};
+
+    m_notifyTimer.start();
+    m_saveTimer.start();
+}
+
+void ResourcesIndexer::path_changed(const QString &path){
+
+    if(auto current = m_current.find(path); current != m_current.end()){
+        if(auto entry = m_entries.find(path); entry != m_entries.end()){
+            entry->second.verified = false;
+        }
+        schedule(current->second, path);
+    }
+
+    if(m_missingParents.contains(path)){
+        m_missingParents.erase(path);
+        for(const auto &[resourcePath, type] : m_current){
+            if(auto entry = m_entries.find(resourcePath); entry != m_entries.end()){
+                if(entry->second.metadata.status == ResourceMetadata::Status::Missing && QFileInfo(resourcePath).absolutePath() == path){
+                    entry->second.verified = false;
+                    schedule(type, resourcePath);
+                }
+            }
+        }
+    }
+}
+
+ResourceMetadata ResourcesIndexer::probe(Resource::Type type, const QString &path, const std::optional<ResourceMetadata> &previous){
+
+    ResourceMetadata metadata;
+    const QFileInfo info(path);
+    if(!info.exists()){
+        metadata.status = ResourceMetadata::Status::Missing;
+        return metadata;
+    }
+    metadata.mtime = info.lastModified().toMSecsSinceEpoch();
+
+    if(type == Resource::Type::Directory){
+        if(!info.isDir()){
+            metadata.status = ResourceMetadata::Status::Invalid;
+            metadata.error  = QSL("not a directory");
+            return metadata;
+        }
+        QDirIterator it(path, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while(it.hasNext()){
+            it.next();
+            metadata.size += it.fileInfo().size();
+            ++metadata.filesCount;
+        }
+        metadata.status = ResourceMetadata::Status::Valid;
+        return metadata;
+    }
+
+    metadata.size   = info.size();
+    metadata.format = info.suffix().toLower();
+
+    // unchanged since last probing
+    if(previous.has_value() && (previous->status == ResourceMetadata::Status::Valid || previous->status == ResourceMetadata::Status::Invalid)){
+        if(previous->size == metadata.size && previous->mtime == metadata.mtime){
+            return previous.value();
+        }
+    }
+
+    metadata.status = ResourceMetadata::Status::Valid;
+    switch(type){
+    case Resource::Type::Image:{
+        QImageReader reader(path);
+        const auto size = reader.size();
+        if(size.isValid()){
+            metadata.width  = size.width();
+            metadata.height = size.height();
+        }else{
+            metadata.status = ResourceMetadata::Status::Invalid;
+            metadata.error  = reader.errorString();
+        }
+    }break;
+    case Resource::Type::Video:
+        if(metadata.format == QSL("mp4") || metadata.format == QSL("m4v") || metadata.format == QSL("mov")){
+            if(auto duration = read_mp4_duration(path); duration.has_value()){
+                metadata.duration = duration.value();
+            }else{
+                metadata.status = ResourceMetadata::Status::Invalid;
+                metadata.error  = QSL("no movie header found");
+            }
+        }
+        break;
+    case Resource::Type::Audio:
+        if(metadata.format == QSL("wav") && !read_wav_info(path, metadata)){
+            metadata.status = ResourceMetadata::Status::Invalid;
+            metadata.error  = QSL("invalid wave header");
+        }
+        break;
+    default:
+        break;
+    }
+
+    if(metadata.size == 0 && metadata.status == ResourceMetadata::Status::Valid){
+        metadata.status = ResourceMetadata::Status::Invalid;
+        metadata.error  = QSL("empty file");
+    }
+    return metadata;
+}
+
+bool ResourcesIndexer::load_index(const QString &indexFilePath){
+
+    QFile file(indexFilePath);
+    if(!file.open(QIODevice::ReadOnly)){
+        return false;
+    }
+
+    const auto doc = QJsonDocument::fromJson(file.readAll());
+    if(!doc.isObject()){
+        QtLogger::warning(QSL("[INDEXER] Invalid resources index file: ") % indexFilePath);
+        return false;
+    }
+
+    for(const auto value : doc.object()[QSL("resources")].toArray()){
+
+        const auto obj  = value.toObject();
+        const auto type = Resource::get_type(obj[QSL("type")].toString().toStdString());
+        if(!type.has_value()){
+            continue;
+        }
+
+        Entry entry;
+        entry.type     = type.value();
+        entry.verified = false;
+        auto &md       = entry.metadata;
+        md.status      = static_cast<ResourceMetadata::Status>(obj[QSL("status")].toInt());
+        md.size        = obj[QSL("size")].toInteger();
+        md.mtime       = obj[QSL("mtime")].toInteger();
+        md.width       = obj[QSL("width")].toInt();
+        md.height      = obj[QSL("height")].toInt();
+        md.duration    = obj[QSL("duration")].toDouble(-1.);
+        md.channels    = obj[QSL("channels")].toInt();
+        md.filesCount  = obj[QSL("filesCount")].toInt();
+        md.format      = obj[QSL("format")].toString();
+        md.error       = obj[QSL("error")].toString();
+        m_entries[obj[QSL("path")].toString()] = std::move(entry);
+    }
+    return true;
+}
+
+bool ResourcesIndexer::save_index(const QString &indexFilePath) const{
+
+    QJsonArray resources;
+    for(const auto &[path, entry] : m_entries){
+        if(!entry.verified || entry.metadata.status == ResourceMetadata::Status::Unknown){
+            continue;
+        }
+        const auto &md = entry.metadata;
+        resources.append(QJsonObject{
+            {QSL("path"),       path},
+            {QSL("type"),       from_view(Resource::get_name(entry.type))},
+            {QSL("status"),     static_cast<int>(md.status)},
+            {QSL("size"),       md.size},
+            {QSL("mtime"),      md.mtime},
+            {QSL("width"),      md.width},
+            {QSL("height"),     md.height},
+            {QSL("duration"),   md.duration},
+            {QSL("channels"),   md.channels},
+            {QSL("filesCount"), md.filesCount},
+            {QSL("format"),     md.format},
+            {QSL("error"),      md.error},
+        });
+    }
+
+    QFile file(indexFilePath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        QtLogger::warning(QSL("[INDEXER] Cannot write resources index file: ") % indexFilePath);
+        return false;
+    }
+    file.write(QJsonDocument(QJsonObject{{QSL("version"), 1}, {QSL("resources"), resources}}).toJson(QJsonDocument::Indented));
+    return true;
+}
@@ -0,0 +1,117 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <optional>
+#include <unordered_set>
+
+// Qt
+#include <QObject>
+#include <QThreadPool>
+#include <QFileSystemWatcher>
+#include <QTimer>
+
+// base
+#include "utility/unordered_map.hpp"
+
+// local
+#include "resources_manager.hpp"
+
+namespace tool::ex {
+
+struct ResourceMetadata{
+
+    enum class Status : int{
+        Unknown = 0,    /**< not scanned yet */
+        Missing,
+        Valid,
+        Invalid         /**< exists but couldn't be probed */
+    };
+
+    Status status = Status::Unknown;
+    qint64 size  = 0;               /**< bytes, sum of the files for directories */
+    qint64 mtime = 0;               /**< ms since epoch */
+    int width  = 0;
+    int height = 0;
+    double duration = -1.;          /**< seconds, -1 if unknown */
+    int channels = 0;
+    int filesCount = 0;
+    QString format;
+    QString error;
+
+    QString description() const;
+};
+
+class ResourcesIndexer : public QObject{
+    Q_OBJECT
+public:
+
+    ResourcesIndexer();
+    ~ResourcesIndexer();
+
+    // schedule a background scan of the new or modified resources and watch their files
+    void update(const ResourcesManager &resM, const QString &experimentFilePath);
+    // metadata of the last scan, main thread only
+    const ResourceMetadata *metadata(const QString &path) const;
+    bool is_scanning() const noexcept{return !m_pending.empty();}
+
+    static ResourceMetadata probe(Resource::Type type, const QString &path, const std::optional<ResourceMetadata> &previous);
+    static QString index_file_path(const QString &experimentFilePath);
+    // headers readers used by probe
+    static std::optional<double> read_mp4_duration(const QString &path);
+    static bool read_wav_info(const QString &path, ResourceMetadata &metadata);
+
+signals:
+
+    void index_updated_signal();
+
+private:
+
+    void schedule(Resource::Type type, const QString &path);
+    void path_changed(const QString &path);
+    void set_result(Resource::Type type, QString path, ResourceMetadata metadata, size_t generation);
+
+    bool load_index(const QString &indexFilePath);
+    bool save_index(const QString &indexFilePath) const;
+
+    struct Entry{
+        Resource::Type type;
+        ResourceMetadata metadata;
+        bool verified = false;      /**< false: loaded from the sidecar index or file modified, needs a new scan */
+    };
+
+    QString m_experimentFilePath;
+    umap<QString, Entry> m_entries;
+    umap<QString, Resource::Type> m_current;
+    umap<QString, size_t> m_pending;            /**< path -> generation of the last scheduled scan */
+    std::unordered_set<QString> m_missingParents;
+    size_t m_generation = 0;
+
+    QThreadPool m_pool;
+    QFileSystemWatcher m_watcher;
+    QTimer m_notifyTimer;           /**< batches results notifications */
+    QTimer m_saveTimer;
+};
+}
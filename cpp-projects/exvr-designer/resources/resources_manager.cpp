@@ -272,41 +272,3 @@ void ResourcesManager::remove_resource(Resource::Type type, size_t index){
 void ResourcesManager::set_reload_code(int code){m_reloadCode = code;}
 
 int ResourcesManager::reload_code() const {return m_reloadCode;}
-
-void ResourcesManager::export_to(QString path){
-
-    // create readme file
-    // ...
-
-    // create resources dir
-    QDir resourcesDir(path % QSL("/resources"));
-    if (!resourcesDir.exists()){
-        resourcesDir.mkpath(".");
-    }
-
-    // create resource types subdir
-    for(const auto &type : Resource::get_types()){
-        if(m_resourcesPerType[type].size() > 0){
-            QDir typeDir(path % QSL("/resources/") % from_view(Resource::get_name(type)));
-            if (!typeDir.exists()){
-                typeDir.mkpath(".");
-            }
-        }
-    }
-
-    // copy resources
-    for(const auto &typeResources : m_resourcesPerType){
-        QString basePath = path % QSL("/resources/") % from_view(Resource::get_name(typeResources.first)) % QSL("/");
-        for(const auto &resource : typeResources.second){
-            if(resource->type == Resource::Type::Directory){
-                QDir dir(basePath + resource->path.split("/").last());
-                if (!dir.exists()){
-                    dir.mkdir(".");
-                }
-
-            }else{
-                QFile::copy(resource->path, basePath + resource->path.split("/").last());
-            }
-        }
-    }
-}
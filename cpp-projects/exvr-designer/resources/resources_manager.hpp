@@ -90,8 +90,6 @@ public:
 
     bool exportMode = false;
 
-    void export_to(QString path);
-
 private:
 
     void insert_resource(std::unique_ptr<Resource> resource);
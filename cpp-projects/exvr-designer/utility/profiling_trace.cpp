@@ -0,0 +1,337 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "profiling_trace.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+// Qt
+#include <QFile>
+#include <QTextStream>
+
+// base
+#include "utility/unordered_map.hpp"
+
+using namespace tool::ex;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct OpenScope{
+    std::string_view name;
+    Clock::time_point start;
+    bool enabled = false;   /**< trace state when the scope began */
+};
+
+// events of one thread, the lock is only contended when the trace is read
+struct ThreadTrace{
+    std::mutex lock;
+    std::uint32_t threadId = 0;
+    std::vector<OpenScope> stack;
+
+    std::vector<TraceEvent> ring;
+    size_t ringHead = 0;
+    size_t ringCount = 0;
+
+    std::vector<TraceEvent> session;
+    size_t sessionDropped = 0;
+    tool::umap<std::string_view, TraceHistogram> histograms;
+};
+
+struct TraceData{
+    Clock::time_point origin = Clock::now();
+    std::atomic<bool> enabled = true;
+    std::atomic<bool> recording = false;
+    std::atomic<std::uint64_t> frame = 0;
+
+    // threads traces are kept alive after their thread ended
+    std::mutex threadsLock;
+    std::vector<std::shared_ptr<ThreadTrace>> threads;
+};
+
+TraceData &data(){
+    static TraceData d;
+    return d;
+}
+
+ThreadTrace &thread_trace(){
+    thread_local std::shared_ptr<ThreadTrace> trace = [](){
+        auto t = std::make_shared<ThreadTrace>();
+        auto &d = data();
+        std::lock_guard<std::mutex> guard(d.threadsLock);
+        t->threadId = static_cast<std::uint32_t>(d.threads.size());
+        d.threads.push_back(t);
+        return t;
+    }();
+    return *trace;
+}
+
+std::vector<std::shared_ptr<ThreadTrace>> threads_traces(){
+    auto &d = data();
+    std::lock_guard<std::mutex> guard(d.threadsLock);
+    return d.threads;
+}
+
+void sort_by_start(std::vector<TraceEvent> &events){
+    std::stable_sort(events.begin(), events.end(), [](const TraceEvent &e1, const TraceEvent &e2){
+        return e1.startUs < e2.startUs;
+    });
+}
+
+std::int64_t to_us(Clock::duration d){
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+}
+
+void write_json_string(QTextStream &s, std::string_view str){
+    s << '"';
+    for(char c : str){
+        if(c == '"' || c == '\\'){
+            s << '\\';
+        }
+        s << c;
+    }
+    s << '"';
+}
+}
+
+void TraceHistogram::add(std::int64_t durationUs){
+
+    const auto d = static_cast<std::uint64_t>(std::max<std::int64_t>(durationUs, 0));
+    bins[std::min<size_t>(std::bit_width(d), NbBins-1)]++;
+
+    if(count == 0){
+        minUs = durationUs;
+        maxUs = durationUs;
+    }else{
+        minUs = std::min(minUs, durationUs);
+        maxUs = std::max(maxUs, durationUs);
+    }
+    totalUs += durationUs;
+    ++count;
+}
+
+void TraceHistogram::merge(const TraceHistogram &other){
+
+    if(other.count == 0){
+        return;
+    }
+    for(size_t ii = 0; ii < NbBins; ++ii){
+        bins[ii] += other.bins[ii];
+    }
+    minUs    = count == 0 ? other.minUs : std::min(minUs, other.minUs);
+    maxUs    = count == 0 ? other.maxUs : std::max(maxUs, other.maxUs);
+    totalUs += other.totalUs;
+    count   += other.count;
+}
+
+std::int64_t TraceHistogram::percentile(double p) const{
+
+    if(count == 0){
+        return 0;
+    }
+
+    const size_t target = static_cast<size_t>(p * static_cast<double>(count - 1)) + 1;
+    size_t cumulated = 0;
+    for(size_t ii = 0; ii < NbBins; ++ii){
+        cumulated += bins[ii];
+        if(cumulated >= target){
+            // upper bound of the bin
+            return std::min<std::int64_t>((std::int64_t{1} << ii) - 1, maxUs);
+        }
+    }
+    return maxUs;
+}
+
+void Trace::begin(std::string_view name){
+    const bool enabled = data().enabled;
+    thread_trace().stack.push_back({name, enabled ? Clock::now() : Clock::time_point{}, enabled});
+}
+
+void Trace::end(){
+
+    auto &t = thread_trace();
+    if(t.stack.empty()){
+        return;
+    }
+
+    const auto scope = t.stack.back();
+    t.stack.pop_back();
+    if(!scope.enabled){
+        return;
+    }
+
+    auto &d = data();
+    TraceEvent event;
+    event.name       = scope.name;
+    event.startUs    = to_us(scope.start - d.origin);
+    event.durationUs = to_us(Clock::now() - scope.start);
+    event.frame      = d.frame;
+    event.threadId   = t.threadId;
+    event.depth      = static_cast<std::uint32_t>(t.stack.size());
+
+    std::lock_guard<std::mutex> guard(t.lock);
+    if(t.ring.empty()){
+        t.ring.resize(RingSize);
+    }
+    t.ring[t.ringHead] = event;
+    t.ringHead  = (t.ringHead + 1) % RingSize;
+    t.ringCount = std::min(t.ringCount + 1, RingSize);
+
+    t.histograms[event.name].add(event.durationUs);
+
+    if(d.recording){
+        if(t.session.size() < MaxSessionEvents){
+            t.session.push_back(event);
+        }else{
+            ++t.sessionDropped;
+        }
+    }
+}
+
+void Trace::next_frame(){
+    ++data().frame;
+}
+
+void Trace::set_enabled(bool enabled){
+    data().enabled = enabled;
+}
+
+bool Trace::is_enabled(){
+    return data().enabled;
+}
+
+void Trace::start_recording(){
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        t->session.clear();
+        t->sessionDropped = 0;
+    }
+    data().recording = true;
+}
+
+void Trace::stop_recording(){
+    data().recording = false;
+}
+
+bool Trace::is_recording(){
+    return data().recording;
+}
+
+size_t Trace::recorded_events_count(){
+    size_t count = 0;
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        count += t->session.size();
+    }
+    return count;
+}
+
+size_t Trace::dropped_events_count(){
+    size_t count = 0;
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        count += t->sessionDropped;
+    }
+    return count;
+}
+
+std::vector<TraceEvent> Trace::ring_events(){
+
+    std::vector<TraceEvent> events;
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        const size_t first = (t->ringHead + RingSize - t->ringCount) % RingSize;
+        for(size_t ii = 0; ii < t->ringCount; ++ii){
+            events.push_back(t->ring[(first + ii) % RingSize]);
+        }
+    }
+    sort_by_start(events);
+    return events;
+}
+
+std::vector<std::pair<std::string_view, TraceHistogram>> Trace::histograms(){
+
+    tool::umap<std::string_view, TraceHistogram> merged;
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        for(const auto &histogram : t->histograms){
+            merged[histogram.first].merge(histogram.second);
+        }
+    }
+    return {merged.begin(), merged.end()};
+}
+
+bool Trace::export_chrome_trace(const QString &path){
+
+    std::vector<TraceEvent> events;
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        events.insert(events.end(), t->session.begin(), t->session.end());
+    }
+    if(events.empty()){
+        events = ring_events();
+    }else{
+        sort_by_start(events);
+    }
+
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)){
+        return false;
+    }
+
+    QTextStream s(&file);
+    s << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for(size_t ii = 0; ii < events.size(); ++ii){
+        const auto &e = events[ii];
+        s << "{\"name\":";
+        write_json_string(s, e.name);
+        s << ",\"cat\":\"designer\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.threadId
+          << ",\"ts\":" << e.startUs << ",\"dur\":" << e.durationUs
+          << ",\"args\":{\"frame\":" << e.frame << "}}";
+        if(ii + 1 < events.size()){
+            s << ',';
+        }
+        s << '\n';
+    }
+    s << "]}\n";
+
+    return s.status() == QTextStream::Ok;
+}
+
+void Trace::clear(){
+    for(auto &t : threads_traces()){
+        std::lock_guard<std::mutex> guard(t->lock);
+        t->ringHead  = 0;
+        t->ringCount = 0;
+        t->session.clear();
+        t->sessionDropped = 0;
+        t->histograms.clear();
+    }
+}
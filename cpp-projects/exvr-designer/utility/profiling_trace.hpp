@@ -0,0 +1,107 @@
+/***********************************************************************************
+** exvr-designer                                                                  **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Qt
+#include <QString>
+
+// base
+#include "utility/benchmark.hpp"
+
+namespace tool::ex{
+
+struct TraceEvent{
+    std::string_view name;          /**< must have a static storage duration (literal) */
+    std::int64_t startUs = 0;       /**< since trace initialization */
+    std::int64_t durationUs = 0;
+    std::uint64_t frame = 0;
+    std::uint32_t threadId = 0;
+    std::uint32_t depth = 0;
+};
+
+struct TraceHistogram{
+
+    // bin ii contains durations in [2^(ii-1), 2^ii[ microseconds
+    static constexpr size_t NbBins = 24;
+
+    void add(std::int64_t durationUs);
+    void merge(const TraceHistogram &other);
+    std::int64_t percentile(double p) const;
+    constexpr std::int64_t mean() const noexcept{return count > 0 ? totalUs / static_cast<std::int64_t>(count) : 0;}
+
+    std::array<size_t, NbBins> bins{};
+    size_t count = 0;
+    std::int64_t minUs = 0;
+    std::int64_t maxUs = 0;
+    std::int64_t totalUs = 0;
+};
+
+// per-thread scopes recorder, each thread keeps its last events in its own ring buffer and can record them for a whole session
+struct Trace{
+
+    static constexpr size_t RingSize = 1 << 16;            /**< per thread */
+    static constexpr size_t MaxSessionEvents = 1 << 20;    /**< per thread, events recorded once reached are dropped */
+
+    static void begin(std::string_view name);
+    static void end();
+    static void next_frame();
+
+    static void set_enabled(bool enabled);
+    static bool is_enabled();
+
+    static void start_recording();
+    static void stop_recording();
+    static bool is_recording();
+    static size_t recorded_events_count();
+    static size_t dropped_events_count();
+
+    // events of every thread ring, sorted by start time
+    static std::vector<TraceEvent> ring_events();
+    static std::vector<std::pair<std::string_view, TraceHistogram>> histograms();
+
+    // export recorded session (or ring content if nothing has been recorded) to chrome trace json format
+    // file can be opened with chrome://tracing or https://ui.perfetto.dev
+    static bool export_chrome_trace(const QString &path);
+
+    static void clear();
+};
+
+struct TraceGuard{
+    TraceGuard(std::string_view name){Trace::begin(name);}
+    ~TraceGuard(){Trace::end();}
+};
+
+// scope timed by Bench and recorded by Trace under the same name
+struct ProfileGuard{
+    ProfileGuard(std::string_view name){Bench::start(name); Trace::begin(name);}
+    ProfileGuard(std::string_view name, bool display){Bench::start(name, display); Trace::begin(name);}
+    ~ProfileGuard(){Trace::end(); Bench::stop();}
+};
+}
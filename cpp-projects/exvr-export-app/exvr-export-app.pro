@@ -101,11 +101,19 @@ LIBS +=  \
     # tool
     $$BASE_LIB \
     $$SCANER_COMPONENT_LIB\
+    $$EXVR_EXPORT_OBJ"\bi*.obj"\
     $$EXVR_EXPORT_OBJ"\py*.obj"\
     $$EXVR_EXPORT_OBJ"\vi*.obj"\
     $$EXVR_EXPORT_OBJ"\ex_*.obj"\
     $$EXVR_EXPORT_OBJ"\k2_*.obj"\
     $$EXVR_EXPORT_OBJ"\k4_*.obj"\
+    $$EXVR_EXPORT_OBJ"\lo*.obj"\
+    $$EXVR_EXPORT_OBJ"\ud*.obj"\
+    $$EXVR_EXPORT_OBJ"\me*.obj"\
+    $$EXVR_EXPORT_OBJ"\se*.obj"\
+    $$EXVR_EXPORT_OBJ"\cs*.obj"\
+    $$EXVR_EXPORT_OBJ"\pl*.obj"\
+    $$EXVR_EXPORT_OBJ"\cl*.obj"\
     # thirdparty
     $$OPENCV_LIBS \
     $$WINDOWS_LIBS \
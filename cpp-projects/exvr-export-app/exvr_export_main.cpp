@@ -26,8 +26,20 @@
 // std
 #include <iostream>
 #include <memory>
-//#include <thread>
-//#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <charconv>
+#include <format>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <mutex>
 //#include <iostream>
 //#include <vector>
 //#include <map>
@@ -170,8 +182,901 @@ auto test_k4_video()  -> void{
 }
 
 
+#include "ex_components/logger_ex_component.hpp"
+
+// 100 columns logged at 1 kHz from the frame thread during durationS seconds (one hour by default)
+auto bench_logger(int durationS, const std::string &path) -> void{
+
+    LoggerExComponent logger;
+    logger.set(ParametersContainer::InitConfig, "separator", std::string(";"));
+    logger.set(ParametersContainer::InitConfig, "write_each_frame", 0);
+    logger.set(ParametersContainer::InitConfig, "flush_interval_ms", 100);
+    logger.set(ParametersContainer::InitConfig, "sync_policy", static_cast<int>(LoggerExComponent::SyncPolicy::AtStop));
+    logger.set(ParametersContainer::InitConfig, "dont_write_if_file_exists", 0);
+    logger.set(ParametersContainer::InitConfig, "add_to_end_if_file_exists", 0);
+    logger.set(ParametersContainer::InitConfig, "add_header_line", 0);
+    logger.set(ParametersContainer::InitConfig, "header_line", std::string(""));
+    logger.set(ParametersContainer::Dynamic, "path_file", path);
+
+    logger.initialize();
+    logger.start_experiment();
+
+    const size_t nbRows = static_cast<size_t>(durationS)*1000;
+    std::vector<double> row(100);
+    std::vector<float> latenciesUs;
+    latenciesUs.reserve(nbRows);
+
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t ii = 0; ii < nbRows; ++ii){
+
+        std::this_thread::sleep_until(start + std::chrono::microseconds(ii*1000));
+        for(size_t jj = 0; jj < row.size(); ++jj){
+            row[jj] = ii + jj*0.001;
+        }
+
+        const auto before = std::chrono::steady_clock::now();
+        logger.log_row(row.data(), row.size());
+        latenciesUs.push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - before).count());
+
+        if(ii % 60000 == 0){
+            std::cout << "minute " << ii/60000 << " rows written " << logger.rows_written() << " dropped " << logger.rows_dropped() << "\n";
+        }
+    }
+
+    const auto stopStart = std::chrono::steady_clock::now();
+    logger.stop_experiment();
+    const auto end = std::chrono::steady_clock::now();
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    const auto percentile = [&](double p){
+        return latenciesUs.empty() ? 0.f : latenciesUs[static_cast<size_t>(p*(latenciesUs.size()-1))];
+    };
+    std::cout << "rows: " << nbRows << " written: " << logger.rows_written() << " dropped: " << logger.rows_dropped() << "\n";
+    std::cout << "bytes written: " << logger.bytes_written() << " in " << std::chrono::duration<double>(end - start).count() << "s\n";
+    std::cout << "log_row latency (us) p50: " << percentile(0.5) << " p99: " << percentile(0.99) << " p99.99: " << percentile(0.9999) << " max: " << percentile(1.0) << "\n";
+    std::cout << "stop (last flush and sync): " << std::chrono::duration<double, std::milli>(end - stopStart).count() << "ms\n";
+}
+
+#include "ex_components/logger_columnar_file.hpp"
+
+// convert a columnar log file to csv, then parse the csv back and compare it with the columnar values
+auto columnar_log_to_csv(const std::string &inputPath, const std::string &outputPath, const std::string &separator) -> bool{
+
+    using namespace std::chrono;
+
+    ColumnarLogReader reader;
+    auto start = steady_clock::now();
+    if(!reader.open(inputPath)){
+        std::cerr << "Cannot open columnar log file " << inputPath << "\n";
+        return false;
+    }
+    if(reader.recovered()){
+        std::cout << "File not closed properly, " << reader.chunks().size() << " complete chunks recovered.\n";
+    }
+
+    std::vector<size_t> allColumns(reader.columns().size());
+    std::iota(allColumns.begin(), allColumns.end(), 0);
+    std::vector<ColumnarLogColumnData> data;
+    if(!reader.read(allColumns, data)){
+        std::cerr << "Invalid column block in " << inputPath << "\n";
+        return false;
+    }
+    const auto loadAllMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    std::vector<ColumnarLogColumnData> subset;
+    reader.read({reader.time_column() >= 0 ? static_cast<size_t>(reader.time_column()) : 0}, subset);
+    const auto loadOneMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    if(!reader.write_csv(outputPath, separator)){
+        std::cerr << "Cannot write csv file " << outputPath << "\n";
+        return false;
+    }
+
+    // read back
+    start = steady_clock::now();
+    std::ifstream csv(outputPath, std::ios::binary);
+    std::string line;
+    std::getline(csv, line);
+    size_t idRow = 0;
+    size_t errors = 0;
+    while(std::getline(csv, line)){
+
+        size_t begin = 0;
+        for(size_t idC = 0; idC < data.size(); ++idC){
+
+            const auto end = idC + 1 < data.size() ? line.find(separator, begin) : line.size();
+            const auto cell = std::string_view(line).substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+            begin = end == std::string::npos ? line.size() : end + separator.size();
+
+            bool equal = false;
+            if(idRow < reader.rows_count()){
+                if(data[idC].type == ColumnarLogType::Real){
+                    const double expected = data[idC].reals[idRow];
+                    double value = std::numeric_limits<double>::quiet_NaN();
+                    std::from_chars(cell.data(), cell.data() + cell.size(), value);
+                    equal = std::isnan(expected) ? cell.empty() : value == expected;
+                }else{
+                    equal = cell == (*data[idC].dictionary)[data[idC].ids[idRow]];
+                }
+            }
+            if(!equal && errors++ < 10){
+                std::cerr << "Mismatch row " << idRow << " column " << reader.columns()[idC].name << ": [" << cell << "]\n";
+            }
+        }
+        ++idRow;
+    }
+    const auto parseCsvMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+    namespace fs = std::filesystem;
+    std::cout << "columns: " << reader.columns().size() << " rows: " << reader.rows_count() << " chunks: " << reader.chunks().size() << "\n";
+    std::cout << "size columnar: " << fs::file_size(inputPath) << " bytes, csv: " << fs::file_size(outputPath) << " bytes\n";
+    std::cout << "load all columns: " << loadAllMs << "ms, load one column: " << loadOneMs << "ms, parse csv: " << parseCsvMs << "ms\n";
+    if(errors != 0 || idRow != reader.rows_count()){
+        std::cerr << "Verification failed: " << errors << " mismatches, " << idRow << " csv rows\n";
+        return false;
+    }
+    std::cout << "Verification ok\n";
+    return true;
+}
+
+
+#include "ex_components/biopac_ex_component.hpp"
+
+// 16 channels at 2 kHz from the simulated device while the frame loop stalls regularly,
+// then the acquisition file is read back to check that no sample has been lost
+auto bench_biopac(int durationS, const std::string &path) -> bool{
+
+    using namespace std::chrono;
+
+    BiopacExComponent biopac;
+    biopac.set(ParametersContainer::InitConfig, "sampling_rate_id", 8);
+    biopac.set(ParametersContainer::InitConfig, "nb_samples_per_call", 100);
+    biopac.set(ParametersContainer::InitConfig, "debug_bypass", 1);
+    for(int ii = 0; ii < 16; ++ii){
+        biopac.set(ParametersContainer::InitConfig, std::format("channel{}", ii), 1);
+        biopac.set(ParametersContainer::InitConfig, std::format("channel{}_name", ii), std::format("ch{}", ii));
+    }
+    biopac.set(ParametersContainer::Dynamic, "path_file", path);
+    biopac.set_device(std::make_unique<SimulatedBiopacDevice>(true));
+
+    if(!biopac.initialize()){
+        return false;
+    }
+    biopac.start_experiment();
+
+    std::vector<float> plot(2*500);
+    const auto start = steady_clock::now();
+    size_t frames = 0;
+    double plotUs = 0.;
+    while(steady_clock::now() - start < seconds(durationS)){
+
+        // 90 fps with a 300ms hitch every 2 seconds
+        std::this_thread::sleep_for(frames % 180 == 179 ? milliseconds(300) : microseconds(11111));
+        const auto before = steady_clock::now();
+        for(size_t ii = 0; ii < 16; ++ii){
+            biopac.decimated_values(ii, 500, plot.data());
+        }
+        plotUs += duration<double, std::micro>(steady_clock::now() - before).count();
+        ++frames;
+    }
+    biopac.stop_experiment();
+
+    std::cout << "samples acquired: " << biopac.samples_count() << " written: " << biopac.samples_written() << " overflow: " << biopac.overflow_count() << "\n";
+    std::cout << "clock drift: " << biopac.clock_drift_ms() << "ms, decimated views per frame: " << plotUs/frames << "us\n";
+
+    ColumnarLogReader reader;
+    std::vector<ColumnarLogColumnData> data;
+    if(!reader.open(path) || !reader.read({0}, data)){
+        std::cerr << "Cannot read acquisition file " << path << "\n";
+        return false;
+    }
+    bool contiguous = data[0].reals.size() == biopac.samples_count();
+    for(size_t ii = 0; ii < data[0].reals.size() && contiguous; ++ii){
+        contiguous = data[0].reals[ii] == static_cast<double>(ii);
+    }
+    std::cout << "file rows: " << reader.rows_count() << " size: " << std::filesystem::file_size(path) << " bytes, contiguous samples: " << contiguous << "\n";
+    return contiguous && biopac.overflow_count() == 0;
+}
+
+#include "ex_components/udp_reader_ex_component.hpp"
+#include "ex_components/udp_writer_ex_component.hpp"
+
+// loopback benchmarks of the UDP components:
+// - latency: a thread emits 1 kHz packets carrying their send time while the frame loop runs at 90 fps with regular hitches
+// - rate: bursts of small packets are sent at each frame
+auto bench_udp(int durationS, int port) -> bool{
+
+    using namespace std::chrono;
+
+    struct Payload{
+        std::uint64_t id;
+        double sendMs;
+    };
+
+    auto percentile = [](std::vector<double> &values, double p){
+        if(values.empty()){
+            return 0.;
+        }
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size()-1, static_cast<size_t>(p*values.size()))];
+    };
+
+    UdpReaderExComponent reader;
+    reader.set(ParametersContainer::InitConfig, "reading_address", std::string("127.0.0.1"));
+    reader.set(ParametersContainer::InitConfig, "reading_port", port);
+    UdpWriterExComponent writer;
+    writer.set(ParametersContainer::InitConfig, "writing_address", std::string("127.0.0.1"));
+    writer.set(ParametersContainer::InitConfig, "writing_port", port);
+    if(!reader.initialize() || !writer.initialize()){
+        return false;
+    }
+
+    // latency
+    const auto start = steady_clock::now();
+    reader.start_experiment();
+    writer.start_experiment();
+
+    std::atomic_bool emit = true;
+    std::thread emitter([&]{
+        Payload payload{0, 0.};
+        auto next = steady_clock::now();
+        while(emit){
+            next += microseconds(1000);
+            std::this_thread::sleep_until(next);
+            payload.sendMs = duration<double, std::milli>(steady_clock::now() - start).count();
+            writer.send_packet(reinterpret_cast<const std::byte*>(&payload), sizeof(Payload));
+            writer.flush();
+            ++payload.id;
+        }
+    });
+
+    std::vector<double> latencies;
+    std::vector<double> frameDelays;
+    std::uint64_t expected = 0;
+    size_t gaps = 0;
+    auto read_frame = [&](){
+        reader.update();
+        const double frameMs = duration<double, std::milli>(steady_clock::now() - start).count();
+        const auto &packets  = reader.frame_packets();
+        for(size_t ii = 0; ii < packets.count(); ++ii){
+            Payload payload;
+            std::memcpy(&payload, packets.message_data(ii), sizeof(Payload));
+            gaps += payload.id != expected ? 1 : 0;
+            expected = payload.id + 1;
+            latencies.push_back(packets.timesMs[ii] - payload.sendMs);
+            frameDelays.push_back(frameMs - packets.timesMs[ii]);
+        }
+    };
+
+    size_t frames = 0;
+    while(steady_clock::now() - start < seconds(durationS)){
+        // 90 fps with a 100ms hitch every 2 seconds
+        std::this_thread::sleep_for(frames++ % 180 == 179 ? milliseconds(100) : microseconds(11111));
+        read_frame();
+    }
+    emit = false;
+    emitter.join();
+    writer.stop_experiment();
+    std::this_thread::sleep_for(milliseconds(20));
+    read_frame();
+    reader.stop_experiment();
+
+    const size_t sentLatency = writer.sent_count();
+    std::cout << std::format("latency: sent {} received {} gaps {} dropped {}/{}\n", sentLatency, expected, gaps, writer.dropped_count(), reader.dropped_count());
+    std::cout << std::format("send to stamp: p50 {:.3f}ms p99 {:.3f}ms max {:.3f}ms\n", percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 1.));
+    std::cout << std::format("stamp to frame: p50 {:.3f}ms p99 {:.3f}ms max {:.3f}ms\n", percentile(frameDelays, 0.5), percentile(frameDelays, 0.99), percentile(frameDelays, 1.));
+    const bool lossless = gaps == 0 && expected == sentLatency && writer.dropped_count() == 0 && reader.dropped_count() == 0;
+
+    // rate
+    reader.start_experiment();
+    writer.start_experiment();
+    const auto rateStart = steady_clock::now();
+    std::array<std::byte, 64> packet{};
+    size_t received = 0;
+    while(steady_clock::now() - rateStart < seconds(durationS)){
+        std::this_thread::sleep_for(microseconds(11111));
+        for(size_t ii = 0; ii < 2000; ++ii){
+            writer.send_packet(packet.data(), packet.size());
+        }
+        writer.post_update();
+        reader.update();
+        received += reader.frame_packets().count();
+    }
+    writer.stop_experiment();
+    std::this_thread::sleep_for(milliseconds(20));
+    reader.update();
+    received += reader.frame_packets().count();
+    reader.stop_experiment();
+
+    const double rateS = duration<double>(steady_clock::now() - rateStart).count();
+    std::cout << std::format("rate: sent {:.0f} packets/s received {:.0f} packets/s, dropped {}/{}\n",
+        writer.sent_count()/rateS, received/rateS, writer.dropped_count(), reader.dropped_count());
+
+    reader.clean();
+    writer.clean();
+    return lossless;
+}
+
+#include "ex_components/serial_port_reader_ex_component.hpp"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+
+// a pseudo-terminal stands in for the device: a thread writes 1 kHz messages split in two writes
+// for each framing mode, the frame loop runs at 90 fps with regular hitches and checks that every message is received in order
+auto bench_serial(int durationS) -> bool{
+
+    using namespace std::chrono;
+
+    struct Mode{
+        SerialFraming framing;
+        std::string name;
+    };
+
+    bool success = true;
+    for(const auto &mode : {Mode{SerialFraming::Delimiter, "delimiter"}, Mode{SerialFraming::FixedLength, "fixed length"}, Mode{SerialFraming::BinaryStruct, "binary struct"}}){
+
+        const int master = posix_openpt(O_RDWR | O_NOCTTY);
+        if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+            std::cerr << "Cannot create pseudo-terminal\n";
+            return false;
+        }
+
+        SerialPortReaderExComponent serial;
+        serial.set(ParametersContainer::InitConfig, "port_to_read", std::string(ptsname(master)));
+        serial.set(ParametersContainer::InitConfig, "baud_rate", 115200);
+        serial.set(ParametersContainer::InitConfig, "framing_mode", static_cast<int>(mode.framing));
+        serial.set(ParametersContainer::InitConfig, "delimiter", std::string("\\r\\n"));
+        serial.set(ParametersContainer::InitConfig, "message_length", 16);
+        serial.set(ParametersContainer::InitConfig, "struct_format", std::string(">Id"));
+        if(!serial.initialize()){
+            ::close(master);
+            return false;
+        }
+
+        const auto start = steady_clock::now();
+        serial.start_experiment();
+
+        std::atomic_bool emit = true;
+        std::thread emitter([&]{
+            std::uint64_t id = 0;
+            auto next = steady_clock::now();
+            std::vector<std::byte> message;
+            while(emit){
+                next += microseconds(1000);
+                std::this_thread::sleep_until(next);
+                const double sendMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+                if(mode.framing == SerialFraming::Delimiter){
+                    const auto text = std::format("{};{}\r\n", id, sendMs);
+                    message.resize(text.size());
+                    std::memcpy(message.data(), text.data(), text.size());
+                }else if(mode.framing == SerialFraming::FixedLength){
+                    message.resize(16);
+                    std::memcpy(message.data(), &id, 8);
+                    std::memcpy(message.data() + 8, &sendMs, 8);
+                }else{
+                    // big endian
+                    const auto id32 = static_cast<std::uint32_t>(id);
+                    message.resize(12);
+                    std::memcpy(message.data(), &id32, 4);
+                    std::memcpy(message.data() + 4, &sendMs, 8);
+                    std::reverse(message.begin(), message.begin() + 4);
+                    std::reverse(message.begin() + 4, message.end());
+                }
+
+                const size_t split = 1 + id % (message.size() - 1);
+                if(::write(master, message.data(), split) < 0 || ::write(master, message.data() + split, message.size() - split) < 0){
+                    break;
+                }
+                ++id;
+            }
+        });
+
+        std::vector<double> latencies;
+        std::uint64_t expected = 0;
+        size_t gaps = 0;
+        auto read_frame = [&](){
+            serial.update();
+            const auto &messages = serial.frame_messages();
+            for(size_t ii = 0; ii < messages.count(); ++ii){
+
+                std::uint64_t id = 0;
+                double sendMs = 0.;
+                if(mode.framing == SerialFraming::Delimiter){
+                    const auto text = std::string_view(reinterpret_cast<const char*>(messages.message_data(ii)), messages.message_size(ii));
+                    const auto separator = text.find(';');
+                    std::from_chars(text.data(), text.data() + separator, id);
+                    sendMs = std::stod(std::string(text.substr(separator + 1)));
+                }else if(mode.framing == SerialFraming::FixedLength){
+                    std::memcpy(&id, messages.message_data(ii), 8);
+                    std::memcpy(&sendMs, messages.message_data(ii) + 8, 8);
+                }else{
+                    std::array<double,2> values;
+                    serial.message_values(ii, values.data());
+                    id     = static_cast<std::uint64_t>(values[0]);
+                    sendMs = values[1];
+                }
+
+                gaps += id != expected ? 1 : 0;
+                expected = id + 1;
+                latencies.push_back(messages.timesMs[ii] - sendMs);
+            }
+        };
+
+        size_t frames = 0;
+        while(steady_clock::now() - start < seconds(durationS)){
+            // 90 fps with a 100ms hitch every 2 seconds
+            std::this_thread::sleep_for(frames++ % 180 == 179 ? milliseconds(100) : microseconds(11111));
+            read_frame();
+        }
+        emit = false;
+        emitter.join();
+        std::this_thread::sleep_for(milliseconds(20));
+        read_frame();
+        serial.stop_experiment();
+        serial.clean();
+        ::close(master);
+
+        std::sort(latencies.begin(), latencies.end());
+        const bool lossless = gaps == 0 && expected == serial.received_count() && serial.dropped_count() == 0 && serial.discarded_bytes() == 0;
+        std::cout << std::format("{}: received {} gaps {} dropped {} discarded bytes {}, write to stamp p50 {}ms max {}ms\n",
+            mode.name, serial.received_count(), gaps, serial.dropped_count(), serial.discarded_bytes(),
+            latencies.empty() ? 0. : latencies[latencies.size()/2], latencies.empty() ? 0. : latencies.back());
+        success = success && lossless && expected > 0;
+    }
+    return success;
+}
+#endif
+
+#include "ex_components/video_decoder_ex_component.hpp"
+
+// plays a video at 90 fps with regular hitches and a seek every 5 seconds, then prints the decoder counters
+auto bench_video(const std::string &path, int durationS) -> bool{
+
+    using namespace std::chrono;
+
+    VideoDecoderExComponent video;
+    video.set(ParametersContainer::Dynamic, "path_video", path);
+    video.set(ParametersContainer::InitConfig, "frames_ring_size", 6);
+    video.set(ParametersContainer::InitConfig, "loop", 1);
+    if(!video.initialize()){
+        return false;
+    }
+    const auto &infos = video.infos();
+    std::cout << std::format("video {}x{} {} fps {} frames\n", infos.width, infos.height, infos.fps, infos.framesCount);
+
+    video.start_experiment();
+    video.play();
+
+    const auto start = steady_clock::now();
+    size_t frames = 0;
+    size_t seeks = 0;
+    size_t inaccurateSeeks = 0;
+    while(steady_clock::now() - start < seconds(durationS)){
+
+        // 90 fps with a 100ms hitch every 2 seconds
+        std::this_thread::sleep_for(frames % 180 == 179 ? milliseconds(100) : microseconds(11111));
+        video.update();
+
+        if(frames % 450 == 449){
+            // paused frame accurate seek
+            video.pause();
+            const double targetMs = std::fmod(1000. * seeks * 7.3, 1000. * infos.framesCount / infos.fps);
+            video.seek(targetMs);
+            const auto seekStart = steady_clock::now();
+            const auto expected  = static_cast<std::int64_t>(std::floor(targetMs * infos.fps / 1000. + 1e-6));
+            while(video.current_frame_index() != expected && steady_clock::now() - seekStart < seconds(2)){
+                std::this_thread::sleep_for(milliseconds(1));
+                video.update();
+            }
+            inaccurateSeeks += video.current_frame_index() != expected ? 1 : 0;
+            std::cout << std::format("seek to frame {} in {}ms\n", expected, duration<double, std::milli>(steady_clock::now() - seekStart).count());
+            ++seeks;
+            video.play();
+        }
+        ++frames;
+    }
+
+    std::cout << std::format("decoded {} dropped {} late updates {} decode latency avg {}ms max {}ms\n",
+        video.decoded_frames_count(), video.dropped_frames_count(), video.late_updates_count(),
+        video.average_decode_latency_ms(), video.max_decode_latency_ms());
+    video.stop_experiment();
+    video.clean();
+    return inaccurateSeeks == 0;
+}
+
+#include "ex_components/frames_synchronizer.hpp"
+
+// simulated cameras capturing at 30 fps with small phase offsets, random transmission latencies,
+// lost frames and a regular 500ms stall of the last camera, compares the latest frames of each camera with the synchronized sets
+auto bench_k4_sync(int camerasCount, int durationS) -> bool{
+
+    using namespace std::chrono;
+
+    struct SimulatedFrame{
+        size_t idCamera = 0;
+        std::int64_t captureNs = 0;
+    };
+
+    FramesSyncSettings settings;
+    settings.toleranceNs    = 8'000'000;
+    settings.bufferSize     = 4;
+    settings.latestFallback = true;
+    FramesSynchronizer<SimulatedFrame> synchronizer;
+    synchronizer.reset(camerasCount, settings);
+
+    std::mutex latestL;
+    std::vector<std::shared_ptr<SimulatedFrame>> latest(camerasCount);
+
+    std::atomic_bool running = true;
+    const auto start = steady_clock::now();
+    std::vector<std::thread> cameras;
+    for(int idC = 0; idC < camerasCount; ++idC){
+        cameras.emplace_back([&,idC]{
+            std::mt19937 gen(idC);
+            std::uniform_int_distribution<int> latencyUs(2000, 25000);
+            std::uniform_int_distribution<int> loss(0, 99);
+            for(std::int64_t idF = 0; running; ++idF){
+                const auto capture = start + nanoseconds(idF * 33'333'333 + idC * 160'000);
+                if(idC == camerasCount - 1 && (capture - start) % seconds(5) < milliseconds(500)){
+                    std::this_thread::sleep_until(capture);
+                    continue;
+                }
+                std::this_thread::sleep_until(capture + microseconds(latencyUs(gen)));
+                if(loss(gen) < 3){
+                    continue;
+                }
+                auto frame = std::make_shared<SimulatedFrame>(SimulatedFrame{static_cast<size_t>(idC), duration_cast<nanoseconds>(capture.time_since_epoch()).count()});
+                synchronizer.push(idC, frame->captureNs, frame);
+                std::lock_guard<std::mutex> lock(latestL);
+                latest[idC] = frame;
+            }
+        });
+    }
+
+    auto skew_ms = [](const auto &frames){
+        std::int64_t minTs = std::numeric_limits<std::int64_t>::max();
+        std::int64_t maxTs = std::numeric_limits<std::int64_t>::min();
+        for(const auto &frame : frames){
+            if(frame == nullptr){
+                return -1.;
+            }
+            minTs = std::min(minTs, frame->captureNs);
+            maxTs = std::max(maxTs, frame->captureNs);
+        }
+        return (maxTs - minTs) * 1e-6;
+    };
+
+    // 90 fps reading loop
+    double latestSkewSum = 0., latestSkewMax = 0.;
+    size_t latestCount = 0;
+    std::vector<std::shared_ptr<SimulatedFrame>> published(camerasCount);
+    while(steady_clock::now() - start < seconds(durationS)){
+        std::this_thread::sleep_for(microseconds(11111));
+        {
+            std::lock_guard<std::mutex> lock(latestL);
+            if(const auto skew = skew_ms(latest); skew >= 0.){
+                latestSkewSum += skew;
+                latestSkewMax  = std::max(latestSkewMax, skew);
+                ++latestCount;
+            }
+        }
+        synchronizer.update();
+    }
+    running = false;
+    for(auto &camera : cameras){
+        camera.join();
+    }
+
+    const auto stats = synchronizer.statistics();
+    std::cout << std::format("latest frames skew avg {}ms max {}ms\n", latestCount > 0 ? latestSkewSum / latestCount : 0., latestSkewMax);
+    std::cout << std::format("synchronized sets {} skew avg {}ms max {}ms, fallbacks {}, dropped frames {}\n",
+        stats.setsCount, stats.averageSkewMs, stats.maxSkewMs, stats.fallbacksCount, stats.droppedFrames);
+    return stats.setsCount > 0 && stats.maxSkewMs <= settings.toleranceNs * 1e-6;
+}
+
+#include "ex_components/cloud_fusion.hpp"
+#include "ex_components/cloud_decimation.hpp"
+
+// 6 cameras of 300k points around the same body: per camera transformed copies against the fused buffer, with and without overlaps removal,
+// then with the inputs decimated to a per camera budget
+auto bench_cloud_fusion(int iterations) -> bool{
+
+    using namespace std::chrono;
+
+    const size_t camerasCount = 6;
+    const size_t pointsCount  = 300000;
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    std::vector<std::vector<float>> positions(camerasCount);
+    std::vector<std::vector<float>> colors(camerasCount);
+    std::vector<CloudFusionInput> inputs(camerasCount);
+    for(size_t idC = 0; idC < camerasCount; ++idC){
+
+        // camera space points of a 1.7m cylinder seen from 6 angles
+        const float angle = static_cast<float>(idC) * 1.0472f;
+        positions[idC].resize(pointsCount*3);
+        colors[idC].resize(pointsCount*3);
+        for(size_t id = 0; id < pointsCount; ++id){
+            const float theta = (unit(gen) - 0.5f) * 2.f;
+            positions[idC][id*3+0] = 0.25f * std::sin(theta);
+            positions[idC][id*3+1] = unit(gen) * 1.7f;
+            positions[idC][id*3+2] = 2.f - 0.25f * std::cos(theta) + unit(gen) * 0.003f;
+            colors[idC][id*3+0] = unit(gen);
+            colors[idC][id*3+1] = unit(gen);
+            colors[idC][id*3+2] = unit(gen);
+        }
+
+        // cameras on a 2m circle looking at the center
+        auto &input = inputs[idC];
+        input.positions = positions[idC].data();
+        input.colorsF   = colors[idC].data();
+        input.count     = pointsCount;
+        input.transform = {
+            std::cos(angle), 0.f, -std::sin(angle), 0.f,
+            0.f, 1.f, 0.f, 0.f,
+            std::sin(angle), 0.f, std::cos(angle), 0.f,
+            -2.f*std::sin(angle), 0.f, -2.f*std::cos(angle), 1.f
+        };
+    }
+
+    // reference: one transformed buffer per camera
+    std::vector<std::vector<FusedVertex>> perCamera(camerasCount, std::vector<FusedVertex>(pointsCount));
+    const auto startPerCamera = steady_clock::now();
+    for(int ii = 0; ii < iterations; ++ii){
+        for(size_t idC = 0; idC < camerasCount; ++idC){
+            const auto &m = inputs[idC].transform;
+            for(size_t id = 0; id < pointsCount; ++id){
+                const float *p = inputs[idC].positions + id*3;
+                const float *c = inputs[idC].colorsF + id*3;
+                auto &v = perCamera[idC][id];
+                v.x = p[0]*m[0] + p[1]*m[4] + p[2]*m[8]  + m[12];
+                v.y = p[0]*m[1] + p[1]*m[5] + p[2]*m[9]  + m[13];
+                v.z = p[0]*m[2] + p[1]*m[6] + p[2]*m[10] + m[14];
+                v.r = static_cast<std::uint8_t>(c[0]*255.f);
+                v.g = static_cast<std::uint8_t>(c[1]*255.f);
+                v.b = static_cast<std::uint8_t>(c[2]*255.f);
+            }
+        }
+    }
+    const double perCameraMs = duration<double, std::milli>(steady_clock::now() - startPerCamera).count() / iterations;
+    std::cout << std::format("per camera copies: {}ms per frame\n", perCameraMs);
+
+    CloudFusion fusion;
+    bool valid = true;
+    for(bool removeOverlaps : {false, true}){
+        CloudFusionSettings settings;
+        settings.removeOverlaps = removeOverlaps;
+        settings.voxelSize      = 0.005f;
+        fusion.set_settings(settings);
+
+        double totalMs = 0.;
+        size_t count = 0;
+        for(int ii = 0; ii < iterations; ++ii){
+            count    = fusion.fuse(inputs);
+            totalMs += fusion.last_duration_ms();
+        }
+        std::cout << std::format("fused{}: {} points ({} removed) {}ms per frame, {} Mpts/s\n",
+            removeOverlaps ? " without overlaps" : "", count, fusion.removed_points_count(),
+            totalMs / iterations, (camerasCount * pointsCount * iterations) / (totalMs * 1000.));
+
+        if(!removeOverlaps){
+            // same positions as the per camera copies
+            const auto fused = fusion.vertices();
+            for(size_t idC = 0; idC < camerasCount && valid; ++idC){
+                for(size_t id = 0; id < pointsCount; id += 997){
+                    const auto &v1 = fused[idC*pointsCount + id];
+                    const auto &v2 = perCamera[idC][id];
+                    valid &= std::abs(v1.x - v2.x) < 1e-5f && std::abs(v1.y - v2.y) < 1e-5f && std::abs(v1.z - v2.z) < 1e-5f && v1.r == v2.r;
+                }
+            }
+            valid &= count == camerasCount * pointsCount;
+        }else{
+            valid &= count < camerasCount * pointsCount;
+        }
+    }
+
+    // per camera budgets applied to the fusion inputs
+    std::vector<CloudDecimation> decimations(camerasCount);
+    auto decimatedInputs = inputs;
+    size_t keptTotal = 0;
+    for(size_t idC = 0; idC < camerasCount; ++idC){
+        decimations[idC].set_settings({CloudDecimationMode::VoxelGrid, 50000});
+        decimations[idC].decimate(inputs[idC].positions, 3*sizeof(float), pointsCount);
+        decimatedInputs[idC].indices = decimations[idC].kept_indices().data();
+        decimatedInputs[idC].count   = decimations[idC].output_count();
+        keptTotal += decimations[idC].output_count();
+    }
+    CloudFusionSettings settings;
+    fusion.set_settings(settings);
+    double decimatedMs = 0.;
+    for(int ii = 0; ii < iterations; ++ii){
+        valid &= fusion.fuse(decimatedInputs) == keptTotal;
+        decimatedMs += fusion.last_duration_ms();
+    }
+    std::cout << std::format("fused decimated inputs: {} points {}ms per frame\n", keptTotal, decimatedMs / iterations);
+
+    const auto fused = fusion.vertices();
+    for(size_t idC = 0, offset = 0; idC < camerasCount && valid; offset += decimatedInputs[idC].count, ++idC){
+        const auto kept = decimations[idC].kept_indices();
+        for(size_t id = 0; id < kept.size(); id += 97){
+            const auto &v1 = fused[offset + id];
+            const auto &v2 = perCamera[idC][kept[id]];
+            valid &= std::abs(v1.x - v2.x) < 1e-5f && std::abs(v1.y - v2.y) < 1e-5f && std::abs(v1.z - v2.z) < 1e-5f && v1.r == v2.r;
+        }
+    }
+    return valid;
+}
+
+// 300k points camera cloud copied to the caller at full resolution, then decimated with several points budgets
+auto bench_cloud_decimation(int iterations) -> bool{
+
+    using namespace std::chrono;
+
+    const size_t pointsCount = 300000;
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    // front half of a 1.7m cylinder 2m away from the camera
+    std::vector<geo::Pt3f> positions(pointsCount);
+    std::vector<geo::Pt3f> colors(pointsCount);
+    for(size_t id = 0; id < pointsCount; ++id){
+        const float theta = (unit(gen) - 0.5f) * 3.1416f;
+        positions[id] = {0.25f * std::sin(theta), unit(gen) * 1.7f, 2.f - 0.25f * std::cos(theta) + unit(gen) * 0.003f};
+        colors[id]    = {unit(gen), unit(gen), unit(gen)};
+    }
+
+    std::vector<camera::K4VertexMeshData> output(pointsCount);
+    auto copy_vertex = [&](size_t idDst, size_t idSrc){
+        output[idDst].pos = positions[idSrc];
+        output[idDst].col = geo::Pt4<std::uint8_t>{
+            static_cast<std::uint8_t>(colors[idSrc].x()*255.f),
+            static_cast<std::uint8_t>(colors[idSrc].y()*255.f),
+            static_cast<std::uint8_t>(colors[idSrc].z()*255.f),
+            255
+        };
+    };
+
+    const auto startFull = steady_clock::now();
+    for(int ii = 0; ii < iterations; ++ii){
+        for(size_t id = 0; id < pointsCount; ++id){
+            copy_vertex(id, id);
+        }
+    }
+    const double fullMs = duration<double, std::milli>(steady_clock::now() - startFull).count() / iterations;
+    std::cout << std::format("full resolution copy: {} points {}ms per frame\n", pointsCount, fullMs);
+
+    bool valid = true;
+    for(auto mode : {CloudDecimationMode::Stride, CloudDecimationMode::VoxelGrid}){
+
+        // one instance per camera, the voxel size is kept between frames
+        CloudDecimation decimation;
+        for(size_t budget : {200000, 100000, 50000, 10000}){
+
+            decimation.set_settings({mode, budget});
+            double decimationMs = 0.;
+            const auto start = steady_clock::now();
+            for(int ii = 0; ii < iterations; ++ii){
+                decimation.decimate(positions.data(), sizeof(geo::Pt3f), pointsCount);
+                decimationMs += decimation.last_duration_ms();
+                const auto kept = decimation.kept_indices();
+                for(size_t id = 0; id < kept.size(); ++id){
+                    copy_vertex(id, kept[id]);
+                }
+            }
+            const double totalMs = duration<double, std::milli>(steady_clock::now() - start).count() / iterations;
+            decimationMs /= iterations;
+
+            std::cout << std::format("{} budget {}: {} points, decimation {}ms + copy {}ms per frame, {} Mpts/s\n",
+                mode == CloudDecimationMode::Stride ? "stride" : "voxel grid", budget, decimation.output_count(),
+                decimationMs, totalMs - decimationMs, pointsCount / (totalMs * 1000.));
+
+            const auto kept = decimation.kept_indices();
+            valid &= decimation.output_count() <= budget && decimation.output_count() > budget / 2;
+            valid &= std::is_sorted(kept.begin(), kept.end()) && std::adjacent_find(kept.begin(), kept.end()) == kept.end();
+        }
+    }
+    return valid;
+}
+
+#include "ex_resources/k4_decoded_frames_cache.hpp"
+
+// a short loop of nbFrames C4F frames of one camera played twice with the default budget,
+// every frame is decoded during the first pass and read from the cache during the second one
+auto bench_frames_cache(int nbFrames) -> bool{
+
+    using namespace std::chrono;
+
+    const size_t framesCount   = static_cast<size_t>(std::max(nbFrames, 1));
+    const size_t verticesCount = 200000;
+    std::vector<geo::Pt3f> vertices(verticesCount);
+    std::vector<geo::Pt4f> colors(verticesCount);
+
+    // stands in for the frame uncompression
+    size_t decodesCount = 0;
+    auto decode = [&](size_t idFrame){
+        const float offset = static_cast<float>(idFrame) * 0.001f;
+        for(size_t id = 0; id < verticesCount; ++id){
+            const float v = static_cast<float>(id) * 1e-5f;
+            vertices[id] = {std::sin(v) + offset, std::cos(v), v};
+            colors[id]   = {v, 1.f - v, offset, 1.f};
+        }
+        ++decodesCount;
+    };
+
+    K4DecodedFramesCache cache;
+    bool valid = true;
+    for(size_t pass = 1; pass <= 2; ++pass){
+
+        const auto start = steady_clock::now();
+        for(size_t idFrame = 0; idFrame < framesCount; ++idFrame){
+            if(auto decoded = cache.get(0, idFrame, K4DecodedFrameFormat::C4F)){
+                std::copy(std::begin(decoded->vertices), std::end(decoded->vertices), vertices.data());
+                std::copy(std::begin(decoded->colorsF), std::end(decoded->colorsF), colors.data());
+                continue;
+            }
+
+            decode(idFrame);
+            auto decoded = std::make_shared<K4DecodedFrame>();
+            decoded->verticesCount = verticesCount;
+            decoded->vertices.assign(std::begin(vertices), std::end(vertices));
+            decoded->colorsF.assign(std::begin(colors), std::end(colors));
+            cache.insert(0, idFrame, K4DecodedFrameFormat::C4F, std::move(decoded));
+        }
+        const double passMs = duration<double, std::milli>(steady_clock::now() - start).count();
+
+        std::cout << std::format("pass {}: {} frames {}ms per frame, decodes {}, hits {}, misses {}, cache {} frames {} MB\n",
+            pass, framesCount, passMs / framesCount, decodesCount, cache.hits(), cache.misses(), cache.count(), cache.used_bytes() / (1024*1024));
+
+        valid &= cache.misses() == framesCount && cache.hits() == (pass - 1) * framesCount && decodesCount == framesCount;
+    }
+
+    if(!valid){
+        std::cerr << std::format("frames decoded after the first pass, {} MB budget\n", cache.budget() / (1024*1024));
+    }
+    return valid;
+}
+
 int main(int argc, char *argv[]){
 
+    if(argc > 1 && std::string(argv[1]) == "bench_logger"){
+        bench_logger(argc > 2 ? std::stoi(argv[2]) : 3600, argc > 3 ? argv[3] : "bench_logger.csv");
+        return 0;
+    }
+    if(argc > 1 && std::string(argv[1]) == "bench_biopac"){
+        return bench_biopac(argc > 2 ? std::stoi(argv[2]) : 60, argc > 3 ? argv[3] : "bench_biopac.exlog") ? 0 : -1;
+    }
+    if(argc > 1 && std::string(argv[1]) == "bench_udp"){
+        return bench_udp(argc > 2 ? std::stoi(argv[2]) : 10, argc > 3 ? std::stoi(argv[3]) : 8061) ? 0 : -1;
+    }
+#ifdef __linux__
+    if(argc > 1 && std::string(argv[1]) == "bench_serial"){
+        return bench_serial(argc > 2 ? std::stoi(argv[2]) : 10) ? 0 : -1;
+    }
+#endif
+    if(argc > 2 && std::string(argv[1]) == "bench_video"){
+        return bench_video(argv[2], argc > 3 ? std::stoi(argv[3]) : 30) ? 0 : -1;
+    }
+    if(argc > 1 && std::string(argv[1]) == "bench_k4_sync"){
+        return bench_k4_sync(argc > 2 ? std::stoi(argv[2]) : 4, argc > 3 ? std::stoi(argv[3]) : 30) ? 0 : -1;
+    }
+    if(argc > 1 && std::string(argv[1]) == "bench_cloud_fusion"){
+        return bench_cloud_fusion(argc > 2 ? std::stoi(argv[2]) : 100) ? 0 : -1;
+    }
+    if(argc > 1 && std::string(argv[1]) == "bench_cloud_decimation"){
+        return bench_cloud_decimation(argc > 2 ? std::stoi(argv[2]) : 100) ? 0 : -1;
+    }
+    if(argc > 1 && std::string(argv[1]) == "bench_frames_cache"){
+        return bench_frames_cache(argc > 2 ? std::stoi(argv[2]) : 60) ? 0 : -1;
+    }
+    if(argc > 3 && std::string(argv[1]) == "to_csv"){
+        return columnar_log_to_csv(argv[2], argv[3], argc > 4 ? argv[4] : ";") ? 0 : -1;
+    }
+
     test_k4_video();
 
 
@@ -0,0 +1,80 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "biopac_device.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <thread>
+
+using namespace tool::ex;
+
+auto SimulatedBiopacDevice::start(const BiopacSettings &settings) -> bool{
+
+    if(settings.channels_count() == 0 || settings.samplingRate <= 0.){
+        return false;
+    }
+
+    m_rate           = settings.samplingRate;
+    m_channels       = settings.channels_count();
+    m_samplesPerRead = std::max<size_t>(settings.samplesPerRead, 1);
+    m_produced       = 0;
+    m_start          = std::chrono::steady_clock::now();
+    return true;
+}
+
+auto SimulatedBiopacDevice::read(double *frames, size_t maxFrames) -> size_t{
+
+    size_t count = std::min(m_samplesPerRead, maxFrames);
+    if(m_realTime){
+
+        // wait until the device would have acquired the block
+        const auto blockEnd = m_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>((m_produced + count) / m_rate)
+        );
+        std::this_thread::sleep_until(blockEnd);
+
+        // late reads return every sample acquired meanwhile, like the device buffer
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        const auto acquired = static_cast<std::uint64_t>(elapsed * m_rate);
+        count = static_cast<size_t>(std::clamp<std::uint64_t>(acquired - m_produced, count, maxFrames));
+    }
+
+    for(size_t ii = 0; ii < count; ++ii){
+        const double t = (m_produced + ii) / m_rate;
+        for(size_t jj = 0; jj < m_channels; ++jj){
+            // xorshift noise
+            m_noise ^= m_noise << 13;
+            m_noise ^= m_noise >> 17;
+            m_noise ^= m_noise << 5;
+            frames[ii*m_channels + jj] = std::sin(2.*std::numbers::pi*(jj+1)*t) + (m_noise % 1000) * 0.0001;
+        }
+    }
+    m_produced += count;
+    return count;
+}
+
+auto SimulatedBiopacDevice::stop() -> void{
+}
@@ -0,0 +1,79 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tool::ex {
+
+struct BiopacSettings{
+
+    static constexpr std::array<double,14> samplingRates = {
+        10., 25., 50., 100., 200., 250., 500., 1000., 2000., 2500., 5000., 10000., 20000., 25000.
+    };
+
+    double samplingRate = 1000.;
+    size_t samplesPerRead = 100;            /**< frames asked to the device at each read */
+    std::vector<std::string> channelsName;
+
+    auto channels_count() const noexcept -> size_t{return channelsName.size();}
+};
+
+// acquisition backend, read is called in loop from the acquisition thread
+class BiopacDevice{
+public:
+    virtual ~BiopacDevice() = default;
+
+    virtual auto start(const BiopacSettings &settings) -> bool = 0;
+    // waits for the next block, fills frames with interleaved channels values and returns the frames count
+    virtual auto read(double *frames, size_t maxFrames) -> size_t = 0;
+    virtual auto stop() -> void = 0;
+};
+
+// sine waves plus noise at the sampling rate, blocks are paced by the system clock if realTime is enabled
+class SimulatedBiopacDevice : public BiopacDevice{
+public:
+
+    SimulatedBiopacDevice(bool realTime = true) : m_realTime(realTime){}
+
+    auto start(const BiopacSettings &settings) -> bool override;
+    auto read(double *frames, size_t maxFrames) -> size_t override;
+    auto stop() -> void override;
+
+private:
+
+    bool m_realTime;
+    double m_rate = 1000.;
+    size_t m_channels = 0;
+    size_t m_samplesPerRead = 100;
+    std::uint64_t m_produced = 0;
+    std::uint32_t m_noise = 1;
+    std::chrono::steady_clock::time_point m_start;
+};
+}
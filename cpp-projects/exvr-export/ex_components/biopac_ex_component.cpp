@@ -0,0 +1,375 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "biopac_ex_component.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <thread>
+
+// local
+#include "logger_columnar_file.hpp"
+
+using namespace std::chrono;
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace {
+
+// single producer (acquisition thread) / single consumer (writer thread) ring of frames: [sample index, channels values...]
+struct FramesRing{
+
+    auto reset(size_t capacityFrames, size_t channelsCount) -> void{
+        stride   = channelsCount + 1;
+        capacity = capacityFrames;
+        data.assign(capacity*stride, 0.);
+        head = 0;
+        tail = 0;
+    }
+
+    auto push(const double *frames, size_t count, std::uint64_t firstIndex) -> bool{
+
+        const size_t h = head.load(std::memory_order_relaxed);
+        if(capacity - (h - tail.load(std::memory_order_acquire)) < count){
+            return false;
+        }
+
+        for(size_t ii = 0; ii < count; ++ii){
+            double *frame = data.data() + ((h + ii) % capacity)*stride;
+            frame[0] = static_cast<double>(firstIndex + ii);
+            std::memcpy(frame + 1, frames + ii*(stride-1), (stride-1)*sizeof(double));
+        }
+        head.store(h + count, std::memory_order_release);
+        return true;
+    }
+
+    auto available() const noexcept -> size_t{
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+
+    auto frame(size_t offset) const noexcept -> const double*{
+        return data.data() + ((tail.load(std::memory_order_relaxed) + offset) % capacity)*stride;
+    }
+
+    auto pop(size_t count) noexcept -> void{
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    std::vector<double> data;
+    size_t stride = 1;
+    size_t capacity = 0;
+    alignas(64) std::atomic<size_t> head = 0;
+    alignas(64) std::atomic<size_t> tail = 0;
+};
+
+constexpr size_t ringSeconds    = 30;
+constexpr size_t plotRate       = 250;  /**< decimated buckets per second */
+constexpr size_t plotSeconds    = 10;
+constexpr auto writerInterval   = milliseconds(50);
+}
+
+struct BiopacExComponent::Impl{
+
+    BiopacSettings settings;
+    std::unique_ptr<BiopacDevice> device = nullptr;
+    FramesRing ring;
+
+    std::thread acquisition;
+    std::thread writer;
+    std::atomic_bool acquire = false;
+    std::mutex writerL;
+    std::condition_variable writerC;
+    bool stopWriter = false;
+
+    steady_clock::time_point experimentStart;
+    double acquisitionStartMs = 0.;
+    std::atomic<size_t> samplesCount = 0;
+    std::atomic<size_t> samplesWritten = 0;
+    std::atomic<size_t> overflowCount = 0;
+    std::atomic<double> clockDriftMs = 0.;
+
+    ColumnarLogWriter file;
+    std::vector<ColumnarLogValue> values;
+
+    // plot
+    mutable std::mutex plotL;
+    size_t bucketFrames = 1;
+    size_t plotBuckets = plotRate*plotSeconds;
+    size_t plotCount = 0;
+    std::vector<float> plotMin;
+    std::vector<float> plotMax;
+    std::vector<float> currentMin;
+    std::vector<float> currentMax;
+    size_t currentCount = 0;
+    std::vector<double> latest;
+
+    auto acquisition_loop() -> void{
+
+        const size_t channels = settings.channels_count();
+        // late reads can return more than the asked block
+        const size_t maxFrames = settings.samplesPerRead * 8;
+        std::vector<double> block(maxFrames * channels);
+
+        const auto start = steady_clock::now();
+        acquisitionStartMs = duration<double, std::milli>(start - experimentStart).count();
+
+        std::uint64_t index = 0;
+        while(acquire){
+
+            const size_t count = device->read(block.data(), maxFrames);
+            if(count == 0){
+                continue;
+            }
+
+            if(!ring.push(block.data(), count, index)){
+                overflowCount += count;
+            }
+            index += count;
+            samplesCount = index;
+
+            // device clock against host clock
+            clockDriftMs = duration<double, std::milli>(steady_clock::now() - start).count() - 1000.*index/settings.samplingRate;
+        }
+    }
+
+    auto consume() -> void{
+
+        const size_t channels  = settings.channels_count();
+        const size_t available = ring.available();
+        if(available == 0){
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(plotL);
+        for(size_t ii = 0; ii < available; ++ii){
+
+            const double *frame = ring.frame(ii);
+
+            if(file.is_opened()){
+                values[0].real = frame[0];
+                values[1].real = acquisitionStartMs + 1000.*frame[0]/settings.samplingRate;
+                for(size_t jj = 0; jj < channels; ++jj){
+                    values[2 + jj].real = frame[1 + jj];
+                }
+                file.add_row(values);
+            }
+
+            for(size_t jj = 0; jj < channels; ++jj){
+                const auto value = static_cast<float>(frame[1 + jj]);
+                currentMin[jj] = currentCount == 0 ? value : std::min(currentMin[jj], value);
+                currentMax[jj] = currentCount == 0 ? value : std::max(currentMax[jj], value);
+            }
+            if(++currentCount == bucketFrames){
+                const size_t idBucket = plotCount++ % plotBuckets;
+                for(size_t jj = 0; jj < channels; ++jj){
+                    plotMin[jj*plotBuckets + idBucket] = currentMin[jj];
+                    plotMax[jj*plotBuckets + idBucket] = currentMax[jj];
+                }
+                currentCount = 0;
+            }
+        }
+        std::copy(ring.frame(available-1) + 1, ring.frame(available-1) + 1 + channels, latest.begin());
+        lock.unlock();
+
+        ring.pop(available);
+        samplesWritten += available;
+    }
+
+    auto writer_loop() -> void{
+
+        std::unique_lock<std::mutex> lock(writerL);
+        while(!stopWriter){
+            writerC.wait_for(lock, writerInterval, [&]{return stopWriter;});
+            lock.unlock();
+            consume();
+            file.flush();
+            lock.lock();
+        }
+    }
+
+    auto stop() -> void{
+
+        if(acquisition.joinable()){
+            acquire = false;
+            acquisition.join();
+            device->stop();
+        }
+
+        if(writer.joinable()){
+            writerL.lock();
+            stopWriter = true;
+            writerL.unlock();
+            writerC.notify_one();
+            writer.join();
+        }
+
+        consume();
+        file.close();
+    }
+};
+
+BiopacExComponent::BiopacExComponent() : i(std::make_unique<Impl>()){
+}
+
+BiopacExComponent::~BiopacExComponent(){
+    i->stop();
+}
+
+auto BiopacExComponent::initialize() -> bool{
+
+    const auto rateId = std::clamp(get<int>(ParametersContainer::InitConfig, "sampling_rate_id"), 0, static_cast<int>(BiopacSettings::samplingRates.size())-1);
+    i->settings.samplingRate   = BiopacSettings::samplingRates[rateId];
+    i->settings.samplesPerRead = static_cast<size_t>(std::max(get<int>(ParametersContainer::InitConfig, "nb_samples_per_call"), 1));
+
+    i->settings.channelsName.clear();
+    for(size_t ii = 0; ii < 16; ++ii){
+        if(get<int>(ParametersContainer::InitConfig, std::format("channel{}", ii)) == 1){
+            i->settings.channelsName.push_back(get<std::string>(ParametersContainer::InitConfig, std::format("channel{}_name", ii)));
+        }
+    }
+    if(i->settings.channels_count() == 0){
+        log_error("No channel enabled.");
+        return false;
+    }
+
+    // the simulated device is only used in bypass mode, benchmarks and tests inject their own device
+    if(i->device == nullptr){
+        if(get<int>(ParametersContainer::InitConfig, "debug_bypass") != 1){
+            log_error("No Biopac hardware backend available, enable debug bypass to use a simulated device.");
+            return false;
+        }
+        i->device = std::make_unique<SimulatedBiopacDevice>();
+    }
+    return true;
+}
+
+auto BiopacExComponent::clean() -> void{
+    i->stop();
+}
+
+auto BiopacExComponent::start_experiment() -> void{
+
+    i->stop();
+    if(i->device == nullptr){
+        return;
+    }
+
+    const size_t channels = i->settings.channels_count();
+    i->ring.reset(std::max<size_t>(static_cast<size_t>(i->settings.samplingRate)*ringSeconds, i->settings.samplesPerRead*16), channels);
+    i->samplesCount   = 0;
+    i->samplesWritten = 0;
+    i->overflowCount  = 0;
+    i->clockDriftMs   = 0.;
+
+    i->bucketFrames = std::max<size_t>(static_cast<size_t>(i->settings.samplingRate) / plotRate, 1);
+    i->plotCount    = 0;
+    i->currentCount = 0;
+    i->plotMin.assign(channels*i->plotBuckets, 0.f);
+    i->plotMax.assign(channels*i->plotBuckets, 0.f);
+    i->currentMin.assign(channels, 0.f);
+    i->currentMax.assign(channels, 0.f);
+    i->latest.assign(channels, 0.);
+
+    if(const auto path = get<std::string>(ParametersContainer::Dynamic, "path_file"); !path.empty()){
+
+        std::vector<ColumnarLogColumn> columns = {{"sample", ColumnarLogType::Real}, {"time_exp", ColumnarLogType::Real}};
+        for(const auto &name : i->settings.channelsName){
+            columns.push_back({name, ColumnarLogType::Real});
+        }
+        if(!i->file.open(path, std::move(columns), 1)){
+            log_error(std::format("Cannot open acquisition file [{}].", path));
+        }
+        i->values.assign(channels + 2, {ColumnarLogValue::Type::Real, 0., {}});
+    }
+
+    if(!i->device->start(i->settings)){
+        log_error("Cannot start acquisition.");
+        return;
+    }
+
+    i->experimentStart = steady_clock::now();
+    i->stopWriter      = false;
+    i->acquire         = true;
+    i->writer          = std::thread(&Impl::writer_loop, i.get());
+    i->acquisition     = std::thread(&Impl::acquisition_loop, i.get());
+}
+
+auto BiopacExComponent::stop_experiment() -> void{
+    i->stop();
+    if(i->overflowCount > 0){
+        log_error(std::format("{} samples lost because the acquisition buffer was full.", i->overflowCount.load()));
+    }
+}
+
+auto BiopacExComponent::set_device(std::unique_ptr<BiopacDevice> device) -> void{
+    i->stop();
+    i->device = std::move(device);
+}
+
+auto BiopacExComponent::settings() const noexcept -> const BiopacSettings&{
+    return i->settings;
+}
+
+auto BiopacExComponent::samples_count() const noexcept -> size_t{
+    return i->samplesCount.load();
+}
+
+auto BiopacExComponent::samples_written() const noexcept -> size_t{
+    return i->samplesWritten.load();
+}
+
+auto BiopacExComponent::overflow_count() const noexcept -> size_t{
+    return i->overflowCount.load();
+}
+
+auto BiopacExComponent::clock_drift_ms() const noexcept -> double{
+    return i->clockDriftMs.load();
+}
+
+auto BiopacExComponent::latest_values(double *values) const -> size_t{
+    std::lock_guard<std::mutex> lock(i->plotL);
+    std::copy(i->latest.begin(), i->latest.end(), values);
+    return i->latest.size();
+}
+
+auto BiopacExComponent::decimated_values(size_t idChannel, size_t nbPoints, float *minMax) const -> size_t{
+
+    std::lock_guard<std::mutex> lock(i->plotL);
+    if(idChannel >= i->settings.channels_count()){
+        return 0;
+    }
+
+    const size_t count = std::min({nbPoints, i->plotCount, i->plotBuckets});
+    for(size_t ii = 0; ii < count; ++ii){
+        const size_t idBucket = (i->plotCount - count + ii) % i->plotBuckets;
+        minMax[2*ii]   = i->plotMin[idChannel*i->plotBuckets + idBucket];
+        minMax[2*ii+1] = i->plotMax[idChannel*i->plotBuckets + idBucket];
+    }
+    return count;
+}
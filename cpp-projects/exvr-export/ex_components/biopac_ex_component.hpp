@@ -0,0 +1,68 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <memory>
+
+// base
+#include "exvr/ex_component.hpp"
+
+// local
+#include "biopac_device.hpp"
+
+namespace tool::ex {
+
+// an acquisition thread reads the device blocks into a multi-channel ring,
+// a writer thread streams them to a columnar log file and updates a decimated view for plotting
+class BiopacExComponent : public ExComponent{
+
+public:
+
+    BiopacExComponent();
+    ~BiopacExComponent() override;
+
+    auto initialize() -> bool override;
+    auto clean() -> void override;
+    auto start_experiment() -> void override;
+    auto stop_experiment() -> void override;
+
+    auto set_device(std::unique_ptr<BiopacDevice> device) -> void;
+    auto settings() const noexcept -> const BiopacSettings&;
+
+    auto samples_count() const noexcept -> size_t;
+    auto samples_written() const noexcept -> size_t;
+    auto overflow_count() const noexcept -> size_t;
+    auto clock_drift_ms() const noexcept -> double;
+
+    // last values of each channel
+    auto latest_values(double *values) const -> size_t;
+    // min/max pairs of the last nbPoints buckets of a channel, oldest first
+    auto decimated_values(size_t idChannel, size_t nbPoints, float *minMax) const -> size_t;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
@@ -0,0 +1,57 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "biopac_ex_component_export.hpp"
+
+using namespace tool::ex;
+
+BiopacExComponent *create_biopac_ex_component(){
+    return new BiopacExComponent();
+}
+
+int get_channels_count_biopac_ex_component(BiopacExComponent *bC){
+    return static_cast<int>(bC->settings().channels_count());
+}
+
+long long get_samples_count_biopac_ex_component(BiopacExComponent *bC){
+    return static_cast<long long>(bC->samples_count());
+}
+
+long long get_overflow_count_biopac_ex_component(BiopacExComponent *bC){
+    return static_cast<long long>(bC->overflow_count());
+}
+
+double get_clock_drift_ms_biopac_ex_component(BiopacExComponent *bC){
+    return bC->clock_drift_ms();
+}
+
+int get_latest_values_biopac_ex_component(BiopacExComponent *bC, double *values){
+    return static_cast<int>(bC->latest_values(values));
+}
+
+int get_decimated_values_biopac_ex_component(BiopacExComponent *bC, int idChannel, int nbPoints, float *minMax){
+    if(idChannel < 0 || nbPoints <= 0){
+        return 0;
+    }
+    return static_cast<int>(bC->decimated_values(static_cast<size_t>(idChannel), static_cast<size_t>(nbPoints), minMax));
+}
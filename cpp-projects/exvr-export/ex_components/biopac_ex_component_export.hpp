@@ -0,0 +1,43 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// base
+#include "utility/export.hpp"
+
+// local
+#include "biopac_ex_component.hpp"
+
+extern "C"{
+
+    DECL_EXPORT tool::ex::BiopacExComponent *create_biopac_ex_component();
+
+    DECL_EXPORT int get_channels_count_biopac_ex_component(tool::ex::BiopacExComponent *bC);
+    DECL_EXPORT long long get_samples_count_biopac_ex_component(tool::ex::BiopacExComponent *bC);
+    DECL_EXPORT long long get_overflow_count_biopac_ex_component(tool::ex::BiopacExComponent *bC);
+    DECL_EXPORT double get_clock_drift_ms_biopac_ex_component(tool::ex::BiopacExComponent *bC);
+
+    DECL_EXPORT int get_latest_values_biopac_ex_component(tool::ex::BiopacExComponent *bC, double *values);
+    DECL_EXPORT int get_decimated_values_biopac_ex_component(tool::ex::BiopacExComponent *bC, int idChannel, int nbPoints, float *minMax);
+}
@@ -0,0 +1,316 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "cloud_decimation.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <execution>
+#include <limits>
+
+using namespace tool::ex;
+
+namespace {
+
+constexpr size_t chunkSize = 32768;
+constexpr size_t maxVoxelPasses = 3;
+constexpr double budgetTolerance = 0.8; /**< a voxel grid result between 80% and 100% of the budget is accepted */
+
+struct Chunk{
+    size_t begin = 0;
+    size_t end = 0;
+    size_t keptCount = 0;
+    size_t keptOffset = 0;
+    float min[3] = {};
+    float max[3] = {};
+};
+
+inline auto position(const std::byte *positions, size_t strideBytes, size_t id) noexcept -> const float*{
+    return reinterpret_cast<const float*>(positions + id * strideBytes);
+}
+
+// lock-free voxel key -> lowest point id
+class VoxelsTable{
+
+public:
+
+    auto reset(size_t pointsCount) -> void{
+        const size_t size = std::bit_ceil(std::max<size_t>(pointsCount * 2, 1024));
+        m_keys.resize(size);
+        m_owners.resize(size);
+        std::fill(m_keys.begin(), m_keys.end(), emptyKey);
+        std::fill(m_owners.begin(), m_owners.end(), std::numeric_limits<std::uint32_t>::max());
+        m_shift = 64 - static_cast<int>(std::countr_zero(size));
+    }
+
+    // returns the slot of the voxel
+    auto insert(std::uint64_t key, std::uint32_t id) noexcept -> std::uint32_t{
+        const size_t mask = m_keys.size() - 1;
+        size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+        while(true){
+            std::atomic_ref<std::uint64_t> slot(m_keys[index]);
+            std::uint64_t current = slot.load(std::memory_order_relaxed);
+            if(current == emptyKey){
+                slot.compare_exchange_strong(current, key, std::memory_order_relaxed);
+                // current is now the key written by this thread or by another one
+                if(current == emptyKey){
+                    current = key;
+                }
+            }
+            if(current == key){
+                std::atomic_ref<std::uint32_t> owner(m_owners[index]);
+                std::uint32_t lowest = owner.load(std::memory_order_relaxed);
+                while(id < lowest && !owner.compare_exchange_weak(lowest, id, std::memory_order_relaxed)){
+                }
+                return static_cast<std::uint32_t>(index);
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    auto owner(std::uint32_t slot) const noexcept -> std::uint32_t{
+        return m_owners[slot];
+    }
+
+private:
+
+    static constexpr std::uint64_t emptyKey = std::numeric_limits<std::uint64_t>::max();
+
+    int m_shift = 64;
+    std::vector<std::uint64_t> m_keys;
+    std::vector<std::uint32_t> m_owners;
+};
+
+inline auto voxel_key(const float *p, const float *origin, float invVoxelSize) noexcept -> std::uint64_t{
+    constexpr float max = static_cast<float>((1 << 21) - 1);
+    auto quantize = [&](float value){
+        // nan values go to the first voxel
+        const float q = value * invVoxelSize;
+        return static_cast<std::uint64_t>(q >= 0.f ? std::min(q, max) : 0.f);
+    };
+    return quantize(p[0] - origin[0]) | (quantize(p[1] - origin[1]) << 21) | (quantize(p[2] - origin[2]) << 42);
+}
+}
+
+struct CloudDecimation::Impl{
+    CloudDecimationSettings settings;
+    std::vector<Chunk> chunks;
+    std::vector<std::uint32_t> slots;
+    std::vector<std::uint32_t> indices;
+    VoxelsTable voxels;
+    size_t outputCount = 0;
+    float voxelSize = 0.f;
+    double durationMs = 0.;
+
+    auto stride(size_t count, size_t budget) -> void;
+    auto voxel_grid(const std::byte *positions, size_t strideBytes, size_t count) -> void;
+    auto voxel_pass(const std::byte *positions, size_t strideBytes, const float *origin, float size) -> size_t;
+};
+
+auto CloudDecimation::Impl::stride(size_t count, size_t budget) -> void{
+    indices.resize(budget);
+    for(size_t id = 0; id < budget; ++id){
+        indices[id] = static_cast<std::uint32_t>(id * count / budget);
+    }
+}
+
+auto CloudDecimation::Impl::voxel_pass(const std::byte *positions, size_t strideBytes, const float *origin, float size) -> size_t{
+
+    const float invVoxelSize = 1.f / size;
+    voxels.reset(slots.size());
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](const Chunk &chunk){
+        for(size_t id = chunk.begin; id < chunk.end; ++id){
+            slots[id] = voxels.insert(voxel_key(position(positions, strideBytes, id), origin, invVoxelSize), static_cast<std::uint32_t>(id));
+        }
+    });
+
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](Chunk &chunk){
+        chunk.keptCount = 0;
+        for(size_t id = chunk.begin; id < chunk.end; ++id){
+            chunk.keptCount += voxels.owner(slots[id]) == id ? 1 : 0;
+        }
+    });
+
+    size_t keptTotal = 0;
+    for(auto &chunk : chunks){
+        chunk.keptOffset = keptTotal;
+        keptTotal += chunk.keptCount;
+    }
+    return keptTotal;
+}
+
+auto CloudDecimation::Impl::voxel_grid(const std::byte *positions, size_t strideBytes, size_t count) -> void{
+
+    const size_t budget = settings.pointsBudget;
+
+    chunks.clear();
+    for(size_t begin = 0; begin < count; begin += chunkSize){
+        chunks.push_back({begin, std::min(begin + chunkSize, count), 0, 0, {}, {}});
+    }
+
+    // bounds
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](Chunk &chunk){
+        std::fill_n(chunk.min, 3, std::numeric_limits<float>::max());
+        std::fill_n(chunk.max, 3, std::numeric_limits<float>::lowest());
+        for(size_t id = chunk.begin; id < chunk.end; ++id){
+            const float *p = position(positions, strideBytes, id);
+            for(size_t c = 0; c < 3; ++c){
+                chunk.min[c] = std::min(chunk.min[c], p[c]);
+                chunk.max[c] = std::max(chunk.max[c], p[c]);
+            }
+        }
+    });
+    float origin[3], extents[3];
+    for(size_t c = 0; c < 3; ++c){
+        float min = std::numeric_limits<float>::max(), max = std::numeric_limits<float>::lowest();
+        for(const auto &chunk : chunks){
+            min = std::min(min, chunk.min[c]);
+            max = std::max(max, chunk.max[c]);
+        }
+        origin[c]  = min;
+        extents[c] = std::max(max - min, 0.f);
+    }
+
+    // clouds are seen as surfaces, a first size is deduced from the bounds area
+    if(voxelSize <= 0.f){
+        const float area = extents[0]*extents[1] + extents[1]*extents[2] + extents[0]*extents[2];
+        voxelSize = std::sqrt(area / static_cast<float>(budget));
+    }
+    // 21 bits per axis
+    const float minSize = std::max({extents[0], extents[1], extents[2]}) / static_cast<float>((1 << 21) - 1);
+    voxelSize = std::max({voxelSize, minSize, std::numeric_limits<float>::min()});
+
+    slots.resize(count);
+    size_t keptTotal = 0;
+    for(size_t pass = 0; pass < maxVoxelPasses; ++pass){
+        keptTotal = voxel_pass(positions, strideBytes, origin, voxelSize);
+        if(keptTotal <= budget && static_cast<double>(keptTotal) >= budgetTolerance * static_cast<double>(budget)){
+            break;
+        }
+        // the kept count of a surface varies with the inverse of the squared voxel size
+        const float ratio = std::clamp(static_cast<float>(keptTotal) / static_cast<float>(budget), 0.25f, 4.f);
+        voxelSize = std::max(voxelSize * std::sqrt(ratio) * (keptTotal > budget ? 1.02f : 0.98f), minSize);
+    }
+
+    indices.resize(keptTotal);
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](const Chunk &chunk){
+        size_t dst = chunk.keptOffset;
+        for(size_t id = chunk.begin; id < chunk.end; ++id){
+            if(voxels.owner(slots[id]) == id){
+                indices[dst++] = static_cast<std::uint32_t>(id);
+            }
+        }
+    });
+
+    // hard budget when the passes did not converge
+    if(keptTotal > budget){
+        for(size_t id = 0; id < budget; ++id){
+            indices[id] = indices[id * keptTotal / budget];
+        }
+        indices.resize(budget);
+    }
+}
+
+CloudDecimation::CloudDecimation() : i(std::make_unique<Impl>()){
+}
+
+CloudDecimation::~CloudDecimation(){
+}
+
+auto CloudDecimation::budgets_from_string(const std::string &budgets, size_t camerasCount) -> std::vector<size_t>{
+
+    std::vector<size_t> values;
+    size_t start = 0;
+    while(start <= budgets.size()){
+        const size_t end = std::min(budgets.find(';', start), budgets.size());
+        size_t value = 0;
+        const auto *first = budgets.data() + start;
+        const auto *last  = budgets.data() + end;
+        while(first != last && *first == ' '){
+            ++first;
+        }
+        if(std::from_chars(first, last, value).ec == std::errc{}){
+            values.push_back(value);
+        }
+        start = end + 1;
+    }
+
+    if(values.empty()){
+        values.push_back(0);
+    }
+    values.resize(std::max(camerasCount, size_t{1}), values.back());
+    return values;
+}
+
+auto CloudDecimation::set_settings(const CloudDecimationSettings &settings) -> void{
+    if(settings.pointsBudget != i->settings.pointsBudget || settings.mode != i->settings.mode){
+        i->voxelSize = 0.f;
+    }
+    i->settings = settings;
+}
+
+auto CloudDecimation::settings() const noexcept -> const CloudDecimationSettings&{
+    return i->settings;
+}
+
+auto CloudDecimation::decimate(const void *positions, size_t strideBytes, size_t count) -> bool{
+
+    const auto start = std::chrono::steady_clock::now();
+
+    const size_t budget = i->settings.pointsBudget;
+    bool decimated = false;
+    if(i->settings.mode != CloudDecimationMode::None && budget != 0 && count > budget && positions != nullptr &&
+       count <= std::numeric_limits<std::uint32_t>::max()){
+        if(i->settings.mode == CloudDecimationMode::Stride){
+            i->stride(count, budget);
+        }else{
+            i->voxel_grid(static_cast<const std::byte*>(positions), strideBytes, count);
+        }
+        decimated = true;
+    }
+
+    i->outputCount = decimated ? i->indices.size() : count;
+    i->durationMs  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return decimated;
+}
+
+auto CloudDecimation::kept_indices() const noexcept -> std::span<const std::uint32_t>{
+    return i->indices;
+}
+
+auto CloudDecimation::output_count() const noexcept -> size_t{
+    return i->outputCount;
+}
+
+auto CloudDecimation::last_duration_ms() const noexcept -> double{
+    return i->durationMs;
+}
+
+auto CloudDecimation::voxel_size() const noexcept -> float{
+    return i->voxelSize;
+}
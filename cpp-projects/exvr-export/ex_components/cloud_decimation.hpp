@@ -0,0 +1,94 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace tool::ex {
+
+enum class CloudDecimationMode : int{
+    None = 0,
+    Stride,     /**< evenly spaced points */
+    VoxelGrid   /**< first point of each occupied voxel, the voxel size adapts to the budget */
+};
+
+struct CloudDecimationSettings{
+    CloudDecimationMode mode = CloudDecimationMode::None;
+    size_t pointsBudget = 0;    /**< no decimation if 0 */
+};
+
+// reduces a cloud to a points budget before it is copied to the caller,
+// the voxel size found for a frame is the starting point of the next one
+class CloudDecimation{
+
+public:
+
+    CloudDecimation();
+    ~CloudDecimation();
+
+    // budgets separated by ';', the last one is used for the next cameras (ex: "200000;100000")
+    static auto budgets_from_string(const std::string &budgets, size_t camerasCount) -> std::vector<size_t>;
+
+    auto set_settings(const CloudDecimationSettings &settings) -> void;
+    auto settings() const noexcept -> const CloudDecimationSettings&;
+
+    // positions are xyz floats at the beginning of each element of strideBytes bytes,
+    // returns false if every point is kept
+    auto decimate(const void *positions, size_t strideBytes, size_t count) -> bool;
+
+    // ascending, valid after decimate returned true
+    auto kept_indices() const noexcept -> std::span<const std::uint32_t>;
+    auto output_count() const noexcept -> size_t;
+    auto last_duration_ms() const noexcept -> double;
+    auto voxel_size() const noexcept -> float;
+
+    // moves the kept elements at the beginning of the array
+    template<typename T>
+    auto compact(T *values) const noexcept -> void{
+        const auto indices = kept_indices();
+        for(size_t id = 0; id < indices.size(); ++id){
+            values[id] = values[indices[id]];
+        }
+    }
+
+    // copies the kept elements
+    template<typename T>
+    auto copy(const T *values, T *output) const noexcept -> void{
+        const auto indices = kept_indices();
+        for(size_t id = 0; id < indices.size(); ++id){
+            output[id] = values[indices[id]];
+        }
+    }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
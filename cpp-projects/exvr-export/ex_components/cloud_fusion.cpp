@@ -0,0 +1,321 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "cloud_fusion.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <execution>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define CLOUD_FUSION_SSE2
+#endif
+
+using namespace tool::ex;
+
+namespace {
+
+constexpr size_t chunkSize = 32768;
+constexpr std::uint32_t opaqueWhite = 0xFFFFFFFF;
+
+struct Chunk{
+    size_t idInput = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    size_t offset = 0;      /**< first vertex in the transformed buffer */
+    size_t keptCount = 0;
+    size_t keptOffset = 0;  /**< first vertex in the compacted buffer */
+};
+
+inline auto to_byte(float value) noexcept -> std::uint32_t{
+    return static_cast<std::uint32_t>(std::clamp(value * 255.f, 0.f, 255.f));
+}
+
+inline auto color(const CloudFusionInput &input, size_t id) noexcept -> std::uint32_t{
+    if(input.colorsF != nullptr){
+        const float *c = input.colorsF + id*3;
+        return to_byte(c[0]) | (to_byte(c[1]) << 8) | (to_byte(c[2]) << 16) | 0xFF000000;
+    }
+    if(input.colorsI != nullptr){
+        std::uint32_t rgba;
+        std::copy_n(input.colorsI + id*4, 4, reinterpret_cast<std::uint8_t*>(&rgba));
+        return rgba;
+    }
+    return opaqueWhite;
+}
+
+#ifdef CLOUD_FUSION_SSE2
+
+// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 -> x0 x1 x2 x3 | y0 y1 y2 y3 | z0 z1 z2 z3
+inline auto deinterleave3(const float *values, __m128 &x, __m128 &y, __m128 &z) noexcept -> void{
+    const __m128 a = _mm_loadu_ps(values);
+    const __m128 b = _mm_loadu_ps(values + 4);
+    const __m128 c = _mm_loadu_ps(values + 8);
+    x = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0,2,3,0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(0,1,0,2)), _MM_SHUFFLE(2,0,1,0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3,0,1,1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2,2,3,3)), _MM_SHUFFLE(2,0,2,0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1,1,2,2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3,3,0,0)), _MM_SHUFFLE(2,0,2,0));
+}
+
+inline auto colors4(const CloudFusionInput &input, size_t id) noexcept -> __m128i{
+    if(input.colorsF != nullptr){
+        __m128 r, g, b;
+        deinterleave3(input.colorsF + id*3, r, g, b);
+        const __m128 scale = _mm_set1_ps(255.f);
+        const __m128 zero  = _mm_setzero_ps();
+        auto to_bytes = [&](__m128 v){
+            return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(v, scale), zero), scale));
+        };
+        return _mm_or_si128(
+            _mm_or_si128(to_bytes(r), _mm_slli_epi32(to_bytes(g), 8)),
+            _mm_or_si128(_mm_slli_epi32(to_bytes(b), 16), _mm_set1_epi32(static_cast<int>(0xFF000000)))
+        );
+    }
+    if(input.colorsI != nullptr){
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.colorsI + id*4));
+    }
+    return _mm_set1_epi32(-1);
+}
+#endif
+
+// world position = [p 1] * M
+auto transform_chunk(const CloudFusionInput &input, size_t begin, size_t end, FusedVertex *output) noexcept -> void{
+
+    const auto &m = input.transform;
+    size_t id = begin;
+
+    // decimated clouds are gathered point by point
+    if(input.indices != nullptr){
+        for(; id < end; ++id){
+            const size_t idSrc = input.indices[id];
+            const float *p = input.positions + idSrc*3;
+            auto &v = output[id - begin];
+            v.x = p[0]*m[0] + p[1]*m[4] + p[2]*m[8]  + m[12];
+            v.y = p[0]*m[1] + p[1]*m[5] + p[2]*m[9]  + m[13];
+            v.z = p[0]*m[2] + p[1]*m[6] + p[2]*m[10] + m[14];
+            const auto rgba = color(input, idSrc);
+            std::copy_n(reinterpret_cast<const std::uint8_t*>(&rgba), 4, &v.r);
+        }
+        return;
+    }
+
+#ifdef CLOUD_FUSION_SSE2
+    const __m128 m0  = _mm_set1_ps(m[0]),  m1  = _mm_set1_ps(m[1]),  m2  = _mm_set1_ps(m[2]);
+    const __m128 m4  = _mm_set1_ps(m[4]),  m5  = _mm_set1_ps(m[5]),  m6  = _mm_set1_ps(m[6]);
+    const __m128 m8  = _mm_set1_ps(m[8]),  m9  = _mm_set1_ps(m[9]),  m10 = _mm_set1_ps(m[10]);
+    const __m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]), m14 = _mm_set1_ps(m[14]);
+
+    for(; id + 4 <= end; id += 4){
+
+        __m128 x, y, z;
+        deinterleave3(input.positions + id*3, x, y, z);
+        __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m4)), _mm_add_ps(_mm_mul_ps(z, m8),  m12));
+        __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m1), _mm_mul_ps(y, m5)), _mm_add_ps(_mm_mul_ps(z, m9),  m13));
+        __m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m2), _mm_mul_ps(y, m6)), _mm_add_ps(_mm_mul_ps(z, m10), m14));
+        __m128 colors = _mm_castsi128_ps(colors4(input, id));
+
+        // back to x y z rgba vertices, colors bits are only moved
+        _MM_TRANSPOSE4_PS(tx, ty, tz, colors);
+        float *dst = reinterpret_cast<float*>(output + (id - begin));
+        _mm_storeu_ps(dst,      tx);
+        _mm_storeu_ps(dst + 4,  ty);
+        _mm_storeu_ps(dst + 8,  tz);
+        _mm_storeu_ps(dst + 12, colors);
+    }
+#endif
+
+    for(; id < end; ++id){
+        const float *p = input.positions + id*3;
+        auto &v = output[id - begin];
+        v.x = p[0]*m[0] + p[1]*m[4] + p[2]*m[8]  + m[12];
+        v.y = p[0]*m[1] + p[1]*m[5] + p[2]*m[9]  + m[13];
+        v.z = p[0]*m[2] + p[1]*m[6] + p[2]*m[10] + m[14];
+        const auto rgba = color(input, id);
+        std::copy_n(reinterpret_cast<const std::uint8_t*>(&rgba), 4, &v.r);
+    }
+}
+
+// lock-free voxel key -> lowest camera id, each slot packs the key and the id
+class VoxelsTable{
+
+public:
+
+    static constexpr size_t maxIds = 15;
+
+    auto reset(size_t pointsCount) -> void{
+        const size_t size = std::bit_ceil(std::max<size_t>(pointsCount * 2, 1024));
+        m_slots.resize(size);
+        std::fill(m_slots.begin(), m_slots.end(), emptySlot);
+        m_shift = 64 - static_cast<int>(std::countr_zero(size));
+    }
+
+    // returns the slot of the voxel
+    auto insert(std::uint64_t key, std::uint64_t id) noexcept -> size_t{
+        const size_t mask = m_slots.size() - 1;
+        const std::uint64_t value = (key << 4) | id;
+        size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+        while(true){
+            std::atomic_ref<std::uint64_t> slot(m_slots[index]);
+            std::uint64_t current = slot.load(std::memory_order_relaxed);
+            while(current == emptySlot || (current >> 4) == key){
+                if(current != emptySlot && (current & 0xF) <= id){
+                    return index;
+                }
+                if(slot.compare_exchange_weak(current, value, std::memory_order_relaxed)){
+                    return index;
+                }
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    auto lowest_id(size_t slot) const noexcept -> std::uint64_t{
+        return m_slots[slot] & 0xF;
+    }
+
+private:
+
+    static constexpr std::uint64_t emptySlot = std::numeric_limits<std::uint64_t>::max();
+
+    int m_shift = 64;
+    std::vector<std::uint64_t> m_slots;
+};
+
+inline auto voxel_key(const FusedVertex &v, float invVoxelSize) noexcept -> std::uint64_t{
+    constexpr std::int64_t half = std::int64_t{1} << 19;
+    constexpr std::int64_t max  = (std::int64_t{1} << 20) - 1;
+    auto quantize = [&](float value){
+        return static_cast<std::uint64_t>(std::clamp(static_cast<std::int64_t>(std::floor(value * invVoxelSize)) + half, std::int64_t{0}, max));
+    };
+    return quantize(v.x) | (quantize(v.y) << 20) | (quantize(v.z) << 40);
+}
+}
+
+struct CloudFusion::Impl{
+    CloudFusionSettings settings;
+    std::vector<Chunk> chunks;
+    std::vector<FusedVertex> transformed;
+    std::vector<FusedVertex> compacted;
+    std::vector<size_t> slots;
+    std::vector<std::uint8_t> kept;
+    VoxelsTable voxels;
+    std::span<const FusedVertex> output;
+    size_t removedCount = 0;
+    double durationMs = 0.;
+};
+
+CloudFusion::CloudFusion() : i(std::make_unique<Impl>()){
+}
+
+CloudFusion::~CloudFusion(){
+}
+
+auto CloudFusion::set_settings(const CloudFusionSettings &settings) -> void{
+    i->settings = settings;
+    i->settings.voxelSize = std::max(i->settings.voxelSize, 0.0001f);
+}
+
+auto CloudFusion::fuse(std::span<const CloudFusionInput> inputs) -> size_t{
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // split every cloud into chunks processed by the workers
+    size_t total = 0;
+    i->chunks.clear();
+    for(size_t idInput = 0; idInput < inputs.size(); ++idInput){
+        const auto &input = inputs[idInput];
+        if(input.positions == nullptr){
+            continue;
+        }
+        for(size_t begin = 0; begin < input.count; begin += chunkSize){
+            i->chunks.push_back({idInput, begin, std::min(begin + chunkSize, input.count), total + begin, 0, 0});
+        }
+        total += input.count;
+    }
+
+    i->transformed.resize(total);
+    std::for_each(std::execution::par, i->chunks.begin(), i->chunks.end(), [&](const Chunk &chunk){
+        transform_chunk(inputs[chunk.idInput], chunk.begin, chunk.end, i->transformed.data() + chunk.offset);
+    });
+    i->output       = std::span<const FusedVertex>(i->transformed.data(), total);
+    i->removedCount = 0;
+
+    if(i->settings.removeOverlaps && inputs.size() > 1 && inputs.size() <= VoxelsTable::maxIds){
+
+        // lowest camera id of each voxel
+        const float invVoxelSize = 1.f / i->settings.voxelSize;
+        i->slots.resize(total);
+        i->kept.resize(total);
+        i->voxels.reset(total);
+        std::for_each(std::execution::par, i->chunks.begin(), i->chunks.end(), [&](const Chunk &chunk){
+            for(size_t id = chunk.offset; id < chunk.offset + (chunk.end - chunk.begin); ++id){
+                i->slots[id] = i->voxels.insert(voxel_key(i->transformed[id], invVoxelSize), chunk.idInput);
+            }
+        });
+
+        // keeps the points of the cameras owning their voxel
+        std::for_each(std::execution::par, i->chunks.begin(), i->chunks.end(), [&](Chunk &chunk){
+            chunk.keptCount = 0;
+            for(size_t id = chunk.offset; id < chunk.offset + (chunk.end - chunk.begin); ++id){
+                i->kept[id] = i->voxels.lowest_id(i->slots[id]) == chunk.idInput ? 1 : 0;
+                chunk.keptCount += i->kept[id];
+            }
+        });
+        size_t keptTotal = 0;
+        for(auto &chunk : i->chunks){
+            chunk.keptOffset = keptTotal;
+            keptTotal += chunk.keptCount;
+        }
+
+        i->compacted.resize(keptTotal);
+        std::for_each(std::execution::par, i->chunks.begin(), i->chunks.end(), [&](const Chunk &chunk){
+            size_t dst = chunk.keptOffset;
+            for(size_t id = chunk.offset; id < chunk.offset + (chunk.end - chunk.begin); ++id){
+                if(i->kept[id] != 0){
+                    i->compacted[dst++] = i->transformed[id];
+                }
+            }
+        });
+        i->output       = std::span<const FusedVertex>(i->compacted.data(), keptTotal);
+        i->removedCount = total - keptTotal;
+    }
+
+    i->durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return i->output.size();
+}
+
+auto CloudFusion::vertices() const noexcept -> std::span<const FusedVertex>{
+    return i->output;
+}
+
+auto CloudFusion::removed_points_count() const noexcept -> size_t{
+    return i->removedCount;
+}
+
+auto CloudFusion::last_duration_ms() const noexcept -> double{
+    return i->durationMs;
+}
@@ -0,0 +1,78 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace tool::ex {
+
+// same layout than camera::K4VertexMeshData
+struct FusedVertex{
+    float x = 0.f, y = 0.f, z = 0.f;
+    std::uint8_t r = 0, g = 0, b = 0, a = 255;
+};
+static_assert(sizeof(FusedVertex) == 16);
+
+// camera space cloud, colors are either rgb floats in [0,1] or rgba bytes
+struct CloudFusionInput{
+    const float *positions = nullptr;               /**< xyz */
+    const float *colorsF = nullptr;                 /**< rgb */
+    const std::uint8_t *colorsI = nullptr;          /**< rgba */
+    const std::uint32_t *indices = nullptr;         /**< points kept by a decimation, every point if null */
+    size_t count = 0;                               /**< points count, or indices count if defined */
+    std::array<float,16> transform = {1.f,0.f,0.f,0.f, 0.f,1.f,0.f,0.f, 0.f,0.f,1.f,0.f, 0.f,0.f,0.f,1.f}; /**< as sent in tr_{n}, translation in 12..14 */
+};
+
+struct CloudFusionSettings{
+    bool removeOverlaps = false;    /**< points in a voxel already filled by a camera with a lower id are removed (up to 15 cameras) */
+    float voxelSize = 0.01f;
+};
+
+// transforms the clouds of every camera to world space into a single contiguous buffer
+class CloudFusion{
+
+public:
+
+    CloudFusion();
+    ~CloudFusion();
+
+    auto set_settings(const CloudFusionSettings &settings) -> void;
+    auto fuse(std::span<const CloudFusionInput> inputs) -> size_t;
+
+    // valid until the next fuse
+    auto vertices() const noexcept -> std::span<const FusedVertex>;
+    auto removed_points_count() const noexcept -> size_t;
+    auto last_duration_ms() const noexcept -> double;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
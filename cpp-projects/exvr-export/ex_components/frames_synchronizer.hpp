@@ -0,0 +1,183 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace tool::ex {
+
+struct FramesSyncSettings{
+    std::int64_t toleranceNs = 8'000'000;   /**< max capture timestamps difference inside a set */
+    size_t bufferSize = 4;                  /**< frames kept per camera while waiting for the others */
+    bool latestFallback = false;            /**< publish the latest frame of each camera when a buffer is full without complete set */
+};
+
+struct FramesSyncStatistics{
+    size_t setsCount = 0;
+    size_t fallbacksCount = 0;
+    size_t droppedFrames = 0;       /**< frames never published */
+    double lastSkewMs = 0.;         /**< capture timestamps range of the published set */
+    double averageSkewMs = 0.;
+    double maxSkewMs = 0.;
+};
+
+// groups the frames of several cameras by capture timestamp and publishes only complete sets,
+// push can be called from any thread, update and frame from the reading thread
+template<typename Frame>
+class FramesSynchronizer{
+
+public:
+
+    auto reset(size_t camerasCount, const FramesSyncSettings &settings) -> void{
+        std::lock_guard<std::mutex> lock(m_locker);
+        m_settings = settings;
+        m_settings.bufferSize = std::max<size_t>(m_settings.bufferSize, 1);
+        m_buffers.assign(camerasCount, {});
+        m_published.assign(camerasCount, {});
+        m_statistics = {};
+    }
+
+    auto push(size_t idCamera, std::int64_t captureTimestampNs, std::shared_ptr<Frame> frame) -> void{
+        std::lock_guard<std::mutex> lock(m_locker);
+        if(idCamera >= m_buffers.size()){
+            return;
+        }
+        auto &buffer = m_buffers[idCamera];
+        buffer.push_back({captureTimestampNs, std::move(frame)});
+        if(buffer.size() > m_settings.bufferSize){
+            buffer.pop_front();
+            ++m_statistics.droppedFrames;
+        }
+    }
+
+    // publishes the most recent complete set (or the latest frames with the fallback), returns true if the published frames changed
+    auto update() -> bool{
+
+        std::lock_guard<std::mutex> lock(m_locker);
+        if(m_buffers.empty()){
+            return false;
+        }
+
+        // camera 0 is the reference, its frames are tried from the most recent
+        const auto &reference = m_buffers.front();
+        std::vector<size_t> ids(m_buffers.size());
+        for(auto itR = reference.rbegin(); itR != reference.rend(); ++itR){
+
+            const std::int64_t ts = itR->timestampNs;
+            std::int64_t minTs = ts;
+            std::int64_t maxTs = ts;
+            bool complete = true;
+            ids[0] = static_cast<size_t>(std::distance(reference.begin(), itR.base()) - 1);
+
+            for(size_t idC = 1; idC < m_buffers.size() && complete; ++idC){
+                const auto &buffer = m_buffers[idC];
+                auto closest = std::min_element(buffer.begin(), buffer.end(), [ts](const auto &f1, const auto &f2){
+                    return std::abs(f1.timestampNs - ts) < std::abs(f2.timestampNs - ts);
+                });
+                if(closest == buffer.end()){
+                    complete = false;
+                    break;
+                }
+                minTs = std::min(minTs, closest->timestampNs);
+                maxTs = std::max(maxTs, closest->timestampNs);
+                complete = (maxTs - minTs) <= m_settings.toleranceNs;
+                ids[idC] = static_cast<size_t>(std::distance(buffer.begin(), closest));
+            }
+
+            if(complete){
+                for(size_t idC = 0; idC < m_buffers.size(); ++idC){
+                    auto &buffer = m_buffers[idC];
+                    m_published[idC] = std::move(buffer[ids[idC]].frame);
+                    m_statistics.droppedFrames += ids[idC];
+                    buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(ids[idC]) + 1);
+                }
+                add_set_skew(maxTs - minTs);
+                return true;
+            }
+        }
+
+        if(!m_settings.latestFallback){
+            return false;
+        }
+
+        // a camera is late or disconnected
+        const bool bufferFull = std::any_of(m_buffers.begin(), m_buffers.end(), [&](const auto &buffer){
+            return buffer.size() >= m_settings.bufferSize;
+        });
+        if(!bufferFull){
+            return false;
+        }
+
+        for(size_t idC = 0; idC < m_buffers.size(); ++idC){
+            auto &buffer = m_buffers[idC];
+            if(!buffer.empty()){
+                m_published[idC] = std::move(buffer.back().frame);
+                m_statistics.droppedFrames += buffer.size() - 1;
+                buffer.clear();
+            }
+        }
+        ++m_statistics.fallbacksCount;
+        return true;
+    }
+
+    auto frame(size_t idCamera) const -> std::shared_ptr<Frame>{
+        std::lock_guard<std::mutex> lock(m_locker);
+        return idCamera < m_published.size() ? m_published[idCamera] : nullptr;
+    }
+
+    auto statistics() const -> FramesSyncStatistics{
+        std::lock_guard<std::mutex> lock(m_locker);
+        return m_statistics;
+    }
+
+private:
+
+    auto add_set_skew(std::int64_t skewNs) -> void{
+        const double skewMs = static_cast<double>(skewNs) * 1e-6;
+        ++m_statistics.setsCount;
+        m_statistics.lastSkewMs     = skewMs;
+        m_statistics.maxSkewMs      = std::max(m_statistics.maxSkewMs, skewMs);
+        m_statistics.averageSkewMs += (skewMs - m_statistics.averageSkewMs) / static_cast<double>(m_statistics.setsCount);
+    }
+
+    struct TimestampedFrame{
+        std::int64_t timestampNs = 0;
+        std::shared_ptr<Frame> frame = nullptr;
+    };
+
+    mutable std::mutex m_locker;
+    FramesSyncSettings m_settings;
+    std::vector<std::deque<TimestampedFrame>> m_buffers;
+    std::vector<std::shared_ptr<Frame>> m_published;
+    FramesSyncStatistics m_statistics;
+};
+}
@@ -129,6 +129,22 @@ bool K2ManagerExComponent::initialize(){
         set_array(ParametersContainer::Dynamic, name, m);
     }
 
+    CloudFusionSettings fusionS;
+    fusionS.removeOverlaps = get<int>(ParametersContainer::InitConfig, "fusion_remove_overlaps") == 1;
+    fusionS.voxelSize      = get<float>(ParametersContainer::InitConfig, "fusion_voxel_size_mm") * 0.001f;
+    cloudFusion.set_settings(fusionS);
+
+    // level of detail of the clouds sent to the caller
+    const auto decimationMode = static_cast<CloudDecimationMode>(get<int>(ParametersContainer::InitConfig, "decimation_mode"));
+    const auto budgets = CloudDecimation::budgets_from_string(get<std::string>(ParametersContainer::InitConfig, "decimation_budgets"), networkInfos.size());
+    cloudDecimations.resize(networkInfos.size());
+    for(size_t ii = 0; ii < networkInfos.size(); ++ii){
+        if(cloudDecimations[ii] == nullptr){
+            cloudDecimations[ii] = std::make_unique<CloudDecimation>();
+        }
+        cloudDecimations[ii]->set_settings({decimationMode, budgets[ii]});
+    }
+
     set<int>(ParametersContainer::Dynamic, "network_config_file_loaded",      networkFileLoaded ? 1 : 0);
     set<int>(ParametersContainer::Dynamic, "calibration_config_file_loaded",  calibFileLoaded ? 1 : 0);
     set<int>(ParametersContainer::Dynamic, "camera_config_file_loaded",       cameraFileLoaded ? 1 : 0);
@@ -300,21 +316,78 @@ size_t K2ManagerExComponent::update_cloud(size_t idCamera, geo::Pt3f *points, ge
     }
 
     grabbersCloudData[idCamera]->dataLocker.lock();
-    const auto sizePts = grabbersCloudData[idCamera]->sizePts;
-    std::copy(grabbersCloudData[idCamera]->points->begin(), grabbersCloudData[idCamera]->points->begin() + static_cast<int>(sizePts), points);
-    for(size_t ii = 0; ii < sizePts; ++ii){
-        colors[ii].x() = (*grabbersCloudData[idCamera]->colors)[ii].x();
-        colors[ii].y() = (*grabbersCloudData[idCamera]->colors)[ii].y();
-        colors[ii].z() = (*grabbersCloudData[idCamera]->colors)[ii].z();
-        colors[ii].w() = 1.f;
+    const auto &cloudPoints = *grabbersCloudData[idCamera]->points;
+    const auto &cloudColors = *grabbersCloudData[idCamera]->colors;
+    auto sizePts = grabbersCloudData[idCamera]->sizePts;
+
+    auto &decimation = *cloudDecimations[idCamera];
+    if(decimation.decimate(cloudPoints.data(), sizeof(geo::Pt3f), sizePts)){
+        decimation.copy(cloudPoints.data(), points);
+        sizePts = decimation.output_count();
+        const auto kept = decimation.kept_indices();
+        for(size_t ii = 0; ii < sizePts; ++ii){
+            colors[ii].x() = cloudColors[kept[ii]].x();
+            colors[ii].y() = cloudColors[kept[ii]].y();
+            colors[ii].z() = cloudColors[kept[ii]].z();
+            colors[ii].w() = 1.f;
+        }
+    }else{
+        std::copy(cloudPoints.begin(), cloudPoints.begin() + static_cast<int>(sizePts), points);
+        for(size_t ii = 0; ii < sizePts; ++ii){
+            colors[ii].x() = cloudColors[ii].x();
+            colors[ii].y() = cloudColors[ii].y();
+            colors[ii].z() = cloudColors[ii].z();
+            colors[ii].w() = 1.f;
+        }
     }
 
     set<int>(ParametersContainer::Dynamic, std::format("nb_pts_{}",idCamera), static_cast<int>(sizePts));
+    set<int>(ParametersContainer::Dynamic,   std::format("decimated_points_count_{}", idCamera), static_cast<int>(sizePts));
+    set<float>(ParametersContainer::Dynamic, std::format("decimation_time_ms_{}", idCamera),     static_cast<float>(decimation.last_duration_ms()));
     grabbersCloudData[idCamera]->dataLocker.unlock();
 
     return sizePts;
 }
 
+size_t K2ManagerExComponent::fuse_clouds(){
+
+    if(debugBypass){
+        return 0;
+    }
+
+    // clouds are locked while being transformed
+    cloudFusionInputs.resize(calibrationsM.size());
+    for(size_t idCamera = 0; idCamera < calibrationsM.size(); ++idCamera){
+        auto &input = cloudFusionInputs[idCamera];
+        input = {};
+        for(size_t jj = 0; jj < 16; ++jj){
+            input.transform[jj] = static_cast<float>(calibrationsM[idCamera].array[jj]);
+        }
+        if(grabbersCloudData.count(idCamera) != 0){
+            auto cloud = grabbersCloudData[idCamera];
+            static_assert(sizeof((*cloud->points)[0]) == 3*sizeof(float));
+            static_assert(sizeof((*cloud->colors)[0]) == 3*sizeof(float));
+            cloud->dataLocker.lock();
+            input.positions = reinterpret_cast<const float*>(cloud->points->data());
+            input.colorsF   = reinterpret_cast<const float*>(cloud->colors->data());
+            input.count     = cloud->sizePts;
+        }
+    }
+
+    const auto count = cloudFusion.fuse(cloudFusionInputs);
+
+    for(size_t idCamera = 0; idCamera < calibrationsM.size(); ++idCamera){
+        if(grabbersCloudData.count(idCamera) != 0){
+            grabbersCloudData[idCamera]->dataLocker.unlock();
+        }
+    }
+
+    set<int>(ParametersContainer::Dynamic,   "fused_points_count",    static_cast<int>(count));
+    set<int>(ParametersContainer::Dynamic,   "fusion_removed_points", static_cast<int>(cloudFusion.removed_points_count()));
+    set<float>(ParametersContainer::Dynamic, "fusion_time_ms",        static_cast<float>(cloudFusion.last_duration_ms()));
+    return count;
+}
+
 void K2ManagerExComponent::update_mesh(size_t idCamera, Pt3f *points, Pt4f *colors, Pt3<std::int32_t> *idTris){
 
     set<int>(ParametersContainer::Dynamic, std::format("nb_pts_{}",idCamera), 0);
@@ -32,6 +32,10 @@
 #include "exvr/ex_component.hpp"
 #include "grabber_controller.hpp"
 
+// local
+#include "cloud_fusion.hpp"
+#include "cloud_decimation.hpp"
+
 namespace tool::ex {
 
 
@@ -51,6 +55,9 @@ public:
 
     void ask_for_frame();
 
+    // world space cloud of every camera in one buffer, valid until the next fuse
+    size_t fuse_clouds();
+
     std::vector<tool::scan::GrabberControllerUP> grabbers;
     std::unordered_map<size_t, camera::K2CloudDisplayData*> grabbersCloudData;
     std::unordered_map<size_t, camera::K2MeshDisplayData*> grabbersMeshData;
@@ -61,6 +68,10 @@ public:
     std::vector<camera::K2GrabberTargetInfo> networkInfos;
     std::vector<geo::Mat4d> calibrationsM;
 
+    CloudFusion cloudFusion;
+    std::vector<CloudFusionInput> cloudFusionInputs;
+    std::vector<std::unique_ptr<CloudDecimation>> cloudDecimations;
+
     bool cleaned = false;
     bool debugBypass = false;
 
@@ -52,3 +52,11 @@ void update_bodies_k2_manager_ex_component(K2ManagerExComponent *c, int idC, int
 void ask_for_frame_k2_manager_ex_component(K2ManagerExComponent *c){
     c->ask_for_frame();
 }
+
+int fuse_clouds_k2_manager_ex_component(K2ManagerExComponent *c){
+    return static_cast<int>(c->fuse_clouds());
+}
+
+const void *get_fused_cloud_data_k2_manager_ex_component(K2ManagerExComponent *c){
+    return c->cloudFusion.vertices().data();
+}
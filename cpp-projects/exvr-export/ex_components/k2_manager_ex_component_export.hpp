@@ -37,6 +37,8 @@ extern "C"{
     DECL_EXPORT void update_bodies_k2_manager_ex_component(tool::ex::K2ManagerExComponent *c,
             int idC, int *bodiesInfo, int *jointsType, int *jointsState, float *jointsPosition, float *jointsRotation);
     DECL_EXPORT void ask_for_frame_k2_manager_ex_component(tool::ex::K2ManagerExComponent *c);
+    DECL_EXPORT int fuse_clouds_k2_manager_ex_component(tool::ex::K2ManagerExComponent *c);
+    DECL_EXPORT const void *get_fused_cloud_data_k2_manager_ex_component(tool::ex::K2ManagerExComponent *c);
 }
 
 
@@ -38,6 +38,11 @@
 #include "camera/kinect4/k4_server_data.hpp"
 #include "camera/kinect4/k4_model.hpp"
 
+// local
+#include "frames_synchronizer.hpp"
+#include "cloud_fusion.hpp"
+#include "cloud_decimation.hpp"
+
 using namespace std::chrono;
 
 using namespace tool;
@@ -56,6 +61,15 @@ struct GrabberSettings{
     camera::K4Model model;
 };
 
+// frame with the points kept by the decimation of its camera, computed on the reception thread
+struct DecimatedFrame{
+    std::shared_ptr<K4Frame> frame = nullptr;
+    bool decimated = false;             /**< every point is kept otherwise */
+    std::vector<std::uint32_t> kept;
+    size_t outputCount = 0;
+    double decimationMs = 0.;
+};
+
 struct K4ManagerExComponent::Impl{
 
     K4ServerNetwork network;
@@ -69,6 +83,19 @@ struct K4ManagerExComponent::Impl{
 
     std::atomic_int framesReceived = 0;
 
+    bool synchronize = false;
+    FramesSynchronizer<DecimatedFrame> synchronizer;
+    std::vector<size_t> lastCaptureId; /**< only accessed by the reception thread of each camera */
+    std::mutex latestL;
+    std::vector<std::shared_ptr<DecimatedFrame>> latestFrames;
+
+    CloudFusion fusion;
+    std::vector<std::array<float,16>> transforms;
+    std::vector<std::shared_ptr<DecimatedFrame>> fusedFrames;
+    std::vector<CloudFusionInput> fusionInputs;
+
+    std::vector<std::unique_ptr<CloudDecimation>> decimations; /**< only used by the reception thread of each camera */
+
     std::vector<size_t> indices1D;
 
     auto set_connections() -> void{
@@ -82,9 +109,50 @@ struct K4ManagerExComponent::Impl{
         K4ServerConnection::compressed_frame_signal.connect([&](size_t idCamera, std::shared_ptr<camera::K4CompressedFrame> cloudFrame){
             framesReceived++;
             serverData.new_compressed_frame(idCamera, cloudFrame);
+            new_frame(idCamera);
         });
     }
 
+    // called from the frames reception thread of the camera: the new capture is decimated once and
+    // every capture is buffered by the synchronizer even if several arrive between two updates
+    auto new_frame(size_t idCamera) -> void{
+
+        auto frame = serverData.get_frame(idCamera);
+        if(frame == nullptr || idCamera >= decimations.size() || idCamera >= lastCaptureId.size() || frame->idCapture == lastCaptureId[idCamera]){
+            return;
+        }
+        lastCaptureId[idCamera] = frame->idCapture;
+
+        static_assert(sizeof(frame->cloud.vertices[0]) == 3*sizeof(float));
+        auto decimatedFrame = std::make_shared<DecimatedFrame>();
+        auto &decimation = *decimations[idCamera];
+        decimatedFrame->decimated = decimation.decimate(frame->cloud.vertices.data(), sizeof(frame->cloud.vertices[0]), frame->cloud.size());
+        if(decimatedFrame->decimated){
+            const auto kept = decimation.kept_indices();
+            decimatedFrame->kept.assign(kept.begin(), kept.end());
+            decimatedFrame->outputCount = kept.size();
+        }else{
+            decimatedFrame->outputCount = frame->cloud.size();
+        }
+        decimatedFrame->decimationMs = decimation.last_duration_ms();
+        decimatedFrame->frame        = std::move(frame);
+
+        if(synchronize){
+            synchronizer.push(idCamera, static_cast<std::int64_t>(decimatedFrame->frame->afterCaptureTS), decimatedFrame);
+        }
+        std::lock_guard<std::mutex> lock(latestL);
+        latestFrames[idCamera] = std::move(decimatedFrame);
+    }
+
+    // only complete sets of frames are used when the cameras are synchronized
+    auto current_frame(size_t idCamera) -> std::shared_ptr<DecimatedFrame>{
+        if(synchronize){
+            return synchronizer.frame(idCamera);
+        }
+        std::lock_guard<std::mutex> lock(latestL);
+        return idCamera < latestFrames.size() ? latestFrames[idCamera] : nullptr;
+    }
+
     auto delete_connections(){
         K4ServerConnection::feedback_signal.disconnect_all();
         K4ServerConnection::compressed_frame_signal.disconnect_all();
@@ -240,16 +308,35 @@ auto K4ManagerExComponent::initialize() -> bool{
 
 
     // transmit calibration matrices
+    i->transforms.resize(i->grabbersS.size());
     for(size_t ii = 0; ii < i->grabbersS.size(); ++ii){
 
         std::vector<float> m(16, 0.f);
         for(size_t jj = 0; jj < 16; ++jj){
             m[jj] = static_cast<float>(i->grabbersS[ii].model.transformation.array[jj]);
         }
+        std::copy(m.begin(), m.end(), i->transforms[ii].begin());
         std::string name = "tr_" + std::to_string(ii);
         set_array(ParametersContainer::Dynamic, name, m);
     }
 
+    CloudFusionSettings fusionS;
+    fusionS.removeOverlaps = get<int>(ParametersContainer::InitConfig, "fusion_remove_overlaps") == 1;
+    fusionS.voxelSize      = get<float>(ParametersContainer::InitConfig, "fusion_voxel_size_mm") * 0.001f;
+    i->fusion.set_settings(fusionS);
+    i->fusedFrames.clear();
+
+    // level of detail of the clouds sent to the caller and fused
+    const auto decimationMode = static_cast<CloudDecimationMode>(get<int>(ParametersContainer::InitConfig, "decimation_mode"));
+    const auto budgets = CloudDecimation::budgets_from_string(get<std::string>(ParametersContainer::InitConfig, "decimation_budgets"), i->grabbersS.size());
+    i->decimations.resize(i->grabbersS.size());
+    for(size_t ii = 0; ii < i->grabbersS.size(); ++ii){
+        if(i->decimations[ii] == nullptr){
+            i->decimations[ii] = std::make_unique<CloudDecimation>();
+        }
+        i->decimations[ii]->set_settings({decimationMode, budgets[ii]});
+    }
+
     if(debugBypass){
         return true;
     }
@@ -262,6 +349,16 @@ auto K4ManagerExComponent::initialize() -> bool{
 
     i->serverData.initialize(i->network.connections_nb());   
 
+    // synchronization of the cameras frames
+    i->synchronize = get<int>(ParametersContainer::InitConfig, "sync_cameras") == 1;
+    FramesSyncSettings syncS;
+    syncS.toleranceNs    = static_cast<std::int64_t>(get<float>(ParametersContainer::InitConfig, "sync_tolerance_ms") * 1'000'000.f);
+    syncS.bufferSize     = static_cast<size_t>(std::max(get<int>(ParametersContainer::InitConfig, "sync_buffer_size"), 1));
+    syncS.latestFallback = get<int>(ParametersContainer::InitConfig, "sync_latest_fallback") == 1;
+    i->synchronizer.reset(i->network.connections_nb(), syncS);
+    i->lastCaptureId.assign(i->network.connections_nb(), std::numeric_limits<size_t>::max());
+    i->latestFrames.assign(i->network.connections_nb(), nullptr);
+
     return true;
 }
 
@@ -320,6 +417,24 @@ auto K4ManagerExComponent::update() -> void{
 
     set<int>(ParametersContainer::Dynamic, "nb_frames_received", i->framesReceived);
 
+    if(i->synchronize){
+        update_synchronization();
+    }
+
+}
+
+auto K4ManagerExComponent::update_synchronization() -> void{
+
+    // frames are pushed with their capture timestamp by the reception callback
+    i->synchronizer.update();
+
+    const auto stats = i->synchronizer.statistics();
+    set<int>(ParametersContainer::Dynamic,   "sync_sets_count",      static_cast<int>(stats.setsCount));
+    set<int>(ParametersContainer::Dynamic,   "sync_fallbacks_count", static_cast<int>(stats.fallbacksCount));
+    set<int>(ParametersContainer::Dynamic,   "sync_dropped_frames",  static_cast<int>(stats.droppedFrames));
+    set<float>(ParametersContainer::Dynamic, "sync_last_skew_ms",    static_cast<float>(stats.lastSkewMs));
+    set<float>(ParametersContainer::Dynamic, "sync_average_skew_ms", static_cast<float>(stats.averageSkewMs));
+    set<float>(ParametersContainer::Dynamic, "sync_max_skew_ms",     static_cast<float>(stats.maxSkewMs));
 }
 
 auto K4ManagerExComponent::read_messages() -> void{
@@ -363,10 +478,11 @@ auto K4ManagerExComponent::read_messages() -> void{
 
 auto K4ManagerExComponent::get_cloud_frame_data(size_t idCamera, size_t currentFrameId, camera::K4VertexMeshData *vertices) -> std::tuple<bool, size_t, size_t>{
 
-    if(auto frame = i->serverData.get_frame(idCamera); frame != nullptr){
+    if(auto decimatedFrame = i->current_frame(idCamera); decimatedFrame != nullptr){
 
+        const auto &frame = decimatedFrame->frame;
         if(currentFrameId == frame->idCapture){
-            return {false, frame->idCapture, frame->cloud.size()};
+            return {false, frame->idCapture, decimatedFrame->outputCount};
         }
 
 //        if(i->indices1D.size() < frame->cloud.size()){
@@ -385,20 +501,80 @@ auto K4ManagerExComponent::get_cloud_frame_data(size_t idCamera, size_t currentF
 //            };
 //        });
 
-        for(size_t id = 0; id < frame->cloud.size(); ++id){
-            vertices[id].pos = frame->cloud.vertices[id];
-//            vertices[id].pos.x() *= -1.f;
-            vertices[id].col = geo::Pt4<std::uint8_t>{
-                static_cast<std::uint8_t>(frame->cloud.colors[id].x()*255.f),
-                static_cast<std::uint8_t>(frame->cloud.colors[id].y()*255.f),
-                static_cast<std::uint8_t>(frame->cloud.colors[id].z()*255.f),
+        auto copy_vertex = [&](size_t idDst, size_t idSrc){
+            vertices[idDst].pos = frame->cloud.vertices[idSrc];
+//            vertices[idDst].pos.x() *= -1.f;
+            vertices[idDst].col = geo::Pt4<std::uint8_t>{
+                static_cast<std::uint8_t>(frame->cloud.colors[idSrc].x()*255.f),
+                static_cast<std::uint8_t>(frame->cloud.colors[idSrc].y()*255.f),
+                static_cast<std::uint8_t>(frame->cloud.colors[idSrc].z()*255.f),
                 255
             };
-        }
+        };
 
+        // kept points found by the reception thread
+        if(decimatedFrame->decimated){
+            for(size_t id = 0; id < decimatedFrame->kept.size(); ++id){
+                copy_vertex(id, decimatedFrame->kept[id]);
+            }
+        }else{
+            for(size_t id = 0; id < frame->cloud.size(); ++id){
+                copy_vertex(id, id);
+            }
+        }
+        set<int>(ParametersContainer::Dynamic,   std::format("decimated_points_count_{}", idCamera), static_cast<int>(decimatedFrame->outputCount));
+        set<float>(ParametersContainer::Dynamic, std::format("decimation_time_ms_{}", idCamera),     static_cast<float>(decimatedFrame->decimationMs));
 
-        return {true, frame->idCapture, frame->cloud.size()};
+        return {true, frame->idCapture, decimatedFrame->outputCount};
     }
     return {false, 0, 0};
 }
 
+
+auto K4ManagerExComponent::fuse_clouds() -> size_t{
+
+    static_assert(sizeof(CloudFusionInput::transform) == 16*sizeof(float));
+    static_assert(sizeof(camera::K4VertexMeshData) == sizeof(FusedVertex));
+
+    // current frames of every camera, the fused cloud is kept if none changed
+    const size_t camerasCount = i->transforms.size();
+    bool changed = i->fusedFrames.size() != camerasCount;
+    i->fusedFrames.resize(camerasCount);
+    for(size_t idCamera = 0; idCamera < camerasCount; ++idCamera){
+        auto frame = i->current_frame(idCamera);
+        if(frame != i->fusedFrames[idCamera]){
+            i->fusedFrames[idCamera] = std::move(frame);
+            changed = true;
+        }
+    }
+    if(!changed){
+        return i->fusion.vertices().size();
+    }
+
+    i->fusionInputs.resize(camerasCount);
+    for(size_t idCamera = 0; idCamera < camerasCount; ++idCamera){
+        auto &input = i->fusionInputs[idCamera];
+        input = {};
+        input.transform = i->transforms[idCamera];
+        if(const auto &decimatedFrame = i->fusedFrames[idCamera]; decimatedFrame != nullptr){
+            // the per camera budgets also apply to the fused cloud
+            const auto &frame = decimatedFrame->frame;
+            static_assert(sizeof(frame->cloud.vertices[0]) == 3*sizeof(float));
+            static_assert(sizeof(frame->cloud.colors[0]) == 3*sizeof(float));
+            input.positions = reinterpret_cast<const float*>(frame->cloud.vertices.data());
+            input.colorsF   = reinterpret_cast<const float*>(frame->cloud.colors.data());
+            input.indices   = decimatedFrame->decimated ? decimatedFrame->kept.data() : nullptr;
+            input.count     = decimatedFrame->outputCount;
+        }
+    }
+
+    const auto count = i->fusion.fuse(i->fusionInputs);
+    set<int>(ParametersContainer::Dynamic,   "fused_points_count",    static_cast<int>(count));
+    set<int>(ParametersContainer::Dynamic,   "fusion_removed_points", static_cast<int>(i->fusion.removed_points_count()));
+    set<float>(ParametersContainer::Dynamic, "fusion_time_ms",        static_cast<float>(i->fusion.last_duration_ms()));
+    return count;
+}
+
+auto K4ManagerExComponent::fused_cloud_data() const -> const camera::K4VertexMeshData*{
+    return reinterpret_cast<const camera::K4VertexMeshData*>(i->fusion.vertices().data());
+}
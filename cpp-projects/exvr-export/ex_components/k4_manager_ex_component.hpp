@@ -48,7 +48,11 @@ public:
     auto update() -> void override;
 
     auto read_messages() -> void;
+    auto update_synchronization() -> void;
     auto get_cloud_frame_data(size_t idCamera, size_t currentFrameId, camera::K4VertexMeshData *vertices) -> std::tuple<bool, size_t, size_t>;
+    // world space cloud of every camera in one buffer, valid until the next fuse
+    auto fuse_clouds() -> size_t;
+    auto fused_cloud_data() const -> const camera::K4VertexMeshData*;
 
     bool debugBypass = false;
 
@@ -41,5 +41,13 @@ void retrieve_cloud_frame_data_k4_manager_ex_component(
     lastFrameState[2] = static_cast<int>(std::get<2>(ret));
 }
 
+int fuse_clouds_k4_manager_ex_component(K4ManagerExComponent *c){
+    return static_cast<int>(c->fuse_clouds());
+}
+
+const camera::K4VertexMeshData *get_fused_cloud_data_k4_manager_ex_component(K4ManagerExComponent *c){
+    return c->fused_cloud_data();
+}
+
 
 // store frame
@@ -42,6 +42,9 @@ extern "C"{
         tool::camera::K4VertexMeshData *vertices,
         int *lastFrameState
     );
+
+    DECL_EXPORT int fuse_clouds_k4_manager_ex_component(tool::ex::K4ManagerExComponent *c);
+    DECL_EXPORT const tool::camera::K4VertexMeshData *get_fused_cloud_data_k4_manager_ex_component(tool::ex::K4ManagerExComponent *c);
 }
 
 
@@ -30,6 +30,7 @@
 
 // local
 #include "ex_resources/k4_volumetric_video_ex_resource.hpp"
+#include "cloud_decimation.hpp"
 
 namespace tool::ex {
 
@@ -37,9 +38,12 @@ class K4VolumetricVideoExComponent : public ExComponent{
 public:
 
     tool::camera::K4VolumetricVideo *resource = nullptr;
+    K4DecodedFramesCache *framesCache = nullptr;
     std::vector<std::unique_ptr<tool::camera::K4FrameUncompressor>> uncompressors; // dedicated uncompressors for enabling multithreads when using the same video resource
+    std::vector<std::unique_ptr<CloudDecimation>> decimations; // applied to the caller buffers, the cache keeps full resolution frames
 
-    K4VolumetricVideoExComponent(tool::ex::K4VolumetricVideoExResource *resourceExport) : resource(&resourceExport->video){
+    K4VolumetricVideoExComponent(tool::ex::K4VolumetricVideoExResource *resourceExport) :
+        resource(&resourceExport->video), framesCache(&resourceExport->framesCache){
     }
 
     bool initialize() override{
@@ -50,6 +54,14 @@ public:
             uncompressor = std::make_unique<tool::camera::K4FrameUncompressor>();
         }
 
+        const auto decimationMode = static_cast<CloudDecimationMode>(get<int>(ParametersContainer::InitConfig, "decimation_mode"));
+        const auto budgets = CloudDecimation::budgets_from_string(get<std::string>(ParametersContainer::InitConfig, "decimation_budgets"), nbCams);
+        decimations.resize(nbCams);
+        for(size_t ii = 0; ii < decimations.size(); ++ii){
+            decimations[ii] = std::make_unique<CloudDecimation>();
+            decimations[ii]->set_settings({decimationMode, budgets[ii]});
+        }
+
         return true;
     }
 
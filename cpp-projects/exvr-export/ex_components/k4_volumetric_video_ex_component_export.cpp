@@ -35,27 +35,111 @@ K4VolumetricVideoExComponent *create_k4_volumetric_video_ex_component(K4Volumetr
     return new K4VolumetricVideoExComponent(resourceExport);
 }
 
+static size_t valid_vertices_count(K4VolumetricVideoExComponent *vvC, int idC, int idFrame){
+    return vvC->resource->get_camera_data(idC)->valid_vertices_count(idFrame);
+}
+
 int uncompress_frame_c4f_k4_volumetric_video_ex_component(K4VolumetricVideoExComponent *vvC, int idC, int idFrame, tool::geo::Pt3f *vertices, tool::geo::Pt4f *colors){
+
+    auto &decimation = *vvC->decimations[idC];
+    if(auto decoded = vvC->framesCache->get(idC, idFrame, K4DecodedFrameFormat::C4F)){
+        if(decimation.decimate(decoded->vertices.data(), sizeof(Pt3f), decoded->vertices.size())){
+            decimation.copy(decoded->vertices.data(), vertices);
+            decimation.copy(decoded->colorsF.data(), colors);
+        }else{
+            std::copy(std::begin(decoded->vertices), std::end(decoded->vertices), vertices);
+            std::copy(std::begin(decoded->colorsF), std::end(decoded->colorsF), colors);
+        }
+        return 1;
+    }
+
     if(auto frame = vvC->resource->get_compressed_frame(idC, idFrame).lock()){
-        return vvC->uncompressors[idC]->uncompress(frame.get(),  vertices, colors) ? 1 : 0;
+        if(!vvC->uncompressors[idC]->uncompress(frame.get(),  vertices, colors)){
+            return 0;
+        }
+        auto decoded = std::make_shared<K4DecodedFrame>();
+        const auto count = decoded->verticesCount = valid_vertices_count(vvC, idC, idFrame);
+        decoded->vertices.assign(vertices, vertices + count);
+        decoded->colorsF.assign(colors, colors + count);
+        vvC->framesCache->insert(idC, idFrame, K4DecodedFrameFormat::C4F, std::move(decoded));
+        if(decimation.decimate(vertices, sizeof(Pt3f), count)){
+            decimation.compact(vertices);
+            decimation.compact(colors);
+        }
+        return 1;
     }
     return 0;
 }
 
 int uncompress_frame_c3i_k4_volumetric_video_ex_component(K4VolumetricVideoExComponent *vvC, int idC, int idFrame, tool::geo::Pt3f *vertices, tool::geo::Pt4<uint8_t> *colors){
+
+    auto &decimation = *vvC->decimations[idC];
+    if(auto decoded = vvC->framesCache->get(idC, idFrame, K4DecodedFrameFormat::C3I)){
+        if(decimation.decimate(decoded->vertices.data(), sizeof(Pt3f), decoded->vertices.size())){
+            decimation.copy(decoded->vertices.data(), vertices);
+            decimation.copy(decoded->colorsI.data(), colors);
+        }else{
+            std::copy(std::begin(decoded->vertices), std::end(decoded->vertices), vertices);
+            std::copy(std::begin(decoded->colorsI), std::end(decoded->colorsI), colors);
+        }
+        return 1;
+    }
+
     if(auto frame = vvC->resource->get_compressed_frame(idC, idFrame).lock()){
-        return vvC->uncompressors[idC]->uncompress(frame.get(),  vertices, colors) ? 1 : 0;
+        if(!vvC->uncompressors[idC]->uncompress(frame.get(),  vertices, colors)){
+            return 0;
+        }
+        auto decoded = std::make_shared<K4DecodedFrame>();
+        const auto count = decoded->verticesCount = valid_vertices_count(vvC, idC, idFrame);
+        decoded->vertices.assign(vertices, vertices + count);
+        decoded->colorsI.assign(colors, colors + count);
+        vvC->framesCache->insert(idC, idFrame, K4DecodedFrameFormat::C3I, std::move(decoded));
+        if(decimation.decimate(vertices, sizeof(Pt3f), count)){
+            decimation.compact(vertices);
+            decimation.compact(colors);
+        }
+        return 1;
     }
     return 0;
 }
 
 int uncompress_frame_vmd_k4_volumetric_video_ex_component(K4VolumetricVideoExComponent *vvC, int idC, int idFrame, tool::camera::K4VertexMeshData *vertices){
+
+    // positions are the first member of the vertices
+    auto &decimation = *vvC->decimations[idC];
+    if(auto decoded = vvC->framesCache->get(idC, idFrame, K4DecodedFrameFormat::VMD)){
+        if(decimation.decimate(decoded->mesh.data(), sizeof(K4VertexMeshData), decoded->mesh.size())){
+            decimation.copy(decoded->mesh.data(), vertices);
+        }else{
+            std::copy(std::begin(decoded->mesh), std::end(decoded->mesh), vertices);
+        }
+        return 1;
+    }
+
     if(auto frame = vvC->resource->get_compressed_frame(idC, idFrame).lock()){
-        return vvC->uncompressors[idC]->uncompress(frame.get(), vertices) ? 1 : 0;
+        if(!vvC->uncompressors[idC]->uncompress(frame.get(), vertices)){
+            return 0;
+        }
+        auto decoded = std::make_shared<K4DecodedFrame>();
+        const auto count = decoded->verticesCount = valid_vertices_count(vvC, idC, idFrame);
+        decoded->mesh.assign(vertices, vertices + count);
+        vvC->framesCache->insert(idC, idFrame, K4DecodedFrameFormat::VMD, std::move(decoded));
+        if(decimation.decimate(vertices, sizeof(K4VertexMeshData), count)){
+            decimation.compact(vertices);
+        }
+        return 1;
     }
     return 0;
 }
 
+int get_decimated_vertices_count_k4_volumetric_video_ex_component(K4VolumetricVideoExComponent *vvC, int idC){
+    return static_cast<int>(vvC->decimations[idC]->output_count());
+}
+
+float get_decimation_time_ms_k4_volumetric_video_ex_component(K4VolumetricVideoExComponent *vvC, int idC){
+    return static_cast<float>(vvC->decimations[idC]->last_duration_ms());
+}
+
 int process_audio_k4_volumetric_video_ex_component(K4VolumetricVideoExComponent *vvC, int idCamera){
     if(idCamera < vvC->audioData.size()){
         vvC->resource->get_audio_samples_all_channels(idCamera, vvC->audioData[idCamera]);
@@ -50,6 +50,13 @@ extern "C"{
         int idC, int idFrame,
         tool::camera::K4VertexMeshData *vertices);
 
+    // vertices written by the last uncompress call of the camera
+    DECL_EXPORT int get_decimated_vertices_count_k4_volumetric_video_ex_component(
+        tool::ex::K4VolumetricVideoExComponent *vvC, int idC);
+
+    DECL_EXPORT float get_decimation_time_ms_k4_volumetric_video_ex_component(
+        tool::ex::K4VolumetricVideoExComponent *vvC, int idC);
+
     DECL_EXPORT int process_audio_k4_volumetric_video_ex_component(
         tool::ex::K4VolumetricVideoExComponent *vvC, int idCamera);
 
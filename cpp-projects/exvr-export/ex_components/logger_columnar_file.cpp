@@ -0,0 +1,674 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "logger_columnar_file.hpp"
+
+// std
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace tool::ex;
+
+namespace {
+
+constexpr std::uint32_t headerMagic  = 0x474C5845; // EXLG
+constexpr std::uint32_t chunkMagic   = 0x4B4E4843; // CHNK
+constexpr std::uint32_t footerMagic  = 0x544F4F46; // FOOT
+constexpr std::uint32_t version      = 1;
+constexpr size_t trailerSize         = sizeof(std::uint64_t) + sizeof(std::uint32_t);
+
+auto chunk_header_size(size_t columnsCount) -> size_t{
+    return 2*sizeof(std::uint32_t) + 2*sizeof(double) + columnsCount*sizeof(std::uint32_t);
+}
+
+template<typename T>
+auto put(std::vector<std::uint8_t> &buffer, const T &value) -> void{
+    const auto position = buffer.size();
+    buffer.resize(position + sizeof(T));
+    std::memcpy(buffer.data() + position, &value, sizeof(T));
+}
+
+auto put(std::vector<std::uint8_t> &buffer, std::string_view text) -> void{
+    put(buffer, static_cast<std::uint32_t>(text.size()));
+    buffer.insert(buffer.end(), text.begin(), text.end());
+}
+
+auto put_varint(std::vector<std::uint8_t> &buffer, std::uint32_t value) -> void{
+    while(value >= 0x80){
+        buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<std::uint8_t>(value));
+}
+
+// bounds checked reads of a loaded block
+struct BlockReader{
+
+    template<typename T>
+    auto get(T &value) -> bool{
+        if(position + sizeof(T) > size){
+            return false;
+        }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    auto get(std::string &text) -> bool{
+        std::uint32_t length = 0;
+        if(!get(length) || position + length > size){
+            return false;
+        }
+        text.assign(reinterpret_cast<const char*>(data + position), length);
+        position += length;
+        return true;
+    }
+
+    auto skip_text() -> bool{
+        std::uint32_t length = 0;
+        if(!get(length) || position + length > size){
+            return false;
+        }
+        position += length;
+        return true;
+    }
+
+    auto get_varint(std::uint32_t &value) -> bool{
+        value = 0;
+        for(int shift = 0; shift < 35; shift += 7){
+            if(position >= size){
+                return false;
+            }
+            const auto byte = data[position++];
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            if((byte & 0x80) == 0){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::uint8_t *data = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+};
+
+auto read_bytes(std::ifstream &file, std::uint64_t offset, size_t size, std::vector<std::uint8_t> &buffer) -> bool{
+    buffer.resize(size);
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size));
+    return static_cast<size_t>(file.gcount()) == size;
+}
+}
+
+ColumnarLogWriter::~ColumnarLogWriter(){
+    close();
+}
+
+auto ColumnarLogWriter::open(const std::string &path, std::vector<ColumnarLogColumn> columns, int timeColumn) -> bool{
+
+    close();
+
+    if(m_file = std::fopen(path.c_str(), "wb"); m_file == nullptr){
+        return false;
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, 1024*1024);
+
+    m_columns       = std::move(columns);
+    m_timeColumn    = (timeColumn >= 0 && timeColumn < static_cast<int>(m_columns.size()) && m_columns[timeColumn].type == ColumnarLogType::Real) ? timeColumn : -1;
+    m_chunks.clear();
+    m_offset        = 0;
+    m_bytesWritten  = 0;
+    m_rows          = 0;
+    m_timeMin       = std::numeric_limits<double>::quiet_NaN();
+    m_timeMax       = std::numeric_limits<double>::quiet_NaN();
+
+    m_blocks.clear();
+    m_blocks.resize(m_columns.size());
+    for(size_t ii = 0; ii < m_columns.size(); ++ii){
+        if(m_columns[ii].type == ColumnarLogType::Text){
+            // id 0 is the empty text
+            m_blocks[ii].dictionary.push_back({});
+            m_blocks[ii].ids[{}] = 0;
+        }
+    }
+
+    m_buffer.clear();
+    put(m_buffer, headerMagic);
+    put(m_buffer, version);
+    put(m_buffer, static_cast<std::uint32_t>(m_columns.size()));
+    for(const auto &column : m_columns){
+        put(m_buffer, column.type);
+        put(m_buffer, std::string_view(column.name));
+    }
+    put(m_buffer, static_cast<std::int32_t>(m_timeColumn));
+    write(m_buffer.data(), m_buffer.size());
+
+    return true;
+}
+
+auto ColumnarLogWriter::add_row(const std::vector<ColumnarLogValue> &values) -> void{
+
+    if(m_file == nullptr){
+        return;
+    }
+
+    for(size_t ii = 0; ii < m_columns.size(); ++ii){
+
+        const auto value = ii < values.size() ? values[ii] : ColumnarLogValue{};
+        auto &block = m_blocks[ii];
+
+        if(m_columns[ii].type == ColumnarLogType::Real){
+
+            double real = std::numeric_limits<double>::quiet_NaN();
+            if(value.type == ColumnarLogValue::Type::Real){
+                real = value.real;
+            }else if(value.type == ColumnarLogValue::Type::Text){
+                std::from_chars(value.text.data(), value.text.data() + value.text.size(), real);
+            }
+            add_real(block, real);
+
+            if(static_cast<int>(ii) == m_timeColumn && !std::isnan(real)){
+                if(std::isnan(m_timeMin) || real < m_timeMin){
+                    m_timeMin = real;
+                }
+                if(std::isnan(m_timeMax) || real > m_timeMax){
+                    m_timeMax = real;
+                }
+            }
+
+        }else{
+
+            if(value.type == ColumnarLogValue::Type::Text){
+                add_text(block, value.text);
+            }else if(value.type == ColumnarLogValue::Type::Real){
+                char digits[32];
+                const auto result = std::to_chars(digits, digits + sizeof(digits), value.real);
+                add_text(block, std::string_view(digits, result.ptr - digits));
+            }else{
+                put_varint(block.data, 0);
+            }
+        }
+    }
+
+    if(++m_rows == rowsPerChunk){
+        write_chunk();
+    }
+}
+
+auto ColumnarLogWriter::close() -> void{
+
+    if(m_file == nullptr){
+        return;
+    }
+
+    write_chunk();
+
+    const std::uint64_t footerOffset = m_offset;
+    m_buffer.clear();
+    put(m_buffer, footerMagic);
+    put(m_buffer, static_cast<std::uint32_t>(m_chunks.size()));
+    for(const auto &chunk : m_chunks){
+        put(m_buffer, chunk.offset);
+        put(m_buffer, chunk.rowsCount);
+        put(m_buffer, chunk.timeMin);
+        put(m_buffer, chunk.timeMax);
+    }
+    for(const auto &block : m_blocks){
+        put(m_buffer, static_cast<std::uint32_t>(block.dictionary.size()));
+        for(const auto &text : block.dictionary){
+            put(m_buffer, std::string_view(text));
+        }
+    }
+    put(m_buffer, footerOffset);
+    put(m_buffer, footerMagic);
+    write(m_buffer.data(), m_buffer.size());
+
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+auto ColumnarLogWriter::flush() -> void{
+    if(m_file != nullptr){
+        std::fflush(m_file);
+    }
+}
+
+auto ColumnarLogWriter::sync() -> void{
+
+    if(m_file == nullptr){
+        return;
+    }
+
+    // current rows are written as a smaller chunk
+    write_chunk();
+    std::fflush(m_file);
+#if defined(_WIN32)
+    _commit(_fileno(m_file));
+#else
+    fsync(fileno(m_file));
+#endif
+}
+
+auto ColumnarLogWriter::add_real(ColumnBlock &block, double value) -> void{
+
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(double));
+    const std::uint64_t x = bits ^ block.previous;
+    block.previous = bits;
+
+    if(x == 0){
+        block.data.push_back(0x80);
+        return;
+    }
+
+    const int leading  = std::countl_zero(x) / 8;
+    const int trailing = std::countr_zero(x) / 8;
+    block.data.push_back(static_cast<std::uint8_t>((leading << 4) | trailing));
+    std::uint64_t meaningful = x >> (trailing*8);
+    for(int ii = 0; ii < 8 - leading - trailing; ++ii){
+        block.data.push_back(static_cast<std::uint8_t>(meaningful & 0xFF));
+        meaningful >>= 8;
+    }
+}
+
+auto ColumnarLogWriter::add_text(ColumnBlock &block, std::string_view text) -> void{
+
+    m_conversion.assign(text);
+    auto it = block.ids.find(m_conversion);
+    if(it == block.ids.end()){
+        it = block.ids.emplace(m_conversion, static_cast<std::uint32_t>(block.dictionary.size())).first;
+        block.dictionary.push_back(m_conversion);
+    }
+    put_varint(block.data, it->second);
+}
+
+auto ColumnarLogWriter::write_chunk() -> void{
+
+    if(m_rows == 0){
+        return;
+    }
+
+    m_buffer.clear();
+    put(m_buffer, chunkMagic);
+    put(m_buffer, m_rows);
+    put(m_buffer, m_timeMin);
+    put(m_buffer, m_timeMax);
+
+    // text blocks start with the dictionary entries added during this chunk
+    std::vector<std::uint8_t> entries;
+    std::vector<std::uint8_t> blocks;
+    for(size_t ii = 0; ii < m_columns.size(); ++ii){
+        auto &block = m_blocks[ii];
+        size_t size = block.data.size();
+        if(m_columns[ii].type == ColumnarLogType::Text){
+            entries.clear();
+            put(entries, static_cast<std::uint32_t>(block.dictionary.size() - block.firstNewEntry));
+            for(size_t jj = block.firstNewEntry; jj < block.dictionary.size(); ++jj){
+                put(entries, std::string_view(block.dictionary[jj]));
+            }
+            blocks.insert(blocks.end(), entries.begin(), entries.end());
+            size += entries.size();
+            block.firstNewEntry = block.dictionary.size();
+        }
+        blocks.insert(blocks.end(), block.data.begin(), block.data.end());
+        put(m_buffer, static_cast<std::uint32_t>(size));
+
+        block.data.clear();
+        block.previous = 0;
+    }
+
+    m_chunks.push_back({m_offset, m_rows, m_timeMin, m_timeMax});
+    write(m_buffer.data(), m_buffer.size());
+    write(blocks.data(), blocks.size());
+
+    m_rows    = 0;
+    m_timeMin = std::numeric_limits<double>::quiet_NaN();
+    m_timeMax = std::numeric_limits<double>::quiet_NaN();
+}
+
+auto ColumnarLogWriter::write(const void *data, size_t size) -> void{
+    const auto written = std::fwrite(data, 1, size, m_file);
+    m_offset       += written;
+    m_bytesWritten += written;
+}
+
+auto ColumnarLogReader::open(const std::string &path) -> bool{
+
+    m_columns.clear();
+    m_chunks.clear();
+    m_dictionaries.clear();
+    m_recovered = false;
+
+    m_file.close();
+    m_file.open(path, std::ios::binary);
+    if(!m_file.is_open()){
+        return false;
+    }
+
+    std::error_code error;
+    const std::uint64_t fileSize = std::filesystem::file_size(path, error);
+    if(error){
+        return false;
+    }
+
+    // header
+    if(!read_bytes(m_file, 0, std::min<std::uint64_t>(fileSize, 64*1024), m_block)){
+        return false;
+    }
+    BlockReader header{m_block.data(), m_block.size()};
+    std::uint32_t magic = 0, fileVersion = 0, columnsCount = 0;
+    if(!header.get(magic) || magic != headerMagic || !header.get(fileVersion) || fileVersion != version || !header.get(columnsCount)){
+        return false;
+    }
+    m_columns.resize(columnsCount);
+    for(auto &column : m_columns){
+        if(!header.get(column.type) || !header.get(column.name)){
+            return false;
+        }
+    }
+    std::int32_t timeColumn = -1;
+    if(!header.get(timeColumn)){
+        return false;
+    }
+    m_timeColumn = timeColumn;
+    m_dictionaries.resize(m_columns.size());
+    const std::uint64_t firstChunk = header.position;
+
+    // footer
+    std::uint64_t footerOffset = 0;
+    if(fileSize >= firstChunk + trailerSize && read_bytes(m_file, fileSize - trailerSize, trailerSize, m_block)){
+        BlockReader trailer{m_block.data(), m_block.size()};
+        trailer.get(footerOffset);
+        trailer.get(magic);
+        if(magic != footerMagic || footerOffset < firstChunk || footerOffset > fileSize - trailerSize){
+            footerOffset = 0;
+        }
+    }
+
+    if(footerOffset != 0 && read_bytes(m_file, footerOffset, fileSize - trailerSize - footerOffset, m_block)){
+
+        BlockReader footer{m_block.data(), m_block.size()};
+        std::uint32_t chunksCount = 0;
+        bool valid = footer.get(magic) && magic == footerMagic && footer.get(chunksCount);
+        m_chunks.resize(valid ? chunksCount : 0);
+        for(auto &chunk : m_chunks){
+            valid = valid && footer.get(chunk.offset) && footer.get(chunk.rowsCount) && footer.get(chunk.timeMin) && footer.get(chunk.timeMax);
+        }
+        for(auto &dictionary : m_dictionaries){
+            std::uint32_t count = 0;
+            valid = valid && footer.get(count);
+            dictionary.resize(valid ? count : 0);
+            for(auto &text : dictionary){
+                valid = valid && footer.get(text);
+            }
+        }
+        if(valid){
+            return true;
+        }
+        m_chunks.clear();
+        for(auto &dictionary : m_dictionaries){
+            dictionary.clear();
+        }
+    }
+
+    // not closed properly, rebuild index from the complete chunks
+    m_recovered = true;
+    return scan_chunks(firstChunk, fileSize);
+}
+
+auto ColumnarLogReader::scan_chunks(std::uint64_t start, std::uint64_t end) -> bool{
+
+    const size_t headerSize = chunk_header_size(m_columns.size());
+    std::uint64_t position = start;
+    std::vector<std::uint8_t> chunkHeader;
+
+    while(position + headerSize <= end){
+
+        if(!read_bytes(m_file, position, headerSize, chunkHeader)){
+            break;
+        }
+        BlockReader reader{chunkHeader.data(), chunkHeader.size()};
+        std::uint32_t magic = 0;
+        ColumnarLogChunkInfo chunk;
+        chunk.offset = position;
+        reader.get(magic);
+        reader.get(chunk.rowsCount);
+        reader.get(chunk.timeMin);
+        reader.get(chunk.timeMax);
+        if(magic != chunkMagic){
+            break;
+        }
+
+        std::vector<std::uint32_t> sizes(m_columns.size());
+        std::uint64_t total = headerSize;
+        for(auto &size : sizes){
+            reader.get(size);
+            total += size;
+        }
+        if(position + total > end){
+            break;
+        }
+
+        // dictionary entries of the chunk
+        std::uint64_t blockOffset = position + headerSize;
+        for(size_t ii = 0; ii < m_columns.size(); ++ii){
+            if(m_columns[ii].type == ColumnarLogType::Text){
+                if(!read_bytes(m_file, blockOffset, sizes[ii], m_block)){
+                    return false;
+                }
+                BlockReader block{m_block.data(), m_block.size()};
+                std::uint32_t count = 0;
+                block.get(count);
+                for(std::uint32_t jj = 0; jj < count; ++jj){
+                    std::string text;
+                    if(!block.get(text)){
+                        return false;
+                    }
+                    m_dictionaries[ii].push_back(std::move(text));
+                }
+            }
+            blockOffset += sizes[ii];
+        }
+
+        m_chunks.push_back(chunk);
+        position += total;
+    }
+    return true;
+}
+
+auto ColumnarLogReader::read(const std::vector<size_t> &columnsId, std::vector<ColumnarLogColumnData> &data, double timeMin, double timeMax) -> bool{
+
+    data.resize(columnsId.size());
+    for(size_t ii = 0; ii < columnsId.size(); ++ii){
+        if(columnsId[ii] >= m_columns.size()){
+            return false;
+        }
+        data[ii].type = m_columns[columnsId[ii]].type;
+        data[ii].reals.clear();
+        data[ii].ids.clear();
+        data[ii].dictionary = &m_dictionaries[columnsId[ii]];
+    }
+
+    const size_t headerSize = chunk_header_size(m_columns.size());
+    std::vector<std::uint8_t> chunkHeader;
+    std::vector<std::uint64_t> offsets(m_columns.size());
+    std::vector<std::uint32_t> sizes(m_columns.size());
+
+    for(const auto &chunk : m_chunks){
+
+        if(m_timeColumn >= 0 && !std::isnan(chunk.timeMin) && (chunk.timeMax < timeMin || chunk.timeMin > timeMax)){
+            continue;
+        }
+
+        if(!read_bytes(m_file, chunk.offset, headerSize, chunkHeader)){
+            return false;
+        }
+        BlockReader reader{chunkHeader.data(), chunkHeader.size()};
+        reader.position = headerSize - m_columns.size()*sizeof(std::uint32_t);
+        std::uint64_t offset = chunk.offset + headerSize;
+        for(size_t ii = 0; ii < m_columns.size(); ++ii){
+            reader.get(sizes[ii]);
+            offsets[ii] = offset;
+            offset += sizes[ii];
+        }
+
+        for(size_t ii = 0; ii < columnsId.size(); ++ii){
+
+            const auto idC = columnsId[ii];
+            if(!read_bytes(m_file, offsets[idC], sizes[idC], m_block)){
+                return false;
+            }
+            BlockReader block{m_block.data(), m_block.size()};
+
+            if(m_columns[idC].type == ColumnarLogType::Real){
+
+                auto &reals = data[ii].reals;
+                std::uint64_t previous = 0;
+                for(std::uint32_t jj = 0; jj < chunk.rowsCount; ++jj){
+                    std::uint8_t control = 0;
+                    if(!block.get(control)){
+                        return false;
+                    }
+                    std::uint64_t x = 0;
+                    const int leading  = control >> 4;
+                    const int trailing = control & 0xF;
+                    if(leading < 8){
+                        const int count = 8 - leading - trailing;
+                        if(count < 0 || block.position + count > block.size){
+                            return false;
+                        }
+                        for(int kk = count - 1; kk >= 0; --kk){
+                            x = (x << 8) | block.data[block.position + kk];
+                        }
+                        block.position += count;
+                        x <<= trailing*8;
+                    }
+                    previous ^= x;
+                    double value;
+                    std::memcpy(&value, &previous, sizeof(double));
+                    reals.push_back(value);
+                }
+
+            }else{
+
+                std::uint32_t count = 0;
+                if(!block.get(count)){
+                    return false;
+                }
+                for(std::uint32_t jj = 0; jj < count; ++jj){
+                    if(!block.skip_text()){
+                        return false;
+                    }
+                }
+                auto &ids = data[ii].ids;
+                for(std::uint32_t jj = 0; jj < chunk.rowsCount; ++jj){
+                    std::uint32_t id = 0;
+                    if(!block.get_varint(id) || id >= data[ii].dictionary->size()){
+                        return false;
+                    }
+                    ids.push_back(id);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+auto ColumnarLogReader::write_csv(const std::string &path, std::string_view separator) -> bool{
+
+    std::vector<size_t> columnsId(m_columns.size());
+    for(size_t ii = 0; ii < columnsId.size(); ++ii){
+        columnsId[ii] = ii;
+    }
+    std::vector<ColumnarLogColumnData> data;
+    if(!read(columnsId, data)){
+        return false;
+    }
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if(file == nullptr){
+        return false;
+    }
+
+    std::string output;
+    for(size_t ii = 0; ii < m_columns.size(); ++ii){
+        if(ii != 0){
+            output += separator;
+        }
+        output += m_columns[ii].name;
+    }
+    output += '\n';
+
+    const size_t rowsCount = rows_count();
+    char digits[32];
+    for(size_t idR = 0; idR < rowsCount; ++idR){
+        for(size_t idC = 0; idC < data.size(); ++idC){
+            if(idC != 0){
+                output += separator;
+            }
+            if(data[idC].type == ColumnarLogType::Real){
+                if(const double value = data[idC].reals[idR]; !std::isnan(value)){
+                    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                    output.append(digits, result.ptr);
+                }
+            }else{
+                output += (*data[idC].dictionary)[data[idC].ids[idR]];
+            }
+        }
+        output += '\n';
+
+        if(output.size() > 4*1024*1024){
+            std::fwrite(output.data(), 1, output.size(), file);
+            output.clear();
+        }
+    }
+    std::fwrite(output.data(), 1, output.size(), file);
+    return std::fclose(file) == 0;
+}
+
+auto ColumnarLogReader::column_id(std::string_view name) const -> int{
+    for(size_t ii = 0; ii < m_columns.size(); ++ii){
+        if(m_columns[ii].name == name){
+            return static_cast<int>(ii);
+        }
+    }
+    return -1;
+}
+
+auto ColumnarLogReader::rows_count() const noexcept -> size_t{
+    size_t count = 0;
+    for(const auto &chunk : m_chunks){
+        count += chunk.rowsCount;
+    }
+    return count;
+}
@@ -0,0 +1,154 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tool::ex {
+
+// typed columnar log file (.exlog)
+//  header: magic, version, columns (type + name), time column
+//  chunks: rows count, time range, size of each column block, then the column blocks
+//      reals: xor with previous value, leading and trailing zero bytes trimmed
+//      texts: dictionary encoded, new dictionary entries first then varint ids
+//  footer: chunks index (offset, rows count, time range) and complete dictionaries
+// chunks can be decoded without the footer, a file with a missing footer is rebuilt by scanning them
+
+enum class ColumnarLogType : std::uint8_t{
+    Real = 0, Text
+};
+
+struct ColumnarLogValue{
+    enum class Type : std::uint8_t{
+        Empty = 0, Real, Text
+    };
+    Type type = Type::Empty;
+    double real = 0.;
+    std::string_view text;
+};
+
+struct ColumnarLogColumn{
+    std::string name;
+    ColumnarLogType type;
+};
+
+struct ColumnarLogChunkInfo{
+    std::uint64_t offset = 0;
+    std::uint32_t rowsCount = 0;
+    double timeMin = std::numeric_limits<double>::quiet_NaN();
+    double timeMax = std::numeric_limits<double>::quiet_NaN();
+};
+
+class ColumnarLogWriter{
+public:
+
+    static constexpr std::uint32_t rowsPerChunk = 8192;
+
+    ~ColumnarLogWriter();
+
+    auto open(const std::string &path, std::vector<ColumnarLogColumn> columns, int timeColumn) -> bool;
+    auto add_row(const std::vector<ColumnarLogValue> &values) -> void;
+    auto close() -> void;
+
+    auto flush() -> void;
+    auto sync() -> void;
+
+    auto is_opened() const noexcept -> bool{return m_file != nullptr;}
+    auto bytes_written() const noexcept -> size_t{return m_bytesWritten;}
+    auto columns_count() const noexcept -> size_t{return m_columns.size();}
+
+private:
+
+    struct ColumnBlock{
+        std::vector<std::uint8_t> data;
+        std::uint64_t previous = 0;
+        std::unordered_map<std::string, std::uint32_t> ids;
+        std::vector<std::string> dictionary;
+        size_t firstNewEntry = 0;
+    };
+
+    auto add_real(ColumnBlock &block, double value) -> void;
+    auto add_text(ColumnBlock &block, std::string_view text) -> void;
+    auto write_chunk() -> void;
+    auto write(const void *data, size_t size) -> void;
+
+    std::FILE *m_file = nullptr;
+    std::vector<ColumnarLogColumn> m_columns;
+    std::vector<ColumnBlock> m_blocks;
+    std::vector<ColumnarLogChunkInfo> m_chunks;
+    std::vector<std::uint8_t> m_buffer;
+    std::string m_conversion;
+    int m_timeColumn = -1;
+    std::uint32_t m_rows = 0;
+    double m_timeMin = 0.;
+    double m_timeMax = 0.;
+    std::uint64_t m_offset = 0;
+    size_t m_bytesWritten = 0;
+};
+
+struct ColumnarLogColumnData{
+    ColumnarLogType type;
+    std::vector<double> reals;
+    std::vector<std::uint32_t> ids;                     /**< indices in the dictionary */
+    const std::vector<std::string> *dictionary = nullptr;
+};
+
+class ColumnarLogReader{
+public:
+
+    auto open(const std::string &path) -> bool;
+
+    // read the given columns of the chunks overlapping [timeMin, timeMax]
+    auto read(const std::vector<size_t> &columnsId, std::vector<ColumnarLogColumnData> &data,
+        double timeMin = -std::numeric_limits<double>::infinity(),
+        double timeMax =  std::numeric_limits<double>::infinity()) -> bool;
+    auto write_csv(const std::string &path, std::string_view separator) -> bool;
+
+    auto column_id(std::string_view name) const -> int;
+    auto columns() const noexcept -> const std::vector<ColumnarLogColumn>& {return m_columns;}
+    auto chunks() const noexcept -> const std::vector<ColumnarLogChunkInfo>& {return m_chunks;}
+    auto rows_count() const noexcept -> size_t;
+    auto time_column() const noexcept -> int{return m_timeColumn;}
+    auto recovered() const noexcept -> bool{return m_recovered;}
+
+private:
+
+    auto scan_chunks(std::uint64_t start, std::uint64_t end) -> bool;
+
+    std::ifstream m_file;
+    std::vector<ColumnarLogColumn> m_columns;
+    std::vector<ColumnarLogChunkInfo> m_chunks;
+    std::vector<std::vector<std::string>> m_dictionaries;
+    std::vector<std::uint8_t> m_block;
+    int m_timeColumn = -1;
+    bool m_recovered = false;
+};
+}
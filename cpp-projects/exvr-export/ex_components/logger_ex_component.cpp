@@ -0,0 +1,625 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "logger_ex_component.hpp"
+
+// std
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// local
+#include "logger_columnar_file.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace {
+
+enum class CellType : std::uint8_t{
+    Empty = 0, Real, Text
+};
+
+// single producer (the logging thread) / single consumer (the writer thread) ring of encoded rows
+struct RowsBuffer{
+
+    RowsBuffer(size_t capacity) : data(std::bit_ceil(capacity)), mask(data.size()-1){}
+
+    auto available() const noexcept -> size_t{
+        return data.size() - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+    }
+
+    auto write(size_t position, const void *src, size_t size) noexcept -> void{
+        const size_t start = position & mask;
+        const size_t first = std::min(size, data.size() - start);
+        std::memcpy(data.data() + start, src, first);
+        std::memcpy(data.data(), static_cast<const std::byte*>(src) + first, size - first);
+    }
+
+    auto read(size_t position, size_t size, std::vector<std::byte> &dst) const -> void{
+        const size_t start = position & mask;
+        const size_t first = std::min(size, data.size() - start);
+        dst.resize(size);
+        std::memcpy(dst.data(), data.data() + start, first);
+        std::memcpy(dst.data() + first, data.data(), size - first);
+    }
+
+    std::vector<std::byte> data;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head = 0; /**< moved by the producer */
+    alignas(64) std::atomic<size_t> tail = 0; /**< moved by the writer */
+};
+
+// row record: [size u32][cells count u32] then for each cell: [type u8] + [f64] or [length u32][chars]
+struct RecordEncoder{
+
+    static constexpr size_t headerSize = 2*sizeof(std::uint32_t);
+
+    static constexpr auto cell_size(double) noexcept -> size_t{
+        return 1 + sizeof(double);
+    }
+    static constexpr auto cell_size(std::string_view text) noexcept -> size_t{
+        return 1 + sizeof(std::uint32_t) + text.size();
+    }
+
+    template<typename T>
+    auto put(const T &value) noexcept -> void{
+        buffer->write(position, &value, sizeof(T));
+        position += sizeof(T);
+    }
+
+    auto put_cell(double value) noexcept -> void{
+        put(CellType::Real);
+        put(value);
+    }
+
+    auto put_cell(std::string_view text) noexcept -> void{
+        put(CellType::Text);
+        put(static_cast<std::uint32_t>(text.size()));
+        buffer->write(position, text.data(), text.size());
+        position += text.size();
+    }
+
+    RowsBuffer *buffer = nullptr;
+    size_t position = 0;
+};
+
+template<typename T>
+auto read_value(const std::byte *data) noexcept -> T{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// buffers of the current thread for each logger, loggers ids are never reused
+thread_local std::vector<std::pair<size_t, RowsBuffer*>> threadBuffers;
+std::atomic<size_t> loggersCounter = 0;
+
+constexpr size_t writeChunkSize = 4 * 1024 * 1024;
+}
+
+struct LoggerExComponent::Impl{
+
+    size_t id = ++loggersCounter;
+
+    // settings
+    std::string separator = ";";
+    bool writeEachFrame = true;
+    std::chrono::milliseconds flushInterval{100};
+    SyncPolicy syncPolicy = SyncPolicy::Never;
+    size_t bufferSize = 8 * 1024 * 1024;
+    bool columnarFormat = false;
+
+    // producers
+    std::mutex buffersL;
+    std::vector<std::unique_ptr<RowsBuffer>> buffers;
+
+    // current frame row
+    struct Column{
+        CellType type = CellType::Empty;
+        double real = 0.;
+        std::string text;
+    };
+    std::vector<Column> columns;
+
+    // writer
+    std::FILE *file = nullptr;
+    std::string path;
+    std::string headerLine;
+    ColumnarLogWriter columnar;
+    std::vector<ColumnarLogValue> values;
+    std::atomic_bool columnarError = false;
+    std::thread writer;
+    std::mutex writerL;
+    std::condition_variable writerC;
+    bool stopWriter = false;
+    bool flushRequested = false;
+    std::vector<RowsBuffer*> drained;
+    std::vector<std::byte> records;
+    std::string output;
+
+    std::atomic<size_t> rowsWritten = 0;
+    std::atomic<size_t> rowsDropped = 0;
+    std::atomic<size_t> cellsDropped = 0;
+    std::atomic<size_t> bytesWritten = 0;
+
+    auto thread_buffer() -> RowsBuffer*{
+
+        for(const auto &[loggerId, buffer] : threadBuffers){
+            if(loggerId == id){
+                return buffer;
+            }
+        }
+
+        // first row logged from this thread
+        std::lock_guard<std::mutex> lock(buffersL);
+        buffers.push_back(std::make_unique<RowsBuffer>(bufferSize));
+        threadBuffers.emplace_back(id, buffers.back().get());
+        return buffers.back().get();
+    }
+
+    template<typename EncodeCells>
+    auto push(size_t cellsCount, size_t cellsSize, EncodeCells &&encode_cells) -> bool{
+
+        auto buffer = thread_buffer();
+        const size_t size = RecordEncoder::headerSize + cellsSize;
+        if(size > buffer->available()){
+            ++rowsDropped;
+            return false;
+        }
+
+        RecordEncoder encoder{buffer, buffer->head.load(std::memory_order_relaxed)};
+        encoder.put(static_cast<std::uint32_t>(size));
+        encoder.put(static_cast<std::uint32_t>(cellsCount));
+        encode_cells(encoder);
+        buffer->head.store(encoder.position, std::memory_order_release);
+        return true;
+    }
+
+    auto format_records() -> void{
+
+        if(columnarFormat){
+            decode_records();
+            return;
+        }
+
+        const std::byte *data = records.data();
+        size_t position = 0;
+        while(position < records.size()){
+
+            const auto recordSize = read_value<std::uint32_t>(data + position);
+            const auto cellsCount = read_value<std::uint32_t>(data + position + sizeof(std::uint32_t));
+            size_t cellPosition   = position + RecordEncoder::headerSize;
+
+            for(std::uint32_t ii = 0; ii < cellsCount; ++ii){
+
+                if(ii != 0){
+                    output += separator;
+                }
+
+                const auto type = read_value<CellType>(data + cellPosition++);
+                if(type == CellType::Real){
+                    char digits[32];
+                    const auto result = std::to_chars(digits, digits + sizeof(digits), read_value<double>(data + cellPosition));
+                    output.append(digits, result.ptr);
+                    cellPosition += sizeof(double);
+                }else if(type == CellType::Text){
+                    const auto length = read_value<std::uint32_t>(data + cellPosition);
+                    cellPosition += sizeof(std::uint32_t);
+                    output.append(reinterpret_cast<const char*>(data + cellPosition), length);
+                    cellPosition += length;
+                }
+            }
+            output += '\n';
+
+            position += recordSize;
+            ++rowsWritten;
+
+            if(output.size() >= writeChunkSize){
+                write_output();
+            }
+        }
+    }
+
+    // rows sent to the columnar writer, the schema is defined by the first row and the header line
+    auto decode_records() -> void{
+
+        const std::byte *data = records.data();
+        size_t position = 0;
+        while(position < records.size()){
+
+            const auto recordSize = read_value<std::uint32_t>(data + position);
+            const auto cellsCount = read_value<std::uint32_t>(data + position + sizeof(std::uint32_t));
+            size_t cellPosition   = position + RecordEncoder::headerSize;
+
+            values.resize(cellsCount);
+            for(auto &value : values){
+                const auto type = read_value<CellType>(data + cellPosition++);
+                if(type == CellType::Real){
+                    value = {ColumnarLogValue::Type::Real, read_value<double>(data + cellPosition), {}};
+                    cellPosition += sizeof(double);
+                }else if(type == CellType::Text){
+                    const auto length = read_value<std::uint32_t>(data + cellPosition);
+                    cellPosition += sizeof(std::uint32_t);
+                    value = {ColumnarLogValue::Type::Text, 0., std::string_view(reinterpret_cast<const char*>(data + cellPosition), length)};
+                    cellPosition += length;
+                }else{
+                    value = {};
+                }
+            }
+            position += recordSize;
+
+            if(!columnar.is_opened() && !columnarError){
+                open_columnar();
+            }
+            if(columnar.is_opened()){
+                // cells after the schema columns are not written
+                if(values.size() > columnar.columns_count()){
+                    cellsDropped += values.size() - columnar.columns_count();
+                }
+                columnar.add_row(values);
+                ++rowsWritten;
+            }else{
+                ++rowsDropped;
+            }
+        }
+    }
+
+    // text cells of the first row holding a number define real columns, add_row converts the next text cells the same way
+    static auto is_real(const ColumnarLogValue &value) noexcept -> bool{
+        if(value.type != ColumnarLogValue::Type::Text){
+            return true;
+        }
+        double real;
+        const auto end    = value.text.data() + value.text.size();
+        const auto result = std::from_chars(value.text.data(), end, real);
+        return !value.text.empty() && result.ec == std::errc{} && result.ptr == end;
+    }
+
+    auto open_columnar() -> void{
+
+        std::vector<std::string_view> names;
+        size_t start = 0;
+        while(!headerLine.empty() && !separator.empty()){
+            const auto end = headerLine.find(separator, start);
+            names.push_back(std::string_view(headerLine).substr(start, end == std::string::npos ? std::string::npos : end - start));
+            if(end == std::string::npos){
+                break;
+            }
+            start = end + separator.size();
+        }
+
+        std::vector<ColumnarLogColumn> columns(values.size());
+        int timeColumn = -1;
+        for(size_t ii = 0; ii < columns.size(); ++ii){
+            columns[ii].name = ii < names.size() ? std::string(names[ii]) : std::format("column_{}", ii);
+            columns[ii].type = is_real(values[ii]) ? ColumnarLogType::Real : ColumnarLogType::Text;
+            if(columns[ii].type == ColumnarLogType::Real && (timeColumn == -1 || columns[ii].name == "time_exp")){
+                timeColumn = static_cast<int>(ii);
+            }
+        }
+        columnarError = !columnar.open(path, std::move(columns), timeColumn);
+    }
+
+    auto drain() -> void{
+
+        drained.clear();
+        buffersL.lock();
+        for(const auto &buffer : buffers){
+            drained.push_back(buffer.get());
+        }
+        buffersL.unlock();
+
+        for(auto buffer : drained){
+            const size_t head = buffer->head.load(std::memory_order_acquire);
+            const size_t tail = buffer->tail.load(std::memory_order_relaxed);
+            if(head == tail){
+                continue;
+            }
+            // release the space before formatting
+            buffer->read(tail, head - tail, records);
+            buffer->tail.store(head, std::memory_order_release);
+            format_records();
+        }
+    }
+
+    auto write_output() -> void{
+        if(!output.empty() && file != nullptr){
+            bytesWritten += std::fwrite(output.data(), 1, output.size(), file);
+        }
+        output.clear();
+    }
+
+    auto flush_file() -> void{
+        if(columnarFormat){
+            columnar.flush();
+            bytesWritten = columnar.bytes_written();
+        }else if(file != nullptr){
+            std::fflush(file);
+        }
+    }
+
+    auto sync_file() -> void{
+        if(columnarFormat){
+            columnar.sync();
+            return;
+        }
+        std::fflush(file);
+#if defined(_WIN32)
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+    }
+
+    auto writer_loop() -> void{
+
+        std::unique_lock<std::mutex> lock(writerL);
+        while(!stopWriter){
+
+            writerC.wait_for(lock, flushInterval, [&]{return stopWriter || flushRequested;});
+            flushRequested = false;
+            lock.unlock();
+
+            drain();
+            write_output();
+            flush_file();
+            if(syncPolicy == SyncPolicy::EachFlush){
+                sync_file();
+            }
+
+            lock.lock();
+        }
+    }
+
+    auto stop_writer() -> void{
+
+        if(!writer.joinable()){
+            return;
+        }
+
+        writerL.lock();
+        stopWriter = true;
+        writerL.unlock();
+        writerC.notify_one();
+        writer.join();
+
+        // remaining rows
+        drain();
+        write_output();
+        if(syncPolicy != SyncPolicy::Never){
+            sync_file();
+        }
+        if(columnarFormat){
+            columnar.close();
+            bytesWritten = columnar.bytes_written();
+        }else{
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+};
+
+LoggerExComponent::LoggerExComponent() : i(std::make_unique<Impl>()){
+}
+
+LoggerExComponent::~LoggerExComponent(){
+    i->stop_writer();
+}
+
+auto LoggerExComponent::initialize() -> bool{
+
+    i->separator      = get<std::string>(ParametersContainer::InitConfig, "separator");
+    i->writeEachFrame = get<int>(ParametersContainer::InitConfig, "write_each_frame") == 1;
+    i->flushInterval  = std::chrono::milliseconds(std::max(get<int>(ParametersContainer::InitConfig, "flush_interval_ms"), 1));
+    i->syncPolicy     = static_cast<SyncPolicy>(get<int>(ParametersContainer::InitConfig, "sync_policy"));
+    i->columnarFormat = get<int>(ParametersContainer::InitConfig, "columnar_format") == 1;
+    return true;
+}
+
+auto LoggerExComponent::clean() -> void{
+    i->stop_writer();
+}
+
+auto LoggerExComponent::start_experiment() -> void{
+
+    namespace fs = std::filesystem;
+
+    i->stop_writer();
+
+    const auto path   = fs::path(get<std::string>(ParametersContainer::Dynamic, "path_file"));
+    const bool exists = fs::exists(path);
+    if(exists && get<int>(ParametersContainer::InitConfig, "dont_write_if_file_exists") == 1){
+        log_error(std::format("Log file [{}] already exists, nothing will be written.", path.string()));
+        return;
+    }
+
+    const bool append = exists && get<int>(ParametersContainer::InitConfig, "add_to_end_if_file_exists") == 1;
+    i->headerLine = get<int>(ParametersContainer::InitConfig, "add_header_line") == 1 ?
+        get<std::string>(ParametersContainer::InitConfig, "header_line") : std::string();
+
+    i->columns.clear();
+    if(!i->headerLine.empty() && !i->separator.empty()){
+        i->columns.resize(1);
+        for(size_t pos = i->headerLine.find(i->separator); pos != std::string::npos; pos = i->headerLine.find(i->separator, pos + i->separator.size())){
+            i->columns.emplace_back();
+        }
+        reset_columns();
+    }
+
+    if(i->columnarFormat){
+        // columnar file opened by the writer with the first row
+        if(append){
+            log_message(std::format("Columnar log file [{}] will be replaced.", path.string()));
+        }
+        i->path          = path.string();
+        i->columnarError = false;
+        i->stopWriter    = false;
+        i->writer        = std::thread(&Impl::writer_loop, i.get());
+        return;
+    }
+
+    if(i->file = std::fopen(path.string().c_str(), append ? "ab" : "wb"); i->file == nullptr){
+        log_error(std::format("Cannot open log file [{}].", path.string()));
+        return;
+    }
+    std::setvbuf(i->file, nullptr, _IOFBF, writeChunkSize);
+
+    if(!i->headerLine.empty() && (!append || fs::file_size(path) == 0)){
+        i->output = i->headerLine + '\n';
+        i->write_output();
+    }
+
+    i->stopWriter = false;
+    i->writer = std::thread(&Impl::writer_loop, i.get());
+}
+
+auto LoggerExComponent::stop_experiment() -> void{
+    i->stop_writer();
+    if(i->columnarError){
+        log_error(std::format("Cannot open columnar log file [{}].", i->path));
+    }
+}
+
+auto LoggerExComponent::post_update() -> void{
+    if(i->writeEachFrame){
+        push_columns();
+    }
+}
+
+auto LoggerExComponent::log_line(std::string_view line) -> bool{
+    return i->push(1, RecordEncoder::cell_size(line), [&](RecordEncoder &encoder){
+        encoder.put_cell(line);
+    });
+}
+
+auto LoggerExComponent::log_row(const double *values, size_t count) -> bool{
+    return i->push(count, count*RecordEncoder::cell_size(0.), [&](RecordEncoder &encoder){
+        for(size_t ii = 0; ii < count; ++ii){
+            encoder.put_cell(values[ii]);
+        }
+    });
+}
+
+auto LoggerExComponent::log_row(const char **values, size_t count) -> bool{
+
+    size_t size = 0;
+    for(size_t ii = 0; ii < count; ++ii){
+        size += RecordEncoder::cell_size(std::string_view(values[ii]));
+    }
+    return i->push(count, size, [&](RecordEncoder &encoder){
+        for(size_t ii = 0; ii < count; ++ii){
+            encoder.put_cell(std::string_view(values[ii]));
+        }
+    });
+}
+
+auto LoggerExComponent::set_column(size_t idColumn, double value) -> void{
+    if(idColumn >= i->columns.size()){
+        i->columns.resize(idColumn + 1);
+    }
+    i->columns[idColumn].type = CellType::Real;
+    i->columns[idColumn].real = value;
+}
+
+auto LoggerExComponent::set_column(size_t idColumn, std::string_view value) -> void{
+    if(idColumn >= i->columns.size()){
+        i->columns.resize(idColumn + 1);
+    }
+    i->columns[idColumn].type = CellType::Text;
+    i->columns[idColumn].text = value;
+}
+
+auto LoggerExComponent::reset_columns() -> void{
+    for(auto &column : i->columns){
+        column.type = CellType::Text;
+        column.text = "-";
+    }
+}
+
+auto LoggerExComponent::push_columns() -> bool{
+
+    if(i->columns.empty()){
+        return false;
+    }
+
+    size_t size = 0;
+    for(const auto &column : i->columns){
+        if(column.type == CellType::Real){
+            size += RecordEncoder::cell_size(column.real);
+        }else if(column.type == CellType::Text){
+            size += RecordEncoder::cell_size(column.text);
+        }else{
+            size += 1;
+        }
+    }
+
+    const bool pushed = i->push(i->columns.size(), size, [&](RecordEncoder &encoder){
+        for(const auto &column : i->columns){
+            if(column.type == CellType::Real){
+                encoder.put_cell(column.real);
+            }else if(column.type == CellType::Text){
+                encoder.put_cell(column.text);
+            }else{
+                encoder.put(CellType::Empty);
+            }
+        }
+    });
+    return pushed;
+}
+
+auto LoggerExComponent::flush() -> void{
+    i->writerL.lock();
+    i->flushRequested = true;
+    i->writerL.unlock();
+    i->writerC.notify_one();
+}
+
+auto LoggerExComponent::rows_written() const noexcept -> size_t{
+    return i->rowsWritten.load();
+}
+
+auto LoggerExComponent::rows_dropped() const noexcept -> size_t{
+    return i->rowsDropped.load();
+}
+
+auto LoggerExComponent::cells_dropped() const noexcept -> size_t{
+    return i->cellsDropped.load();
+}
+
+auto LoggerExComponent::bytes_written() const noexcept -> size_t{
+    return i->bytesWritten.load();
+}
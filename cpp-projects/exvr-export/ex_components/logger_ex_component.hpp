@@ -0,0 +1,81 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <memory>
+#include <string_view>
+
+// base
+#include "exvr/ex_component.hpp"
+
+namespace tool::ex {
+
+// with "columnar_format", rows are written in a typed columnar file (see logger_columnar_file.hpp),
+// columns names come from the header line and columns types from the first row (text holding a number is real),
+// cells beyond these columns are counted in cells_dropped
+class LoggerExComponent : public ExComponent{
+
+public:
+
+    enum class SyncPolicy : int{
+        Never = 0,      /**< only let the system write its cache */
+        EachFlush,      /**< sync the file after each writer cycle */
+        AtStop          /**< sync the file once when the experiment stops */
+    };
+
+    LoggerExComponent();
+    ~LoggerExComponent() override;
+
+    auto initialize() -> bool override;
+    auto clean() -> void override;
+    auto start_experiment() -> void override;
+    auto stop_experiment() -> void override;
+    auto post_update() -> void override;
+
+    // thread safe and never blocking, each calling thread copies its rows in its own buffer
+    // returns false if the row has been dropped because the buffer was full
+    auto log_line(std::string_view line) -> bool;
+    auto log_row(const double *values, size_t count) -> bool;
+    auto log_row(const char **values, size_t count) -> bool;
+
+    // columns of the current row, values are kept between rows, the row is pushed at post update if "write_each_frame" is enabled
+    // with a header line, the columns are initialized with "-" for each header cell when the experiment starts
+    auto set_column(size_t idColumn, double value) -> void;
+    auto set_column(size_t idColumn, std::string_view value) -> void;
+    auto reset_columns() -> void;
+    auto push_columns() -> bool;
+
+    auto flush() -> void;
+
+    auto rows_written() const noexcept -> size_t;
+    auto rows_dropped() const noexcept -> size_t;
+    auto cells_dropped() const noexcept -> size_t; /**< columnar format: cells beyond the columns of the first row */
+    auto bytes_written() const noexcept -> size_t;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
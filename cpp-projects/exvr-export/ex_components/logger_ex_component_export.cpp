@@ -0,0 +1,74 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "logger_ex_component_export.hpp"
+
+using namespace tool::ex;
+
+LoggerExComponent *create_logger_ex_component(){
+    return new LoggerExComponent();
+}
+
+int log_line_logger_ex_component(LoggerExComponent *lC, const char *line){
+    return lC->log_line(line) ? 1 : 0;
+}
+
+int log_row_doubles_logger_ex_component(LoggerExComponent *lC, const double *values, int count){
+    return lC->log_row(values, static_cast<size_t>(count)) ? 1 : 0;
+}
+
+int log_row_strings_logger_ex_component(LoggerExComponent *lC, const char **values, int count){
+    return lC->log_row(values, static_cast<size_t>(count)) ? 1 : 0;
+}
+
+void set_column_double_logger_ex_component(LoggerExComponent *lC, int idColumn, double value){
+    lC->set_column(static_cast<size_t>(idColumn), value);
+}
+
+void set_column_string_logger_ex_component(LoggerExComponent *lC, int idColumn, const char *value){
+    lC->set_column(static_cast<size_t>(idColumn), std::string_view(value));
+}
+
+void reset_columns_logger_ex_component(LoggerExComponent *lC){
+    lC->reset_columns();
+}
+
+int push_columns_logger_ex_component(LoggerExComponent *lC){
+    return lC->push_columns() ? 1 : 0;
+}
+
+void flush_logger_ex_component(LoggerExComponent *lC){
+    lC->flush();
+}
+
+long long get_rows_written_logger_ex_component(LoggerExComponent *lC){
+    return static_cast<long long>(lC->rows_written());
+}
+
+long long get_rows_dropped_logger_ex_component(LoggerExComponent *lC){
+    return static_cast<long long>(lC->rows_dropped());
+}
+
+long long get_cells_dropped_logger_ex_component(LoggerExComponent *lC){
+    return static_cast<long long>(lC->cells_dropped());
+}
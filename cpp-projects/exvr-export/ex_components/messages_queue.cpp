@@ -0,0 +1,99 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "messages_queue.hpp"
+
+// std
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+using namespace tool::ex;
+
+namespace {
+constexpr size_t recordHeaderSize = sizeof(std::uint32_t) + sizeof(double);
+}
+
+auto TimestampedMessagesQueue::reset(size_t capacityBytes) -> void{
+    m_data.assign(std::bit_ceil(capacityBytes), std::byte{0});
+    m_mask = m_data.size()-1;
+    m_head = 0;
+    m_tail = 0;
+}
+
+auto TimestampedMessagesQueue::push(const std::byte *message, size_t size, double timeMs) noexcept -> bool{
+
+    const size_t total = recordHeaderSize + size;
+    const size_t head  = m_head.load(std::memory_order_relaxed);
+    if(m_data.size() - (head - m_tail.load(std::memory_order_acquire)) < total){
+        return false;
+    }
+
+    const auto size32 = static_cast<std::uint32_t>(size);
+    write(head, &size32, sizeof(size32));
+    write(head + sizeof(size32), &timeMs, sizeof(timeMs));
+    write(head + recordHeaderSize, message, size);
+    m_head.store(head + total, std::memory_order_release);
+    return true;
+}
+
+auto TimestampedMessagesQueue::drain(TimestampedMessages &messages) -> size_t{
+
+    const size_t head = m_head.load(std::memory_order_acquire);
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    size_t count = 0;
+    while(tail != head){
+
+        std::uint32_t size;
+        double timeMs;
+        read(tail, &size, sizeof(size));
+        read(tail + sizeof(size), &timeMs, sizeof(timeMs));
+
+        const size_t offset = messages.data.size();
+        messages.data.resize(offset + size);
+        read(tail + recordHeaderSize, messages.data.data() + offset, size);
+        messages.offsets.push_back(messages.data.size());
+        messages.timesMs.push_back(timeMs);
+
+        tail += recordHeaderSize + size;
+        ++count;
+    }
+    m_tail.store(tail, std::memory_order_release);
+
+    return count;
+}
+
+auto TimestampedMessagesQueue::write(size_t position, const void *src, size_t size) noexcept -> void{
+    const size_t start = position & m_mask;
+    const size_t first = std::min(size, m_data.size() - start);
+    std::memcpy(m_data.data() + start, src, first);
+    std::memcpy(m_data.data(), static_cast<const std::byte*>(src) + first, size - first);
+}
+
+auto TimestampedMessagesQueue::read(size_t position, void *dst, size_t size) const noexcept -> void{
+    const size_t start = position & m_mask;
+    const size_t first = std::min(size, m_data.size() - start);
+    std::memcpy(dst, m_data.data() + start, first);
+    std::memcpy(static_cast<std::byte*>(dst) + first, m_data.data(), size - first);
+}
@@ -0,0 +1,79 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tool::ex {
+
+// timestamped messages stored contiguously
+struct TimestampedMessages{
+
+    std::vector<std::byte> data;
+    std::vector<size_t> offsets = {0};  /**< count + 1 offsets */
+    std::vector<double> timesMs;        /**< experiment time of each message */
+
+    auto count() const noexcept -> size_t{return timesMs.size();}
+    auto message_data(size_t id) const noexcept -> const std::byte*{return data.data() + offsets[id];}
+    auto message_size(size_t id) const noexcept -> size_t{return offsets[id+1] - offsets[id];}
+
+    auto clear() noexcept -> void{
+        data.clear();
+        offsets.resize(1);
+        timesMs.clear();
+    }
+    auto add(const std::byte *message, size_t size, double timeMs) -> void{
+        data.insert(data.end(), message, message + size);
+        offsets.push_back(data.size());
+        timesMs.push_back(timeMs);
+    }
+};
+
+// single producer / single consumer byte ring of variable size messages: [size u32][time f64][bytes]
+class TimestampedMessagesQueue{
+
+public:
+
+    auto reset(size_t capacityBytes) -> void;
+
+    // returns false and drops the message if the queue is full
+    auto push(const std::byte *message, size_t size, double timeMs) noexcept -> bool;
+    // moves every available message at the end of messages, returns their count
+    auto drain(TimestampedMessages &messages) -> size_t;
+
+private:
+
+    auto write(size_t position, const void *src, size_t size) noexcept -> void;
+    auto read(size_t position, void *dst, size_t size) const noexcept -> void;
+
+    std::vector<std::byte> m_data;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head = 0; /**< moved by the producer */
+    alignas(64) std::atomic<size_t> m_tail = 0; /**< moved by the consumer */
+};
+}
@@ -0,0 +1,378 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "serial_port.hpp"
+
+// std
+#include <array>
+#include <bit>
+#include <cstring>
+#include <format>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+using namespace tool::ex;
+
+namespace {
+
+constexpr auto field_size(char type) noexcept -> size_t{
+    switch(type){
+    case 'b': case 'B':
+        return 1;
+    case 'h': case 'H':
+        return 2;
+    case 'i': case 'I': case 'f':
+        return 4;
+    case 'q': case 'Q': case 'd':
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+template<typename T>
+auto read_field(const std::byte *data, bool swap) noexcept -> double{
+    std::array<std::byte, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), data, sizeof(T));
+    if(swap){
+        std::reverse(bytes.begin(), bytes.end());
+    }
+    return static_cast<double>(std::bit_cast<T>(bytes));
+}
+
+auto unescape(std::string_view text) -> std::vector<std::byte>{
+
+    std::vector<std::byte> bytes;
+    for(size_t ii = 0; ii < text.size(); ++ii){
+
+        if(text[ii] != '\\' || ii + 1 == text.size()){
+            bytes.push_back(static_cast<std::byte>(text[ii]));
+            continue;
+        }
+
+        switch(text[++ii]){
+        case 'n':
+            bytes.push_back(std::byte{'\n'});
+            break;
+        case 'r':
+            bytes.push_back(std::byte{'\r'});
+            break;
+        case 't':
+            bytes.push_back(std::byte{'\t'});
+            break;
+        case '0':
+            bytes.push_back(std::byte{0});
+            break;
+        case 'x':
+            if(ii + 2 < text.size()){
+                bytes.push_back(static_cast<std::byte>(std::stoi(std::string(text.substr(ii+1, 2)), nullptr, 16)));
+                ii += 2;
+            }
+            break;
+        default:
+            bytes.push_back(static_cast<std::byte>(text[ii]));
+            break;
+        }
+    }
+    return bytes;
+}
+}
+
+auto SerialStructFormat::parse(std::string_view format) -> bool{
+
+    m_fields.clear();
+    m_size      = 0;
+    m_bigEndian = false;
+
+    size_t ii = 0;
+    if(!format.empty() && (format[0] == '<' || format[0] == '>')){
+        m_bigEndian = format[0] == '>';
+        ++ii;
+    }
+
+    size_t repeat = 0;
+    for(; ii < format.size(); ++ii){
+        const char c = format[ii];
+        if(c >= '0' && c <= '9'){
+            repeat = repeat*10 + static_cast<size_t>(c - '0');
+            continue;
+        }
+        if(c == ' '){
+            continue;
+        }
+        if(field_size(c) == 0){
+            m_fields.clear();
+            m_size = 0;
+            return false;
+        }
+        m_fields.insert(m_fields.end(), std::max<size_t>(repeat, 1), c);
+        m_size += std::max<size_t>(repeat, 1) * field_size(c);
+        repeat = 0;
+    }
+    return m_size > 0;
+}
+
+auto SerialStructFormat::decode(const std::byte *message, double *values) const noexcept -> void{
+
+    const bool swap = m_bigEndian != (std::endian::native == std::endian::big);
+    for(const auto type : m_fields){
+        switch(type){
+        case 'b':
+            *values = read_field<std::int8_t>(message, swap);
+            break;
+        case 'B':
+            *values = read_field<std::uint8_t>(message, swap);
+            break;
+        case 'h':
+            *values = read_field<std::int16_t>(message, swap);
+            break;
+        case 'H':
+            *values = read_field<std::uint16_t>(message, swap);
+            break;
+        case 'i':
+            *values = read_field<std::int32_t>(message, swap);
+            break;
+        case 'I':
+            *values = read_field<std::uint32_t>(message, swap);
+            break;
+        case 'q':
+            *values = read_field<std::int64_t>(message, swap);
+            break;
+        case 'Q':
+            *values = read_field<std::uint64_t>(message, swap);
+            break;
+        case 'f':
+            *values = read_field<float>(message, swap);
+            break;
+        case 'd':
+            *values = read_field<double>(message, swap);
+            break;
+        }
+        message += field_size(type);
+        ++values;
+    }
+}
+
+auto SerialMessagesFramer::reset(const SerialFramingSettings &settings) -> bool{
+
+    m_mode             = settings.mode;
+    m_maxMessageLength = settings.maxMessageLength;
+    m_pending.clear();
+    m_scanned        = 0;
+    m_discardedBytes = 0;
+
+    switch(m_mode){
+    case SerialFraming::Delimiter:
+        m_delimiter = unescape(settings.delimiter);
+        return !m_delimiter.empty();
+    case SerialFraming::FixedLength:
+        m_messageLength = settings.messageLength;
+        return m_messageLength > 0;
+    case SerialFraming::BinaryStruct:
+        if(!m_structFormat.parse(settings.structFormat)){
+            return false;
+        }
+        m_messageLength = m_structFormat.size();
+        return true;
+    }
+    return false;
+}
+
+struct SerialPort::Impl{
+
+#ifdef _WIN32
+    HANDLE handle = INVALID_HANDLE_VALUE;
+    auto opened() const noexcept -> bool{return handle != INVALID_HANDLE_VALUE;}
+    auto error_code() const noexcept -> int{return static_cast<int>(GetLastError());}
+#else
+    int handle = -1;
+    int readTimeoutMs = 5;
+    auto opened() const noexcept -> bool{return handle != -1;}
+    auto error_code() const noexcept -> int{return errno;}
+#endif
+    std::string lastError;
+
+    auto set_error(const std::string &context) -> void{
+        lastError = std::format("{} (error {})", context, error_code());
+    }
+};
+
+SerialPort::SerialPort() : i(std::make_unique<Impl>()){
+}
+
+SerialPort::~SerialPort(){
+    close();
+}
+
+auto SerialPort::open(const std::string &port, int baudRate, int readTimeoutMs) -> bool{
+
+    close();
+
+#ifdef _WIN32
+
+    i->handle = CreateFileA(std::format("\\\\.\\{}", port).c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+    if(!i->opened()){
+        i->set_error(std::format("Cannot open port [{}]", port));
+        return false;
+    }
+
+    DCB dcb{};
+    dcb.DCBlength = sizeof(DCB);
+    GetCommState(i->handle, &dcb);
+    dcb.BaudRate = static_cast<DWORD>(baudRate);
+    dcb.ByteSize = 8;
+    dcb.Parity   = NOPARITY;
+    dcb.StopBits = ONESTOPBIT;
+    dcb.fBinary  = TRUE;
+    if(!SetCommState(i->handle, &dcb)){
+        i->set_error(std::format("Cannot set baud rate {} on port [{}]", baudRate, port));
+        close();
+        return false;
+    }
+
+    // returns as soon as bytes are available or after the timeout
+    COMMTIMEOUTS timeouts{};
+    timeouts.ReadIntervalTimeout         = MAXDWORD;
+    timeouts.ReadTotalTimeoutMultiplier  = MAXDWORD;
+    timeouts.ReadTotalTimeoutConstant    = static_cast<DWORD>(readTimeoutMs);
+    SetCommTimeouts(i->handle, &timeouts);
+    PurgeComm(i->handle, PURGE_RXCLEAR);
+
+#else
+
+    speed_t speed;
+    switch(baudRate){
+    case 1200:    speed = B1200;    break;
+    case 2400:    speed = B2400;    break;
+    case 4800:    speed = B4800;    break;
+    case 9600:    speed = B9600;    break;
+    case 19200:   speed = B19200;   break;
+    case 38400:   speed = B38400;   break;
+    case 57600:   speed = B57600;   break;
+    case 115200:  speed = B115200;  break;
+    case 230400:  speed = B230400;  break;
+#ifdef B460800
+    case 460800:  speed = B460800;  break;
+    case 921600:  speed = B921600;  break;
+    case 1000000: speed = B1000000; break;
+    case 2000000: speed = B2000000; break;
+#endif
+    default:
+        i->lastError = std::format("Unsupported baud rate {}.", baudRate);
+        return false;
+    }
+
+    i->handle = ::open(port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if(!i->opened()){
+        i->set_error(std::format("Cannot open port [{}]", port));
+        return false;
+    }
+
+    termios options{};
+    if(tcgetattr(i->handle, &options) != 0){
+        i->set_error(std::format("Cannot get attributes of port [{}]", port));
+        close();
+        return false;
+    }
+    cfmakeraw(&options);
+    options.c_cflag |= CLOCAL | CREAD;
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    if(tcsetattr(i->handle, TCSANOW, &options) != 0){
+        i->set_error(std::format("Cannot set attributes of port [{}]", port));
+        close();
+        return false;
+    }
+    tcflush(i->handle, TCIFLUSH);
+    i->readTimeoutMs = readTimeoutMs;
+
+#endif
+
+    return true;
+}
+
+auto SerialPort::close() -> void{
+
+    if(!i->opened()){
+        return;
+    }
+#ifdef _WIN32
+    CloseHandle(i->handle);
+    i->handle = INVALID_HANDLE_VALUE;
+#else
+    ::close(i->handle);
+    i->handle = -1;
+#endif
+}
+
+auto SerialPort::is_opened() const noexcept -> bool{
+    return i->opened();
+}
+
+auto SerialPort::last_error() const -> const std::string&{
+    return i->lastError;
+}
+
+auto SerialPort::read(std::byte *data, size_t maxSize) -> std::int64_t{
+
+    if(!i->opened()){
+        return -1;
+    }
+
+#ifdef _WIN32
+    DWORD count = 0;
+    if(!ReadFile(i->handle, data, static_cast<DWORD>(maxSize), &count, nullptr)){
+        i->set_error("Cannot read port");
+        return -1;
+    }
+    return static_cast<std::int64_t>(count);
+#else
+    pollfd fd{i->handle, POLLIN, 0};
+    const int result = poll(&fd, 1, i->readTimeoutMs);
+    if(result == 0){
+        return 0;
+    }
+    if(result < 0 || ((fd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0 && (fd.revents & POLLIN) == 0)){
+        i->set_error("Cannot wait for port");
+        return -1;
+    }
+
+    const auto count = ::read(i->handle, data, maxSize);
+    if(count < 0){
+        if(errno == EAGAIN || errno == EWOULDBLOCK){
+            return 0;
+        }
+        i->set_error("Cannot read port");
+        return -1;
+    }
+    return static_cast<std::int64_t>(count);
+#endif
+}
@@ -0,0 +1,148 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tool::ex {
+
+enum class SerialFraming : int{
+    Delimiter = 0,  /**< messages end with a delimiter sequence (not included in the message) */
+    FixedLength,    /**< messages of messageLength bytes */
+    BinaryStruct    /**< messages of the size of structFormat */
+};
+
+struct SerialFramingSettings{
+    SerialFraming mode = SerialFraming::Delimiter;
+    std::string delimiter = "\\n";      /**< escape sequences: \n \r \t \0 \\ \xHH */
+    size_t messageLength = 1;
+    std::string structFormat = "<hhf";  /**< byte order (< or >) followed by fields b B h H i I q Q f d, with optional repeat counts (3f) */
+    size_t maxMessageLength = 65536;    /**< bytes without delimiter are discarded above this size */
+};
+
+// fields layout of a packed binary message
+class SerialStructFormat{
+
+public:
+
+    auto parse(std::string_view format) -> bool;
+    auto size() const noexcept -> size_t{return m_size;}
+    auto fields_count() const noexcept -> size_t{return m_fields.size();}
+    // writes fields_count values converted to double
+    auto decode(const std::byte *message, double *values) const noexcept -> void;
+
+private:
+
+    bool m_bigEndian = false;
+    std::vector<char> m_fields;
+    size_t m_size = 0;
+};
+
+// splits the received bytes into messages, incomplete messages are kept for the next push
+class SerialMessagesFramer{
+
+public:
+
+    auto reset(const SerialFramingSettings &settings) -> bool;
+    auto struct_format() const noexcept -> const SerialStructFormat&{return m_structFormat;}
+    auto discarded_bytes() const noexcept -> size_t{return m_discardedBytes;}
+
+    template<typename OnMessage>
+    auto push(const std::byte *data, size_t size, OnMessage &&onMessage) -> void{
+
+        m_pending.insert(m_pending.end(), data, data + size);
+
+        size_t start = 0;
+        if(m_mode == SerialFraming::Delimiter){
+
+            const size_t delimiterSize = m_delimiter.size();
+            size_t position = m_scanned;
+            while(position + delimiterSize <= m_pending.size()){
+                if(std::equal(m_delimiter.begin(), m_delimiter.end(), m_pending.begin() + position)){
+                    onMessage(m_pending.data() + start, position - start);
+                    position += delimiterSize;
+                    start = position;
+                }else{
+                    ++position;
+                }
+            }
+            if(m_pending.size() - start > m_maxMessageLength){
+                m_discardedBytes += m_pending.size() - start;
+                start     = m_pending.size();
+                m_scanned = 0;
+            }else{
+                m_scanned = position - start;
+            }
+
+        }else{
+            while(m_pending.size() - start >= m_messageLength){
+                onMessage(m_pending.data() + start, m_messageLength);
+                start += m_messageLength;
+            }
+        }
+
+        m_pending.erase(m_pending.begin(), m_pending.begin() + start);
+    }
+
+private:
+
+    SerialFraming m_mode = SerialFraming::Delimiter;
+    std::vector<std::byte> m_delimiter;
+    size_t m_messageLength = 1;
+    size_t m_maxMessageLength = 65536;
+    SerialStructFormat m_structFormat;
+
+    std::vector<std::byte> m_pending;
+    size_t m_scanned = 0;           /**< pending bytes already searched for a delimiter */
+    size_t m_discardedBytes = 0;
+};
+
+// raw 8N1 serial port, reads wait at most readTimeoutMs
+class SerialPort{
+
+public:
+
+    SerialPort();
+    ~SerialPort();
+
+    auto open(const std::string &port, int baudRate, int readTimeoutMs) -> bool;
+    auto close() -> void;
+    auto is_opened() const noexcept -> bool;
+    auto last_error() const -> const std::string&;
+
+    // returns the bytes count read, 0 on timeout and -1 on error
+    auto read(std::byte *data, size_t maxSize) -> std::int64_t;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
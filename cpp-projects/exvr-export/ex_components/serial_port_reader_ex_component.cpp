@@ -0,0 +1,201 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "serial_port_reader_ex_component.hpp"
+
+// std
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <thread>
+
+using namespace std::chrono;
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace {
+constexpr size_t queueSize     = 4 * 1024 * 1024;
+constexpr size_t readChunkSize = 4096;
+constexpr int readWaitMs       = 5;
+constexpr auto errorWait       = milliseconds(10);
+}
+
+struct SerialPortReaderExComponent::Impl{
+
+    std::string portName;
+    int baudRate = 9600;
+    SerialFramingSettings framing;
+
+    SerialPort port;
+    SerialMessagesFramer framer;
+    TimestampedMessagesQueue queue;
+    TimestampedMessages frameMessages;
+
+    std::thread reader;
+    std::atomic_bool read = false;
+
+    steady_clock::time_point experimentStart;
+    std::atomic<size_t> receivedCount = 0;
+    std::atomic<size_t> droppedCount = 0;
+    std::atomic<size_t> discardedBytes = 0;
+    std::atomic<size_t> readErrorsCount = 0;
+
+    auto read_loop() -> void{
+
+        std::vector<std::byte> chunk(readChunkSize);
+        while(read){
+
+            const auto count = port.read(chunk.data(), chunk.size());
+            if(count < 0){
+                ++readErrorsCount;
+                std::this_thread::sleep_for(errorWait);
+                continue;
+            }
+            if(count == 0){
+                continue;
+            }
+
+            // messages completed by this chunk share its reception time
+            const double timeMs = duration<double, std::milli>(steady_clock::now() - experimentStart).count();
+            size_t received = 0;
+            framer.push(chunk.data(), static_cast<size_t>(count), [&](const std::byte *message, size_t size){
+                if(!queue.push(message, size, timeMs)){
+                    ++droppedCount;
+                }
+                ++received;
+            });
+            receivedCount += received;
+            discardedBytes = framer.discarded_bytes();
+        }
+    }
+
+    auto stop() -> void{
+        if(reader.joinable()){
+            read = false;
+            reader.join();
+        }
+    }
+};
+
+SerialPortReaderExComponent::SerialPortReaderExComponent() : i(std::make_unique<Impl>()){
+}
+
+SerialPortReaderExComponent::~SerialPortReaderExComponent(){
+    i->stop();
+}
+
+auto SerialPortReaderExComponent::initialize() -> bool{
+
+    i->portName              = get<std::string>(ParametersContainer::InitConfig, "port_to_read");
+    i->baudRate              = get<int>(ParametersContainer::InitConfig, "baud_rate");
+    i->framing.mode          = static_cast<SerialFraming>(get<int>(ParametersContainer::InitConfig, "framing_mode"));
+    i->framing.delimiter     = get<std::string>(ParametersContainer::InitConfig, "delimiter");
+    i->framing.messageLength = static_cast<size_t>(std::max(get<int>(ParametersContainer::InitConfig, "message_length"), 1));
+    i->framing.structFormat  = get<std::string>(ParametersContainer::InitConfig, "struct_format");
+
+    if(!i->framer.reset(i->framing)){
+        log_error(std::format("Invalid framing settings (delimiter [{}], struct format [{}]).", i->framing.delimiter, i->framing.structFormat));
+        return false;
+    }
+
+    if(!i->port.open(i->portName, i->baudRate, readWaitMs)){
+        log_error(std::format("Cannot open serial port [{}]: {}", i->portName, i->port.last_error()));
+        return false;
+    }
+    i->queue.reset(queueSize);
+    return true;
+}
+
+auto SerialPortReaderExComponent::clean() -> void{
+    i->stop();
+    i->port.close();
+}
+
+auto SerialPortReaderExComponent::start_experiment() -> void{
+
+    i->stop();
+
+    i->framer.reset(i->framing);
+    i->frameMessages.clear();
+    i->receivedCount   = 0;
+    i->droppedCount    = 0;
+    i->discardedBytes  = 0;
+    i->readErrorsCount = 0;
+
+    i->experimentStart = steady_clock::now();
+    i->read   = true;
+    i->reader = std::thread(&Impl::read_loop, i.get());
+}
+
+auto SerialPortReaderExComponent::stop_experiment() -> void{
+
+    i->stop();
+
+    if(i->droppedCount > 0){
+        log_error(std::format("{} messages dropped because the reception queue was full.", i->droppedCount.load()));
+    }
+    if(i->discardedBytes > 0){
+        log_error(std::format("{} bytes discarded because no delimiter was found.", i->discardedBytes.load()));
+    }
+    if(i->readErrorsCount > 0){
+        log_error(std::format("{} read errors on port [{}]: {}", i->readErrorsCount.load(), i->portName, i->port.last_error()));
+    }
+}
+
+auto SerialPortReaderExComponent::update() -> void{
+    i->frameMessages.clear();
+    i->queue.drain(i->frameMessages);
+}
+
+auto SerialPortReaderExComponent::frame_messages() const noexcept -> const TimestampedMessages&{
+    return i->frameMessages;
+}
+
+auto SerialPortReaderExComponent::fields_count() const noexcept -> size_t{
+    return i->framing.mode == SerialFraming::BinaryStruct ? i->framer.struct_format().fields_count() : 0;
+}
+
+auto SerialPortReaderExComponent::message_values(size_t idMessage, double *values) const -> size_t{
+    if(fields_count() == 0 || idMessage >= i->frameMessages.count()){
+        return 0;
+    }
+    i->framer.struct_format().decode(i->frameMessages.message_data(idMessage), values);
+    return fields_count();
+}
+
+auto SerialPortReaderExComponent::received_count() const noexcept -> size_t{
+    return i->receivedCount.load();
+}
+
+auto SerialPortReaderExComponent::dropped_count() const noexcept -> size_t{
+    return i->droppedCount.load();
+}
+
+auto SerialPortReaderExComponent::discarded_bytes() const noexcept -> size_t{
+    return i->discardedBytes.load();
+}
+
+auto SerialPortReaderExComponent::read_errors_count() const noexcept -> size_t{
+    return i->readErrorsCount.load();
+}
@@ -0,0 +1,87 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "serial_port_reader_ex_component_export.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+
+using namespace tool::ex;
+
+SerialPortReaderExComponent *create_serial_port_reader_ex_component(){
+    return new SerialPortReaderExComponent();
+}
+
+int get_messages_count_serial_port_reader_ex_component(SerialPortReaderExComponent *sC){
+    return static_cast<int>(sC->frame_messages().count());
+}
+
+int get_message_size_serial_port_reader_ex_component(SerialPortReaderExComponent *sC, int idMessage){
+    const auto &messages = sC->frame_messages();
+    if(idMessage < 0 || static_cast<size_t>(idMessage) >= messages.count()){
+        return 0;
+    }
+    return static_cast<int>(messages.message_size(idMessage));
+}
+
+double get_message_time_ms_serial_port_reader_ex_component(SerialPortReaderExComponent *sC, int idMessage){
+    const auto &messages = sC->frame_messages();
+    if(idMessage < 0 || static_cast<size_t>(idMessage) >= messages.count()){
+        return 0.;
+    }
+    return messages.timesMs[idMessage];
+}
+
+int copy_message_serial_port_reader_ex_component(SerialPortReaderExComponent *sC, int idMessage, unsigned char *data, int size){
+    const auto &messages = sC->frame_messages();
+    if(idMessage < 0 || static_cast<size_t>(idMessage) >= messages.count() || size <= 0){
+        return 0;
+    }
+    const size_t count = std::min(messages.message_size(idMessage), static_cast<size_t>(size));
+    std::memcpy(data, messages.message_data(idMessage), count);
+    return static_cast<int>(count);
+}
+
+int get_fields_count_serial_port_reader_ex_component(SerialPortReaderExComponent *sC){
+    return static_cast<int>(sC->fields_count());
+}
+
+int get_message_values_serial_port_reader_ex_component(SerialPortReaderExComponent *sC, int idMessage, double *values){
+    if(idMessage < 0){
+        return 0;
+    }
+    return static_cast<int>(sC->message_values(static_cast<size_t>(idMessage), values));
+}
+
+long long get_received_count_serial_port_reader_ex_component(SerialPortReaderExComponent *sC){
+    return static_cast<long long>(sC->received_count());
+}
+
+long long get_dropped_count_serial_port_reader_ex_component(SerialPortReaderExComponent *sC){
+    return static_cast<long long>(sC->dropped_count());
+}
+
+long long get_discarded_bytes_serial_port_reader_ex_component(SerialPortReaderExComponent *sC){
+    return static_cast<long long>(sC->discarded_bytes());
+}
@@ -0,0 +1,145 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "udp_reader_ex_component.hpp"
+
+// std
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <thread>
+
+using namespace std::chrono;
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace {
+constexpr size_t queueSize  = 16 * 1024 * 1024;
+constexpr int receiveWaitMs = 5;
+}
+
+struct UdpReaderExComponent::Impl{
+
+    UdpSocket socket;
+    TimestampedMessagesQueue queue;
+    TimestampedMessages framePackets;
+
+    std::thread receiver;
+    std::atomic_bool receive = false;
+
+    steady_clock::time_point experimentStart;
+    std::int64_t experimentStartSystemNs = 0;
+    std::atomic<size_t> receivedCount = 0;
+    std::atomic<size_t> droppedCount = 0;
+
+    auto receive_loop() -> void{
+
+        UdpReceiveBatch batch;
+        while(receive){
+
+            if(socket.receive(batch, receiveWaitMs) == 0){
+                continue;
+            }
+
+            const double nowMs = duration<double, std::milli>(steady_clock::now() - experimentStart).count();
+            for(size_t ii = 0; ii < batch.count; ++ii){
+                // the kernel time is used when available since the packets of a batch may have waited in the socket buffer
+                const double timeMs = batch.kernelTimesNs[ii] < 0 ? nowMs : (batch.kernelTimesNs[ii] - experimentStartSystemNs)*1e-6;
+                if(!queue.push(batch.packet_data(ii), batch.sizes[ii], timeMs)){
+                    ++droppedCount;
+                }
+            }
+            receivedCount += batch.count;
+        }
+    }
+
+    auto stop() -> void{
+        if(receiver.joinable()){
+            receive = false;
+            receiver.join();
+        }
+    }
+};
+
+UdpReaderExComponent::UdpReaderExComponent() : i(std::make_unique<Impl>()){
+}
+
+UdpReaderExComponent::~UdpReaderExComponent(){
+    i->stop();
+}
+
+auto UdpReaderExComponent::initialize() -> bool{
+
+    const auto address = get<std::string>(ParametersContainer::InitConfig, "reading_address");
+    const auto port    = get<int>(ParametersContainer::InitConfig, "reading_port");
+    if(!i->socket.open_reader(address, port)){
+        log_error(std::format("Cannot open UDP reader on [{}:{}]: {}", address, port, i->socket.last_error()));
+        return false;
+    }
+    i->queue.reset(queueSize);
+    return true;
+}
+
+auto UdpReaderExComponent::clean() -> void{
+    i->stop();
+    i->socket.close();
+}
+
+auto UdpReaderExComponent::start_experiment() -> void{
+
+    i->stop();
+
+    i->framePackets.clear();
+    i->receivedCount = 0;
+    i->droppedCount  = 0;
+
+    i->experimentStart         = steady_clock::now();
+    i->experimentStartSystemNs = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    i->receive  = true;
+    i->receiver = std::thread(&Impl::receive_loop, i.get());
+}
+
+auto UdpReaderExComponent::stop_experiment() -> void{
+    i->stop();
+    if(i->droppedCount > 0){
+        log_error(std::format("{} packets dropped because the reception queue was full.", i->droppedCount.load()));
+    }
+}
+
+auto UdpReaderExComponent::update() -> void{
+    i->framePackets.clear();
+    i->queue.drain(i->framePackets);
+}
+
+auto UdpReaderExComponent::frame_packets() const noexcept -> const TimestampedMessages&{
+    return i->framePackets;
+}
+
+auto UdpReaderExComponent::received_count() const noexcept -> size_t{
+    return i->receivedCount.load();
+}
+
+auto UdpReaderExComponent::dropped_count() const noexcept -> size_t{
+    return i->droppedCount.load();
+}
@@ -0,0 +1,62 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <memory>
+
+// base
+#include "exvr/ex_component.hpp"
+
+// local
+#include "udp_socket.hpp"
+
+namespace tool::ex {
+
+// a receive thread reads the packets by batches and stamps them with the experiment time,
+// they are queued and made available to the frame thread once per update
+class UdpReaderExComponent : public ExComponent{
+
+public:
+
+    UdpReaderExComponent();
+    ~UdpReaderExComponent() override;
+
+    auto initialize() -> bool override;
+    auto clean() -> void override;
+    auto start_experiment() -> void override;
+    auto stop_experiment() -> void override;
+    auto update() -> void override;
+
+    // packets received since the previous update
+    auto frame_packets() const noexcept -> const TimestampedMessages&;
+
+    auto received_count() const noexcept -> size_t;
+    auto dropped_count() const noexcept -> size_t;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
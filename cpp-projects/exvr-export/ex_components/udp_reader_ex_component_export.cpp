@@ -0,0 +1,72 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "udp_reader_ex_component_export.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+
+using namespace tool::ex;
+
+UdpReaderExComponent *create_udp_reader_ex_component(){
+    return new UdpReaderExComponent();
+}
+
+int get_packets_count_udp_reader_ex_component(UdpReaderExComponent *uC){
+    return static_cast<int>(uC->frame_packets().count());
+}
+
+int get_packet_size_udp_reader_ex_component(UdpReaderExComponent *uC, int idPacket){
+    const auto &packets = uC->frame_packets();
+    if(idPacket < 0 || static_cast<size_t>(idPacket) >= packets.count()){
+        return 0;
+    }
+    return static_cast<int>(packets.message_size(idPacket));
+}
+
+double get_packet_time_ms_udp_reader_ex_component(UdpReaderExComponent *uC, int idPacket){
+    const auto &packets = uC->frame_packets();
+    if(idPacket < 0 || static_cast<size_t>(idPacket) >= packets.count()){
+        return 0.;
+    }
+    return packets.timesMs[idPacket];
+}
+
+int copy_packet_udp_reader_ex_component(UdpReaderExComponent *uC, int idPacket, unsigned char *data, int size){
+    const auto &packets = uC->frame_packets();
+    if(idPacket < 0 || static_cast<size_t>(idPacket) >= packets.count() || size <= 0){
+        return 0;
+    }
+    const size_t count = std::min(packets.message_size(idPacket), static_cast<size_t>(size));
+    std::memcpy(data, packets.message_data(idPacket), count);
+    return static_cast<int>(count);
+}
+
+long long get_received_count_udp_reader_ex_component(UdpReaderExComponent *uC){
+    return static_cast<long long>(uC->received_count());
+}
+
+long long get_dropped_count_udp_reader_ex_component(UdpReaderExComponent *uC){
+    return static_cast<long long>(uC->dropped_count());
+}
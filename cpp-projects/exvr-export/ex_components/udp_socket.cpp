@@ -0,0 +1,341 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "udp_socket.hpp"
+
+// std
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace tool::ex;
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+constexpr SocketHandle invalidSocket = INVALID_SOCKET;
+
+auto socket_error() -> int{return WSAGetLastError();}
+auto would_block(int error) -> bool{return error == WSAEWOULDBLOCK;}
+auto close_socket(SocketHandle handle) -> void{closesocket(handle);}
+auto wait_socket(SocketHandle handle, short events, int timeoutMs) -> bool{
+    WSAPOLLFD fd{handle, events, 0};
+    return WSAPoll(&fd, 1, timeoutMs) > 0;
+}
+constexpr short readEvent  = POLLRDNORM;
+constexpr short writeEvent = POLLWRNORM;
+
+struct WinsockSession{
+    WinsockSession(){
+        WSADATA data;
+        WSAStartup(MAKEWORD(2,2), &data);
+    }
+    ~WinsockSession(){
+        WSACleanup();
+    }
+};
+#else
+using SocketHandle = int;
+constexpr SocketHandle invalidSocket = -1;
+
+auto socket_error() -> int{return errno;}
+auto would_block(int error) -> bool{return error == EAGAIN || error == EWOULDBLOCK;}
+auto close_socket(SocketHandle handle) -> void{::close(handle);}
+auto wait_socket(SocketHandle handle, short events, int timeoutMs) -> bool{
+    pollfd fd{handle, events, 0};
+    return poll(&fd, 1, timeoutMs) > 0;
+}
+constexpr short readEvent  = POLLIN;
+constexpr short writeEvent = POLLOUT;
+#endif
+
+constexpr size_t sendBatchSize    = 256;
+constexpr int sendWaitMs          = 10;
+
+auto resolve(const std::string &address, int port, sockaddr_in &socketAddress) -> bool{
+
+    addrinfo hints{};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo *result = nullptr;
+    if(getaddrinfo(address.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || result == nullptr){
+        return false;
+    }
+    std::memcpy(&socketAddress, result->ai_addr, sizeof(sockaddr_in));
+    freeaddrinfo(result);
+    return true;
+}
+}
+
+struct UdpSocket::Impl{
+
+    SocketHandle handle = invalidSocket;
+    std::string lastError;
+
+#ifdef __linux__
+    std::vector<mmsghdr> messages;
+    std::vector<iovec> iovecs;
+    std::vector<std::array<char, CMSG_SPACE(sizeof(timespec))>> controls;
+#endif
+
+    auto set_error(const std::string &context) -> void{
+        lastError = std::format("{} (error {})", context, socket_error());
+    }
+
+    auto create(int bufferSize, bool reader) -> bool{
+
+#ifdef _WIN32
+        static WinsockSession session;
+#endif
+        handle = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if(handle == invalidSocket){
+            set_error("Cannot create socket");
+            return false;
+        }
+
+        // a large kernel buffer absorbs the bursts while the thread is not scheduled
+        setsockopt(handle, SOL_SOCKET, reader ? SO_RCVBUF : SO_SNDBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+        // non-blocking, waits are done with poll
+#ifdef _WIN32
+        u_long mode = 1;
+        ioctlsocket(handle, FIONBIO, &mode);
+#else
+        fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+        return true;
+    }
+
+#ifdef __linux__
+    auto prepare(size_t count) -> void{
+        if(messages.size() < count){
+            messages.resize(count);
+            iovecs.resize(count);
+            controls.resize(count);
+        }
+    }
+#endif
+};
+
+UdpSocket::UdpSocket() : i(std::make_unique<Impl>()){
+}
+
+UdpSocket::~UdpSocket(){
+    close();
+}
+
+auto UdpSocket::open_reader(const std::string &address, int port, int bufferSize) -> bool{
+
+    close();
+
+    sockaddr_in socketAddress{};
+    if(!resolve(address, port, socketAddress)){
+        i->lastError = std::format("Cannot resolve address [{}].", address);
+        return false;
+    }
+    if(!i->create(bufferSize, true)){
+        return false;
+    }
+    if(bind(i->handle, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0){
+        i->set_error(std::format("Cannot bind socket to [{}:{}]", address, port));
+        close();
+        return false;
+    }
+
+#ifdef __linux__
+    // reception time of each packet
+    int enable = 1;
+    setsockopt(i->handle, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable));
+#endif
+    return true;
+}
+
+auto UdpSocket::open_writer(const std::string &address, int port, int bufferSize) -> bool{
+
+    close();
+
+    sockaddr_in socketAddress{};
+    if(!resolve(address, port, socketAddress)){
+        i->lastError = std::format("Cannot resolve address [{}].", address);
+        return false;
+    }
+    if(!i->create(bufferSize, false)){
+        return false;
+    }
+    if(connect(i->handle, reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0){
+        i->set_error(std::format("Cannot connect socket to [{}:{}]", address, port));
+        close();
+        return false;
+    }
+    return true;
+}
+
+auto UdpSocket::close() -> void{
+    if(i->handle != invalidSocket){
+        close_socket(i->handle);
+        i->handle = invalidSocket;
+    }
+}
+
+auto UdpSocket::is_opened() const noexcept -> bool{
+    return i->handle != invalidSocket;
+}
+
+auto UdpSocket::last_error() const -> const std::string&{
+    return i->lastError;
+}
+
+auto UdpSocket::receive(UdpReceiveBatch &batch, int timeoutMs) -> size_t{
+
+    batch.count = 0;
+    if(!is_opened() || !wait_socket(i->handle, readEvent, timeoutMs)){
+        return 0;
+    }
+
+#ifdef __linux__
+
+    i->prepare(UdpReceiveBatch::maxPackets);
+    for(size_t ii = 0; ii < UdpReceiveBatch::maxPackets; ++ii){
+        i->iovecs[ii] = {batch.data.data() + ii*UdpReceiveBatch::maxPacketSize, UdpReceiveBatch::maxPacketSize};
+        auto &header = i->messages[ii].msg_hdr;
+        header = {};
+        header.msg_iov        = &i->iovecs[ii];
+        header.msg_iovlen     = 1;
+        header.msg_control    = i->controls[ii].data();
+        header.msg_controllen = i->controls[ii].size();
+    }
+
+    const int count = recvmmsg(i->handle, i->messages.data(), UdpReceiveBatch::maxPackets, MSG_DONTWAIT, nullptr);
+    if(count <= 0){
+        if(!would_block(socket_error())){
+            i->set_error("Cannot receive packets");
+        }
+        return 0;
+    }
+
+    for(int ii = 0; ii < count; ++ii){
+        batch.sizes[ii]         = i->messages[ii].msg_len;
+        batch.kernelTimesNs[ii] = -1;
+        auto &header = i->messages[ii].msg_hdr;
+        for(cmsghdr *control = CMSG_FIRSTHDR(&header); control != nullptr; control = CMSG_NXTHDR(&header, control)){
+            if(control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS){
+                timespec time;
+                std::memcpy(&time, CMSG_DATA(control), sizeof(time));
+                batch.kernelTimesNs[ii] = static_cast<std::int64_t>(time.tv_sec)*1000000000 + time.tv_nsec;
+            }
+        }
+    }
+    batch.count = static_cast<size_t>(count);
+
+#else
+
+    while(batch.count < UdpReceiveBatch::maxPackets){
+        const auto received = recv(
+            i->handle,
+            reinterpret_cast<char*>(batch.data.data() + batch.count*UdpReceiveBatch::maxPacketSize),
+            static_cast<int>(UdpReceiveBatch::maxPacketSize),
+            0
+        );
+        if(received < 0){
+            if(!would_block(socket_error())){
+                i->set_error("Cannot receive packet");
+            }
+            break;
+        }
+        batch.sizes[batch.count]         = static_cast<size_t>(received);
+        batch.kernelTimesNs[batch.count] = -1;
+        ++batch.count;
+    }
+
+#endif
+
+    return batch.count;
+}
+
+auto UdpSocket::send(const TimestampedMessages &packets, size_t first) -> size_t{
+
+    if(!is_opened()){
+        return 0;
+    }
+
+    size_t sent = 0;
+    size_t current = first;
+    while(current < packets.count()){
+
+#ifdef __linux__
+        const size_t count = std::min(packets.count() - current, sendBatchSize);
+        i->prepare(count);
+        for(size_t ii = 0; ii < count; ++ii){
+            i->iovecs[ii] = {const_cast<std::byte*>(packets.message_data(current + ii)), packets.message_size(current + ii)};
+            auto &header = i->messages[ii].msg_hdr;
+            header = {};
+            header.msg_iov    = &i->iovecs[ii];
+            header.msg_iovlen = 1;
+        }
+        const int result = sendmmsg(i->handle, i->messages.data(), static_cast<unsigned int>(count), 0);
+#else
+        const int result = ::send(
+            i->handle,
+            reinterpret_cast<const char*>(packets.message_data(current)),
+            static_cast<int>(packets.message_size(current)),
+            0
+        ) < 0 ? -1 : 1;
+#endif
+
+        if(result > 0){
+            sent    += static_cast<size_t>(result);
+            current += static_cast<size_t>(result);
+            continue;
+        }
+
+        if(would_block(socket_error())){
+            // kernel buffer full
+            if(wait_socket(i->handle, writeEvent, sendWaitMs)){
+                continue;
+            }
+            i->set_error("Send buffer full");
+            break;
+        }
+
+        // the packet is skipped (e.g. no reader on a connected loopback port)
+        i->set_error("Cannot send packet");
+        ++current;
+    }
+    return sent;
+}
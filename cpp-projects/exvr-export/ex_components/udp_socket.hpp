@@ -0,0 +1,79 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// local
+#include "messages_queue.hpp"
+
+namespace tool::ex {
+
+// received packets of a single batched call
+struct UdpReceiveBatch{
+
+    static constexpr size_t maxPackets    = 64;
+    static constexpr size_t maxPacketSize = 65536;
+
+    UdpReceiveBatch() : data(maxPackets*maxPacketSize), sizes(maxPackets), kernelTimesNs(maxPackets){}
+
+    auto packet_data(size_t id) const noexcept -> const std::byte*{return data.data() + id*maxPacketSize;}
+
+    std::vector<std::byte> data;
+    std::vector<size_t> sizes;
+    std::vector<std::int64_t> kernelTimesNs; /**< system clock reception time from the kernel, -1 if unavailable */
+    size_t count = 0;
+};
+
+// IPv4 datagram socket, batches receives and sends with recvmmsg/sendmmsg on Linux
+// and falls back to non-blocking loops elsewhere
+class UdpSocket{
+
+public:
+
+    UdpSocket();
+    ~UdpSocket();
+
+    // binds on address:port
+    auto open_reader(const std::string &address, int port, int bufferSize = 4*1024*1024) -> bool;
+    // connects to address:port
+    auto open_writer(const std::string &address, int port, int bufferSize = 4*1024*1024) -> bool;
+    auto close() -> void;
+    auto is_opened() const noexcept -> bool;
+    auto last_error() const -> const std::string&;
+
+    // waits up to timeoutMs for a packet, then reads every pending packet up to the batch capacity
+    auto receive(UdpReceiveBatch &batch, int timeoutMs) -> size_t;
+    // sends the packets from the first one, returns the count sent
+    auto send(const TimestampedMessages &packets, size_t first = 0) -> size_t;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
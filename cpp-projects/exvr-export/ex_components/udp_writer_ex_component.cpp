@@ -0,0 +1,168 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "udp_writer_ex_component.hpp"
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono;
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace {
+constexpr size_t queueSize = 16 * 1024 * 1024;
+}
+
+struct UdpWriterExComponent::Impl{
+
+    UdpSocket socket;
+    TimestampedMessagesQueue queue;
+    TimestampedMessages sendPackets;
+
+    std::thread sender;
+    std::mutex senderL;
+    std::condition_variable senderC;
+    bool flushRequested = false;
+    bool stopSender = false;
+
+    steady_clock::time_point experimentStart;
+    std::atomic<size_t> sentCount = 0;
+    std::atomic<size_t> droppedCount = 0;
+
+    auto send_pending() -> void{
+        sendPackets.clear();
+        if(queue.drain(sendPackets) == 0){
+            return;
+        }
+        const size_t sent = socket.send(sendPackets);
+        sentCount    += sent;
+        droppedCount += sendPackets.count() - sent;
+    }
+
+    auto send_loop() -> void{
+
+        std::unique_lock<std::mutex> lock(senderL);
+        while(!stopSender){
+            senderC.wait(lock, [&]{return flushRequested || stopSender;});
+            flushRequested = false;
+            lock.unlock();
+            send_pending();
+            lock.lock();
+        }
+    }
+
+    auto notify() -> void{
+        senderL.lock();
+        flushRequested = true;
+        senderL.unlock();
+        senderC.notify_one();
+    }
+
+    auto stop() -> void{
+
+        if(sender.joinable()){
+            senderL.lock();
+            stopSender = true;
+            senderL.unlock();
+            senderC.notify_one();
+            sender.join();
+        }
+        send_pending();
+    }
+};
+
+UdpWriterExComponent::UdpWriterExComponent() : i(std::make_unique<Impl>()){
+}
+
+UdpWriterExComponent::~UdpWriterExComponent(){
+    i->stop();
+}
+
+auto UdpWriterExComponent::initialize() -> bool{
+
+    const auto address = get<std::string>(ParametersContainer::InitConfig, "writing_address");
+    const auto port    = get<int>(ParametersContainer::InitConfig, "writing_port");
+    if(!i->socket.open_writer(address, port)){
+        log_error(std::format("Cannot open UDP writer to [{}:{}]: {}", address, port, i->socket.last_error()));
+        return false;
+    }
+    i->queue.reset(queueSize);
+    return true;
+}
+
+auto UdpWriterExComponent::clean() -> void{
+    i->stop();
+    i->socket.close();
+}
+
+auto UdpWriterExComponent::start_experiment() -> void{
+
+    i->stop();
+
+    i->sentCount    = 0;
+    i->droppedCount = 0;
+
+    i->experimentStart = steady_clock::now();
+    i->flushRequested  = false;
+    i->stopSender      = false;
+    i->sender = std::thread(&Impl::send_loop, i.get());
+}
+
+auto UdpWriterExComponent::stop_experiment() -> void{
+    i->stop();
+    if(i->droppedCount > 0){
+        log_error(std::format("{} packets not sent: {}", i->droppedCount.load(), i->socket.last_error()));
+    }
+}
+
+auto UdpWriterExComponent::post_update() -> void{
+    i->notify();
+}
+
+auto UdpWriterExComponent::send_packet(const std::byte *data, size_t size) -> bool{
+    const double timeMs = duration<double, std::milli>(steady_clock::now() - i->experimentStart).count();
+    if(!i->queue.push(data, size, timeMs)){
+        ++i->droppedCount;
+        return false;
+    }
+    return true;
+}
+
+auto UdpWriterExComponent::flush() -> void{
+    i->notify();
+}
+
+auto UdpWriterExComponent::sent_count() const noexcept -> size_t{
+    return i->sentCount.load();
+}
+
+auto UdpWriterExComponent::dropped_count() const noexcept -> size_t{
+    return i->droppedCount.load();
+}
@@ -0,0 +1,56 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "udp_writer_ex_component_export.hpp"
+
+// std
+#include <cstring>
+
+using namespace tool::ex;
+
+UdpWriterExComponent *create_udp_writer_ex_component(){
+    return new UdpWriterExComponent();
+}
+
+int send_packet_udp_writer_ex_component(UdpWriterExComponent *uC, const unsigned char *data, int size){
+    if(size < 0){
+        return 0;
+    }
+    return uC->send_packet(reinterpret_cast<const std::byte*>(data), static_cast<size_t>(size)) ? 1 : 0;
+}
+
+int send_string_udp_writer_ex_component(UdpWriterExComponent *uC, const char *text){
+    return uC->send_packet(reinterpret_cast<const std::byte*>(text), std::strlen(text)) ? 1 : 0;
+}
+
+void flush_udp_writer_ex_component(UdpWriterExComponent *uC){
+    uC->flush();
+}
+
+long long get_sent_count_udp_writer_ex_component(UdpWriterExComponent *uC){
+    return static_cast<long long>(uC->sent_count());
+}
+
+long long get_dropped_count_udp_writer_ex_component(UdpWriterExComponent *uC){
+    return static_cast<long long>(uC->dropped_count());
+}
@@ -0,0 +1,481 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "video_decoder_ex_component.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// opencv
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+
+using namespace std::chrono;
+
+using namespace tool;
+using namespace tool::ex;
+
+namespace {
+
+enum class SlotState : int{
+    Free = 0,
+    Writing,    /**< filled by the converter */
+    Ready,      /**< waiting to be displayed */
+    Displayed   /**< held by the frame thread until the next selected frame */
+};
+
+struct FrameSlot{
+    std::vector<std::uint8_t> data;
+    SlotState state = SlotState::Free;
+    std::int64_t index = -1;
+    size_t generation = 0;
+};
+
+struct DecodedFrame{
+    cv::Mat image;
+    std::int64_t index = 0;
+    size_t generation = 0;
+    double decodeMs = 0.;
+};
+
+constexpr size_t convertQueueSize = 2;
+}
+
+struct VideoDecoderExComponent::Impl{
+
+    // settings
+    std::string path;
+    size_t ringSize = 6;
+    bool loop = false;
+    VideoDecoderInfos infos;
+
+    cv::VideoCapture capture;
+    std::thread decoder;
+    std::thread converter;
+
+    // shared, protected by L
+    std::mutex L;
+    std::condition_variable slotsC;
+    std::condition_variable queueC;
+    std::vector<FrameSlot> slots;
+    std::deque<DecodedFrame> toConvert;
+    size_t generation = 0;          /**< incremented at each seek, older frames are discarded */
+    std::int64_t seekTarget = 0;
+    bool seekRequested = false;
+    bool decoderEnded = false;
+    bool stopThreads = false;
+    double latencySumMs = 0.;
+    double latencyMaxMs = 0.;
+
+    // frame thread
+    int displayedSlot = -1;
+    std::int64_t displayedIndex = -1;
+    bool playing = false;
+    steady_clock::time_point playStart;
+    double playStartVideoMs = 0.;
+    double pausedVideoMs = 0.;
+
+    std::atomic<size_t> decodedCount = 0;
+    std::atomic<size_t> droppedCount = 0;
+    std::atomic<size_t> lateUpdatesCount = 0;
+
+    auto frame_index(double videoTimeMs) const noexcept -> std::int64_t{
+        return static_cast<std::int64_t>(std::floor(videoTimeMs * infos.fps / 1000. + 1e-6));
+    }
+
+    auto decode_loop() -> void{
+
+        std::int64_t index = 0;         /**< absolute index of the next frame, keeps increasing when looping */
+        std::int64_t passStart = 0;     /**< absolute index of the first frame of the current pass */
+        size_t currentGeneration = 0;
+        cv::Mat image;
+
+        while(true){
+
+            std::unique_lock<std::mutex> lock(L);
+            if(stopThreads){
+                return;
+            }
+
+            if(seekRequested){
+                seekRequested     = false;
+                decoderEnded      = false;
+                currentGeneration = generation;
+                const auto target = seekTarget;
+                lock.unlock();
+
+                const auto targetInFile = (loop && infos.framesCount > 0) ? target % infos.framesCount : target;
+                capture.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(targetInFile));
+                // containers seeking on key frames land before the target
+                auto position = static_cast<std::int64_t>(capture.get(cv::CAP_PROP_POS_FRAMES));
+                while(position < targetInFile && capture.grab()){
+                    ++position;
+                }
+                index     = target;
+                passStart = target - targetInFile;
+                continue;
+            }
+
+            if(decoderEnded){
+                slotsC.wait(lock, [&]{return stopThreads || seekRequested;});
+                continue;
+            }
+            lock.unlock();
+
+            const auto decodeStart = steady_clock::now();
+            const bool decoded = capture.read(image) && !image.empty();
+            const double decodeMs = duration<double, std::milli>(steady_clock::now() - decodeStart).count();
+            if(!decoded){
+                if(loop && index > passStart){
+                    capture.set(cv::CAP_PROP_POS_FRAMES, 0.);
+                    passStart = index;
+                }else{
+                    lock.lock();
+                    decoderEnded = true;
+                }
+                continue;
+            }
+
+            lock.lock();
+            queueC.wait(lock, [&]{return stopThreads || seekRequested || toConvert.size() < convertQueueSize;});
+            if(stopThreads || seekRequested){
+                continue;
+            }
+            toConvert.push_back({std::move(image), index++, currentGeneration, decodeMs});
+            lock.unlock();
+            queueC.notify_all();
+        }
+    }
+
+    auto convert_loop() -> void{
+
+        const int width  = infos.width;
+        const int height = infos.height;
+        cv::Mat flipped;
+
+        while(true){
+
+            std::unique_lock<std::mutex> lock(L);
+            queueC.wait(lock, [&]{return stopThreads || !toConvert.empty();});
+            if(stopThreads){
+                return;
+            }
+            auto frame = std::move(toConvert.front());
+            toConvert.pop_front();
+            queueC.notify_all();
+
+            FrameSlot *slot = nullptr;
+            slotsC.wait(lock, [&]{
+                if(stopThreads || frame.generation != generation){
+                    return true;
+                }
+                auto free = std::find_if(slots.begin(), slots.end(), [](const auto &s){return s.state == SlotState::Free;});
+                slot = free != slots.end() ? &(*free) : nullptr;
+                return slot != nullptr;
+            });
+            if(stopThreads){
+                return;
+            }
+            if(frame.generation != generation || frame.image.cols != width || frame.image.rows != height){
+                continue;
+            }
+            slot->state = SlotState::Writing;
+            lock.unlock();
+
+            // bottom-up RGBA rows, as expected by the textures
+            const auto convertStart = steady_clock::now();
+            cv::flip(frame.image, flipped, 0);
+            cv::Mat rgba(height, width, CV_8UC4, slot->data.data());
+            cv::cvtColor(flipped, rgba, flipped.channels() == 1 ? cv::COLOR_GRAY2RGBA : (flipped.channels() == 4 ? cv::COLOR_BGRA2RGBA : cv::COLOR_BGR2RGBA));
+            // waits for a free slot excluded
+            const double latencyMs = frame.decodeMs + duration<double, std::milli>(steady_clock::now() - convertStart).count();
+
+            lock.lock();
+            if(frame.generation == generation){
+                slot->state      = SlotState::Ready;
+                slot->index      = frame.index;
+                slot->generation = frame.generation;
+                latencySumMs += latencyMs;
+                latencyMaxMs  = std::max(latencyMaxMs, latencyMs);
+                ++decodedCount;
+            }else{
+                slot->state = SlotState::Free;
+                lock.unlock();
+                slotsC.notify_all();
+            }
+        }
+    }
+
+    auto start_threads() -> void{
+        stopThreads    = false;
+        seekRequested  = false;
+        decoderEnded   = false;
+        generation     = 0;
+        displayedSlot  = -1;
+        displayedIndex = -1;
+        toConvert.clear();
+        for(auto &slot : slots){
+            slot.state = SlotState::Free;
+        }
+        decoder   = std::thread(&Impl::decode_loop, this);
+        converter = std::thread(&Impl::convert_loop, this);
+    }
+
+    auto stop_threads() -> void{
+        L.lock();
+        stopThreads = true;
+        L.unlock();
+        slotsC.notify_all();
+        queueC.notify_all();
+        if(decoder.joinable()){
+            decoder.join();
+        }
+        if(converter.joinable()){
+            converter.join();
+        }
+    }
+};
+
+VideoDecoderExComponent::VideoDecoderExComponent() : i(std::make_unique<Impl>()){
+}
+
+VideoDecoderExComponent::~VideoDecoderExComponent(){
+    i->stop_threads();
+}
+
+auto VideoDecoderExComponent::initialize() -> bool{
+
+    i->path     = get<std::string>(ParametersContainer::Dynamic, "path_video");
+    i->ringSize = static_cast<size_t>(std::max(get<int>(ParametersContainer::InitConfig, "frames_ring_size"), 3));
+    i->loop     = get<int>(ParametersContainer::InitConfig, "loop") == 1;
+
+    if(!i->capture.open(i->path)){
+        log_error(std::format("Cannot open video [{}].", i->path));
+        return false;
+    }
+
+    i->infos.width       = static_cast<int>(i->capture.get(cv::CAP_PROP_FRAME_WIDTH));
+    i->infos.height      = static_cast<int>(i->capture.get(cv::CAP_PROP_FRAME_HEIGHT));
+    i->infos.fps         = i->capture.get(cv::CAP_PROP_FPS);
+    i->infos.framesCount = static_cast<std::int64_t>(i->capture.get(cv::CAP_PROP_FRAME_COUNT));
+    if(i->infos.width <= 0 || i->infos.height <= 0){
+        log_error(std::format("Invalid size for video [{}].", i->path));
+        return false;
+    }
+    if(i->infos.fps <= 0.){
+        log_message(std::format("No frame rate found for video [{}], 30 fps will be used.", i->path));
+        i->infos.fps = 30.;
+    }
+
+    i->slots = std::vector<FrameSlot>(i->ringSize);
+    for(auto &slot : i->slots){
+        slot.data.resize(static_cast<size_t>(i->infos.width) * i->infos.height * 4);
+    }
+    return true;
+}
+
+auto VideoDecoderExComponent::clean() -> void{
+    i->stop_threads();
+    i->capture.release();
+}
+
+auto VideoDecoderExComponent::start_experiment() -> void{
+
+    i->stop_threads();
+
+    i->decodedCount     = 0;
+    i->droppedCount     = 0;
+    i->lateUpdatesCount = 0;
+    i->latencySumMs     = 0.;
+    i->latencyMaxMs     = 0.;
+    i->playing          = false;
+    i->pausedVideoMs    = 0.;
+
+    i->capture.set(cv::CAP_PROP_POS_FRAMES, 0.);
+    i->start_threads();
+}
+
+auto VideoDecoderExComponent::stop_experiment() -> void{
+
+    i->stop_threads();
+
+    if(i->droppedCount > 0){
+        log_message(std::format("Video [{}]: {} frames dropped, {} late updates, decode latency avg {:.2f}ms max {:.2f}ms.",
+            i->path, i->droppedCount.load(), i->lateUpdatesCount.load(), average_decode_latency_ms(), max_decode_latency_ms()));
+    }
+}
+
+auto VideoDecoderExComponent::start_routine() -> void{
+    if(get<int>(ParametersContainer::Dynamic, "play_at_new_routine") == 1){
+        seek(0.);
+        play();
+    }
+}
+
+auto VideoDecoderExComponent::play() -> void{
+    if(!i->playing){
+        i->playStart        = steady_clock::now();
+        i->playStartVideoMs = i->pausedVideoMs;
+        i->playing          = true;
+    }
+}
+
+auto VideoDecoderExComponent::pause() -> void{
+    if(i->playing){
+        i->pausedVideoMs = video_time_ms();
+        i->playing       = false;
+    }
+}
+
+auto VideoDecoderExComponent::seek(double videoTimeMs) -> void{
+
+    videoTimeMs = std::max(videoTimeMs, 0.);
+    auto target = i->frame_index(videoTimeMs);
+    if(!i->loop && i->infos.framesCount > 0){
+        target = std::min(target, i->infos.framesCount - 1);
+    }
+
+    i->L.lock();
+    ++i->generation;
+    i->seekTarget    = target;
+    i->seekRequested = true;
+    i->toConvert.clear();
+    for(auto &slot : i->slots){
+        if(slot.state == SlotState::Ready){
+            slot.state = SlotState::Free;
+        }
+    }
+    // frames skipped by a seek are not dropped
+    i->displayedIndex = target - 1;
+    i->L.unlock();
+    i->slotsC.notify_all();
+    i->queueC.notify_all();
+
+    i->playStart        = steady_clock::now();
+    i->playStartVideoMs = videoTimeMs;
+    i->pausedVideoMs    = videoTimeMs;
+}
+
+auto VideoDecoderExComponent::update() -> void{
+
+    const auto target = i->frame_index(video_time_ms());
+
+    std::unique_lock<std::mutex> lock(i->L);
+
+    int selected = -1;
+    for(size_t ii = 0; ii < i->slots.size(); ++ii){
+        const auto &slot = i->slots[ii];
+        if(slot.state == SlotState::Ready && slot.generation == i->generation && slot.index <= target){
+            if(selected == -1 || slot.index > i->slots[selected].index){
+                selected = static_cast<int>(ii);
+            }
+        }
+    }
+
+    if(selected != -1){
+
+        const auto index = i->slots[selected].index;
+        // ready frames older than the selected one will never be displayed
+        for(auto &slot : i->slots){
+            if(slot.state == SlotState::Ready && (slot.generation != i->generation || slot.index < index)){
+                slot.state = SlotState::Free;
+            }
+        }
+        if(i->displayedSlot != -1 && i->displayedSlot != selected){
+            i->slots[i->displayedSlot].state = SlotState::Free;
+        }
+        if(index > i->displayedIndex + 1){
+            i->droppedCount += static_cast<size_t>(index - i->displayedIndex - 1);
+        }
+        i->slots[selected].state = SlotState::Displayed;
+        i->displayedSlot  = selected;
+        i->displayedIndex = index;
+    }
+
+    // the frame due is not decoded yet
+    if(i->displayedIndex < target && !i->decoderEnded){
+        ++i->lateUpdatesCount;
+    }
+
+    lock.unlock();
+    if(selected != -1){
+        i->slotsC.notify_all();
+    }
+}
+
+auto VideoDecoderExComponent::video_time_ms() const -> double{
+    if(!i->playing){
+        return i->pausedVideoMs;
+    }
+    return i->playStartVideoMs + duration<double, std::milli>(steady_clock::now() - i->playStart).count();
+}
+
+auto VideoDecoderExComponent::infos() const noexcept -> const VideoDecoderInfos&{
+    return i->infos;
+}
+
+auto VideoDecoderExComponent::current_frame_data() const noexcept -> const std::uint8_t*{
+    return i->displayedSlot != -1 ? i->slots[i->displayedSlot].data.data() : nullptr;
+}
+
+auto VideoDecoderExComponent::current_frame_index() const noexcept -> std::int64_t{
+    return i->displayedSlot != -1 ? i->slots[i->displayedSlot].index : -1;
+}
+
+auto VideoDecoderExComponent::ended() const noexcept -> bool{
+    std::lock_guard<std::mutex> lock(i->L);
+    return i->decoderEnded && std::none_of(i->slots.begin(), i->slots.end(), [](const auto &s){
+        return s.state == SlotState::Ready || s.state == SlotState::Writing;
+    }) && i->toConvert.empty();
+}
+
+auto VideoDecoderExComponent::decoded_frames_count() const noexcept -> size_t{
+    return i->decodedCount.load();
+}
+
+auto VideoDecoderExComponent::dropped_frames_count() const noexcept -> size_t{
+    return i->droppedCount.load();
+}
+
+auto VideoDecoderExComponent::late_updates_count() const noexcept -> size_t{
+    return i->lateUpdatesCount.load();
+}
+
+auto VideoDecoderExComponent::average_decode_latency_ms() const noexcept -> double{
+    std::lock_guard<std::mutex> lock(i->L);
+    return i->decodedCount > 0 ? i->latencySumMs / i->decodedCount : 0.;
+}
+
+auto VideoDecoderExComponent::max_decode_latency_ms() const noexcept -> double{
+    std::lock_guard<std::mutex> lock(i->L);
+    return i->latencyMaxMs;
+}
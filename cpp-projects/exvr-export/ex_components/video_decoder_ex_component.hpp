@@ -0,0 +1,80 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <cstdint>
+#include <memory>
+
+// base
+#include "exvr/ex_component.hpp"
+
+namespace tool::ex {
+
+struct VideoDecoderInfos{
+    int width = 0;
+    int height = 0;
+    double fps = 30.;
+    std::int64_t framesCount = 0;
+};
+
+// a decoder thread reads the video and a converter thread writes RGBA frames into a ring,
+// at each update the frame thread picks the last frame due at the current video time
+class VideoDecoderExComponent : public ExComponent{
+
+public:
+
+    VideoDecoderExComponent();
+    ~VideoDecoderExComponent() override;
+
+    auto initialize() -> bool override;
+    auto clean() -> void override;
+    auto start_experiment() -> void override;
+    auto stop_experiment() -> void override;
+    auto start_routine() -> void override;
+    auto play() -> void override;
+    auto pause() -> void override;
+    auto update() -> void override;
+
+    // frame accurate, the frame displayed at videoTimeMs is the first one decoded after the seek
+    auto seek(double videoTimeMs) -> void;
+    auto video_time_ms() const -> double;
+    auto infos() const noexcept -> const VideoDecoderInfos&;
+
+    // RGBA frame selected at the last update, valid until the next one
+    auto current_frame_data() const noexcept -> const std::uint8_t*;
+    auto current_frame_index() const noexcept -> std::int64_t;
+    auto ended() const noexcept -> bool;
+
+    auto decoded_frames_count() const noexcept -> size_t;
+    auto dropped_frames_count() const noexcept -> size_t;
+    auto late_updates_count() const noexcept -> size_t;
+    auto average_decode_latency_ms() const noexcept -> double;
+    auto max_decode_latency_ms() const noexcept -> double;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
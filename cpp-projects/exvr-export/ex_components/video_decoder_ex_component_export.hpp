@@ -0,0 +1,54 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// base
+#include "utility/export.hpp"
+
+// local
+#include "video_decoder_ex_component.hpp"
+
+extern "C"{
+
+    DECL_EXPORT tool::ex::VideoDecoderExComponent *create_video_decoder_ex_component();
+
+    DECL_EXPORT int get_width_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT int get_height_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT double get_fps_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT long long get_frames_count_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+
+    DECL_EXPORT void seek_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC, double videoTimeMs);
+    DECL_EXPORT double get_video_time_ms_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT int is_ended_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+
+    // RGBA frame selected at the last update, the pointer stays valid until the next update
+    DECL_EXPORT const unsigned char *get_frame_data_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT long long get_frame_index_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+
+    DECL_EXPORT long long get_decoded_frames_count_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT long long get_dropped_frames_count_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT long long get_late_updates_count_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT double get_average_decode_latency_ms_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+    DECL_EXPORT double get_max_decode_latency_ms_video_decoder_ex_component(tool::ex::VideoDecoderExComponent *vC);
+}
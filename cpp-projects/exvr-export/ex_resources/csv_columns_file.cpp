@@ -0,0 +1,780 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "csv_columns_file.hpp"
+
+// std
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <format>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define CSV_COLUMNS_FILE_SSE2
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace tool::ex;
+
+namespace {
+
+constexpr double invalidValue = std::numeric_limits<double>::quiet_NaN();
+constexpr size_t noRow = std::numeric_limits<size_t>::max();
+constexpr std::uint64_t poolFlag = std::uint64_t{1} << 63;
+constexpr size_t firstBucketSize = 64;
+constexpr size_t levelsFactor = 8;
+
+struct MappedFile{
+
+    const char *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    auto open(const std::string &path) -> bool{
+
+#ifdef _WIN32
+        // utf-8 path
+        const int wideSize = MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()), nullptr, 0);
+        std::wstring widePath(static_cast<size_t>(wideSize), L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, path.data(), static_cast<int>(path.size()), widePath.data(), wideSize);
+        file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if(file == INVALID_HANDLE_VALUE){
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        if(size == 0){
+            return true;
+        }
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping == nullptr){
+            return false;
+        }
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if(fd == -1){
+            return false;
+        }
+        struct stat infos;
+        if(fstat(fd, &infos) != 0){
+            return false;
+        }
+        size = static_cast<size_t>(infos.st_size);
+        if(size == 0){
+            return true;
+        }
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(address == MAP_FAILED){
+            return false;
+        }
+        madvise(address, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(address);
+#endif
+        return data != nullptr;
+    }
+
+    auto close() -> void{
+#ifdef _WIN32
+        if(data != nullptr){
+            UnmapViewOfFile(data);
+        }
+        if(mapping != nullptr){
+            CloseHandle(mapping);
+        }
+        if(file != INVALID_HANDLE_VALUE){
+            CloseHandle(file);
+        }
+        mapping = nullptr;
+        file    = INVALID_HANDLE_VALUE;
+#else
+        if(data != nullptr){
+            munmap(const_cast<char*>(data), size);
+        }
+        if(fd != -1){
+            ::close(fd);
+        }
+        fd = -1;
+#endif
+        data = nullptr;
+        size = 0;
+    }
+};
+
+// first occurrence of a or b in [p, end)
+auto find_any(const char *p, const char *end, char a, char b) noexcept -> const char*{
+#ifdef CSV_COLUMNS_FILE_SSE2
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    while(end - p >= 16){
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+        if(mask != 0){
+            return p + std::countr_zero(static_cast<unsigned int>(mask));
+        }
+        p += 16;
+    }
+#endif
+    while(p < end && *p != a && *p != b){
+        ++p;
+    }
+    return p;
+}
+
+auto trim(std::string_view text) noexcept -> std::string_view{
+    while(!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '\r')){
+        text.remove_prefix(1);
+    }
+    while(!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')){
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// empty cells are NaN
+auto parse_real(std::string_view cell, double &value) noexcept -> bool{
+    cell = trim(cell);
+    if(cell.empty()){
+        value = invalidValue;
+        return true;
+    }
+    if(cell.front() == '+'){
+        cell.remove_prefix(1);
+    }
+    const auto result = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+    return result.ec == std::errc() && result.ptr == cell.data() + cell.size();
+}
+
+struct Cell{
+    std::string_view text;
+    bool escaped = false;   /**< quoted cell containing doubled quotes */
+};
+
+// reads the cell at p and moves p after its separator or line break, returns false at the end of the line
+auto read_cell(const char *&p, const char *end, char separator, bool quotes, Cell &cell) noexcept -> bool{
+
+    if(quotes && p < end && *p == '"'){
+        const char *start = p + 1;
+        const char *q = start;
+        cell.escaped = false;
+        while(true){
+            q = static_cast<const char*>(std::memchr(q, '"', static_cast<size_t>(end - q)));
+            if(q == nullptr){
+                q = end;
+                break;
+            }
+            if(q + 1 < end && q[1] == '"'){
+                cell.escaped = true;
+                q += 2;
+                continue;
+            }
+            break;
+        }
+        cell.text = std::string_view(start, static_cast<size_t>(q - start));
+        p = find_any(std::min(q + 1, end), end, separator, '\n');
+    }else{
+        const char *q = find_any(p, end, separator, '\n');
+        cell.text    = std::string_view(p, static_cast<size_t>(q - p));
+        cell.escaped = false;
+        if(!cell.text.empty() && cell.text.back() == '\r'){
+            cell.text.remove_suffix(1);
+        }
+        p = q;
+    }
+
+    if(p < end && *p == separator){
+        ++p;
+        return true;
+    }
+    if(p < end){
+        ++p;
+    }
+    return false;
+}
+
+auto skip_empty_lines(const char *p, const char *end) noexcept -> const char*{
+    while(p < end && (*p == '\n' || (*p == '\r' && p + 1 < end && p[1] == '\n'))){
+        p += *p == '\n' ? 1 : 2;
+    }
+    return p;
+}
+
+auto unescape(std::string_view text) -> std::string{
+    std::string result;
+    result.reserve(text.size());
+    for(size_t ii = 0; ii < text.size(); ++ii){
+        result.push_back(text[ii]);
+        if(text[ii] == '"' && ii + 1 < text.size() && text[ii+1] == '"'){
+            ++ii;
+        }
+    }
+    return result;
+}
+
+struct TextCell{
+    std::uint64_t offset = 0;   /**< in the mapped file, or in the pool if poolFlag is set */
+    std::uint32_t size = 0;
+};
+
+struct MinMaxLevel{
+    size_t bucketSize = 0;
+    std::vector<double> minValues;
+    std::vector<double> maxValues;
+    std::vector<size_t> minRows;
+    std::vector<size_t> maxRows;
+};
+
+struct MinMax{
+
+    double minValue = std::numeric_limits<double>::infinity();
+    double maxValue = -std::numeric_limits<double>::infinity();
+    size_t minRow = noRow;
+    size_t maxRow = noRow;
+
+    // NaN values are ignored by the comparisons
+    auto add(double value, size_t row) noexcept -> void{
+        if(value < minValue){
+            minValue = value;
+            minRow   = row;
+        }
+        if(value > maxValue){
+            maxValue = value;
+            maxRow   = row;
+        }
+    }
+
+    auto merge(const MinMaxLevel &level, size_t idBucket) noexcept -> void{
+        if(level.minRows[idBucket] == noRow){
+            return;
+        }
+        if(level.minValues[idBucket] < minValue){
+            minValue = level.minValues[idBucket];
+            minRow   = level.minRows[idBucket];
+        }
+        if(level.maxValues[idBucket] > maxValue){
+            maxValue = level.maxValues[idBucket];
+            maxRow   = level.maxRows[idBucket];
+        }
+    }
+};
+
+auto add_level(MinMaxLevel &level, const MinMax &bucket) -> void{
+    level.minValues.push_back(bucket.minValue);
+    level.maxValues.push_back(bucket.maxValue);
+    level.minRows.push_back(bucket.minRow);
+    level.maxRows.push_back(bucket.maxRow);
+}
+
+// min/max of rows [rowStart, rowEnd) using the full buckets of the coarsest levels and the raw values at the edges
+auto range_min_max(const std::vector<double> &values, const std::vector<MinMaxLevel> &levels, int idLevel, size_t rowStart, size_t rowEnd, MinMax &result) noexcept -> void{
+
+    if(rowStart >= rowEnd){
+        return;
+    }
+    if(idLevel < 0){
+        for(size_t row = rowStart; row < rowEnd; ++row){
+            result.add(values[row], row);
+        }
+        return;
+    }
+
+    const auto &level = levels[idLevel];
+    const size_t firstBucket = (rowStart + level.bucketSize - 1) / level.bucketSize;
+    const size_t endBucket   = rowEnd / level.bucketSize;
+    if(firstBucket >= endBucket){
+        range_min_max(values, levels, idLevel - 1, rowStart, rowEnd, result);
+        return;
+    }
+
+    range_min_max(values, levels, idLevel - 1, rowStart, firstBucket*level.bucketSize, result);
+    for(size_t idBucket = firstBucket; idBucket < endBucket; ++idBucket){
+        result.merge(level, idBucket);
+    }
+    range_min_max(values, levels, idLevel - 1, endBucket*level.bucketSize, rowEnd, result);
+}
+
+auto lttb(const std::vector<double> &xs, const std::vector<double> &ys, size_t threshold, std::vector<double> &outXs, std::vector<double> &outYs) -> void{
+
+    const size_t count = xs.size();
+    if(count <= threshold || threshold < 3){
+        outXs = xs;
+        outYs = ys;
+        return;
+    }
+
+    outXs.push_back(xs.front());
+    outYs.push_back(ys.front());
+
+    const double every = static_cast<double>(count - 2) / static_cast<double>(threshold - 2);
+    size_t selected = 0;
+    for(size_t ii = 0; ii < threshold - 2; ++ii){
+
+        // average point of the next bucket
+        const size_t avgStart = static_cast<size_t>(std::floor((ii + 1) * every)) + 1;
+        const size_t avgEnd   = std::min(static_cast<size_t>(std::floor((ii + 2) * every)) + 1, count);
+        double avgX = 0.;
+        double avgY = 0.;
+        for(size_t jj = avgStart; jj < avgEnd; ++jj){
+            avgX += xs[jj];
+            avgY += ys[jj];
+        }
+        if(avgEnd > avgStart){
+            avgX /= static_cast<double>(avgEnd - avgStart);
+            avgY /= static_cast<double>(avgEnd - avgStart);
+        }else{
+            avgX = xs.back();
+            avgY = ys.back();
+        }
+
+        // point of the current bucket making the largest triangle with the previous selected point and the average
+        const size_t rangeStart = static_cast<size_t>(std::floor(ii * every)) + 1;
+        const size_t rangeEnd   = std::min(static_cast<size_t>(std::floor((ii + 1) * every)) + 1, count - 1);
+        double maxArea = -1.;
+        size_t next = rangeStart;
+        for(size_t jj = rangeStart; jj < rangeEnd; ++jj){
+            const double area = std::abs((xs[selected] - avgX) * (ys[jj] - ys[selected]) - (xs[selected] - xs[jj]) * (avgY - ys[selected]));
+            if(area > maxArea){
+                maxArea = area;
+                next    = jj;
+            }
+        }
+        outXs.push_back(xs[next]);
+        outYs.push_back(ys[next]);
+        selected = next;
+    }
+
+    outXs.push_back(xs.back());
+    outYs.push_back(ys.back());
+}
+}
+
+struct CsvColumnsFile::Impl{
+
+    MappedFile file;
+    std::string lastError;
+
+    char separator = ',';
+    size_t rowsCount = 0;
+    size_t invalidCells = 0;
+    std::vector<std::string> names;
+    std::vector<CsvColumnType> types;
+    std::vector<std::vector<double>> reals;
+    std::vector<std::vector<TextCell>> texts;
+    std::string pool;   /**< unescaped quoted cells */
+
+    size_t xColumn = rowsIndex;
+    bool indexBuilt = false;
+    std::vector<std::vector<MinMaxLevel>> pyramids;
+
+    auto detect_separator(const char *p, const char *end) const noexcept -> char{
+        const char *lineEnd = find_any(p, end, '\n', '\n');
+        const auto line = std::string_view(p, static_cast<size_t>(lineEnd - p));
+        const std::array<char,3> candidates = {',', ';', '\t'};
+        char best = 0;
+        size_t bestCount = 0;
+        for(const auto candidate : candidates){
+            const auto count = static_cast<size_t>(std::count(line.begin(), line.end(), candidate));
+            if(count > bestCount){
+                best      = candidate;
+                bestCount = count;
+            }
+        }
+        if(best == 0){
+            best = line.find(' ') != std::string_view::npos ? ' ' : ',';
+        }
+        return best;
+    }
+
+    auto add_text(size_t idColumn, const Cell &cell) -> void{
+        TextCell text;
+        if(cell.escaped){
+            const auto unescaped = unescape(cell.text);
+            text.offset = poolFlag | pool.size();
+            text.size   = static_cast<std::uint32_t>(unescaped.size());
+            pool += unescaped;
+        }else{
+            text.offset = static_cast<std::uint64_t>(cell.text.data() - file.data);
+            text.size   = static_cast<std::uint32_t>(cell.text.size());
+        }
+        texts[idColumn].push_back(text);
+    }
+
+    auto add_column() -> void{
+        names.push_back(std::format("column{}", names.size()));
+        types.push_back(CsvColumnType::Text);
+        reals.emplace_back();
+        texts.emplace_back(rowsCount);
+    }
+
+    auto parse(const CsvParseSettings &settings) -> bool{
+
+        const char *p   = file.data;
+        const char *end = file.data + file.size;
+        if(file.size >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0){
+            p += 3;
+        }
+        p = skip_empty_lines(p, end);
+        if(p == end){
+            lastError = "Empty file.";
+            return false;
+        }
+
+        separator = settings.separator != 0 ? settings.separator : detect_separator(p, end);
+
+        // columns from the first line
+        Cell cell;
+        std::vector<std::string> firstLine;
+        const char *dataStart = p;
+        for(bool more = true; more;){
+            more = read_cell(p, end, separator, settings.quotes, cell);
+            firstLine.emplace_back(trim(cell.escaped ? std::string_view(unescape(cell.text)) : cell.text));
+        }
+        if(settings.header){
+            names = std::move(firstLine);
+            dataStart = p;
+        }else{
+            names.clear();
+            for(size_t ii = 0; ii < firstLine.size(); ++ii){
+                names.push_back(std::format("column{}", ii));
+            }
+        }
+        size_t columnsCount = names.size();
+
+        // types from the first rows
+        types.assign(columnsCount, settings.inferTypes ? CsvColumnType::Real : CsvColumnType::Text);
+        p = skip_empty_lines(dataStart, end);
+        size_t inferredRows = 0;
+        for(; p < end && inferredRows < (settings.inferTypes ? settings.typeInferenceRows : 1); ++inferredRows){
+            size_t idColumn = 0;
+            for(bool more = true; more; ++idColumn){
+                more = read_cell(p, end, separator, settings.quotes, cell);
+                double value;
+                if(idColumn < columnsCount && (cell.escaped || !parse_real(cell.text, value))){
+                    types[idColumn] = CsvColumnType::Text;
+                }
+            }
+            p = skip_empty_lines(p, end);
+        }
+
+        reals.assign(columnsCount, {});
+        texts.assign(columnsCount, {});
+        const size_t inferredBytes = static_cast<size_t>(p - dataStart);
+        const size_t estimatedRows = inferredRows > 0 ? (file.size / std::max<size_t>(inferredBytes / inferredRows, 1)) + 16 : 16;
+        for(size_t ii = 0; ii < columnsCount; ++ii){
+            if(types[ii] == CsvColumnType::Real){
+                reals[ii].reserve(estimatedRows);
+            }else{
+                texts[ii].reserve(estimatedRows);
+            }
+        }
+
+        // rows
+        p = skip_empty_lines(dataStart, end);
+        rowsCount    = 0;
+        invalidCells = 0;
+        while(p < end){
+
+            size_t idColumn = 0;
+            for(bool more = true; more; ++idColumn){
+                more = read_cell(p, end, separator, settings.quotes, cell);
+                if(idColumn == columnsCount){
+                    add_column();
+                    ++columnsCount;
+                }
+                if(types[idColumn] == CsvColumnType::Real){
+                    double value;
+                    if(cell.escaped || !parse_real(cell.text, value)){
+                        value = invalidValue;
+                        ++invalidCells;
+                    }
+                    reals[idColumn].push_back(value);
+                }else{
+                    add_text(idColumn, cell);
+                }
+            }
+
+            // missing cells
+            for(; idColumn < columnsCount; ++idColumn){
+                if(types[idColumn] == CsvColumnType::Real){
+                    reals[idColumn].push_back(invalidValue);
+                }else{
+                    texts[idColumn].push_back({});
+                }
+            }
+            ++rowsCount;
+            p = skip_empty_lines(p, end);
+        }
+        return true;
+    }
+};
+
+CsvColumnsFile::CsvColumnsFile() : i(std::make_unique<Impl>()){
+}
+
+CsvColumnsFile::~CsvColumnsFile(){
+    close();
+}
+
+auto CsvColumnsFile::open(const std::string &path, const CsvParseSettings &settings) -> bool{
+
+    close();
+    if(!i->file.open(path)){
+        i->lastError = std::format("Cannot open file [{}].", path);
+        close();
+        return false;
+    }
+    if(!i->parse(settings)){
+        close();
+        return false;
+    }
+    return true;
+}
+
+auto CsvColumnsFile::close() -> void{
+    i->file.close();
+    i->rowsCount    = 0;
+    i->invalidCells = 0;
+    i->names.clear();
+    i->types.clear();
+    i->reals.clear();
+    i->texts.clear();
+    i->pool.clear();
+    i->pyramids.clear();
+    i->indexBuilt = false;
+}
+
+auto CsvColumnsFile::last_error() const -> const std::string&{
+    return i->lastError;
+}
+
+auto CsvColumnsFile::separator() const noexcept -> char{
+    return i->separator;
+}
+
+auto CsvColumnsFile::rows_count() const noexcept -> size_t{
+    return i->rowsCount;
+}
+
+auto CsvColumnsFile::columns_count() const noexcept -> size_t{
+    return i->names.size();
+}
+
+auto CsvColumnsFile::column_name(size_t idColumn) const -> const std::string&{
+    return i->names[idColumn];
+}
+
+auto CsvColumnsFile::column_type(size_t idColumn) const -> CsvColumnType{
+    return i->types[idColumn];
+}
+
+auto CsvColumnsFile::invalid_cells_count() const noexcept -> size_t{
+    return i->invalidCells;
+}
+
+auto CsvColumnsFile::reals(size_t idColumn) const -> std::span<const double>{
+    return i->reals[idColumn];
+}
+
+auto CsvColumnsFile::text(size_t idColumn, size_t idRow) const -> std::string_view{
+    if(i->types[idColumn] != CsvColumnType::Text){
+        return {};
+    }
+    const auto &cell = i->texts[idColumn][idRow];
+    if((cell.offset & poolFlag) != 0){
+        return std::string_view(i->pool.data() + (cell.offset & ~poolFlag), cell.size);
+    }
+    return std::string_view(i->file.data + cell.offset, cell.size);
+}
+
+auto CsvColumnsFile::build_decimation_index(size_t xColumn) -> bool{
+
+    i->indexBuilt = false;
+    i->pyramids.clear();
+
+    if(xColumn != rowsIndex){
+        if(xColumn >= columns_count() || i->types[xColumn] != CsvColumnType::Real){
+            i->lastError = std::format("Invalid x column {}.", xColumn);
+            return false;
+        }
+        const auto &xs = i->reals[xColumn];
+        if(!std::is_sorted(xs.begin(), xs.end()) || std::any_of(xs.begin(), xs.end(), [](double x){return std::isnan(x);})){
+            i->lastError = std::format("Column [{}] is not ascending.", i->names[xColumn]);
+            return false;
+        }
+    }
+    i->xColumn = xColumn;
+
+    i->pyramids.resize(columns_count());
+    for(size_t idColumn = 0; idColumn < columns_count(); ++idColumn){
+
+        if(i->types[idColumn] != CsvColumnType::Real){
+            continue;
+        }
+
+        const auto &values = i->reals[idColumn];
+        auto &levels = i->pyramids[idColumn];
+
+        // first level from the values, next ones from the previous level
+        MinMaxLevel first;
+        first.bucketSize = firstBucketSize;
+        for(size_t start = 0; start < values.size(); start += firstBucketSize){
+            MinMax bucket;
+            const size_t end = std::min(start + firstBucketSize, values.size());
+            for(size_t row = start; row < end; ++row){
+                bucket.add(values[row], row);
+            }
+            add_level(first, bucket);
+        }
+        levels.push_back(std::move(first));
+
+        while(levels.back().minValues.size() > levelsFactor){
+            const auto &previous = levels.back();
+            MinMaxLevel level;
+            level.bucketSize = previous.bucketSize * levelsFactor;
+            for(size_t start = 0; start < previous.minValues.size(); start += levelsFactor){
+                MinMax bucket;
+                const size_t end = std::min(start + levelsFactor, previous.minValues.size());
+                for(size_t idBucket = start; idBucket < end; ++idBucket){
+                    bucket.merge(previous, idBucket);
+                }
+                add_level(level, bucket);
+            }
+            levels.push_back(std::move(level));
+        }
+    }
+
+    i->indexBuilt = true;
+    return true;
+}
+
+auto CsvColumnsFile::x_column() const noexcept -> size_t{
+    return i->xColumn;
+}
+
+auto CsvColumnsFile::decimate(size_t yColumn, double xMin, double xMax, size_t maxPoints, CsvDecimation mode, std::vector<double> &xs, std::vector<double> &ys) const -> size_t{
+
+    xs.clear();
+    ys.clear();
+    if(!i->indexBuilt || yColumn >= columns_count() || i->types[yColumn] != CsvColumnType::Real || xMax < xMin || maxPoints < 4){
+        return 0;
+    }
+
+    // rows range
+    size_t rowStart = 0;
+    size_t rowEnd   = 0;
+    if(i->xColumn == rowsIndex){
+        rowStart = static_cast<size_t>(std::clamp(std::ceil(xMin), 0., static_cast<double>(rows_count())));
+        rowEnd   = static_cast<size_t>(std::clamp(std::floor(xMax) + 1., 0., static_cast<double>(rows_count())));
+    }else{
+        const auto &x = i->reals[i->xColumn];
+        rowStart = static_cast<size_t>(std::lower_bound(x.begin(), x.end(), xMin) - x.begin());
+        rowEnd   = static_cast<size_t>(std::upper_bound(x.begin(), x.end(), xMax) - x.begin());
+    }
+    if(rowEnd <= rowStart){
+        return 0;
+    }
+
+    const auto &y      = i->reals[yColumn];
+    const auto &levels = i->pyramids[yColumn];
+    auto x_at = [&](size_t row){
+        return i->xColumn == rowsIndex ? static_cast<double>(row) : i->reals[i->xColumn][row];
+    };
+
+    const size_t count = rowEnd - rowStart;
+    if(count <= maxPoints){
+        for(size_t row = rowStart; row < rowEnd; ++row){
+            if(!std::isnan(y[row])){
+                xs.push_back(x_at(row));
+                ys.push_back(y[row]);
+            }
+        }
+        return xs.size();
+    }
+
+    // min and max of each bucket, in rows order
+    auto min_max_points = [&](size_t bucketsCount, std::vector<double> &bXs, std::vector<double> &bYs){
+        for(size_t idBucket = 0; idBucket < bucketsCount; ++idBucket){
+            MinMax bucket;
+            range_min_max(y, levels, static_cast<int>(levels.size()) - 1, rowStart + idBucket*count/bucketsCount, rowStart + (idBucket+1)*count/bucketsCount, bucket);
+            if(bucket.minRow == noRow){
+                continue;
+            }
+            const size_t first  = std::min(bucket.minRow, bucket.maxRow);
+            const size_t second = std::max(bucket.minRow, bucket.maxRow);
+            bXs.push_back(x_at(first));
+            bYs.push_back(y[first]);
+            if(second != first){
+                bXs.push_back(x_at(second));
+                bYs.push_back(y[second]);
+            }
+        }
+    };
+
+    if(mode == CsvDecimation::MinMax){
+        min_max_points(maxPoints / 2, xs, ys);
+        return xs.size();
+    }
+
+    // LTTB on the raw points or on a finer min/max decimation for large ranges
+    std::vector<double> sourceXs;
+    std::vector<double> sourceYs;
+    if(count > 4 * maxPoints){
+        // keeps the range bounds
+        auto add_bound = [&](size_t row){
+            if(!std::isnan(y[row]) && (sourceXs.empty() || sourceXs.back() != x_at(row))){
+                sourceXs.push_back(x_at(row));
+                sourceYs.push_back(y[row]);
+            }
+        };
+        add_bound(rowStart);
+        min_max_points(2 * maxPoints, sourceXs, sourceYs);
+        add_bound(rowEnd - 1);
+    }else{
+        for(size_t row = rowStart; row < rowEnd; ++row){
+            if(!std::isnan(y[row])){
+                sourceXs.push_back(x_at(row));
+                sourceYs.push_back(y[row]);
+            }
+        }
+    }
+    lttb(sourceXs, sourceYs, maxPoints, xs, ys);
+    return xs.size();
+}
@@ -0,0 +1,94 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tool::ex {
+
+enum class CsvColumnType : int{
+    Real = 0,   /**< empty or invalid cells are NaN */
+    Text
+};
+
+enum class CsvDecimation : int{
+    MinMax = 0, /**< min and max of each bucket, keeps every peak */
+    LTTB        /**< largest triangle three buckets, keeps the visual shape */
+};
+
+struct CsvParseSettings{
+    char separator = 0;             /**< detected from the first line if 0 (, ; tab or space) */
+    bool header = true;             /**< columns names from the first line */
+    bool inferTypes = true;         /**< every column is text otherwise */
+    size_t typeInferenceRows = 100; /**< columns are real if every non-empty cell of the first rows is a number */
+    bool quotes = true;             /**< cells starting with a quote are quoted cells, kept as is otherwise */
+};
+
+// memory mapped CSV file parsed into typed columns, the path is utf-8,
+// quoted cells are supported but not line breaks inside them,
+// rows longer than the first line add text columns
+class CsvColumnsFile{
+
+public:
+
+    static constexpr size_t rowsIndex = std::numeric_limits<size_t>::max();
+
+    CsvColumnsFile();
+    ~CsvColumnsFile();
+
+    auto open(const std::string &path, const CsvParseSettings &settings = {}) -> bool;
+    auto close() -> void;
+    auto last_error() const -> const std::string&;
+
+    auto separator() const noexcept -> char;
+    auto rows_count() const noexcept -> size_t;
+    auto columns_count() const noexcept -> size_t;
+    auto column_name(size_t idColumn) const -> const std::string&;
+    auto column_type(size_t idColumn) const -> CsvColumnType;
+    auto invalid_cells_count() const noexcept -> size_t;
+
+    // empty for text columns
+    auto reals(size_t idColumn) const -> std::span<const double>;
+    // empty for real columns, the view is valid while the file is opened
+    auto text(size_t idColumn, size_t idRow) const -> std::string_view;
+
+    // min/max pyramids of every real column, x values are read from xColumn (must be ascending) or are the rows indices (rowsIndex)
+    auto build_decimation_index(size_t xColumn) -> bool;
+    auto x_column() const noexcept -> size_t;
+    // at most maxPoints (>= 4) (x,y) points of yColumn for x in [xMin, xMax], all points if they fit
+    auto decimate(size_t yColumn, double xMin, double xMax, size_t maxPoints, CsvDecimation mode, std::vector<double> &xs, std::vector<double> &ys) const -> size_t;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> i;
+};
+}
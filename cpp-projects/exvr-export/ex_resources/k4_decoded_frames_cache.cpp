@@ -0,0 +1,109 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "k4_decoded_frames_cache.hpp"
+
+using namespace tool::ex;
+
+size_t K4DecodedFrame::bytes() const noexcept{
+    return sizeof(K4DecodedFrame) +
+        vertices.capacity()*sizeof(geo::Pt3f) +
+        colorsF.capacity()*sizeof(geo::Pt4f) +
+        colorsI.capacity()*sizeof(geo::Pt4<std::uint8_t>) +
+        mesh.capacity()*sizeof(camera::K4VertexMeshData);
+}
+
+std::shared_ptr<const K4DecodedFrame> K4DecodedFramesCache::get(size_t idCamera, size_t idFrame, K4DecodedFrameFormat format){
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto it = m_entries.find(key(idCamera, idFrame, format));
+    if(it == m_entries.end()){
+        ++m_misses;
+        return nullptr;
+    }
+
+    ++m_hits;
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->frame;
+}
+
+void K4DecodedFramesCache::insert(size_t idCamera, size_t idFrame, K4DecodedFrameFormat format, std::shared_ptr<const K4DecodedFrame> frame){
+
+    const size_t size = frame->bytes();
+    std::lock_guard<std::mutex> guard(m_lock);
+    if(size > m_budget){
+        return;
+    }
+
+    const auto k = key(idCamera, idFrame, format);
+    if(auto it = m_entries.find(k); it != m_entries.end()){
+        // already decoded by another component
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return;
+    }
+
+    m_lru.push_front(Entry{k, std::move(frame)});
+    m_entries[k] = m_lru.begin();
+    m_used += size;
+    evict();
+}
+
+void K4DecodedFramesCache::set_budget(size_t budgetBytes){
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_budget = budgetBytes;
+    evict();
+}
+
+void K4DecodedFramesCache::clear(){
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_lru.clear();
+    m_entries.clear();
+    m_used = 0;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+size_t K4DecodedFramesCache::budget() const{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_budget;
+}
+
+size_t K4DecodedFramesCache::used_bytes() const{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_used;
+}
+
+size_t K4DecodedFramesCache::count() const{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_entries.size();
+}
+
+void K4DecodedFramesCache::evict(){
+
+    // frames still used by a component stay alive through their shared pointer
+    while(m_used > m_budget && !m_lru.empty()){
+        m_used -= m_lru.back().frame->bytes();
+        m_entries.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+}
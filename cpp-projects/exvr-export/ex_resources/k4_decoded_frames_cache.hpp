@@ -0,0 +1,100 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// std
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// base
+#include "geometry/point3.hpp"
+#include "geometry/point4.hpp"
+#include "camera/kinect4/k4_volumetric_video.hpp"
+
+namespace tool::ex {
+
+enum class K4DecodedFrameFormat : std::uint8_t{
+    C4F, C3I, VMD
+};
+
+// decoded frame data, only the buffers of its format are filled
+struct K4DecodedFrame{
+    size_t verticesCount = 0;
+    std::vector<geo::Pt3f> vertices;
+    std::vector<geo::Pt4f> colorsF;
+    std::vector<geo::Pt4<std::uint8_t>> colorsI;
+    std::vector<camera::K4VertexMeshData> mesh;
+
+    size_t bytes() const noexcept;
+};
+
+// LRU cache of decoded frames shared by every component using the same resource
+// the budget is shared by all the cameras of the video, with ~200k valid vertices per frame (NFOV unbinned depth):
+// - C4F (Pt3f + Pt4f, 28 bytes per vertex): ~5.6 MB per frame, the 512 MB default holds ~90 frames, ~3s at 30 fps for one camera
+// - C3I and VMD (16 bytes per vertex): ~3.2 MB per frame, ~160 frames, ~5.3s at 30 fps for one camera
+// divide these durations by the cameras count, a loop longer than the budget is decoded at each pass (sequential access evicts the next frames)
+class K4DecodedFramesCache{
+public:
+
+    K4DecodedFramesCache(size_t budgetBytes = 512*1024*1024) : m_budget(budgetBytes){}
+
+    std::shared_ptr<const K4DecodedFrame> get(size_t idCamera, size_t idFrame, K4DecodedFrameFormat format);
+    void insert(size_t idCamera, size_t idFrame, K4DecodedFrameFormat format, std::shared_ptr<const K4DecodedFrame> frame);
+
+    void set_budget(size_t budgetBytes);
+    void clear();
+
+    size_t budget() const;
+    size_t used_bytes() const;
+    size_t count() const;
+    inline size_t hits() const noexcept{return m_hits.load();}
+    inline size_t misses() const noexcept{return m_misses.load();}
+
+private:
+
+    void evict();
+
+    static constexpr std::uint64_t key(size_t idCamera, size_t idFrame, K4DecodedFrameFormat format) noexcept{
+        return (static_cast<std::uint64_t>(idCamera) << 40) | (static_cast<std::uint64_t>(idFrame) << 8) | static_cast<std::uint64_t>(format);
+    }
+
+    struct Entry{
+        std::uint64_t key;
+        std::shared_ptr<const K4DecodedFrame> frame;
+    };
+
+    mutable std::mutex m_lock;
+    std::list<Entry> m_lru; /**< most recently used first */
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> m_entries;
+    size_t m_budget;
+    size_t m_used = 0;
+
+    std::atomic<size_t> m_hits = 0;
+    std::atomic<size_t> m_misses = 0;
+};
+}
@@ -28,13 +28,18 @@
 #include "exvr/ex_resource.hpp"
 #include "camera/kinect4/k4_volumetric_video.hpp"
 
+// local
+#include "k4_decoded_frames_cache.hpp"
+
 namespace tool::ex {
 
 class K4VolumetricVideoExResource : public ExResource{
 public:
     tool::camera::K4VolumetricVideo video;
+    K4DecodedFramesCache framesCache; /**< decoded frames shared by every component using this resource */
 
     bool initialize() override{
+        framesCache.clear();
         return video.load_from_file(get<std::string>(ParametersContainer::Dynamic, "path_file"));
     }
 };
@@ -25,6 +25,9 @@
 
 #include "k4_volumetric_video_ex_resource_export.hpp"
 
+// std
+#include <algorithm>
+
 using namespace tool::ex;
 using namespace tool::geo;
 using namespace tool::camera;
@@ -64,3 +67,19 @@ int get_valid_vertices_count_k4_volumetric_video_ex_resource(K4VolumetricVideoEx
 int get_audio_data_total_size_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR, int idC){
     return static_cast<int>(vvR->video.total_audio_frames_size(idC));
 }
+
+void set_frames_cache_budget_k4_volumetric_video_ex_resource(K4VolumetricVideoExResource *vvR, int budgetMB){
+    vvR->framesCache.set_budget(static_cast<size_t>(std::max(budgetMB, 0))*1024*1024);
+}
+
+int get_frames_cache_count_k4_volumetric_video_ex_resource(K4VolumetricVideoExResource *vvR){
+    return static_cast<int>(vvR->framesCache.count());
+}
+
+long long get_frames_cache_hits_k4_volumetric_video_ex_resource(K4VolumetricVideoExResource *vvR){
+    return static_cast<long long>(vvR->framesCache.hits());
+}
+
+long long get_frames_cache_misses_k4_volumetric_video_ex_resource(K4VolumetricVideoExResource *vvR){
+    return static_cast<long long>(vvR->framesCache.misses());
+}
@@ -40,4 +40,8 @@ extern "C"{
     DECL_EXPORT int get_id_frame_from_time_ms_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR, int idC, float timeMs);
     DECL_EXPORT int get_valid_vertices_count_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR, int idC, int idF);
     DECL_EXPORT int get_audio_data_total_size_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR, int idC);
+    DECL_EXPORT void set_frames_cache_budget_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR, int budgetMB);
+    DECL_EXPORT int get_frames_cache_count_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR);
+    DECL_EXPORT long long get_frames_cache_hits_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR);
+    DECL_EXPORT long long get_frames_cache_misses_k4_volumetric_video_ex_resource(tool::ex::K4VolumetricVideoExResource *vvR);
 }
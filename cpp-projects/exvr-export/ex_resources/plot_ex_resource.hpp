@@ -0,0 +1,55 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// base
+#include "exvr/ex_resource.hpp"
+
+// local
+#include "csv_columns_file.hpp"
+
+namespace tool::ex {
+
+class PlotExResource : public ExResource{
+public:
+    CsvColumnsFile file;
+
+    // x values are read from the first real column if it is ascending, from the rows indices otherwise
+    bool initialize() override{
+        if(!file.open(get<std::string>(ParametersContainer::Dynamic, "path_file"))){
+            log_error(file.last_error());
+            return false;
+        }
+        for(size_t idColumn = 0; idColumn < file.columns_count(); ++idColumn){
+            if(file.column_type(idColumn) == CsvColumnType::Real){
+                if(file.build_decimation_index(idColumn)){
+                    return true;
+                }
+                break;
+            }
+        }
+        return file.build_decimation_index(CsvColumnsFile::rowsIndex);
+    }
+};
+}
@@ -0,0 +1,82 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "plot_ex_resource_export.hpp"
+
+// std
+#include <algorithm>
+
+using namespace tool::ex;
+
+PlotExResource *create_plot_ex_resource(){
+    return new PlotExResource();
+}
+
+int get_rows_count_plot_ex_resource(PlotExResource *pR){
+    return static_cast<int>(pR->file.rows_count());
+}
+
+int get_columns_count_plot_ex_resource(PlotExResource *pR){
+    return static_cast<int>(pR->file.columns_count());
+}
+
+const char *get_column_name_plot_ex_resource(PlotExResource *pR, int idColumn){
+    return pR->file.column_name(idColumn).c_str();
+}
+
+int get_column_type_plot_ex_resource(PlotExResource *pR, int idColumn){
+    return static_cast<int>(pR->file.column_type(idColumn));
+}
+
+int get_x_column_plot_ex_resource(PlotExResource *pR){
+    if(pR->file.x_column() == CsvColumnsFile::rowsIndex){
+        return -1;
+    }
+    return static_cast<int>(pR->file.x_column());
+}
+
+int copy_column_plot_ex_resource(PlotExResource *pR, int idColumn, double *values, int maxCount){
+    const auto column = pR->file.reals(idColumn);
+    const auto count  = std::min(column.size(), static_cast<size_t>(std::max(maxCount, 0)));
+    std::copy_n(column.begin(), count, values);
+    return static_cast<int>(count);
+}
+
+int copy_text_cell_plot_ex_resource(PlotExResource *pR, int idColumn, int idRow, char *text, int maxSize){
+    const auto cell  = pR->file.text(idColumn, idRow);
+    const auto count = std::min(cell.size(), static_cast<size_t>(std::max(maxSize, 0)));
+    std::copy_n(cell.begin(), count, text);
+    return static_cast<int>(count);
+}
+
+int decimate_plot_ex_resource(PlotExResource *pR, int yColumn, double xMin, double xMax, int maxPoints, int mode, double *xs, double *ys){
+
+    std::vector<double> decimatedXs;
+    std::vector<double> decimatedYs;
+    const auto count = pR->file.decimate(
+        yColumn, xMin, xMax, static_cast<size_t>(std::max(maxPoints, 0)), static_cast<CsvDecimation>(mode), decimatedXs, decimatedYs
+    );
+    std::copy(decimatedXs.begin(), decimatedXs.end(), xs);
+    std::copy(decimatedYs.begin(), decimatedYs.end(), ys);
+    return static_cast<int>(count);
+}
@@ -0,0 +1,43 @@
+/***********************************************************************************
+** exvr-export                                                                    **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// base
+#include "utility/export.hpp"
+
+// local
+#include "plot_ex_resource.hpp"
+
+extern "C"{
+
+    DECL_EXPORT tool::ex::PlotExResource *create_plot_ex_resource();
+    DECL_EXPORT int get_rows_count_plot_ex_resource(tool::ex::PlotExResource *pR);
+    DECL_EXPORT int get_columns_count_plot_ex_resource(tool::ex::PlotExResource *pR);
+    DECL_EXPORT const char *get_column_name_plot_ex_resource(tool::ex::PlotExResource *pR, int idColumn);
+    DECL_EXPORT int get_column_type_plot_ex_resource(tool::ex::PlotExResource *pR, int idColumn);
+    DECL_EXPORT int get_x_column_plot_ex_resource(tool::ex::PlotExResource *pR);
+    DECL_EXPORT int copy_column_plot_ex_resource(tool::ex::PlotExResource *pR, int idColumn, double *values, int maxCount);
+    DECL_EXPORT int copy_text_cell_plot_ex_resource(tool::ex::PlotExResource *pR, int idColumn, int idRow, char *text, int maxSize);
+    DECL_EXPORT int decimate_plot_ex_resource(tool::ex::PlotExResource *pR, int yColumn, double xMin, double xMax, int maxPoints, int mode, double *xs, double *ys);
+}
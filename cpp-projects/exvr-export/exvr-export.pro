@@ -100,7 +100,13 @@ LIBS +=  \
 
 HEADERS += \
     # ex_components
+    ex_components/biopac_device.hpp \
+    ex_components/biopac_ex_component.hpp \
+    ex_components/biopac_ex_component_export.hpp \
+    ex_components/cloud_decimation.hpp \
+    ex_components/cloud_fusion.hpp \
     ex_components/ex_component_export.hpp \
+    ex_components/frames_synchronizer.hpp \
     # ex_resources
     ex_components/k2_manager_ex_component.hpp \
     ex_components/k2_manager_ex_component_export.hpp \
@@ -108,20 +114,43 @@ HEADERS += \
     ex_components/k4_manager_ex_component_export.hpp \
     ex_components/k4_volumetric_video_ex_component.hpp \
     ex_components/k4_volumetric_video_ex_component_export.hpp \
+    ex_components/logger_columnar_file.hpp \
+    ex_components/logger_ex_component.hpp \
+    ex_components/logger_ex_component_export.hpp \
+    ex_components/messages_queue.hpp \
     ex_components/python_script_ex_component.hpp \
     ex_components/python_script_ex_component_export.hpp \
+    ex_components/serial_port.hpp \
+    ex_components/serial_port_reader_ex_component.hpp \
+    ex_components/serial_port_reader_ex_component_export.hpp \
+    ex_components/udp_reader_ex_component.hpp \
+    ex_components/udp_reader_ex_component_export.hpp \
+    ex_components/udp_socket.hpp \
+    ex_components/udp_writer_ex_component.hpp \
+    ex_components/udp_writer_ex_component_export.hpp \
+    ex_components/video_decoder_ex_component.hpp \
+    ex_components/video_decoder_ex_component_export.hpp \
     ex_components/video_saver_ex_component.hpp \
     ex_components/video_saver_ex_component_export.hpp \
     ex_element_export.hpp \
     ex_experiment_export.hpp \
+    ex_resources/csv_columns_file.hpp \
     ex_resources/ex_resource_export.hpp \
     ex_resources/k2_volumetric_video_ex_resource.hpp \
     ex_resources/k2_volumetric_video_ex_resource_export.hpp \
+    ex_resources/k4_decoded_frames_cache.hpp \
     ex_resources/k4_volumetric_video_ex_resource.hpp \
-    ex_resources/k4_volumetric_video_ex_resource_export.hpp
+    ex_resources/k4_volumetric_video_ex_resource_export.hpp \
+    ex_resources/plot_ex_resource.hpp \
+    ex_resources/plot_ex_resource_export.hpp
 
 SOURCES += \
     # ex_components
+    ex_components/biopac_device.cpp \
+    ex_components/biopac_ex_component.cpp \
+    ex_components/biopac_ex_component_export.cpp \
+    ex_components/cloud_decimation.cpp \
+    ex_components/cloud_fusion.cpp \
     ex_components/ex_component_export.cpp \
     # ex_resources
     ex_components/k2_manager_ex_component.cpp \
@@ -129,15 +158,32 @@ SOURCES += \
     ex_components/k4_manager_ex_component.cpp \
     ex_components/k4_manager_ex_component_export.cpp \
     ex_components/k4_volumetric_video_ex_component_export.cpp \
+    ex_components/logger_columnar_file.cpp \
+    ex_components/logger_ex_component.cpp \
+    ex_components/logger_ex_component_export.cpp \
+    ex_components/messages_queue.cpp \
     ex_components/python_script_ex_component.cpp \
     ex_components/python_script_ex_component_export.cpp \
+    ex_components/serial_port.cpp \
+    ex_components/serial_port_reader_ex_component.cpp \
+    ex_components/serial_port_reader_ex_component_export.cpp \
+    ex_components/udp_reader_ex_component.cpp \
+    ex_components/udp_reader_ex_component_export.cpp \
+    ex_components/udp_socket.cpp \
+    ex_components/udp_writer_ex_component.cpp \
+    ex_components/udp_writer_ex_component_export.cpp \
+    ex_components/video_decoder_ex_component.cpp \
+    ex_components/video_decoder_ex_component_export.cpp \
     ex_components/video_saver_ex_component.cpp \
     ex_components/video_saver_ex_component_export.cpp \
     ex_element_export.cpp \
     ex_experiment_export.cpp \
+    ex_resources/csv_columns_file.cpp \
     ex_resources/ex_resource_export.cpp \
     # main    
     ex_resources/k2_volumetric_video_ex_resource.cpp \
     ex_resources/k2_volumetric_video_ex_resource_export.cpp \
+    ex_resources/k4_decoded_frames_cache.cpp \
     ex_resources/k4_volumetric_video_ex_resource_export.cpp \
+    ex_resources/plot_ex_resource_export.cpp \
 
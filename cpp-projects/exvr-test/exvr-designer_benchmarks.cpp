@@ -0,0 +1,537 @@
+/***********************************************************************************
+** exvr-test                                                                      **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+// std
+#include <cmath>
+#include <unordered_set>
+
+// Qt
+#include <QImage>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+// base
+#include "thirdparty/catch/catch.hpp"
+#include "utility/benchmark.hpp"
+
+// qt-utility
+#include "qt_logger.hpp"
+
+// exvr-designer
+#include "experiment/experiment.hpp"
+#include "IO/xml_io_manager.hpp"
+#include "IO/binary_experiment_file.hpp"
+#include "gui/objects/flow_sequence_object.hpp"
+#include "experiment/simulator.hpp"
+#include "gui/widgets/connections/connections_graph_plan.hpp"
+#include "gui/widgets/connections/data_models/data/nodes_data_converters.hpp"
+
+// exvr-export
+#include "ex_resources/csv_columns_file.hpp"
+
+// local
+#include "synthetic_experiment.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+// benchmarks are hidden by default, run them with: exvr-test "[benchmark]"
+
+TEST_CASE("Flow diagram", "[.][benchmark]"){
+
+    Experiment exp("1.0");
+    generate_synthetic_experiment(exp, flow_blocks_settings(150));
+    QtLogger::message(QSL("Flow elements: ") % QString::number(exp.elements.size()) % QSL(" loops: ") % QString::number(exp.loops.size()));
+
+    FlowSequenceO flow;
+    QFont font;
+    font.setPointSizeF(FlowElementO::sizeTxt*3.0);
+    QFontMetrics fm(font);
+
+    Bench::start("[Flow: update from experiment]"sv, false);
+    flow.update_from_experiment(&exp);
+    Bench::stop();
+
+    // first layout computes text metrics, next ones only use the cache
+    QSizeF size;
+    Bench::start("[Flow: first layout]"sv, false);
+    size = flow.compute_layout(fm, 3.0, exp.states.maximumDeepLevel);
+    Bench::stop();
+    for(int ii = 0; ii < 20; ++ii){
+        Bench::start("[Flow: cached layout]"sv, false);
+        size = flow.compute_layout(fm, 3.0, exp.states.maximumDeepLevel);
+        Bench::stop();
+    }
+    REQUIRE(size.width() > 0.);
+
+    SECTION("Hit testing"){
+        for(int jj = 0; jj < 10; ++jj){
+            Bench::start("[Flow: hit test all elements]"sv, false);
+            for(const auto &element : flow.elements){
+                REQUIRE(flow.mouse_on_element(element->uiElemRect.center().toPoint()) == element.get());
+            }
+            for(const auto &loop : flow.loopsElements){
+                REQUIRE(flow.mouse_on_loop(loop->uiElemRect.center().toPoint()) == loop.get());
+            }
+            Bench::stop();
+        }
+    }
+
+    SECTION("Painting"){
+
+        // viewport of a typical scroll area
+        QImage image(1600, 400, QImage::Format_ARGB32_Premultiplied);
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setFont(font);
+
+        for(int ii = 0; ii < 10; ++ii){
+            Bench::start("[Flow: draw whole sequence]"sv, false);
+            flow.draw(painter, 3.0, QRectF(QPointF(0.,0.), size));
+            Bench::stop();
+
+            const qreal x = (size.width() - image.width()) * ii / 10.;
+            painter.resetTransform();
+            painter.translate(-x, 0.);
+            Bench::start("[Flow: draw exposed region]"sv, false);
+            flow.draw(painter, 3.0, QRectF(QPointF(x,0.), QSizeF(image.size())));
+            Bench::stop();
+        }
+    }
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("Simulator", "[.][benchmark]"){
+
+    Experiment exp("1.0");
+    generate_synthetic_experiment(exp, flow_blocks_settings(1));
+
+    // 100x100 iterations of { routine, isi, routine } with short conditions
+    for(const auto &loop : exp.loops){
+        loop->set_nb_reps(100);
+    }
+    for(auto routine : exp.get_elements_from_type<Routine>()){
+        for(auto &condition : routine->conditions){
+            condition->duration = SecondsTS{0.5};
+        }
+    }
+
+    Bench::start("[Simulator: generate instance]"sv, false);
+    auto instance = Instance::generate_from_full_experiment(&exp.randomizer, exp, 0);
+    Bench::stop();
+    REQUIRE(instance != nullptr);
+
+    Simulator simulator;
+    SimReport report;
+    Bench::start("[Simulator: run]"sv, false);
+    report = simulator.run(*instance);
+    Bench::stop();
+
+    REQUIRE(report.elements.size() == instance->flow.size());
+    QtLogger::message(QSL("Simulated elements: ") % QString::number(report.elements.size()) %
+        QSL(" frames: ") % QString::number(report.frames) %
+        QSL(" virtual duration: ") % QString::number(report.totalDuration) % QSL("s"));
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("Connections graph", "[.][benchmark]"){
+
+    // chain of 600 connectors, connections inserted from the end of the chain
+    const int nbConnectors = 600;
+    auto condition = Condition::generate_new_default();
+    std::vector<int> keys;
+    for(int ii = 0; ii < nbConnectors; ++ii){
+        condition->connectors.push_back(std::make_unique<Connector>(ConnectorKey{-1}, Connector::Type::Real, QSL("c"), QPointF{}));
+        keys.push_back(condition->connectors.back()->key());
+    }
+    for(int ii = nbConnectors-1; ii > 0; --ii){
+        auto connection = std::make_unique<Connection>(ConnectionKey{-1});
+        connection->startType  = Connection::Type::Connector;
+        connection->endType    = Connection::Type::Connector;
+        connection->startKey   = keys[ii-1];
+        connection->startIndex = 0;
+        connection->endKey     = keys[ii];
+        connection->endIndex   = 0;
+        condition->connections.push_back(std::move(connection));
+    }
+
+    ConnectionsGraphPlan plan;
+    Bench::start("[Connections graph: compile x100]"sv, false);
+    for(int ii = 0; ii < 100; ++ii){
+        plan.compile(condition.get());
+    }
+    Bench::stop();
+
+    REQUIRE(!plan.has_cycle());
+    REQUIRE(plan.max_depth() == static_cast<size_t>(nbConnectors-1));
+    REQUIRE(plan.connectors_order().front()->key() == keys.front());
+    REQUIRE(plan.connections_order().front()->startKey == keys.front());
+    REQUIRE(plan.connections_order().back()->endKey == keys.back());
+
+    // propagate a value through the converters of every connection of the chain
+    std::vector<IntegerToRealConverter> toReal(nbConnectors);
+    std::vector<RealToIntegerConverter> toInteger(nbConnectors);
+    DataSP value;
+    Bench::start("[Connections graph: convert x1000]"sv, false);
+    for(int ii = 0; ii < 1000; ++ii){
+        value = std::make_shared<IntData>(ii);
+        for(int jj = 0; jj < nbConnectors; ++jj){
+            value = toInteger[jj](toReal[jj](value));
+        }
+    }
+    Bench::stop();
+
+    REQUIRE(node_data_cast<IntData>(value) != nullptr);
+    REQUIRE(node_data_cast<IntData>(value)->value() == 999);
+    REQUIRE(node_data_cast<RealData>(value) == nullptr);
+
+    // same chain with the converters of the type-indexed table, as bound by the plan
+    // each connection converts into its preallocated output, updated in place
+    using CNT = ConnectionNode::Type;
+    ConvertersTable::add<IntegerToRealConverter, RealData>(CNT::integer_t);
+    ConvertersTable::add<RealToIntegerConverter, IntData>(CNT::real_t);
+    REQUIRE(ConvertersTable::type(QSL("real")) == CNT::real_t);
+    REQUIRE(ConvertersTable::generate(CNT::plot_t, CNT::real_t) == nullptr);
+
+    std::vector<std::unique_ptr<BaseConverter>> converters;
+    for(int ii = 0; ii < nbConnectors; ++ii){
+        converters.push_back(ConvertersTable::generate(CNT::integer_t, CNT::real_t));
+        converters.push_back(ConvertersTable::generate(CNT::real_t, CNT::integer_t));
+    }
+
+    auto input = std::make_shared<IntData>(0);
+    const NodeData *firstOutput = nullptr;
+    Bench::start("[Connections graph: compiled slots x1000]"sv, false);
+    for(int ii = 0; ii < 1000; ++ii){
+        input->set_value(ii);
+        value = input;
+        for(auto &converter : converters){
+            value = (*converter)(value);
+        }
+        if(ii == 0){
+            firstOutput = value.get();
+        }
+    }
+    Bench::stop();
+
+    REQUIRE(node_data_cast<IntData>(value)->value() == 999);
+    REQUIRE(value.get() == firstOutput);
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("Randomizer constraints", "[.][benchmark]"){
+
+    Randomizer randomizer(0);
+    SequenceConstraints constraints;
+    constraints.maxRepeats  = 1;
+    constraints.minDistance = 4;
+
+    // 10k trials, 5 sets, each set must wait 3 other trials before coming back
+    std::vector<size_t> counts(5, 2000);
+    size_t nbViolations = 0;
+    std::vector<int> ids;
+    Bench::start("[Randomizer: constrained 10k x100]"sv, false);
+    for(size_t ii = 0; ii < 100; ++ii){
+        auto gen = randomizer.instance_generator(ii, 0);
+        ids = Randomizer::generate_constrained_ids(counts, constraints, gen, &nbViolations);
+    }
+    Bench::stop();
+    REQUIRE(ids.size() == 10000);
+    REQUIRE(nbViolations == 0);
+
+    Bench::start("[Randomizer: balanced transitions 10k x100]"sv, false);
+    for(size_t ii = 0; ii < 100; ++ii){
+        auto gen = randomizer.instance_generator(ii, 1);
+        ids = Randomizer::generate_balanced_transitions_ids(20, 10000, true, gen);
+    }
+    Bench::stop();
+    REQUIRE(ids.size() == 10000);
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("Instance flow", "[.][benchmark]"){
+
+    Experiment exp("1.0");
+    generate_synthetic_experiment(exp, flow_blocks_settings(10));
+    for(const auto &loop : exp.loops){
+        loop->set_nb_reps(30);
+        loop->set_sets({QSL("a"),QSL("b"),QSL("c"),QSL("d")});
+    }
+
+    Bench::start("[Instance flow: generate]"sv, false);
+    auto instance = Instance::generate_from_full_experiment(&exp.randomizer, exp, 0);
+    Bench::stop();
+    REQUIRE(instance != nullptr);
+
+    size_t conditionsBytes = 0;
+    for(const auto &condition : instance->conditions){
+        conditionsBytes += sizeof(QString) + to_size_t(condition.size())*sizeof(QChar);
+    }
+    QtLogger::message(QSL("Flow elements: ") % QString::number(instance->flow.size()) %
+        QSL(" records: ") % QString::number(instance->flow.size()*sizeof(InstanceElement)) %
+        QSL(" bytes, interned conditions: ") % QString::number(instance->conditions.size()) %
+        QSL(" (") % QString::number(conditionsBytes) % QSL(" bytes)"));
+
+    // reverse index lookups
+    size_t found = 0;
+    Bench::start("[Instance flow: go to element x10000]"sv, false);
+    for(size_t ii = 0; ii < 10000; ++ii){
+        const auto &element = instance->flow[ii % instance->flow.size()];
+        if(auto positions = instance->positions(element.elem->e_key(), instance->condition(element)); positions != nullptr){
+            found += positions->size() > 0 ? 1 : 0;
+        }
+    }
+    Bench::stop();
+    REQUIRE(found == 10000);
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("Conditions sharing", "[.][benchmark]"){
+
+    // routine inside 2 nested loops: 20 x 25 = 500 conditions
+    Experiment exp("1.0");
+    generate_synthetic_experiment(exp, flow_blocks_settings(1));
+    QStringList sets1, sets2;
+    for(int ii = 0; ii < 20; ++ii){
+        sets1 << (QSL("a") % QString::number(ii));
+    }
+    for(int ii = 0; ii < 25; ++ii){
+        sets2 << (QSL("b") % QString::number(ii));
+    }
+    exp.loops[0]->set_sets(sets1);
+    exp.loops[1]->set_sets(sets2);
+    exp.update_conditions();
+
+    auto routine = exp.get_elements_from_type<Routine>()[0];
+    REQUIRE(routine->conditions.size() == 500);
+
+    for(int ii = 0; ii < 20; ++ii){
+        exp.add_new_component(Component::Type::Cube, RowId{ii});
+    }
+    const auto components = exp.compM.get_components();
+
+    Bench::start("[Conditions sharing: add actions to all conditions]"sv, false);
+    for(const auto component : components){
+        exp.add_action_to_all_conditions(routine->e_key(), component->c_key(), std::nullopt, true, true);
+    }
+    Bench::stop();
+
+    Bench::start("[Conditions sharing: modify actions of all conditions]"sv, false);
+    for(const auto component : components){
+        exp.modify_action_to_all_conditions(routine->e_key(), component->c_key(), false, true, true, ConfigKey{-1}, false, true);
+        exp.modify_action_to_all_conditions(routine->e_key(), component->c_key(), false, true, true, ConfigKey{-1}, true, true);
+    }
+    Bench::stop();
+
+    std::vector<std::pair<ElementKey,ConditionKey>> targets;
+    for(size_t ii = 1; ii < routine->conditions.size(); ++ii){
+        targets.emplace_back(routine->e_key(), routine->conditions[ii]->c_key());
+    }
+    routine->conditions[0]->actions[0]->timelineUpdate.edit().add_interval({SecondsTS{10.}, SecondsTS{200.}});
+
+    Bench::start("[Conditions sharing: copy condition to all others]"sv, false);
+    exp.copy_to_conditions(routine->e_key(), routine->conditions[0]->c_key(), targets, true, false);
+    Bench::stop();
+
+    // timelines memory with and without sharing, a shared timeline costs a pointer per action timeline and a control block per timeline data
+    std::unordered_set<const void*> unique;
+    size_t timelines = 0, intervals = 0, uniqueIntervals = 0;
+    for(const auto &condition : routine->conditions){
+        for(const auto &action : condition->actions){
+            for(const auto timeline : {&action->timelineUpdate, &action->timelineVisibility}){
+                ++timelines;
+                intervals += (*timeline)->intervals.size();
+                if(unique.insert(timeline->id()).second){
+                    uniqueIntervals += (*timeline)->intervals.size();
+                }
+            }
+        }
+    }
+    REQUIRE(timelines == 500*20*2);
+    QtLogger::message(QSL("Timelines: ") % QString::number(timelines) %
+        QSL(", shared timelines: ") % QString::number(unique.size()) %
+        QSL(", timelines bytes shared: ") % QString::number(
+            timelines*sizeof(CowData<Timeline>) + unique.size()*(2*sizeof(void*) + sizeof(Timeline)) + uniqueIntervals*sizeof(Interval)) %
+        QSL(" / copied: ") % QString::number(timelines*(sizeof(std::unique_ptr<Timeline>) + sizeof(Timeline)) + intervals*sizeof(Interval)));
+
+    // shared definitions are written once
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const auto xmlPath = dir.filePath(QSL("exp.xml"));
+    XmlIoManager xmlIoM(&exp);
+    Bench::start("[Conditions sharing: save xml]"sv, false);
+    REQUIRE(xmlIoM.save_experiment_file(xmlPath));
+    Bench::stop();
+
+    Experiment loaded("1.0");
+    XmlIoManager loadedIoM(&loaded);
+    Bench::start("[Conditions sharing: load xml]"sv, false);
+    REQUIRE(loadedIoM.load_experiment_file(xmlPath));
+    Bench::stop();
+
+    std::unordered_set<const void*> loadedUnique;
+    for(const auto &condition : loaded.get_elements_from_type<Routine>()[0]->conditions){
+        for(const auto &action : condition->actions){
+            loadedUnique.insert(action->timelineUpdate.id());
+            loadedUnique.insert(action->timelineVisibility.id());
+        }
+    }
+    REQUIRE(loadedUnique.size() <= unique.size());
+    QtLogger::message(QSL("Xml size: ") % QString::number(QFileInfo(xmlPath).size()) % QSL(" bytes"));
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("Experiment file formats", "[.][benchmark]"){
+
+    Experiment exp("1.0");
+    generate_synthetic_experiment(exp, flow_blocks_settings(100));
+    for(int ii = 0; ii < 5; ++ii){
+        for(const auto &type : Component::all_components_types()){
+            exp.add_new_component(type, {0});
+        }
+    }
+    for(auto routine : exp.get_elements_from_type<Routine>()){
+        for(const auto component : exp.compM.get_components()){
+            exp.add_action_to_all_conditions(routine->e_key(), component->c_key(), std::nullopt, true, true);
+        }
+    }
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const auto xmlPath    = dir.filePath(QSL("exp.xml"));
+    const auto binaryPath = dir.filePath(QSL("exp.exvrb"));
+
+    XmlIoManager xmlIoM(&exp);
+    Bench::start("[Experiment file: save xml]"sv, false);
+    REQUIRE(xmlIoM.save_experiment_file(xmlPath));
+    Bench::stop();
+    Bench::start("[Experiment file: save binary]"sv, false);
+    REQUIRE(xmlIoM.save_experiment_file(binaryPath));
+    Bench::stop();
+
+    QtLogger::message(QSL("Xml size: ") % QString::number(QFileInfo(xmlPath).size()) %
+        QSL(" bytes, binary size: ") % QString::number(QFileInfo(binaryPath).size()) % QSL(" bytes"));
+
+    for(const auto &path : {xmlPath, binaryPath}){
+        Experiment loaded("1.0");
+        XmlIoManager loadedIoM(&loaded);
+        Bench::start(path == xmlPath ? "[Experiment file: load xml]"sv : "[Experiment file: load binary]"sv, false);
+        REQUIRE(loadedIoM.load_experiment_file(path));
+        Bench::stop();
+        REQUIRE(loaded.compM.count() == exp.compM.count());
+    }
+
+    // lazy access to a single component
+    QFile binaryFile(binaryPath);
+    REQUIRE(binaryFile.open(QIODevice::ReadOnly));
+    const auto data = binaryFile.readAll();
+    Bench::start("[Experiment file: open binary and read one component]"sv, false);
+    BinaryExperimentFile file;
+    REQUIRE(file.open(data));
+    auto id = file.find_section(QSL("Component"), exp.compM.get_components().back()->key());
+    REQUIRE(id.has_value());
+    REQUIRE(file.section(id.value()) != nullptr);
+    Bench::stop();
+    REQUIRE(file.decoded_sections_count() == 1);
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
+
+TEST_CASE("CSV ingestion", "[.][benchmark]"){
+
+    // 2M rows of { time, 3 signals, label }
+    const int nbRows = 2000000;
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const auto path = dir.filePath(QSL("signals.csv"));
+    {
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::WriteOnly));
+        QByteArray content = "time,x,y,z,label\n";
+        for(int ii = 0; ii < nbRows; ++ii){
+            content += QByteArray::number(ii*0.001, 'f', 3) + "," + QByteArray::number(std::sin(ii*0.01)) + "," +
+                QByteArray::number(std::cos(ii*0.01)) + "," + QByteArray::number(ii % 1000) + ",s" + QByteArray::number(ii % 7) + "\n";
+            if(content.size() > 1024*1024){
+                file.write(content);
+                content.clear();
+            }
+        }
+        file.write(content);
+    }
+    QtLogger::message(QSL("CSV size: ") % QString::number(QFileInfo(path).size()) % QSL(" bytes"));
+
+    // line by line reading and splitting
+    std::vector<double> values;
+    values.reserve(nbRows);
+    Bench::start("[CSV ingestion: text stream]"sv, false);
+    {
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        QTextStream in(&file);
+        in.readLine();
+        while(!in.atEnd()){
+            const auto split = in.readLine().split(",");
+            values.push_back(split[1].toDouble());
+        }
+    }
+    Bench::stop();
+    REQUIRE(values.size() == static_cast<size_t>(nbRows));
+
+    CsvColumnsFile file;
+    Bench::start("[CSV ingestion: columns file]"sv, false);
+    REQUIRE(file.open(path.toStdString()));
+    Bench::stop();
+    REQUIRE(file.rows_count() == static_cast<size_t>(nbRows));
+    REQUIRE(file.column_type(4) == CsvColumnType::Text);
+    REQUIRE(file.reals(1)[nbRows-1] == values.back());
+
+    Bench::start("[CSV ingestion: decimation index]"sv, false);
+    REQUIRE(file.build_decimation_index(0));
+    Bench::stop();
+
+    // plot viewer queries: whole signal then a zoom
+    std::vector<double> xs, ys;
+    for(auto mode : {CsvDecimation::MinMax, CsvDecimation::LTTB}){
+        Bench::start(mode == CsvDecimation::MinMax ? "[CSV ingestion: min/max 2000 points x100]"sv : "[CSV ingestion: LTTB 2000 points x100]"sv, false);
+        for(int ii = 0; ii < 100; ++ii){
+            REQUIRE(file.decimate(1, 0., ii % 2 == 0 ? 2000. : 100., 2000, mode, xs, ys) <= 2000);
+        }
+        Bench::stop();
+    }
+
+    Bench::display(BenchUnit::milliseconds, 0, true);
+    Bench::reset();
+}
@@ -0,0 +1,294 @@
+/***********************************************************************************
+** exvr-test                                                                      **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+// std
+#include <chrono>
+#include <algorithm>
+
+// Qt
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+// base
+#include "thirdparty/catch/catch.hpp"
+
+// qt-utility
+#include "qt_logger.hpp"
+
+// exvr-designer
+#include "IO/xml_io_manager.hpp"
+#include "synthetic_experiment.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+// scale suite, hidden by default, run it with: exvr-test "[scale]"
+// environment variables:
+//  EXVR_BENCH_PRESETS      presets to run (default: "small,medium", available: small,medium,large)
+//  EXVR_BENCH_OUTPUT       json results file (default: exvr-test-benchmarks.json)
+//  EXVR_BENCH_BASELINE     json results file of a previous run to compare with (optional)
+//  EXVR_BENCH_THRESHOLD    allowed relative slowdown before reporting a regression (default: 0.2)
+//  EXVR_BENCH_MIN_DELTA_MS slowdowns below this absolute value are ignored (default: 1.0)
+// a "threshold" value in a baseline entry overrides EXVR_BENCH_THRESHOLD for this entry
+
+struct ScaleResult{
+    QString name;
+    size_t runs = 0;
+    double medianMs = 0.;
+    double minMs = 0.;
+    double maxMs = 0.;
+};
+
+template<typename F>
+static ScaleResult measure(const QString &name, size_t runs, F &&f){
+
+    std::vector<double> times;
+    times.reserve(runs);
+    for(size_t ii = 0; ii < runs; ++ii){
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+
+    ScaleResult result;
+    result.name     = name;
+    result.runs     = runs;
+    result.medianMs = times[times.size()/2];
+    result.minMs    = times.front();
+    result.maxMs    = times.back();
+    QtLogger::message(QSL("[SCALE] ") % name % QSL(": ") % QString::number(result.medianMs, 'f', 3) %
+        QSL("ms (min ") % QString::number(result.minMs, 'f', 3) % QSL(" max ") % QString::number(result.maxMs, 'f', 3) %
+        QSL(" runs ") % QString::number(runs) % QSL(")"));
+    return result;
+}
+
+static std::vector<std::pair<QString, SyntheticExperimentSettings>> scale_presets(){
+
+    SyntheticExperimentSettings small;
+
+    SyntheticExperimentSettings medium;
+    medium.nbRoutines               = 40;
+    medium.loopDepth                = 2;
+    medium.setsPerLoop              = 5;
+    medium.nbComponents             = 60;
+    medium.actionsPerCondition      = 10;
+    medium.intervalsPerTimeline     = 4;
+    medium.connectorsPerCondition   = 20;
+
+    SyntheticExperimentSettings large;
+    large.nbRoutines                = 100;
+    large.loopDepth                 = 2;
+    large.setsPerLoop               = 8;
+    large.nbComponents              = 120;
+    large.actionsPerCondition       = 15;
+    large.intervalsPerTimeline      = 5;
+    large.connectorsPerCondition    = 25;
+
+    return {{QSL("small"), small}, {QSL("medium"), medium}, {QSL("large"), large}};
+}
+
+static std::vector<ScaleResult> run_preset(const QString &preset, const SyntheticExperimentSettings &settings){
+
+    QtLogger::message(QSL("[SCALE] preset ") % preset % QSL(" ") % settings.to_string());
+    std::vector<ScaleResult> results;
+    const auto name = [&](const QString &operation){
+        return preset % QSL("/") % operation;
+    };
+
+    // generation
+    std::unique_ptr<Experiment> exp;
+    results.push_back(measure(name(QSL("generate")), 1, [&]{
+        exp = std::make_unique<Experiment>("1.0");
+        generate_synthetic_experiment(*exp, settings);
+    }));
+    auto routines = exp->get_elements_from_type<Routine>();
+    REQUIRE(routines.size() == settings.routines_count());
+    REQUIRE(routines.front()->conditions.size() == settings.conditions_per_routine());
+
+    results.push_back(measure(name(QSL("update_conditions")), 5, [&]{
+        exp->update_conditions();
+    }));
+    REQUIRE(routines.front()->conditions.size() == settings.conditions_per_routine());
+
+    // intervals inserted in reverse order, each insertion merges the timeline
+    results.push_back(measure(name(QSL("timeline_merge")), 5, [&]{
+        Timeline timeline(Timeline::Update);
+        for(int ii = 2000; ii > 0; --ii){
+            timeline.add_interval(Interval{SecondsTS{ii*1.}, SecondsTS{ii*1.+0.5}});
+        }
+        for(int ii = 0; ii < 2000; ii += 2){
+            timeline.add_interval(Interval{SecondsTS{ii*1.+0.25}, SecondsTS{ii*1.+1.25}});
+        }
+    }));
+
+    // component lookups by key and by name
+    const auto components = exp->compM.get_components();
+    size_t found = 0;
+    results.push_back(measure(name(QSL("component_lookups")), 5, [&]{
+        for(size_t ii = 0; ii < 100; ++ii){
+            for(const auto component : components){
+                found += exp->compM.get_component(component->c_key(), false) == component ? 1 : 0;
+                found += exp->compM.get_component(component->name()) == component ? 1 : 0;
+            }
+        }
+    }));
+    REQUIRE(found == 5*100*2*components.size());
+
+    results.push_back(measure(name(QSL("generate_instance")), 3, [&]{
+        auto instance = Instance::generate_from_full_experiment(&exp->randomizer, *exp, 0);
+        REQUIRE(instance != nullptr);
+    }));
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const auto path = dir.filePath(QSL("scale.xml"));
+    XmlIoManager xmlIoM(exp.get());
+    results.push_back(measure(name(QSL("xml_save")), 3, [&]{
+        REQUIRE(xmlIoM.save_experiment_file(path));
+    }));
+    results.push_back(measure(name(QSL("xml_load")), 3, [&]{
+        Experiment loaded("1.0");
+        XmlIoManager loadedIoM(&loaded);
+        REQUIRE(loadedIoM.load_experiment_file(path));
+        REQUIRE(loaded.compM.count() == exp->compM.count());
+    }));
+
+    // copy the first condition of every routine to all the others of the routine
+    results.push_back(measure(name(QSL("copy_to_conditions")), 1, [&]{
+        for(auto routine : routines){
+            std::vector<std::pair<ElementKey,ConditionKey>> targets;
+            for(size_t ii = 1; ii < routine->conditions.size(); ++ii){
+                targets.emplace_back(routine->e_key(), routine->conditions[ii]->c_key());
+            }
+            exp->copy_to_conditions(routine->e_key(), routine->conditions[0]->c_key(), targets, true, true);
+        }
+    }));
+    REQUIRE(routines.back()->conditions.back()->actions.size() == routines.back()->conditions.front()->actions.size());
+
+    return results;
+}
+
+static QJsonObject to_json(const std::vector<ScaleResult> &results){
+
+    QJsonArray entries;
+    for(const auto &result : results){
+        entries.append(QJsonObject{
+            {QSL("name"),     result.name},
+            {QSL("runs"),     static_cast<int>(result.runs)},
+            {QSL("median_ms"), result.medianMs},
+            {QSL("min_ms"),   result.minMs},
+            {QSL("max_ms"),   result.maxMs},
+        });
+    }
+    return QJsonObject{
+        {QSL("version"), 1},
+        {QSL("date"),    QDateTime::currentDateTime().toString(Qt::ISODate)},
+        {QSL("results"), entries},
+    };
+}
+
+static std::vector<QString> compare_with_baseline(const std::vector<ScaleResult> &results, const QJsonObject &baseline,
+    double threshold, double minDeltaMs){
+
+    std::vector<QString> regressions;
+    for(const auto &entry : baseline[QSL("results")].toArray()){
+
+        const auto object = entry.toObject();
+        const auto name = object[QSL("name")].toString();
+        auto result = std::find_if(results.begin(), results.end(), [&](const ScaleResult &r){
+            return r.name == name;
+        });
+        if(result == results.end()){
+            continue;
+        }
+
+        const double baselineMs     = object[QSL("median_ms")].toDouble();
+        const double entryThreshold = object[QSL("threshold")].toDouble(threshold);
+        const double delta          = result->medianMs - baselineMs;
+        const double ratio          = baselineMs > 0. ? delta / baselineMs : 0.;
+        const auto info = name % QSL(": ") % QString::number(result->medianMs, 'f', 3) % QSL("ms / baseline ") %
+            QString::number(baselineMs, 'f', 3) % QSL("ms (") % (ratio >= 0. ? QSL("+") : QSL("")) %
+            QString::number(ratio*100., 'f', 1) % QSL("%)");
+
+        if(ratio > entryThreshold && delta > minDeltaMs){
+            QtLogger::warning(QSL("[SCALE] regression ") % info);
+            regressions.push_back(info);
+        }else{
+            QtLogger::message(QSL("[SCALE] ") % info);
+        }
+    }
+    return regressions;
+}
+
+TEST_CASE("Scale suite", "[.][benchmark][scale]"){
+
+    const auto presets = qEnvironmentVariable("EXVR_BENCH_PRESETS", QSL("small,medium")).split(',', Qt::SkipEmptyParts);
+    const auto output  = qEnvironmentVariable("EXVR_BENCH_OUTPUT", QSL("exvr-test-benchmarks.json"));
+    const auto baselinePath = qEnvironmentVariable("EXVR_BENCH_BASELINE");
+
+    bool ok = false;
+    double threshold  = qEnvironmentVariable("EXVR_BENCH_THRESHOLD").toDouble(&ok);
+    if(!ok){
+        threshold = 0.2;
+    }
+    double minDeltaMs = qEnvironmentVariable("EXVR_BENCH_MIN_DELTA_MS").toDouble(&ok);
+    if(!ok){
+        minDeltaMs = 1.0;
+    }
+
+    std::vector<ScaleResult> results;
+    for(const auto &[preset, settings] : scale_presets()){
+        if(presets.contains(preset)){
+            auto presetResults = run_preset(preset, settings);
+            results.insert(results.end(), presetResults.begin(), presetResults.end());
+        }
+    }
+    REQUIRE(!results.empty());
+
+    QFile outputFile(output);
+    REQUIRE(outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    outputFile.write(QJsonDocument(to_json(results)).toJson());
+    outputFile.close();
+    QtLogger::message(QSL("[SCALE] results written to ") % QFileInfo(outputFile).absoluteFilePath());
+
+    if(baselinePath.isEmpty()){
+        return;
+    }
+
+    QFile baselineFile(baselinePath);
+    REQUIRE(baselineFile.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const auto baseline = QJsonDocument::fromJson(baselineFile.readAll(), &error);
+    INFO(error.errorString().toStdString());
+    REQUIRE(baseline.isObject());
+
+    const auto regressions = compare_with_baseline(results, baseline.object(), threshold, minDeltaMs);
+    INFO(QStringList(regressions.begin(), regressions.end()).join('\n').toStdString());
+    REQUIRE(regressions.empty());
+}
@@ -24,7 +24,16 @@
 ************************************************************************************/
 
 // std
+#include <algorithm>
+#include <cmath>
 #include <format>
+#include <unordered_set>
+
+// Qt
+#include <QDir>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <QXmlStreamReader>
 
 // base
 #include "thirdparty/catch/catch.hpp"
@@ -34,7 +43,16 @@
 
 // exvr-designer
 #include "IO/xml_io_manager.hpp"
+#include "IO/binary_experiment_file.hpp"
+#include "IO/experiment_stream.hpp"
+#include "experiment/simulator.hpp"
 #include "utility/path_utility.hpp"
+#include "data/flow_elements/loop.hpp"
+#include "resources/resources_exporter.hpp"
+#include "resources/resources_indexer.hpp"
+
+// exvr-export
+#include "ex_resources/csv_columns_file.hpp"
 
 using namespace tool;
 using namespace tool::ex;
@@ -105,6 +123,581 @@ TEST_CASE("Experiment"){
         REQUIRE(exp.get_routine(RowId{2})->name() == names[2]);
         REQUIRE(exp.get_routine(RowId{3})->name() == names[3]);
     }
+
+    SECTION("Simulation"){
+
+        exp.add_element(FlowElement::Type::Routine, 0);
+        exp.add_element(FlowElement::Type::Isi, 2);
+        exp.add_element(FlowElement::Type::Routine, 4);
+
+        // first routine: next when update time >= 500ms
+        auto condition = exp.get_routine(RowId{0})->conditions[0].get();
+        auto add_connector = [&](Connector::Type type, QString arg){
+            condition->connectors.push_back(std::make_unique<Connector>(ConnectorKey{-1}, type, QSL("c"), QPointF{}));
+            condition->connectors.back()->arg.edit().set_value(arg);
+            return condition->connectors.back()->key();
+        };
+        auto connect_connectors = [&](int startKey, int startIndex, int endKey, int endIndex){
+            auto connection = std::make_unique<Connection>(ConnectionKey{-1});
+            connection->startType  = Connection::Type::Connector;
+            connection->endType    = Connection::Type::Connector;
+            connection->startKey   = startKey;
+            connection->startIndex = startIndex;
+            connection->endKey     = endKey;
+            connection->endIndex   = endIndex;
+            condition->connections.push_back(std::move(connection));
+        };
+        const int update  = add_connector(Connector::Type::Update_routine, QSL(""));
+        const int real    = add_connector(Connector::Type::Real, QSL("500"));
+        const int op      = add_connector(Connector::Type::Decimal_operation, QSL("Superior or equal?"));
+        const int trigger = add_connector(Connector::Type::Conditional_trigger, QSL(""));
+        const int next    = add_connector(Connector::Type::Next, QSL(""));
+        connect_connectors(update, 0, op, 0);
+        connect_connectors(real, 0, op, 1);
+        connect_connectors(op, 0, trigger, 0);
+        connect_connectors(trigger, 0, next, 0);
+
+        auto instance = Instance::generate_from_full_experiment(&exp.randomizer, exp, 0);
+        REQUIRE(instance != nullptr);
+        REQUIRE(instance->conditions.size() == 2); // "default" and the ISI interval
+        REQUIRE(instance->positions(exp.get_routine(RowId{1})->e_key(), QSL("default"))->front() == 2);
+
+        Simulator simulator;
+        auto report = simulator.run(*instance);
+        REQUIRE(report.elements.size() == instance->flow.size());
+        REQUIRE(report.elements[0].endReason == SimEndReason::Next);
+        REQUIRE(report.elements[0].duration == Approx(0.5).margin(0.02));
+        REQUIRE(report.elements[1].type == FlowElement::Type::Isi);
+        REQUIRE(report.elements[2].endReason == SimEndReason::Duration);
+        REQUIRE(report.totalDuration == Approx(report.elements[0].duration + 1. + exp.get_routine(RowId{1})->conditions[0]->duration.v).margin(0.02));
+        REQUIRE(!report.stopped);
+    }
+
+    SECTION("Conditions sharing"){
+
+        exp.add_element(FlowElement::Type::Loop, 0);
+        exp.add_element(FlowElement::Type::Routine, 2);
+        exp.loops[0]->set_sets({QSL("a"), QSL("b"), QSL("c")});
+        exp.update_conditions();
+        exp.add_new_component(Component::Type::Cube, RowId{0});
+
+        auto routine   = exp.get_routine(RowId{0});
+        auto component = exp.compM.get_component(RowId{0});
+        REQUIRE(routine->conditions.size() == 3);
+        auto first  = routine->conditions[0].get();
+        auto second = routine->conditions[1].get();
+
+        // bulk operations share the timelines
+        exp.add_action_to_all_conditions(routine->e_key(), component->c_key(), std::nullopt, true, false);
+        for(const auto &condition : routine->conditions){
+            REQUIRE(condition->actions.size() == 1);
+            REQUIRE(condition->actions[0]->timelineUpdate.shares_with(first->actions[0]->timelineUpdate));
+            REQUIRE(condition->actions[0]->timelineVisibility.shares_with(first->actions[0]->timelineVisibility));
+        }
+
+        // a modified timeline is detached from the other conditions
+        exp.add_timeline_interval(routine->e_key(), first->c_key(), first->actions[0]->a_key(), false, Interval{SecondsTS{0.}, SecondsTS{10.}});
+        REQUIRE(first->actions[0]->timelineVisibility->nb_intervals() == 1);
+        REQUIRE(second->actions[0]->timelineVisibility->nb_intervals() == 0);
+
+        // copied actions and connectors keep their own keys and share their data
+        first->connectors.push_back(std::make_unique<Connector>(ConnectorKey{-1}, Connector::Type::Real, QSL("Real"), QPointF{}));
+        first->connectors.back()->arg.edit().set_value(QSL("1.5"));
+        exp.copy_to_conditions(routine->e_key(), first->c_key(), {{routine->e_key(), second->c_key()}}, true, true);
+        REQUIRE(second->actions[0]->key() != first->actions[0]->key());
+        REQUIRE(second->actions[0]->timelineVisibility.shares_with(first->actions[0]->timelineVisibility));
+        REQUIRE(second->connectors.size() == 1);
+        REQUIRE(second->connectors[0]->key() != first->connectors[0]->key());
+        REQUIRE(second->connectors[0]->arg.shares_with(first->connectors[0]->arg));
+
+        // shared data is written once and shared again once loaded
+        std::unordered_set<const void*> timelines;
+        for(const auto &condition : routine->conditions){
+            timelines.insert(condition->actions[0]->timelineUpdate.id());
+            timelines.insert(condition->actions[0]->timelineVisibility.id());
+        }
+
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        XmlIoManager xmlIoM(&exp);
+        REQUIRE(xmlIoM.save_experiment_file(dir.filePath(QSL("exp.xml"))));
+
+        QFile xmlFile(dir.filePath(QSL("exp.xml")));
+        REQUIRE(xmlFile.open(QIODevice::ReadOnly));
+        const auto xml = xmlFile.readAll();
+        REQUIRE(static_cast<size_t>(xml.count("<Timeline ")) == timelines.size());
+        REQUIRE(xml.count("<ConnectorArg ") == 1);
+
+        Experiment loaded("1.0");
+        XmlIoManager loadedIoM(&loaded);
+        REQUIRE(loadedIoM.load_experiment_file(dir.filePath(QSL("exp.xml"))));
+        auto loadedRoutine = loaded.get_routine(RowId{0});
+        REQUIRE(loadedRoutine->conditions.size() == 3);
+        auto loadedFirst  = loadedRoutine->conditions[0].get();
+        auto loadedSecond = loadedRoutine->conditions[1].get();
+        REQUIRE(loadedFirst->actions[0]->timelineVisibility->nb_intervals() == 1);
+        REQUIRE(loadedSecond->actions[0]->timelineVisibility.shares_with(loadedFirst->actions[0]->timelineVisibility));
+        REQUIRE(loadedSecond->connectors[0]->arg.shares_with(loadedFirst->connectors[0]->arg));
+        REQUIRE(loadedSecond->connectors[0]->arg->value() == QSL("1.5"));
+    }
+}
+
+TEST_CASE("Randomizer"){
+
+    Randomizer randomizer(42);
+
+    SECTION("Constrained sequence"){
+
+        auto gen = randomizer.instance_generator(0, 1);
+        SequenceConstraints constraints;
+        constraints.maxRepeats  = 1;
+        constraints.minDistance = 3;
+
+        size_t nbViolations = 0;
+        const auto ids = Randomizer::generate_constrained_ids({40,40,40,40}, constraints, gen, &nbViolations);
+        REQUIRE(ids.size() == 160);
+        REQUIRE(nbViolations == 0);
+        for(size_t ii = 1; ii < ids.size(); ++ii){
+            REQUIRE(ids[ii] != ids[ii-1]);
+            if(ii > 1){
+                REQUIRE(ids[ii] != ids[ii-2]);
+            }
+        }
+        for(int id = 0; id < 4; ++id){
+            REQUIRE(std::count(ids.begin(), ids.end(), id) == 40);
+        }
+
+        // same instance, same sequence
+        auto sameGen = randomizer.instance_generator(0, 1);
+        REQUIRE(Randomizer::generate_constrained_ids({40,40,40,40}, constraints, sameGen) == ids);
+    }
+
+    SECTION("Balanced transitions"){
+
+        auto gen = randomizer.instance_generator(0, 2);
+        const auto ids = Randomizer::generate_balanced_transitions_ids(4, 4*3*5+1, true, gen);
+        std::array<int,16> transitions = {};
+        for(size_t ii = 1; ii < ids.size(); ++ii){
+            REQUIRE(ids[ii] != ids[ii-1]);
+            ++transitions[static_cast<size_t>(ids[ii-1]*4 + ids[ii])];
+        }
+        for(size_t ii = 0; ii < transitions.size(); ++ii){
+            REQUIRE(transitions[ii] == ((ii % 5 == 0) ? 0 : 5));
+        }
+    }
+
+    SECTION("Williams latin square"){
+
+        // each value follows each other value exactly once over the rows
+        std::array<int,16> transitions = {};
+        for(size_t row = 0; row < 4; ++row){
+            const auto ids = Randomizer::generate_williams_ids(4, 4, row);
+            for(size_t ii = 1; ii < ids.size(); ++ii){
+                ++transitions[static_cast<size_t>(ids[ii-1]*4 + ids[ii])];
+            }
+        }
+        for(size_t ii = 0; ii < transitions.size(); ++ii){
+            REQUIRE(transitions[ii] == ((ii % 5 == 0) ? 0 : 1));
+        }
+    }
+}
+
+static std::vector<QString> xml_tokens(const QByteArray &xml){
+
+    std::vector<QString> tokens;
+    QXmlStreamReader r(xml);
+    while(!r.atEnd()){
+        switch(r.readNext()){
+        case QXmlStreamReader::StartElement:{
+            QString token = QSL("<") % r.name();
+            for(const auto &attribute : r.attributes()){
+                token += QSL(" ") % attribute.qualifiedName() % QSL("=") % attribute.value();
+            }
+            tokens.push_back(token);
+        }break;
+        case QXmlStreamReader::EndElement:
+            tokens.push_back(QSL("/") % r.name());
+            break;
+        case QXmlStreamReader::Characters:
+            if(!r.isWhitespace()){
+                tokens.push_back(r.text().toString());
+            }
+            break;
+        case QXmlStreamReader::Comment:
+            tokens.push_back(QSL("#") % r.text());
+            break;
+        default:
+            break;
+        }
+    }
+    return tokens;
+}
+
+TEST_CASE("Binary experiment"){
+
+    SECTION("Typed values"){
+
+        const QByteArray xml =
+            "<Experiment key=\"3\"><Component key=\"7\" name=\"c\">"
+            "<Arg name=\"a\" value=\"1 2 -3\" sep=\" \"/>"
+            "<Arg name=\"b\" value=\"0.1,0.25,3,-0\" sep=\",\"/>"
+            "<Arg name=\"c\" value=\"1.0 2\" sep=\" \"/>"
+            "<Arg name=\"d\" value=\"0.5\" ratio=\"1e+21\" text=\"\xc3\xa9t\xc3\xa9\"/>"
+            "<!-- comment --></Component></Experiment>";
+
+        const auto binary = BinaryExperimentFile::from_xml(xml);
+        REQUIRE(BinaryExperimentFile::is_binary(binary));
+        const auto back = BinaryExperimentFile::to_xml(binary);
+        REQUIRE(back.has_value());
+        REQUIRE(xml_tokens(back.value()) == xml_tokens(xml));
+
+        BinaryExperimentFile file;
+        REQUIRE(file.open(binary));
+        REQUIRE(file.sections_count() == 2);
+        REQUIRE(file.decoded_sections_count() == 0);
+        auto id = file.find_section(QSL("Component"), 7);
+        REQUIRE(id.has_value());
+        REQUIRE(file.section(id.value())->attributes[1].second == QSL("c"));
+        REQUIRE(file.decoded_sections_count() == 1);
+        file.release_section(id.value());
+        REQUIRE(file.decoded_sections_count() == 0);
+    }
+
+    SECTION("Streaming"){
+
+        const QByteArray xml =
+            "<Experiment key=\"1\"><Settings a=\"0\"/><Components><Component key=\"4\" name=\"c\">"
+            "<Arg name=\"a\" value=\"1.5 2\" sep=\" \"/></Component><Component key=\"5\"/></Components>"
+            "<!-- comment --><Routine key=\"2\"><Condition name=\"x\"/></Routine></Experiment>";
+        const auto binary = BinaryExperimentFile::from_xml(xml);
+        REQUIRE(!binary.isEmpty());
+
+        // binary tokens read directly from the sections
+        ExperimentStreamReader reader;
+        REQUIRE(reader.set_binary(binary));
+        std::vector<QString> tokens;
+        while(!reader.at_end()){
+            reader.read_next();
+            if(reader.is_start_element()){
+                tokens.push_back(QSL("<") % reader.name() % QSL(" ") % reader.attribute(QSL("key")));
+            }else if(reader.is_end_element()){
+                tokens.push_back(QSL("/") % reader.name());
+            }
+        }
+        REQUIRE(!reader.has_error());
+        REQUIRE(tokens == std::vector<QString>{
+            QSL("<Experiment 1"), QSL("<Settings "), QSL("/Settings"), QSL("<Components "),
+            QSL("<Component 4"), QSL("<Arg "), QSL("/Arg"), QSL("/Component"), QSL("<Component 5"), QSL("/Component"),
+            QSL("/Components"), QSL("<Routine 2"), QSL("<Condition "), QSL("/Condition"), QSL("/Routine"), QSL("/Experiment")
+        });
+
+        // invalid sequences are not encoded
+        BinaryExperimentWriter unbalanced;
+        unbalanced.write_start_element(QSL("Experiment"));
+        REQUIRE(unbalanced.finish().isEmpty());
+
+        BinaryExperimentWriter attributeAfterChild;
+        attributeAfterChild.write_start_element(QSL("Experiment"));
+        attributeAfterChild.write_comment(QSL("c"));
+        attributeAfterChild.write_attribute(QSL("key"), QSL("1"));
+        attributeAfterChild.write_end_element();
+        REQUIRE(attributeAfterChild.finish().isEmpty());
+
+        BinaryExperimentWriter tooManyEnds;
+        tooManyEnds.write_end_element();
+        REQUIRE(tooManyEnds.finish().isEmpty());
+
+        REQUIRE(!reader.set_binary(binary.left(binary.size()/2)));
+    }
+
+    SECTION("Round trip"){
+
+        Experiment exp("1.0");
+        exp.add_element(FlowElement::Type::Routine, 0);
+        exp.add_element(FlowElement::Type::Isi, 2);
+        exp.add_element(FlowElement::Type::Loop, 4);
+        for(const auto &type : Component::all_components_types()){
+            exp.add_new_component(type, {0});
+        }
+
+        QTemporaryDir dir;
+        REQUIRE(dir.isValid());
+        XmlIoManager xmlIoM(&exp);
+        REQUIRE(xmlIoM.save_experiment_file(dir.filePath(QSL("exp.xml"))));
+        REQUIRE(xmlIoM.save_experiment_file(dir.filePath(QSL("exp.exvrb"))));
+
+        QFile xmlFile(dir.filePath(QSL("exp.xml")));
+        QFile binaryFile(dir.filePath(QSL("exp.exvrb")));
+        REQUIRE(xmlFile.open(QIODevice::ReadOnly));
+        REQUIRE(binaryFile.open(QIODevice::ReadOnly));
+        const auto xml    = xmlFile.readAll();
+        const auto binary = binaryFile.readAll();
+        REQUIRE(binary.size() < xml.size());
+
+        const auto back = BinaryExperimentFile::to_xml(binary);
+        REQUIRE(back.has_value());
+        REQUIRE(xml_tokens(back.value()) == xml_tokens(xml));
+
+        Experiment loaded("1.0");
+        XmlIoManager loadedIoM(&loaded);
+        REQUIRE(loadedIoM.load_experiment_file(dir.filePath(QSL("exp.exvrb"))));
+        REQUIRE(loaded.compM.count() == exp.compM.count());
+        REQUIRE(loaded.elements.size() == exp.elements.size());
+    }
+}
+
+TEST_CASE("CSV columns file"){
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    auto write_file = [&](const QString &name, const QByteArray &content){
+        QFile file(dir.filePath(name));
+        REQUIRE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+        return dir.filePath(name).toStdString();
+    };
+
+    SECTION("Typed columns"){
+
+        CsvColumnsFile file;
+        REQUIRE(file.open(write_file(QSL("typed.csv"), "\xEF\xBB\xBFtime;value;name\r\n0;1.5;a\r\n\r\n1;-2;\"b;\"\"c\"\"\"\n2;;d\n3;1e3;e;extra\n")));
+        REQUIRE(file.separator() == ';');
+        REQUIRE(file.rows_count() == 4);
+        REQUIRE(file.columns_count() == 4);
+        REQUIRE(file.column_name(1) == "value");
+        REQUIRE(file.column_type(0) == CsvColumnType::Real);
+        REQUIRE(file.column_type(1) == CsvColumnType::Real);
+        REQUIRE(file.column_type(2) == CsvColumnType::Text);
+        REQUIRE(file.reals(1)[0] == 1.5);
+        REQUIRE(std::isnan(file.reals(1)[2]));
+        REQUIRE(file.reals(1)[3] == 1000.);
+        REQUIRE(file.text(2, 1) == "b;\"c\"");
+        REQUIRE(file.text(3, 3) == "extra");
+        REQUIRE(file.text(3, 0).empty());
+
+        CsvParseSettings settings;
+        settings.typeInferenceRows = 2;
+        REQUIRE(file.open(write_file(QSL("invalid.csv"), "x,y\n0,1\n1,2\n2,z\n"), settings));
+        REQUIRE(file.column_type(1) == CsvColumnType::Real);
+        REQUIRE(file.invalid_cells_count() == 1);
+        REQUIRE(std::isnan(file.reals(1)[2]));
+    }
+
+    SECTION("Decimation"){
+
+        QByteArray content = "t,y\n";
+        for(int ii = 0; ii < 100000; ++ii){
+            const double y = ii == 54321 ? 100. : (ii == 777 ? -100. : std::sin(ii*0.01));
+            content += QByteArray::number(ii*0.1) + "," + QByteArray::number(y) + "\n";
+        }
+        CsvColumnsFile file;
+        REQUIRE(file.open(write_file(QSL("signal.csv"), content)));
+        REQUIRE(!file.build_decimation_index(1));
+        REQUIRE(file.build_decimation_index(0));
+
+        std::vector<double> xs, ys;
+        REQUIRE(file.decimate(1, 0., 10000., 400, CsvDecimation::MinMax, xs, ys) <= 400);
+        REQUIRE(std::ranges::is_sorted(xs));
+        REQUIRE(std::ranges::max(ys) == 100.);
+        REQUIRE(std::ranges::min(ys) == -100.);
+
+        REQUIRE(file.decimate(1, 50., 5000., 300, CsvDecimation::LTTB, xs, ys) == 300);
+        REQUIRE(xs.front() == 50.);
+        REQUIRE(xs.back() == 5000.);
+
+        // all points when they fit
+        REQUIRE(file.decimate(1, 1., 2., 300, CsvDecimation::LTTB, xs, ys) == 11);
+        REQUIRE(file.build_decimation_index(CsvColumnsFile::rowsIndex));
+        REQUIRE(file.decimate(1, 54000., 55000., 20, CsvDecimation::MinMax, xs, ys) <= 20);
+        REQUIRE(std::ranges::max(ys) == 100.);
+    }
+
+    SECTION("Loop sets file"){
+
+        Loop loop;
+        REQUIRE(loop.load_file(QString::fromStdString(write_file(QSL("sets.txt"), "s1\ns2 3\n\ns1 4\ns3 x\n"))));
+        REQUIRE(loop.sets.size() == 3);
+        REQUIRE(loop.sets[0]->name == QSL("s1"));
+        REQUIRE(loop.sets[0]->occurencies == 1);
+        REQUIRE(loop.sets[1]->occurencies == 3);
+        REQUIRE(loop.sets[2]->occurencies == 1);
+        REQUIRE(!loop.load_file(QString::fromStdString(write_file(QSL("empty.txt"), "\n\n"))));
+
+        // quotes are part of the names, non-ascii path
+        REQUIRE(loop.load_file(QString::fromStdString(write_file(QString::fromUtf8("sets_\xC3\xA9.txt"), "\"s1\" 2\n\"s2 3\n"))));
+        REQUIRE(loop.sets.size() == 2);
+        REQUIRE(loop.sets[0]->name == QSL("\"s1\""));
+        REQUIRE(loop.sets[0]->occurencies == 2);
+        REQUIRE(loop.sets[1]->name == QSL("\"s2"));
+        REQUIRE(loop.sets[1]->occurencies == 3);
+    }
+}
+
+TEST_CASE("Resources export"){
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    auto write_file = [&](const QString &name, const QByteArray &content){
+        QDir().mkpath(QFileInfo(dir.filePath(name)).absolutePath());
+        QFile file(dir.filePath(name));
+        REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(content);
+        return dir.filePath(name);
+    };
+
+    SECTION("Export paths collisions"){
+
+        ResourcesManager resM;
+        resM.add_resources(Resource::Type::Text, {
+            write_file(QSL("a/x.txt"), "a"),
+            write_file(QSL("b/X.txt"), "b"),
+            write_file(QSL("c/x.txt"), "c"),
+            write_file(QSL("c/y"), "y")
+        });
+        resM.add_resource(Resource::Type::Image, write_file(QSL("d/x.txt"), "d"));
+
+        const auto paths = ResourcesExporter::generate_export_paths(resM);
+        REQUIRE(paths.size() == 5);
+
+        const auto texts = resM.get_resources(Resource::Type::Text);
+        REQUIRE(texts.size() == 4);
+        REQUIRE(paths.at(texts[0]->key()) == QSL("resources/Text/x.txt"));
+        // case insensitive collision
+        REQUIRE(paths.at(texts[1]->key()) == QSL("resources/Text/X_1.txt"));
+        REQUIRE(paths.at(texts[2]->key()) == QSL("resources/Text/x_2.txt"));
+        REQUIRE(paths.at(texts[3]->key()) == QSL("resources/Text/y"));
+        // other type directory, no collision
+        REQUIRE(paths.at(resM.get_resources(Resource::Type::Image)[0]->key()) == QSL("resources/Image/x.txt"));
+    }
+
+    SECTION("Hash cache"){
+
+        const auto file1 = write_file(QSL("h1.bin"), "content");
+        const auto file2 = write_file(QSL("h2.bin"), "content");
+        const auto hash1 = ResourcesHashCache::compute_hash(file1, 3);
+        REQUIRE(!hash1.isEmpty());
+        REQUIRE(hash1 == ResourcesHashCache::compute_hash(file2, 1024));
+        REQUIRE(ResourcesHashCache::compute_hash(dir.filePath(QSL("missing.bin")), 1024).isEmpty());
+
+        ResourcesHashCache cache;
+        REQUIRE(!cache.hash(QFileInfo(file1)).has_value());
+        cache.set_hash(QFileInfo(file1), hash1);
+        REQUIRE(cache.hash(QFileInfo(file1)) == hash1);
+
+        // saved and loaded entries
+        const auto cachePath = dir.filePath(QSL("hashes"));
+        REQUIRE(cache.save(cachePath));
+        ResourcesHashCache loaded;
+        REQUIRE(loaded.load(cachePath));
+        REQUIRE(loaded.hash(QFileInfo(file1)) == hash1);
+        REQUIRE(!loaded.hash(QFileInfo(file2)).has_value());
+
+        // modified file invalidates its entry
+        write_file(QSL("h1.bin"), "modified content");
+        REQUIRE(!cache.hash(QFileInfo(file1)).has_value());
+        REQUIRE(!loaded.hash(QFileInfo(file1)).has_value());
+        REQUIRE(!ResourcesHashCache().load(dir.filePath(QSL("missing"))));
+    }
+}
+
+TEST_CASE("Resources metadata"){
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    auto write_file = [&](const QString &name, const QByteArray &content){
+        QFile file(dir.filePath(name));
+        REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(content);
+        return dir.filePath(name);
+    };
+    auto be32 = [](quint32 v){
+        QByteArray b(4, 0);
+        qToBigEndian(v, b.data());
+        return b;
+    };
+    auto be64 = [](quint64 v){
+        QByteArray b(8, 0);
+        qToBigEndian(v, b.data());
+        return b;
+    };
+    auto le = [](quint32 v, int bytes){
+        QByteArray b(4, 0);
+        qToLittleEndian(v, b.data());
+        return b.left(bytes);
+    };
+    auto box = [&](const char *type, const QByteArray &payload){
+        return be32(8 + payload.size()) + QByteArray(type, 4) + payload;
+    };
+    const QByteArray ftyp = box("ftyp", QByteArray("isom") + be32(0));
+
+    SECTION("Mp4 duration"){
+
+        // version 0: 32 bits times
+        const auto mvhd0 = box("mvhd", QByteArray(12, 0) + be32(1000) + be32(2500));
+        REQUIRE(ResourcesIndexer::read_mp4_duration(write_file(QSL("v0.mp4"), ftyp + box("moov", mvhd0))) == 2.5);
+
+        // version 1: 64 bits times, moov after mdat
+        const auto mvhd1 = box("mvhd", QByteArray(1, 1) + QByteArray(19, 0) + be32(600) + be64(1800));
+        REQUIRE(ResourcesIndexer::read_mp4_duration(write_file(QSL("v1.mp4"), ftyp + box("mdat", QByteArray(100, 0)) + box("moov", mvhd1))) == 3.);
+
+        // truncated movie header
+        REQUIRE(!ResourcesIndexer::read_mp4_duration(write_file(QSL("short.mp4"), ftyp + box("moov", box("mvhd", QByteArray(8, 0))))).has_value());
+        // no movie box
+        REQUIRE(!ResourcesIndexer::read_mp4_duration(write_file(QSL("nomoov.mp4"), ftyp)).has_value());
+        // box size smaller than its header
+        REQUIRE(!ResourcesIndexer::read_mp4_duration(write_file(QSL("small.mp4"), be32(4) + QByteArray("free") + box("moov", mvhd0))).has_value());
+        // 32 bits box size beyond the end of the file
+        REQUIRE(!ResourcesIndexer::read_mp4_duration(write_file(QSL("beyond.mp4"), be32(0x7FFFFFFF) + QByteArray("free") + box("moov", mvhd0))).has_value());
+        // 64 bits box size which would overflow the position
+        REQUIRE(!ResourcesIndexer::read_mp4_duration(write_file(QSL("overflow.mp4"), be32(1) + QByteArray("free") + be64(0xFFFFFFFFFFFFFFF0ull) + box("moov", mvhd0))).has_value());
+        REQUIRE(!ResourcesIndexer::read_mp4_duration(dir.filePath(QSL("missing.mp4"))).has_value());
+    }
+
+    SECTION("Wave info"){
+
+        const auto fmt  = QByteArray("fmt ") + le(16, 4) + le(1, 2) + le(2, 2) + le(44100, 4) + le(176400, 4) + le(4, 2) + le(16, 2);
+        const auto list = QByteArray("LIST") + le(3, 4) + QByteArray(4, 0);  // odd size, padded
+        const auto data = QByteArray("data") + le(88200, 4);
+
+        ResourceMetadata metadata;
+        REQUIRE(ResourcesIndexer::read_wav_info(write_file(QSL("a.wav"), QByteArray("RIFF") + le(0, 4) + QByteArray("WAVE") + fmt + list + data), metadata));
+        REQUIRE(metadata.channels == 2);
+        REQUIRE(metadata.duration == 0.5);
+
+        ResourceMetadata invalid;
+        // data chunk before fmt
+        REQUIRE(!ResourcesIndexer::read_wav_info(write_file(QSL("b.wav"), QByteArray("RIFF") + le(0, 4) + QByteArray("WAVE") + data + fmt), invalid));
+        REQUIRE(!ResourcesIndexer::read_wav_info(write_file(QSL("c.wav"), QByteArray("RIFF") + le(0, 4) + QByteArray("AVI ") + fmt + data), invalid));
+        REQUIRE(!ResourcesIndexer::read_wav_info(write_file(QSL("d.wav"), QByteArray("RIFF")), invalid));
+    }
+
+    SECTION("Probe"){
+
+        const auto mp4 = write_file(QSL("video.mp4"), ftyp + box("moov", box("mvhd", QByteArray(12, 0) + be32(10) + be32(25))));
+        auto metadata = ResourcesIndexer::probe(Resource::Type::Video, mp4, std::nullopt);
+        REQUIRE(metadata.status == ResourceMetadata::Status::Valid);
+        REQUIRE(metadata.format == QSL("mp4"));
+        REQUIRE(metadata.duration == 2.5);
+        REQUIRE(metadata.size == QFileInfo(mp4).size());
+
+        // unchanged file reuses the previous metadata
+        auto previous = metadata;
+        previous.duration = 42.;
+        REQUIRE(ResourcesIndexer::probe(Resource::Type::Video, mp4, previous).duration == 42.);
+
+        auto corrupted = ResourcesIndexer::probe(Resource::Type::Video, write_file(QSL("corrupted.mov"), be32(1) + QByteArray("free") + be64(0xFFFFFFFFFFFFFFF0ull)), std::nullopt);
+        REQUIRE(corrupted.status == ResourceMetadata::Status::Invalid);
+
+        REQUIRE(ResourcesIndexer::probe(Resource::Type::Audio, dir.filePath(QSL("missing.wav")), std::nullopt).status == ResourceMetadata::Status::Missing);
+        REQUIRE(ResourcesIndexer::probe(Resource::Type::Text, write_file(QSL("empty.txt"), {}), std::nullopt).status == ResourceMetadata::Status::Invalid);
+        REQUIRE(ResourcesIndexer::probe(Resource::Type::Directory, mp4, std::nullopt).status == ResourceMetadata::Status::Invalid);
+
+        write_file(QSL("d1.txt"), "12");
+        write_file(QSL("d2.txt"), "345");
+        auto directory = ResourcesIndexer::probe(Resource::Type::Directory, dir.path(), std::nullopt);
+        REQUIRE(directory.status == ResourceMetadata::Status::Valid);
+        REQUIRE(directory.filesCount >= 2);
+    }
 }
 
 TEST_CASE("Experiments loading"){
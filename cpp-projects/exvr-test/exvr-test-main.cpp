@@ -31,7 +31,7 @@
 //}
 
 // Qt
-#include <QCoreApplication>
+#include <QApplication>
 
 // base
 #include "utility/benchmark.hpp"
@@ -53,7 +53,8 @@ int main(int argc, char **argv){
 
 //    tool::Bench::disable_display();
 
-    QCoreApplication app(argc, argv);
+    // gui application needed by the flow painting benchmarks
+    QApplication app(argc, argv);
 
     // init logging system
     QtLogger::init(QApplication::applicationDirPath() % QSL("/logs/"), QSL("designer_test.html"));
@@ -64,6 +64,7 @@ INCLUDEPATH += \
     $$BASE_INCLUDES \
     $$QT_UTILITY_INCLUDES \
     $$EXVR_DESIGNER_INCLUDES \
+    $$EXVR_EXPORT_INCLUDES \
     # thirdparty
     $$CATCH_INCLUDES \
     $$QWT_INCLUDES \
@@ -83,8 +84,14 @@ LIBS +=  \
     $$QT_UTILITY_LIB \
     $$EXVR_DESIGNER_OBJ"/ExVR-designer_pch.obj" \
     $$EXVR_DESIGNER_OBJ"/xml_io_manager.obj" \
+    $$EXVR_DESIGNER_OBJ"/binary_experiment_file.obj" \
+    $$EXVR_DESIGNER_OBJ"/experiment_stream.obj" \
     $$EXVR_DESIGNER_OBJ"/experiment.obj" \
     $$EXVR_DESIGNER_OBJ"/randomizer.obj" \
+    $$EXVR_DESIGNER_OBJ"/instance.obj" \
+    $$EXVR_DESIGNER_OBJ"/simulator.obj" \
+    $$EXVR_DESIGNER_OBJ"/connections_graph_plan.obj" \
+    $$EXVR_DESIGNER_OBJ"/nodes_data_converters.obj" \
     $$EXVR_DESIGNER_OBJ"/component.obj" \
     $$EXVR_DESIGNER_OBJ"/timeline.obj" \
     $$EXVR_DESIGNER_OBJ"/config.obj" \
@@ -93,11 +100,30 @@ LIBS +=  \
     $$EXVR_DESIGNER_OBJ"/routine.obj" \
     $$EXVR_DESIGNER_OBJ"/isi.obj" \
     $$EXVR_DESIGNER_OBJ"/loop.obj" \
+    $$EXVR_DESIGNER_OBJ"/csv_columns_file.obj" \
     $$EXVR_DESIGNER_OBJ"/interval.obj" \
     $$EXVR_DESIGNER_OBJ"/components_manager.obj" \
     $$EXVR_DESIGNER_OBJ"/resources_manager.obj" \
+    $$EXVR_DESIGNER_OBJ"/resources_exporter.obj" \
+    $$EXVR_DESIGNER_OBJ"/moc_resources_exporter.obj" \
+    $$EXVR_DESIGNER_OBJ"/resources_indexer.obj" \
+    $$EXVR_DESIGNER_OBJ"/moc_resources_indexer.obj" \
     $$EXVR_DESIGNER_OBJ"/connector.obj" \
     $$EXVR_DESIGNER_OBJ"/path_utility.obj" \
+    $$EXVR_DESIGNER_OBJ"/global_signals.obj" \
+    $$EXVR_DESIGNER_OBJ"/moc_global_signals.obj" \
+    $$EXVR_DESIGNER_OBJ"/display.obj" \
+    $$EXVR_DESIGNER_OBJ"/flow_spatial_index.obj" \
+    $$EXVR_DESIGNER_OBJ"/flow_element_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/flow_sequence_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/isi_flow_element_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/loop_flow_element_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/movable_flow_element_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/node_flow_element_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/routine_flow_element_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/add_button_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/move_button_object.obj" \
+    $$EXVR_DESIGNER_OBJ"/remove_button_object.obj" \
     # third-party
     $$QWT_LIBS \
     $$NODES_LIB \
@@ -106,9 +132,13 @@ LIBS +=  \
 ######################################## PROJECT FILES
 
 HEADERS += \
+    synthetic_experiment.hpp \
 
 SOURCES += \
     exvr-test-main.cpp \
     exvr-designer_tests.cpp \
+    exvr-designer_benchmarks.cpp \
+    exvr-designer_scale_benchmarks.cpp \
+    synthetic_experiment.cpp \
 
 
@@ -0,0 +1,145 @@
+/***********************************************************************************
+** exvr-test                                                                      **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#include "synthetic_experiment.hpp"
+
+// std
+#include <algorithm>
+#include <array>
+#include <random>
+
+// qt-utility
+#include "qt_str.hpp"
+
+using namespace tool;
+using namespace tool::ex;
+
+size_t SyntheticExperimentSettings::conditions_per_routine() const{
+    size_t count = 1;
+    for(size_t ii = 0; ii < loopDepth; ++ii){
+        count *= std::max<size_t>(setsPerLoop, 1);
+    }
+    return count;
+}
+
+QString SyntheticExperimentSettings::to_string() const{
+    return QSL("blocks: ") % QString::number(nbBlocks) % QSL(" routines: ") % QString::number(nbRoutines) % QSL(" loop depth: ") % QString::number(loopDepth) %
+        QSL(" sets per loop: ") % QString::number(setsPerLoop) % QSL(" components: ") % QString::number(nbComponents) %
+        QSL(" actions per condition: ") % QString::number(actionsPerCondition) %
+        QSL(" connectors per condition: ") % QString::number(connectorsPerCondition);
+}
+
+SyntheticExperimentSettings tool::ex::flow_blocks_settings(size_t nbBlocks){
+    SyntheticExperimentSettings settings;
+    settings.nbBlocks               = nbBlocks;
+    settings.nbRoutines             = 2;
+    settings.isisBetweenRoutines    = true;
+    settings.loopDepth              = 2;
+    settings.setsPerLoop            = 0;
+    settings.nbComponents           = 0;
+    return settings;
+}
+
+void tool::ex::generate_synthetic_experiment(Experiment &exp, const SyntheticExperimentSettings &settings){
+
+    std::mt19937 gen(settings.seed);
+
+    // flow: each block is loop{ loop{ ... routine, (isi), routine ... } }
+    for(size_t block = 0; block < settings.nbBlocks; ++block){
+        size_t node = exp.elements.size()-1;
+        for(size_t ii = 0; ii < settings.loopDepth; ++ii, node += 2){
+            exp.add_element(FlowElement::Type::Loop, node);
+        }
+        for(size_t ii = 0; ii < settings.nbRoutines; ++ii, node += 2){
+            if(ii > 0 && settings.isisBetweenRoutines){
+                exp.add_element(FlowElement::Type::Isi, node);
+                node += 2;
+            }
+            exp.add_element(FlowElement::Type::Routine, node);
+        }
+    }
+    exp.unselect_all_elements(false);
+
+    for(size_t ii = 0; ii < exp.loops.size() && settings.setsPerLoop > 0; ++ii){
+        QStringList sets;
+        for(size_t jj = 0; jj < settings.setsPerLoop; ++jj){
+            sets << (QSL("l") % QString::number(ii) % QSL("s") % QString::number(jj));
+        }
+        exp.loops[ii]->set_sets(sets);
+    }
+    exp.update_conditions();
+
+    // components
+    const auto types = Component::all_components_types();
+    for(size_t ii = 0; ii < settings.nbComponents; ++ii){
+        exp.add_new_component(types[ii % types.size()], RowId{static_cast<int>(exp.compM.count())});
+    }
+    const auto components = exp.compM.get_components();
+    if(components.empty()){
+        return;
+    }
+
+    std::uniform_real_distribution<double> time(0., 1.);
+    const std::array<Connector::Type, 4> connectorsTypes = {
+        Connector::Type::Real, Connector::Type::Decimal_operation, Connector::Type::Conditional_trigger, Connector::Type::Logger
+    };
+
+    size_t offset = 0;
+    for(auto routine : exp.get_elements_from_type<Routine>()){
+        for(auto &condition : routine->conditions){
+
+            // actions with random intervals
+            const size_t nbActions = std::min(settings.actionsPerCondition, components.size());
+            for(size_t ii = 0; ii < nbActions; ++ii){
+                auto action = Action::generate_component_action(
+                    components[(offset + ii) % components.size()], condition->duration, std::nullopt, false, true
+                );
+                for(size_t jj = 0; jj < settings.intervalsPerTimeline; ++jj){
+                    const double start = time(gen) * condition->duration.v;
+                    const double end   = std::min(start + time(gen) * condition->duration.v * 0.2, condition->duration.v);
+                    action->timelineUpdate.edit().add_interval(Interval{SecondsTS{start}, SecondsTS{end}});
+                }
+                condition->actions.push_back(std::move(action));
+            }
+            ++offset;
+
+            // chain of connectors
+            for(size_t ii = 0; ii < settings.connectorsPerCondition; ++ii){
+                const auto type = connectorsTypes[ii % connectorsTypes.size()];
+                condition->connectors.push_back(std::make_unique<Connector>(
+                    ConnectorKey{-1}, type, from_view(Connector::get_name(type)), QPointF(100.*ii, 0.)
+                ));
+                if(ii > 0){
+                    auto connection = std::make_unique<Connection>(ConnectionKey{-1});
+                    connection->startType  = Connection::Type::Connector;
+                    connection->endType    = Connection::Type::Connector;
+                    connection->startKey   = condition->connectors[ii-1]->key();
+                    connection->startIndex = 0;
+                    connection->endKey     = condition->connectors[ii]->key();
+                    connection->endIndex   = 0;
+                    condition->connections.push_back(std::move(connection));
+                }
+            }
+        }
+    }
+}
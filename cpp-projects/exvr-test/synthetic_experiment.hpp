@@ -0,0 +1,51 @@
+/***********************************************************************************
+** exvr-test                                                                      **
+** MIT License                                                                    **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+************************************************************************************/
+
+#pragma once
+
+// exvr-designer
+#include "experiment/experiment.hpp"
+
+namespace tool::ex {
+
+struct SyntheticExperimentSettings{
+    size_t nbBlocks = 1;                    /**< flow is a sequence of blocks: nested loops around the routines */
+    size_t nbRoutines = 10;                 /**< per block */
+    bool isisBetweenRoutines = false;
+    size_t loopDepth = 1;                   /**< routines are inside this number of nested loops */
+    size_t setsPerLoop = 4;                 /**< conditions per routine: setsPerLoop^loopDepth, 0 keeps the default set */
+    size_t nbComponents = 20;
+    size_t actionsPerCondition = 5;
+    size_t intervalsPerTimeline = 3;
+    size_t connectorsPerCondition = 10;
+    unsigned int seed = 0;
+
+    size_t routines_count() const noexcept{return nbBlocks*nbRoutines;}
+    size_t conditions_per_routine() const;
+    QString to_string() const;
+};
+
+void generate_synthetic_experiment(Experiment &exp, const SyntheticExperimentSettings &settings);
+// blocks of loop{ loop{ routine, isi, routine } } without components
+SyntheticExperimentSettings flow_blocks_settings(size_t nbBlocks);
+}
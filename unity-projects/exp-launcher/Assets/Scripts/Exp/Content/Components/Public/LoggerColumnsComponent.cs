@@ -24,30 +24,50 @@
 
 // system
 using System;
-using System.Collections.Generic;
 
 namespace Ex {
 
-    public class LoggerColumnsComponent : BaseLoggerComponent {
+    // rows are formatted and written by the native logger (exvr-export), the frame loop only copies the columns values
+    public class LoggerColumnsComponent : CppExComponent {
 
         // parameters
+        protected string m_directoryPath;
+        protected string m_baseFileName;
+        protected string m_fileExtension;
+        protected bool m_addInstanceToFileName;
         protected bool m_addDateToFileName;
         protected string m_dateTimeFormat;
-        protected bool m_writeCurrentColumnsAtEachFrame;
-        protected string m_columnsSeparator;
 
-        private List<string> columnsValue = null;
+        private string m_filePath = "";
+
+        private DLLLoggerComponent logger_dll() {
+            return (DLLLoggerComponent)cppDll;
+        }
 
         #region ex_functions
         protected override bool initialize() {
 
-            if (!read_common_init_parameters()) {
+            m_directoryPath = initC.get_resource_path(ResourcesManager.ResourceType.Directory, "directory");
+            if (m_directoryPath.Length == 0) {
+                log_error("No directory resource defined.");
                 return false;
             }
-            m_addDateToFileName = initC.get<bool>("add_date_to_file_name");
-            m_dateTimeFormat = initC.get<string>("date_time_format");
-            m_writeCurrentColumnsAtEachFrame = initC.get<bool>("write_each_frame");
-            m_columnsSeparator = initC.get<string>("separator");
+
+            m_addInstanceToFileName = initC.get<bool>("add_current_instance_to_file_name");
+            m_baseFileName          = initC.get<string>("base_file_name");
+            m_fileExtension         = initC.get<string>("file_extension");
+            m_addDateToFileName     = initC.get<bool>("add_date_to_file_name");
+            m_dateTimeFormat        = initC.get<string>("date_time_format");
+
+            // init DLL
+            try {
+                cppDll = new DLLLoggerComponent();
+            } catch (System.Exception exception) {
+                log_error(string.Format("Cannot init logger DLL, error: {0}", exception.Message));
+                cppDll = null;
+                return false;
+            }
+            cppDll.parent = this;
 
             // slots
             add_slot("set column value", (idAny) => {
@@ -55,71 +75,78 @@ namespace Ex {
                 update_column_value(colValue.id, colValue.value);
             });
             add_slot("write current line", (nullArg) => {
-                write(String.Join(m_columnsSeparator, columnsValue), true);
+                write_current_colums();
             });
             add_slot("reset all values", (nullArg) => {
                 reset_all_values();
             });
 
+            if (!cppDll.initialize()) {
+                log_error("Cannot initialize logger dll.");
+                return false;
+            }
             return true;
         }
 
         protected override void start_experiment() {
 
+            m_filePath = string.Format("{0}/{1}", m_directoryPath, generate_file_name());
+            cppDll.set(Parameters.Container.Dynamic, "path_file", m_filePath);
             base.start_experiment();
-
-            if (initC.get<bool>("add_header_line")) {
-                var header = initC.get<string>("header_line");
-                write(header, true);
-
-                var count = Ex.Text.split(header, ";").Length;
-                columnsValue = new List<string>(count);
-                for (int ii = 0; ii < count; ++ii) {
-                    columnsValue.Add("-");
-                }
-            } else {
-                columnsValue = new List<string>();
-            }            
-        }
-
-
-        protected override void post_update() {
-            if (m_writeCurrentColumnsAtEachFrame) {
-                write_current_colums();
-            }
         }
 
         #endregion
 
         #region private_functions
 
-        protected override string generate_file_name() {
+        protected string generate_file_name() {
             string dateStr = string.Format("_{0}", DateTime.Now.ToString(m_dateTimeFormat));
             return string.Format("{0}{1}{2}.{3}", m_baseFileName, m_addInstanceToFileName ?
                 string.Concat("_", ExVR.Experiment().instanceName) : "", m_addDateToFileName ? dateStr : "", m_fileExtension);
         }
 
-
         #endregion
 
         #region public_functions
 
+        public string parent_directory_path() {
+            return m_directoryPath;
+        }
+
+        public string file_path() {
+            return m_filePath;
+        }
+
+        public string file_extension() {
+            return m_fileExtension;
+        }
+
+        public void write(object value) {
+            logger_dll().log_line(Converter.to_string(value));
+        }
+
         public void write_current_colums() {
-            write(string.Join(m_columnsSeparator, columnsValue), true);
+            logger_dll().push_columns();
         }
 
         public void update_column_value(int idColumn, object value) {
 
-            while (idColumn >= columnsValue.Count) {
-                columnsValue.Add("-");
+            // numbers are formatted by the writer thread
+            if (value is double d) {
+                logger_dll().set_column(idColumn, d);
+            } else if (value is float f) {
+                logger_dll().set_column(idColumn, f);
+            } else if (value is int i) {
+                logger_dll().set_column(idColumn, i);
+            } else if (value is long l) {
+                logger_dll().set_column(idColumn, l);
+            } else {
+                logger_dll().set_column(idColumn, Converter.to_string(value));
             }
-            columnsValue[idColumn] = Converter.to_string(value);
         }
 
         public void reset_all_values() {
-            for (int ii = 0; ii < columnsValue.Count; ++ii) {
-                columnsValue[ii] = "-";
-            }
+            logger_dll().reset_columns();
         }
 
         #endregion
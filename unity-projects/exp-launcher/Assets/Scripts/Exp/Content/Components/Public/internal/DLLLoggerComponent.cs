@@ -0,0 +1,86 @@
+﻿/*******************************************************************************
+** exvr-exp                                                                   **
+** No license (to be defined)                                                 **
+** Copyright (c) [2018] [Florian Lance][EPFL-LNCO]                            **
+********************************************************************************/
+
+// system
+using System;
+using System.Runtime.InteropServices;
+
+
+namespace Ex {
+
+    public class DLLLoggerComponent : DLLExComponent {
+
+        // rows are copied by the calling thread into its own buffer, formatted and written by the native writer thread
+        public bool log_line(string line) {
+            return log_line_logger_ex_component(_handle, line) == 1;
+        }
+
+        public void set_column(int idColumn, double value) {
+            set_column_double_logger_ex_component(_handle, idColumn, value);
+        }
+        public void set_column(int idColumn, string value) {
+            set_column_string_logger_ex_component(_handle, idColumn, value);
+        }
+        public void reset_columns() {
+            reset_columns_logger_ex_component(_handle);
+        }
+        public bool push_columns() {
+            return push_columns_logger_ex_component(_handle) == 1;
+        }
+
+        public void flush() {
+            flush_logger_ex_component(_handle);
+        }
+
+        public long rows_written() {
+            return get_rows_written_logger_ex_component(_handle);
+        }
+        public long rows_dropped() {
+            return get_rows_dropped_logger_ex_component(_handle);
+        }
+
+        #region memory_management
+
+        public DLLLoggerComponent() : base() {
+        }
+        protected override void create_DLL_class() {
+            _handle = new HandleRef(this, create_logger_ex_component());
+        }
+
+        #endregion memory_management    
+        #region DllImport
+
+        // memory management
+        [DllImport("exvr-export", EntryPoint = "create_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern IntPtr create_logger_ex_component();
+
+        [DllImport("exvr-export", EntryPoint = "log_line_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern int log_line_logger_ex_component(HandleRef logger, string line);
+
+        [DllImport("exvr-export", EntryPoint = "set_column_double_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern void set_column_double_logger_ex_component(HandleRef logger, int idColumn, double value);
+
+        [DllImport("exvr-export", EntryPoint = "set_column_string_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern void set_column_string_logger_ex_component(HandleRef logger, int idColumn, string value);
+
+        [DllImport("exvr-export", EntryPoint = "reset_columns_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern void reset_columns_logger_ex_component(HandleRef logger);
+
+        [DllImport("exvr-export", EntryPoint = "push_columns_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern int push_columns_logger_ex_component(HandleRef logger);
+
+        [DllImport("exvr-export", EntryPoint = "flush_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern void flush_logger_ex_component(HandleRef logger);
+
+        [DllImport("exvr-export", EntryPoint = "get_rows_written_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern long get_rows_written_logger_ex_component(HandleRef logger);
+
+        [DllImport("exvr-export", EntryPoint = "get_rows_dropped_logger_ex_component", CallingConvention = CallingConvention.Cdecl)]
+        static private extern long get_rows_dropped_logger_ex_component(HandleRef logger);
+
+        #endregion DllImport        
+    }
+}
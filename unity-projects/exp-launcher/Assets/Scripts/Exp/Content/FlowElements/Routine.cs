@@ -121,6 +121,8 @@ namespace Ex{
             m_type = Type.Routine;
             m_isARandomizer = routine.Randomizer;
 
+            resolve_shared_definitions(routine);
+
             // generate conditions
             m_conditions = new List<Condition>(routine.Conditions.Count);
             m_conditionsPerName = new Dictionary<string, Condition>(routine.Conditions.Count);
@@ -137,6 +139,38 @@ namespace Ex{
             }
 
         }
+        // timelines and connectors arguments shared by several conditions are defined once in the routine
+        private static void resolve_shared_definitions(XML.Routine routine) {
+
+            var timelines = new Dictionary<int, XML.Timeline>();
+            if (routine.Timelines != null) {
+                foreach (var timeline in routine.Timelines) {
+                    timelines[timeline.Key] = timeline;
+                }
+            }
+            var args = new Dictionary<int, XML.Arg>();
+            if (routine.ConnectorArgs != null) {
+                foreach (var arg in routine.ConnectorArgs) {
+                    args[arg.Key] = arg.Arg;
+                }
+            }
+
+            foreach (XML.Condition xmlCondition in routine.Conditions) {
+                foreach (XML.Action action in xmlCondition.Actions) {
+                    if (action.Timelines == null || action.Timelines.Count == 0) {
+                        action.Timelines = new List<XML.Timeline>(2) {
+                            timelines[action.KeyTimelineUpdate], timelines[action.KeyTimelineVisibility]
+                        };
+                    }
+                }
+                foreach (XML.Connector connector in xmlCondition.Connectors) {
+                    if (connector.Arg == null || connector.Arg.Count == 0) {
+                        connector.Arg = new List<XML.Arg>(1) { args[connector.KeyArg] };
+                    }
+                }
+            }
+        }
+
         public bool initialize() {
 
             foreach (var condition in m_conditions) {
@@ -165,6 +165,9 @@ namespace Ex{
         public class Timeline{
 
             // attributes
+            [XmlAttribute(AttributeName = "key")] // defined in routine
+            public int Key { get; set; }
+
             [XmlAttribute(AttributeName = "type")]
             public string Type { get; set; }
 
@@ -192,8 +195,14 @@ namespace Ex{
             [XmlAttribute(AttributeName = "node_position")]
             public string Position { get; set; }
 
+            [XmlAttribute(AttributeName = "key_timeline_update")]
+            public int KeyTimelineUpdate { get; set; }
+
+            [XmlAttribute(AttributeName = "key_timeline_visibility")]
+            public int KeyTimelineVisibility { get; set; }
+
             // elements
-            [XmlElement(ElementName = "Timeline")]
+            [XmlElement(ElementName = "Timeline")] // legacy, timelines are now defined in routine
             public List<Timeline> Timelines { get; set; }
         }
 
@@ -250,11 +259,26 @@ namespace Ex{
             [XmlAttribute(AttributeName = "node_position")]
             public string Position { get; set; }
 
+            [XmlAttribute(AttributeName = "key_arg")]
+            public int KeyArg { get; set; }
+
             // elements
-            [XmlElement(ElementName = "Arg")]
+            [XmlElement(ElementName = "Arg")] // legacy, arguments are now defined in routine
             public List<Arg> Arg { get; set; }
         }
 
+        [XmlRoot(ElementName = "ConnectorArg")]
+        public class ConnectorArg{
+
+            // attributes
+            [XmlAttribute(AttributeName = "key")]
+            public int Key { get; set; }
+
+            // elements
+            [XmlElement(ElementName = "Arg")]
+            public Arg Arg { get; set; }
+        }
+
 
         [XmlRoot(ElementName = "Condition")]
         public class Condition{
@@ -294,6 +318,12 @@ namespace Ex{
             public bool Randomizer { get; set; }
 
             // elements
+            [XmlElement(ElementName = "Timeline")] // shared by the conditions actions
+            public List<Timeline> Timelines { get; set; }
+
+            [XmlElement(ElementName = "ConnectorArg")] // shared by the conditions connectors
+            public List<ConnectorArg> ConnectorArgs { get; set; }
+
             [XmlElement(ElementName = "Condition")]
             public List<Condition> Conditions { get; set; }
         }